@@ -0,0 +1,103 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Template message queue for inter-thread communication with conflation
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsMessageQueue.h"
+
+namespace ts {
+    //!
+    //! Template message queue for inter-thread communication with conflation.
+    //! @ingroup thread
+    //!
+    //! The ts::MessageConflatingQueue template class implements a synchronized
+    //! access to a shared queue of generic messages. Each message has a key.
+    //! When a message is enqueued while a message with the same key is still
+    //! waiting in the queue, the new message replaces the old one, at the same
+    //! position in the queue. The superseded message is dropped.
+    //!
+    //! This is typically used for periodic status updates (a bitrate report
+    //! for instance): only the most recent update of each kind is worth
+    //! delivering and a slow consumer can never be flooded by repeated
+    //! updates, each key occupies at most one slot in the queue.
+    //!
+    //! @tparam MSG The type of the messages to exchange.
+    //! @tparam MUTEX The type of mutex for synchronization (std::mutex by default).
+    //! @tparam SAMEKEY A function object to check if two @a MSG instances have
+    //! the same key. By default, the '==' operator on @a MSG is used.
+    //!
+    template <typename MSG, class MUTEX = std::mutex, class SAMEKEY = std::equal_to<MSG>>
+    class MessageConflatingQueue: public MessageQueue<MSG, MUTEX>
+    {
+        TS_NOCOPY(MessageConflatingQueue);
+    public:
+        //!
+        //! Constructor.
+        //!
+        //! @param [in] maxMessages Maximum number of messages in the queue.
+        //! When a thread attempts to enqueue a message and the queue is full,
+        //! the thread waits until at least one message is dequeued.
+        //! If @a maxMessages is 0, the queue is unlimited. In that case,
+        //! the logic of the application must ensure that the queue is
+        //! bounded somehow, otherwise the queue may exhaust all the process
+        //! memory.
+        //!
+        MessageConflatingQueue(size_t maxMessages = 0);
+
+    protected:
+        //!
+        //! Explicit reference to superclass.
+        //!
+        typedef MessageQueue<MSG, MUTEX> SuperClass;
+
+        //!
+        //! This virtual protected method locates a queued message with the same key.
+        //! @param [in] msg The new message to enqueue.
+        //! @param [in] list The content of the queue.
+        //! @return An iterator to the superseded message or @a list.end() when no
+        //! queued message has the same key as @a msg.
+        //!
+        virtual typename SuperClass::MessageList::iterator
+            conflatePlacement(const typename SuperClass::MessagePtr& msg, typename SuperClass::MessageList& list) override;
+    };
+}
+
+
+//----------------------------------------------------------------------------
+// Template definitions.
+//----------------------------------------------------------------------------
+
+template <typename MSG, class MUTEX, class SAMEKEY>
+ts::MessageConflatingQueue<MSG, MUTEX, SAMEKEY>::MessageConflatingQueue(size_t maxMessages) :
+    SuperClass(maxMessages)
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Placement of the superseded message (virtual protected method).
+//----------------------------------------------------------------------------
+
+template <typename MSG, class MUTEX, class SAMEKEY>
+typename ts::MessageConflatingQueue<MSG, MUTEX, SAMEKEY>::SuperClass::MessageList::iterator
+ts::MessageConflatingQueue<MSG, MUTEX, SAMEKEY>::conflatePlacement(const typename SuperClass::MessagePtr& msg, typename SuperClass::MessageList& list)
+{
+    // Null pointers never conflate anything.
+    if (!msg.isNull()) {
+        for (auto it = list.begin(); it != list.end(); ++it) {
+            if (!it->isNull() && SAMEKEY()(*msg, **it)) {
+                return it;
+            }
+        }
+    }
+    return list.end();
+}
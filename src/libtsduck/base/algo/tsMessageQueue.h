@@ -109,6 +109,51 @@ namespace ts {
         //!
         bool enqueue(MSG* msg, MilliSecond timeout = Infinite);
 
+        //!
+        //! Insert a message in the queue, without ever waiting.
+        //!
+        //! This method never blocks the calling thread. When the queue is full and the
+        //! message does not conflate a queued one, the message is immediately dropped
+        //! and counted in droppedCount(). This is the recommended way to post
+        //! control-plane messages from a data-plane thread: an overloaded consumer
+        //! can never stall the producer.
+        //!
+        //! @param [in,out] msg The message to enqueue. On success, the ownership of the
+        //! pointed object is transfered to the message queue and the @a msg safe pointer
+        //! becomes a null pointer. When the message is dropped, @a msg is left unchanged.
+        //! @return True if the message was enqueued or conflated, false if it was dropped.
+        //!
+        bool tryEnqueue(MessagePtr& msg);
+
+        //!
+        //! Insert a message in the queue, without ever waiting.
+        //!
+        //! This method never blocks the calling thread. When the queue is full and the
+        //! message does not conflate a queued one, the message is immediately dropped
+        //! and counted in droppedCount().
+        //!
+        //! @param [in] msg A pointer to the message to enqueue. This pointer shall not
+        //! be owned by a safe pointer. When the message is enqueued or conflated, the
+        //! pointer becomes owned by a safe pointer and will be deallocated when no
+        //! longer used. When the message is dropped, it is immediately deallocated.
+        //! @return True if the message was enqueued or conflated, false if it was dropped.
+        //!
+        bool tryEnqueue(MSG* msg);
+
+        //!
+        //! Get the number of messages which were dropped by tryEnqueue() on queue overflow.
+        //! @return The number of dropped messages since the creation of the queue.
+        //!
+        uint64_t droppedCount() const;
+
+        //!
+        //! Get the number of messages which were conflated.
+        //! A message is conflated when it replaces a superseded message which was
+        //! still in the queue, as decided by conflatePlacement().
+        //! @return The number of conflated messages since the creation of the queue.
+        //!
+        uint64_t conflatedCount() const;
+
         //!
         //! Insert a message in the queue, even if the queue is full.
         //!
@@ -185,18 +230,39 @@ namespace ts {
         //!
         virtual typename MessageList::iterator dequeuePlacement(MessageList& list);
 
+        //!
+        //! This virtual protected method locates a queued message which is superseded
+        //! by a new one. When a non-end iterator is returned, the new message replaces
+        //! the superseded one in place, keeping its position in the queue, instead of
+        //! being appended. This is the conflation mechanism: repeated updates of the
+        //! same nature (a periodic bitrate report for instance) occupy one single slot
+        //! in the queue and cannot push it to overflow. The default implementation
+        //! never conflates anything.
+        //! @param [in] msg The new message to enqueue.
+        //! @param [in] list The content of the queue.
+        //! @return An iterator to the superseded message or @a list.end() when the
+        //! new message does not supersede any queued one.
+        //!
+        virtual typename MessageList::iterator conflatePlacement(const MessagePtr& msg, MessageList& list);
+
     private:
         // Private members.
         mutable std::mutex              _mutex {};         //!< Protect access to all private members
         mutable std::condition_variable _enqueued {};      //!< Signaled when some message is inserted
         mutable std::condition_variable _dequeued {};      //!< Signaled when some message is removed
         size_t      _maxMessages = 0;  //!< Max number of messages in the queue
+        uint64_t    _dropped = 0;      //!< Number of messages dropped by tryEnqueue().
+        uint64_t    _conflated = 0;    //!< Number of messages which replaced a superseded one.
         MessageList _queue {};         //!< Actual message queue.
 
         // Enqueue a safe pointer in the list and signal the condition.
         // Must be executed under the protection of the lock.
         void enqueuePtr(const MessagePtr& ptr);
 
+        // Replace a superseded message by a new one, according to conflatePlacement().
+        // Must be executed under the protection of the lock. Return true on conflation.
+        bool conflatePtr(const MessagePtr& ptr);
+
         // Wait for free space in the queue using a specific timeout, under the protection of the mutex.
         bool waitFreeSpace(std::unique_lock<std::mutex>& lock, MilliSecond timeout);
     };
@@ -262,6 +328,14 @@ ts::MessageQueue<MSG, MUTEX>::dequeuePlacement(MessageList& list)
     return list.begin();
 }
 
+template <typename MSG, class MUTEX>
+typename ts::MessageQueue<MSG, MUTEX>::MessageList::iterator
+ts::MessageQueue<MSG, MUTEX>::conflatePlacement(const MessagePtr& msg, MessageList& list)
+{
+    // By default, a message never supersedes a queued one.
+    return list.end();
+}
+
 
 //----------------------------------------------------------------------------
 // Enqueue a safe pointer in the list and signal the condition.
@@ -276,6 +350,29 @@ void ts::MessageQueue<MSG, MUTEX>::enqueuePtr(const MessagePtr& ptr)
 }
 
 
+//----------------------------------------------------------------------------
+// Replace a superseded message by a new one (conflation).
+// Must be executed under the protection of the lock.
+//----------------------------------------------------------------------------
+
+template <typename MSG, class MUTEX>
+bool ts::MessageQueue<MSG, MUTEX>::conflatePtr(const MessagePtr& ptr)
+{
+    const auto it = conflatePlacement(ptr, _queue);
+    if (it == _queue.end()) {
+        return false;
+    }
+    else {
+        // Replace the superseded message in place, the position in the queue
+        // and consequently the dequeue order are preserved.
+        *it = ptr;
+        _conflated++;
+        _enqueued.notify_all();
+        return true;
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Wait for free space in the queue using a specific timeout.
 //----------------------------------------------------------------------------
@@ -320,16 +417,24 @@ bool ts::MessageQueue<MSG, MUTEX>::enqueue(MessagePtr& msg, MilliSecond timeout)
     // on waiting for space in the queue.
     std::unique_lock<std::mutex> lock(_mutex);
 
+    // Transfer ownership of the pointed object into a local safe pointer which is
+    // guaranteed to be destructed before releasing the lock. If the message is
+    // neither conflated nor enqueued, ownership is given back to the caller.
+    const MessagePtr transferred(msg.release());
+
+    // Conflation first: replacing a superseded message does not need free space.
+    if (conflatePtr(transferred)) {
+        return true;
+    }
+
     if (waitFreeSpace(lock, timeout)) {
         // Successfully waited for free space in the queue.
-        // Transfer ownership of the pointed object inside a code block which guarantees
-        // that the new safe pointer will be destructed before releasing the lock.
-        const MessagePtr transferred(msg.release());
         enqueuePtr(transferred);
         return true;
     }
     else {
-        // Timeout, queue still full.
+        // Timeout, queue still full, give the message back to the caller.
+        msg = transferred;
         return false;
     }
 }
@@ -340,21 +445,93 @@ bool ts::MessageQueue<MSG, MUTEX>::enqueue(MSG* msg, MilliSecond timeout)
     // Same code template as above.
     std::unique_lock<std::mutex> lock(_mutex);
 
-    if (waitFreeSpace(lock, timeout)) {
-        // Create a safe pointer to the pointed object inside a code block which guarantees
-        // that the safe pointer will be destructed before releasing the lock.
-        const MessagePtr ptr(msg);
+    // Create a safe pointer to the pointed object inside a code block which guarantees
+    // that the safe pointer will be destructed before releasing the lock.
+    const MessagePtr ptr(msg);
+
+    if (conflatePtr(ptr)) {
+        return true;
+    }
+    else if (waitFreeSpace(lock, timeout)) {
         enqueuePtr(ptr);
         return true;
     }
     else {
-        // Timeout, queue still full. Deallocated the message.
-        delete msg;
+        // Timeout, queue still full. The message is deallocated with the safe pointer.
         return false;
     }
 }
 
 
+//----------------------------------------------------------------------------
+// Insert a message in the queue, without ever waiting.
+//----------------------------------------------------------------------------
+
+template <typename MSG, class MUTEX>
+bool ts::MessageQueue<MSG, MUTEX>::tryEnqueue(MessagePtr& msg)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // Transfer ownership of the pointed object inside a code block which guarantees
+    // that the new safe pointer will be destructed before releasing the lock.
+    const MessagePtr transferred(msg.release());
+    if (conflatePtr(transferred)) {
+        return true;
+    }
+    else if (_maxMessages == 0 || _queue.size() < _maxMessages) {
+        enqueuePtr(transferred);
+        return true;
+    }
+    else {
+        // Queue full, drop the message, give it back to the caller.
+        _dropped++;
+        msg = transferred;
+        return false;
+    }
+}
+
+template <typename MSG, class MUTEX>
+bool ts::MessageQueue<MSG, MUTEX>::tryEnqueue(MSG* msg)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // Create a safe pointer to the pointed object inside a code block which guarantees
+    // that the safe pointer will be destructed before releasing the lock.
+    const MessagePtr ptr(msg);
+    if (conflatePtr(ptr)) {
+        return true;
+    }
+    else if (_maxMessages == 0 || _queue.size() < _maxMessages) {
+        enqueuePtr(ptr);
+        return true;
+    }
+    else {
+        // Queue full, drop the message, it is deallocated with the safe pointer.
+        _dropped++;
+        return false;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Get the overflow and conflation counters.
+//----------------------------------------------------------------------------
+
+template <typename MSG, class MUTEX>
+uint64_t ts::MessageQueue<MSG, MUTEX>::droppedCount() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _dropped;
+}
+
+template <typename MSG, class MUTEX>
+uint64_t ts::MessageQueue<MSG, MUTEX>::conflatedCount() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _conflated;
+}
+
+
 //----------------------------------------------------------------------------
 // Insert a message in the queue, even if the queue is full.
 //----------------------------------------------------------------------------
@@ -367,7 +544,9 @@ void ts::MessageQueue<MSG, MUTEX>::forceEnqueue(MessagePtr& msg)
         // Transfer ownership of the pointed object inside a code block which guarantees
         // that the new safe pointer will be destructed before releasing the lock.
         const MessagePtr transfered(msg.release());
-        enqueuePtr(transfered);
+        if (!conflatePtr(transfered)) {
+            enqueuePtr(transfered);
+        }
     }
 }
 
@@ -379,7 +558,9 @@ void ts::MessageQueue<MSG, MUTEX>::forceEnqueue(MSG* msg)
         // Create a safe pointer to the pointed object inside a code block which guarantees
         // that the safe pointer will be destructed before releasing the lock.
         const MessagePtr ptr(msg);
-        enqueuePtr(ptr);
+        if (!conflatePtr(ptr)) {
+            enqueuePtr(ptr);
+        }
     }
 }
 
@@ -15,6 +15,7 @@
 #include "tsUString.h"
 #include "tsIntegerUtils.h"
 #include <cmath>
+#include <random>
 
 namespace ts {
     //!
@@ -94,6 +95,34 @@ namespace ts {
         //!
         FLOAT standardDeviation() const { return std::sqrt(variance()); }
 
+        //!
+        //! Default number of samples in the quantile estimation reservoir.
+        //! @see enableQuantiles()
+        //!
+        static constexpr size_t DEFAULT_RESERVOIR_SIZE = 1024;
+
+        //!
+        //! Enable the estimation of quantiles.
+        //! The quantiles are estimated over a bounded uniform random sample of the
+        //! data ("reservoir sampling"). The memory usage is therefore constant,
+        //! whatever the number of accumulated samples, making the estimation
+        //! suitable for very long collections. By default, quantiles are not
+        //! collected and feed() has no sampling overhead.
+        //! @param [in] reservoir_size Maximum number of samples to keep in memory.
+        //! The larger the reservoir, the more accurate the extreme quantiles.
+        //!
+        void enableQuantiles(size_t reservoir_size = DEFAULT_RESERVOIR_SIZE);
+
+        //!
+        //! Get an estimation of a quantile of all accumulated samples.
+        //! The quantile collection must have been enabled using enableQuantiles().
+        //! @param [in] probability The requested quantile, between 0.0 and 1.0.
+        //! As examples, 0.5 is the median and 0.99 the 99th percentile.
+        //! @return An estimation of the corresponding quantile value. Return zero
+        //! when the quantile collection is disabled or no sample was accumulated.
+        //!
+        NUMBER quantile(FLOAT probability) const;
+
         //!
         //! Get the mean value of all accumulated samples as a string.
         //! @param [in] width Minimum width of the string, left-padded with spaces.
@@ -122,6 +151,7 @@ namespace ts {
         //
         //  References:
         //  [1] https://en.wikipedia.org/wiki/Algorithms_for_calculating_variance
+        //  [2] https://en.wikipedia.org/wiki/Reservoir_sampling
         //
         size_t _count = 0;    // Total number of samples.
         NUMBER _min = 0;      // Minimum value.
@@ -129,6 +159,12 @@ namespace ts {
         SIGNED _var_k = 0;    // Variance: K constant (see [1])
         SIGNED _var_ex = 0;   // Variance: Ex accumulation (see [1])
         SIGNED _var_ex2 = 0;  // Variance: Ex2 accumulation (see [1])
+
+        // Quantile estimation by reservoir sampling ("algorithm R", see [2]).
+        size_t _reservoir_size = 0;                 // Maximum reservoir size, zero when quantiles are disabled.
+        mutable bool _sorted = true;                // The reservoir is currently sorted.
+        mutable std::vector<NUMBER> _reservoir {};  // Uniform random sample of the accumulated data.
+        std::default_random_engine _random {};      // Random generator for the sampling.
     };
 }
 
@@ -147,6 +183,8 @@ void ts::SingleDataStatistics<NUMBER, DEFAULT_FLOAT>::reset()
     _var_k = 0;
     _var_ex = 0;
     _var_ex2 = 0;
+    _sorted = true;
+    _reservoir.clear();
 }
 
 
@@ -167,6 +205,55 @@ void ts::SingleDataStatistics<NUMBER, DEFAULT_FLOAT>::feed(NUMBER value)
     _var_ex += diff;
     _var_ex2 += diff * diff;
     _count++;
+
+    // Reservoir sampling, see reference [2] in file header. Each of the _count
+    // samples has the same probability of being present in the reservoir.
+    if (_reservoir_size > 0) {
+        if (_reservoir.size() < _reservoir_size) {
+            _reservoir.push_back(value);
+            _sorted = false;
+        }
+        else {
+            const size_t index = size_t(_random() % _count);
+            if (index < _reservoir_size) {
+                _reservoir[index] = value;
+                _sorted = false;
+            }
+        }
+    }
+}
+
+
+// Enable the estimation of quantiles.
+template <typename NUMBER, typename DEFAULT_FLOAT>
+void ts::SingleDataStatistics<NUMBER, DEFAULT_FLOAT>::enableQuantiles(size_t reservoir_size)
+{
+    _reservoir_size = reservoir_size;
+    if (_reservoir.size() > reservoir_size) {
+        _reservoir.resize(reservoir_size);
+    }
+    _reservoir.reserve(reservoir_size);
+}
+
+
+// Get an estimation of a quantile of all accumulated samples.
+template <typename NUMBER, typename DEFAULT_FLOAT>
+NUMBER ts::SingleDataStatistics<NUMBER, DEFAULT_FLOAT>::quantile(FLOAT probability) const
+{
+    if (_reservoir.empty()) {
+        return 0;
+    }
+
+    // Sort the reservoir on demand only.
+    if (!_sorted) {
+        std::sort(_reservoir.begin(), _reservoir.end());
+        _sorted = true;
+    }
+
+    // Nearest-rank method over the sample.
+    probability = std::max(FLOAT(0.0), std::min(FLOAT(1.0), probability));
+    const size_t index = std::min(_reservoir.size() - 1, size_t(probability * FLOAT(_reservoir.size())));
+    return _reservoir[index];
 }
 
 
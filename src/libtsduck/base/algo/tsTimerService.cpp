@@ -0,0 +1,135 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsTimerService.h"
+
+TS_DEFINE_SINGLETON(ts::TimerService);
+
+
+//----------------------------------------------------------------------------
+// Constructor and destructor.
+//----------------------------------------------------------------------------
+
+ts::TimerService::TimerService()
+{
+}
+
+ts::TimerService::~TimerService()
+{
+    // Terminate the service thread and wait for actual thread termination.
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _terminate = true;
+    }
+    _condition.notify_all();
+    waitForTermination();
+}
+
+
+//----------------------------------------------------------------------------
+// Remove the pending deadline of a handler. Must be called with mutex held.
+//----------------------------------------------------------------------------
+
+void ts::TimerService::remove(TimerServiceHandlerInterface* handler)
+{
+    const auto it = _handlers.find(handler);
+    if (it != _handlers.end()) {
+        _deadlines.erase(it->second);
+        _handlers.erase(it);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Schedule or reschedule the timer of a handler.
+//----------------------------------------------------------------------------
+
+void ts::TimerService::schedule(TimerServiceHandlerInterface* handler, MilliSecond timeout)
+{
+    if (handler == nullptr) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // Replace the previous deadline of this handler, if any.
+    remove(handler);
+    const Clock::time_point due = Clock::now() + std::chrono::milliseconds(std::chrono::milliseconds::rep(timeout));
+    _handlers[handler] = _deadlines.insert(std::make_pair(due, handler));
+
+    if (_started) {
+        // Wake up the service thread, the earliest deadline may have changed.
+        _condition.notify_all();
+    }
+    else {
+        // Start the service thread on first use.
+        _started = true;
+        Thread::start();
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Cancel the pending timer of a handler, if any.
+//----------------------------------------------------------------------------
+
+void ts::TimerService::cancel(TimerServiceHandlerInterface* handler)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    remove(handler);
+
+    // If the handler is currently running in the service thread, wait for its
+    // completion, so that the caller can safely destruct the handler on return.
+    // Obviously don't wait when the handler cancels itself from its own code.
+    if (!isCurrentThread()) {
+        while (_executing == handler) {
+            _completed.wait(lock);
+            // The handler may have rescheduled itself while it was executing,
+            // after our initial remove(). Remove that new deadline as well, so
+            // that the handler is really never invoked again after cancel().
+            remove(handler);
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Invoked in the context of the service thread.
+//----------------------------------------------------------------------------
+
+void ts::TimerService::main()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    while (!_terminate) {
+        if (_deadlines.empty()) {
+            // Nothing to do, sleep until the deadlines change.
+            _condition.wait(lock);
+        }
+        else if (Clock::now() < _deadlines.begin()->first) {
+            // Sleep until the earliest deadline. When the deadlines change in
+            // the meantime, the condition is signaled and we reevaluate.
+            _condition.wait_until(lock, _deadlines.begin()->first);
+        }
+        else {
+            // The earliest deadline is expired, extract it.
+            TimerServiceHandlerInterface* const handler = _deadlines.begin()->second;
+            _deadlines.erase(_deadlines.begin());
+            _handlers.erase(handler);
+            _executing = handler;
+
+            // Execute the handler without holding the mutex to avoid deadlocks
+            // when the handler schedules or cancels timers.
+            lock.unlock();
+            handler->handleTimerExpiration();
+            lock.lock();
+
+            _executing = nullptr;
+            _completed.notify_all();
+        }
+    }
+}
@@ -0,0 +1,83 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Process-wide shared timer service.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsTimerServiceHandlerInterface.h"
+#include "tsSingleton.h"
+#include "tsThread.h"
+
+namespace ts {
+    //!
+    //! Process-wide shared timer service.
+    //! @ingroup thread
+    //!
+    //! All timers of the process are served by one single internal thread,
+    //! instead of one thread per timer. The thread is started on the first
+    //! scheduled timer and sleeps until the earliest deadline. An application
+    //! with many watchdogs (tsswitch with receive timeouts on many inputs for
+    //! instance) thus generates one wakeup per expiration instead of periodic
+    //! wakeups and context switches in as many idle threads.
+    //!
+    //! Each handler has at most one pending timer: scheduling again replaces
+    //! the previous deadline. Expiration handlers are executed in the context
+    //! of the service thread, one at a time.
+    //!
+    class TSDUCKDLL TimerService : private Thread
+    {
+        TS_DECLARE_SINGLETON(TimerService);
+    public:
+        //!
+        //! Destructor.
+        //!
+        virtual ~TimerService() override;
+
+        //!
+        //! Schedule or reschedule the timer of a handler.
+        //! The previous deadline of this handler, if any, is replaced.
+        //! @param [in] handler The handler to call at expiration of the timeout.
+        //! @param [in] timeout Timeout in milliseconds from now.
+        //!
+        void schedule(TimerServiceHandlerInterface* handler, MilliSecond timeout);
+
+        //!
+        //! Cancel the pending timer of a handler, if any.
+        //! When the handler is currently executing in the service thread, this
+        //! method blocks until the handler completes, unless it is invoked from
+        //! the handler itself. On return, it is guaranteed that the handler is
+        //! not and will not be invoked, until a new call to schedule().
+        //! A handler shall always cancel its timer before being destructed.
+        //! @param [in] handler The handler to cancel.
+        //!
+        void cancel(TimerServiceHandlerInterface* handler);
+
+    private:
+        // All deadlines are based on the system monotonic clock.
+        typedef std::chrono::steady_clock Clock;
+        typedef std::multimap<Clock::time_point, TimerServiceHandlerInterface*> DeadlineMap;
+
+        std::mutex               _mutex {};            // Protect the following fields.
+        std::condition_variable  _condition {};        // Signaled when the deadlines change or on termination.
+        std::condition_variable  _completed {};        // Signaled when an expiration handler returns.
+        bool                     _terminate = false;   // The service thread shall exit.
+        bool                     _started = false;     // The service thread is started.
+        DeadlineMap              _deadlines {};        // Pending timers, sorted by deadline.
+        std::map<TimerServiceHandlerInterface*, DeadlineMap::iterator> _handlers {};  // Pending timer of each handler.
+        TimerServiceHandlerInterface* _executing = nullptr;  // Handler currently running in the service thread.
+
+        // Remove the pending deadline of a handler. Must be called with mutex held.
+        void remove(TimerServiceHandlerInterface* handler);
+
+        // Implementation of Thread.
+        virtual void main() override;
+    };
+}
@@ -0,0 +1,13 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsTimerServiceHandlerInterface.h"
+
+ts::TimerServiceHandlerInterface::~TimerServiceHandlerInterface()
+{
+}
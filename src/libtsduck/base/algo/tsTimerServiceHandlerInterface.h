@@ -0,0 +1,35 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Expiration handler interface for the shared timer service.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsPlatform.h"
+
+namespace ts {
+    //!
+    //! Expiration handler interface for the shared timer service.
+    //! @ingroup thread
+    //! @see TimerService
+    //!
+    class TSDUCKDLL TimerServiceHandlerInterface
+    {
+        TS_INTERFACE(TimerServiceHandlerInterface);
+    public:
+        //!
+        //! Handle the expiration of a timer.
+        //! The handler is executed in the context of the timer service thread.
+        //! All timers of the process share this thread: the handler shall
+        //! return quickly and delegate long processing elsewhere.
+        //!
+        virtual void handleTimerExpiration() = 0;
+    };
+}
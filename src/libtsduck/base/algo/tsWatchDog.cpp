@@ -23,11 +23,9 @@ ts::WatchDog::WatchDog(ts::WatchDogHandlerInterface* handler, ts::MilliSecond ti
 
 ts::WatchDog::~WatchDog()
 {
-    // Terminate the thread and wait for actual thread termination.
-    // Does nothing if the thread has not been started.
-    _terminate = true;
-    _condition.notify_all();
-    waitForTermination();
+    // Cancel the pending timer. This blocks until a possible in-flight
+    // expiration handler completes, so that the object can be safely destructed.
+    TimerService::Instance().cancel(this);
 }
 
 
@@ -42,35 +40,26 @@ void ts::WatchDog::setWatchDogHandler(WatchDogHandlerInterface* h)
 }
 
 
-//----------------------------------------------------------------------------
-// Activate the watchdog. Must be called with mutex held.
-//----------------------------------------------------------------------------
-
-void ts::WatchDog::activate()
-{
-    if (_started) {
-        // Watchdog thread already started, signal the condition.
-        _condition.notify_all();
-    }
-    else {
-        // Start the watchdog thread.
-        _started = true;
-        Thread::start();
-    }
-}
-
-
 //----------------------------------------------------------------------------
 // Set a new timeout value.
 //----------------------------------------------------------------------------
 
 void ts::WatchDog::setTimeout(MilliSecond timeout, bool autoStart)
 {
-    std::lock_guard<std::mutex> lock(_mutex);
-    _timeout = timeout;
-    _active = autoStart;
-    if (autoStart) {
-        activate();
+    MilliSecond t = 0;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _timeout = timeout;
+        _active = autoStart;
+        t = timeout;
+    }
+    // Call the timer service without holding the mutex: the service thread may
+    // concurrently run handleTimerExpiration() which takes the mutex.
+    if (autoStart && t > 0) {
+        TimerService::Instance().schedule(this, t);
+    }
+    else {
+        TimerService::Instance().cancel(this);
     }
 }
 
@@ -81,9 +70,15 @@ void ts::WatchDog::setTimeout(MilliSecond timeout, bool autoStart)
 
 void ts::WatchDog::restart()
 {
-    std::lock_guard<std::mutex> lock(_mutex);
-    _active = true;
-    activate();
+    MilliSecond t = 0;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _active = true;
+        t = _timeout;
+    }
+    if (t > 0) {
+        TimerService::Instance().schedule(this, t);
+    }
 }
 
 
@@ -93,44 +88,48 @@ void ts::WatchDog::restart()
 
 void ts::WatchDog::suspend()
 {
-    std::lock_guard<std::mutex> lock(_mutex);
-    _active = false;
-    // Signal the condition if the thread is started.
-    // No need to activate the thread if not started.
-    _condition.notify_all();
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _active = false;
+    }
+    TimerService::Instance().cancel(this);
 }
 
 
 //----------------------------------------------------------------------------
-// Invoked in the context of the server thread.
+// Invoked in the context of the timer service thread.
 //----------------------------------------------------------------------------
 
-void ts::WatchDog::main()
+void ts::WatchDog::handleTimerExpiration()
 {
-    _log.debug(u"Watchdog thread started, id %d", {_watchDogId});
-
-    while (!_terminate) {
-        bool expired = false;
-        WatchDogHandlerInterface* h = nullptr;
-
-        // Wait for the condition to be signaled. Get protected data while under mutex protection.
-        {
-            std::unique_lock<std::mutex> lock(_mutex);
-            if (!_active || _timeout == 0) {
-                _condition.wait(lock);
-            }
-            else {
-                expired = _condition.wait_for(lock, std::chrono::milliseconds(std::chrono::milliseconds::rep(_timeout))) == std::cv_status::timeout;
-            }
-            h = _handler;
-        }
+    bool expired = false;
+    WatchDogHandlerInterface* h = nullptr;
+
+    // Get protected data under mutex protection. The watchdog may have been
+    // suspended after the expiration was already committed by the service.
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        expired = _active && _timeout > 0;
+        h = _handler;
+    }
 
-        // Handle the expiration. No longer under mutex protection to avoid deadlocks in handler.
-        if (!_terminate && expired && h != nullptr) {
-            _log.debug(u"Watchdog expired, id %d", {_watchDogId});
-            h->handleWatchDogTimeout(*this);
-        }
+    // Handle the expiration. No longer under mutex protection to avoid deadlocks in handler.
+    if (expired && h != nullptr) {
+        _log.debug(u"Watchdog expired, id %d", {_watchDogId});
+        h->handleWatchDogTimeout(*this);
     }
 
-    _log.debug(u"Watchdog thread completed, id %d", {_watchDogId});
+    // Rearm for a full timeout unless the handler suspended or restarted the
+    // watchdog. This preserves the periodic behavior of the former per-watchdog
+    // thread which kept waiting for the timeout again after an expiration.
+    MilliSecond t = 0;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_active && _timeout > 0) {
+            t = _timeout;
+        }
+    }
+    if (t > 0) {
+        TimerService::Instance().schedule(this, t);
+    }
 }
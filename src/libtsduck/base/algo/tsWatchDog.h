@@ -13,8 +13,8 @@
 
 #pragma once
 #include "tsWatchDogHandlerInterface.h"
+#include "tsTimerService.h"
 #include "tsNullReport.h"
-#include "tsThread.h"
 #include "tsReport.h"
 
 namespace ts {
@@ -27,10 +27,11 @@ namespace ts {
     //! a "next input". To avoid this, restart() or suspend() must be called before
     //! the timeout expires.
     //!
-    //! A WatchDog instance contains an internal thread which is started in the constructor
-    //! and terminated in the destructor.
+    //! All watchdogs of the process share the single thread of the TimerService,
+    //! instead of running one timer thread each. Expiration handlers are executed
+    //! in the context of that shared thread.
     //!
-    class TSDUCKDLL WatchDog : private Thread
+    class TSDUCKDLL WatchDog : private TimerServiceHandlerInterface
     {
         TS_NOCOPY(WatchDog);
     public:
@@ -91,18 +92,12 @@ namespace ts {
     private:
         Report&                   _log;                // For debug messages.
         volatile int              _watchDogId = 0;     // Application-defined watchdog identifier.
-        volatile bool             _terminate = false;  // Terminate the thread.
         std::mutex                _mutex {};           // Mutex to protect the following fields.
-        std::condition_variable   _condition {};       // Condition to signal when something changed.
         WatchDogHandlerInterface* _handler = nullptr;  // Handler for expiration.
         MilliSecond               _timeout = 0;        // Expiration timeout, 0 means no timeout.
         bool                      _active = false;     // The watchdog is active.
-        bool                      _started = false;    // The thread is started.
 
-        // Activate the watchdog. Must be called with mutex held.
-        void activate();
-
-        // Implementation of Thread.
-        virtual void main() override;
+        // Implementation of TimerServiceHandlerInterface, invoked in the timer service thread.
+        virtual void handleTimerExpiration() override;
     };
 }
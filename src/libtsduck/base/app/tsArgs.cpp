@@ -546,7 +546,7 @@ ts::UString ts::Args::formatHelpOptions(size_t line_width) const
 // Add a new option.
 //----------------------------------------------------------------------------
 
-void ts::Args::addOption(const IOption& opt)
+void ts::Args::addOption(IOption&& opt)
 {
     // Erase previous version, if any.
     _iopts.erase(opt.name);
@@ -561,8 +561,9 @@ void ts::Args::addOption(const IOption& opt)
         }
     }
 
-    // Finally add the new option.
-    _iopts.insert(std::make_pair(opt.name, opt));
+    // Finally add the new option. The key is copied before the option is moved.
+    const UString name(opt.name);
+    _iopts.insert(std::make_pair(name, std::move(opt)));
 }
 
 
@@ -599,7 +600,7 @@ ts::Args& ts::Args::copyOptions(const Args& other, const bool replace)
 {
     for (auto& it : other._iopts) {
         if ((it.second.flags & IOPT_PREDEFINED) == 0 && (replace || !Contains(_iopts, it.second.name))) {
-            addOption(it.second);
+            addOption(IOption(it.second));
         }
     }
     return *this;
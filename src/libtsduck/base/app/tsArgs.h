@@ -1289,8 +1289,8 @@ namespace ts {
         static const UChar* const THOUSANDS_SEPARATORS;
         static const UChar* const DECIMAL_POINTS;
 
-        // Add a new option.
-        void addOption(const IOption& opt);
+        // Add a new option. The option object is moved into the map, not copied.
+        void addOption(IOption&& opt);
 
         // Adjust predefined options based on flags.
         void adjustPredefinedOptions();
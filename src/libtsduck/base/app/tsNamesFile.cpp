@@ -8,11 +8,28 @@
 
 #include "tsNamesFile.h"
 #include "tsFileUtils.h"
+#include "tsSysUtils.h"
+#include "tsEnvironment.h"
+#include "tsErrCodeReport.h"
 #include "tsCerrReport.h"
 #include "tsFatal.h"
 #include "tsSingleton.h"
 
 
+//----------------------------------------------------------------------------
+// Format of the binary cache of a names file.
+//----------------------------------------------------------------------------
+
+namespace {
+    // The cache file starts with a magic number and a format version, followed
+    // by the list of source files with their modification times, the section
+    // directory and finally the entry definitions of all sections. The entry
+    // definitions of a section are decoded only when the section is used.
+    constexpr uint32_t CACHE_MAGIC = 0x54534E43;  // "TSNC"
+    constexpr uint16_t CACHE_VERSION = 1;
+}
+
+
 //----------------------------------------------------------------------------
 // Predefined names files.
 //----------------------------------------------------------------------------
@@ -215,12 +232,13 @@ ts::NamesFile::NamesFile(const UString& fileName, bool mergeExtensions) :
     if (_configFile.empty()) {
         // Cannot load configuration, names will not be available.
         _log.error(u"configuration file '%s' not found", {fileName});
-    }
-    else {
-        loadFile(_configFile);
+        return;
     }
 
-    // Merge extensions if required.
+    // Build the list of all source files: the configuration file itself,
+    // followed by the extension files when they must be merged.
+    UStringList sources;
+    sources.push_back(_configFile);
     if (mergeExtensions) {
         // Get list of extension names.
         UStringList files;
@@ -231,10 +249,24 @@ ts::NamesFile::NamesFile(const UString& fileName, bool mergeExtensions) :
                 _log.error(u"extension file '%s' not found", {name});
             }
             else {
-                loadFile(path);
+                sources.push_back(path);
             }
         }
     }
+
+    // Use the binary cache when it is enabled and up to date with the sources.
+    const UString cacheFile(BinaryCacheFile(fileName));
+    if (!cacheFile.empty() && loadBinaryCache(cacheFile, sources)) {
+        return;
+    }
+
+    // Parse the text files and regenerate the cache for the next process.
+    for (const auto& path : sources) {
+        loadFile(path);
+    }
+    if (!cacheFile.empty()) {
+        saveBinaryCache(cacheFile, sources);
+    }
 }
 
 
@@ -284,8 +316,8 @@ void ts::NamesFile::loadFile(const UString& fileName)
                 _sections.insert(std::make_pair(line, section));
             }
         }
-        else if (!decodeDefinition(line, section)) {
-            // Invalid line.
+        else if (section == nullptr) {
+            // Definition line before the first section.
             _log.error(u"%s: invalid line %d: %s", {fileName, lineNumber, line});
             if (++_configErrors >= 20) {
                 // Give up after that number of errors
@@ -293,16 +325,247 @@ void ts::NamesFile::loadFile(const UString& fileName)
                 break;
             }
         }
+        else {
+            // Keep the line as is. It will be decoded the first time the section is used.
+            section->rawLines.push_back(line);
+        }
     }
     strm.close();
 }
 
 
+//----------------------------------------------------------------------------
+// Make sure that all entries of a section are decoded (lazy loading).
+//----------------------------------------------------------------------------
+
+void ts::NamesFile::loadSection(ConfigSection* section) const
+{
+    // Fast path, without locking, when the section is already decoded.
+    if (section == nullptr || section->loaded.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_sectionMutex);
+    if (section->loaded.load(std::memory_order_relaxed)) {
+        // Decoded by another thread while waiting for the mutex.
+        return;
+    }
+
+    // Decode the entries from the binary cache.
+    const uint8_t* const data = _cacheData.data();
+    size_t off = section->cacheOffset;
+    for (size_t i = 0; i < section->cacheCount; ++i) {
+        if (off + 18 > _cacheData.size()) {
+            _configErrors++;
+            _log.error(u"%s: corrupted binary cache", {_configFile});
+            break;
+        }
+        const Value first = GetUInt64(data + off);
+        const Value last = GetUInt64(data + off + 8);
+        const size_t len = GetUInt16(data + off + 16);
+        off += 18;
+        if (off + len > _cacheData.size()) {
+            _configErrors++;
+            _log.error(u"%s: corrupted binary cache", {_configFile});
+            break;
+        }
+        section->addEntry(first, last, UString::FromUTF8(reinterpret_cast<const char*>(data + off), len));
+        off += len;
+    }
+    section->cacheCount = 0;
+
+    // Decode the definition lines from the text files.
+    for (const auto& line : section->rawLines) {
+        if (!decodeDefinition(line, section)) {
+            _log.error(u"%s: invalid line: %s", {_configFile, line});
+            if (++_configErrors >= 20) {
+                // Give up after that number of errors
+                _log.error(u"%s: too many errors, giving up", {_configFile});
+                break;
+            }
+        }
+    }
+    section->rawLines.clear();
+    section->loaded.store(true, std::memory_order_release);
+}
+
+
+//----------------------------------------------------------------------------
+// Get the path of the binary cache of a names file.
+//----------------------------------------------------------------------------
+
+ts::UString ts::NamesFile::BinaryCacheFile(const UString& fileName)
+{
+    if (!GetEnvironment(u"TSDUCK_NO_NAMES_CACHE").empty()) {
+        // The binary cache is disabled.
+        return UString();
+    }
+    const UString base(BaseName(fileName));
+    return UserConfigurationFileName(u"." + base + u".bin", base + u".bin");
+}
+
+
+//----------------------------------------------------------------------------
+// Load the binary cache if it is up to date with the source files.
+//----------------------------------------------------------------------------
+
+bool ts::NamesFile::loadBinaryCache(const UString& cacheFile, const UStringList& sourceFiles)
+{
+    // Errors are not reported: an absent or stale cache is a normal condition.
+    if (!_cacheData.loadFromFile(cacheFile)) {
+        return false;
+    }
+    const uint8_t* const data = _cacheData.data();
+    const size_t end = _cacheData.size();
+    size_t off = 0;
+
+    // Extract a length-prefixed UTF-8 string at current offset.
+    auto getString = [&](UString& str) {
+        if (off + 2 > end) {
+            return false;
+        }
+        const size_t len = GetUInt16(data + off);
+        off += 2;
+        if (off + len > end) {
+            return false;
+        }
+        str.assignFromUTF8(reinterpret_cast<const char*>(data + off), len);
+        off += len;
+        return true;
+    };
+
+    // Check the cache header.
+    bool ok = end >= 8 && GetUInt32(data) == CACHE_MAGIC && GetUInt16(data + 4) == CACHE_VERSION;
+    off = 6;
+
+    // Check that the source files and their modification times are unchanged.
+    size_t fileCount = 0;
+    if (ok && (ok = off + 2 <= end)) {
+        fileCount = GetUInt16(data + off);
+        off += 2;
+        ok = fileCount == sourceFiles.size();
+    }
+    auto src = sourceFiles.begin();
+    for (size_t i = 0; ok && i < fileCount; ++i, ++src) {
+        UString path;
+        ok = getString(path) && off + 8 <= end && path == *src &&
+             GetUInt64(data + off) == uint64_t(GetFileModificationTimeUTC(path) - Time::Epoch);
+        off += 8;
+    }
+
+    // Build the section index. The entries themselves are decoded on first use only.
+    size_t sectionCount = 0;
+    if (ok && (ok = off + 4 <= end)) {
+        sectionCount = GetUInt32(data + off);
+        off += 4;
+    }
+    for (size_t i = 0; ok && i < sectionCount; ++i) {
+        UString name;
+        UString inherit;
+        ok = getString(name) && off + 1 <= end;
+        if (ok) {
+            const uint8_t bits = data[off++];
+            ok = getString(inherit) && off + 8 <= end;
+            if (ok) {
+                ConfigSection* section = new ConfigSection;
+                CheckNonNull(section);
+                section->bits = bits;
+                section->inherit = inherit;
+                section->cacheCount = GetUInt32(data + off);
+                section->cacheOffset = GetUInt32(data + off + 4);
+                off += 8;
+                _sections.insert(std::make_pair(name, section));
+            }
+        }
+    }
+
+    // The entries area starts right after the section directory.
+    // Stored offsets are relative to the start of this area.
+    for (auto& it : _sections) {
+        it.second->cacheOffset += off;
+        ok = ok && it.second->cacheOffset <= end;
+    }
+
+    if (!ok) {
+        // Invalid or stale cache, forget it.
+        for (const auto& it : _sections) {
+            delete it.second;
+        }
+        _sections.clear();
+        _cacheData.clear();
+        return false;
+    }
+    _log.debug(u"loaded names cache %s", {cacheFile});
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Regenerate the binary cache from the fully decoded sections.
+//----------------------------------------------------------------------------
+
+void ts::NamesFile::saveBinaryCache(const UString& cacheFile, const UStringList& sourceFiles) const
+{
+    // The cache can only contain fully decoded sections.
+    for (const auto& it : _sections) {
+        loadSection(it.second);
+    }
+    if (_configErrors > 0) {
+        // Never cache invalid data.
+        return;
+    }
+
+    // Append a length-prefixed UTF-8 string to a byte block.
+    auto putString = [](ByteBlock& bb, const UString& str) {
+        const std::string utf8(str.toUTF8());
+        bb.appendUInt16(uint16_t(utf8.size()));
+        bb.append(utf8.data(), utf8.size());
+    };
+
+    // Serialize the section directory and the entries area.
+    ByteBlock dir;
+    ByteBlock entries;
+    for (const auto& it : _sections) {
+        putString(dir, it.first);
+        dir.appendUInt8(uint8_t(it.second->bits));
+        putString(dir, it.second->inherit);
+        dir.appendUInt32(uint32_t(it.second->entries.size()));
+        dir.appendUInt32(uint32_t(entries.size()));
+        for (const auto& ent : it.second->entries) {
+            entries.appendUInt64(ent.first);
+            entries.appendUInt64(ent.second->last);
+            putString(entries, ent.second->name);
+        }
+    }
+
+    // Serialize the complete cache file.
+    ByteBlock bb;
+    bb.appendUInt32(CACHE_MAGIC);
+    bb.appendUInt16(CACHE_VERSION);
+    bb.appendUInt16(uint16_t(sourceFiles.size()));
+    for (const auto& file : sourceFiles) {
+        putString(bb, file);
+        bb.appendUInt64(uint64_t(GetFileModificationTimeUTC(file) - Time::Epoch));
+    }
+    bb.appendUInt32(uint32_t(_sections.size()));
+    bb.append(dir);
+    bb.append(entries);
+
+    // Atomically replace the cache file, other processes may read it concurrently.
+    // Errors are not reported: the cache directory may not be writable.
+    const UString tmpFile(UString::Format(u"%s.tmp-%d", {cacheFile, CurrentProcessId()}));
+    if (bb.saveToFile(tmpFile)) {
+        fs::rename(tmpFile, cacheFile, &ErrCodeReport());
+        _log.debug(u"regenerated names cache %s", {cacheFile});
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Decode a line as "first[-last] = name". Return true on success.
 //----------------------------------------------------------------------------
 
-bool ts::NamesFile::decodeDefinition(const UString& line, ConfigSection* section)
+bool ts::NamesFile::decodeDefinition(const UString& line, ConfigSection* section) const
 {
     // Check the presence of the '=' and in a valid section.
     const size_t equal = line.find(UChar('='));
@@ -570,8 +833,9 @@ void ts::NamesFile::getName(const UString& sectionName, Value value, ConfigSecti
             return;
         }
 
-        // Get the name of the value in the section.
+        // Get the name of the value in the section, decoding the section first if necessary.
         section = it->second;
+        loadSection(section);
         name = section->getName(value);
 
         // Return when name found or no "superclass" or too many levels of inheritance.
@@ -13,6 +13,7 @@
 
 #pragma once
 #include "tsUString.h"
+#include "tsByteBlock.h"
 #include "tsEnumUtils.h"
 #include "tsReport.h"
 #include "tsVersionInfo.h"
@@ -43,6 +44,12 @@ namespace ts {
     //!
     //! Representation of a ".names" file, containing names for identifiers.
     //! In an instance of NamesFile, all names are loaded from one configuration file.
+    //!
+    //! To speed up the startup of short-lived commands, a binary cache of each
+    //! decoded file is maintained in the user's configuration area and the
+    //! sections are lazily decoded, the first time they are actually used.
+    //! The cache is automatically regenerated when a source file is modified.
+    //! Define the environment variable TSDUCK_NO_NAMES_CACHE to disable it.
     //! @ingroup app
     //!
     class TSDUCKDLL NamesFile
@@ -124,6 +131,8 @@ namespace ts {
 
         //!
         //! Get the number of errors in the configuration file.
+        //! Since sections are lazily decoded, errors can be detected after
+        //! construction, when a section is used for the first time.
         //! @return The number of errors in the configuration file.
         //!
         size_t errorCount() const { return _configErrors; }
@@ -218,9 +227,13 @@ namespace ts {
         {
             TS_NOCOPY(ConfigSection);
         public:
-            size_t          bits = 0;     // Number of significant bits in values of the type.
-            ConfigEntryMap  entries {};   // All entries, indexed by names.
-            UString         inherit {};   // Redirect to this section if value not found.
+            size_t          bits = 0;         // Number of significant bits in values of the type.
+            ConfigEntryMap  entries {};       // All entries, indexed by names.
+            UString         inherit {};       // Redirect to this section if value not found.
+            UStringList     rawLines {};      // Undecoded definition lines (lazy loading from text file).
+            size_t          cacheOffset = 0;  // Offset of undecoded entries in the binary cache.
+            size_t          cacheCount = 0;   // Number of undecoded entries in the binary cache.
+            std::atomic<bool> loaded {false}; // All entries are decoded.
 
             ConfigSection() = default;
             ~ConfigSection();
@@ -239,7 +252,7 @@ namespace ts {
         typedef std::map<UString, ConfigSection*> ConfigSectionMap;
 
         // Decode a line as "first[-last] = name". Return true on success, false on error.
-        bool decodeDefinition(const UString& line, ConfigSection* section);
+        bool decodeDefinition(const UString& line, ConfigSection* section) const;
 
         // Compute a number of hexa digits.
         static int HexaDigits(size_t bits);
@@ -248,8 +261,21 @@ namespace ts {
         static Value DisplayMask(size_t bits);
 
         // Load a configuration file and merge its content into this instance.
+        // The definition lines are kept undecoded until the sections are used.
         void loadFile(const UString& fileName);
 
+        // Make sure that all entries of a section are decoded (lazy loading).
+        void loadSection(ConfigSection* section) const;
+
+        // Get the path of the binary cache of a names file. Empty if the cache is disabled.
+        static UString BinaryCacheFile(const UString& fileName);
+
+        // Load the binary cache if it is up to date with the source files. Return false otherwise.
+        bool loadBinaryCache(const UString& cacheFile, const UStringList& sourceFiles);
+
+        // Regenerate the binary cache from the fully decoded sections.
+        void saveBinaryCache(const UString& cacheFile, const UStringList& sourceFiles) const;
+
         // Get the section and name from a value, empty if not found. Section can be null.
         void getName(const UString& sectionName, Value value, ConfigSection*& section, UString& name) const;
 
@@ -257,10 +283,12 @@ namespace ts {
         static UString NormalizedSectionName(const UString& sectionName) { return sectionName.toTrimmed().toLower(); }
 
         // Names private fields.
-        Report&          _log;               // Error logger.
-        const UString    _configFile;        // Configuration file path.
-        size_t           _configErrors = 0;  // Number of errors in configuration file.
-        ConfigSectionMap _sections {};       // Configuration sections.
+        Report&            _log;               // Error logger.
+        const UString      _configFile;        // Configuration file path.
+        mutable size_t     _configErrors = 0;  // Number of errors in configuration file.
+        ConfigSectionMap   _sections {};       // Configuration sections.
+        ByteBlock          _cacheData {};      // Content of the binary cache file.
+        mutable std::mutex _sectionMutex {};   // Protects lazy decoding of sections.
     };
 
     //!
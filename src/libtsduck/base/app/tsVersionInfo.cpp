@@ -126,6 +126,22 @@ void ts::VersionInfo::startNewVersionDetection()
         return;
     }
 
+    // Start the thread. All file system and network accesses are performed in
+    // the thread, to keep them off the startup path of the calling application.
+    _started = start();
+
+#endif
+}
+
+
+//----------------------------------------------------------------------------
+// Execute in the context of the thread.
+//----------------------------------------------------------------------------
+
+void ts::VersionInfo::main()
+{
+#if !defined(TS_NO_GITHUB)
+
     // Do not check new version more than once a day.
     // We create an empty more-or-less-hidden empty file at the same place as the
     // TSDuck configuration file. The creation time of this file is the last check time.
@@ -146,21 +162,6 @@ void ts::VersionInfo::startNewVersionDetection()
         _debug.error(u"error creating file %s", {filename});
     }
 
-    // Start the thread.
-    _started = start();
-
-#endif
-}
-
-
-//----------------------------------------------------------------------------
-// Execute in the context of the thread.
-//----------------------------------------------------------------------------
-
-void ts::VersionInfo::main()
-{
-#if !defined(TS_NO_GITHUB)
-
     // Get new version from GitHub.
     const ts::GitHubRelease rel(u"tsduck", u"tsduck", UString(), _debug);
 
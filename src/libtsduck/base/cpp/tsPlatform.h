@@ -930,6 +930,28 @@ namespace fs = std::filesystem;
     #error "New unknown compiler, please update TS_NO_OPTIMIZE in tsPlatform.h"
 #endif
 
+//!
+//! Prefetch a memory address into the data caches.
+//!
+//! This is a hint only. On compilers without a prefetch builtin, the macro
+//! does nothing. Used in a few performance-critical loops to fetch the next
+//! item while the current one is processed.
+//!
+//! Example:
+//! @code
+//! TS_PREFETCH(&buffer[i + 1]);
+//! @endcode
+//!
+//! @param addr Address of the data to prefetch.
+//!
+#if defined(DOXYGEN)
+    #define TS_PREFETCH(addr) platform_specific
+#elif defined(TS_GCC)
+    #define TS_PREFETCH(addr) __builtin_prefetch(addr)
+#else
+    #define TS_PREFETCH(addr) do {} while (false)
+#endif
+
 //!
 //! Definition of the name of the current function.
 //! This is typically __func__ but recent compilers have "pretty" names for C++.
@@ -84,30 +84,308 @@ bool ts::json::IsInlineJSON(const UString& name)
 }
 
 
+//----------------------------------------------------------------------------
+// Internal fast parser for complete in-memory JSON documents.
+// The generic TextParser-based Parse() processes the text token by token and
+// builds intermediate strings for each of them, which dominates the parsing
+// time on multi-megabyte inputs. When the complete document is available in
+// memory, this single-pass lexer directly scans the characters and extracts
+// string and number literals in one slice each.
+//----------------------------------------------------------------------------
+
+namespace {
+    class DocumentParser
+    {
+        TS_NOBUILD_NOCOPY(DocumentParser);
+    public:
+        // Constructor on a complete in-memory document.
+        DocumentParser(const ts::UString& text, ts::Report& report) :
+            _cur(text.data()),
+            _end(text.data() + text.size()),
+            _report(report)
+        {
+        }
+
+        // Parse the complete document. Only spaces are allowed after the value.
+        bool parse(ts::json::ValuePtr& value);
+
+    private:
+        const ts::UChar*       _cur;       // Current position in the document.
+        const ts::UChar* const _end;       // End of document.
+        size_t                 _line = 1;  // Current line number, for error messages.
+        ts::Report&            _report;    // Where to report errors.
+
+        // Skip spaces, update the line number.
+        void skipSpace()
+        {
+            while (_cur < _end && ts::IsSpace(*_cur)) {
+                if (*_cur == ts::LINE_FEED) {
+                    _line++;
+                }
+                ++_cur;
+            }
+        }
+
+        // Match a literal keyword, advance the position when it matches.
+        bool match(const ts::UChar* keyword)
+        {
+            const ts::UChar* p = _cur;
+            while (*keyword != 0) {
+                if (p >= _end || *p++ != *keyword++) {
+                    return false;
+                }
+            }
+            _cur = p;
+            return true;
+        }
+
+        // Parse one JSON value at the current position.
+        bool parseValue(ts::json::ValuePtr& value);
+
+        // Parse a string literal at the current position.
+        bool parseString(ts::UString& str);
+    };
+}
+
+
+//----------------------------------------------------------------------------
+// Fast parser: parse a string literal at the current position.
+//----------------------------------------------------------------------------
+
+bool DocumentParser::parseString(ts::UString& str)
+{
+    // JSON strings always start with a double quote.
+    if (_cur >= _end || *_cur != u'"') {
+        return false;
+    }
+    const ts::UChar* const start = ++_cur;
+    bool has_escape = false;
+
+    while (_cur < _end) {
+        const ts::UChar c = *_cur;
+        if (c == u'"') {
+            // End of string, extract the body in one slice.
+            str.assign(start, _cur - start);
+            ++_cur;
+            if (has_escape) {
+                str.convertFromJSON();
+            }
+            return true;
+        }
+        if (c == ts::LINE_FEED || c == ts::CARRIAGE_RETURN) {
+            // String literals must be closed on the same line.
+            return false;
+        }
+        if (c == u'\\') {
+            // Skip the character after backslash, decoded later in one pass.
+            has_escape = true;
+            ++_cur;
+            if (_cur >= _end) {
+                return false;
+            }
+        }
+        ++_cur;
+    }
+    return false;
+}
+
+
+//----------------------------------------------------------------------------
+// Fast parser: parse one JSON value at the current position.
+//----------------------------------------------------------------------------
+
+bool DocumentParser::parseValue(ts::json::ValuePtr& value)
+{
+    using namespace ts;
+
+    // Leading spaces are ignored.
+    skipSpace();
+    const UChar c = _cur < _end ? *_cur : CHAR_NULL;
+    UString str;
+
+    // Look for one of the seven possible forms or JSON value.
+    if (c == u'n' && match(u"null")) {
+        value = new json::Null;
+    }
+    else if (c == u't' && match(u"true")) {
+        value = new json::True;
+    }
+    else if (c == u'f' && match(u"false")) {
+        value = new json::False;
+    }
+    else if (c == u'"' && parseString(str)) {
+        value = new json::String(str);
+    }
+    else if (c == u'-' || IsDigit(c)) {
+        // Scan a numeric literal according to the JSON grammar.
+        const UChar* const start = _cur;
+        if (c == u'-') {
+            ++_cur;
+        }
+        while (_cur < _end && IsDigit(*_cur)) {
+            ++_cur;
+        }
+        if (_cur < _end && *_cur == u'.') {
+            ++_cur;
+            while (_cur < _end && IsDigit(*_cur)) {
+                ++_cur;
+            }
+        }
+        if (_cur < _end && (*_cur == u'e' || *_cur == u'E')) {
+            ++_cur;
+            if (_cur < _end && (*_cur == u'+' || *_cur == u'-')) {
+                ++_cur;
+            }
+            while (_cur < _end && IsDigit(*_cur)) {
+                ++_cur;
+            }
+        }
+        str.assign(start, _cur - start);
+        int64_t intVal = 0;
+        double floatVal = 0.0;
+        if (str.toInteger(intVal, UString::DEFAULT_THOUSANDS_SEPARATOR)) {
+            value = new json::Number(intVal);
+        }
+        else if (str.toFloat(floatVal)) {
+            value = new json::Number(floatVal);
+        }
+        else {
+            // Invalid integer,
+            _report.error(u"line %d: JSON floating-point numbers not yet supported, using \"null\" instead", {_line});
+            value = new json::Null;
+        }
+    }
+    else if (c == u'{') {
+        // Parse an object.
+        ++_cur;
+        value = new json::Object;
+        // Loop on all fields of the object.
+        for (;;) {
+            skipSpace();
+            // Exit at end of object.
+            if (_cur < _end && *_cur == u'}') {
+                ++_cur;
+                break;
+            }
+            UString name;
+            json::ValuePtr element;
+            if (!parseString(name)) {
+                return false;
+            }
+            skipSpace();
+            if (_cur >= _end || *_cur != u':') {
+                return false;
+            }
+            ++_cur;
+            if (!parseValue(element)) {
+                return false;
+            }
+            // Found field.
+            value->add(name, element);
+            skipSpace();
+            // Exit at end of object.
+            if (_cur < _end && *_cur == u'}') {
+                ++_cur;
+                break;
+            }
+            // Expect a comma before next field.
+            if (_cur >= _end || *_cur != u',') {
+                _report.error(u"line %d: syntax error in JSON object, missing ','", {_line});
+                return false;
+            }
+            ++_cur;
+        }
+    }
+    else if (c == u'[') {
+        // Parse an array.
+        ++_cur;
+        value = new json::Array;
+        // Loop on all elements of the array.
+        for (;;) {
+            skipSpace();
+            // Exit at end of array.
+            if (_cur < _end && *_cur == u']') {
+                ++_cur;
+                break;
+            }
+            json::ValuePtr element;
+            if (!parseValue(element)) {
+                return false;
+            }
+            // Found an element.
+            value->set(element);
+            skipSpace();
+            // Exit at end of array.
+            if (_cur < _end && *_cur == u']') {
+                ++_cur;
+                break;
+            }
+            // Expect a comma before next element.
+            if (_cur >= _end || *_cur != u',') {
+                _report.error(u"line %d: syntax error in JSON array, missing ','", {_line});
+                return false;
+            }
+            ++_cur;
+        }
+    }
+    else {
+        _report.error(u"line %d: not a valid JSON value", {_line});
+        return false;
+    }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Fast parser: parse the complete document.
+//----------------------------------------------------------------------------
+
+bool DocumentParser::parse(ts::json::ValuePtr& value)
+{
+    value.clear();
+    if (!parseValue(value)) {
+        return false;
+    }
+    // Nothing is allowed after the JSON value.
+    skipSpace();
+    if (_cur < _end) {
+        _report.error(u"line %d: extraneous text after JSON value", {_line});
+        return false;
+    }
+    return true;
+}
+
+
 //----------------------------------------------------------------------------
 // Load a JSON value (typically an object or array) from a text file.
 //----------------------------------------------------------------------------
 
 bool ts::json::LoadFile(ValuePtr& value, const UString& filename, Report& report)
 {
-    TextParser parser(report);
-    bool ok = true;
     if (filename.empty() || filename == u"-") {
-        ok = parser.loadStream(std::cin);
+        return LoadStream(value, std::cin, report);
     }
     else if (IsInlineJSON(filename)) {
-        parser.loadDocument(filename);
+        return Parse(value, filename, report);
     }
     else {
-        ok = parser.loadFile(filename);
+        UStringList lines;
+        if (!UString::Load(lines, filename)) {
+            report.error(u"error reading file %s", {filename});
+            return false;
+        }
+        return Parse(value, lines, report);
     }
-    return ok && Parse(value, parser, true, report);
 }
 
 bool ts::json::LoadStream(ValuePtr& value, std::istream& strm, Report& report)
 {
-    TextParser parser(report);
-    return parser.loadStream(strm) && Parse(value, parser, true, report);
+    UStringList lines;
+    if (!UString::Load(lines, strm)) {
+        report.error(u"error reading input document");
+        return false;
+    }
+    return Parse(value, lines, report);
 }
 
 
@@ -117,14 +395,13 @@ bool ts::json::LoadStream(ValuePtr& value, std::istream& strm, Report& report)
 
 bool ts::json::Parse(ValuePtr& value, const UStringList& lines, Report& report)
 {
-    TextParser parser(lines, report);
-    return Parse(value, parser, true, report);
+    return Parse(value, UString::Join(lines, u"\n"), report);
 }
 
 bool ts::json::Parse(ValuePtr& value, const UString& text, Report& report)
 {
-    TextParser parser(text, report);
-    return Parse(value, parser, true, report);
+    DocumentParser parser(text, report);
+    return parser.parse(value);
 }
 
 bool ts::json::Parse(ValuePtr& value, TextParser& parser, bool jsonOnly, Report& report)
@@ -66,6 +66,7 @@ bool ts::PcapFile::open(const UString& filename, Report& report)
         }
         _in = &std::cin;
         _name = u"standard input";
+        _seekable = false;
     }
     else {
         _file.open(filename.toUTF8().c_str(), std::ios::in | std::ios::binary);
@@ -75,6 +76,7 @@ bool ts::PcapFile::open(const UString& filename, Report& report)
         }
         _in = &_file;
         _name = filename;
+        _seekable = true;
     }
 
     // Read the file header, starting with a 4-byte "magic" number.
@@ -134,6 +136,34 @@ bool ts::PcapFile::readall(uint8_t* data, size_t size, Report& report)
 }
 
 
+//----------------------------------------------------------------------------
+// Move the read position, forward by "size" bytes or to an absolute position.
+//----------------------------------------------------------------------------
+
+bool ts::PcapFile::skipBytes(size_t size, Report& report)
+{
+    if (size > 0 && !_in->seekg(std::streamoff(size), std::ios::cur)) {
+        report.error(u"error seeking in %s", {_name});
+        return error(report);
+    }
+    const std::ios::pos_type fpos = _in->tellg();
+    if (fpos != std::ios::pos_type(-1)) {
+        _file_size = uint64_t(fpos);
+    }
+    return true;
+}
+
+bool ts::PcapFile::seekTo(std::ios::pos_type pos, Report& report)
+{
+    if (!_in->seekg(pos)) {
+        report.error(u"error seeking in %s", {_name});
+        return error(report);
+    }
+    _file_size = uint64_t(pos);
+    return true;
+}
+
+
 //----------------------------------------------------------------------------
 // Read a file header, starting from a magic which was read as big endian.
 //----------------------------------------------------------------------------
@@ -298,6 +328,144 @@ bool ts::PcapFile::readNgBlockBody(uint32_t block_type, ByteBlock& body, Report&
 }
 
 
+//----------------------------------------------------------------------------
+// Convert a pcap-ng packet block timestamp into microseconds.
+//----------------------------------------------------------------------------
+
+ts::MicroSecond ts::PcapFile::ngTimestamp(size_t if_index, uint32_t high, uint32_t low) const
+{
+    if (if_index >= _if.size() || _if[if_index].time_units == 0) {
+        return -1;
+    }
+    const SubSecond units = _if[if_index].time_units;
+    const SubSecond tstamp = SubSecond(uint64_t(high) << 32) + SubSecond(low);
+    // Take care to overflow in tstamp * MilliSecPerSec. Sometimes, the timestamp is a full time
+    // since 1970 with time unit being 1,000,000,000. The value is close to the 64-bit max.
+    if (units == MicroSecPerSec) {
+        return tstamp;
+    }
+    else if (units > MicroSecPerSec && units % MicroSecPerSec == 0) {
+        return tstamp / (units / MicroSecPerSec);
+    }
+    else if (units < MicroSecPerSec && MicroSecPerSec % units == 0) {
+        return tstamp * (MicroSecPerSec / units);
+    }
+    else if (mul_overflow(tstamp, MicroSecPerSec, tstamp * MicroSecPerSec)) {
+        return SubSecond((double(tstamp) * double(MicroSecPerSec)) / double(units));
+    }
+    else {
+        return (tstamp * MicroSecPerSec) / units;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Fast-forward up to the first packet at or after the given timestamp.
+//----------------------------------------------------------------------------
+
+bool ts::PcapFile::seekToTimestamp(MicroSecond timestamp, Report& report)
+{
+    // Check that the file is open.
+    if (_in == nullptr) {
+        report.error(u"no pcap file open");
+        return false;
+    }
+    if (_error) {
+        return false;
+    }
+    if (!_seekable) {
+        report.debug(u"%s is not seekable, cannot fast-forward", {_name});
+        return true;
+    }
+
+    // Loop on data blocks until one packet block reaches the timestamp.
+    for (;;) {
+
+        // Remember the position of the current block.
+        const std::ios::pos_type block_pos = _in->tellg();
+        if (block_pos == std::ios::pos_type(-1)) {
+            report.error(u"error seeking in %s", {_name});
+            return error(report);
+        }
+
+        if (_ng) {
+            // Pcap-ng file, read block type and total length.
+            uint8_t header[8];
+            if (!readall(header, sizeof(header), report)) {
+                return error(report);
+            }
+            const uint32_t type = get32(header);
+            if (type == PCAPNG_SECTION_HEADER) {
+                // Restart a new section, maybe with another endianness. The length
+                // field is in the new byte order, reread it in readHeader().
+                if (!seekTo(block_pos + std::ios::off_type(4), report) || !readHeader(type, report)) {
+                    return error(report);
+                }
+                continue;
+            }
+            const size_t size = get32(header + 4);
+            if (size % 4 != 0 || size < 12) {
+                return error(report, u"invalid pcap-ng block length %d in %s", {size, _name});
+            }
+            if (type == PCAPNG_INTERFACE_DESC) {
+                // Interface descriptions are needed, process them normally.
+                if (!seekTo(block_pos + std::ios::off_type(4), report) || !readNgBlockBody(type, _buffer, report)) {
+                    return error(report);
+                }
+                if (!analyzeNgInterface(_buffer.data(), _buffer.size(), report)) {
+                    return error(report);
+                }
+                continue;
+            }
+            if (type == PCAPNG_ENHANCED_PACKET || type == PCAPNG_OBSOLETE_PACKET) {
+                // Read interface id and timestamp only, 12 bytes at start of block body.
+                uint8_t tsfield[12];
+                if (size < 12 + sizeof(tsfield) || !readall(tsfield, sizeof(tsfield), report)) {
+                    return error(report);
+                }
+                const size_t if_index = type == PCAPNG_OBSOLETE_PACKET ? get16(tsfield) : get32(tsfield);
+                MicroSecond block_time = ngTimestamp(if_index, get32(tsfield + 4), get32(tsfield + 8));
+                if (block_time >= 0 && if_index < _if.size()) {
+                    block_time += _if[if_index].time_offset;
+                }
+                if (block_time >= timestamp) {
+                    // Done, let the next readIPv4() parse this block.
+                    return seekTo(block_pos, report);
+                }
+                // Skip the rest of the block without reading the packet data.
+                if (!skipBytes(size - 8 - sizeof(tsfield), report)) {
+                    return false;
+                }
+                continue;
+            }
+            // Any other block, including simple packet blocks without timestamp, is skipped.
+            if (!skipBytes(size - 8, report)) {
+                return false;
+            }
+        }
+        else {
+            // Pcap file, read the 16-byte packet record header.
+            uint8_t header[16];
+            if (!readall(header, sizeof(header), report)) {
+                return error(report);
+            }
+            const MicroSecond block_time =
+                (MicroSecond(get32(header)) * MicroSecPerSec) +
+                (SubSecond(get32(header + 4)) * MicroSecPerSec) / _if[0].time_units +
+                _if[0].time_offset;
+            if (block_time >= timestamp) {
+                // Done, let the next readIPv4() parse this record.
+                return seekTo(block_pos, report);
+            }
+            // Skip the captured packet data.
+            if (!skipBytes(get32(header + 8), report)) {
+                return false;
+            }
+        }
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Read the next IPv4 packet (headers included).
 //----------------------------------------------------------------------------
@@ -323,9 +491,9 @@ bool ts::PcapFile::readIPv4(IPv4Packet& packet, MicroSecond& timestamp, Report&
     // Loop on file blocks until an IPv4 packet is found.
     for (;;) {
 
-        // The captured packet will go there.
-        ByteBlock buffer;
-        size_t cap_start = 0;  // captured packet start index in buffer
+        // The captured packet will go in _buffer, which is reused from packet
+        // to packet to avoid a memory allocation per packet.
+        size_t cap_start = 0;  // captured packet start index in _buffer
         size_t cap_size = 0;   // captured packet size
         size_t orig_size = 0;  // original packet size (on network)
         size_t if_index = 0;   // interface index
@@ -347,49 +515,29 @@ bool ts::PcapFile::readIPv4(IPv4Packet& packet, MicroSecond& timestamp, Report&
                 continue; // loop to next packet block
             }
             // Read one data block.
-            if (!readNgBlockBody(type, buffer, report)) {
+            if (!readNgBlockBody(type, _buffer, report)) {
                 return error(report);
             }
             if (type == PCAPNG_INTERFACE_DESC) {
                 // Process an interface description.
-                if (!analyzeNgInterface(buffer.data(), buffer.size(), report)) {
+                if (!analyzeNgInterface(_buffer.data(), _buffer.size(), report)) {
                     return error(report);
                 }
                 continue; // loop to next packet block
             }
-            else if ((type == PCAPNG_ENHANCED_PACKET || type == PCAPNG_OBSOLETE_PACKET) && buffer.size() >= 20) {
+            else if ((type == PCAPNG_ENHANCED_PACKET || type == PCAPNG_OBSOLETE_PACKET) && _buffer.size() >= 20) {
                 _packet_count++;
                 cap_start = 20;
-                cap_size = std::min<size_t>(get32(buffer.data() + 12), buffer.size() - 20);
-                orig_size = get32(buffer.data() + 16);
-                if_index = type == PCAPNG_OBSOLETE_PACKET ? get16(buffer.data()) : get32(buffer.data());
-                if (if_index < _if.size() && _if[if_index].time_units != 0) {
-                    const SubSecond units = _if[if_index].time_units;
-                    const SubSecond tstamp = SubSecond(uint64_t(get32(buffer.data() + 4)) << 32) + SubSecond(get32(buffer.data() + 8));
-                    // Take care to overflow in tstamp * MilliSecPerSec. Sometimes, the timestamp is a full time
-                    // since 1970 with time unit being 1,000,000,000. The value is close to the 64-bit max.
-                    if (units == MicroSecPerSec) {
-                        timestamp = tstamp;
-                    }
-                    else if (units > MicroSecPerSec && units % MicroSecPerSec == 0) {
-                        timestamp = tstamp / (units / MicroSecPerSec);
-                    }
-                    else if (units < MicroSecPerSec && MicroSecPerSec % units == 0) {
-                        timestamp = tstamp * (MicroSecPerSec / units);
-                    }
-                    else if (mul_overflow(tstamp, MicroSecPerSec, tstamp * MicroSecPerSec)) {
-                        timestamp = SubSecond((double(tstamp) * double(MicroSecPerSec)) / double(units));
-                    }
-                    else {
-                        timestamp = (tstamp * MicroSecPerSec) / units;
-                    }
-                }
+                cap_size = std::min<size_t>(get32(_buffer.data() + 12), _buffer.size() - 20);
+                orig_size = get32(_buffer.data() + 16);
+                if_index = type == PCAPNG_OBSOLETE_PACKET ? get16(_buffer.data()) : get32(_buffer.data());
+                timestamp = ngTimestamp(if_index, get32(_buffer.data() + 4), get32(_buffer.data() + 8));
             }
-            else if (type == PCAPNG_SIMPLE_PACKET && buffer.size() >= 4) {
+            else if (type == PCAPNG_SIMPLE_PACKET && _buffer.size() >= 4) {
                 _packet_count++;
                 cap_start = 4;
-                orig_size = get32(buffer.data());
-                cap_size = std::min(orig_size, buffer.size() - 4);
+                orig_size = get32(_buffer.data());
+                cap_size = std::min(orig_size, _buffer.size() - 4);
             }
             else {
                 // This data block does not contain a captured packet, ignore it.
@@ -412,8 +560,8 @@ bool ts::PcapFile::readIPv4(IPv4Packet& packet, MicroSecond& timestamp, Report&
             timestamp = (MicroSecond(tstamp) * MicroSecPerSec) + (SubSecond(sub_tstamp) * MicroSecPerSec) / _if[0].time_units;
 
             // Read packet data.
-            buffer.resize(cap_size);
-            if (!readall(buffer.data(), buffer.size(), report)) {
+            _buffer.resize(cap_size);
+            if (!readall(_buffer.data(), _buffer.size(), report)) {
                 return error(report);
             }
         }
@@ -439,21 +587,21 @@ bool ts::PcapFile::readIPv4(IPv4Packet& packet, MicroSecond& timestamp, Report&
         }
 
         report.log(2, u"pcap data block: %d bytes, captured packet at offset %d, %d bytes (original: %d bytes), link type: %d",
-                   {buffer.size(), cap_start, cap_size, orig_size, ifd.link_type});
+                   {_buffer.size(), cap_start, cap_size, orig_size, ifd.link_type});
 
         // Analyze the captured packet, trying to find an IPv4 datagram.
-        if (ifd.link_type == LINKTYPE_NULL && cap_size > 4 && get32(buffer.data() + cap_start) == 2) {
+        if (ifd.link_type == LINKTYPE_NULL && cap_size > 4 && get32(_buffer.data() + cap_start) == 2) {
             // BSD loopback encapsulation; the link layer header is a 4-byte field, in host byte order, containing 2 for IPv4 packets.
             cap_start += 4;
             cap_size -= 4;
         }
-        else if (ifd.link_type == LINKTYPE_LOOP && cap_size > 4 && GetUInt32BE(buffer.data() + cap_start) == 2) {
+        else if (ifd.link_type == LINKTYPE_LOOP && cap_size > 4 && GetUInt32BE(_buffer.data() + cap_start) == 2) {
             // OpenBSD loopback encapsulation; the link-layer header is a 4-byte field, in network byte order, containing 2 for IPv4 packets/
             cap_start += 4;
             cap_size -= 4;
         }
         else if ((ifd.link_type == LINKTYPE_ETHERNET || ifd.link_type == LINKTYPE_NULL || ifd.link_type == LINKTYPE_LOOP) &&
-                 cap_size > ETHER_HEADER_SIZE + ifd.fcs_size && GetUInt16BE(buffer.data() + cap_start + ETHER_TYPE_OFFSET) == ETHERTYPE_IPv4)
+                 cap_size > ETHER_HEADER_SIZE + ifd.fcs_size && GetUInt16BE(_buffer.data() + cap_start + ETHER_TYPE_OFFSET) == ETHERTYPE_IPv4)
         {
             // Ethernet frame: 14-byte header: destination MAC (6 bytes), source MAC (6 bytes), ether type (2 bytes, 0x0800 for IPv4).
             // This should apply to LINKTYPE_ETHERNET only. However, in some pcap files (not pcap-ng), it has been noticed that
@@ -461,7 +609,7 @@ bool ts::PcapFile::readIPv4(IPv4Packet& packet, MicroSecond& timestamp, Report&
             cap_start += ETHER_HEADER_SIZE;
             cap_size -= ETHER_HEADER_SIZE + ifd.fcs_size;
         }
-        else if (ifd.link_type == LINKTYPE_RAW && cap_size >= IPv4_MIN_HEADER_SIZE && (buffer[cap_start] >> 4) == 4) {
+        else if (ifd.link_type == LINKTYPE_RAW && cap_size >= IPv4_MIN_HEADER_SIZE && (_buffer[cap_start] >> 4) == 4) {
             // Raw IPv4 or IPv6 header (version in first byte), no encopsulation.
         }
         else {
@@ -471,7 +619,11 @@ bool ts::PcapFile::readIPv4(IPv4Packet& packet, MicroSecond& timestamp, Report&
 
         // A possible IPv4 datagram was found.
         if (cap_size > 0) {
-            if (packet.reset(buffer.data() + cap_start, cap_size)) {
+            // Give subclasses a chance to discard the packet before copying it.
+            if (!preFilterIPv4(_buffer.data() + cap_start, cap_size)) {
+                continue; // loop to next packet block
+            }
+            if (packet.reset(_buffer.data() + cap_start, cap_size)) {
                 _ipv4_packet_count++;
                 _ipv4_packets_size += cap_size;
                 return true;
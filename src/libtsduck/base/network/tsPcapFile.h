@@ -14,6 +14,7 @@
 #pragma once
 #include "tsReport.h"
 #include "tsMemory.h"
+#include "tsByteBlock.h"
 #include "tsTime.h"
 #include "tsIPv4Packet.h"
 #include "tsPcap.h"
@@ -144,12 +145,40 @@ namespace ts {
         //!
         static Time ToTime(MicroSecond timestamp) { return timestamp < 0 ? Time::Epoch : Time::UnixEpoch + (timestamp / MicroSecPerMilliSec); }
 
+        //!
+        //! Fast-forward the file up to the first packet at or after the given timestamp.
+        //! Packet blocks before @a timestamp are skipped at block level: only the block
+        //! headers and timestamps are read, the packet data are bypassed with a file seek
+        //! and are neither parsed nor counted in the packet and size statistics.
+        //! Interface descriptions and section headers found on the way are still processed.
+        //! Packet blocks without timestamps (pcap-ng simple packet blocks) are considered
+        //! as preceding the target and are skipped. This method does nothing when the
+        //! input is not seekable (standard input).
+        //! @param [in] timestamp Target timestamp in microseconds since Unix epoch.
+        //! @param [in,out] report Where to report errors.
+        //! @return True on success, false on error.
+        //!
+        virtual bool seekToTimestamp(MicroSecond timestamp, Report& report);
+
         //!
         //! Close the file.
         //! Do not reset counters, file names, etc. The last values before close() are still accessible.
         //!
         virtual void close();
 
+    protected:
+        //!
+        //! Pre-filtering hook for subclasses.
+        //! This method is invoked on each captured IPv4 datagram, before copying it
+        //! into an IPv4Packet object. A subclass may override it to discard packets
+        //! from a simple inspection of the raw IPv4 header, avoiding the copy and
+        //! the validation of unselected packets.
+        //! @param [in] data Address of the raw IPv4 datagram, headers included.
+        //! @param [in] size Size in bytes of the raw IPv4 datagram.
+        //! @return True to keep the packet, false to discard it.
+        //!
+        virtual bool preFilterIPv4(const uint8_t* data, size_t size) { return true; }
+
     private:
         // Descriptioon of one capture interface.
         // Pcap files have only one interface, pcap-ng files may have more.
@@ -164,6 +193,7 @@ namespace ts {
         };
 
         bool          _error = false;          // Error was set, may be logical error, not a file error.
+        bool          _seekable = false;       // The input stream is a regular file, positioning is possible.
         std::istream* _in = nullptr;           // Point to actual input stream.
         std::ifstream _file {};                // Input file (when it is a named file).
         UString       _name {};                // Saved file name for messages.
@@ -178,6 +208,7 @@ namespace ts {
         uint64_t      _ipv4_packets_size = 0;  // Total size in bytes of captured IPv4 packets.
         MicroSecond   _first_timestamp {-1};   // Timestamp of first packet in file.
         MicroSecond   _last_timestamp {-1};    // Timestamp of last packet in file.
+        ByteBlock     _buffer {};              // Data block read buffer, reused from packet to packet.
         std::vector<InterfaceDesc> _if {};     // Capture interfaces by index, only one in pcap files.
 
         // Report an error (if fmt is not empty), set error indicator, return false.
@@ -186,6 +217,14 @@ namespace ts {
         // Read exactly "size" bytes. Return false if not enough bytes before eof.
         bool readall(uint8_t* data, size_t size, Report& report);
 
+        // Move the read position, forward by "size" bytes or to an absolute position.
+        bool skipBytes(size_t size, Report& report);
+        bool seekTo(std::ios::pos_type pos, Report& report);
+
+        // Convert a pcap-ng packet block timestamp into microseconds, -1 if not available.
+        // The interface time offset is not included.
+        MicroSecond ngTimestamp(size_t if_index, uint32_t high, uint32_t low) const;
+
         // Read a file / section header, starting from a magic number which was read as big endian.
         bool readHeader(uint32_t magic, Report& report);
 
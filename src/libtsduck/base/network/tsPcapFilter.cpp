@@ -194,12 +194,65 @@ bool ts::PcapFilter::open(const UString& filename, Report& report)
 }
 
 
+//----------------------------------------------------------------------------
+// Pre-filter an IPv4 packet on the raw datagram, inherited method.
+//----------------------------------------------------------------------------
+
+bool ts::PcapFilter::preFilterIPv4(const uint8_t* data, size_t size)
+{
+    // Cheap rejection test on the raw IPv4 header, before the datagram is
+    // copied and validated in an IPv4Packet. Only packets which would be
+    // rejected anyway are discarded here. In case of doubt, keep the packet,
+    // the full filter in readIPv4() decides.
+    if (size < IPv4_MIN_HEADER_SIZE || (data[0] >> 4) != IPv4_VERSION) {
+        return true; // let the full parser reject or warn
+    }
+
+    // Filter by protocol.
+    const uint8_t proto = data[IPv4_PROTOCOL_OFFSET];
+    if (!_protocols.empty() && !Contains(_protocols, proto)) {
+        return false;
+    }
+
+    // Rebuild the source and destination socket addresses from the raw header.
+    IPv4SocketAddress src(GetUInt32BE(data + IPv4_SRC_ADDR_OFFSET));
+    IPv4SocketAddress dst(GetUInt32BE(data + IPv4_DEST_ADDR_OFFSET));
+
+    // The ports are in the protocol header, for TCP and UDP only and in the
+    // first fragment only. When they cannot be located, the addresses keep
+    // unspecified ports and act as wildcards in match().
+    const size_t hlen = size_t(data[0] & 0x0F) * 4;
+    const bool first_fragment = (GetUInt16BE(data + IPv4_FRAGMENT_OFFSET) & 0x1FFF) == 0;
+    if ((proto == IPv4_PROTO_TCP || proto == IPv4_PROTO_UDP) && first_fragment && hlen >= IPv4_MIN_HEADER_SIZE && size >= hlen + 4) {
+        src.setPort(GetUInt16BE(data + hlen));
+        dst.setPort(GetUInt16BE(data + hlen + 2));
+    }
+
+    // Same address selection as in readIPv4().
+    return (src.match(_source) && dst.match(_destination)) ||
+           (_bidirectional_filter && src.match(_destination) && dst.match(_source));
+}
+
+
 //----------------------------------------------------------------------------
 // Read an IPv4 packet, inherited method.
 //----------------------------------------------------------------------------
 
 bool ts::PcapFilter::readIPv4(IPv4Packet& packet, MicroSecond& timestamp, Report& report)
 {
+    // Before the first packet, when an absolute date filter is set, fast-forward
+    // at block level up to the first time of interest instead of reading, parsing
+    // and dropping every previous packet. Not done when packet-number or
+    // time-offset filters are also set: the skipped packets are neither counted
+    // nor usable as time origin.
+    if (packetCount() == 0 && _first_time > 0 &&
+        _first_packet == 0 && _last_packet == std::numeric_limits<size_t>::max() &&
+        _first_time_offset == 0 && _last_time_offset == std::numeric_limits<ts::MicroSecond>::max() &&
+        !seekToTimestamp(_first_time, report))
+    {
+        return false;
+    }
+
     // Read packets until one which matches all filters.
     for (;;) {
         // Invoke superclass to read next packet.
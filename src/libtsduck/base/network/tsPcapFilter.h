@@ -220,6 +220,10 @@ namespace ts {
         virtual bool open(const UString& filename, Report& report) override;
         virtual bool readIPv4(IPv4Packet& packet, MicroSecond& timestamp, Report& report) override;
 
+    protected:
+        // Inherited methods.
+        virtual bool preFilterIPv4(const uint8_t* data, size_t size) override;
+
     private:
         std::set<uint8_t> _protocols {};
         IPv4SocketAddress _source {};
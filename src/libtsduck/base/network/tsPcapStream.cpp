@@ -115,8 +115,14 @@ void ts::PcapStream::Stream::store(const IPv4Packet& pkt, MicroSecond tstamp)
         ptr->sequence |= msb << 32;
     }
 
-    // Find the right location in the queue.
-    auto it = packets.begin();
+    // Find the right location in the queue. In the common case, packets are
+    // captured in sequence order and the new block goes at end of queue,
+    // after the last stored block, without any overlap. Check that first to
+    // avoid a scan of the queue for each packet.
+    auto it = packets.end();
+    if (!packets.empty() && ptr->sequence < packets.back()->sequence + packets.back()->data.size()) {
+        it = packets.begin();
+    }
     while (it != packets.end()) {
         DataBlock& db(**it);
         if (ptr->sequence == db.sequence) {
@@ -298,6 +304,9 @@ bool ts::PcapStream::readTCP(IPv4SocketAddress& source, ByteBlock& data, size_t&
     assert(peer_number == ISRC || peer_number == IDST);
     source = peer_number == ISRC ? sourceFilter() : destinationFilter();
 
+    // Pre-size the output buffer, the requested data will be appended to it.
+    data.reserve(data.size() + remain);
+
     // Read data from the selected stream.
     Stream& stream(_streams[peer_number]);
     while (remain > 0) {
@@ -314,25 +323,32 @@ bool ts::PcapStream::readTCP(IPv4SocketAddress& source, ByteBlock& data, size_t&
         }
         assert(!stream.packets.empty());
 
-        // Get data from the first packet.
-        auto first = stream.packets.front();
-        if (first->index < first->data.size()) {
-            const size_t chunk = std::min(remain, first->data.size() - first->index);
-            data.append(&first->data[first->index], chunk);
-            remain -= chunk;
-            size += chunk;
-            first->index += chunk;
-            timestamp = first->timestamp;
-        }
-        if (first->end) {
-            return size > 0; // end of TCP stream
-        }
+        // Get data from the contiguous run of buffered packets in one pass,
+        // without trying to read more packets between each of them.
+        while (remain > 0) {
+            auto first = stream.packets.front();
+            if (first->index < first->data.size()) {
+                const size_t chunk = std::min(remain, first->data.size() - first->index);
+                data.append(&first->data[first->index], chunk);
+                remain -= chunk;
+                size += chunk;
+                first->index += chunk;
+                timestamp = first->timestamp;
+            }
+            if (first->end) {
+                return size > 0; // end of TCP stream
+            }
 
-        // Drop the first packet if adjacent to the second.
-        auto second = stream.packets.begin();
-        ++second;
-        if (second != stream.packets.end() && (*second)->sequence == first->sequence + first->data.size()) {
-            stream.packets.pop_front();
+            // Drop the first packet if adjacent to the second and continue with
+            // the second one. Otherwise, more packets need to be read.
+            auto second = stream.packets.begin();
+            ++second;
+            if (second != stream.packets.end() && (*second)->sequence == first->sequence + first->data.size()) {
+                stream.packets.pop_front();
+            }
+            else {
+                break;
+            }
         }
     }
     return true;
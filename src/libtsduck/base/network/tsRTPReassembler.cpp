@@ -0,0 +1,293 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsRTPReassembler.h"
+
+// Size of the SMPTE 2022-1 FEC header, after the RTP header.
+namespace {
+    constexpr size_t FEC_HEADER_SIZE = 16;
+}
+
+
+//----------------------------------------------------------------------------
+// Preallocate all buffers.
+//----------------------------------------------------------------------------
+
+void ts::RTPReassembler::init(size_t window, size_t max_packet_size)
+{
+    _window = std::max<size_t>(window, 1);
+    _max_packet = std::max(max_packet_size, RTP_HEADER_SIZE);
+
+    // The media ring must be larger than the reordering window so that the
+    // datagrams of a full FEC matrix remain addressable during recovery.
+    _depth = 256;
+    while (_depth < 4 * _window) {
+        _depth <<= 1;
+    }
+
+    _media.resize(_depth);
+    for (auto& slot : _media) {
+        slot.data.resize(_max_packet);
+    }
+    _fec_col.resize(_depth);
+    _fec_row.resize(_depth);
+    for (auto& slot : _fec_col) {
+        slot.data.resize(_max_packet);
+    }
+    for (auto& slot : _fec_row) {
+        slot.data.resize(_max_packet);
+    }
+
+    _reordered = _recovered = _lost = 0;
+    reset();
+}
+
+
+//----------------------------------------------------------------------------
+// Clear all content, keep the preallocated buffers and the counters.
+//----------------------------------------------------------------------------
+
+void ts::RTPReassembler::reset()
+{
+    _synced = false;
+    _next_seq = _max_seq = 0;
+    for (auto& slot : _media) {
+        slot.present = false;
+    }
+    for (auto& slot : _fec_col) {
+        slot.present = false;
+    }
+    for (auto& slot : _fec_row) {
+        slot.present = false;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Check if the datagram at the given sequence number is present.
+//----------------------------------------------------------------------------
+
+bool ts::RTPReassembler::isPresent(uint16_t seq) const
+{
+    const MediaSlot& slot(_media[seq & (_depth - 1)]);
+    return slot.present && slot.seq == seq;
+}
+
+
+//----------------------------------------------------------------------------
+// Push one datagram from the media stream.
+//----------------------------------------------------------------------------
+
+bool ts::RTPReassembler::putMedia(const uint8_t* data, size_t size, MicroSecond timestamp)
+{
+    // Reject datagrams which do not look like RTP version 2.
+    if (_depth == 0 || data == nullptr || size < RTP_HEADER_SIZE || size > _max_packet || (data[0] >> 6) != 2) {
+        return false;
+    }
+    const size_t header_size = RTP_HEADER_SIZE + 4 * size_t(data[0] & 0x0F);
+    if (header_size > size) {
+        return false;
+    }
+    const uint16_t seq = GetUInt16(data + 2);
+
+    // Lock on the first datagram.
+    if (!_synced) {
+        _synced = true;
+        _next_seq = seq;
+        _max_seq = uint16_t(seq - 1);
+    }
+
+    const int ahead = SeqDiff(seq, _next_seq);
+    if (ahead < 0) {
+        // Too late, a datagram with this sequence number was already delivered or abandoned.
+        _reordered++;
+        return true;
+    }
+    if (ahead >= int(_depth)) {
+        // Far beyond the ring, heavy loss or stream restart. Count what is
+        // definitely unrecoverable and resynchronize on the new datagram.
+        uint64_t held = 0;
+        for (const auto& slot : _media) {
+            held += slot.present && !slot.delivered ? 1 : 0;
+        }
+        _lost += uint64_t(uint16_t(seq - _next_seq)) - held;
+        reset();
+        _synced = true;
+        _next_seq = seq;
+        _max_seq = uint16_t(seq - 1);
+    }
+
+    // Track out-of-order arrivals.
+    if (SeqDiff(seq, _max_seq) > 0) {
+        _max_seq = seq;
+    }
+    else {
+        _reordered++;
+    }
+
+    // Store the datagram in its slot.
+    MediaSlot& slot(_media[seq & (_depth - 1)]);
+    if (!slot.present || slot.seq != seq) {
+        std::memcpy(slot.data.data(), data, size);
+        slot.present = true;
+        slot.delivered = false;
+        slot.seq = seq;
+        slot.size = size;
+        slot.header_size = header_size;
+        slot.timestamp = timestamp;
+    }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Push one datagram from a SMPTE 2022-1 FEC stream.
+//----------------------------------------------------------------------------
+
+void ts::RTPReassembler::putFEC(const uint8_t* data, size_t size)
+{
+    // The FEC datagram is itself an RTP datagram, followed by the FEC header.
+    if (_depth == 0 || data == nullptr || size < RTP_HEADER_SIZE || (data[0] >> 6) != 2) {
+        return;
+    }
+    const size_t rtp_header = RTP_HEADER_SIZE + 4 * size_t(data[0] & 0x0F);
+    if (size < rtp_header + FEC_HEADER_SIZE) {
+        return;
+    }
+    const uint8_t* const fec = data + rtp_header;
+    const uint16_t snbase = GetUInt16(fec);
+    const bool row = (fec[12] & 0x40) != 0;  // "D" bit: 0 = column, 1 = row.
+    const uint16_t offset = fec[13];
+    const uint16_t count = fec[14];
+    const size_t payload_size = size - rtp_header - FEC_HEADER_SIZE;
+    if (offset == 0 || count < 2 || size_t(offset) * count > _depth || payload_size == 0 || payload_size > _max_packet) {
+        return;
+    }
+
+    std::vector<FECSlot>& ring(row ? _fec_row : _fec_col);
+    FECSlot& slot(ring[snbase & (ring.size() - 1)]);
+    std::memcpy(slot.data.data(), fec + FEC_HEADER_SIZE, payload_size);
+    slot.present = true;
+    slot.snbase = snbase;
+    slot.offset = offset;
+    slot.count = count;
+    slot.size_xor = GetUInt16(fec + 2);
+    slot.pt_xor = fec[4] & 0x7F;
+    slot.ts_xor = GetUInt32(fec + 8);
+    slot.size = payload_size;
+}
+
+
+//----------------------------------------------------------------------------
+// Try to rebuild the datagram at the given sequence number from one FEC ring.
+//----------------------------------------------------------------------------
+
+bool ts::RTPReassembler::recover(uint16_t seq, std::vector<FECSlot>& ring)
+{
+    for (auto& fec : ring) {
+
+        // Look for a FEC datagram protecting this sequence number.
+        const int dist = fec.present ? SeqDiff(seq, fec.snbase) : -1;
+        if (!fec.present || dist < 0 || dist % fec.offset != 0 || size_t(dist) / fec.offset >= fec.count) {
+            continue;
+        }
+
+        // All other protected datagrams must be present.
+        bool complete = true;
+        for (uint16_t i = 0; complete && i < fec.count; ++i) {
+            const uint16_t s = uint16_t(fec.snbase + i * fec.offset);
+            complete = s == seq || isPresent(s);
+        }
+        if (!complete) {
+            continue;
+        }
+
+        // Rebuild the missing datagram by XOR-ing the FEC payload with the
+        // payloads of all other protected datagrams. Same for the length,
+        // the payload type and the RTP time stamp.
+        MediaSlot& dst(_media[seq & (_depth - 1)]);
+        uint8_t* const payload = dst.data.data() + RTP_HEADER_SIZE;
+        std::memcpy(payload, fec.data.data(), fec.size);
+        uint16_t size_x = fec.size_xor;
+        uint8_t pt_x = fec.pt_xor;
+        uint32_t ts_x = fec.ts_xor;
+        uint32_t ssrc = 0;
+        for (uint16_t i = 0; i < fec.count; ++i) {
+            const uint16_t s = uint16_t(fec.snbase + i * fec.offset);
+            if (s != seq) {
+                const MediaSlot& m(_media[s & (_depth - 1)]);
+                const uint8_t* const mpay = m.data.data() + m.header_size;
+                const size_t msize = m.size - m.header_size;
+                for (size_t b = 0; b < std::min(msize, fec.size); ++b) {
+                    payload[b] ^= mpay[b];
+                }
+                size_x ^= uint16_t(msize);
+                pt_x ^= m.data[1] & 0x7F;
+                ts_x ^= GetUInt32(m.data.data() + 4);
+                ssrc = GetUInt32(m.data.data() + 8);
+            }
+        }
+
+        // Sanity check on the recovered payload size.
+        if (size_x == 0 || size_t(size_x) > fec.size || RTP_HEADER_SIZE + size_t(size_x) > _max_packet) {
+            continue;
+        }
+
+        // Rebuild a plain RTP header in front of the recovered payload.
+        dst.data[0] = 0x80;  // version 2, no padding, no extension, no CSRC.
+        dst.data[1] = pt_x;
+        PutUInt16(dst.data.data() + 2, seq);
+        PutUInt32(dst.data.data() + 4, ts_x);
+        PutUInt32(dst.data.data() + 8, ssrc);
+        dst.present = true;
+        dst.delivered = false;
+        dst.seq = seq;
+        dst.size = RTP_HEADER_SIZE + size_x;
+        dst.header_size = RTP_HEADER_SIZE;
+        dst.timestamp = -1;
+        _recovered++;
+        return true;
+    }
+    return false;
+}
+
+
+//----------------------------------------------------------------------------
+// Pop the next datagram in RTP sequence order, when available.
+//----------------------------------------------------------------------------
+
+bool ts::RTPReassembler::getNext(uint8_t* buffer, size_t buffer_size, size_t& ret_size, MicroSecond& timestamp)
+{
+    if (!_synced) {
+        return false;
+    }
+    for (;;) {
+        MediaSlot& slot(_media[_next_seq & (_depth - 1)]);
+        if (slot.present && !slot.delivered && slot.seq == _next_seq) {
+            // The next datagram in sequence is available, deliver it. The slot
+            // is kept in the ring: its payload can still be needed to rebuild
+            // another datagram of the same FEC column or row.
+            ret_size = std::min(slot.size, buffer_size);
+            std::memcpy(buffer, slot.data.data(), ret_size);
+            timestamp = slot.timestamp;
+            slot.delivered = true;
+            _next_seq++;
+            return true;
+        }
+        if (SeqDiff(_max_seq, _next_seq) < int(_window)) {
+            // The missing datagram may still arrive, hold back its successors.
+            return false;
+        }
+        // The missing datagram is overdue. Try to rebuild it from the column
+        // FEC stream, then from the row FEC stream, then abandon it.
+        if (!recover(_next_seq, _fec_col) && !recover(_next_seq, _fec_row)) {
+            _lost++;
+            _next_seq++;
+        }
+    }
+}
@@ -0,0 +1,167 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  RTP datagram reordering and SMPTE 2022-1 FEC recovery.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsIPProtocols.h"
+#include "tsByteBlock.h"
+
+namespace ts {
+    //!
+    //! RTP datagram reordering and SMPTE 2022-1 FEC recovery.
+    //! @ingroup net
+    //!
+    //! RTP datagrams are pushed as they are received from the network and
+    //! popped in RTP sequence order. Out-of-order datagrams are held in a
+    //! sequence-indexed ring until the sequence hole before them is filled
+    //! or abandoned. Optional SMPTE 2022-1 FEC datagrams (from the column
+    //! and row FEC streams) are pushed separately and used to rebuild a
+    //! missing datagram when all other datagrams of its column or row were
+    //! received.
+    //!
+    //! All buffers are preallocated by init(). Pushing, popping and packet
+    //! recovery never allocate memory, this class is safe on a real-time
+    //! reception path.
+    //!
+    //! This class is not thread-safe. When the FEC streams are received by
+    //! separate threads, the caller must serialize the accesses.
+    //!
+    class TSDUCKDLL RTPReassembler
+    {
+        TS_NOCOPY(RTPReassembler);
+    public:
+        //!
+        //! Default constructor.
+        //! The object is unusable until init() is called.
+        //!
+        RTPReassembler() = default;
+
+        //!
+        //! Preallocate all buffers.
+        //! @param [in] window Maximum number of datagrams which are held back while
+        //! waiting for a late datagram. This is the reordering depth and also the
+        //! worst-case added latency, in datagrams. The ring is larger than this
+        //! value so that a full FEC matrix remains addressable for recovery.
+        //! @param [in] max_packet_size Maximum size in bytes of one datagram.
+        //!
+        void init(size_t window, size_t max_packet_size = IP_MAX_PACKET_SIZE);
+
+        //!
+        //! Clear all content, keep the preallocated buffers and the counters.
+        //!
+        void reset();
+
+        //!
+        //! Push one datagram from the media stream.
+        //! @param [in] data Address of the datagram, starting with the RTP header.
+        //! @param [in] size Size in bytes of the datagram.
+        //! @param [in] timestamp Receive timestamp in micro-seconds, -1 if unknown.
+        //! @return True if the datagram was a valid RTP datagram and was retained.
+        //! False if it does not look like RTP (the caller should process it directly).
+        //!
+        bool putMedia(const uint8_t* data, size_t size, MicroSecond timestamp);
+
+        //!
+        //! Push one datagram from a SMPTE 2022-1 FEC stream (column or row).
+        //! The column / row nature is read from the FEC header.
+        //! Invalid datagrams are silently ignored.
+        //! @param [in] data Address of the datagram, starting with the RTP header.
+        //! @param [in] size Size in bytes of the datagram.
+        //!
+        void putFEC(const uint8_t* data, size_t size);
+
+        //!
+        //! Pop the next datagram in RTP sequence order, when available.
+        //! A datagram is available when it is the next one in sequence, possibly
+        //! after FEC recovery or after abandoning a datagram which is missing for
+        //! more than the reordering window.
+        //! @param [out] buffer Address of the buffer for the datagram.
+        //! @param [in] buffer_size Size in bytes of the buffer.
+        //! @param [out] ret_size Size in bytes of the returned datagram.
+        //! @param [out] timestamp Receive timestamp in micro-seconds, -1 if unknown.
+        //! @return True when a datagram is returned, false when nothing is available yet.
+        //!
+        bool getNext(uint8_t* buffer, size_t buffer_size, size_t& ret_size, MicroSecond& timestamp);
+
+        //!
+        //! Get the number of datagrams which were received out of order.
+        //! @return The number of datagrams which were received out of order.
+        //!
+        uint64_t reorderedCount() const { return _reordered; }
+
+        //!
+        //! Get the number of datagrams which were rebuilt using FEC.
+        //! @return The number of datagrams which were rebuilt using FEC.
+        //!
+        uint64_t recoveredCount() const { return _recovered; }
+
+        //!
+        //! Get the number of datagrams which were definitely lost.
+        //! @return The number of datagrams which were definitely lost.
+        //!
+        uint64_t lostCount() const { return _lost; }
+
+    private:
+        // One slot of the media ring, indexed by RTP sequence number.
+        class MediaSlot
+        {
+        public:
+            MediaSlot() = default;
+            bool        present = false;   // The slot contains the datagram with this sequence number.
+            bool        delivered = false; // The datagram was handed out but is kept as FEC recovery material.
+            uint16_t    seq = 0;           // RTP sequence number of the datagram.
+            size_t      size = 0;          // Total datagram size.
+            size_t      header_size = 0;   // RTP header size (payload starts there).
+            MicroSecond timestamp = -1;
+            ByteBlock   data {};           // Preallocated to max_packet_size.
+        };
+
+        // One slot of a FEC ring, indexed by the base sequence number ("SNBase").
+        class FECSlot
+        {
+        public:
+            FECSlot() = default;
+            bool      present = false;
+            uint16_t  snbase = 0;     // First protected sequence number.
+            uint16_t  offset = 0;     // Distance between protected sequence numbers.
+            uint16_t  count = 0;      // Number of protected datagrams ("NA").
+            uint16_t  size_xor = 0;   // XOR of the protected payload sizes ("length recovery").
+            uint8_t   pt_xor = 0;     // XOR of the protected payload types.
+            uint32_t  ts_xor = 0;     // XOR of the protected RTP time stamps.
+            size_t    size = 0;       // Size of the FEC payload (XOR of media payloads).
+            ByteBlock data {};        // Preallocated to max_packet_size.
+        };
+
+        // Configuration and state.
+        size_t        _depth = 0;        // Size of the media ring, a power of two.
+        size_t        _window = 0;       // Reordering depth, less than _depth.
+        size_t        _max_packet = 0;   // Maximum datagram size.
+        bool          _synced = false;   // _next_seq is meaningful.
+        uint16_t      _next_seq = 0;     // Next sequence number to deliver.
+        uint16_t      _max_seq = 0;      // Highest sequence number seen so far.
+        uint64_t      _reordered = 0;
+        uint64_t      _recovered = 0;
+        uint64_t      _lost = 0;
+        std::vector<MediaSlot> _media {};
+        std::vector<FECSlot>   _fec_col {};
+        std::vector<FECSlot>   _fec_row {};
+
+        // Signed distance between two sequence numbers, modulo 2^16.
+        static int SeqDiff(uint16_t a, uint16_t b) { return int16_t(a - b); }
+
+        // Check if the datagram at the given sequence number is present.
+        bool isPresent(uint16_t seq) const;
+
+        // Try to rebuild the datagram at the given sequence number from one FEC ring.
+        bool recover(uint16_t seq, std::vector<FECSlot>& ring);
+    };
+}
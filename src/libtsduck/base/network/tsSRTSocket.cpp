@@ -42,6 +42,13 @@ void ts::SRTSocket::defineArgs(ts::Args& args)
               u"With --listener, specify the number of allowed waiting incoming clients. "
               u"The default is one.");
 
+    args.option(u"busy-poll", 0, Args::POSITIVE);
+    args.help(u"busy-poll", u"count",
+              u"Use busy polling on receive operations. The socket is set in non-blocking "
+              u"mode and a receive operation spins up to the specified number of immediate "
+              u"attempts before waiting for incoming data. This trades CPU for a reduced "
+              u"wakeup latency and is only useful at very high bitrates.");
+
     args.option(u"no-reuse-port");
     args.help(u"no-reuse-port",
               u"With --listener, disable the reuse port socket option. "
@@ -284,7 +291,9 @@ bool ts::SRTSocket::loadArgs(DuckContext&, Args&) { return true; }
 bool ts::SRTSocket::send(const void*, size_t, Report& report) NOSRT_ERROR
 bool ts::SRTSocket::receive(void*, size_t, size_t&, Report& report) NOSRT_ERROR
 bool ts::SRTSocket::receive(void*, size_t, size_t&, MicroSecond&, Report& report) NOSRT_ERROR
+size_t ts::SRTSocket::receiveQueueSize(Report&) const { return 0; }
 bool ts::SRTSocket::reportStatistics(SRTStatMode, Report& report) NOSRT_ERROR
+bool ts::SRTSocket::getSendStatus(SRTSendStatus&, Report& report) NOSRT_ERROR
 bool ts::SRTSocket::getSockOpt(int, const char*, void*, int&, Report& report) const NOSRT_ERROR
 int  ts::SRTSocket::getSocket() const { return -1; }
 bool ts::SRTSocket::getMessageApi() const { return false; }
@@ -426,6 +435,8 @@ public:
      std::string passphrase {};
      std::string streamid {};
      int         polling_time = -1;
+     int         busy_poll = 0;
+     int         epoll_id = -1;
      bool        messageapi = false;
      bool        nakreport = false;
      bool        reuse_port = false;
@@ -576,6 +587,24 @@ bool ts::SRTSocket::open(SRTSocketMode mode,
     // Set final socket options.
     success = success && _guts->setSockOptPost(report);
 
+    // With busy polling, the receive operations are non-blocking and wait on
+    // an epoll when the spin budget is exhausted.
+    if (success && _guts->busy_poll > 0) {
+        const bool no = false;
+        success = _guts->setSockOpt(SRTO_RCVSYN, "SRTO_RCVSYN", &no, sizeof(no), report);
+        if (success && (_guts->epoll_id = ::srt_epoll_create()) < 0) {
+            report.error(u"error during srt_epoll_create(): %s", {::srt_getlasterror_str()});
+            success = false;
+        }
+        if (success) {
+            int events = SRT_EPOLL_IN | SRT_EPOLL_ERR;
+            if (::srt_epoll_add_usock(_guts->epoll_id, _guts->sock, &events) < 0) {
+                report.error(u"error during srt_epoll_add_usock(): %s", {::srt_getlasterror_str()});
+                success = false;
+            }
+        }
+    }
+
     // Reset send/receive statistics.
     _guts->total_sent_bytes = _guts->total_received_bytes = 0;
     if (_guts->stats_interval > 0) {
@@ -613,6 +642,12 @@ bool ts::SRTSocket::close(Report& report)
     _guts->listener = SRT_INVALID_SOCK;
     _guts->sock = SRT_INVALID_SOCK;
 
+    // Release the epoll which was used for busy polling.
+    if (_guts->epoll_id >= 0) {
+        ::srt_epoll_release(_guts->epoll_id);
+        _guts->epoll_id = -1;
+    }
+
     if (sock != SRT_INVALID_SOCK) {
         // Close the SRT data socket.
         report.debug(u"calling srt_close()");
@@ -778,6 +813,7 @@ bool ts::SRTSocket::loadArgs(DuckContext& duck, Args& args)
     args.getIntValue(_guts->rcvbuf, u"rcvbuf", -1);
     args.getIntValue(_guts->rcv_latency, u"rcv-latency", -1);
     args.getIntValue(_guts->polling_time, u"polling-time", DEFAULT_POLLING_TIME);
+    args.getIntValue(_guts->busy_poll, u"busy-poll", 0);
     args.getIntValue(_guts->sndbuf, u"sndbuf", -1);
     args.getIntValue(_guts->udp_rcvbuf, u"udp-rcvbuf", -1);
     args.getIntValue(_guts->udp_sndbuf, u"udp-sndbuf", -1);
@@ -1074,7 +1110,37 @@ bool ts::SRTSocket::receive(void* data, size_t max_size, size_t& ret_size, Micro
     ::SRT_MSGCTRL ctrl;
     TS_ZERO(ctrl);
 
-    const int ret = ::srt_recvmsg2(_guts->sock, reinterpret_cast<char*>(data), int(max_size), &ctrl);
+    int ret = 0;
+    if (_guts->busy_poll <= 0) {
+        // Blocking receive.
+        ret = ::srt_recvmsg2(_guts->sock, reinterpret_cast<char*>(data), int(max_size), &ctrl);
+    }
+    else {
+        // Busy polling: the socket is non-blocking, spin on immediate attempts
+        // before waiting for incoming data on the epoll.
+        int spin = _guts->busy_poll;
+        while ((ret = ::srt_recvmsg2(_guts->sock, reinterpret_cast<char*>(data), int(max_size), &ctrl)) < 0 &&
+               ::srt_getlasterror(nullptr) == SRT_EASYNCRCV &&
+               !_guts->disconnected && _guts->sock != SRT_INVALID_SOCK)
+        {
+            if (spin > 0) {
+                spin--;
+            }
+            else {
+                // Spin budget exhausted, block until data are available or timeout.
+                ::SRTSOCKET rsock = _guts->sock;
+                int rnum = 1;
+                if (::srt_epoll_wait(_guts->epoll_id, &rsock, &rnum, nullptr, nullptr, _guts->polling_time, nullptr, nullptr, nullptr, nullptr) < 0 &&
+                    ::srt_getlasterror(nullptr) != SRT_ETIMEOUT)
+                {
+                    // Error on the epoll itself (typically the socket was closed).
+                    // Let the final srt_recvmsg2() report the actual state.
+                    ret = ::srt_recvmsg2(_guts->sock, reinterpret_cast<char*>(data), int(max_size), &ctrl);
+                    break;
+                }
+            }
+        }
+    }
     if (ret < 0) {
         // Differentiate peer disconnection (aka "end of file") and actual errors.
         const int err = srt_getlasterror(nullptr);
@@ -1096,6 +1162,21 @@ bool ts::SRTSocket::receive(void* data, size_t max_size, size_t& ret_size, Micro
 }
 
 
+//----------------------------------------------------------------------------
+// Get the number of data packets which are ready in the receive buffer.
+//----------------------------------------------------------------------------
+
+size_t ts::SRTSocket::receiveQueueSize(Report& report) const
+{
+    if (_guts->disconnected || _guts->sock == SRT_INVALID_SOCK) {
+        return 0;
+    }
+    int count = 0;
+    int optlen = sizeof(count);
+    return getSockOpt(SRTO_RCVDATA, "SRTO_RCVDATA", &count, optlen, report) && count > 0 ? size_t(count) : 0;
+}
+
+
 //----------------------------------------------------------------------------
 // Send / receive statistics.
 //----------------------------------------------------------------------------
@@ -1296,4 +1377,46 @@ bool ts::SRTSocket::reportStatistics(SRTStatMode mode, Report& report)
     return true;
 }
 
+
+//----------------------------------------------------------------------------
+// Get a snapshot of the sender-side congestion state of the socket.
+//----------------------------------------------------------------------------
+
+bool ts::SRTSocket::getSendStatus(SRTSendStatus& status, Report& report)
+{
+    status = SRTSendStatus();
+
+    // If socket was closed, silently fail.
+    if (_guts->sock == SRT_INVALID_SOCK) {
+        return false;
+    }
+
+    // Get statistics data from the SRT socket. Never clear the interval
+    // statistics here, they belong to reportStatistics().
+    ::SRT_TRACEBSTATS stats;
+    TS_ZERO(stats);
+
+    if (::srt_bstats(_guts->sock, &stats, 0) < 0) {
+        int sys_error = 0;
+        const int srt_error = ::srt_getlasterror(&sys_error);
+        report.debug(u"srt_bstats: socket: 0x%X, libsrt error: %d, system error: %d", {_guts->sock, srt_error, sys_error});
+        if (!_guts->disconnected) {
+            report.error(u"error during srt_bstats: %s", {::srt_getlasterror_str()});
+        }
+        return false;
+    }
+
+    status.rtt_ms = stats.msRTT;
+    status.flow_window_packets = size_t(std::max(0, stats.pktFlowWindow));
+    status.congestion_window_packets = size_t(std::max(0, stats.pktCongestionWindow));
+    status.in_flight_packets = size_t(std::max(0, stats.pktFlightSize));
+    status.sent_packets = uint64_t(std::max<int64_t>(0, stats.pktSentTotal));
+    status.retransmitted_packets = uint64_t(std::max(0, stats.pktRetransTotal));
+    status.lost_packets = uint64_t(std::max(0, stats.pktSndLossTotal));
+    status.dropped_packets = uint64_t(std::max(0, stats.pktSndDropTotal));
+    status.link_bandwidth_mbps = stats.mbpsBandwidth;
+    status.send_rate_mbps = stats.mbpsSendRate;
+    return true;
+}
+
 #endif // TS_NO_SRT
@@ -50,6 +50,28 @@ namespace ts {
     class Args;
     class DuckContext;
 
+    //!
+    //! Snapshot of the sender-side congestion state of a Secure Reliable Transport (SRT) socket.
+    //! This structure collects the data which drive the SRT sending rate: retransmissions,
+    //! round-trip time, flow and congestion windows.
+    //! @ingroup net
+    //!
+    class TSDUCKDLL SRTSendStatus
+    {
+    public:
+        SRTSendStatus() = default;                 //!< Constructor.
+        double   rtt_ms = 0.0;                     //!< Round-trip time in milliseconds.
+        size_t   flow_window_packets = 0;          //!< Flow control window size in packets.
+        size_t   congestion_window_packets = 0;    //!< Congestion control window size in packets.
+        size_t   in_flight_packets = 0;            //!< Number of packets in flight (sent but not yet acknowledged).
+        uint64_t sent_packets = 0;                 //!< Total number of sent packets since the socket was opened.
+        uint64_t retransmitted_packets = 0;        //!< Total number of retransmitted packets since the socket was opened.
+        uint64_t lost_packets = 0;                 //!< Total number of sent packets which were reported lost since the socket was opened.
+        uint64_t dropped_packets = 0;              //!< Total number of packets dropped by the sender since the socket was opened.
+        double   link_bandwidth_mbps = 0.0;        //!< Estimated link bandwidth in megabits per second.
+        double   send_rate_mbps = 0.0;             //!< Sending rate in megabits per second over the last interval.
+    };
+
     //!
     //! Secure Reliable Transport (SRT) Socket.
     //! If the libsrt is not available during compilation of this class,
@@ -162,6 +184,14 @@ namespace ts {
         //!
         bool receive(void* data, size_t max_size, size_t& ret_size, MicroSecond& timestamp, Report& report = CERR);
 
+        //!
+        //! Get the number of data packets which are ready in the receive buffer.
+        //! That many packets (or messages with the Message API) can be read without blocking.
+        //! @param [in,out] report Where to report error.
+        //! @return Number of packets which can be immediately read. Zero when the buffer is empty or on error.
+        //!
+        size_t receiveQueueSize(Report& report = CERR) const;
+
         //!
         //! Get the total number of sent bytes since the socket was opened.
         //! @return The total number of sent bytes since the socket was opened.
@@ -189,6 +219,16 @@ namespace ts {
         //!
         bool reportStatistics(SRTStatMode mode = SRTStatMode::ALL, Report& report = CERR);
 
+        //!
+        //! Get a snapshot of the sender-side congestion state of the socket.
+        //! Unlike reportStatistics(), this method never clears the interval statistics
+        //! and can be used in addition to --statistics-interval reporting.
+        //! @param [out] status Returned congestion state.
+        //! @param [in,out] report Where to report errors.
+        //! @return True on success, false on error.
+        //!
+        bool getSendStatus(SRTSendStatus& status, Report& report = CERR);
+
         //!
         //! Get SRT option.
         //! @param [in] optName Option name as enumeration. The possible values for @a optName are given
@@ -11,6 +11,13 @@
 #include "tsException.h"
 #include "tsNullReport.h"
 #include "tsMemory.h"
+#include "tsTime.h"
+
+#if defined(TS_LINUX)
+    #include "tsBeforeStandardHeaders.h"
+    #include <linux/sock_diag.h>
+    #include "tsAfterStandardHeaders.h"
+#endif
 
 
 //----------------------------------------------------------------------------
@@ -67,6 +74,20 @@ void ts::Socket::declareOpened(SysSocketType sock, Report& report)
 bool ts::Socket::close(Report& report)
 {
     if (_sock != SYS_SOCKET_INVALID) {
+        // With adaptive receive buffer tuning, report the final sizing and drop history.
+        if (_tune_ceiling != 0) {
+            size_t drops = 0;
+            getReceiveDropCount(drops, report);
+            if (_tune_cursize == 0) {
+                // No explicit size was ever set, get the system default.
+                int size = 0;
+                SysSocketLengthType len = sizeof(size);
+                if (::getsockopt(_sock, SOL_SOCKET, SO_RCVBUF, SysRecvBufferPointer(&size), &len) == 0 && size > 0) {
+                    _tune_cursize = size_t(size);
+                }
+            }
+            report.verbose(u"closing socket: receive buffer size %'d bytes after %d automatic enlargements, %'d datagrams dropped by the kernel", {_tune_cursize, _tune_grow, drops});
+        }
         // Mark the socket as invalid. If the close generates reception errors in other threads,
         // these threads can immediately check if this is a real error or the result of a close.
         const SysSocketType previous = _sock;
@@ -112,7 +133,88 @@ bool ts::Socket::setReceiveBufferSize(size_t bytes, Report& report)
         report.error(u"error setting socket receive buffer size: %s", {SysSocketErrorCodeMessage()});
         return false;
     }
+    // Remember the last explicit size as base for the adaptive tuning.
+    _tune_cursize = bytes;
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Get the number of datagrams which were dropped by the kernel.
+//----------------------------------------------------------------------------
+
+bool ts::Socket::getReceiveDropCount(size_t& drops, Report& report)
+{
+    drops = 0;
+#if defined(TS_LINUX) && defined(SO_MEMINFO)
+    // Array of per-socket memory counters, indexed by SK_MEMINFO_xxx from linux/sock_diag.h.
+    // The drop counter (SK_MEMINFO_DROPS) is reported by Linux 4.9 and above.
+    uint32_t meminfo[SK_MEMINFO_VARS];
+    TS_ZERO(meminfo);
+    SysSocketLengthType len = sizeof(meminfo);
+    if (::getsockopt(_sock, SOL_SOCKET, SO_MEMINFO, SysRecvBufferPointer(meminfo), &len) != 0) {
+        report.debug(u"error getting socket memory info: %s", {SysSocketErrorCodeMessage()});
+        return false;
+    }
+    if (size_t(len) < (SK_MEMINFO_DROPS + 1) * sizeof(uint32_t)) {
+        // Truncated array from an older kernel, no drop counter.
+        return false;
+    }
+    drops = size_t(meminfo[SK_MEMINFO_DROPS]);
     return true;
+#else
+    // No usable per-socket drop counter on this system.
+    return false;
+#endif
+}
+
+
+//----------------------------------------------------------------------------
+// Adaptive tuning of the receive buffer size, called on the receive path.
+//----------------------------------------------------------------------------
+
+void ts::Socket::checkReceiveBufferTuning(Report& report)
+{
+    // Limit the overhead on the receive path: check the clock every 256 receive
+    // operations only and sample the drop counter about once per second.
+    if (_tune_ceiling == 0 || _tune_countdown-- > 0) {
+        return;
+    }
+    _tune_countdown = 256;
+    const MilliSecond now = Time::CurrentUTC() - Time::Epoch;
+    if (now < _tune_next) {
+        return;
+    }
+    _tune_next = now + MilliSecPerSec;
+
+    // Sample the kernel drop counter. Disable the tuning when not available.
+    size_t drops = 0;
+    if (!getReceiveDropCount(drops, report)) {
+        report.debug(u"no kernel drop counter on this system, disabling receive buffer tuning");
+        _tune_ceiling = 0;
+        return;
+    }
+    if (drops <= _tune_drops) {
+        return;
+    }
+
+    // New drops were detected since the last sample. Get the current buffer
+    // size from the system when no explicit size was set so far.
+    if (_tune_cursize == 0) {
+        int size = 0;
+        SysSocketLengthType len = sizeof(size);
+        if (::getsockopt(_sock, SOL_SOCKET, SO_RCVBUF, SysRecvBufferPointer(&size), &len) == 0 && size > 0) {
+            _tune_cursize = size_t(size);
+        }
+    }
+
+    // Double the receive buffer size, up to the ceiling.
+    const size_t newsize = std::min(2 * _tune_cursize, _tune_ceiling);
+    if (newsize > _tune_cursize && setReceiveBufferSize(newsize, report)) {
+        report.verbose(u"%'d datagrams dropped by the kernel, enlarging socket receive buffer to %'d bytes", {drops, newsize});
+        _tune_grow++;
+    }
+    _tune_drops = drops;
 }
 
 
@@ -71,6 +71,36 @@ namespace ts {
         //!
         bool setReceiveBufferSize(size_t size, Report& report = CERR);
 
+        //!
+        //! Default ceiling for the adaptive tuning of the receive buffer size.
+        //!
+        static constexpr size_t DEFAULT_RECEIVE_BUFFER_CEILING = 16 * 1024 * 1024;
+
+        //!
+        //! Enable the adaptive tuning of the receive buffer size.
+        //!
+        //! When enabled, the kernel counter of datagrams which were dropped on this
+        //! socket because of a full receive buffer is periodically sampled on the
+        //! receive path. When new drops are detected, the receive buffer size is
+        //! doubled, up to @a ceiling. The final buffer size and the drop history
+        //! are reported in verbose mode when the socket is closed. The drop counter
+        //! is currently available on Linux only (socket option SO_MEMINFO); on other
+        //! systems, the tuning silently remains inactive.
+        //!
+        //! @param [in] ceiling Maximum receive buffer size in bytes. When zero,
+        //! the adaptive tuning is disabled.
+        //!
+        void setReceiveBufferTuning(size_t ceiling) { _tune_ceiling = ceiling; }
+
+        //!
+        //! Get the number of datagrams which were dropped by the kernel on this
+        //! socket because the receive buffer was full.
+        //! @param [out] drops Number of dropped datagrams since the socket was open.
+        //! @param [in,out] report Where to report error.
+        //! @return True on success, false when the counter is not available on this system.
+        //!
+        bool getReceiveDropCount(size_t& drops, Report& report = CERR);
+
         //!
         //! Set the receive timeout.
         //! @param [in] timeout Receive timeout in milliseconds.
@@ -127,7 +157,24 @@ namespace ts {
         //!
         virtual void declareOpened(SysSocketType sock, Report& report);
 
+        //!
+        //! Sample the kernel drop counter and enlarge the receive buffer when new
+        //! drops are detected. Called on the receive path by subclasses when the
+        //! adaptive tuning of the receive buffer size is enabled.
+        //! @param [in,out] report Where to report messages.
+        //! @see setReceiveBufferTuning()
+        //!
+        void checkReceiveBufferTuning(Report& report);
+
     private:
         volatile SysSocketType _sock {SYS_SOCKET_INVALID};
+
+        // Adaptive tuning of the receive buffer size.
+        size_t      _tune_ceiling = 0;    // Maximum receive buffer size, zero means tuning disabled.
+        size_t      _tune_cursize = 0;    // Last receive buffer size which was set, zero means unknown.
+        size_t      _tune_drops = 0;      // Kernel drop count at last sample.
+        size_t      _tune_grow = 0;       // Number of automatic buffer enlargements.
+        size_t      _tune_countdown = 0;  // Receive operations until next clock check.
+        MilliSecond _tune_next = 0;       // Next drop sampling time (UTC milliseconds).
     };
 }
@@ -39,6 +39,17 @@ void ts::UDPReceiver::defineArgs(ts::Args& args, bool with_short_options, bool d
     args.option(destinationOptionName(), dest_short, Args::STRING, dest_min, max_count);
     args.help(destinationOptionName(), u"[address:]port", help);
 
+    args.option(u"adaptive-buffer-size", 0, Args::UNSIGNED, 0, 1, 0, 0, true);
+    args.help(u"adaptive-buffer-size", u"max-bytes",
+              u"Automatically tune the UDP socket receive buffer size. The kernel counter "
+              u"of datagrams which were dropped because of a full receive buffer is "
+              u"periodically sampled and, when new drops are detected, the receive buffer "
+              u"size is doubled, up to the specified maximum size in bytes (default: " +
+              UString::Decimal(Socket::DEFAULT_RECEIVE_BUFFER_CEILING) + u" bytes). "
+              u"The final buffer size and the drop history are reported in verbose mode "
+              u"when the socket is closed. With --buffer-size, the initial size is the "
+              u"specified one. Currently available on Linux only.");
+
     args.option(u"buffer-size", with_short_options ? 'b' : 0, Args::UNSIGNED);
     args.help(u"buffer-size", u"Specify the UDP socket receive buffer size in bytes (socket option).");
 
@@ -54,6 +65,16 @@ void ts::UDPReceiver::defineArgs(ts::Args& args, bool with_short_options, bool d
               u"Warning: On input sockets, this option is effective only on Windows systems. "
               u"On Unix systems (Linux, macOS, BSD), this option applies only to output sockets.");
 
+    args.option(u"hardware-timestamps");
+    args.help(u"hardware-timestamps",
+              u"Request receive timestamps from the hardware clock of the network interface "
+              u"instead of the kernel software timestamps. Hardware timestamps remove the "
+              u"interrupt and scheduling jitter from latency measurements. The timestamping "
+              u"unit of the network interface must be enabled separately (see ethtool on "
+              u"Linux) and its clock should be synchronized with the system clock (using a "
+              u"PTP daemon for instance). Packets without a hardware timestamp fall back to "
+              u"the kernel timestamp. This option is supported on Linux only.");
+
     args.option(u"first-source", with_short_options ? 'f' : 0);
     args.help(u"first-source",
               u"Filter UDP packets based on the source address. Use the sender address of "
@@ -137,7 +158,9 @@ bool ts::UDPReceiver::loadArgs(DuckContext& duck, Args& args, size_t index)
     _use_ssm = args.present(u"ssm");
     _use_first_source = args.present(u"first-source");
     _mc_loopback = !args.present(u"disable-multicast-loop");
+    _recv_hw_timestamps = args.present(u"hardware-timestamps");
     args.getIntValue(_recv_bufsize, u"buffer-size", 0);
+    _recv_buf_ceiling = args.present(u"adaptive-buffer-size") ? args.intValue<size_t>(u"adaptive-buffer-size", DEFAULT_RECEIVE_BUFFER_CEILING) : 0;
     args.getIntValue(_recv_timeout, u"receive-timeout", _recv_timeout); // preserve previous value
 
     // Check the presence of the '@' indicating a source address.
@@ -270,6 +293,32 @@ void ts::UDPReceiver::setParameters(const IPv4SocketAddress& localAddress, bool
 }
 
 
+//----------------------------------------------------------------------------
+// Copy the reception parameters of another UDP receiver.
+//----------------------------------------------------------------------------
+
+void ts::UDPReceiver::copyParameters(const UDPReceiver& other, uint16_t port_offset)
+{
+    // Copy the configuration fields only, not the runtime state of the socket.
+    _dest_is_parameter = other._dest_is_parameter;
+    _receiver_specified = other._receiver_specified;
+    _use_ssm = other._use_ssm;
+    _dest_addr = other._dest_addr;
+    _local_address = other._local_address;
+    _reuse_port = other._reuse_port;
+    _default_interface = other._default_interface;
+    _use_first_source = other._use_first_source;
+    _mc_loopback = other._mc_loopback;
+    _recv_hw_timestamps = other._recv_hw_timestamps;
+    _recv_bufsize = other._recv_bufsize;
+    _recv_timeout = other._recv_timeout;
+    _use_source = other._use_source;
+    _first_source.clear();
+    _sources.clear();
+    _dest_addr.setPort(uint16_t(_dest_addr.port() + port_offset));
+}
+
+
 //----------------------------------------------------------------------------
 // Open the socket. Override UDPSocket::open().
 //----------------------------------------------------------------------------
@@ -298,12 +347,15 @@ bool ts::UDPReceiver::open(ts::Report& report)
 #endif
         _dest_addr.port());
 
+    // Adaptive tuning of the receive buffer size (disabled when the ceiling is zero).
+    setReceiveBufferTuning(_recv_buf_ceiling);
+
     // Create UDP socket from the superclass.
     // Note: On Windows, bind must be done *before* joining multicast groups.
     bool ok =
         UDPSocket::open(report) &&
         reusePort(_reuse_port, report) &&
-        setReceiveTimestamps(_recv_timestamps, report) &&
+        setReceiveTimestamps(_recv_timestamps, _recv_hw_timestamps, report) &&
         setMulticastLoop(_mc_loopback, report) &&
         (_recv_bufsize <= 0 || setReceiveBufferSize(_recv_bufsize, report)) &&
         (_recv_timeout < 0 || setReceiveTimeout(_recv_timeout, report)) &&
@@ -347,13 +399,14 @@ bool ts::UDPReceiver::receive(void* data,
                               ts::IPv4SocketAddress& destination,
                               const ts::AbortInterface* abort,
                               ts::Report& report,
-                              MicroSecond* timestamp)
+                              MicroSecond* timestamp,
+                              bool* timestamp_hw)
 {
     // Loop on packet reception until one matching filtering criteria is found.
     for (;;) {
 
         // Wait for a UDP message from the superclass.
-        if (!UDPSocket::receive(data, max_size, ret_size, sender, destination, abort, report, timestamp)) {
+        if (!UDPSocket::receive(data, max_size, ret_size, sender, destination, abort, report, timestamp, timestamp_hw)) {
             return false;
         }
 
@@ -363,69 +416,113 @@ bool ts::UDPReceiver::receive(void* data,
             report.log(2, u"received UDP packet, source: %s, destination: %s, timestamp: %'d", {sender, destination, timestamp != nullptr ? *timestamp : -1});
         }
 
-        // Check the destination address to exclude packets from other streams.
-        // When several multicast streams use the same destination port and several
-        // applications on the same system listen to these distinct streams,
-        // the multicast MAC address management is such that any socket which
-        // is bound to the common port will receive the traffic for all streams.
-        // This is why we need to check the destination address and exclude
-        // packets which are not from the intended stream.
-        //
-        // We accept a packet in any of:
-        // 1) Actual packet destination is unknown. Probably, the system cannot
-        //    report the destination address.
-        // 2) We listen to a multicast address and the actual destination is the same.
-        // 3) If we listen to unicast traffic and the actual destination is unicast.
-        //    In that case, unicast is by definition sent to us.
-
-        if (destination.hasAddress() && ((_dest_addr.hasAddress() && destination != _dest_addr) || (!_dest_addr.hasAddress() && destination.isMulticast()))) {
-            // This is a spurious packet.
-            if (report.maxSeverity() >= Severity::Debug) {
-                // Prior report level checking to avoid evaluating parameters when not necessary.
-                report.debug(u"rejecting packet, destination: %s, expecting: %s", {destination, _dest_addr});
-            }
-            continue;
+        // Now found a packet matching all criteria.
+        if (passDatagramFilters(sender, destination, report)) {
+            return true;
         }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Receive a batch of messages. Override UDPSocket::receiveBatch().
+//----------------------------------------------------------------------------
+
+bool ts::UDPReceiver::receiveBatch(ReceivedMessage* messages, size_t max_count, size_t& ret_count, const AbortInterface* abort, Report& report)
+{
+    // Receive a batch of datagrams from the superclass.
+    if (!UDPSocket::receiveBatch(messages, max_count, ret_count, abort, report)) {
+        return false;
+    }
 
-        // Keep track of the first sender address.
-        if (!_first_source.hasAddress()) {
-            // First packet, keep address of the sender.
-            _first_source = sender;
-            _sources.insert(sender);
-
-            // With option --first-source, use this one to filter packets.
-            if (_use_first_source) {
-                assert(!_use_source.hasAddress());
-                _use_source = sender;
-                report.verbose(u"now filtering on source address %s", {sender});
+    // Apply the same filtering criteria as in receive() on each message. Accepted messages
+    // are compacted at the beginning of the array. Swapping complete descriptions (instead
+    // of copying them) keeps each caller-supplied buffer attached to its own slot.
+    size_t accepted = 0;
+    for (size_t i = 0; i < ret_count; ++i) {
+        if (passDatagramFilters(messages[i].sender, messages[i].destination, report)) {
+            if (accepted != i) {
+                std::swap(messages[accepted], messages[i]);
             }
+            accepted++;
         }
+    }
+    ret_count = accepted;
 
-        // Keep track of senders (sources) to detect or filter multiple sources.
-        if (_sources.count(sender) == 0) {
-            // Detected an additional source, warn the user that distinct streams are potentially mixed.
-            // If no source filtering is applied, this is a warning since this may affect the resulting stream.
-            // With source filtering, this is just an informational verbose-level message.
-            const int level = _use_source.hasAddress() ? Severity::Verbose : Severity::Warning;
-            if (_sources.size() == 1) {
-                report.log(level, u"detected multiple sources for the same destination %s with potentially distinct streams", {destination});
-                report.log(level, u"detected source: %s", {_first_source});
-            }
-            report.log(level, u"detected source: %s", {sender});
-            _sources.insert(sender);
+    // Note: when all messages of the batch were spurious, ret_count is zero.
+    // This is still a success, the caller shall simply retry.
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Apply destination and source filtering on one received datagram.
+//----------------------------------------------------------------------------
+
+bool ts::UDPReceiver::passDatagramFilters(const IPv4SocketAddress& sender, const IPv4SocketAddress& destination, Report& report)
+{
+    // Check the destination address to exclude packets from other streams.
+    // When several multicast streams use the same destination port and several
+    // applications on the same system listen to these distinct streams,
+    // the multicast MAC address management is such that any socket which
+    // is bound to the common port will receive the traffic for all streams.
+    // This is why we need to check the destination address and exclude
+    // packets which are not from the intended stream.
+    //
+    // We accept a packet in any of:
+    // 1) Actual packet destination is unknown. Probably, the system cannot
+    //    report the destination address.
+    // 2) We listen to a multicast address and the actual destination is the same.
+    // 3) If we listen to unicast traffic and the actual destination is unicast.
+    //    In that case, unicast is by definition sent to us.
+
+    if (destination.hasAddress() && ((_dest_addr.hasAddress() && destination != _dest_addr) || (!_dest_addr.hasAddress() && destination.isMulticast()))) {
+        // This is a spurious packet.
+        if (report.maxSeverity() >= Severity::Debug) {
+            // Prior report level checking to avoid evaluating parameters when not necessary.
+            report.debug(u"rejecting packet, destination: %s, expecting: %s", {destination, _dest_addr});
+        }
+        return false;
+    }
+
+    // Keep track of the first sender address.
+    if (!_first_source.hasAddress()) {
+        // First packet, keep address of the sender.
+        _first_source = sender;
+        _sources.insert(sender);
+
+        // With option --first-source, use this one to filter packets.
+        if (_use_first_source) {
+            assert(!_use_source.hasAddress());
+            _use_source = sender;
+            report.verbose(u"now filtering on source address %s", {sender});
         }
+    }
 
-        // Filter packets based on source address if requested.
-        if (!sender.match(_use_source)) {
-            // Not the expected source, this is a spurious packet.
-            if (report.maxSeverity() >= Severity::Debug) {
-                // Prior report level checking to avoid evaluating parameters when not necessary.
-                report.debug(u"rejecting packet, source: %s, expecting: %s", {sender, _use_source});
-            }
-            continue;
+    // Keep track of senders (sources) to detect or filter multiple sources.
+    if (_sources.count(sender) == 0) {
+        // Detected an additional source, warn the user that distinct streams are potentially mixed.
+        // If no source filtering is applied, this is a warning since this may affect the resulting stream.
+        // With source filtering, this is just an informational verbose-level message.
+        const int level = _use_source.hasAddress() ? Severity::Verbose : Severity::Warning;
+        if (_sources.size() == 1) {
+            report.log(level, u"detected multiple sources for the same destination %s with potentially distinct streams", {destination});
+            report.log(level, u"detected source: %s", {_first_source});
         }
+        report.log(level, u"detected source: %s", {sender});
+        _sources.insert(sender);
+    }
 
-        // Now found a packet matching all criteria.
-        return true;
+    // Filter packets based on source address if requested.
+    if (!sender.match(_use_source)) {
+        // Not the expected source, this is a spurious packet.
+        if (report.maxSeverity() >= Severity::Debug) {
+            // Prior report level checking to avoid evaluating parameters when not necessary.
+            report.debug(u"rejecting packet, source: %s, expecting: %s", {sender, _use_source});
+        }
+        return false;
     }
+
+    // Now found a packet matching all criteria.
+    return true;
 }
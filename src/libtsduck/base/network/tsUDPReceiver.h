@@ -102,6 +102,15 @@ namespace ts {
         //!
         void setParameters(const IPv4SocketAddress& localAddress, bool reusePort, size_t bufferSize = 0);
 
+        //!
+        //! Copy the reception parameters of another UDP receiver, with an offset on the UDP port.
+        //! This is typically used to receive an auxiliary stream of the main one, such as a
+        //! SMPTE 2022-1 FEC stream which is sent on the media port plus 2 or 4.
+        //! @param [in] other UDP receiver to copy the parameters from, as loaded by loadArgs().
+        //! @param [in] port_offset Value to add to the destination UDP port.
+        //!
+        void copyParameters(const UDPReceiver& other, uint16_t port_offset);
+
         //!
         //! Set reception timeout as if it comes from command line.
         //! @param [in] timeout Receive timeout in milliseconds. No timeout if zero or negative.
@@ -117,7 +126,13 @@ namespace ts {
                              IPv4SocketAddress& destination,
                              const AbortInterface* abort = nullptr,
                              Report& report = CERR,
-                             MicroSecond* timestamp = nullptr) override;
+                             MicroSecond* timestamp = nullptr,
+                             bool* timestamp_hw = nullptr) override;
+        virtual bool receiveBatch(ReceivedMessage* messages,
+                                  size_t max_count,
+                                  size_t& ret_count,
+                                  const AbortInterface* abort = nullptr,
+                                  Report& report = CERR) override;
 
     private:
         bool              _dest_is_parameter = true;   // Destination address is a command line parameter, not an option.
@@ -132,7 +147,9 @@ namespace ts {
         bool              _use_first_source = false;   // Use socket address of first received packet to filter subsequent packets.
         bool              _mc_loopback = true;         // Multicast loopback option
         bool              _recv_timestamps = true;     // Get receive timestamps, currently hardcoded, is there a reason to disable it?
+        bool              _recv_hw_timestamps = false; // Request hardware timestamps from the network interface.
         size_t            _recv_bufsize = 0;           // Socket receive buffer size.
+        size_t            _recv_buf_ceiling = 0;       // Max size for adaptive buffer tuning, zero means disabled.
         MilliSecond       _recv_timeout {-1};          // Receive timeout.
         IPv4SocketAddress _use_source {};              // Filter on this socket address of sender (can be a simple filter of an SSM source).
         IPv4SocketAddress _first_source {};            // Socket address of first received packet.
@@ -140,5 +157,9 @@ namespace ts {
 
         // Get the command line argument for the destination parameter.
         const UChar* destinationOptionName() const { return _dest_is_parameter ? u"" : u"ip-udp"; }
+
+        // Apply destination and source filtering on one received datagram.
+        // Return true when the datagram matches all criteria, false when it shall be dropped.
+        bool passDatagramFilters(const IPv4SocketAddress& sender, const IPv4SocketAddress& destination, Report& report);
     };
 }
@@ -224,10 +224,21 @@ bool ts::UDPSocket::setMulticastLoop(bool on, Report& report)
 // Enable or disable the generation of receive timestamps.
 //----------------------------------------------------------------------------
 
-bool ts::UDPSocket::setReceiveTimestamps(bool on, Report& report)
+bool ts::UDPSocket::setReceiveTimestamps(bool on, bool hardware, Report& report)
 {
     // The option exists only on Linux and is silently ignored on other systems.
 #if defined(TS_LINUX)
+    if (on && hardware) {
+        // Request hardware timestamps from the NIC, with software timestamps as
+        // fallback for packets without one. The timestamping unit of the NIC must
+        // be enabled separately (ethtool), otherwise only the fallback applies.
+        const int flags = SOF_TIMESTAMPING_RX_HARDWARE | SOF_TIMESTAMPING_RAW_HARDWARE | SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE;
+        if (::setsockopt(getSocket(), SOL_SOCKET, SO_TIMESTAMPING, &flags, sizeof(flags)) == 0) {
+            return true;
+        }
+        // Hardware timestamps are a request only, fall back to software timestamps.
+        report.verbose(u"socket option SO_TIMESTAMPING: %s, using software timestamps", {SysSocketErrorCodeMessage()});
+    }
     // Set SO_TIMESTAMPNS option which reports timestamps in nanoseconds (struct timespec).
     int enable = int(on);
     if (::setsockopt(getSocket(), SOL_SOCKET, SO_TIMESTAMPNS, &enable, sizeof(enable)) != 0) {
@@ -240,6 +251,51 @@ bool ts::UDPSocket::setReceiveTimestamps(bool on, Report& report)
 }
 
 
+//----------------------------------------------------------------------------
+// Enable or disable kernel-scheduled transmission (SO_TXTIME).
+//----------------------------------------------------------------------------
+
+bool ts::UDPSocket::setTransmitTime(bool on, Report& report)
+{
+#if defined(TS_LINUX) && defined(SO_TXTIME)
+    // Transmit times are expressed on the monotonic clock, the one which is used
+    // by the ETF qdisc when configured with "clockid CLOCK_MONOTONIC".
+    if (on) {
+        ::sock_txtime txt;
+        TS_ZERO(txt);
+        txt.clockid = CLOCK_MONOTONIC;
+        if (::setsockopt(getSocket(), SOL_SOCKET, SO_TXTIME, &txt, sizeof(txt)) != 0) {
+            report.error(u"socket option SO_TXTIME: " + SysSocketErrorCodeMessage());
+            return false;
+        }
+    }
+    _txtime_active = on;
+    return true;
+#else
+    // Unlike receive timestamps, silently ignoring the option would break the pacing.
+    report.error(u"kernel-scheduled transmission is not supported on this system");
+    return false;
+#endif
+}
+
+
+//----------------------------------------------------------------------------
+// Get the current value of the reference clock for transmit timestamps.
+//----------------------------------------------------------------------------
+
+ts::NanoSecond ts::UDPSocket::TransmitClock()
+{
+#if defined(TS_LINUX) && defined(SO_TXTIME)
+    ::timespec now;
+    TS_ZERO(now);
+    ::clock_gettime(CLOCK_MONOTONIC, &now);
+    return NanoSecond(now.tv_sec) * NanoSecPerSec + NanoSecond(now.tv_nsec);
+#else
+    return 0;
+#endif
+}
+
+
 //----------------------------------------------------------------------------
 // Enable or disable the broadcast option.
 //----------------------------------------------------------------------------
@@ -426,6 +482,91 @@ bool ts::UDPSocket::send(const void* data, size_t size, const IPv4SocketAddress&
 }
 
 
+//----------------------------------------------------------------------------
+// Send a batch of messages in one operation when supported by the system.
+//----------------------------------------------------------------------------
+
+bool ts::UDPSocket::sendBatch(const SentMessage* messages, size_t count, Report& report)
+{
+    return sendBatch(messages, count, _default_destination, report);
+}
+
+bool ts::UDPSocket::sendBatch(const SentMessage* messages, size_t count, const IPv4SocketAddress& dest, Report& report)
+{
+#if defined(TS_LINUX)
+
+    ::sockaddr addr;
+    dest.copy(addr);
+
+    // Maximum number of messages per sendmmsg() system call.
+    constexpr size_t MAX_BATCH = 64;
+    ::mmsghdr hdrs[MAX_BATCH];
+    ::iovec vecs[MAX_BATCH];
+#if defined(SO_TXTIME)
+    alignas(::cmsghdr) uint8_t ctrl[MAX_BATCH][CMSG_SPACE(sizeof(uint64_t))];
+#endif
+
+    while (count > 0) {
+        const size_t burst = std::min(count, MAX_BATCH);
+        TS_ZERO(hdrs);
+        TS_ZERO(vecs);
+        for (size_t i = 0; i < burst; ++i) {
+            vecs[i].iov_base = const_cast<void*>(messages[i].data);
+            vecs[i].iov_len = messages[i].size;
+            hdrs[i].msg_hdr.msg_name = &addr;
+            hdrs[i].msg_hdr.msg_namelen = sizeof(addr);
+            hdrs[i].msg_hdr.msg_iov = &vecs[i];
+            hdrs[i].msg_hdr.msg_iovlen = 1;
+#if defined(SO_TXTIME)
+            // Attach the requested transmit time as ancillary data, the kernel
+            // packet scheduler will release the packet at that time.
+            if (_txtime_active && messages[i].txtime > 0) {
+                std::memset(ctrl[i], 0, sizeof(ctrl[i]));
+                hdrs[i].msg_hdr.msg_control = ctrl[i];
+                hdrs[i].msg_hdr.msg_controllen = CMSG_SPACE(sizeof(uint64_t));
+                ::cmsghdr* cmsg = CMSG_FIRSTHDR(&hdrs[i].msg_hdr);
+                cmsg->cmsg_level = SOL_SOCKET;
+                cmsg->cmsg_type = SCM_TXTIME;
+                cmsg->cmsg_len = CMSG_LEN(sizeof(uint64_t));
+                const uint64_t txtime = uint64_t(messages[i].txtime);
+                std::memcpy(CMSG_DATA(cmsg), &txtime, sizeof(txtime));
+            }
+#endif
+        }
+
+        // The system call may send less messages than requested, simply continue with the rest.
+        size_t sent = 0;
+        while (sent < burst) {
+            const int result = ::sendmmsg(getSocket(), hdrs + sent, unsigned(burst - sent), 0);
+            if (result < 0) {
+                if (LastSysSocketErrorCode() == EINTR) {
+                    // Got a signal, not a user interrupt, will ignore it.
+                    continue;
+                }
+                report.error(u"error sending UDP message: " + SysSocketErrorCodeMessage());
+                return false;
+            }
+            sent += size_t(result);
+        }
+        messages += burst;
+        count -= burst;
+    }
+    return true;
+
+#else
+
+    // No batched transmission on this platform, send one message at a time.
+    for (size_t i = 0; i < count; ++i) {
+        if (!send(messages[i].data, messages[i].size, dest, report)) {
+            return false;
+        }
+    }
+    return true;
+
+#endif
+}
+
+
 //----------------------------------------------------------------------------
 // Receive a message.
 // If abort interface is non-zero, invoke it when I/O is interrupted
@@ -440,18 +581,22 @@ bool ts::UDPSocket::receive(void* data,
                             IPv4SocketAddress& destination,
                             const AbortInterface* abort,
                             Report& report,
-                            MicroSecond* timestamp)
+                            MicroSecond* timestamp,
+                            bool* timestamp_hw)
 {
     // Clear timestamp if specified.
     if (timestamp != nullptr) {
         *timestamp = -1;
     }
+    if (timestamp_hw != nullptr) {
+        *timestamp_hw = false;
+    }
 
     // Loop on unsollicited interrupts
     for (;;) {
 
         // Wait for a message.
-        const SysSocketErrorCode err = receiveOne(data, max_size, ret_size, sender, destination, report, timestamp);
+        const SysSocketErrorCode err = receiveOne(data, max_size, ret_size, sender, destination, report, timestamp, timestamp_hw);
 
         if (abort != nullptr && abort->aborting()) {
             // Aborting, no error message.
@@ -460,6 +605,8 @@ bool ts::UDPSocket::receive(void* data,
         else if (err == SYS_SUCCESS) {
             // Sometimes, we get "successful" empty message coming from nowhere. Ignore them.
             if (ret_size > 0 || sender.hasAddress()) {
+                // Adaptive tuning of the receive buffer size (no-op when disabled).
+                checkReceiveBufferTuning(report);
                 return true;
             }
         }
@@ -495,7 +642,8 @@ ts::SysSocketErrorCode ts::UDPSocket::receiveOne(void* data,
                                                  IPv4SocketAddress& sender,
                                                  IPv4SocketAddress& destination,
                                                  Report& report,
-                                                 MicroSecond* timestamp)
+                                                 MicroSecond* timestamp,
+                                                 bool* timestamp_hw)
 {
     // Clear returned values
     ret_size = 0;
@@ -600,6 +748,26 @@ ts::SysSocketErrorCode ts::UDPSocket::receiveOne(void* data,
         return LastSysSocketErrorCode();
     }
 
+    // Browse returned ancillary data.
+    parseAncillaryData(hdr, destination, timestamp, timestamp_hw);
+
+#endif // Windows vs. UNIX
+
+    // Successfully received a message
+    ret_size = size_t(insize);
+    sender = IPv4SocketAddress(sender_sock);
+
+    return SYS_SUCCESS;
+}
+
+
+//----------------------------------------------------------------------------
+// Extract destination address and timestamp from received ancillary data.
+//----------------------------------------------------------------------------
+
+#if !defined(TS_WINDOWS)
+void ts::UDPSocket::parseAncillaryData(::msghdr& hdr, IPv4SocketAddress& destination, MicroSecond* timestamp, bool* timestamp_hw)
+{
     TS_PUSH_WARNING()
     TS_GCC_NOWARNING(zero-as-null-pointer-constant) // invalid definition of CMSG_NXTHDR in musl libc (Alpine Linux)
 #if defined(TS_OPENBSD)
@@ -634,16 +802,119 @@ ts::SysSocketErrorCode ts::UDPSocket::receiveOne(void* data,
                 *timestamp = nano / NanoSecPerMicroSec;
             }
         }
+        else if (timestamp != nullptr && cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPING && cmsg->cmsg_len >= 3 * sizeof(::timespec)) {
+            // SO_TIMESTAMPING reports an array of 3 timespec: [0] is the software
+            // timestamp, [2] is the raw hardware timestamp from the NIC clock.
+            // Prefer the hardware timestamp when the NIC produced one.
+            const ::timespec* ts = reinterpret_cast<const ::timespec*>(CMSG_DATA(cmsg));
+            const NanoSecond hw_nano = NanoSecond(ts[2].tv_sec) * NanoSecPerSec + NanoSecond(ts[2].tv_nsec);
+            const NanoSecond sw_nano = NanoSecond(ts[0].tv_sec) * NanoSecPerSec + NanoSecond(ts[0].tv_nsec);
+            if (hw_nano != 0) {
+                *timestamp = hw_nano / NanoSecPerMicroSec;
+                if (timestamp_hw != nullptr) {
+                    *timestamp_hw = true;
+                }
+            }
+            else if (sw_nano != 0) {
+                *timestamp = sw_nano / NanoSecPerMicroSec;
+            }
+        }
 #endif
     }
 
     TS_POP_WARNING()
+}
+#endif // !TS_WINDOWS
 
-#endif // Windows vs. UNIX
 
-    // Successfully received a message
-    ret_size = size_t(insize);
-    sender = IPv4SocketAddress(sender_sock);
+//----------------------------------------------------------------------------
+// Receive a batch of messages in one operation when supported by the system.
+//----------------------------------------------------------------------------
 
-    return SYS_SUCCESS;
+bool ts::UDPSocket::receiveBatch(ReceivedMessage* messages, size_t max_count, size_t& ret_count, const AbortInterface* abort, Report& report)
+{
+    ret_count = 0;
+    if (max_count == 0) {
+        return true;
+    }
+
+#if defined(TS_LINUX)
+
+    // Maximum number of messages per recvmmsg() system call. Larger batches are
+    // simply truncated, the caller will naturally retry with the rest.
+    constexpr size_t MAX_BATCH = 64;
+    const size_t count = std::min(max_count, MAX_BATCH);
+
+    // Per-message system structures.
+    ::mmsghdr hdrs[MAX_BATCH];
+    ::iovec vecs[MAX_BATCH];
+    ::sockaddr senders[MAX_BATCH];
+    uint8_t ancil_data[MAX_BATCH][256];
+    TS_ZERO(hdrs);
+    TS_ZERO(vecs);
+    TS_ZERO(senders);
+    TS_ZERO(ancil_data);
+
+    for (size_t i = 0; i < count; ++i) {
+        vecs[i].iov_base = messages[i].data;
+        vecs[i].iov_len = messages[i].max_size;
+        hdrs[i].msg_hdr.msg_name = &senders[i];
+        hdrs[i].msg_hdr.msg_namelen = sizeof(senders[i]);
+        hdrs[i].msg_hdr.msg_iov = &vecs[i];
+        hdrs[i].msg_hdr.msg_iovlen = 1;
+        hdrs[i].msg_hdr.msg_control = ancil_data[i];
+        hdrs[i].msg_hdr.msg_controllen = sizeof(ancil_data[i]);
+    }
+
+    // Loop on unsollicited interrupts.
+    for (;;) {
+
+        // Block until the first message only, then return with whatever is already queued.
+        const int insize = ::recvmmsg(getSocket(), hdrs, unsigned(count), MSG_WAITFORONE, nullptr);
+
+        if (abort != nullptr && abort->aborting()) {
+            // Aborting, no error message.
+            return false;
+        }
+        else if (insize > 0) {
+            // Successfully received a batch of messages.
+            for (int i = 0; i < insize; ++i) {
+                ReceivedMessage& msg(messages[size_t(i)]);
+                msg.ret_size = size_t(hdrs[i].msg_len);
+                msg.sender = IPv4SocketAddress(senders[i]);
+                msg.destination.clear();
+                msg.timestamp = -1;
+                msg.timestamp_hw = false;
+                parseAncillaryData(hdrs[i].msg_hdr, msg.destination, &msg.timestamp, &msg.timestamp_hw);
+            }
+            ret_count = size_t(insize);
+            // Adaptive tuning of the receive buffer size (no-op when disabled).
+            checkReceiveBufferTuning(report);
+            return true;
+        }
+        else if (LastSysSocketErrorCode() == EINTR) {
+            // Got a signal, not a user interrupt, will ignore it.
+            report.debug(u"signal, not user interrupt");
+        }
+        else {
+            // Abort on non-interrupt errors.
+            if (isOpen()) {
+                // Report the error only if the error does not result from a close in another thread.
+                report.error(u"error receiving from UDP socket: %s", {SysSocketErrorCodeMessage()});
+            }
+            return false;
+        }
+    }
+
+#else
+
+    // No batched reception on this platform, fall back to one single message.
+    ReceivedMessage& msg(messages[0]);
+    if (receive(msg.data, msg.max_size, msg.ret_size, msg.sender, msg.destination, abort, report, &msg.timestamp, &msg.timestamp_hw)) {
+        ret_count = 1;
+        return true;
+    }
+    return false;
+
+#endif
 }
@@ -189,17 +189,49 @@ namespace ts {
         //! Enable or disable the generation of receive timestamps.
         //!
         //! When enabled, each received UDP packets comes with a time stamp (see receive()).
-        //! When possible, a hardware timestamp from the NIC is received. Otherwise, a software
-        //! timestamp is generated by the kernel.
-        //!
-        //! When enabled, this option is a @æ request, not a requirement.
+        //! By default, the timestamp is generated by the kernel when the packet enters the
+        //! IP stack. When @a hardware is true, a timestamp from the NIC hardware clock is
+        //! requested instead, with the kernel timestamp as fallback for packets without one.
+        //! Hardware timestamps eliminate the interrupt and scheduling jitter from latency
+        //! measurements but the timestamping unit of the NIC must be enabled separately
+        //! (see ethtool on Linux) and the NIC clock may not be synchronized with the system
+        //! clock unless a PTP daemon disciplines it.
+        //!
+        //! When enabled, this option is a request, not a requirement.
         //! Currently, this option is supported on Linux only. It is ignored on other systems.
         //!
         //! @param [in] on If true, receive timestamps are activated on the socket. Otherwise, they are disabled.
+        //! @param [in] hardware If true, request hardware timestamps from the network interface.
+        //! @param [in,out] report Where to report error.
+        //! @return True on success, false on error.
+        //!
+        bool setReceiveTimestamps(bool on, bool hardware = false, Report& report = CERR);
+
+        //!
+        //! Enable or disable kernel-scheduled transmission (socket option SO_TXTIME).
+        //!
+        //! When enabled, each message in a batched send operation may carry a transmit
+        //! timestamp (see SentMessage::txtime). The kernel packet scheduler, typically
+        //! the ETF qdisc, holds the packet and releases it at the requested time. The
+        //! pacing precision then no longer depends on user-space wakeup latency.
+        //!
+        //! Currently, this option is supported on Linux only. Unlike receive timestamps,
+        //! this is a requirement, not a request: an error is reported on other systems.
+        //!
+        //! @param [in] on If true, kernel-scheduled transmission is activated on the socket.
         //! @param [in,out] report Where to report error.
         //! @return True on success, false on error.
+        //! @see TransmitClock()
+        //!
+        bool setTransmitTime(bool on, Report& report = CERR);
+
+        //!
+        //! Get the current value of the reference clock for kernel-scheduled transmission.
+        //! Transmit timestamps in SentMessage::txtime are absolute values on this clock.
+        //! @return Current clock value in nano-seconds, zero when kernel-scheduled
+        //! transmission is not supported on this system.
         //!
-        bool setReceiveTimestamps(bool on, Report& report = CERR);
+        static NanoSecond TransmitClock();
 
         //!
         //! Enable or disable the broadcast option.
@@ -301,6 +333,42 @@ namespace ts {
         //!
         virtual bool send(const void* data, size_t size, Report& report = CERR);
 
+        //!
+        //! Description of one datagram in a batched send operation.
+        //!
+        struct TSDUCKDLL SentMessage
+        {
+            const void* data = nullptr;  //!< Address of the message to send.
+            size_t      size = 0;        //!< Size in bytes of the message to send.
+            NanoSecond  txtime = 0;      //!< Optional transmit time on the clock of TransmitClock(), zero to send immediately. Requires setTransmitTime().
+        };
+
+        //!
+        //! Send a batch of messages to a destination address and port in one operation
+        //! when supported by the system.
+        //!
+        //! On Linux, the whole batch is sent with as few sendmmsg() system calls as
+        //! possible. On other systems, this method falls back to one send() per message.
+        //!
+        //! @param [in] messages Address of an array of @a count message descriptions.
+        //! @param [in] count Number of messages to send.
+        //! @param [in] destination Socket address of the destination.
+        //! @param [in,out] report Where to report error.
+        //! @return True on success, false on error.
+        //!
+        virtual bool sendBatch(const SentMessage* messages, size_t count, const IPv4SocketAddress& destination, Report& report = CERR);
+
+        //!
+        //! Send a batch of messages to the default destination address and port in one
+        //! operation when supported by the system.
+        //!
+        //! @param [in] messages Address of an array of @a count message descriptions.
+        //! @param [in] count Number of messages to send.
+        //! @param [in,out] report Where to report error.
+        //! @return True on success, false on error.
+        //!
+        virtual bool sendBatch(const SentMessage* messages, size_t count, Report& report = CERR);
+
         //!
         //! Receive a message.
         //!
@@ -317,6 +385,8 @@ namespace ts {
         //! @param [out] timestamp When not null, return the receive timestamp in micro-seconds.
         //! Use setReceiveTimestamps() to enable the generation of receive timestamps.
         //! If the returned value is negative, no timestamp is available.
+        //! @param [out] timestamp_hw When not null, set to true when @a timestamp comes from
+        //! the NIC hardware clock and false when it is a kernel software timestamp.
         //! @return True on success, false on error.
         //!
         virtual bool receive(void* data,
@@ -326,7 +396,48 @@ namespace ts {
                              IPv4SocketAddress& destination,
                              const AbortInterface* abort = nullptr,
                              Report& report = CERR,
-                             MicroSecond* timestamp = nullptr);
+                             MicroSecond* timestamp = nullptr,
+                             bool* timestamp_hw = nullptr);
+
+        //!
+        //! Description of one datagram in a batched receive operation.
+        //! Before calling receiveBatch(), the caller fills @a data and @a max_size
+        //! for each message. The other fields are returned values.
+        //!
+        struct TSDUCKDLL ReceivedMessage
+        {
+            void*             data = nullptr;    //!< Address of the buffer for the received message (caller-supplied).
+            size_t            max_size = 0;      //!< Size in bytes of the reception buffer (caller-supplied).
+            size_t            ret_size = 0;      //!< Returned size in bytes of the received message.
+            IPv4SocketAddress sender {};         //!< Returned socket address of the sender.
+            IPv4SocketAddress destination {};    //!< Returned socket address of the packet destination.
+            MicroSecond       timestamp = -1;    //!< Returned receive timestamp in micro-seconds, -1 if not available.
+            bool              timestamp_hw = false;  //!< Returned indicator of a timestamp from the NIC hardware clock.
+        };
+
+        //!
+        //! Receive a batch of messages in one operation when supported by the system.
+        //!
+        //! On Linux, this method uses recvmmsg() and fills as many messages as can be
+        //! received in one system call. It waits for the first message only, then
+        //! returns immediately with whatever additional datagrams are already queued.
+        //! On other systems, this method falls back to one single receive() operation.
+        //!
+        //! @param [in,out] messages Address of an array of @a max_count message descriptions.
+        //! On input, the @a data and @a max_size fields of each message must be set.
+        //! @param [in] max_count Maximum number of messages to receive.
+        //! @param [out] ret_count Number of actually received messages, the first
+        //! @a ret_count elements of @a messages are filled.
+        //! @param [in] abort If non-zero, invoked when I/O is interrupted
+        //! (in case of user-interrupt, return, otherwise retry).
+        //! @param [in,out] report Where to report error.
+        //! @return True on success, false on error.
+        //!
+        virtual bool receiveBatch(ReceivedMessage* messages,
+                                  size_t max_count,
+                                  size_t& ret_count,
+                                  const AbortInterface* abort = nullptr,
+                                  Report& report = CERR);
 
         // Implementation of Socket interface.
         virtual bool open(Report& report = CERR) override;
@@ -385,13 +496,19 @@ namespace ts {
         // Private members
         IPv4SocketAddress _local_address {};
         IPv4SocketAddress _default_destination {};
+        bool              _txtime_active = false;  // Kernel-scheduled transmission is enabled.
 #if !defined(TS_NO_SSM)
         SSMReqSet         _ssmcast {};  // Current set of source-specific multicast memberships
 #endif
         MReqSet           _mcast {};    // Current set of multicast memberships
 
         // Perform one receive operation. Hide the system mud.
-        SysSocketErrorCode receiveOne(void* data, size_t max_size, size_t& ret_size, IPv4SocketAddress& sender, IPv4SocketAddress& destination, Report& report, MicroSecond* timestamp);
+        SysSocketErrorCode receiveOne(void* data, size_t max_size, size_t& ret_size, IPv4SocketAddress& sender, IPv4SocketAddress& destination, Report& report, MicroSecond* timestamp, bool* timestamp_hw);
+
+#if !defined(TS_WINDOWS) || defined(DOXYGEN)
+        // Extract destination address and receive timestamp from the ancillary data of a received message.
+        void parseAncillaryData(::msghdr& hdr, IPv4SocketAddress& destination, MicroSecond* timestamp, bool* timestamp_hw);
+#endif
 
         // Furiously idiotic Windows feature, see comment in receiveOne()
 #if defined(TS_WINDOWS)
@@ -162,6 +162,19 @@ namespace ts {
         //!
         void enableCompression(bool on = true) { _useCompression = on; }
 
+        //!
+        //! Enable the reuse of connections between transfers.
+        //! Connection reuse is disabled by default. When enabled, the connection
+        //! to the server is kept alive at the end of a transfer. When the next
+        //! transfer on the same WebRequest object targets the same server, the
+        //! connection is reused, saving the TCP, TLS and DNS setup time. This is
+        //! a significant saving when many small files are downloaded in sequence
+        //! from the same server (HLS segments for instance).
+        //! Currently implemented on UNIX systems only (libcurl).
+        //! @param [in] on Boolean setting connection reuse on or off.
+        //!
+        void enableConnectionReuse(bool on = true) { _connectionReuse = on; }
+
         //!
         //! Get the current user agent name to use in HTTP headers.
         //! @return A constant reference to the user agent name to use in HTTP headers.
@@ -359,6 +372,7 @@ namespace ts {
         UString       _proxyUser {};
         UString       _proxyPassword {};
         bool          _useCompression = false;
+        bool          _connectionReuse = false;    // keep the connection alive between transfers
         UString       _cookiesFileName {};
         bool          _useCookies = false;
         bool          _deleteCookiesFile = false; // delete the cookies file on close
@@ -0,0 +1,151 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsAsyncLogQueue.h"
+#include "tsFatal.h"
+
+
+//----------------------------------------------------------------------------
+// Constructor and destructor.
+//----------------------------------------------------------------------------
+
+ts::AsyncLogQueue::AsyncLogQueue(size_t maxMessages) :
+    _max_messages(std::max<size_t>(1, maxMessages)),
+    _head(&_stub),
+    _tail(&_stub)
+{
+}
+
+ts::AsyncLogQueue::~AsyncLogQueue()
+{
+    // No concurrent access is possible at this point, delete pending nodes.
+    Node* node = _head;
+    while (node != nullptr) {
+        Node* next = node->next.load(std::memory_order_relaxed);
+        if (node != &_stub) {
+            delete node;
+        }
+        node = next;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Lock-free push of a node at the tail of the list.
+//----------------------------------------------------------------------------
+
+void ts::AsyncLogQueue::pushNode(Node* node)
+{
+    // Swap the tail, then link the previous tail to the new node. Between the
+    // two steps, the node is not yet reachable from the head; the consumer
+    // handles that transient state in popNode().
+    Node* prev = _tail.exchange(node, std::memory_order_acq_rel);
+    prev->next.store(node, std::memory_order_release);
+}
+
+
+//----------------------------------------------------------------------------
+// Pop the oldest node, null when the queue is empty. Consumer only.
+//----------------------------------------------------------------------------
+
+ts::AsyncLogQueue::Node* ts::AsyncLogQueue::popNode()
+{
+    Node* head = _head;
+    Node* next = head->next.load(std::memory_order_acquire);
+
+    // Skip the permanent stub node.
+    if (head == &_stub) {
+        if (next == nullptr) {
+            // The queue is empty.
+            return nullptr;
+        }
+        _head = head = next;
+        next = head->next.load(std::memory_order_acquire);
+    }
+    if (next == nullptr && head == _tail.load(std::memory_order_acquire)) {
+        // Head is the only element. Reinsert the stub behind it so that the
+        // last message can be delivered.
+        _stub.next.store(nullptr, std::memory_order_relaxed);
+        pushNode(&_stub);
+    }
+    while ((next = head->next.load(std::memory_order_acquire)) == nullptr) {
+        // A producer has swapped the tail but not yet linked its node.
+        // The link appears within a few instructions, spin.
+    }
+    _head = next;
+    return head;
+}
+
+
+//----------------------------------------------------------------------------
+// Enqueue a message. Can be called from any thread, never blocks.
+//----------------------------------------------------------------------------
+
+bool ts::AsyncLogQueue::enqueue(bool terminate, int severity, const UString& text, bool force)
+{
+    // Bounded queue: count the message first, drop on overflow.
+    if (force) {
+        _count.fetch_add(1, std::memory_order_relaxed);
+    }
+    else if (_count.fetch_add(1, std::memory_order_relaxed) >= _max_messages) {
+        _count.fetch_sub(1, std::memory_order_relaxed);
+        _dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    Node* node = new Node;
+    CheckNonNull(node);
+    node->terminate = terminate;
+    node->severity = severity;
+    node->text = text;
+    pushNode(node);
+
+    // Wake up the consumer when it is idle. The fence pairs with the one in
+    // dequeue(): either this thread sees the idle flag, or the consumer sees
+    // the pushed node before blocking (classical store-buffering pattern).
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_idle.load(std::memory_order_relaxed)) {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _idle.store(false, std::memory_order_relaxed);
+        }
+        _wake.notify_one();
+    }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Dequeue the next message. Single consumer thread, block when empty.
+//----------------------------------------------------------------------------
+
+void ts::AsyncLogQueue::dequeue(bool& terminate, int& severity, UString& text)
+{
+    for (;;) {
+        Node* node = popNode();
+        if (node == nullptr) {
+            // The queue looks empty: declare the consumer idle, check again,
+            // then block. See the matching fence in enqueue().
+            std::unique_lock<std::mutex> lock(_mutex);
+            _idle.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            node = popNode();
+            if (node == nullptr) {
+                _wake.wait(lock);
+                continue;
+            }
+            _idle.store(false, std::memory_order_relaxed);
+        }
+        _count.fetch_sub(1, std::memory_order_relaxed);
+        terminate = node->terminate;
+        severity = node->severity;
+        text = std::move(node->text);
+        delete node;
+        return;
+    }
+}
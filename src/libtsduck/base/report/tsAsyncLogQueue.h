@@ -0,0 +1,104 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Lock-free message queue for asynchronous log reporting.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsUString.h"
+
+namespace ts {
+    //!
+    //! Lock-free message queue for asynchronous log reporting.
+    //! @ingroup log
+    //!
+    //! This is a multi-producer, single-consumer (MPSC) queue. Any number of
+    //! application threads enqueue messages without ever taking a lock: an
+    //! enqueue is a pair of atomic operations, regardless of the contention.
+    //! A message storm on the producer side can therefore never block or slow
+    //! down the packet processing path of the application threads.
+    //!
+    //! The queue is bounded. When the maximum number of messages is reached,
+    //! new messages are dropped and counted. The consumer can fetch and reset
+    //! the dropped message counter to report a summary. Critical messages,
+    //! such as the termination request, can be enqueued in "force" mode,
+    //! bypassing the bound.
+    //!
+    //! The single consumer thread blocks when the queue is empty. A producer
+    //! signals the consumer only when it is known to be idle, so the signaling
+    //! mutex is never contended while the consumer keeps up with the flow.
+    //!
+    class TSDUCKDLL AsyncLogQueue
+    {
+        TS_NOCOPY(AsyncLogQueue);
+    public:
+        //!
+        //! Constructor.
+        //! @param [in] maxMessages Maximum number of queued messages before dropping.
+        //!
+        AsyncLogQueue(size_t maxMessages);
+
+        //!
+        //! Destructor.
+        //!
+        ~AsyncLogQueue();
+
+        //!
+        //! Enqueue a message. Can be called from any thread, never blocks.
+        //! @param [in] terminate Termination request indicator.
+        //! @param [in] severity Severity of the message.
+        //! @param [in] text Message text.
+        //! @param [in] force When true, bypass the maximum queue size, never drop.
+        //! @return True if the message was enqueued, false if it was dropped on overflow.
+        //!
+        bool enqueue(bool terminate, int severity, const UString& text, bool force = false);
+
+        //!
+        //! Dequeue the next message. Must be called from one single consumer
+        //! thread. Block when the queue is empty.
+        //! @param [out] terminate Termination request indicator.
+        //! @param [out] severity Severity of the message.
+        //! @param [out] text Message text.
+        //!
+        void dequeue(bool& terminate, int& severity, UString& text);
+
+        //!
+        //! Get and reset the number of messages which were dropped on overflow.
+        //! @return Number of dropped messages since the previous call.
+        //!
+        size_t fetchDroppedCount() { return _dropped.exchange(0, std::memory_order_relaxed); }
+
+    private:
+        // One node in the intrusive linked list of messages.
+        struct Node
+        {
+            std::atomic<Node*> next {nullptr};
+            bool    terminate = false;
+            int     severity = 0;
+            UString text {};
+        };
+
+        const size_t            _max_messages;    // Maximum number of queued messages.
+        Node                    _stub {};         // Permanent empty node, never delivered.
+        Node*                   _head;            // Oldest node, accessed by the consumer only.
+        std::atomic<Node*>      _tail;            // Newest node, swapped by producers.
+        std::atomic<size_t>     _count {0};       // Number of queued messages.
+        std::atomic<size_t>     _dropped {0};     // Number of messages dropped on overflow.
+        std::atomic<bool>       _idle {false};    // The consumer is (about to be) blocked.
+        std::mutex              _mutex {};        // Consumer blocking only, never taken by producers while the consumer keeps up.
+        std::condition_variable _wake {};         // Signaled by a producer when the consumer is idle.
+
+        // Lock-free push of a node at the tail of the list.
+        void pushNode(Node* node);
+
+        // Pop the oldest node, null when the queue is empty. Consumer only.
+        Node* popNode();
+    };
+}
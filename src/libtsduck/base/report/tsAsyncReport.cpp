@@ -7,6 +7,7 @@
 //----------------------------------------------------------------------------
 
 #include "tsAsyncReport.h"
+#include "tsTime.h"
 
 
 //----------------------------------------------------------------------------
@@ -44,7 +45,7 @@ void ts::AsyncReport::terminate()
     if (!_terminated) {
         // Insert an "end of report" message in the queue.
         // This message will tell the logging thread to terminate.
-        _log_queue.forceEnqueue(new LogMessage(true, 0, UString()));
+        _log_queue.enqueue(true, 0, UString(), true);
 
         // Wait for termination of the logging thread
         waitForTermination();
@@ -69,9 +70,9 @@ void ts::AsyncReport::writeLog(int severity, const UString &msg)
 #endif
 
     if (!_terminated) {
-        // Enqueue the message immediately (timeout = 0), drop message on overflow.
-        // On the contrary, in synchronous mode, wait infinitely until the message is queued.
-        _log_queue.enqueue(new LogMessage(false, severity, msg), _synchronous ? Infinite : 0);
+        // Enqueue the message without ever blocking, drop message on overflow.
+        // In synchronous mode, force the message in the queue, never drop it.
+        _log_queue.enqueue(false, severity, msg, _synchronous);
     }
 }
 
@@ -82,19 +83,31 @@ void ts::AsyncReport::writeLog(int severity, const UString &msg)
 
 void ts::AsyncReport::main()
 {
-    LogMessagePtr msg;
+    bool terminate = false;
+    int severity = Severity::Info;
+    UString message;
 
     // Notify subclasses (if any) of thread start.
     asyncThreadStarted();
 
-    while (_log_queue.dequeue(msg) && !msg->terminate) {
+    for (;;) {
+        _log_queue.dequeue(terminate, severity, message);
+        if (terminate) {
+            break;
+        }
 
-        asyncThreadLog(msg->severity, msg->message);
+        asyncThreadLog(severity, message);
 
         // Abort application on fatal error
-        if (msg->severity == Severity::Fatal) {
+        if (severity == Severity::Fatal) {
             std::exit(EXIT_FAILURE);
         }
+
+        // Report messages which were dropped on queue overflow.
+        const size_t dropped = _log_queue.fetchDroppedCount();
+        if (dropped != 0) {
+            asyncThreadLog(Severity::Info, UString::Format(u"%'d messages dropped on log queue overflow", {dropped}));
+        }
     }
 
     if (_max_severity >= Severity::Debug) {
@@ -14,7 +14,7 @@
 #pragma once
 #include "tsReport.h"
 #include "tsAsyncReportArgs.h"
-#include "tsMessageQueue.h"
+#include "tsAsyncLogQueue.h"
 #include "tsThread.h"
 
 namespace ts {
@@ -112,22 +112,10 @@ namespace ts {
         // This hook is invoked in the context of the logging thread.
         virtual void main() override;
 
-        // The application threads send that type of message to the logging thread
-        struct LogMessage
-        {
-            LogMessage(bool t, int s, const UString& m) : terminate(t), severity(s), message(m) {}
-
-            bool    terminate = false;  // tell logging thread to terminate
-            int     severity = Severity::Info;
-            UString message {};
-        };
-        typedef SafePtr<LogMessage, ts::null_mutex> LogMessagePtr;
-        typedef MessageQueue<LogMessage, ts::null_mutex> LogMessageQueue;
-
         // Private members:
-        LogMessageQueue _log_queue {};
-        volatile bool   _time_stamp = false;
-        volatile bool   _synchronous = false;
-        volatile bool   _terminated = false;
+        AsyncLogQueue _log_queue;
+        volatile bool _time_stamp = false;
+        volatile bool _synchronous = false;
+        volatile bool _terminated = false;
     };
 }
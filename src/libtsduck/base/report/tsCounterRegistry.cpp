@@ -0,0 +1,86 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsCounterRegistry.h"
+#include "tsFatal.h"
+
+TS_DEFINE_SINGLETON(ts::CounterRegistry);
+
+
+//----------------------------------------------------------------------------
+// Constructors and destructors.
+//----------------------------------------------------------------------------
+
+ts::CounterRegistry::CounterRegistry()
+{
+}
+
+ts::CounterRegistry::~CounterRegistry()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (const auto& it : _counters) {
+        delete it.second;
+    }
+    _counters.clear();
+}
+
+
+//----------------------------------------------------------------------------
+// Index of the shard to update from the current thread.
+//----------------------------------------------------------------------------
+
+size_t ts::CounterRegistry::Counter::shardIndex()
+{
+    // Evaluated once per thread, wait-free afterwards.
+    static thread_local const size_t index = std::hash<std::thread::id>()(std::this_thread::get_id()) % SHARD_COUNT;
+    return index;
+}
+
+
+//----------------------------------------------------------------------------
+// Get the current value of a counter, aggregated over all shards.
+//----------------------------------------------------------------------------
+
+uint64_t ts::CounterRegistry::Counter::value() const
+{
+    uint64_t total = 0;
+    for (const auto& shard : _shards) {
+        total += shard.value.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+
+//----------------------------------------------------------------------------
+// Get a counter by name, create it if it does not exist yet.
+//----------------------------------------------------------------------------
+
+ts::CounterRegistry::Counter& ts::CounterRegistry::getCounter(const UString& name)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    Counter*& counter(_counters[name]);
+    if (counter == nullptr) {
+        counter = new Counter(name);
+        CheckNonNull(counter);
+    }
+    return *counter;
+}
+
+
+//----------------------------------------------------------------------------
+// Get a snapshot of all counters.
+//----------------------------------------------------------------------------
+
+void ts::CounterRegistry::getAllCounters(std::map<UString, uint64_t>& values) const
+{
+    values.clear();
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (const auto& it : _counters) {
+        values[it.first] = it.second->value();
+    }
+}
@@ -0,0 +1,109 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  A registry of named performance counters.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsUString.h"
+#include "tsSingleton.h"
+
+namespace ts {
+    //!
+    //! A process-wide registry of named performance counters.
+    //! @ingroup log
+    //!
+    //! Counters are registered by name and never deallocated. Updating a
+    //! counter is wait-free: each counter is sharded over several atomic
+    //! values, on distinct cache lines, and a thread always updates the
+    //! same shard, selected from its thread id. The counter value is
+    //! aggregated over the shards when it is read, typically when some
+    //! monitoring component scrapes the registry. Reading is cheap but
+    //! not atomic with respect to concurrent updates; values which are
+    //! read while being updated may be slightly out of date, which is
+    //! fine for monitoring.
+    //!
+    //! This class is a singleton. Use static Instance() method to access the single instance.
+    //!
+    class TSDUCKDLL CounterRegistry
+    {
+        TS_DECLARE_SINGLETON(CounterRegistry);
+    public:
+        //!
+        //! Number of shards per counter.
+        //! A power of two, large enough to make update collisions between threads unlikely.
+        //!
+        static constexpr size_t SHARD_COUNT = 16;
+
+        //!
+        //! A named monotonic counter.
+        //! Instances are created by the registry only and remain valid until the end of the process.
+        //!
+        class TSDUCKDLL Counter
+        {
+            TS_NOBUILD_NOCOPY(Counter);
+        public:
+            //!
+            //! Add a value to the counter. This operation is wait-free.
+            //! @param [in] count Value to add.
+            //!
+            void add(uint64_t count = 1) { _shards[shardIndex()].value.fetch_add(count, std::memory_order_relaxed); }
+
+            //!
+            //! Get the current value of the counter, aggregated over all shards.
+            //! @return The current counter value.
+            //!
+            uint64_t value() const;
+
+            //!
+            //! Get the name of the counter.
+            //! @return A constant reference to the counter name.
+            //!
+            const UString& name() const { return _name; }
+
+        private:
+            friend class CounterRegistry;
+            Counter(const UString& name) : _name(name) {}
+
+            // Each shard is alone on its cache line to avoid false sharing between threads.
+            struct Shard {
+                alignas(64) std::atomic<uint64_t> value {0};
+            };
+
+            // Index of the shard to update from the current thread.
+            static size_t shardIndex();
+
+            const UString _name;
+            std::array<Shard, SHARD_COUNT> _shards {};
+        };
+
+        //!
+        //! Destructor.
+        //!
+        ~CounterRegistry();
+
+        //!
+        //! Get a counter by name, create it if it does not exist yet.
+        //! @param [in] name Name of the counter.
+        //! @return A reference to the counter. The reference remains valid until the end of the process.
+        //!
+        Counter& getCounter(const UString& name);
+
+        //!
+        //! Get a snapshot of all counters.
+        //! @param [out] values All counter values, indexed by counter name.
+        //!
+        void getAllCounters(std::map<UString, uint64_t>& values) const;
+
+    private:
+        mutable std::mutex _mutex {};             // Protect the map, not the counter updates.
+        std::map<UString, Counter*> _counters {}; // Registered counters, by name.
+    };
+}
@@ -14,11 +14,11 @@
 #pragma once
 #include "tsUChar.h"
 #include "tsArgMix.h"
+#include "tsUString.h"
 
 namespace ts {
 
     class Enumeration;
-    class UString;
 
     //!
     //! Message severity.
@@ -134,6 +134,25 @@ namespace ts {
         //!
         virtual void log(int severity, const UString& fmt, std::initializer_list<ArgMixIn> args);
 
+        //!
+        //! Report a message with an explicit severity and individual arguments.
+        //! Contrary to the overloads using an std::initializer_list, the arguments
+        //! are boxed into ArgMix only when the message passes the severity filter.
+        //! Use this form for hot-path diagnostics which are usually discarded.
+        //! @param [in] severity Message severity.
+        //! @param [in] fmt Format string with embedded '\%' sequences.
+        //! @param [in] arg1 First argument to substitute in the format string.
+        //! @param [in] args Additional arguments to substitute in the format string.
+        //! @see UString::format()
+        //!
+        template <class T, class... Args>
+        void log(int severity, const UChar* fmt, const T& arg1, const Args&... args)
+        {
+            if (severity <= maxSeverity()) {
+                log(severity, UString::Format(fmt, {ArgMixIn(arg1), ArgMixIn(args)...}));
+            }
+        }
+
         //!
         //! Report a fatal error message.
         //! @param [in] msg Message text.
@@ -266,6 +285,17 @@ namespace ts {
         //!
         void verbose(const UString& fmt, std::initializer_list<ArgMixIn> args) { log(Severity::Verbose, fmt, args); }
 
+        //!
+        //! Report a verbose message with individual arguments.
+        //! The arguments are boxed into ArgMix only when verbose mode is active.
+        //! @param [in] fmt Format string with embedded '\%' sequences.
+        //! @param [in] arg1 First argument to substitute in the format string.
+        //! @param [in] args Additional arguments to substitute in the format string.
+        //! @see UString::format()
+        //!
+        template <class T, class... Args>
+        void verbose(const UChar* fmt, const T& arg1, const Args&... args) { log(Severity::Verbose, fmt, arg1, args...); }
+
         //!
         //! Report a debug message.
         //! @param [in] msg Message text.
@@ -288,6 +318,17 @@ namespace ts {
         //!
         void debug(const UString& fmt, std::initializer_list<ArgMixIn> args) { log(Severity::Debug, fmt, args); }
 
+        //!
+        //! Report a debug message with individual arguments.
+        //! The arguments are boxed into ArgMix only when debug mode is active.
+        //! @param [in] fmt Format string with embedded '\%' sequences.
+        //! @param [in] arg1 First argument to substitute in the format string.
+        //! @param [in] args Additional arguments to substitute in the format string.
+        //! @see UString::format()
+        //!
+        template <class T, class... Args>
+        void debug(const UChar* fmt, const T& arg1, const Args&... args) { log(Severity::Debug, fmt, arg1, args...); }
+
         //!
         //! Check if errors (or worse) were reported through this object.
         //! @return True if errors (or worse) were reported through this object.
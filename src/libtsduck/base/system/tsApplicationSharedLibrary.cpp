@@ -11,6 +11,82 @@
 #include "tsCerrReport.h"
 #include "tsFileUtils.h"
 #include "tsSysUtils.h"
+#include "tsEnvironment.h"
+#include "tsErrCodeReport.h"
+
+
+//----------------------------------------------------------------------------
+// Manifest cache of plugin directory scans.
+//----------------------------------------------------------------------------
+
+namespace {
+    // Scanning all plugin directories can be slow, typically on network-mounted
+    // file systems. The result of a scan is cached in a small manifest file in
+    // the user's configuration area, keyed by the modification times of the
+    // scanned directories, and reused as long as no directory was modified.
+
+    // Get the path of the manifest cache for a file name prefix ("tsplugin_",
+    // "tslibext_"). Empty when the cache is disabled.
+    ts::UString ManifestCacheFile(const ts::UString& prefix)
+    {
+        if (!ts::GetEnvironment(u"TSDUCK_NO_PLUGINS_CACHE").empty()) {
+            return ts::UString();
+        }
+        return ts::UserConfigurationFileName(u"." + prefix + u"manifest", prefix + u"manifest");
+    }
+
+    // Modification time of a directory, in milliseconds, zero if non-existent.
+    ts::UString DirLine(const ts::UString& dir)
+    {
+        return ts::UString::Format(u"dir %d %s", {ts::GetFileModificationTimeUTC(dir) - ts::Time::Epoch, dir});
+    }
+
+    // Load the manifest cache. Return false when absent or stale.
+    bool LoadManifest(const ts::UString& cacheFile, const ts::UStringList& dirs, ts::UStringVector& files)
+    {
+        ts::UStringList lines;
+        if (!ts::UString::Load(lines, cacheFile)) {
+            return false;
+        }
+        auto it = lines.begin();
+        if (it == lines.end() || *it != u"# tsduck manifest 1") {
+            return false;
+        }
+        // The list of directories and their modification times must be unchanged.
+        for (const auto& dir : dirs) {
+            if (++it == lines.end() || *it != DirLine(dir)) {
+                return false;
+            }
+        }
+        // The rest of the manifest is the result of the scan.
+        while (++it != lines.end()) {
+            if (!it->startWith(u"file ")) {
+                return false;
+            }
+            files.push_back(it->substr(5));
+        }
+        return true;
+    }
+
+    // Regenerate the manifest cache after a scan.
+    void SaveManifest(const ts::UString& cacheFile, const ts::UStringList& dirs, const ts::UStringVector& files)
+    {
+        ts::UStringList lines;
+        lines.push_back(u"# tsduck manifest 1");
+        for (const auto& dir : dirs) {
+            lines.push_back(DirLine(dir));
+        }
+        for (const auto& file : files) {
+            lines.push_back(u"file " + file);
+        }
+        // Atomically replace the manifest, other processes may read it concurrently.
+        // Errors are not reported: the cache directory may not be writable.
+        const ts::UString tmpFile(ts::UString::Format(u"%s.tmp-%d", {cacheFile, ts::CurrentProcessId()}));
+        if (ts::UString::Save(lines, tmpFile)) {
+            fs::rename(tmpFile, cacheFile, &ts::ErrCodeReport());
+        }
+    }
+}
 
 
 //----------------------------------------------------------------------------
@@ -143,6 +219,13 @@ void ts::ApplicationSharedLibrary::GetPluginList(UStringVector& files, const USt
     UStringList path_dirs;
     GetSearchPath(path_dirs, library_path);
 
+    // Use the cached result of a previous scan when no directory was modified.
+    const UString cacheFile(ManifestCacheFile(prefix));
+    if (!cacheFile.empty() && LoadManifest(cacheFile, path_dirs, files)) {
+        CERR.log(2, u"Using cached manifest for plugins %s*%s, %d files", {prefix, SharedLibrarySuffix, files.size()});
+        return;
+    }
+
     // Assume that distinct shared libraries with the same base name contain the same plugin,
     // or two distinct versions of the same plugin. Since they are likely to contain the same
     // symbols, do nat load them both. Keep a set of loaded base names.
@@ -173,6 +256,11 @@ void ts::ApplicationSharedLibrary::GetPluginList(UStringVector& files, const USt
     // Sort the list of plugins.
     std::sort(files.begin(), files.end());
 
+    // Regenerate the manifest cache for the next process.
+    if (!cacheFile.empty()) {
+        SaveManifest(cacheFile, path_dirs, files);
+    }
+
     // Debug section when TS_CERR_DEBUG_LEVEL environment variable is 2 or higher.
     if (CERR.maxSeverity() >= 2) {
         CERR.log(2, u"Results for plugins %s*%s:", {prefix, SharedLibrarySuffix});
@@ -78,6 +78,9 @@ namespace ts {
 
         //!
         //! Get a list of plugins.
+        //! The result of the directory scan is cached in the user's configuration
+        //! area and reused as long as no directory in the search path is modified.
+        //! Define the environment variable TSDUCK_NO_PLUGINS_CACHE to disable it.
         //! @param [out] files List of shared library files.
         //! @param [in] prefix Prefix for plugin names.
         //! @param [in] library_path Name of an environment variable, an optional list of directories to search, similar to @c LD_LIBRARY_PATH.
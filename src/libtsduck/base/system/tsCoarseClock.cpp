@@ -0,0 +1,99 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsCoarseClock.h"
+#include "tsMemory.h"
+
+// Select the coarse clock sources, by decreasing order of preference.
+// On Windows, GetSystemTimeAsFileTime() already returns a cached value
+// which the kernel updates on each timer tick, there is nothing cheaper.
+#if !defined(TS_WINDOWS)
+    #if defined(CLOCK_MONOTONIC_COARSE)
+        // Linux: updated on each timer tick, read from the vDSO without system call.
+        #define TS_COARSE_MONOTONIC CLOCK_MONOTONIC_COARSE
+    #elif defined(CLOCK_MONOTONIC_FAST)
+        // FreeBSD and DragonFlyBSD equivalent.
+        #define TS_COARSE_MONOTONIC CLOCK_MONOTONIC_FAST
+    #else
+        // No coarse source, fall back to the regular monotonic clock.
+        #define TS_COARSE_MONOTONIC CLOCK_MONOTONIC
+    #endif
+#endif
+
+
+//----------------------------------------------------------------------------
+// Get the precision of the coarse clocks.
+//----------------------------------------------------------------------------
+
+ts::NanoSecond ts::CoarseClock::Precision()
+{
+#if defined(TS_WINDOWS)
+
+    // The system time is updated on each timer tick, typically 15.6 ms.
+    return 16 * NanoSecPerMilliSec;
+
+#else
+
+    // The resolution of a clock never changes, get it once.
+    static const NanoSecond resolution = []() {
+        ::timespec res;
+        TS_ZERO(res);
+        ::clock_getres(TS_COARSE_MONOTONIC, &res);
+        return NanoSecond(res.tv_sec) * NanoSecPerSec + NanoSecond(res.tv_nsec);
+    }();
+    return resolution;
+
+#endif
+}
+
+
+//----------------------------------------------------------------------------
+// Get the current value of the coarse monotonic clock.
+//----------------------------------------------------------------------------
+
+ts::NanoSecond ts::CoarseClock::MonotonicNanoSeconds()
+{
+#if defined(TS_WINDOWS)
+
+    // A FILETIME structure is binary-compatible with a 64-bit integer in units of 100 ns.
+    union {
+        ::FILETIME ft;
+        int64_t i;
+    } result;
+    ::GetSystemTimeAsFileTime(&result.ft);
+    return result.i * 100;
+
+#else
+
+    return Time::UnixClockNanoSeconds(TS_COARSE_MONOTONIC);
+
+#endif
+}
+
+
+//----------------------------------------------------------------------------
+// Get the current UTC time from the coarse clock.
+//----------------------------------------------------------------------------
+
+ts::Time ts::CoarseClock::CurrentUTC()
+{
+#if defined(CLOCK_REALTIME_COARSE)
+
+    ::timespec now;
+    TS_ZERO(now);
+    ::clock_gettime(CLOCK_REALTIME_COARSE, &now);
+    return Time::UnixTimeToUTC(uint64_t(now.tv_sec)) + MilliSecond(now.tv_nsec / NanoSecPerMilliSec);
+
+#else
+
+    // The Windows system time is already coarse and cheap to read.
+    // Other systems have no coarse real-time clock, use the regular one.
+    return Time::CurrentUTC();
+
+#endif
+}
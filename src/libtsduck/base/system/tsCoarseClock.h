@@ -0,0 +1,62 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Coarse but cheap process-wide clock service.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsTime.h"
+
+namespace ts {
+    //!
+    //! Coarse but cheap process-wide clock service.
+    //! @ingroup system
+    //!
+    //! This class is a collection of static methods returning timestamps from
+    //! the cheapest clock source of the operating system, typically a cached
+    //! value which the kernel updates on each timer tick and which can be read
+    //! without system call. Reading the regular clocks (Time::CurrentUTC(),
+    //! Monotonic) can be a significant cost when done once per packet or per
+    //! datagram at high bitrates.
+    //!
+    //! Precision contract: the returned timestamps are never more precise than
+    //! the kernel timer tick, typically between 1 and 16 milliseconds depending
+    //! on the operating system. The exact value is given by Precision().
+    //! Successive reads of the same clock are guaranteed to be non-decreasing.
+    //! Use these methods only when such a granularity is acceptable.
+    //!
+    class TSDUCKDLL CoarseClock
+    {
+        TS_NOBUILD_NOCOPY(CoarseClock);
+    public:
+        //!
+        //! Get the precision of the coarse clocks.
+        //! @return The granularity of the coarse timestamps, in nanoseconds.
+        //! Two reads which are closer apart than this duration may return the
+        //! same value.
+        //!
+        static NanoSecond Precision();
+
+        //!
+        //! Get the current value of the coarse monotonic clock.
+        //! The origin of this clock is unspecified, only differences between
+        //! two reads are meaningful. The values are not comparable with the
+        //! Monotonic class.
+        //! @return Current value of the coarse monotonic clock in nanoseconds.
+        //!
+        static NanoSecond MonotonicNanoSeconds();
+
+        //!
+        //! Get the current UTC time from the coarse clock.
+        //! @return Current UTC time, with the granularity given by Precision().
+        //!
+        static Time CurrentUTC();
+    };
+}
@@ -278,6 +278,23 @@ bool ts::ForkPipe::open(const UString& command, WaitMode wait_mode, size_t buffe
         return false;
     }
 
+#if defined(TS_LINUX) && defined(F_SETPIPE_SZ)
+    // Enlarge the kernel pipe buffer when a size is requested. A larger buffer means
+    // fewer system calls and process switches when a sustained stream of data goes
+    // through the pipe. This is an optimization only: the kernel rounds the size as
+    // it sees fit and the operation may fail for unprivileged users above the limit
+    // in /proc/sys/fs/pipe-max-size. Errors are ignored, keeping the default size.
+    if (_use_pipe && buffer_size > 0) {
+        const int actual_size = ::fcntl(filedes[PIPE_WRITEFD], F_SETPIPE_SZ, int(buffer_size));
+        if (actual_size < 0) {
+            report.debug(u"cannot set pipe buffer size to %'d bytes: %s", {buffer_size, SysErrorCodeMessage()});
+        }
+        else {
+            report.debug(u"pipe buffer size set to %'d bytes", {actual_size});
+        }
+    }
+#endif
+
     // Create the forked process
     if (_wait_mode == EXIT_PROCESS) {
         // Don't fork, the parent process will directly call exec().
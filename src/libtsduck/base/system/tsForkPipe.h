@@ -80,7 +80,7 @@ namespace ts {
         //! Create the process, open the optional pipe.
         //! @param [in] command The command to execute.
         //! @param [in] wait_mode How to wait for process termination in close().
-        //! @param [in] buffer_size The pipe buffer size in bytes. Used on Windows only. Zero means default.
+        //! @param [in] buffer_size The pipe buffer size in bytes. Used on Windows and Linux only. Zero means default.
         //! @param [in,out] report Where to report errors.
         //! @param [in] out_mode How to handle stdout and stderr.
         //! @param [in] in_mode How to handle stdin. Use the pipe by default.
@@ -0,0 +1,54 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Static tracing probes for low-overhead instrumentation of hot paths.
+//!
+//!  The probes are USDT (user statically-defined tracing) probes which can
+//!  be observed on live systems with perf or bpftrace, without any code
+//!  change or instrumented rebuild on the observer side. They are compiled
+//!  out by default and enabled with "make probes" (macro TS_ENABLE_PROBES),
+//!  on Linux only. All probes use the provider name "tsduck".
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsPlatform.h"
+
+#if defined(DOXYGEN)
+    //!
+    //! Emit a static tracing probe (USDT) without argument.
+    //! Compiled out unless the library is built with TS_ENABLE_PROBES on Linux.
+    //! @param name Probe name in the "tsduck" provider.
+    //!
+    #define TS_PROBE(name)
+    //!
+    //! Emit a static tracing probe (USDT) with one argument.
+    //! Compiled out unless the library is built with TS_ENABLE_PROBES on Linux.
+    //! @param name Probe name in the "tsduck" provider.
+    //! @param a1 First probe argument, an integral value.
+    //!
+    #define TS_PROBE1(name, a1)
+    //!
+    //! Emit a static tracing probe (USDT) with two arguments.
+    //! Compiled out unless the library is built with TS_ENABLE_PROBES on Linux.
+    //! @param name Probe name in the "tsduck" provider.
+    //! @param a1 First probe argument, an integral value.
+    //! @param a2 Second probe argument, an integral value.
+    //!
+    #define TS_PROBE2(name, a1, a2)
+#elif defined(TS_ENABLE_PROBES) && defined(TS_LINUX)
+    #include <sys/sdt.h>
+    #define TS_PROBE(name)          DTRACE_PROBE(tsduck, name)
+    #define TS_PROBE1(name, a1)     DTRACE_PROBE1(tsduck, name, a1)
+    #define TS_PROBE2(name, a1, a2) DTRACE_PROBE2(tsduck, name, a1, a2)
+#else
+    #define TS_PROBE(name)          do {} while (false)
+    #define TS_PROBE1(name, a1)     do {} while (false)
+    #define TS_PROBE2(name, a1, a2) do {} while (false)
+#endif
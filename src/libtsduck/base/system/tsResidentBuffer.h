@@ -73,6 +73,13 @@ namespace ts {
         size_t count() const { return _elem_count; }
 
     private:
+#if defined(TS_LINUX) || defined(DOXYGEN)
+        // Huge page size for transparent huge pages (2 MB on x86-64 and most arm64 configurations).
+        static constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+        // Minimum buffer size to use huge page alignment (keep padding overhead reasonable).
+        static constexpr size_t HUGE_PAGE_THRESHOLD = 4 * HUGE_PAGE_SIZE;
+#endif
+
         char*        _allocated_base = nullptr;  // First allocated address
         char*        _locked_base = nullptr;     // First locked address (mlock, page boundary)
         T*           _base = nullptr;            // Same as _locked_base with type T*
@@ -97,30 +104,49 @@ ts::ResidentBuffer<T>::ResidentBuffer(size_t elem_count) :
     const size_t requested_size = elem_count * sizeof(T);
     const size_t page_size = SysInfo::Instance().memoryPageSize();
 
-    // Allocate enough space to include memory pages around the requested size
-    _allocated_size = requested_size + 2 * page_size;
+    // Alignment of the locked region. This is the memory page size by default.
+    // On Linux, large buffers are aligned on a huge page boundary so that the
+    // kernel can back them with transparent huge pages, reducing TLB pressure
+    // when many threads walk a large packet buffer.
+    size_t alignment = page_size;
+#if defined(TS_LINUX)
+    if (requested_size >= HUGE_PAGE_THRESHOLD) {
+        alignment = std::max(alignment, HUGE_PAGE_SIZE);
+    }
+#endif
+
+    // Allocate enough space to include alignment padding around the requested size
+    _allocated_size = requested_size + 2 * alignment;
     _allocated_base = new char[_allocated_size];
 
-    // Locked space starts at next page boundary after allocated base:
-    // Its size is the next multiple of page size after requested_size:
+    // Locked space starts at next alignment boundary after allocated base:
+    // Its size is the next multiple of alignment after requested_size:
     // Be sure to use size_t (unsigned) instead of ptrdiff_t (signed)
     // to perform arithmetics on pointers because we use modulo operations.
     assert(sizeof(size_t) == sizeof(char_ptr));
-    _locked_base = char_ptr(round_up(size_t(_allocated_base), page_size));
-    _locked_size = round_up(requested_size, page_size);
+    _locked_base = char_ptr(round_up(size_t(_allocated_base), alignment));
+    _locked_size = round_up(requested_size, alignment);
     _base = new (_locked_base) T[elem_count];
 
     // Integrity checks
     assert(_allocated_base <= _locked_base);
-    assert(_locked_base < _allocated_base + page_size);
+    assert(_locked_base < _allocated_base + alignment);
     assert(_locked_base + _locked_size <= _allocated_base + _allocated_size);
     assert(requested_size <= _locked_size);
     assert(_locked_size <= _allocated_size);
-    assert(size_t(_locked_base) % page_size == 0);
+    assert(size_t(_locked_base) % alignment == 0);
     assert(size_t(_locked_base) == size_t(_base));
     assert(char_ptr(_base + elem_count) <= _locked_base + _locked_size);
     assert(_locked_size % page_size == 0);
 
+#if defined(TS_LINUX) && defined(MADV_HUGEPAGE)
+    // Advise the kernel to back the buffer with transparent huge pages.
+    // This is a hint only, a failure is harmless and ignored.
+    if (alignment >= HUGE_PAGE_SIZE) {
+        ::madvise(_locked_base, _locked_size, MADV_HUGEPAGE);
+    }
+#endif
+
 #if defined(TS_WINDOWS)
 
     // Windows implementation.
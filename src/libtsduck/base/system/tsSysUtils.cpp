@@ -308,6 +308,33 @@ ts::MilliSecond ts::GetProcessCpuTime()
 }
 
 
+//----------------------------------------------------------------------------
+// Get the CPU time of the current thread in milliseconds.
+//----------------------------------------------------------------------------
+
+ts::MilliSecond ts::GetThreadCpuTime()
+{
+#if defined(TS_WINDOWS)
+
+    ::FILETIME creation_time, exit_time, kernel_time, user_time;
+    if (::GetThreadTimes(::GetCurrentThread(), &creation_time, &exit_time, &kernel_time, &user_time) == 0) {
+        throw ts::Exception(u"GetThreadTimes error", ::GetLastError());
+    }
+    return ts::Time::Win32FileTimeToMilliSecond(kernel_time) + ts::Time::Win32FileTimeToMilliSecond(user_time);
+
+#else
+
+    ::timespec tp;
+    TS_ZERO(tp);
+    if (::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &tp) < 0) {
+        throw ts::Exception(u"clock_gettime error", errno);
+    }
+    return MilliSecond(tp.tv_sec) * MilliSecPerSec + MilliSecond(tp.tv_nsec) / NanoSecPerMilliSec;
+
+#endif
+}
+
+
 //----------------------------------------------------------------------------
 // Get the virtual memory size of the process in bytes.
 //----------------------------------------------------------------------------
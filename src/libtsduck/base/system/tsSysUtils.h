@@ -173,6 +173,13 @@ namespace ts {
     //!
     TSDUCKDLL MilliSecond GetProcessCpuTime();
 
+    //!
+    //! Get the CPU time of the current thread in milliseconds.
+    //! @return The CPU time of the current thread in milliseconds.
+    //! @throw ts::Exception on error.
+    //!
+    TSDUCKDLL MilliSecond GetThreadCpuTime();
+
     //!
     //! Get the virtual memory size of the process in bytes.
     //! @return The virtual memory size of the process in bytes.
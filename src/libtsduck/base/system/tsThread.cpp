@@ -15,6 +15,7 @@
 #if defined(TS_LINUX)
     #include "tsBeforeStandardHeaders.h"
     #include <sys/prctl.h>
+    #include <sched.h>
     #include "tsAfterStandardHeaders.h"
 #endif
 
@@ -184,6 +185,11 @@ bool ts::Thread::start()
         return false;
     }
 
+    // Set the thread affinity. This is a hint, failures are ignored.
+    if (_attributes._cpu >= 0 && _attributes._cpu < int(8 * sizeof(::DWORD_PTR))) {
+        ::SetThreadAffinityMask(_handle, ::DWORD_PTR(1) << _attributes._cpu);
+    }
+
     // Set the thread priority
     ::BOOL status = ::SetThreadPriority(_handle, ThreadAttributes::Win32Priority(_attributes._priority));
     if (status == 0) {
@@ -241,6 +247,17 @@ bool ts::Thread::start()
     }
 #endif
 
+#if defined(TS_LINUX) && !defined(TS_ANDROID)
+    // Set the CPU affinity. Like memory locking, a failure (e.g. invalid CPU
+    // number) is not a fatal error, the thread simply runs without affinity.
+    if (_attributes._cpu >= 0 && _attributes._cpu < CPU_SETSIZE) {
+        ::cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(_attributes._cpu, &cpus);
+        ::pthread_attr_setaffinity_np(&attr, sizeof(cpus), &cpus);
+    }
+#endif
+
     // Create the thread
     if (::pthread_create(&_pthread, &attr, Thread::ThreadProc, this) != 0) {
         ::pthread_attr_destroy(&attr);
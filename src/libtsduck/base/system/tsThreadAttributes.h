@@ -187,6 +187,41 @@ namespace ts {
             return _priority;
         }
 
+        //!
+        //! Set the CPU affinity for the thread.
+        //!
+        //! When a CPU number is set, the thread is restricted to run on this CPU only.
+        //! This is useful on NUMA systems to prevent a thread from migrating between
+        //! nodes, away from the memory it works on.
+        //!
+        //! CPU pinning is supported on Linux and Windows only. On other operating
+        //! systems, this attribute is ignored. Similarly, an invalid CPU number is
+        //! ignored and the thread runs without affinity. Like memory locking, failing
+        //! to set the affinity is not a real error which prevents the application
+        //! from working, at worst there are performance implications.
+        //!
+        //! @param [in] cpu CPU number on which the thread must run, -1 to let the
+        //! operating system schedule the thread on any CPU (the default).
+        //! @return A reference to this object.
+        //!
+        ThreadAttributes& setCPUAffinity(int cpu)
+        {
+            _cpu = cpu;
+            return *this;
+        }
+
+        //!
+        //! Get the CPU affinity for the thread.
+        //!
+        //! @return The CPU number on which the thread must run,
+        //! -1 when the thread can run on any CPU.
+        //! @see setCPUAffinity()
+        //!
+        int getCPUAffinity() const
+        {
+            return _cpu;
+        }
+
         //!
         //! Get the minimum priority for a thread in this context of the operating system.
         //! @return The minimum priority for a thread.
@@ -244,6 +279,7 @@ namespace ts {
         size_t  _stackSize = 0;
         bool    _deleteWhenTerminated = false;
         int     _priority = 0;
+        int     _cpu = -1;  // -1 means no affinity, run on any CPU.
         UString _name {};
 
         //
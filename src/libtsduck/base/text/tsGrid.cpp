@@ -63,7 +63,7 @@ void ts::Grid::setLineWidth(size_t lineWidth, size_t marginWidth)
 void ts::Grid::openTable()
 {
     if (!_tableOpen) {
-        _out << std::endl << _tableTop << std::endl;
+        _out << '\n' << _tableTop << '\n';
         _lineCount += 2;
         _tableOpen = true;
     }
@@ -72,17 +72,18 @@ void ts::Grid::openTable()
 void ts::Grid::closeTable()
 {
     if (_tableOpen) {
-        _out << _tableBottom << std::endl << std::endl;
+        _out << _tableBottom << '\n' << '\n';
         _lineCount += 2;
         _tableOpen = false;
+        // Flush once per table instead of once per line.
+        _out.flush();
     }
-
 }
 
 void ts::Grid::section()
 {
     if (_tableOpen) {
-        _out << _sectionLine << std::endl;
+        _out << _sectionLine << '\n';
         _lineCount++;
     }
 }
@@ -90,20 +91,66 @@ void ts::Grid::section()
 void ts::Grid::subSection()
 {
     if (_tableOpen) {
-        _out << _subSectionLine << std::endl;
+        _out << _subSectionLine << '\n';
         _lineCount++;
     }
 }
 
 
+//----------------------------------------------------------------------------
+// Line buffer management.
+//----------------------------------------------------------------------------
+
+void ts::Grid::flushLine()
+{
+    _lineBuffer.append(_rightMargin);
+    _lineBuffer.append(1, u'\n');
+    _out << _lineBuffer;
+    _lineCount++;
+}
+
+void ts::Grid::appendJustifiedLeft(const UString& text, size_t width, UChar pad, size_t spacesBeforePad)
+{
+    const size_t wid = text.width();
+    if (wid > width) {
+        _lineBuffer.append(text.toTruncatedWidth(width, LEFT_TO_RIGHT));
+    }
+    else {
+        _lineBuffer.append(text);
+        if (wid < width) {
+            spacesBeforePad = std::min(spacesBeforePad, width - wid);
+            _lineBuffer.append(spacesBeforePad, SPACE);
+            _lineBuffer.append(width - wid - spacesBeforePad, pad);
+        }
+    }
+}
+
+void ts::Grid::appendJustifiedRight(const UString& text, size_t width, UChar pad, size_t spacesAfterPad)
+{
+    const size_t wid = text.width();
+    if (wid > width) {
+        _lineBuffer.append(text.toTruncatedWidth(width, RIGHT_TO_LEFT));
+    }
+    else {
+        if (wid < width) {
+            spacesAfterPad = std::min(spacesAfterPad, width - wid);
+            _lineBuffer.append(width - wid - spacesAfterPad, pad);
+            _lineBuffer.append(spacesAfterPad, SPACE);
+        }
+        _lineBuffer.append(text);
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Write one line.
 //----------------------------------------------------------------------------
 
 void ts::Grid::putLine(const UString& line)
 {
-    _out << _leftMargin << line.toJustifiedLeft(_contentWidth, SPACE, true) << _rightMargin << std::endl;
-    _lineCount++;
+    _lineBuffer.assign(_leftMargin);
+    appendJustifiedLeft(line, _contentWidth, SPACE);
+    flushLine();
 }
 
 void ts::Grid::putMultiLine(const UString& text)
@@ -126,32 +173,31 @@ void ts::Grid::putLine(const UString& left, const UString& right, bool oneLine)
 
     if (leftWidth + _marginWidth + rightWidth <= _contentWidth) {
         // Display on one line, no truncation.
-        _out << _leftMargin
-             << left
-             << std::string(_contentWidth - leftWidth - rightWidth, ' ')
-             << right
-             << _rightMargin
-             << std::endl;
-        _lineCount++;
+        _lineBuffer.assign(_leftMargin);
+        _lineBuffer.append(left);
+        _lineBuffer.append(_contentWidth - leftWidth - rightWidth, SPACE);
+        _lineBuffer.append(right);
+        flushLine();
     }
     else if (oneLine) {
         // Truncate and pack on one line.
         const size_t excess = leftWidth + _marginWidth + rightWidth - _contentWidth;
         const size_t leftExcess = excess / 2;
         const size_t rightExcess = excess - leftExcess;
-        _out << _leftMargin
-             << left.toJustifiedLeft(leftWidth - leftExcess, SPACE, true)
-             << std::string(_marginWidth, ' ')
-             << right.toJustifiedRight(rightWidth - rightExcess, SPACE, true)
-             << _rightMargin
-             << std::endl;
-        _lineCount++;
+        _lineBuffer.assign(_leftMargin);
+        appendJustifiedLeft(left, leftWidth - leftExcess, SPACE);
+        _lineBuffer.append(_marginWidth, SPACE);
+        appendJustifiedRight(right, rightWidth - rightExcess, SPACE);
+        flushLine();
     }
     else {
         // Display on two lines.
-        _out << _leftMargin << left.toJustifiedLeft(_contentWidth, SPACE, true) << _rightMargin << std::endl
-             << _leftMargin << right.toJustifiedRight(_contentWidth, SPACE, true) << _rightMargin << std::endl;
-        _lineCount += 2;
+        _lineBuffer.assign(_leftMargin);
+        appendJustifiedLeft(left, _contentWidth, SPACE);
+        flushLine();
+        _lineBuffer.assign(_leftMargin);
+        appendJustifiedRight(right, _contentWidth, SPACE);
+        flushLine();
     }
 }
 
@@ -318,10 +364,7 @@ void ts::Grid::adjustLayout()
 void ts::Grid::putLayout(const std::initializer_list<ColumnText> text)
 {
     // Begin of line.
-    _out << _leftMargin;
-
-    // Inner margins.
-    const UString margin(_marginWidth, ' ');
+    _lineBuffer.assign(_leftMargin);
 
     // Iterator through text to display
     auto iText = text.begin();
@@ -333,14 +376,14 @@ void ts::Grid::putLayout(const std::initializer_list<ColumnText> text)
 
         // Left margin between columns (except for first column).
         if (currentWidth > 0) {
-            _out << margin;
+            _lineBuffer.append(_marginWidth, SPACE);
             currentWidth += _marginWidth;
         }
         currentWidth += iLayout._width;
 
         if (iLayout.isBorder()) {
             // Simply display the border character.
-            _out << iLayout._pad;
+            _lineBuffer.append(1, iLayout._pad);
         }
         else {
             // Text to display. The argument list may be shorter than the layout.
@@ -357,15 +400,15 @@ void ts::Grid::putLayout(const std::initializer_list<ColumnText> text)
 
             if (text1.empty() && (iLayout._justif != ColumnLayout::BOTH || text2.empty())) {
                 // Totally empty field, use spaces.
-                _out << std::string(iLayout._width, ' ');
+                _lineBuffer.append(iLayout._width, SPACE);
             }
             else if (iLayout._justif == ColumnLayout::LEFT) {
                 // Only one text, left-justifed.
-                _out << text1.toJustifiedLeft(iLayout._width, iLayout._pad, true, 1);
+                appendJustifiedLeft(text1, iLayout._width, iLayout._pad, 1);
             }
             else if (iLayout._justif == ColumnLayout::RIGHT) {
                 // Only one text, right-justifed.
-                _out << text1.toJustifiedRight(iLayout._width, iLayout._pad, true, 1);
+                appendJustifiedRight(text1, iLayout._width, iLayout._pad, 1);
             }
             else {
                 // Two text, a left-justified one and a right-justified one.
@@ -408,17 +451,27 @@ void ts::Grid::putLayout(const std::initializer_list<ColumnText> text)
                 }
                 // Now, we have adjusted leftWidth and rightWidth to make sure the 2 texts fit on the line.
                 assert(leftWidth + 2 + rightWidth <= iLayout._width);
-                _out << (fits ? text1 : text1.toTruncatedWidth(leftWidth, LEFT_TO_RIGHT))
-                     << (text1.empty() ? iLayout._pad : SPACE)
-                     << UString(iLayout._width - leftWidth - 2 - rightWidth, iLayout._pad)
-                     << (text2.empty() ? iLayout._pad : SPACE)
-                     << (fits ? text2 : text2.toTruncatedWidth(rightWidth, RIGHT_TO_LEFT));
+                if (fits) {
+                    _lineBuffer.append(text1);
+                }
+                else {
+                    _lineBuffer.append(text1.toTruncatedWidth(leftWidth, LEFT_TO_RIGHT));
+                }
+                _lineBuffer.append(1, text1.empty() ? iLayout._pad : SPACE);
+                _lineBuffer.append(iLayout._width - leftWidth - 2 - rightWidth, iLayout._pad);
+                _lineBuffer.append(1, text2.empty() ? iLayout._pad : SPACE);
+                if (fits) {
+                    _lineBuffer.append(text2);
+                }
+                else {
+                    _lineBuffer.append(text2.toTruncatedWidth(rightWidth, RIGHT_TO_LEFT));
+                }
             }
         }
     }
 
     // End of line.
     assert(currentWidth <= _contentWidth);
-    _out << std::string(_contentWidth - currentWidth, ' ') << _rightMargin << std::endl;
-    _lineCount++;
+    _lineBuffer.append(_contentWidth - currentWidth, SPACE);
+    flushLine();
 }
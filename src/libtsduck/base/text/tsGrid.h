@@ -267,8 +267,17 @@ namespace ts {
         UString       _rightMargin {};      // Right margin content.
         LayoutVector  _requestedLayout {};  // User-requested ColumnLayout layout.
         LayoutVector  _layout {};           // Actual column layout, after adjustment.
+        UString       _lineBuffer {};       // Reused buffer to assemble one output line.
 
         // Recompute layout based on grid width.
         void adjustLayout();
+
+        // Write the assembled line buffer on the output stream, once, without flushing.
+        void flushLine();
+
+        // Append a justified text to the line buffer, without temporary string.
+        // Same semantics as UString::justifyLeft() / justifyRight() with truncation.
+        void appendJustifiedLeft(const UString& text, size_t width, UChar pad, size_t spacesBeforePad = 0);
+        void appendJustifiedRight(const UString& text, size_t width, UChar pad, size_t spacesAfterPad = 0);
     };
 }
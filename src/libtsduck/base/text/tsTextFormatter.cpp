@@ -165,25 +165,35 @@ ts::TextFormatter& ts::TextFormatter::setMarginSize(size_t margin)
 
 bool ts::TextFormatter::writeStreamBuffer(const void* addr, size_t size)
 {
-    const char* const last = static_cast<const char*>(addr) + size;
-    for (const char* p = static_cast<const char*>(addr); p < last; ++p) {
+    const char* p = static_cast<const char*>(addr);
+    const char* const last = p + size;
+    while (p < last) {
         if (*p == '\t') {
             // Tabulations are expanded as spaces.
             // Without formatting, a tabulation is just one space.
             do {
                 *_out << ' ';
             } while (++_column % _tabSize != 0 && _formatting);
+            ++p;
         }
         else if (*p == '\r' || *p == '\n') {
             // CR and LF indifferently move back to begining of current/next line.
             *_out << *p;
             _column = 0;
             _afterSpace = false;
+            ++p;
         }
         else {
-            *_out << *p;
-            ++_column;
-            _afterSpace = _afterSpace || *p != ' ';
+            // Run of plain characters, write it in one chunk.
+            const char* run = p;
+            while (p < last && *p != '\t' && *p != '\r' && *p != '\n') {
+                ++p;
+            }
+            _out->write(run, p - run);
+            _column += size_t(p - run);
+            while (!_afterSpace && run < p) {
+                _afterSpace = *run++ != ' ';
+            }
         }
     }
     return !_out->fail();
@@ -1499,6 +1499,16 @@ INT ts::Buffer::getBits(size_t bits)
         return 0;
     }
 
+    // Fast path: extract the bit field from a 64-bit window in one load,
+    // as long as the window does not extend past the addressable buffer.
+    if (_big_endian && bits > 0 && _state.rbit + bits <= 64 && _state.rbyte + 8 <= _buffer_size) {
+        const uint64_t val64 = (GetUInt64BE(_buffer + _state.rbyte) << _state.rbit) >> (64 - bits);
+        const size_t next = _state.rbit + bits;
+        _state.rbyte += next >> 3;
+        _state.rbit = next & 7;
+        return INT(val64);
+    }
+
     INT val = 0;
 
     if (_big_endian) {
@@ -1559,6 +1569,19 @@ bool ts::Buffer::putBits(INT value, size_t bits)
         return false;
     }
 
+    // Fast path: merge the bit field into a 64-bit window in one load / store,
+    // as long as the window does not extend past the addressable buffer. The
+    // bits of the window outside the field are stored back unmodified.
+    if (_big_endian && bits > 0 && _state.wbit + bits <= 64 && _state.wbyte + 8 <= _buffer_size) {
+        const uint64_t mask = (~uint64_t(0) << (64 - bits)) >> _state.wbit;
+        const uint64_t field = (uint64_t(value) << (64 - bits)) >> _state.wbit;
+        PutUInt64BE(_buffer + _state.wbyte, (GetUInt64BE(_buffer + _state.wbyte) & ~mask) | field);
+        const size_t next = _state.wbit + bits;
+        _state.wbyte += next >> 3;
+        _state.wbit = next & 7;
+        return true;
+    }
+
     if (_big_endian) {
         // Write leading bits up to byte boundary
         while (bits > 0 && _state.wbit != 0) {
@@ -0,0 +1,72 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsByteBlockPool.h"
+#include "tsFatal.h"
+
+
+//----------------------------------------------------------------------------
+// Constructor.
+//----------------------------------------------------------------------------
+
+ts::ByteBlockPool::ByteBlockPool(size_t max_blocks) :
+    _max_blocks(max_blocks)
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Get a block from the pool.
+//----------------------------------------------------------------------------
+
+ts::ByteBlockPtr ts::ByteBlockPool::acquire()
+{
+    // Round-robin search for a block which is only owned by the pool.
+    // Starting after the last reused block avoids rescanning long-lived
+    // blocks which sit at the beginning of the pool.
+    for (size_t i = 0; i < _blocks.size(); ++i) {
+        const size_t index = (_next + i) % _blocks.size();
+        if (_blocks[index].count() == 1) {
+            _next = (index + 1) % _blocks.size();
+            return _blocks[index];
+        }
+    }
+
+    // All pooled blocks are still in use somewhere, allocate a new one.
+    ByteBlockPtr block(new ByteBlock);
+    CheckNonNull(block.pointer());
+    if (_blocks.size() < _max_blocks) {
+        _blocks.push_back(block);
+    }
+    return block;
+}
+
+
+//----------------------------------------------------------------------------
+// Change the maximum number of blocks which are kept in the pool.
+//----------------------------------------------------------------------------
+
+void ts::ByteBlockPool::setMaxBlocks(size_t max_blocks)
+{
+    _max_blocks = max_blocks;
+    if (_blocks.size() > _max_blocks) {
+        _blocks.resize(_max_blocks);
+        _next = 0;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Drop all pooled blocks.
+//----------------------------------------------------------------------------
+
+void ts::ByteBlockPool::clear()
+{
+    _blocks.clear();
+    _next = 0;
+}
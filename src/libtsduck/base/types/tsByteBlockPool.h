@@ -0,0 +1,85 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Pool of reusable ByteBlock objects.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsByteBlock.h"
+
+namespace ts {
+    //!
+    //! Pool of reusable ByteBlock objects.
+    //! @ingroup cpp
+    //!
+    //! The pool reduces the amount of memory allocations when many short-lived
+    //! ByteBlock objects are created, for instance during section assembly in
+    //! a demux. The pool hands out safe pointers to its blocks. A block can be
+    //! reused when the pool is its only remaining owner, so a block which is
+    //! still referenced somewhere, for instance by an application which keeps
+    //! a section alive, is never handed out twice. Reused blocks keep their
+    //! previous capacity, eliminating reallocations once the pool is warm.
+    //!
+    //! The pool is not thread-safe, it is designed to be owned by one object,
+    //! typically one demux instance.
+    //!
+    class TSDUCKDLL ByteBlockPool
+    {
+        TS_NOCOPY(ByteBlockPool);
+    public:
+        //!
+        //! Default maximum number of blocks in a pool.
+        //!
+        static constexpr size_t DEFAULT_MAX_BLOCKS = 512;
+
+        //!
+        //! Constructor.
+        //! @param [in] max_blocks Maximum number of blocks which are kept in the pool.
+        //! When all of them are in use, additional blocks are allocated and simply
+        //! deallocated when no longer used, as without a pool.
+        //!
+        explicit ByteBlockPool(size_t max_blocks = DEFAULT_MAX_BLOCKS);
+
+        //!
+        //! Get a block from the pool.
+        //! The returned block contains stale data from its previous use, the caller
+        //! is expected to overwrite its content. When no pooled block is available,
+        //! a new block is allocated (and added to the pool if not full).
+        //! @return A safe pointer to a block. Never null.
+        //!
+        ByteBlockPtr acquire();
+
+        //!
+        //! Change the maximum number of blocks which are kept in the pool.
+        //! Supernumerary blocks are immediately removed from the pool. Those which
+        //! are still referenced elsewhere remain valid, like with clear().
+        //! @param [in] max_blocks New maximum number of pooled blocks.
+        //!
+        void setMaxBlocks(size_t max_blocks);
+
+        //!
+        //! Drop all pooled blocks.
+        //! Blocks which are still referenced elsewhere remain valid, they are
+        //! simply no longer reusable through this pool.
+        //!
+        void clear();
+
+        //!
+        //! Get the number of blocks currently in the pool, in use or not.
+        //! @return The number of blocks currently in the pool.
+        //!
+        size_t size() const { return _blocks.size(); }
+
+    private:
+        size_t                    _max_blocks;  // Maximum number of pooled blocks.
+        size_t                    _next = 0;    // Round-robin start index for the next search.
+        std::vector<ByteBlockPtr> _blocks {};   // Pooled blocks, free or in use.
+    };
+}
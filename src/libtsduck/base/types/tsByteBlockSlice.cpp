@@ -0,0 +1,99 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsByteBlockSlice.h"
+
+
+//----------------------------------------------------------------------------
+// Constructors.
+//----------------------------------------------------------------------------
+
+ts::ByteBlockSlice::ByteBlockSlice(const ByteBlockPtr& data, size_t offset, size_t size) :
+    _data(data)
+{
+    // Clip the bounds to the actual data.
+    const size_t max = _data.isNull() ? 0 : _data->size();
+    _offset = std::min(offset, max);
+    _size = std::min(size, max - _offset);
+}
+
+ts::ByteBlockSlice::ByteBlockSlice(const void* data, size_t size) :
+    _data(new ByteBlock(data, size)),
+    _size(size)
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Clear the slice and drop the reference on the shared data.
+//----------------------------------------------------------------------------
+
+void ts::ByteBlockSlice::clear()
+{
+    _data.clear();
+    _offset = 0;
+    _size = 0;
+}
+
+
+//----------------------------------------------------------------------------
+// Copy-on-write: make this slice the only reference on its data.
+//----------------------------------------------------------------------------
+
+void ts::ByteBlockSlice::detach()
+{
+    if (isShared()) {
+        // Copy only the slice, not the full shared block.
+        _data = new ByteBlock(_data->data() + _offset, _size);
+        _offset = 0;
+    }
+}
+
+uint8_t* ts::ByteBlockSlice::udata()
+{
+    if (_data.isNull() || _size == 0) {
+        return nullptr;
+    }
+    detach();
+    return _data->data() + _offset;
+}
+
+
+//----------------------------------------------------------------------------
+// Sub-slicing, sharing the same data.
+//----------------------------------------------------------------------------
+
+void ts::ByteBlockSlice::trim(size_t offset, size_t size)
+{
+    // Clip the bounds to the current slice.
+    offset = std::min(offset, _size);
+    _size = std::min(size, _size - offset);
+    _offset += offset;
+}
+
+ts::ByteBlockSlice ts::ByteBlockSlice::subSlice(size_t offset, size_t size) const
+{
+    ByteBlockSlice sub(*this);
+    sub.trim(offset, size);
+    return sub;
+}
+
+
+//----------------------------------------------------------------------------
+// Conversion and comparison.
+//----------------------------------------------------------------------------
+
+ts::ByteBlock ts::ByteBlockSlice::toByteBlock() const
+{
+    return _size == 0 ? ByteBlock() : ByteBlock(_data->data() + _offset, _size);
+}
+
+bool ts::ByteBlockSlice::operator==(const ByteBlockSlice& other) const
+{
+    return _size == other._size && (_size == 0 || std::memcmp(data(), other.data(), _size) == 0);
+}
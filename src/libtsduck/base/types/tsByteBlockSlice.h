@@ -0,0 +1,140 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Shared slice view over a reference-counted byte block.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsByteBlock.h"
+
+namespace ts {
+    //!
+    //! Shared slice view over a reference-counted byte block.
+    //! @ingroup cpp
+    //!
+    //! A ByteBlockSlice designates a contiguous range of bytes inside a
+    //! ByteBlock which is shared through a ByteBlockPtr. Copying a slice or
+    //! taking a sub-slice only adjusts the reference count and the bounds,
+    //! the bytes themselves are not copied. This avoids the duplication of
+    //! payloads when a part of a binary structure (section, PES packet) is
+    //! passed around read-only.
+    //!
+    //! The slice has copy-on-write semantics: requesting write access through
+    //! udata() duplicates the underlying data first when they are shared with
+    //! other references. Read access never copies.
+    //!
+    //! Like ByteBlockPtr, the reference counting is not thread-safe. Do not
+    //! share the same underlying data between slices in different threads.
+    //!
+    class TSDUCKDLL ByteBlockSlice
+    {
+    public:
+        //!
+        //! Default constructor, an empty slice.
+        //!
+        ByteBlockSlice() = default;
+
+        //!
+        //! Constructor from a shared byte block.
+        //! The data are shared, not copied.
+        //! @param [in] data Safe pointer to the data. The slice keeps a reference on it.
+        //! @param [in] offset Offset of the start of the slice in @a data.
+        //! @param [in] size Size in bytes of the slice, NPOS for "up to the end of @a data".
+        //! The bounds are clipped to the actual size of @a data.
+        //!
+        ByteBlockSlice(const ByteBlockPtr& data, size_t offset = 0, size_t size = NPOS);
+
+        //!
+        //! Constructor from raw data.
+        //! This is the only constructor which copies the bytes, to take ownership of them.
+        //! @param [in] data Address of the data to copy.
+        //! @param [in] size Size in bytes of the data.
+        //!
+        ByteBlockSlice(const void* data, size_t size);
+
+        //!
+        //! Get read-only access to the slice content.
+        //! @return Address of the first byte of the slice or the null pointer when empty.
+        //!
+        const uint8_t* data() const { return _data.isNull() || _size == 0 ? nullptr : _data->data() + _offset; }
+
+        //!
+        //! Get the size of the slice.
+        //! @return Size in bytes of the slice.
+        //!
+        size_t size() const { return _size; }
+
+        //!
+        //! Check if the slice is empty.
+        //! @return True when the slice is empty.
+        //!
+        bool empty() const { return _size == 0; }
+
+        //!
+        //! Clear the slice and drop the reference on the shared data.
+        //!
+        void clear();
+
+        //!
+        //! Check if the underlying data are shared with other references.
+        //! @return True when at least one other slice or ByteBlockPtr references the same data.
+        //!
+        bool isShared() const { return !_data.isNull() && _data.count() > 1; }
+
+        //!
+        //! Get write access to the slice content, copying the data first when they are shared.
+        //! After this call, the slice is guaranteed to be the only reference on its data.
+        //! @return Address of the first byte of the slice or the null pointer when empty.
+        //!
+        uint8_t* udata();
+
+        //!
+        //! Reduce the slice to a sub-range of itself.
+        //! The data are shared, not copied.
+        //! @param [in] offset Offset of the new start of the slice, relative to the current start.
+        //! @param [in] size New size in bytes of the slice, NPOS for "up to the end of the current slice".
+        //! The bounds are clipped to the current slice.
+        //!
+        void trim(size_t offset, size_t size = NPOS);
+
+        //!
+        //! Get a sub-slice of this slice.
+        //! The data are shared, not copied.
+        //! @param [in] offset Offset of the start of the sub-slice, relative to the start of this slice.
+        //! @param [in] size Size in bytes of the sub-slice, NPOS for "up to the end of this slice".
+        //! The bounds are clipped to this slice.
+        //! @return The sub-slice.
+        //!
+        ByteBlockSlice subSlice(size_t offset, size_t size = NPOS) const;
+
+        //!
+        //! Get a copy of the slice content as a byte block.
+        //! @return A byte block containing a copy of the slice.
+        //!
+        ByteBlock toByteBlock() const;
+
+        //!
+        //! Comparison operator.
+        //! The contents of the slices are compared, not the identities of the shared data.
+        //! @param [in] other Other slice to compare.
+        //! @return True when the two slices have identical contents.
+        //!
+        bool operator==(const ByteBlockSlice& other) const;
+        TS_UNEQUAL_OPERATOR(ByteBlockSlice)
+
+    private:
+        // Make this slice the only reference on its data, copying them when necessary.
+        void detach();
+
+        ByteBlockPtr _data {};    // Shared data, possibly larger than the slice.
+        size_t       _offset = 0; // Offset of the slice in *_data.
+        size_t       _size = 0;   // Size in bytes of the slice.
+    };
+}
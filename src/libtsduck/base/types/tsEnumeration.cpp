@@ -18,12 +18,27 @@ const ts::Enumeration::int_t ts::Enumeration::UNKNOWN = std::numeric_limits<ts::
 
 ts::Enumeration::Enumeration(std::initializer_list<NameValue> values)
 {
+    _entries.reserve(values.size());
     for (const auto& it : values) {
-        _map.insert(std::make_pair(it.value, it.name));
+        addValue(it.value, it.name);
     }
 }
 
 
+//----------------------------------------------------------------------------
+// Add one value/name pair, keeping the entries sorted.
+//----------------------------------------------------------------------------
+
+void ts::Enumeration::addValue(int_t value, const UString& name)
+{
+    // Insert after all entries with the same value, like a multimap would,
+    // so that the first declared name for a value is returned by name().
+    const auto it = std::upper_bound(_entries.begin(), _entries.end(), value,
+                                     [](int_t v, const std::pair<int_t, UString>& e) { return v < e.first; });
+    _entries.insert(it, std::make_pair(value, name));
+}
+
+
 //----------------------------------------------------------------------------
 // Get the value from a name, abbreviation allowed.
 //----------------------------------------------------------------------------
@@ -33,12 +48,13 @@ TS_GCC_NOWARNING(shadow) // workaround for a bug in GCC 7.5
 
 ts::Enumeration::int_t ts::Enumeration::value(const UString& name, bool caseSensitive, bool abbreviated) const
 {
-    const UString lcName(name.toLower());
     size_t previousCount = 0;
     int_t previous = UNKNOWN;
 
-    for (const auto& it : _map) {
-        if ((caseSensitive && it.second == name) || (!caseSensitive && it.second.toLower() == lcName)) {
+    for (const auto& it : _entries) {
+        if ((caseSensitive && it.second == name) ||
+            (!caseSensitive && it.second.length() == name.length() && it.second.startWith(name, CASE_INSENSITIVE)))
+        {
             // Found an exact match
             return it.first;
         }
@@ -78,11 +94,12 @@ TS_POP_WARNING()
 
 ts::UString ts::Enumeration::error(const UString& name1, bool caseSensitive, bool abbreviated, const UString& designator, const UString& prefix) const
 {
-    const UString lcName(name1.toLower());
     UStringList maybe;
 
-    for (const auto& it : _map) {
-        if ((caseSensitive && it.second == name1) || (!caseSensitive && it.second.toLower() == lcName)) {
+    for (const auto& it : _entries) {
+        if ((caseSensitive && it.second == name1) ||
+            (!caseSensitive && it.second.length() == name1.length() && it.second.startWith(name1, CASE_INSENSITIVE)))
+        {
             // Found an exact match, there is no error.
             return UString();
         }
@@ -111,8 +128,9 @@ ts::UString ts::Enumeration::error(const UString& name1, bool caseSensitive, boo
 
 ts::UString ts::Enumeration::intToName(int_t value, bool hexa, size_t hexDigitCount) const
 {
-    const auto it = _map.find(value);
-    if (it != _map.end()) {
+    const auto it = std::lower_bound(_entries.begin(), _entries.end(), value,
+                                     [](const std::pair<int_t, UString>& e, int_t v) { return e.first < v; });
+    if (it != _entries.end() && it->first == value) {
         return it->second;
     }
     else if (hexa) {
@@ -134,7 +152,7 @@ ts::UString ts::Enumeration::bitMaskNames(int_t value, const ts::UString& separa
     int_t done = 0; // Bitmask of all values which are already added in the list.
 
     // Insert all known names.
-    for (const auto& it : _map) {
+    for (const auto& it : _entries) {
         if ((value & it.first) == it.first) {
             // This bit pattern is present.
             done |= it.first;
@@ -171,8 +189,8 @@ ts::UString ts::Enumeration::bitMaskNames(int_t value, const ts::UString& separa
 ts::UString ts::Enumeration::nameList(const UString& separator, const UString& inQuote, const UString& outQuote) const
 {
     UStringVector sl;
-    sl.reserve(_map.size());
-    for (const auto& it : _map) {
+    sl.reserve(_entries.size());
+    for (const auto& it : _entries) {
         sl.push_back(inQuote + it.second + outQuote);
     }
     std::sort(sl.begin(), sl.end());
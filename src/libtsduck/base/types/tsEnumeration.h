@@ -93,20 +93,20 @@ namespace ts {
         //! @return True if this object has the same content as @a other,
         //! false otherwise.
         //!
-        bool operator==(const Enumeration& other) const { return _map == other._map; }
+        bool operator==(const Enumeration& other) const { return _entries == other._entries; }
         TS_UNEQUAL_OPERATOR(Enumeration)
 
         //!
         //! Get the number of entries in the enumeration.
         //! @return The number of entries in the enumeration.
         //!
-        size_t size() const { return _map.size(); }
+        size_t size() const { return _entries.size(); }
 
         //!
         //! Check if the enumeration is empty.
         //! @return True if the enumeration is empty.
         //!
-        bool empty() const { return _map.empty(); }
+        bool empty() const { return _entries.empty(); }
 
         //!
         //! Add a new enumeration value.
@@ -115,7 +115,7 @@ namespace ts {
         //! @param [in] value The corresponding integer value.
         //!
         template <typename INTENUM, typename std::enable_if<std::is_integral<INTENUM>::value || std::is_enum<INTENUM>::value>::type* = nullptr>
-        void add(const UString& name, INTENUM value) { _map.insert(std::make_pair(static_cast<int_t>(value), name)); }
+        void add(const UString& name, INTENUM value) { addValue(static_cast<int_t>(value), name); }
 
         //!
         //! Get the value from a name.
@@ -260,23 +260,30 @@ namespace ts {
         //! }
         //! @endcode
         //!
-        typedef std::multimap<int_t, UString>::const_iterator const_iterator;
+        typedef std::vector<std::pair<int_t, UString>>::const_iterator const_iterator;
 
         //!
         //! Return an iterator pointing to the first element of this object.
         //! @return An iterator pointing to the first element of this object.
         //!
-        const_iterator begin() const { return _map.begin(); }
+        const_iterator begin() const { return _entries.begin(); }
 
         //!
         //! Return an iterator pointing after the last element of this object.
         //! @return An iterator pointing after the last element of this object.
         //!
-        const_iterator end() const { return _map.end(); }
+        const_iterator end() const { return _entries.end(); }
 
     private:
-        // Map int to name. Multiple names are allowed for the same integer value.
-        std::multimap<int_t,UString> _map {};
+        // Value/name pairs, sorted by value, in one contiguous block of memory.
+        // Multiple names are allowed for the same integer value. A flat sorted
+        // vector is used instead of a node-based map: enumerations are small,
+        // built once (often as global constants at startup) and name lookups
+        // scan all entries anyway to detect ambiguous abbreviations.
+        std::vector<std::pair<int_t, UString>> _entries {};
+
+        // Add one value/name pair, keeping the entries sorted.
+        void addValue(int_t value, const UString& name);
 
         // Get the name from a value.
         UString intToName(int_t value, bool hexa = false, size_t hexDigitCount = 0) const;
@@ -324,7 +331,7 @@ template <class CONTAINER>
 void ts::Enumeration::getAllNames(CONTAINER& names) const
 {
     names.clear();
-    for (const auto& it : _map) {
+    for (const auto& it : _entries) {
         names.push_back(it.second);
     }
 }
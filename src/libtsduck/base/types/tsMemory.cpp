@@ -8,6 +8,33 @@
 
 #include "tsMemory.h"
 
+// Vector instructions for the byte scanners (00 00 XX pattern, identical
+// bytes). SSE2 is part of the x86-64 base ABI and NEON is part of the Arm-64
+// base ABI, no special compilation option is needed for these architectures.
+#if defined(__SSE2__) || (defined(TS_MSC) && (defined(_M_X64) || defined(_M_AMD64)))
+    #include <emmintrin.h>
+    #define TS_PATTERN_SCAN_SSE2 1
+#elif defined(__ARM_NEON)
+    #include <arm_neon.h>
+    #define TS_PATTERN_SCAN_NEON 1
+#endif
+
+#if defined(TS_PATTERN_SCAN_SSE2) || defined(TS_PATTERN_SCAN_NEON)
+namespace {
+    // Index of the lowest set bit in a non-zero mask.
+    inline size_t LowestSetBit(uint64_t mask)
+    {
+#if defined(TS_MSC)
+        unsigned long bit = 0;
+        ::_BitScanForward64(&bit, mask);
+        return size_t(bit);
+#else
+        return size_t(__builtin_ctzll(mask));
+#endif
+    }
+}
+#endif
+
 
 //----------------------------------------------------------------------------
 // Check if a memory area starts with the specified prefix
@@ -45,6 +72,65 @@ const uint8_t* ts::LocatePattern(const void* area, size_t area_size, const void*
 }
 
 
+//----------------------------------------------------------------------------
+// Locate a 3-byte pattern 00 00 XX into a memory area.
+//----------------------------------------------------------------------------
+
+const uint8_t* ts::LocateZeroZero(const void* area, size_t area_size, uint8_t third)
+{
+    const uint8_t* cur = reinterpret_cast<const uint8_t*>(area);
+    const uint8_t* const end = cur + area_size;
+
+#if defined(TS_PATTERN_SCAN_SSE2)
+    // Find pairs of zero bytes, 16 candidate offsets per step. The chunk is
+    // compared against zero, once at the current position and once shifted by
+    // one byte (hence the 17-byte requirement). Candidate positions are those
+    // where both comparisons match, the third byte is then checked separately.
+    const __m128i zero = _mm_setzero_si128();
+    while (cur + 17 <= end) {
+        const __m128i eq1 = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(cur)), zero);
+        const __m128i eq2 = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(cur + 1)), zero);
+        uint32_t mask = uint32_t(_mm_movemask_epi8(_mm_and_si128(eq1, eq2)));
+        while (mask != 0) {
+            const size_t i = LowestSetBit(mask);
+            if (cur + i + 2 < end && cur[i + 2] == third) {
+                return cur + i;
+            }
+            mask &= mask - 1; // clear lowest set bit
+        }
+        cur += 16;
+    }
+#elif defined(TS_PATTERN_SCAN_NEON)
+    // Same algorithm with NEON. The 128-bit comparison result is narrowed
+    // to a 64-bit mask with 4 bits per byte position.
+    const uint8x16_t zero = vdupq_n_u8(0);
+    while (cur + 17 <= end) {
+        const uint8x16_t eq1 = vceqq_u8(vld1q_u8(cur), zero);
+        const uint8x16_t eq2 = vceqq_u8(vld1q_u8(cur + 1), zero);
+        const uint8x16_t both = vandq_u8(eq1, eq2);
+        uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(both), 4)), 0);
+        while (mask != 0) {
+            const size_t i = LowestSetBit(mask) / 4;
+            if (cur + i + 2 < end && cur[i + 2] == third) {
+                return cur + i;
+            }
+            mask &= ~(uint64_t(0x0F) << (4 * i)); // clear that byte position
+        }
+        cur += 16;
+    }
+#endif
+
+    // Scalar loop on remaining bytes (and complete buffer without vector instructions).
+    while (cur + 3 <= end) {
+        if (cur[0] == 0 && cur[1] == 0 && cur[2] == third) {
+            return cur;
+        }
+        ++cur;
+    }
+    return nullptr; // not found
+}
+
+
 //----------------------------------------------------------------------------
 // Check if a memory area contains all identical byte values.
 //----------------------------------------------------------------------------
@@ -54,15 +140,49 @@ bool ts::IdenticalBytes(const void * area, size_t area_size)
     if (area_size < 2) {
         return false;
     }
-    else {
-        const uint8_t* d = reinterpret_cast<const uint8_t*>(area);
-        for (size_t i = 0; i < area_size - 1; ++i) {
-            if (d[i] != d[i + 1]) {
-                return false;
-            }
+
+    const uint8_t* cur = reinterpret_cast<const uint8_t*>(area);
+    const uint8_t* const end = cur + area_size;
+    const uint8_t value = *cur;
+
+#if defined(TS_PATTERN_SCAN_SSE2)
+    // Compare 64-byte chunks against the broadcasted first byte value.
+    const __m128i ref = _mm_set1_epi8(char(value));
+    while (cur + 64 <= end) {
+        const __m128i eq0 = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(cur)), ref);
+        const __m128i eq1 = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(cur + 16)), ref);
+        const __m128i eq2 = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(cur + 32)), ref);
+        const __m128i eq3 = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(cur + 48)), ref);
+        const __m128i all = _mm_and_si128(_mm_and_si128(eq0, eq1), _mm_and_si128(eq2, eq3));
+        if (uint32_t(_mm_movemask_epi8(all)) != 0xFFFF) {
+            return false;
+        }
+        cur += 64;
+    }
+#elif defined(TS_PATTERN_SCAN_NEON)
+    // Same algorithm with NEON.
+    const uint8x16_t ref = vdupq_n_u8(value);
+    while (cur + 64 <= end) {
+        const uint8x16_t eq0 = vceqq_u8(vld1q_u8(cur), ref);
+        const uint8x16_t eq1 = vceqq_u8(vld1q_u8(cur + 16), ref);
+        const uint8x16_t eq2 = vceqq_u8(vld1q_u8(cur + 32), ref);
+        const uint8x16_t eq3 = vceqq_u8(vld1q_u8(cur + 48), ref);
+        const uint64x2_t all = vreinterpretq_u64_u8(vandq_u8(vandq_u8(eq0, eq1), vandq_u8(eq2, eq3)));
+        if ((vgetq_lane_u64(all, 0) & vgetq_lane_u64(all, 1)) != std::numeric_limits<uint64_t>::max()) {
+            return false;
+        }
+        cur += 64;
+    }
+#endif
+
+    // Scalar loop on remaining bytes (and complete buffer without vector instructions).
+    while (cur < end) {
+        if (*cur != value) {
+            return false;
         }
-        return true;
+        ++cur;
     }
+    return true;
 }
 
 
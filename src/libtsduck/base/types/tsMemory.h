@@ -56,6 +56,18 @@ namespace ts {
     //!
     TSDUCKDLL const uint8_t* LocatePattern(const void* area, size_t area_size, const void* pattern, size_t pattern_size);
 
+    //!
+    //! Locate a 3-byte pattern 00 00 XX into a memory area.
+    //! This is a specialized version of LocatePattern() which is accelerated with vector
+    //! instructions on platforms which support them. It is typically used to locate MPEG
+    //! start code prefixes (00 00 01) or filler sequences (00 00 00) in video streams.
+    //! @param [in] area Address of a memory area to check.
+    //! @param [in] area_size Size in bytes of the memory area.
+    //! @param [in] third Value of the third byte of the pattern.
+    //! @return Address of the first occurence of the pattern in @a area or the null pointer if not found.
+    //!
+    TSDUCKDLL const uint8_t* LocateZeroZero(const void* area, size_t area_size, uint8_t third);
+
     //!
     //! Check if a memory area contains all identical byte values.
     //! @param [in] area Address of a memory area to check.
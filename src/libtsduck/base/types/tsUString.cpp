@@ -18,6 +18,171 @@
 #include "tsIntegerUtils.h"
 #include "tsEnumeration.h"
 
+// Vector instructions for the 7-bit ASCII fast paths of the UTF-8 / UTF-16
+// conversions and for the JSON escape scanner. SSE2 is part of the x86-64
+// base ABI and NEON is part of the Arm-64 base ABI, no special compilation
+// option is needed.
+#if defined(__SSE2__) || (defined(TS_MSC) && (defined(_M_X64) || defined(_M_AMD64)))
+    #include <emmintrin.h>
+    #define TS_ASCII_CONV_SSE2 1
+#elif defined(__ARM_NEON)
+    #include <arm_neon.h>
+    #define TS_ASCII_CONV_NEON 1
+#endif
+
+namespace {
+
+    // Number of leading 7-bit ASCII bytes in an UTF-8 buffer.
+    size_t AsciiPrefixSize(const char* data, size_t size)
+    {
+        const char* cur = data;
+        const char* const end = data + size;
+#if defined(TS_ASCII_CONV_SSE2)
+        while (cur + 16 <= end) {
+            const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cur));
+            if (_mm_movemask_epi8(chunk) != 0) {
+                break;
+            }
+            cur += 16;
+        }
+#elif defined(TS_ASCII_CONV_NEON)
+        while (cur + 16 <= end) {
+            const uint8x16_t hi = vcgeq_u8(vld1q_u8(reinterpret_cast<const uint8_t*>(cur)), vdupq_n_u8(0x80));
+            // Narrow the 128-bit comparison result to a 64-bit mask, 4 bits per byte.
+            if (vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(hi), 4)), 0) != 0) {
+                break;
+            }
+            cur += 16;
+        }
+#endif
+        while (cur < end && (*cur & 0x80) == 0) {
+            ++cur;
+        }
+        return size_t(cur - data);
+    }
+
+    // Number of leading 7-bit ASCII code points in an UTF-16 buffer.
+    size_t AsciiPrefixSize(const ts::UChar* data, size_t size)
+    {
+        const ts::UChar* cur = data;
+        const ts::UChar* const end = data + size;
+#if defined(TS_ASCII_CONV_SSE2)
+        const __m128i non_ascii = _mm_set1_epi16(int16_t(0xFF80));
+        while (cur + 8 <= end) {
+            const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cur));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(chunk, non_ascii), _mm_setzero_si128())) != 0xFFFF) {
+                break;
+            }
+            cur += 8;
+        }
+#elif defined(TS_ASCII_CONV_NEON)
+        while (cur + 8 <= end) {
+            const uint16x8_t hi = vcgeq_u16(vld1q_u16(reinterpret_cast<const uint16_t*>(cur)), vdupq_n_u16(0x80));
+            // Narrow the 128-bit comparison result to a 64-bit mask, 8 bits per code point.
+            if (vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(hi, 4)), 0) != 0) {
+                break;
+            }
+            cur += 8;
+        }
+#endif
+        while (cur < end && *cur < 0x80) {
+            ++cur;
+        }
+        return size_t(cur - data);
+    }
+
+    // Number of leading characters which need no escape in a JSON string,
+    // ie. printable ASCII except the quotation mark and the backslash.
+    size_t JSONPlainPrefixSize(const ts::UChar* data, size_t size)
+    {
+        const ts::UChar* cur = data;
+        const ts::UChar* const end = data + size;
+#if defined(TS_ASCII_CONV_SSE2)
+        const __m128i space = _mm_set1_epi16(0x0020);
+        const __m128i tilde = _mm_set1_epi16(0x007E);
+        const __m128i quote = _mm_set1_epi16(0x0022);
+        const __m128i bslash = _mm_set1_epi16(0x005C);
+        while (cur + 8 <= end) {
+            const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cur));
+            // Unsigned comparisons through saturating subtractions: a <= b when a -sat- b == 0.
+            const __m128i in_range = _mm_and_si128(_mm_cmpeq_epi16(_mm_subs_epu16(space, chunk), _mm_setzero_si128()),
+                                                   _mm_cmpeq_epi16(_mm_subs_epu16(chunk, tilde), _mm_setzero_si128()));
+            const __m128i escape = _mm_or_si128(_mm_cmpeq_epi16(chunk, quote), _mm_cmpeq_epi16(chunk, bslash));
+            if (_mm_movemask_epi8(_mm_andnot_si128(escape, in_range)) != 0xFFFF) {
+                break;
+            }
+            cur += 8;
+        }
+#elif defined(TS_ASCII_CONV_NEON)
+        while (cur + 8 <= end) {
+            const uint16x8_t chunk = vld1q_u16(reinterpret_cast<const uint16_t*>(cur));
+            const uint16x8_t in_range = vandq_u16(vcgeq_u16(chunk, vdupq_n_u16(0x0020)), vcleq_u16(chunk, vdupq_n_u16(0x007E)));
+            const uint16x8_t escape = vorrq_u16(vceqq_u16(chunk, vdupq_n_u16(0x0022)), vceqq_u16(chunk, vdupq_n_u16(0x005C)));
+            // Narrow the 128-bit comparison result to a 64-bit mask, 8 bits per code point.
+            if (vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vbicq_u16(in_range, escape), 4)), 0) != 0xFFFFFFFFFFFFFFFF) {
+                break;
+            }
+            cur += 8;
+        }
+#endif
+        while (cur < end && *cur >= 0x0020 && *cur <= 0x007E && *cur != ts::QUOTATION_MARK && *cur != ts::REVERSE_SOLIDUS) {
+            ++cur;
+        }
+        return size_t(cur - data);
+    }
+
+    // Widen a buffer of 7-bit ASCII bytes into UTF-16 code points.
+    void WidenAscii(const char* in, size_t count, ts::UChar* out)
+    {
+#if defined(TS_ASCII_CONV_SSE2)
+        const __m128i zero = _mm_setzero_si128();
+        while (count >= 16) {
+            const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_unpacklo_epi8(chunk, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 8), _mm_unpackhi_epi8(chunk, zero));
+            in += 16;
+            out += 16;
+            count -= 16;
+        }
+#elif defined(TS_ASCII_CONV_NEON)
+        while (count >= 8) {
+            vst1q_u16(reinterpret_cast<uint16_t*>(out), vmovl_u8(vld1_u8(reinterpret_cast<const uint8_t*>(in))));
+            in += 8;
+            out += 8;
+            count -= 8;
+        }
+#endif
+        while (count-- > 0) {
+            *out++ = ts::UChar(uint8_t(*in++));
+        }
+    }
+
+    // Narrow a buffer of 7-bit ASCII UTF-16 code points into bytes.
+    void NarrowAscii(const ts::UChar* in, size_t count, char* out)
+    {
+#if defined(TS_ASCII_CONV_SSE2)
+        while (count >= 16) {
+            const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+            const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 8));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_packus_epi16(lo, hi));
+            in += 16;
+            out += 16;
+            count -= 16;
+        }
+#elif defined(TS_ASCII_CONV_NEON)
+        while (count >= 8) {
+            vst1_u8(reinterpret_cast<uint8_t*>(out), vmovn_u16(vld1q_u16(reinterpret_cast<const uint16_t*>(in))));
+            in += 8;
+            out += 8;
+            count -= 8;
+        }
+#endif
+        while (count-- > 0) {
+            *out++ = char(*in++);
+        }
+    }
+}
+
 // The UTF-8 Byte Order Mark
 const char* const ts::UString::UTF8_BOM = "\xEF\xBB\xBF";
 
@@ -88,6 +253,18 @@ void ts::UString::ConvertUTF16ToUTF8(const UChar*& inStart, const UChar* inEnd,
 
     while (inStart < inEnd && outStart < outEnd) {
 
+        // Bulk conversion of 7-bit ASCII runs, the dominant case in practice.
+        // ASCII code points are copied verbatim, several at a time.
+        const size_t ascii = AsciiPrefixSize(inStart, std::min<size_t>(inEnd - inStart, outEnd - outStart));
+        if (ascii > 0) {
+            NarrowAscii(inStart, ascii, outStart);
+            inStart += ascii;
+            outStart += ascii;
+            if (inStart >= inEnd || outStart >= outEnd) {
+                break;
+            }
+        }
+
         // Get current code point as 16-bit value.
         code = *inStart++;
 
@@ -199,6 +376,18 @@ void ts::UString::ConvertUTF8ToUTF16(const char*& inStart, const char* inEnd, UC
 
     while (inStart < inEnd && outStart < outEnd) {
 
+        // Bulk conversion of 7-bit ASCII runs, the dominant case in practice.
+        // ASCII bytes are widened verbatim, several at a time.
+        const size_t ascii = AsciiPrefixSize(inStart, std::min<size_t>(inEnd - inStart, outEnd - outStart));
+        if (ascii > 0) {
+            WidenAscii(inStart, ascii, outStart);
+            inStart += ascii;
+            outStart += ascii;
+            if (inStart >= inEnd || outStart >= outEnd) {
+                break;
+            }
+        }
+
         // Get current code point at 8-bit value.
         code = *inStart++ & 0xFF;
 
@@ -349,8 +538,13 @@ ts::UString& ts::UString::assignFromUTF8(const char* utf8, size_type count)
 
 void ts::UString::toUTF8(std::string& utf8) const
 {
-    // The maximum number of UTF-8 bytes is 3 times the number of UTF-16 codes.
-    utf8.resize(3 * size());
+    // When the string is 7-bit ASCII, the common case for log messages, the
+    // UTF-8 size is the exact number of characters and short strings stay
+    // within the small-string storage of std::string, without allocation.
+    // Otherwise, the maximum number of UTF-8 bytes is 3 times the number of
+    // UTF-16 codes.
+    const bool ascii = AsciiPrefixSize(data(), size()) == size();
+    utf8.resize(ascii ? size() : 3 * size());
 
     const UChar* inStart = data();
     char* outStart = const_cast<char*>(utf8.data());
@@ -373,14 +567,16 @@ std::string ts::UString::toUTF8() const
 
 std::ostream& operator<<(std::ostream& strm, const ts::UString& str)
 {
-    std::string utf8;
+    // Reuse a per-thread conversion buffer: repeated log messages do not
+    // allocate once the buffer has reached its high-water mark.
+    thread_local std::string utf8;
     str.toUTF8(utf8);
     return strm << utf8;
 }
 
 std::ostream& operator<<(std::ostream& strm, const ts::UChar* str)
 {
-    std::string utf8;
+    thread_local std::string utf8;
     ts::UString(str).toUTF8(utf8);
     return strm << utf8;
 }
@@ -1239,7 +1435,19 @@ ts::UString ts::UString::fromJSON() const
 
 void ts::UString::convertToJSON()
 {
-    for (size_type i = 0; i < length(); ) {
+    // Fast path: leading run of characters which need no escape.
+    // In the common case of a plain ASCII string, nothing is modified.
+    size_type i = JSONPlainPrefixSize(data(), length());
+    if (i >= length()) {
+        return;
+    }
+
+    // Rebuild the escaped string in one single pass.
+    UString result;
+    result.reserve(length() + 16);
+    result.assign(*this, 0, i);
+
+    while (i < length()) {
         const UChar c = at(i);
 
         // Known backslash sequences.
@@ -1257,21 +1465,24 @@ void ts::UString::convertToJSON()
 
         if (quoted != CHAR_NULL) {
             // Single character backslash sequence
-            at(i) = REVERSE_SOLIDUS;
-            insert(i + 1, 1, quoted);
-            i += 2;
+            result.push_back(REVERSE_SOLIDUS);
+            result.push_back(quoted);
+            i++;
         }
         else if (c >= 0x0020 && c <= 0x007E) {
-            // Unmodified character
-            i++;
+            // Run of unmodified characters, append it in one chunk.
+            const size_type run = JSONPlainPrefixSize(data() + i, length() - i);
+            result.append(*this, i, run);
+            i += run;
         }
         else {
             // Other Unicode character, use hex code.
-            at(i) = REVERSE_SOLIDUS;
-            insert(i + 1, Format(u"u%04X", {uint16_t(c)}));
-            i += 6;
+            result.push_back(REVERSE_SOLIDUS);
+            result.append(Format(u"u%04X", {uint16_t(c)}));
+            i++;
         }
     }
+    swap(result);
 }
 
 void ts::UString::convertFromJSON()
@@ -1670,6 +1881,18 @@ bool ts::UString::hexaDecodeAppend(ts::ByteBlock& result, bool c_style) const
 // Wrapper methods.
 //----------------------------------------------------------------------------
 
+// Lookup table: hexadecimal representation of all byte values, two characters per byte.
+namespace {
+    const std::array<ts::UChar, 512> UPPER_HEX_BYTE = []() {
+        std::array<ts::UChar, 512> table {};
+        for (size_t byte = 0; byte < 256; ++byte) {
+            table[2 * byte] = u"0123456789ABCDEF"[byte >> 4];
+            table[2 * byte + 1] = u"0123456789ABCDEF"[byte & 0x0F];
+        }
+        return table;
+    }();
+}
+
 ts::UString ts::UString::Dump(const void *data,
                               size_type size,
                               uint32_t flags,
@@ -1706,6 +1929,117 @@ void ts::UString::appendDump(const ByteBlock& bb,
 }
 
 
+//----------------------------------------------------------------------------
+// Compute the number of dumped bytes per line (internal helper).
+//----------------------------------------------------------------------------
+
+ts::UString::size_type ts::UString::DumpBytesPerLine(uint32_t flags, size_type indent, size_type line_width, size_type end_offset, size_type inner_indent)
+{
+    // Width of an hexa byte: "XX" (2) or "0xXX," (5).
+    size_type hexa_width = 0;
+    if (flags & C_STYLE) {
+        hexa_width = 5;
+        flags |= HEXA;
+    }
+    else if (flags & (HEXA | SINGLE_LINE)) {
+        hexa_width = 2;
+    }
+
+    // Width of the offset field.
+    size_type offset_width = 0;
+    if ((flags & OFFSET) != 0) {
+        offset_width = (flags & WIDE_OFFSET) == 0 && end_offset <= 0x10000 ? 4 : 8;
+    }
+
+    // Width of a binary byte.
+    size_type bin_width = 0;
+    if (flags & BIN_NIBBLE) {
+        bin_width = 9;
+        flags |= BINARY;
+    }
+    else if (flags & BINARY) {
+        bin_width = 8;
+    }
+
+    // Number of non-byte characters.
+    size_type add_width = indent + inner_indent;
+    if (offset_width != 0) {
+        add_width += offset_width + 3;
+    }
+    if ((flags & HEXA) && (flags & (BINARY | ASCII))) {
+        add_width += 2;
+    }
+    if ((flags & BINARY) && (flags & ASCII)) {
+        add_width += 2;
+    }
+
+    // Max number of dumped bytes per line.
+    size_type bytes_per_line;
+    if (flags & BPL) {
+        bytes_per_line = line_width;
+    }
+    else if (add_width >= line_width) {
+        bytes_per_line = 8;  // arbitrary, if indent is too long
+    }
+    else {
+        bytes_per_line = (line_width - add_width) /
+            (((flags & HEXA) ? (hexa_width + 1) : 0) +
+             ((flags & BINARY) ? (bin_width + 1) : 0) +
+             ((flags & ASCII) ? 1 : 0));
+        if (bytes_per_line > 1) {
+            bytes_per_line = bytes_per_line & ~1; // force even value
+        }
+    }
+    return bytes_per_line == 0 ? 8 : bytes_per_line;  // arbitrary, if ended up with none
+}
+
+
+//----------------------------------------------------------------------------
+// Write the hexadecimal dump of a memory area directly into a stream.
+//----------------------------------------------------------------------------
+
+void ts::UString::Dump(std::ostream& strm,
+                       const void *data,
+                       size_type size,
+                       uint32_t flags,
+                       size_type indent,
+                       size_type line_width,
+                       size_type init_offset,
+                       size_type inner_indent)
+{
+    // Do nothing in case of invalid or empty data.
+    if (data == nullptr || size == 0) {
+        return;
+    }
+
+    // Make sure we have something to display (default is hexa).
+    if ((flags & (HEXA | C_STYLE | BINARY | BIN_NIBBLE | ASCII)) == 0) {
+        flags |= HEXA;
+    }
+
+    // Single-line variants cannot be split, build them in one string.
+    if ((flags & (SINGLE_LINE | COMPACT)) != 0) {
+        strm << Dump(data, size, flags, indent, line_width, init_offset, inner_indent);
+        return;
+    }
+
+    // Force a constant offset width over all lines of the dump.
+    if ((flags & OFFSET) != 0 && init_offset + size > 0x10000) {
+        flags |= WIDE_OFFSET;
+    }
+
+    // Format and write the dump line by line, reusing one line buffer.
+    const size_type bpl = DumpBytesPerLine(flags, indent, line_width, init_offset + size, inner_indent);
+    const uint8_t* raw = static_cast<const uint8_t*>(data);
+    UString line;
+    for (size_type start = 0; start < size; start += bpl) {
+        line.clear();
+        line.appendDump(raw + start, std::min(bpl, size - start), flags | BPL, indent, bpl, init_offset + start, inner_indent);
+        strm << line;
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Build a multi-line string containing the hexadecimal dump of a memory area.
 //----------------------------------------------------------------------------
@@ -1761,7 +2095,7 @@ void ts::UString::appendDump(const void *data,
                 append(1, u' ');
             }
             append(byte_prefix);
-            append(Hexa(raw[i], 0, UString(), false, true));
+            append(&UPPER_HEX_BYTE[2 * raw[i]], 2);
             append(byte_suffix);
         }
         return;
@@ -1800,39 +2134,8 @@ void ts::UString::appendDump(const void *data,
     // Pre-allocation to avoid too frequent reallocations.
     reserve(length() + indent + inner_indent + (hexa_width + bin_width + 5) * size);
 
-    // Number of non-byte characters
-    size_type add_width = indent + inner_indent;
-    if (offset_width != 0) {
-        add_width += offset_width + 3;
-    }
-    if ((flags & HEXA) && (flags & (BINARY | ASCII))) {
-        add_width += 2;
-    }
-    if ((flags & BINARY) && (flags & ASCII)) {
-        add_width += 2;
-    }
-
     // Computes max number of dumped bytes per line
-    size_type bytes_per_line;
-
-    if (flags & BPL) {
-        bytes_per_line = line_width;
-    }
-    else if (add_width >= line_width) {
-        bytes_per_line = 8;  // arbitrary, if indent is too long
-    }
-    else {
-        bytes_per_line = (line_width - add_width) /
-            (((flags & HEXA) ? (hexa_width + 1) : 0) +
-             ((flags & BINARY) ? (bin_width + 1) : 0) +
-             ((flags & ASCII) ? 1 : 0));
-        if (bytes_per_line > 1) {
-            bytes_per_line = bytes_per_line & ~1; // force even value
-        }
-    }
-    if (bytes_per_line == 0) {
-        bytes_per_line = 8;  // arbitrary, if ended up with none
-    }
+    const size_type bytes_per_line = DumpBytesPerLine(flags, indent, line_width, init_offset + size, inner_indent);
 
     // Display data
     for (size_type line = 0; line < size; line += bytes_per_line) {
@@ -1852,7 +2155,7 @@ void ts::UString::appendDump(const void *data,
         if (flags & HEXA) {
             for (size_type byte = 0; byte < line_size; byte++) {
                 append(byte_prefix);
-                append(Hexa(raw[line + byte], 0, UString(), false, true));
+                append(&UPPER_HEX_BYTE[2 * raw[line + byte]], 2);
                 append(byte_suffix);
                 if (byte < bytes_per_line - 1) {
                     append(1, u' ');
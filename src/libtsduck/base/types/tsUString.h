@@ -2006,6 +2006,34 @@ namespace ts {
                         size_type init_offset = 0,
                         size_type inner_indent = 0);
 
+        //!
+        //! Write the hexadecimal dump of a memory area directly into a stream.
+        //! This is equivalent to writing the result of Dump() into the stream but
+        //! the data are formatted and written line by line, reusing one line buffer,
+        //! without building one big string for the complete dump. On large memory
+        //! areas, this is faster and the memory usage remains flat.
+        //! @param [in,out] strm Output stream.
+        //! @param [in] data Starting address of the memory area to dump.
+        //! @param [in] size Size in bytes of the memory area to dump.
+        //! @param [in] flags A combination of option flags indicating how to format the data.
+        //! This is typically the result of or'ed values from the enum type HexaFlags.
+        //! @param [in] indent Each line is indented by this number of characters.
+        //! @param [in] line_width Maximum number of characters per line.
+        //! If the flag BPL is specified, @a line_width is interpreted as the number of displayed byte values per line.
+        //! @param [in] init_offset If the flag OFFSET is specified, an offset in the memory area is displayed at the beginning of each line.
+        //! In this case, @a init_offset specified the offset value for the first byte.
+        //! @param [in] inner_indent Add this indentation before hexa/ascii dump, after offset.
+        //! @see HexaFlags
+        //!
+        static void Dump(std::ostream& strm,
+                         const void *data,
+                         size_type size,
+                         uint32_t flags = HEXA,
+                         size_type indent = 0,
+                         size_type line_width = DEFAULT_HEXA_LINE_WIDTH,
+                         size_type init_offset = 0,
+                         size_type inner_indent = 0);
+
         //!
         //! Interpret this string as a sequence of hexadecimal digits (ignore blanks).
         //! @param [out] result Decoded bytes.
@@ -2216,6 +2244,11 @@ namespace ts {
 #endif
 
     private:
+        // Internal helper for appendDump() and the stream version of Dump():
+        // compute the number of dumped bytes per line. The end_offset parameter
+        // is the offset after the last byte of the complete dump (init_offset + size).
+        static size_type DumpBytesPerLine(uint32_t flags, size_type indent, size_type line_width, size_type end_offset, size_type inner_indent);
+
         // Internal helpers for toInteger(), signed and unsigned versions.
         // Work on trimmed strings, with leading '+' skipped.
         template<typename INT, typename std::enable_if<std::is_integral<INT>::value && std::is_unsigned<INT>::value>::type* = nullptr>
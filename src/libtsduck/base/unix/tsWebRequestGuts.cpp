@@ -198,7 +198,9 @@ public:
     bool startTransfer(CertState certState);
 
     // Close and cleanup everything.
-    void clear();
+    // With connection reuse, unless deep is true, keep the curl handles alive
+    // so that the next transfer on the same object can reuse the connection.
+    void clear(bool deep = false);
 
     // Wait for data to be present in the reception buffer.
     // If maxSize is zero, wait until something is present in data buffer
@@ -224,7 +226,10 @@ private:
     ::curl_slist* _headers {nullptr};          // Request headers.
     bool          _canRetry {false};           // Can retry the connection later.
     UString       _certFile {};                // Latest CA certificates file.
-    ByteBlock     _data {};                    // Received data, filled by writeCallback(), emptied by receive().
+    uint8_t*      _dest {nullptr};             // User buffer of the pending receive(), directly written by writeCallback().
+    size_t        _destMax {0};                // Size of the user buffer.
+    size_t        _destSize {0};               // Number of bytes already written into the user buffer.
+    ByteBlock     _data {};                    // Received data which does not fit in the user buffer.
     char          _error[CURL_ERROR_SIZE] {0}; // Error message buffer for libcurl.
 
     // Handle an error while receiving data. Always return false.
@@ -249,7 +254,7 @@ ts::WebRequest::SystemGuts::SystemGuts(WebRequest& request) :
 
 ts::WebRequest::SystemGuts::~SystemGuts()
 {
-    clear();
+    clear(true);
 }
 
 void ts::WebRequest::allocateGuts()
@@ -384,14 +389,16 @@ bool ts::WebRequest::SystemGuts::startTransfer(CertState certState)
 #if defined(TS_CURL_WAKEUP)
             std::lock_guard<std::mutex> lock(_mutex);
 #endif
-            // Initialize curl_multi and curl_easy
-            if ((_curlm = ::curl_multi_init()) == nullptr) {
+            // Initialize curl_multi and curl_easy. With connection reuse, the handles
+            // are kept from the previous transfer, along with their live connections,
+            // DNS cache and TLS session cache.
+            if (_curlm == nullptr && (_curlm = ::curl_multi_init()) == nullptr) {
                 _request._report.error(u"libcurl 'curl_multi' initialization error");
                 return false;
             }
-            if ((_curl = ::curl_easy_init()) == nullptr) {
+            if (_curl == nullptr && (_curl = ::curl_easy_init()) == nullptr) {
                 _request._report.error(u"libcurl 'curl_easy' initialization error");
-                clear();
+                clear(true);
                 return false;
             }
 
@@ -399,7 +406,7 @@ bool ts::WebRequest::SystemGuts::startTransfer(CertState certState)
             ::CURLMcode mstatus = ::curl_multi_add_handle(_curlm, _curl);
             if (mstatus != ::CURLM_OK) {
                 _request._report.error(multiMessage(u"curl_multi_add_handle error", mstatus));
-                clear();
+                clear(true);
                 return false;
             }
         }
@@ -425,6 +432,13 @@ bool ts::WebRequest::SystemGuts::startTransfer(CertState certState)
             status = ::curl_easy_setopt(_curl, CURLOPT_ACCEPT_ENCODING, "");
         }
 
+        // With connection reuse, extend the life of DNS cache entries (the libcurl
+        // default is 60 seconds) so that successive transfers on the same server
+        // do not resolve its name again.
+        if (status == ::CURLE_OK && _request._connectionReuse) {
+            status = ::curl_easy_setopt(_curl, CURLOPT_DNS_CACHE_TIMEOUT, 300L);
+        }
+
         // Set the starting URL.
         if (status == ::CURLE_OK) {
             status = ::curl_easy_setopt(_curl, CURLOPT_URL, _request._originalURL.toUTF8().c_str());
@@ -580,8 +594,15 @@ bool ts::WebRequest::SystemGuts::receive(void* buffer, size_t maxSize, size_t* r
     ::CURLMcode mstatus = ::CURLM_OK;
     int runningHandles = 0;
 
-    // If the response buffer is empty, wait for data.
-    while (_data.empty() && !_request._interrupted) {
+    // Let the write callback fill the user buffer directly, without a copy
+    // through _data. The callback is always invoked from curl_multi_perform(),
+    // in this thread, so _dest is never accessed concurrently.
+    _dest = reinterpret_cast<uint8_t*>(buffer);
+    _destMax = buffer == nullptr ? 0 : maxSize;
+    _destSize = 0;
+
+    // If no data was received yet, wait for some.
+    while (_data.empty() && _destSize == 0 && !_request._interrupted) {
 
         // Perform all immediate operations. Non-blocking call.
 #if defined(TS_CURL_CALLAGAIN)
@@ -601,8 +622,8 @@ bool ts::WebRequest::SystemGuts::receive(void* buffer, size_t maxSize, size_t* r
             break;
         }
 
-        // If there is still nothing in the response buffer, wait for something to be ready.
-        if (_data.empty()) {
+        // If there is still nothing received, wait for something to be ready.
+        if (_data.empty() && _destSize == 0) {
 
             // Wait for something to happen on the sockets or some timeout.
             int numfds = 0;
@@ -618,14 +639,18 @@ bool ts::WebRequest::SystemGuts::receive(void* buffer, size_t maxSize, size_t* r
         }
     }
 
+    // The user buffer is no longer a valid destination after returning.
+    _dest = nullptr;
+    _destMax = 0;
+
     // Immediate error on interrupt.
     if (_request._interrupted) {
         _request._report.debug(u"curl: request was interrupted");
         return false;
     }
 
-    // If the data buffer is empty and there is no more running transfer, check status.
-    if (_data.empty() && runningHandles == 0) {
+    // If nothing was received and there is no more running transfer, check status.
+    if (_data.empty() && _destSize == 0 && runningHandles == 0) {
         ::CURLMsg* msg = nullptr;
         int remainingMsg = 0;
         while ((msg = ::curl_multi_info_read(_curlm, &remainingMsg)) != nullptr) {
@@ -649,15 +674,20 @@ bool ts::WebRequest::SystemGuts::receive(void* buffer, size_t maxSize, size_t* r
         return true;
     }
 
-    // Now transfer data to the user.
-    const size_t size = buffer == nullptr ? 0 : std::min(_data.size(), maxSize);
-    if (size > 0) {
-        std::memcpy(buffer, _data.data(), size);
-        if (size >= _data.size()) {
+    // Some data may have been directly written into the user buffer by the
+    // write callback. Append older data which were stored in _data before the
+    // user buffer was known (they always precede direct writes in the stream).
+    size_t size = _destSize;
+    if (buffer != nullptr && size < maxSize && !_data.empty()) {
+        assert(size == 0);
+        const size_t more = std::min(_data.size(), maxSize - size);
+        std::memcpy(reinterpret_cast<uint8_t*>(buffer) + size, _data.data(), more);
+        size += more;
+        if (more >= _data.size()) {
             _data.clear();
         }
         else {
-            _data.erase(0, size);
+            _data.erase(0, more);
         }
     }
     if (retSize != nullptr) {
@@ -687,7 +717,7 @@ void ts::WebRequest::SystemGuts::abort()
 // Close and cleanup everything.
 //----------------------------------------------------------------------------
 
-void ts::WebRequest::SystemGuts::clear()
+void ts::WebRequest::SystemGuts::clear(bool deep)
 {
 #if defined(TS_CURL_WAKEUP)
     // Make sure we don't call curl_multi_wakeup() while deallocating.
@@ -705,22 +735,32 @@ void ts::WebRequest::SystemGuts::clear()
         ::curl_multi_remove_handle(_curlm, _curl);
     }
 
-    // Make sure the curl_easy is clean.
-    if (_curl != nullptr) {
-        ::curl_easy_cleanup(_curl);
-        _curl = nullptr;
-    }
+    if (deep || !_request._connectionReuse) {
+        // Make sure the curl_easy is clean.
+        if (_curl != nullptr) {
+            ::curl_easy_cleanup(_curl);
+            _curl = nullptr;
+        }
 
-    // Make sure the curl_multi is clean.
-    if (_curlm != nullptr) {
-        ::curl_multi_cleanup(_curlm);
-        _curlm = nullptr;
+        // Make sure the curl_multi is clean.
+        if (_curlm != nullptr) {
+            ::curl_multi_cleanup(_curlm);
+            _curlm = nullptr;
+        }
+    }
+    else if (_curl != nullptr) {
+        // Connection reuse: reset all options on the curl_easy handler but keep it
+        // alive, with its live connections, DNS cache and TLS session cache. All
+        // options are set again at the beginning of the next transfer.
+        ::curl_easy_reset(_curl);
     }
 
     // Erase nul-terminated error message.
     _error[0] = 0;
 
-    // Cleanup response data buffer.
+    // Cleanup response data buffer and direct destination.
+    _dest = nullptr;
+    _destMax = _destSize = 0;
     _data.clear();
     _canRetry = false;
 }
@@ -758,9 +798,24 @@ size_t ts::WebRequest::SystemGuts::WriteCallback(char *ptr, size_t size, size_t
         return 0; // error
     }
     else {
-        // Store response data in the SystemGuts.
         const size_t dataSize = size * nmemb;
-        guts->_data.append(ptr, dataSize);
+        size_t remain = dataSize;
+
+        // Write directly into the user buffer of the pending receive(), if any.
+        // This avoids copying every received byte through the _data buffer.
+        if (guts->_dest != nullptr && guts->_destSize < guts->_destMax) {
+            const size_t direct = std::min(remain, guts->_destMax - guts->_destSize);
+            std::memcpy(guts->_dest + guts->_destSize, ptr, direct);
+            guts->_destSize += direct;
+            ptr += direct;
+            remain -= direct;
+        }
+
+        // Store the rest in the SystemGuts, for the next receive().
+        if (remain > 0) {
+            guts->_data.append(ptr, remain);
+        }
+
         // After receiving some data, it is no longer possible to retry the connection.
         guts->_canRetry = false;
         return dataSize;
@@ -872,9 +872,10 @@ void ts::xml::Element::printClose(TextFormatter& output, size_t levels) const
 // Parse the node.
 //----------------------------------------------------------------------------
 
-bool ts::xml::Element::parseNode(TextParser& parser, const Node* parent)
+bool ts::xml::Element::parseTag(TextParser& parser, bool& selfClosing)
 {
     // We just read the "<". Skip spaces and read the tag name.
+    selfClosing = false;
     UString nodeName;
     parser.skipWhiteSpace();
     if (!parser.parseXMLName(nodeName)) {
@@ -900,6 +901,7 @@ bool ts::xml::Element::parseNode(TextParser& parser, const Node* parent)
         }
         else if (parser.match(u"/>", true)) {
             // Found end of standalone tag, without children.
+            selfClosing = true;
             return true;
         }
         else if (parser.parseXMLName(attrName)) {
@@ -950,16 +952,14 @@ bool ts::xml::Element::parseNode(TextParser& parser, const Node* parent)
     if (!ok) {
         UString ignored;
         parser.parseText(ignored, u">", true, false);
-        return false;
-    }
-
-    // End of tag, swallow all children.
-    if (!parseChildren(parser)) {
-        return false;
     }
+    return ok;
+}
 
-    // We now must be at "</tag>".
-    ok = parser.match(u"</", true);
+bool ts::xml::Element::parseClosingTag(TextParser& parser)
+{
+    // We must be at "</tag>".
+    bool ok = parser.match(u"</", true);
     if (ok) {
         UString endTag;
         ok = parser.skipWhiteSpace() && parser.parseXMLName(endTag) && parser.skipWhiteSpace() && endTag.similar(value());
@@ -972,3 +972,20 @@ bool ts::xml::Element::parseNode(TextParser& parser, const Node* parent)
 
     return ok;
 }
+
+bool ts::xml::Element::parseNode(TextParser& parser, const Node* parent)
+{
+    // Read the start tag, with attributes.
+    bool selfClosing = false;
+    if (!parseTag(parser, selfClosing)) {
+        return false;
+    }
+
+    // A standalone tag has no children and no closing tag.
+    if (selfClosing) {
+        return true;
+    }
+
+    // End of tag, swallow all children, then the closing tag.
+    return parseChildren(parser) && parseClosingTag(parser);
+}
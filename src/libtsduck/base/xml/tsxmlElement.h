@@ -857,9 +857,19 @@ namespace ts {
             virtual bool parseNode(TextParser& parser, const Node* parent) override;
 
         private:
+            // The streaming document parser parses the start and closing tags separately.
+            friend class StreamingDocument;
+
             CaseSensitivity _attributeCase {CASE_INSENSITIVE}; // For attribute names.
             AttributeMap _attributes {};
 
+            // Parse the start tag, after the initial "<", including the attributes.
+            // On return, selfClosing is true when the tag ends with "/>" (no children).
+            bool parseTag(TextParser& parser, bool& selfClosing);
+
+            // Parse the closing tag "</name>" of this element.
+            bool parseClosingTag(TextParser& parser);
+
             // Compute the key in the attribute map.
             UString attributeKey(const UString& attributeName) const;
 
@@ -33,6 +33,18 @@ ts::xml::ModelDocument::~ModelDocument()
 }
 
 
+//----------------------------------------------------------------------------
+// Clear the content of the document.
+//----------------------------------------------------------------------------
+
+void ts::xml::ModelDocument::clear()
+{
+    // The cached element pointers become dangling when the tree is dropped.
+    _model_cache.clear();
+    Document::clear();
+}
+
+
 
 //----------------------------------------------------------------------------
 // Validate an XML document.
@@ -61,6 +73,36 @@ bool ts::xml::ModelDocument::validate(const Document& doc) const
 }
 
 
+//----------------------------------------------------------------------------
+// Validate one element of an XML document against a child of the model root.
+//----------------------------------------------------------------------------
+
+bool ts::xml::ModelDocument::validateChildOfRoot(const UString& rootName, const Element* elem) const
+{
+    const Element* modelRoot = rootElement();
+
+    if (modelRoot == nullptr) {
+        report().error(u"invalid XML model, no root element");
+        return false;
+    }
+    else if (elem == nullptr) {
+        report().error(u"invalid XML document");
+        return false;
+    }
+    else if (!modelRoot->name().similar(rootName)) {
+        report().error(u"invalid XML document, expected <%s> as root, found <%s>", {modelRoot->name(), rootName});
+        return false;
+    }
+
+    const Element* modelChild = findModelElement(modelRoot, elem->name());
+    if (modelChild == nullptr) {
+        report().error(u"unexpected node <%s> in <%s>, line %d", {elem->name(), rootName, elem->lineNumber()});
+        return false;
+    }
+    return validateElement(modelChild, elem);
+}
+
+
 //----------------------------------------------------------------------------
 // Validate an XML tree of elements, used by validate().
 //----------------------------------------------------------------------------
@@ -121,6 +163,27 @@ const ts::xml::Element* ts::xml::ModelDocument::findModelElement(const Element*
         return nullptr;
     }
 
+    // Lookup the resolution cache first. The same names are looked up over and
+    // over in the same model elements when similar table structures are repeated
+    // across documents. Names are case-insensitive, normalize the cache key.
+    const auto key = std::make_pair(elem, name.toLower());
+    const auto hit = _model_cache.find(key);
+    if (hit != _model_cache.end()) {
+        return hit->second;
+    }
+
+    const Element* result = searchModelElement(elem, name);
+    _model_cache[key] = result;
+    return result;
+}
+
+
+//----------------------------------------------------------------------------
+// Search a child element by name in an XML model element, without cache.
+//----------------------------------------------------------------------------
+
+const ts::xml::Element* ts::xml::ModelDocument::searchModelElement(const Element* elem, const UString& name) const
+{
     // Loop on all children.
     for (const Element* child = elem->firstChildElement(); child != nullptr; child = child->nextSiblingElement()) {
         if (name.similar(child->name())) {
@@ -50,6 +50,22 @@ namespace ts {
             //!
             bool validate(const Document& doc) const;
 
+            //!
+            //! Validate one element of an XML document against a child of the model root.
+            //! This is typically used when a document is processed one element at a time
+            //! with a StreamingDocument, instead of being validated globally.
+            //! @param [in] rootName Name of the root element of the document to validate.
+            //! @param [in] elem The element to validate, supposedly a child of the root.
+            //! @return True if @a elem matches the model in this object, false if it does not.
+            //!
+            bool validateChildOfRoot(const UString& rootName, const Element* elem) const;
+
+            //!
+            //! Clear the content of the document.
+            //! Also clear the model element resolution cache.
+            //!
+            virtual void clear() override;
+
         protected:
             //!
             //! Find a child element by name in an XML model element.
@@ -67,6 +83,22 @@ namespace ts {
             //! @return True if @a doc matches @a model, false if it does not.
             //!
             bool validateElement(const Element* model, const Element* doc) const;
+
+            //!
+            //! Search a child element by name in an XML model element, without cache.
+            //! @param [in] elem An XML element in a model document.
+            //! @param [in] name Name of the child element to search.
+            //! @return Address of the child model or zero if not found.
+            //!
+            const Element* searchModelElement(const Element* elem, const UString& name) const;
+
+            // Cache of model element resolutions. Documents which are validated against
+            // the same model endlessly look up the same child names in the same model
+            // elements, including through "_any in=..." indirections. Cache the result,
+            // including negative ones. The cache is cleared when the model is reloaded.
+            // Like the rest of the document, this is not thread-safe.
+            typedef std::map<std::pair<const Element*, UString>, const Element*> ModelElementCache;
+            mutable ModelElementCache _model_cache {};
         };
     }
 }
@@ -345,6 +345,9 @@ namespace ts {
             virtual bool parseChildren(TextParser& parser);
 
         private:
+            // The streaming document parser uses the low-level parsing primitives.
+            friend class StreamingDocument;
+
             Report& _report;                // Where to report errors.
             UString _value {};              // Value of the node, depend on the node type.
             Node*   _parent = nullptr;      // Parent node, null for a document.
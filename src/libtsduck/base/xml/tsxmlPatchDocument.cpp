@@ -42,6 +42,31 @@ void ts::xml::PatchDocument::patch(Document& doc) const
 }
 
 
+//----------------------------------------------------------------------------
+// Fast check if this patch may alter a top-level element of a document.
+//----------------------------------------------------------------------------
+
+bool ts::xml::PatchDocument::canPatch(const UString& name) const
+{
+    const Element* root = rootElement();
+    if (root == nullptr) {
+        // Empty patch document, cannot patch anything.
+        return false;
+    }
+    if (root->hasAttribute(X_NODE_ATTR)) {
+        // An "x-node" attribute on the root may delete the complete document.
+        return true;
+    }
+    for (const Element* child = root->firstChildElement(); child != nullptr; child = child->nextSiblingElement()) {
+        // A node to add is inserted in all documents. Otherwise, the names must match.
+        if (child->hasAttribute(X_NODE_ATTR, u"add") || name.similar(child->name())) {
+            return true;
+        }
+    }
+    return false;
+}
+
+
 //----------------------------------------------------------------------------
 // Patch an XML tree of elements.
 //----------------------------------------------------------------------------
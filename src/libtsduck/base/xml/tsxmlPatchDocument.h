@@ -45,6 +45,17 @@ namespace ts {
             //!
             void patch(Document& doc) const;
 
+            //!
+            //! Fast check if this patch may alter a top-level element of a document.
+            //! The check is based on element names only. It may return true for elements
+            //! which are eventually left unmodified by patch() but it never returns false
+            //! for an element which would be modified.
+            //! @param [in] name Name of an element, directly below the root of the documents to patch.
+            //! @return True if the patch may modify or delete an element with that @a name
+            //! or add new elements next to it, false if such an element cannot be altered.
+            //!
+            bool canPatch(const UString& name) const;
+
         private:
             // Patch an XML tree of elements.
             // Return true when processing of the doc node may continue, false if it has been deleted.
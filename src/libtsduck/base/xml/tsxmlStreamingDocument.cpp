@@ -0,0 +1,179 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsxmlStreamingDocument.h"
+#include "tsxmlElement.h"
+#include "tsxmlComment.h"
+#include "tsFileUtils.h"
+
+
+//----------------------------------------------------------------------------
+// Constructors and destructors.
+//----------------------------------------------------------------------------
+
+ts::xml::StreamingDocument::StreamingDocument(Report& report) :
+    Document(report),
+    _parser(report)
+{
+}
+
+ts::xml::StreamingDocument::~StreamingDocument()
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Open and parse the document up to the start tag of the root element.
+//----------------------------------------------------------------------------
+
+ts::xml::Element* ts::xml::StreamingDocument::open(const UString& fileName, bool search)
+{
+    // Specific case of inline XML content, when the string is not the name of a file but directly an XML content.
+    if (IsInlineXML(fileName)) {
+        _parser.loadDocument(fileName);
+        return openParser();
+    }
+
+    // Specific case of the standard input.
+    if (fileName.empty() || fileName == u"-") {
+        return open(std::cin);
+    }
+
+    // Actual file name to load after optional search in directories.
+    const UString actualFileName(search ? SearchConfigurationFile(fileName) : fileName);
+
+    // Eliminate non-existent files.
+    if (actualFileName.empty()) {
+        report().error(u"file not found: %s", {fileName});
+        return nullptr;
+    }
+
+    // Parse the document from the file.
+    report().debug(u"loading XML file %s", {actualFileName});
+    return _parser.loadFile(actualFileName) ? openParser() : nullptr;
+}
+
+ts::xml::Element* ts::xml::StreamingDocument::open(std::istream& strm)
+{
+    return _parser.loadStream(strm) ? openParser() : nullptr;
+}
+
+
+//----------------------------------------------------------------------------
+// Common part of open(): parse up to the start tag of the root element.
+//----------------------------------------------------------------------------
+
+ts::xml::Element* ts::xml::StreamingDocument::openParser()
+{
+    // Cleanup all previous content of the document.
+    clear();
+    _root = nullptr;
+    _root_closed = false;
+    _error = false;
+
+    // Parse the leading declarations and comments, up to the root element.
+    Node* node = nullptr;
+    while (_root == nullptr && (node = identifyNextNode(_parser)) != nullptr) {
+        Element* elem = dynamic_cast<Element*>(node);
+        if (elem != nullptr) {
+            // Found the root element, parse its start tag only, not its children.
+            bool selfClosing = false;
+            if (!elem->parseTag(_parser, selfClosing)) {
+                delete elem;
+                _error = true;
+                return nullptr;
+            }
+            elem->reparent(this);
+            _root = elem;
+            _root_closed = selfClosing;
+        }
+        else if (node->parseNode(_parser, this)) {
+            node->reparent(this);
+        }
+        else {
+            // Error, we expect the child's parser to have displayed the error message.
+            delete node;
+            _error = true;
+            return nullptr;
+        }
+    }
+
+    // Check presence of root element.
+    if (_root == nullptr) {
+        report().error(u"invalid XML document, no root element found");
+        _error = true;
+    }
+    return _root;
+}
+
+
+//----------------------------------------------------------------------------
+// Parse the next element under the root element.
+//----------------------------------------------------------------------------
+
+ts::xml::Element* ts::xml::StreamingDocument::nextElement()
+{
+    while (_root != nullptr && !_root_closed && !_error) {
+
+        // Identify the next child of the root.
+        Node* node = _root->identifyNextNode(_parser);
+        if (node == nullptr) {
+            // End of the root's children, parse the root closing tag.
+            _root_closed = true;
+            _error = !_root->parseClosingTag(_parser);
+            return nullptr;
+        }
+
+        // Read the complete node, including its own children.
+        if (!node->parseNode(_parser, _root)) {
+            // Error, we expect the child's parser to have displayed the error message.
+            delete node;
+            _error = true;
+            return nullptr;
+        }
+
+        Element* elem = dynamic_cast<Element*>(node);
+        if (elem != nullptr) {
+            // Found an element, the caller will typically delete it after use.
+            elem->reparent(_root);
+            return elem;
+        }
+
+        // Texts and comments between elements are not significant, free them now.
+        delete node;
+    }
+    return nullptr;
+}
+
+
+//----------------------------------------------------------------------------
+// Close the document.
+//----------------------------------------------------------------------------
+
+bool ts::xml::StreamingDocument::close()
+{
+    if (_root == nullptr || _error || !_root_closed) {
+        return false;
+    }
+
+    // Only comments (and insignificant spaces) may remain after the root element.
+    Node* node = nullptr;
+    while ((node = identifyNextNode(_parser)) != nullptr) {
+        const bool ok = node->parseNode(_parser, this) && dynamic_cast<Comment*>(node) != nullptr;
+        delete node;
+        if (!ok) {
+            report().error(u"invalid XML document, need one single root element");
+            return false;
+        }
+    }
+    if (!_parser.eof()) {
+        report().error(u"line %d: trailing character sequence, invalid XML document", {_parser.lineNumber()});
+        return false;
+    }
+    return true;
+}
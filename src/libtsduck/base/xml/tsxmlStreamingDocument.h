@@ -0,0 +1,94 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Representation of a "streaming" XML document which is parsed on the fly.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsxmlDocument.h"
+
+namespace ts {
+    namespace xml {
+        //!
+        //! Representation of a "streaming" XML document which is parsed on the fly.
+        //! @ingroup xml
+        //!
+        //! This is the input counterpart of RunningDocument. The idea is to process
+        //! an arbitrary long XML document one element at a time, without building
+        //! the complete node tree in memory. The document is opened and parsed up
+        //! to the start tag of the root element. Then, each child element of the
+        //! root is parsed, returned to the caller and typically deleted after use.
+        //! The memory usage stays proportional to one element, not the document
+        //! (the raw document text, however, is held in memory by the parser).
+        //!
+        class TSDUCKDLL StreamingDocument: public Document
+        {
+            TS_NOCOPY(StreamingDocument);
+        public:
+            //!
+            //! Constructor.
+            //! @param [in,out] report Where to report errors.
+            //!
+            explicit StreamingDocument(Report& report = NULLREP);
+
+            //!
+            //! Destructor.
+            //!
+            virtual ~StreamingDocument() override;
+
+            //!
+            //! Open and parse the document up to the start tag of the root element.
+            //! The leading declarations and comments are parsed and kept in the document.
+            //! @param [in] fileName Name of the file to parse. If the file name is empty or "-",
+            //! the standard input is used. If the file name starts with "&lt;?xml", this is an
+            //! inline XML content, not a file name.
+            //! @param [in] search If true, use a search algorithm for the XML file.
+            //! @see SearchConfigurationFile()
+            //! @return The root element of the document, with its attributes but without
+            //! children, or a null pointer on error.
+            //!
+            Element* open(const UString& fileName, bool search = false);
+
+            //!
+            //! Open and parse the document from a stream up to the start tag of the root element.
+            //! @param [in,out] strm A standard text stream in input mode.
+            //! @return The root element of the document, with its attributes but without
+            //! children, or a null pointer on error.
+            //!
+            Element* open(std::istream& strm);
+
+            //!
+            //! Parse the next element under the root element.
+            //! Texts and comments between elements are not significant and are discarded.
+            //! The returned element is completely parsed, with all its children.
+            //! It is linked as a child of the root but the caller should delete it
+            //! after use to keep the memory usage low.
+            //! @return The next element or a null pointer at end of document or on error.
+            //!
+            Element* nextElement();
+
+            //!
+            //! Close the document.
+            //! Verify that the complete document was parsed up to the end.
+            //! @return True when the complete document was successfully parsed.
+            //!
+            bool close();
+
+        private:
+            TextParser _parser;             // The document parser.
+            Element*   _root = nullptr;     // Root element, child of this document.
+            bool       _root_closed = false;// The root closing tag was parsed.
+            bool       _error = false;      // A parsing error occurred.
+
+            // Common part of open(): parse up to the start tag of the root element.
+            Element* openParser();
+        };
+    }
+}
@@ -190,3 +190,103 @@ void ts::AES::decryptAccel(const uint8_t* ct, uint8_t* pt)
     assert(false);
 #endif
 }
+
+
+//----------------------------------------------------------------------------
+// Accelerated multi-block encryption in ECB mode.
+//----------------------------------------------------------------------------
+
+void ts::AES::encryptBlocksAccel(const uint8_t* pt, uint8_t* ct, size_t count)
+{
+#if defined(TS_ARM_AES_INSTRUCTIONS)
+    const Acceleration& accel(*_accel);
+    const int last = _nrounds - 1;
+
+    // Process 4 blocks at a time. The AES instructions have a multi-cycle
+    // latency but are pipelined: interleaving 4 independent blocks keeps the
+    // AES unit busy instead of waiting for each block to complete.
+    while (count >= 4) {
+        uint8x16_t b0 = vld1q_u8(pt);
+        uint8x16_t b1 = vld1q_u8(pt + 16);
+        uint8x16_t b2 = vld1q_u8(pt + 32);
+        uint8x16_t b3 = vld1q_u8(pt + 48);
+        for (int r = 0; r < last; ++r) {
+            b0 = vaesmcq_u8(vaeseq_u8(b0, accel.eK[r]));
+            b1 = vaesmcq_u8(vaeseq_u8(b1, accel.eK[r]));
+            b2 = vaesmcq_u8(vaeseq_u8(b2, accel.eK[r]));
+            b3 = vaesmcq_u8(vaeseq_u8(b3, accel.eK[r]));
+        }
+        b0 = veorq_u8(vaeseq_u8(b0, accel.eK[last]), accel.eK[last + 1]);
+        b1 = veorq_u8(vaeseq_u8(b1, accel.eK[last]), accel.eK[last + 1]);
+        b2 = veorq_u8(vaeseq_u8(b2, accel.eK[last]), accel.eK[last + 1]);
+        b3 = veorq_u8(vaeseq_u8(b3, accel.eK[last]), accel.eK[last + 1]);
+        vst1q_u8(ct, b0);
+        vst1q_u8(ct + 16, b1);
+        vst1q_u8(ct + 32, b2);
+        vst1q_u8(ct + 48, b3);
+        pt += 64;
+        ct += 64;
+        count -= 4;
+    }
+
+    // Process the remaining blocks one by one.
+    while (count > 0) {
+        encryptAccel(pt, ct);
+        pt += 16;
+        ct += 16;
+        count--;
+    }
+#else
+    // Shall not be called.
+    assert(false);
+#endif
+}
+
+
+//----------------------------------------------------------------------------
+// Accelerated multi-block decryption in ECB mode.
+//----------------------------------------------------------------------------
+
+void ts::AES::decryptBlocksAccel(const uint8_t* ct, uint8_t* pt, size_t count)
+{
+#if defined(TS_ARM_AES_INSTRUCTIONS)
+    const Acceleration& accel(*_accel);
+    const int last = _nrounds - 1;
+
+    // Same 4-block interleaving as encryptBlocksAccel().
+    while (count >= 4) {
+        uint8x16_t b0 = vld1q_u8(ct);
+        uint8x16_t b1 = vld1q_u8(ct + 16);
+        uint8x16_t b2 = vld1q_u8(ct + 32);
+        uint8x16_t b3 = vld1q_u8(ct + 48);
+        for (int r = 0; r < last; ++r) {
+            b0 = vaesimcq_u8(vaesdq_u8(b0, accel.dK[r]));
+            b1 = vaesimcq_u8(vaesdq_u8(b1, accel.dK[r]));
+            b2 = vaesimcq_u8(vaesdq_u8(b2, accel.dK[r]));
+            b3 = vaesimcq_u8(vaesdq_u8(b3, accel.dK[r]));
+        }
+        b0 = veorq_u8(vaesdq_u8(b0, accel.dK[last]), accel.dK[last + 1]);
+        b1 = veorq_u8(vaesdq_u8(b1, accel.dK[last]), accel.dK[last + 1]);
+        b2 = veorq_u8(vaesdq_u8(b2, accel.dK[last]), accel.dK[last + 1]);
+        b3 = veorq_u8(vaesdq_u8(b3, accel.dK[last]), accel.dK[last + 1]);
+        vst1q_u8(pt, b0);
+        vst1q_u8(pt + 16, b1);
+        vst1q_u8(pt + 32, b2);
+        vst1q_u8(pt + 48, b3);
+        ct += 64;
+        pt += 64;
+        count -= 4;
+    }
+
+    // Process the remaining blocks one by one.
+    while (count > 0) {
+        decryptAccel(ct, pt);
+        ct += 16;
+        pt += 16;
+        count--;
+    }
+#else
+    // Shall not be called.
+    assert(false);
+#endif
+}
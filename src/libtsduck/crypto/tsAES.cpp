@@ -17,11 +17,16 @@
 #include "tsByteSwap.h"
 #include "tsRotate.h"
 #include "tsSysInfo.h"
+#include "tsMonotonic.h"
 
 // Runtime check once if accelerated AES instructions are supported on this CPU.
 volatile bool ts::AES::_accel_checked = false;
 volatile bool ts::AES::_accel_supported = false;
 
+// Runtime check once if the kernel crypto engine is worth using.
+volatile bool ts::AES::_kernel_checked = false;
+volatile bool ts::AES::_kernel_preferred = false;
+
 
 //----------------------------------------------------------------------------
 // Constructor and destructor.
@@ -874,10 +879,59 @@ bool ts::AES::setKeyImpl(const void* key_data, size_t key_length, size_t rounds)
         setKeyAccel();
     }
 
+    // Kernel crypto engine (Linux AF_ALG): worth considering only when the CPU
+    // has no AES instructions. The first key schedule in the process runs a
+    // benchmark of the kernel engine against the software implementation and
+    // the fastest wins for bulk multi-block operations.
+    if (!_accel_supported) {
+        if (!_kernel_checked) {
+            _kernel_preferred = AFALGCipher::IsSupported() && kernelIsFaster(key_data, key_length);
+            _kernel_checked = true;
+        }
+        if (!_kernel_preferred || !_kernel.open("ecb(aes)", key_data, key_length)) {
+            // Engine not preferred or no longer available, use the software path.
+            _kernel.close();
+        }
+    }
+
     return true;
 }
 
 
+//----------------------------------------------------------------------------
+// One-shot startup benchmark, kernel engine vs. software implementation.
+//----------------------------------------------------------------------------
+
+bool ts::AES::kernelIsFaster(const void* key, size_t key_length)
+{
+    // Encrypt the same buffer with the kernel engine and with the software
+    // implementation (the key is scheduled at this point) and compare the
+    // elapsed times. The buffer is large enough to amortize the system call
+    // cost of the kernel engine, as bulk operations later do.
+    constexpr size_t block_count = 8192; // 128 kB
+
+    AFALGCipher probe;
+    if (!probe.open("ecb(aes)", key, key_length)) {
+        return false;
+    }
+
+    const ByteBlock input(block_count * BLOCK_SIZE, 0xA5);
+    ByteBlock output(block_count * BLOCK_SIZE);
+
+    const Monotonic start(true);
+    if (!probe.transform(true, input.data(), output.data(), input.size())) {
+        return false;
+    }
+    const Monotonic middle(true);
+    if (!BlockCipher::encryptBlocksImpl(input.data(), output.data(), block_count)) {
+        return false;
+    }
+    const Monotonic end(true);
+
+    return middle - start < end - middle;
+}
+
+
 //----------------------------------------------------------------------------
 // Encryption in ECB mode.
 //----------------------------------------------------------------------------
@@ -939,6 +993,45 @@ bool ts::AES::encryptImpl(const void* plain, size_t plain_length, void* cipher,
 }
 
 
+//----------------------------------------------------------------------------
+// Multi-block encryption and decryption in ECB mode.
+//----------------------------------------------------------------------------
+
+bool ts::AES::encryptBlocksImpl(const uint8_t* plain, uint8_t* cipher, size_t block_count)
+{
+    if (_accel_supported) {
+        // The accelerated version pipelines several independent blocks.
+        encryptBlocksAccel(plain, cipher, block_count);
+        return true;
+    }
+    if (_kernel.isOpen() && block_count >= KERNEL_MIN_BLOCKS) {
+        // The kernel engine amortizes its system call cost on large batches only.
+        // On kernel failure, fall back to the software path.
+        if (_kernel.transform(true, plain, cipher, block_count * BLOCK_SIZE)) {
+            return true;
+        }
+    }
+    return BlockCipher::encryptBlocksImpl(plain, cipher, block_count);
+}
+
+bool ts::AES::decryptBlocksImpl(const uint8_t* cipher, uint8_t* plain, size_t block_count)
+{
+    if (_accel_supported) {
+        // The accelerated version pipelines several independent blocks.
+        decryptBlocksAccel(cipher, plain, block_count);
+        return true;
+    }
+    if (_kernel.isOpen() && block_count >= KERNEL_MIN_BLOCKS) {
+        // The kernel engine amortizes its system call cost on large batches only.
+        // On kernel failure, fall back to the software path.
+        if (_kernel.transform(false, cipher, plain, block_count * BLOCK_SIZE)) {
+            return true;
+        }
+    }
+    return BlockCipher::decryptBlocksImpl(cipher, plain, block_count);
+}
+
+
 //----------------------------------------------------------------------------
 // Decryption in ECB mode.
 //----------------------------------------------------------------------------
@@ -13,6 +13,7 @@
 
 #pragma once
 #include "tsBlockCipher.h"
+#include "tsAFALGCipher.h"
 
 namespace ts {
     //!
@@ -47,6 +48,8 @@ namespace ts {
         virtual bool setKeyImpl(const void* key, size_t key_length, size_t rounds) override;
         virtual bool encryptImpl(const void* plain, size_t plain_length, void* cipher, size_t cipher_maxsize, size_t* cipher_length) override;
         virtual bool decryptImpl(const void* cipher, size_t cipher_length, void* plain, size_t plain_maxsize, size_t* plain_length) override;
+        virtual bool encryptBlocksImpl(const uint8_t* plain, uint8_t* cipher, size_t block_count) override;
+        virtual bool decryptBlocksImpl(const uint8_t* cipher, uint8_t* plain, size_t block_count) override;
 
     private:
         class Acceleration;
@@ -60,11 +63,26 @@ namespace ts {
         static volatile bool _accel_checked;
         static volatile bool _accel_supported;
 
+        // Kernel crypto engine (Linux AF_ALG), used for bulk multi-block operations
+        // when the CPU has no AES instructions and the kernel engine benchmarks
+        // faster than the software implementation (hardware crypto engines on some
+        // ARM SoC's are only reachable through the kernel).
+        AFALGCipher _kernel {};
+        static constexpr size_t KERNEL_MIN_BLOCKS = 64;  // Below this, the syscall cost dominates.
+        static volatile bool _kernel_checked;
+        static volatile bool _kernel_preferred;
+
+        // One-shot startup benchmark, kernel engine vs. software implementation.
+        // Must be called with a scheduled key (at the end of setKeyImpl()).
+        bool kernelIsFaster(const void* key, size_t key_length);
+
         // Accelerated versions, compiled in a separated module.
         static Acceleration* newAccel();
         static void deleteAccel(Acceleration*);
         void setKeyAccel();
         void encryptAccel(const uint8_t* pt, uint8_t* ct);
         void decryptAccel(const uint8_t* ct, uint8_t* pt);
+        void encryptBlocksAccel(const uint8_t* pt, uint8_t* ct, size_t count);
+        void decryptBlocksAccel(const uint8_t* ct, uint8_t* pt, size_t count);
     };
 }
@@ -0,0 +1,171 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsAFALGCipher.h"
+
+#if defined(TS_LINUX)
+    #include "tsBeforeStandardHeaders.h"
+    #include <sys/socket.h>
+    #include <linux/if_alg.h>
+    #include <unistd.h>
+    #include "tsAfterStandardHeaders.h"
+    #if !defined(SOL_ALG)
+        #define SOL_ALG 279
+    #endif
+#endif
+
+
+//----------------------------------------------------------------------------
+// Destructor.
+//----------------------------------------------------------------------------
+
+ts::AFALGCipher::~AFALGCipher()
+{
+    close();
+}
+
+
+//----------------------------------------------------------------------------
+// Check once if the kernel crypto API is available on this system.
+//----------------------------------------------------------------------------
+
+bool ts::AFALGCipher::IsSupported()
+{
+#if defined(TS_LINUX)
+    // Try to bind an AF_ALG socket to an AES transform. This fails when the
+    // kernel was built without the crypto userspace API or without AES.
+    const int fd = ::socket(AF_ALG, SOCK_SEQPACKET, 0);
+    if (fd < 0) {
+        return false;
+    }
+    ::sockaddr_alg sa;
+    std::memset(&sa, 0, sizeof(sa));
+    sa.salg_family = AF_ALG;
+    std::strcpy(reinterpret_cast<char*>(sa.salg_type), "skcipher");
+    std::strcpy(reinterpret_cast<char*>(sa.salg_name), "ecb(aes)");
+    const bool ok = ::bind(fd, reinterpret_cast<::sockaddr*>(&sa), sizeof(sa)) == 0;
+    ::close(fd);
+    return ok;
+#else
+    return false;
+#endif
+}
+
+
+//----------------------------------------------------------------------------
+// Open a kernel cipher transform and set the key.
+//----------------------------------------------------------------------------
+
+bool ts::AFALGCipher::open(const char* algo, const void* key, size_t key_length)
+{
+#if defined(TS_LINUX)
+    close();
+
+    if ((_alg_fd = ::socket(AF_ALG, SOCK_SEQPACKET, 0)) < 0) {
+        return false;
+    }
+
+    ::sockaddr_alg sa;
+    std::memset(&sa, 0, sizeof(sa));
+    sa.salg_family = AF_ALG;
+    std::strcpy(reinterpret_cast<char*>(sa.salg_type), "skcipher");
+    std::strncpy(reinterpret_cast<char*>(sa.salg_name), algo, sizeof(sa.salg_name) - 1);
+
+    if (::bind(_alg_fd, reinterpret_cast<::sockaddr*>(&sa), sizeof(sa)) < 0 ||
+        ::setsockopt(_alg_fd, SOL_ALG, ALG_SET_KEY, key, ::socklen_t(key_length)) < 0 ||
+        (_op_fd = ::accept(_alg_fd, nullptr, nullptr)) < 0)
+    {
+        close();
+        return false;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+
+//----------------------------------------------------------------------------
+// Close the kernel transform.
+//----------------------------------------------------------------------------
+
+void ts::AFALGCipher::close()
+{
+#if defined(TS_LINUX)
+    if (_op_fd >= 0) {
+        ::close(_op_fd);
+        _op_fd = -1;
+    }
+    if (_alg_fd >= 0) {
+        ::close(_alg_fd);
+        _alg_fd = -1;
+    }
+#endif
+}
+
+
+//----------------------------------------------------------------------------
+// Encrypt or decrypt a batch of data.
+//----------------------------------------------------------------------------
+
+bool ts::AFALGCipher::transform(bool encrypt, const uint8_t* input, uint8_t* output, size_t size)
+{
+#if defined(TS_LINUX)
+    if (_op_fd < 0) {
+        return false;
+    }
+
+    // Maximum size of one kernel request. The kernel bounds one AF_ALG request
+    // to a few pages (ALG_MAX_PAGES = 16). Larger batches are split here, the
+    // system call cost remains amortized over 64 kB of data per request.
+    static constexpr size_t CHUNK_SIZE = 16 * 4096;
+
+    while (size > 0) {
+        const size_t len = std::min(size, CHUNK_SIZE);
+
+        // One request: the control part selects the operation, the data part
+        // carries all input bytes of the chunk at once.
+        alignas(::cmsghdr) uint8_t cbuf[CMSG_SPACE(sizeof(uint32_t))] = {0};
+        ::iovec iov;
+        iov.iov_base = const_cast<uint8_t*>(input);
+        iov.iov_len = len;
+        ::msghdr msg;
+        std::memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = cbuf;
+        msg.msg_controllen = sizeof(cbuf);
+        ::cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_ALG;
+        cmsg->cmsg_type = ALG_SET_OP;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(uint32_t));
+        *reinterpret_cast<uint32_t*>(CMSG_DATA(cmsg)) = encrypt ? ALG_OP_ENCRYPT : ALG_OP_DECRYPT;
+
+        if (::sendmsg(_op_fd, &msg, 0) != ::ssize_t(len)) {
+            return false;
+        }
+
+        // Read back the transformed data of the chunk.
+        size_t received = 0;
+        while (received < len) {
+            const ::ssize_t ret = ::read(_op_fd, output + received, len - received);
+            if (ret <= 0) {
+                return false;
+            }
+            received += size_t(ret);
+        }
+
+        input += len;
+        output += len;
+        size -= len;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,89 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Symmetric cipher using the Linux kernel crypto API (AF_ALG).
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsPlatform.h"
+
+namespace ts {
+    //!
+    //! Symmetric cipher using the Linux kernel crypto API (AF_ALG).
+    //! @ingroup crypto
+    //!
+    //! This class gives access to the kernel "skcipher" transforms through
+    //! an AF_ALG socket. On platforms with a hardware crypto engine which is
+    //! only reachable through the kernel (some ARM SoC's typically), this can
+    //! be much faster than a software implementation for bulk operations.
+    //! Each request has a fixed system call cost, so the data shall be
+    //! submitted in large batches; transform() internally splits the data
+    //! into requests of the maximum size the kernel accepts.
+    //!
+    //! On non-Linux platforms, all methods fail.
+    //!
+    class TSDUCKDLL AFALGCipher
+    {
+        TS_NOCOPY(AFALGCipher);
+    public:
+        //!
+        //! Constructor.
+        //! The object is unusable until open() succeeds.
+        //!
+        AFALGCipher() = default;
+
+        //!
+        //! Destructor.
+        //!
+        ~AFALGCipher();
+
+        //!
+        //! Check once if the kernel crypto API is available on this system.
+        //! @return True when AF_ALG sockets with AES transforms can be created.
+        //!
+        static bool IsSupported();
+
+        //!
+        //! Open a kernel cipher transform and set the key.
+        //! Any previously open transform is closed first.
+        //! @param [in] algo Kernel name of the skcipher transform, eg. "ecb(aes)".
+        //! @param [in] key Address of key value.
+        //! @param [in] key_length Key length in bytes.
+        //! @return True on success, false on error.
+        //!
+        bool open(const char* algo, const void* key, size_t key_length);
+
+        //!
+        //! Check if a kernel transform is open.
+        //! @return True if open() succeeded and close() was not called.
+        //!
+        bool isOpen() const { return _op_fd >= 0; }
+
+        //!
+        //! Encrypt or decrypt a batch of data.
+        //! The data size must be a multiple of the block size of the algorithm.
+        //! @param [in] encrypt True to encrypt, false to decrypt.
+        //! @param [in] input Address of input data.
+        //! @param [out] output Address of buffer for output data, same size as the input.
+        //! @param [in] size Size in bytes of the input and output data.
+        //! @return True on success, false on error.
+        //!
+        bool transform(bool encrypt, const uint8_t* input, uint8_t* output, size_t size);
+
+        //!
+        //! Close the kernel transform.
+        //!
+        void close();
+
+    private:
+        int _alg_fd = -1;  // AF_ALG transform socket, carries the algorithm and the key.
+        int _op_fd = -1;   // Operation socket, from accept(), carries the requests.
+    };
+}
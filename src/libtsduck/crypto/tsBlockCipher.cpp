@@ -120,6 +120,65 @@ bool ts::BlockCipher::decrypt(const void* cipher, size_t cipher_length, void* pl
 }
 
 
+//----------------------------------------------------------------------------
+// Encrypt or decrypt several independent blocks of data (ECB-style).
+//----------------------------------------------------------------------------
+
+bool ts::BlockCipher::encryptBlocks(const void* plain, void* cipher, size_t block_count)
+{
+    if (block_count == 0) {
+        return true;
+    }
+    if (!allowEncrypt()) {
+        return false;
+    }
+    // One multi-block operation counts as one key usage per encrypted block.
+    _key_encrypt_count += block_count - 1;
+    return encryptBlocksImpl(reinterpret_cast<const uint8_t*>(plain), reinterpret_cast<uint8_t*>(cipher), block_count);
+}
+
+bool ts::BlockCipher::decryptBlocks(const void* cipher, void* plain, size_t block_count)
+{
+    if (block_count == 0) {
+        return true;
+    }
+    if (!allowDecrypt()) {
+        return false;
+    }
+    // One multi-block operation counts as one key usage per decrypted block.
+    _key_decrypt_count += block_count - 1;
+    return decryptBlocksImpl(reinterpret_cast<const uint8_t*>(cipher), reinterpret_cast<uint8_t*>(plain), block_count);
+}
+
+bool ts::BlockCipher::encryptBlocksImpl(const uint8_t* plain, uint8_t* cipher, size_t block_count)
+{
+    const size_t bsize = blockSize();
+    while (block_count > 0) {
+        if (!encryptImpl(plain, bsize, cipher, bsize, nullptr)) {
+            return false;
+        }
+        plain += bsize;
+        cipher += bsize;
+        block_count--;
+    }
+    return true;
+}
+
+bool ts::BlockCipher::decryptBlocksImpl(const uint8_t* cipher, uint8_t* plain, size_t block_count)
+{
+    const size_t bsize = blockSize();
+    while (block_count > 0) {
+        if (!decryptImpl(cipher, bsize, plain, bsize, nullptr)) {
+            return false;
+        }
+        cipher += bsize;
+        plain += bsize;
+        block_count--;
+    }
+    return true;
+}
+
+
 //----------------------------------------------------------------------------
 // Encrypt one block of data in place.
 //----------------------------------------------------------------------------
@@ -134,6 +134,40 @@ namespace ts {
         //!
         bool decrypt(const void* cipher, size_t cipher_length, void* plain, size_t plain_maxsize, size_t* plain_length = nullptr);
 
+        //!
+        //! Encrypt several independent blocks of data (ECB-style).
+        //!
+        //! Each block is encrypted independently of the others, like several
+        //! calls to encrypt() on consecutive blocks. This entry point is used
+        //! by parallelizable chaining modes such as CTR to let the block cipher
+        //! pipeline several independent blocks at once, when the implementation
+        //! supports it. For pure block ciphers only.
+        //!
+        //! @param [in] plain Address of plain text, @a block_count blocks of blockSize() bytes.
+        //! @param [out] cipher Address of buffer for cipher text, same size as the plain text.
+        //! The plain text and cipher text areas shall be either identical or disjoint.
+        //! @param [in] block_count Number of blocks to encrypt.
+        //! @return True on success, false on error.
+        //!
+        bool encryptBlocks(const void* plain, void* cipher, size_t block_count);
+
+        //!
+        //! Decrypt several independent blocks of data (ECB-style).
+        //!
+        //! Each block is decrypted independently of the others, like several
+        //! calls to decrypt() on consecutive blocks. This entry point is used
+        //! by parallelizable chaining modes such as CBC decryption to let the
+        //! block cipher pipeline several independent blocks at once, when the
+        //! implementation supports it. For pure block ciphers only.
+        //!
+        //! @param [in] cipher Address of cipher text, @a block_count blocks of blockSize() bytes.
+        //! @param [out] plain Address of buffer for plain text, same size as the cipher text.
+        //! The plain text and cipher text areas shall be either identical or disjoint.
+        //! @param [in] block_count Number of blocks to decrypt.
+        //! @return True on success, false on error.
+        //!
+        bool decryptBlocks(const void* cipher, void* plain, size_t block_count);
+
         //!
         //! Encrypt one block of data in place.
         //!
@@ -265,6 +299,28 @@ namespace ts {
         //!
         virtual bool decryptImpl(const void* cipher, size_t cipher_length, void* plain, size_t plain_maxsize, size_t* plain_length) = 0;
 
+        //!
+        //! Encrypt several independent blocks of data (implementation of algorithm-specific part).
+        //! The default implementation is to call encryptImpl() on each block.
+        //! A subclass may provide a pipelined multi-block implementation.
+        //! @param [in] plain Address of plain text, @a block_count blocks of blockSize() bytes.
+        //! @param [out] cipher Address of buffer for cipher text, same size as the plain text.
+        //! @param [in] block_count Number of blocks to encrypt.
+        //! @return True on success, false on error.
+        //!
+        virtual bool encryptBlocksImpl(const uint8_t* plain, uint8_t* cipher, size_t block_count);
+
+        //!
+        //! Decrypt several independent blocks of data (implementation of algorithm-specific part).
+        //! The default implementation is to call decryptImpl() on each block.
+        //! A subclass may provide a pipelined multi-block implementation.
+        //! @param [in] cipher Address of cipher text, @a block_count blocks of blockSize() bytes.
+        //! @param [out] plain Address of buffer for plain text, same size as the cipher text.
+        //! @param [in] block_count Number of blocks to decrypt.
+        //! @return True on success, false on error.
+        //!
+        virtual bool decryptBlocksImpl(const uint8_t* cipher, uint8_t* plain, size_t block_count);
+
         //!
         //! Encrypt one block of data in place (implementation of algorithm-specific part).
         //! The default implementation is to call encryptImpl() and copy the data.
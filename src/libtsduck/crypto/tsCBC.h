@@ -31,8 +31,9 @@ namespace ts {
     public:
         //!
         //! Constructor.
+        //! The work buffer holds PARALLEL_BLOCKS blocks for multi-block decryption.
         //!
-        CBC() : CipherChainingTemplate<CIPHER>(1, 1, 1) {}
+        CBC() : CipherChainingTemplate<CIPHER>(1, 1, ts::CipherChaining::PARALLEL_BLOCKS) {}
 
         // Implementation of BlockCipher and CipherChaining interfaces.
         // For some reason, doxygen is unable to automatically inherit the
@@ -148,21 +149,29 @@ bool ts::CBC<CIPHER>::decryptImpl(const void* cipher, size_t cipher_length, void
     const uint8_t* ct = reinterpret_cast<const uint8_t*> (cipher);
     uint8_t* pt = reinterpret_cast<uint8_t*> (plain);
 
+    // Unlike encryption, CBC decryption is parallelizable: the predecessor of
+    // each block is already available in the cipher text. Decrypt chunks of up
+    // to PARALLEL_BLOCKS blocks in one multi-block operation, the block cipher
+    // can pipeline them.
     while (cipher_length > 0) {
+        const size_t chunk = std::min(cipher_length / this->block_size, ts::CipherChaining::PARALLEL_BLOCKS);
         // work = decrypt (cipher-text)
-        if (!this->algo->decrypt(ct, this->block_size, this->work.data(), this->block_size)) {
+        if (!this->algo->decryptBlocks(ct, this->work.data(), chunk)) {
             return false;
         }
-        // plain-text = previous-cipher XOR work
-        for (size_t i = 0; i < this->block_size; ++i) {
-            pt[i] = previous[i] ^ this->work[i];
+        for (size_t b = 0; b < chunk; ++b) {
+            // plain-text = previous-cipher XOR work
+            const uint8_t* const wb = this->work.data() + b * this->block_size;
+            for (size_t i = 0; i < this->block_size; ++i) {
+                pt[i] = previous[i] ^ wb[i];
+            }
+            // previous-cipher = cipher-text
+            previous = ct;
+            // advance one block
+            ct += this->block_size;
+            pt += this->block_size;
         }
-        // previous-cipher = cipher-text
-        previous = ct;
-        // advance one block
-        ct += this->block_size;
-        pt += this->block_size;
-        cipher_length -= this->block_size;
+        cipher_length -= chunk * this->block_size;
     }
 
     return true;
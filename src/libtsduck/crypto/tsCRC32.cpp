@@ -134,3 +134,104 @@ void ts::CRC32::add(const void* data, size_t size)
         }
     }
 }
+
+
+//----------------------------------------------------------------------------
+// Continue the computation over scattered data fragments.
+//----------------------------------------------------------------------------
+
+void ts::CRC32::add(std::initializer_list<Fragment> fragments)
+{
+    for (const auto& frag : fragments) {
+        add(frag.data, frag.size);
+    }
+}
+
+void ts::CRC32::add(const std::vector<Fragment>& fragments)
+{
+    for (const auto& frag : fragments) {
+        add(frag.data, frag.size);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Combine with the CRC32 of a subsequent data area.
+//----------------------------------------------------------------------------
+
+namespace {
+    // The CRC register transformations are linear over GF(2). An operator is
+    // represented by its matrix, one column of 32 bits per input bit.
+
+    // Apply an operator on a register value.
+    uint32_t Gf2Times(const uint32_t* op, uint32_t vec)
+    {
+        uint32_t result = 0;
+        for (size_t i = 0; vec != 0; ++i, vec >>= 1) {
+            if (vec & 1) {
+                result ^= op[i];
+            }
+        }
+        return result;
+    }
+
+    // Square an operator: dst = src * src.
+    void Gf2Square(uint32_t* dst, const uint32_t* src)
+    {
+        for (size_t i = 0; i < 32; ++i) {
+            dst[i] = Gf2Times(src, src[i]);
+        }
+    }
+
+    // Advance the CRC register over a number of zero bits, without new input,
+    // by squaring the one-bit operator (logarithmic on the number of bits).
+    uint32_t AdvanceZeroes(uint32_t crc, uint64_t bits)
+    {
+        // Operator for one zero bit: shift left, reduce by the generator polynomial.
+        uint32_t mat1[32];
+        uint32_t mat2[32];
+        uint32_t* op = mat1;
+        uint32_t* sq = mat2;
+        for (size_t i = 0; i < 31; ++i) {
+            op[i] = uint32_t(1) << (i + 1);
+        }
+        op[31] = 0x04C11DB7; // the FCS-32 generator polynomial, see table above
+
+        while (bits != 0) {
+            if (bits & 1) {
+                crc = Gf2Times(op, crc);
+            }
+            bits >>= 1;
+            if (bits != 0) {
+                Gf2Square(sq, op);
+                std::swap(op, sq);
+            }
+        }
+        return crc;
+    }
+
+    // Reverse the 32 bits of a value.
+    uint32_t ReverseBits(uint32_t x)
+    {
+        x = ((x & 0x55555555) << 1) | ((x >> 1) & 0x55555555);
+        x = ((x & 0x33333333) << 2) | ((x >> 2) & 0x33333333);
+        x = ((x & 0x0F0F0F0F) << 4) | ((x >> 4) & 0x0F0F0F0F);
+        return (x << 24) | ((x & 0xFF00) << 8) | ((x >> 8) & 0xFF00) | (x >> 24);
+    }
+}
+
+void ts::CRC32::combine(const CRC32& next, size_t size)
+{
+    // The register is linear: crc(A||B) = zeroes(crc(A) xor INIT, bits(B)) xor crc(B),
+    // where zeroes() advances the register over zero bits without new input and the
+    // INIT term cancels the initial register value embedded in crc(B).
+    const uint32_t combined = AdvanceZeroes(value() ^ 0xFFFFFFFF, 8 * uint64_t(size)) ^ next.value();
+
+    if (_accel_supported) {
+        // The accelerated implementation stores the register with reversed bits (see valueAccel()).
+        _fcs = ReverseBits(combined);
+    }
+    else {
+        _fcs = combined;
+    }
+}
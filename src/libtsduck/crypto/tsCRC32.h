@@ -40,6 +40,26 @@ namespace ts {
             add(data, size);
         }
 
+        //!
+        //! A data fragment, for scatter-gather CRC32 computation.
+        //! A list of fragments describes scattered data, in logical order.
+        //!
+        struct TSDUCKDLL Fragment
+        {
+            const void* data;  //!< Address of the data fragment.
+            size_t      size;  //!< Size in bytes of the data fragment.
+        };
+
+        //!
+        //! Constructor, compute the CRC32 of scattered data fragments.
+        //! @param [in] fragments List of data fragments, in logical order.
+        //!
+        CRC32(std::initializer_list<Fragment> fragments) :
+            CRC32()
+        {
+            add(fragments);
+        }
+
         //!
         //! Continue the computation of a data area, following a previous CRC32.
         //! @param [in] data Address of area to analyze.
@@ -47,6 +67,37 @@ namespace ts {
         //!
         void add(const void* data, size_t size);
 
+        //!
+        //! Continue the computation over scattered data fragments.
+        //! This is equivalent to calling add() on each fragment in order,
+        //! without gathering the fragments in a contiguous buffer first.
+        //! @param [in] fragments List of data fragments, in logical order.
+        //!
+        void add(std::initializer_list<Fragment> fragments);
+
+        //!
+        //! Continue the computation over scattered data fragments.
+        //! This is equivalent to calling add() on each fragment in order,
+        //! without gathering the fragments in a contiguous buffer first.
+        //! @param [in] fragments Vector of data fragments, in logical order.
+        //!
+        void add(const std::vector<Fragment>& fragments);
+
+        //!
+        //! Combine with the CRC32 of a subsequent data area.
+        //!
+        //! If this object contains the CRC32 of a data area A and @a next contains
+        //! the CRC32 of a data area B, then this object contains the CRC32 of the
+        //! concatenation of A and B after the call. The combination runs in
+        //! logarithmic time on @a size, without reprocessing any of the data.
+        //! This is typically used to merge CRC32 values which were computed in
+        //! parallel over consecutive chunks of a large data area.
+        //!
+        //! @param [in] next CRC32 of the data area which follows this one.
+        //! @param [in] size Size in bytes of the data area over which @a next was computed.
+        //!
+        void combine(const CRC32& next, size_t size);
+
         //!
         //! Get the value of the CRC32 as computed so far.
         //! @return The value of the CRC32 as computed so far.
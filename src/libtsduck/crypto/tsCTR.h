@@ -67,9 +67,10 @@ namespace ts {
     private:
         size_t _counter_bits; // size in bits of the counter part.
 
-        // We need two work blocks.
-        // The first one contains the "input block" or counter.
-        // The second one contains the "output block", the encrypted counter.
+        // The work buffer contains 1 + 2 * PARALLEL_BLOCKS blocks.
+        // The first block contains the "input block" or current counter.
+        // The next PARALLEL_BLOCKS blocks contain a batch of counter values.
+        // The last PARALLEL_BLOCKS blocks contain the encrypted counters, the keystream.
         // This private method increments the counter block.
         bool incrementCounter();
     };
@@ -82,7 +83,7 @@ namespace ts {
 
 template<class CIPHER>
 ts::CTR<CIPHER>::CTR(size_t counter_bits) :
-    CipherChainingTemplate<CIPHER>(1, 1, 2),
+    CipherChainingTemplate<CIPHER>(1, 1, 1 + 2 * ts::CipherChaining::PARALLEL_BLOCKS),
     _counter_bits(0)
 {
     setCounterBits(counter_bits);
@@ -173,31 +174,49 @@ bool ts::CTR<CIPHER>::encryptImpl(const void* plain, size_t plain_length, void*
     // work[0] = iv
     std::memcpy(this->work.data(), this->iv.data(), this->block_size);
 
-    // Loop on all blocks, including last truncated one.
-
     const uint8_t* pt = reinterpret_cast<const uint8_t*>(plain);
     uint8_t* ct = reinterpret_cast<uint8_t*>(cipher);
-
-    while (plain_length > 0) {
-        // work[1] = encrypt(work[0])
-        if (!this->algo->encrypt(this->work.data(), this->block_size, this->work.data() + this->block_size, this->block_size)) {
+    uint8_t* const counters = this->work.data() + this->block_size;
+    uint8_t* const keystream = counters + ts::CipherChaining::PARALLEL_BLOCKS * this->block_size;
+
+    // Process all complete blocks, by chunks of up to PARALLEL_BLOCKS blocks.
+    // The counter values of a chunk are encrypted in one multi-block operation,
+    // they are independent and the block cipher can pipeline them.
+    while (plain_length >= this->block_size) {
+        const size_t chunk = std::min(plain_length / this->block_size, ts::CipherChaining::PARALLEL_BLOCKS);
+        for (size_t b = 0; b < chunk; ++b) {
+            // Copy work[0], the current counter, then increment it.
+            std::memcpy(counters + b * this->block_size, this->work.data(), this->block_size);
+            if (!incrementCounter()) {
+                return false;
+            }
+        }
+        // keystream = encrypt(counters)
+        if (!this->algo->encryptBlocks(counters, keystream, chunk)) {
             return false;
         }
-        // This block size:
-        const size_t size = std::min(plain_length, this->block_size);
-        // cipher-text = plain-text XOR work[1]
+        // cipher-text = plain-text XOR keystream
+        const size_t size = chunk * this->block_size;
         for (size_t i = 0; i < size; ++i) {
-            ct[i] = this->work[this->block_size + i] ^ pt[i];
-        }
-        // work[0] += 1
-        if (!incrementCounter()) {
-            return false;
+            ct[i] = keystream[i] ^ pt[i];
         }
-        // advance one block
+        // advance one chunk
         ct += size;
         pt += size;
         plain_length -= size;
     }
+
+    // Process the last truncated block, if any.
+    if (plain_length > 0) {
+        // keystream = encrypt(work[0])
+        if (!this->algo->encrypt(this->work.data(), this->block_size, keystream, this->block_size)) {
+            return false;
+        }
+        // cipher-text = plain-text XOR keystream, truncated
+        for (size_t i = 0; i < plain_length; ++i) {
+            ct[i] = keystream[i] ^ pt[i];
+        }
+    }
     return true;
 }
 
@@ -71,6 +71,14 @@ namespace ts {
         virtual bool residueAllowed() const = 0;
 
     protected:
+        //!
+        //! Number of blocks which parallelizable chaining modes process at once.
+        //! Independent blocks are passed together to the block cipher, using
+        //! BlockCipher::encryptBlocks() or BlockCipher::decryptBlocks(), to
+        //! benefit from multi-block pipelining when the cipher supports it.
+        //!
+        static constexpr size_t PARALLEL_BLOCKS = 8;
+
         // Protected fields, for chaining mode subclass implementation.
         BlockCipher* algo;        //!< An instance of the block cipher.
         const size_t block_size;  //!< Shortcut for algo->blockSize().
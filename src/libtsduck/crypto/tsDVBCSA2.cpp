@@ -422,6 +422,21 @@ namespace {
         0x4D, 0x4F, 0xCD, 0xCF, 0x6D, 0x6F, 0xED, 0xEF,
         0x5D, 0x5F, 0xDD, 0xDF, 0x7D, 0x7F, 0xFD, 0xFF
     };
+
+    // Fused S-box and permutation. The round function needs both block_sbox[x]
+    // and block_perm[block_sbox[x]]. One single table lookup returns the two
+    // values (permutation in the upper byte) instead of two dependent lookups
+    // in each of the 56 rounds.
+    struct BlockSboxPerm {
+        uint16_t table[256];
+        BlockSboxPerm()
+        {
+            for (int i = 0; i < 256; i++) {
+                table[i] = uint16_t((block_perm[block_sbox[i]] << 8) | block_sbox[i]);
+            }
+        }
+    };
+    const BlockSboxPerm block_sbox_perm;
 }
 
 
@@ -492,16 +507,17 @@ void ts::DVBCSA2::BlockCipher::decipher(const uint8_t *ib, uint8_t *bd)
     // loop over kk[56]..kk[1]
     for (i = 56; i > 0; i--) {
         sbox_in  = _kk[i] ^ R[7];
-        sbox_out = block_sbox[sbox_in];
-        perm_out = block_perm[sbox_out];
+        sbox_out = block_sbox_perm.table[sbox_in] & 0xFF;
+        perm_out = block_sbox_perm.table[sbox_in] >> 8;
         next_R8 = R[7];
+        const int r8_sbox = R[8] ^ sbox_out;
         R[7] = R[6] ^ perm_out;
         R[6] = R[5];
-        R[5] = R[4] ^ R[8] ^ sbox_out;
-        R[4] = R[3] ^ R[8] ^ sbox_out;
-        R[3] = R[2] ^ R[8] ^ sbox_out;
+        R[5] = R[4] ^ r8_sbox;
+        R[4] = R[3] ^ r8_sbox;
+        R[3] = R[2] ^ r8_sbox;
         R[2] = R[1];
-        R[1] = R[8] ^ sbox_out;
+        R[1] = r8_sbox;
         R[8] = next_R8;
     }
 
@@ -537,8 +553,8 @@ void ts::DVBCSA2::BlockCipher::encipher (const uint8_t *bd, uint8_t *ib)
     // loop over kk[1]..kk[56]
     for (i = 1; i <= 56; i++) {
         sbox_in  = _kk[i] ^ R[8];
-        sbox_out = block_sbox[sbox_in];
-        perm_out = block_perm[sbox_out];
+        sbox_out = block_sbox_perm.table[sbox_in] & 0xFF;
+        perm_out = block_sbox_perm.table[sbox_in] >> 8;
         next_R1 = R[2];
         R[2] = R[3] ^ R[1];
         R[3] = R[4] ^ R[1];
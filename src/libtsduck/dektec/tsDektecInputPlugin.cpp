@@ -19,6 +19,7 @@ bool tsDektecInputPluginIsEmpty = true; // Avoid warning about empty module.
 #include "tsDektecDevice.h"
 #include "tsModulation.h"
 #include "tsSysUtils.h"
+#include "tsTime.h"
 #include "tsFatal.h"
 #include "tsLNB.h"
 
@@ -935,13 +936,29 @@ size_t ts::DektecInputPlugin::receive(TSPacket* buffer, TSPacketMetadata* pkt_da
         status = _guts->chan.Read(reinterpret_cast<char*>(buffer), size, _guts->timeout_ms);
     }
 
-    if (status == DTAPI_OK) {
-        return size / PKT_SIZE;
-    }
-    else {
+    if (status != DTAPI_OK) {
         tsp->error(u"capture error on Dektec device %d: %s", {_guts->dev_index, DektecStrError(status)});
         return 0;
     }
+
+    const size_t count = size_t(size) / PKT_SIZE;
+
+    // Stamp the packets with their estimated arrival time. The hardware does not
+    // report per-packet time stamps in this receive mode but the FIFO load tells
+    // how long the batch was waiting on board: the last packet of the batch arrived
+    // at "now" minus the dwell time of the bytes which remain in the FIFO and the
+    // previous ones are spread backward at the hardware-measured input bitrate.
+    if (pkt_data != nullptr && _guts->got_bitrate && _guts->cur_bitrate > 0) {
+        const int64_t bitrate = int64_t(_guts->cur_bitrate.toInt());
+        const uint64_t spacing = uint64_t((int64_t(8 * PKT_SIZE) * MicroSecPerSec) / bitrate);
+        const int64_t remain = std::max<int64_t>(0, int64_t(fifo_load) - int64_t(size));
+        const uint64_t now = uint64_t(Time::CurrentUTC() - Time::Epoch) * MicroSecPerMilliSec;
+        const uint64_t last = now - uint64_t((remain * 8 * MicroSecPerSec) / bitrate);
+        for (size_t i = 0; i < count; ++i) {
+            pkt_data[i].setInputTimeStamp(last - (count - 1 - i) * spacing, MicroSecPerSec, TimeSource::DEKTEC);
+        }
+    }
+    return count;
 }
 
 #endif // TS_NO_DTAPI
@@ -24,12 +24,14 @@ bool tsDektecOutputPluginIsEmpty = true; // Avoid warning about empty module.
 #include "tsModulation.h"
 #include "tsIntegerUtils.h"
 #include "tsSysUtils.h"
+#include "tsThread.h"
 #include "tsFatal.h"
 
 TS_REGISTER_OUTPUT_PLUGIN(u"dektec", ts::DektecOutputPlugin);
 
 #define DEFAULT_PRELOAD_FIFO_PERCENTAGE 80
 #define DEFAULT_MAINTAIN_PRELOAD_THRESHOLD_SIZE 20116 // a little over 20k in packets, byte size for exactly 107 packets
+#define DEFAULT_IO_THREAD_BUFFER_PACKETS 16384 // default size in packets of the staging buffer with --io-thread
 
 
 //----------------------------------------------------------------------------
@@ -38,9 +40,23 @@ TS_REGISTER_OUTPUT_PLUGIN(u"dektec", ts::DektecOutputPlugin);
 
 class ts::DektecOutputPlugin::Guts
 {
-    TS_NOCOPY(Guts);
+    TS_NOBUILD_NOCOPY(Guts);
 public:
-    Guts() = default;                               // Constructor
+    // Dedicated writer thread (option --io-thread).
+    class Writer : public Thread
+    {
+        TS_NOBUILD_NOCOPY(Writer);
+    public:
+        Writer(DektecOutputPlugin* plugin) : _plugin(plugin) {}
+        virtual void main() override { _plugin->writerMain(); }
+    private:
+        DektecOutputPlugin* const _plugin;
+    };
+
+    static constexpr size_t FIFO_LOAD_HISTORY = 16;   // Number of FIFO load samples to keep for underrun reporting.
+    static constexpr int    WRITE_ALIGN_PACKETS = 32; // Preferred write granularity of the writer thread, in packets.
+
+    Guts(DektecOutputPlugin* plugin) : writer(plugin) {}  // Constructor
     bool                 starting = false;          // Starting phase (loading FIFO, no transmit)
     bool                 is_started = false;        // Device started
     bool                 mute_on_stop = false;      // Device supports output muting
@@ -65,6 +81,20 @@ public:
     bool                 drop_to_preload = false;   // Drop sufficient packets to get back to preload FIFO size--only set to true at run-time if would exceed preload plus threshold
     bool                 carrier_only = false;      // Output carrier frequency only, no modulated TS
     int                  power_mode = -1;           // Power mode to set on DTU-315
+    bool                 use_io_thread = false;     // Option --io-thread
+    bool                 writer_started = false;    // The writer thread is running
+    volatile bool        stop_writer = false;       // Ask the writer thread to terminate
+    volatile bool        writer_error = false;      // A write failed in the writer thread
+    std::mutex           mutex {};                  // Protect the staging ring
+    std::condition_variable staged {};              // Signal packets added in the staging ring
+    std::condition_variable unstaged {};            // Signal packets removed from the staging ring
+    ByteBlock            ring {};                   // Staging ring between send() and the writer thread
+    size_t               ring_head = 0;             // Offset of the oldest staged byte in ring
+    size_t               ring_size = 0;             // Number of staged bytes in ring
+    int                  load_history[FIFO_LOAD_HISTORY] {};  // Circular history of FIFO load samples
+    size_t               load_next = 0;             // Next write index in load_history
+    size_t               load_count = 0;            // Number of valid samples in load_history
+    Writer               writer;                    // Dedicated writer thread
 };
 
 
@@ -84,7 +114,7 @@ bool ts::DektecOutputPlugin::isRealTime()
 
 ts::DektecOutputPlugin::DektecOutputPlugin(TSP* tsp_) :
     OutputPlugin(tsp_, u"Send packets to a Dektec DVB-ASI or modulator device", u"[options]"),
-    _guts(new Guts)
+    _guts(new Guts(this))
 {
     CheckNonNull(_guts);
 
@@ -343,6 +373,14 @@ ts::DektecOutputPlugin::DektecOutputPlugin(TSP* tsp_) :
     option(u"inversion");
     help(u"inversion", u"All modulators devices: enable spectral inversion.");
 
+    option(u"io-thread", 0, INTEGER, 0, 1, 64, UNLIMITED_VALUE, true);
+    help(u"io-thread",
+         u"Write packets to the device from a dedicated thread. "
+         u"The optional value is the size in packets of the staging buffer between "
+         u"the plugin thread and the writer thread. The default is " TS_USTRINGIFY(DEFAULT_IO_THREAD_BUFFER_PACKETS) u" packets. "
+         u"The writer thread groups packets into fewer and larger write operations, "
+         u"which reduces the risk of FIFO underrun with modulators at high symbol rates.");
+
     option(u"j83", 0, Enumeration({
         {u"A", DTAPI_MOD_J83_A},
         {u"B", DTAPI_MOD_J83_B},
@@ -780,6 +818,7 @@ bool ts::DektecOutputPlugin::start()
     _guts->maintain_preload = present(u"maintain-preload");
     _guts->drop_to_maintain = present(u"drop-to-maintain-preload");
     _guts->carrier_only = present(u"carrier-only");
+    _guts->use_io_thread = present(u"io-thread");
     getIntValue(_guts->power_mode, u"power-mode", -1);
     GetDektecIOStandardArgs(*this, _guts->iostd_value, _guts->iostd_subvalue);
 
@@ -1045,6 +1084,20 @@ bool ts::DektecOutputPlugin::start()
     else {
         tsp->verbose(u"Will start transmission immediately.");
     }
+
+    // Start the dedicated writer thread when requested.
+    if (_guts->use_io_thread) {
+        _guts->ring.resize(intValue<size_t>(u"io-thread", DEFAULT_IO_THREAD_BUFFER_PACKETS) * PKT_SIZE);
+        _guts->ring_head = _guts->ring_size = 0;
+        _guts->load_next = _guts->load_count = 0;
+        _guts->stop_writer = _guts->writer_error = false;
+        if (!_guts->writer.start()) {
+            return startError(u"error starting the I/O thread");
+        }
+        _guts->writer_started = true;
+        tsp->verbose(u"started dedicated writer thread, staging buffer: %'d bytes", {_guts->ring.size()});
+    }
+
     _guts->is_started = true;
     return true;
 }
@@ -1576,6 +1629,18 @@ bool ts::DektecOutputPlugin::stop()
     if (_guts->is_started) {
         tsp->verbose(u"terminating %s output", {_guts->device.model});
 
+        // Terminate the writer thread first. It drains the staging ring before exiting.
+        if (_guts->writer_started) {
+            {
+                std::lock_guard<std::mutex> lock(_guts->mutex);
+                _guts->stop_writer = true;
+            }
+            _guts->staged.notify_all();
+            _guts->writer.waitForTermination();
+            _guts->writer_started = false;
+            _guts->ring.clear();
+        }
+
         // Mute output signal for modulators which support this
         if (_guts->mute_on_stop) {
             tsp->debug(u"SetRfMode(%d)", {DTAPI_UPCONV_MUTE});
@@ -1637,10 +1702,6 @@ bool ts::DektecOutputPlugin::send(const TSPacket* buffer, const TSPacketMetadata
         return true;
     }
 
-    char* data = reinterpret_cast<char*>(const_cast<TSPacket*>(buffer));
-    int remain = int(packet_count * PKT_SIZE);
-    Dtapi::DTAPI_RESULT status = DTAPI_OK;
-
     // If no bitrate was specified on the command line, adjust the bitrate when input bitrate changes.
     BitRate new_bitrate;
     if (_guts->opt_bitrate == 0 &&
@@ -1659,6 +1720,50 @@ bool ts::DektecOutputPlugin::send(const TSPacket* buffer, const TSPacketMetadata
         }
     }
 
+    // With --io-thread, hand the packets over to the writer thread through the staging ring.
+    if (_guts->writer_started) {
+        const char* data = reinterpret_cast<const char*>(buffer);
+        size_t remain = packet_count * PKT_SIZE;
+        std::unique_lock<std::mutex> lock(_guts->mutex);
+        while (remain > 0) {
+            if (_guts->writer_error) {
+                // The error was already reported by the writer thread.
+                return false;
+            }
+            if (_guts->ring_size >= _guts->ring.size()) {
+                // The staging ring is full, wait for the writer thread to drain part of it.
+                // Wake up regularly to check for error and abort conditions.
+                if (tsp->aborting()) {
+                    return false;
+                }
+                _guts->unstaged.wait_for(lock, std::chrono::milliseconds(1));
+                continue;
+            }
+            // Copy as much as possible at the back of the staging ring, up to the wrap-around point.
+            const size_t back = (_guts->ring_head + _guts->ring_size) % _guts->ring.size();
+            const size_t size = std::min(std::min(remain, _guts->ring.size() - _guts->ring_size), _guts->ring.size() - back);
+            ::memcpy(&_guts->ring[back], data, size);
+            _guts->ring_size += size;
+            data += size;
+            remain -= size;
+            _guts->staged.notify_all();
+        }
+        return true;
+    }
+
+    // Without writer thread, write to the device directly from the plugin thread.
+    return writeToDevice(reinterpret_cast<char*>(const_cast<TSPacket*>(buffer)), int(packet_count * PKT_SIZE));
+}
+
+
+//----------------------------------------------------------------------------
+// Write packets on the output channel, preserving preload and drop logic.
+//----------------------------------------------------------------------------
+
+bool ts::DektecOutputPlugin::writeToDevice(char* data, int remain)
+{
+    Dtapi::DTAPI_RESULT status = DTAPI_OK;
+
     // Loop on write until everything is gone.
     while (remain > 0) {
 
@@ -1675,6 +1780,7 @@ bool ts::DektecOutputPlugin::send(const TSPacket* buffer, const TSPacketMetadata
                 tsp->error(u"error getting output fifo load: " + DektecStrError(status));
                 return false;
             }
+            recordFifoLoad(fifo_load);
 
             if (fifo_load < _guts->preload_fifo_size - int(PKT_SIZE)) {
                 // Remain in starting phase, limit next I/O size
@@ -1703,6 +1809,7 @@ bool ts::DektecOutputPlugin::send(const TSPacket* buffer, const TSPacketMetadata
                 tsp->error(u"error getting output fifo load: " + DektecStrError(status));
                 return false;
             }
+            recordFifoLoad(fifo_load);
 
             if (_guts->preload_fifo && _guts->maintain_preload) {
                 if (fifo_load == 0) {
@@ -1814,15 +1921,7 @@ bool ts::DektecOutputPlugin::send(const TSPacket* buffer, const TSPacketMetadata
             status = _guts->chan.GetFlags(statusFlags, latched);
             if (status == DTAPI_OK) {
                 if (latched) {
-                    if ((latched & DTAPI_TX_CPU_UFL) != 0) {
-                        tsp->verbose(u"Got CPU underflow.");
-                    }
-                    if ((latched & DTAPI_TX_DMA_UFL) != 0) {
-                        tsp->verbose(u"Got DMA underflow.");
-                    }
-                    if ((latched & DTAPI_TX_FIFO_UFL) != 0) {
-                        tsp->verbose(u"Got FIFO underflow.");
-                    }
+                    reportUnderflows(latched);
                     _guts->chan.ClearFlags(latched);
                 }
             }
@@ -1835,6 +1934,114 @@ bool ts::DektecOutputPlugin::send(const TSPacket* buffer, const TSPacketMetadata
     return true;
 }
 
+
+//----------------------------------------------------------------------------
+// Record one sample of the output FIFO load for underrun reporting.
+//----------------------------------------------------------------------------
+
+void ts::DektecOutputPlugin::recordFifoLoad(int load)
+{
+    _guts->load_history[_guts->load_next] = load;
+    _guts->load_next = (_guts->load_next + 1) % Guts::FIFO_LOAD_HISTORY;
+    _guts->load_count = std::min(_guts->load_count + 1, Guts::FIFO_LOAD_HISTORY);
+}
+
+
+//----------------------------------------------------------------------------
+// Report latched underflow flags with the recent FIFO load history.
+//----------------------------------------------------------------------------
+
+void ts::DektecOutputPlugin::reportUnderflows(int latched)
+{
+    if ((latched & DTAPI_TX_CPU_UFL) != 0) {
+        tsp->verbose(u"Got CPU underflow.");
+    }
+    if ((latched & DTAPI_TX_DMA_UFL) != 0) {
+        tsp->verbose(u"Got DMA underflow.");
+    }
+    if ((latched & DTAPI_TX_FIFO_UFL) != 0) {
+        tsp->verbose(u"Got FIFO underflow.");
+    }
+    if (_guts->load_count > 0) {
+        // Display the most recent FIFO load samples, oldest first, to help diagnosing the underrun.
+        UString history;
+        for (size_t i = 0; i < _guts->load_count; ++i) {
+            const size_t index = (_guts->load_next + Guts::FIFO_LOAD_HISTORY - _guts->load_count + i) % Guts::FIFO_LOAD_HISTORY;
+            if (!history.empty()) {
+                history.append(u", ");
+            }
+            history.append(UString::Decimal(_guts->load_history[index]));
+        }
+        tsp->verbose(u"Recent FIFO load samples (bytes): %s", {history});
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Main loop of the dedicated writer thread (option --io-thread).
+//----------------------------------------------------------------------------
+
+void ts::DektecOutputPlugin::writerMain()
+{
+    const size_t align = size_t(Guts::WRITE_ALIGN_PACKETS) * PKT_SIZE;
+    ByteBlock chunk(round_down(size_t(DTA_MAX_IO_SIZE), align));
+    bool ok = true;
+
+    while (ok) {
+
+        // Wait until packets are staged or termination is requested.
+        size_t size = 0;
+        {
+            std::unique_lock<std::mutex> lock(_guts->mutex);
+            _guts->staged.wait(lock, [this]() { return _guts->stop_writer || _guts->ring_size > 0; });
+            if (_guts->ring_size == 0) {
+                // Termination was requested and the ring is drained.
+                break;
+            }
+            size = _guts->ring_size;
+        }
+
+        if (size < align && !_guts->stop_writer) {
+            // Less than one aligned burst is staged. If the hardware FIFO still holds
+            // enough packets, wait for a larger burst instead of issuing a small write.
+            int fifo_load = 0;
+            if (_guts->chan.GetFifoLoad(fifo_load) == DTAPI_OK) {
+                recordFifoLoad(fifo_load);
+                if (fifo_load > int(align)) {
+                    SleepThread(1);
+                    continue;
+                }
+            }
+        }
+
+        // Extract a chunk from the staging ring, in aligned bursts when possible.
+        {
+            std::lock_guard<std::mutex> lock(_guts->mutex);
+            size = std::min(_guts->ring_size, chunk.size());
+            if (size >= align) {
+                size = round_down(size, align);
+            }
+            const size_t part1 = std::min(size, _guts->ring.size() - _guts->ring_head);
+            ::memcpy(chunk.data(), &_guts->ring[_guts->ring_head], part1);
+            if (part1 < size) {
+                ::memcpy(chunk.data() + part1, _guts->ring.data(), size - part1);
+            }
+            _guts->ring_head = (_guts->ring_head + size) % _guts->ring.size();
+            _guts->ring_size -= size;
+        }
+        _guts->unstaged.notify_all();
+
+        ok = writeToDevice(reinterpret_cast<char*>(chunk.data()), int(size));
+    }
+
+    if (!ok) {
+        // Remember the error and release a potentially blocked send().
+        _guts->writer_error = true;
+        _guts->unstaged.notify_all();
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Set preload FIFO size based on delay, if requested, in ms
 // Returns true if preload FIFO size altered, false otherwise
@@ -62,6 +62,19 @@ namespace ts {
         // false otherwise.
         bool setPreloadFIFOSizeBasedOnDelay();
 
+        // Write packets on the output channel, preserving the FIFO preload and drop logic.
+        // The data address and byte size must be multiples of the TS packet size.
+        bool writeToDevice(char* data, int remain);
+
+        // Record one sample of the output FIFO load for underrun reporting.
+        void recordFifoLoad(int load);
+
+        // Report latched underflow flags with the recent FIFO load history.
+        void reportUnderflows(int latched);
+
+        // Main loop of the dedicated writer thread (option --io-thread).
+        void writerMain();
+
         // Checks whether calculated parameters for dvb-t do not override user specified params
         bool ParamsMatchUserOverrides(const ts::BitrateDifferenceDVBT& params);
     };
@@ -58,10 +58,10 @@ void ts::ContinuityAnalyzer::setPIDFilter(const PIDSet& pids)
     _pid_filter = pids;
 
     // Reset context of all removed PID's
-    if (removed_pids.any()) {
+    if (removed_pids.any() && !_pid_states.empty()) {
         for (PID pid = 0; pid < PID_MAX; ++pid) {
             if (removed_pids[pid]) {
-                _pid_states.erase(pid);
+                _pid_states[pid] = PIDState();
             }
         }
     }
@@ -83,7 +83,9 @@ void ts::ContinuityAnalyzer::removePID(PID pid)
 {
     if (pid < _pid_filter.size() && _pid_filter[pid]) {
         _pid_filter.reset(pid);
-        _pid_states.erase(pid);
+        if (pid < _pid_states.size()) {
+            _pid_states[pid] = PIDState();
+        }
     }
 }
 
@@ -99,26 +101,31 @@ bool ts::ContinuityAnalyzer::hasPID(PID pid) const
 
 uint8_t ts::ContinuityAnalyzer::firstCC(PID pid) const
 {
-    auto it = _pid_states.find(pid);
-    return it == _pid_states.end() ? INVALID_CC : it->second.first_cc;
+    return pid < _pid_states.size() ? _pid_states[pid].first_cc : INVALID_CC;
 }
 
 uint8_t ts::ContinuityAnalyzer::lastCC(PID pid) const
 {
-    auto it = _pid_states.find(pid);
-    return it == _pid_states.end() ? INVALID_CC : it->second.last_cc_out;
+    return pid < _pid_states.size() ? _pid_states[pid].last_cc_out : INVALID_CC;
 }
 
 size_t ts::ContinuityAnalyzer::dupCount(PID pid) const
 {
-    auto it = _pid_states.find(pid);
-    return it == _pid_states.end() ? NPOS : it->second.dup_count;
+    return pid < _pid_states.size() && _pid_states[pid].first_cc != INVALID_CC ? _pid_states[pid].dup_count : NPOS;
 }
 
 void ts::ContinuityAnalyzer::getLastPacket(PID pid, TSPacket& packet) const
 {
-    auto it = _pid_states.find(pid);
-    packet = it == _pid_states.end() ? NullPacket : it->second.last_pkt_in;
+    packet = pid < _pid_states.size() && _pid_states[pid].first_cc != INVALID_CC ? _pid_states[pid].last_pkt_in : NullPacket;
+}
+
+ts::ContinuityAnalyzer::PIDState& ts::ContinuityAnalyzer::pidState(PID pid)
+{
+    // The flat array is allocated on first use only, not in all instances.
+    if (_pid_states.empty()) {
+        _pid_states.resize(PID_MAX);
+    }
+    return _pid_states[pid];
 }
 
 ts::TSPacket ts::ContinuityAnalyzer::lastPacket(PID pid) const
@@ -161,91 +168,142 @@ bool ts::ContinuityAnalyzer::feedPacketInternal(TSPacket* pkt, bool update)
 
     // The null PID is never eligible for CC processing.
     if (pid != PID_NULL && _pid_filter.test(pid)) {
+        result = feedPacketState(pidState(pid), pkt, update);
+        _processed_packets++;
+    }
 
-        // Get or create PID context.
-        PIDState& state(_pid_states[pid]);
-        const bool new_pid = state.first_cc == INVALID_CC;
+    // Count total packets.
+    _total_packets++;
+    return result;
+}
 
-        // Remember initial characteristics of the input packet.
-        const uint8_t last_cc_in = new_pid ? INVALID_CC : state.last_pkt_in.getCC();
-        const uint8_t cc = pkt->getCC();
-        const bool has_payload = pkt->hasPayload();
-        const bool has_discontinuity = pkt->getDiscontinuityIndicator();
-        const bool duplicated = !new_pid && !has_discontinuity && pkt->isDuplicate(state.last_pkt_in);
 
-        // Save input packet as originally received.
-        state.last_pkt_in = *pkt;
+//----------------------------------------------------------------------------
+// Detect / fix error on a window of packets.
+//----------------------------------------------------------------------------
 
-        if (new_pid) {
-            // First packet on this PID
-            state.first_cc = cc;
-        }
-        else if (_generator) {
-            // Generator mode, ignore input CC, generate a smooth stream.
-            if (update) {
-                pkt->clearDiscontinuityIndicator();
-                pkt->setCC(has_payload ? ((state.last_cc_out + 1) & CC_MASK) : state.last_cc_out);
-                _fix_count++;
-                result = false;
-            }
+size_t ts::ContinuityAnalyzer::feedPackets(TSPacket* pkt, size_t count)
+{
+    assert(pkt != nullptr || count == 0);
+    size_t mod_count = 0;
+    size_t index = 0;
+
+    while (index < count) {
+
+        // Locate the run of consecutive packets with the same PID.
+        const PID pid = pkt[index].getPID();
+        size_t end = index + 1;
+        while (end < count && pkt[end].getPID() == pid) {
+            end++;
         }
-        else if (has_discontinuity) {
-            // Discontinuity indicator is set, ignore any discontinuity.
-            state.dup_count = 0;
+
+        if (pid == PID_NULL || !_pid_filter.test(pid)) {
+            // PID not eligible for CC processing, skip the complete run.
+            _total_packets += end - index;
         }
-        else if (duplicated) {
-            // Duplicate packet.
-            if (++state.dup_count >= 2) {
-                // The standard allows at most 2 duplicate packets.
-                if (_display_errors) {
-                    _report->log(_severity, u"%s, %d duplicate packets", {linePrefix(pid), state.dup_count + 1});
-                }
-                // There is nothing we can do to fix this.
-                _error_count++;
-                result = false;
-            }
-            if (update &&_fix_errors) {
-                // Check if we need to replicate a duplicate packet (same CC) or increment the CC.
-                const uint8_t cc_out = _replicate_dup || !has_payload ? state.last_cc_out : ((state.last_cc_out + 1) & CC_MASK);
-                if (cc != cc_out) {
-                    pkt->setCC(cc_out);
-                    result = false;
-                    _fix_count++;
+        else {
+            // Resolve the PID context once for the complete run.
+            PIDState& state(pidState(pid));
+            while (index < end) {
+                if (!feedPacketState(state, &pkt[index], true)) {
+                    mod_count++;
                 }
+                _processed_packets++;
+                _total_packets++;
+                index++;
             }
         }
-        else {
-            // Compute expected CC for this packet.
-            const uint8_t good_cc_in = has_payload ? ((last_cc_in + 1) & CC_MASK) : last_cc_in;
-            const uint8_t good_cc_out = has_payload ? ((state.last_cc_out + 1) & CC_MASK) : state.last_cc_out;
-
-            if (cc != good_cc_in) {
-                if (_display_errors) {
-                    // Display a specific message depending on the error.
-                    if (!has_payload && cc == ((last_cc_in + 1) & CC_MASK)) {
-                        _report->log(_severity, u"%s, incorrect CC increment without payload", {linePrefix(pid)});
-                    }
-                    else {
-                        _report->log(_severity, u"%s, missing %d packets", {linePrefix(pid), MissingPackets(last_cc_in, cc)});
-                    }
-                }
-                _error_count++;
-                result = false;
+        index = end;
+    }
+    return mod_count;
+}
+
+
+//----------------------------------------------------------------------------
+// Detect / fix error on one packet, in the context of its PID state.
+//----------------------------------------------------------------------------
+
+bool ts::ContinuityAnalyzer::feedPacketState(PIDState& state, TSPacket* pkt, bool update)
+{
+    bool result = true;
+    const PID pid = pkt->getPID();
+    const bool new_pid = state.first_cc == INVALID_CC;
+
+    // Remember initial characteristics of the input packet.
+    const uint8_t last_cc_in = new_pid ? INVALID_CC : state.last_pkt_in.getCC();
+    const uint8_t cc = pkt->getCC();
+    const bool has_payload = pkt->hasPayload();
+    const bool has_discontinuity = pkt->getDiscontinuityIndicator();
+    const bool duplicated = !new_pid && !has_discontinuity && pkt->isDuplicate(state.last_pkt_in);
+
+    // Save input packet as originally received.
+    state.last_pkt_in = *pkt;
+
+    if (new_pid) {
+        // First packet on this PID
+        state.first_cc = cc;
+    }
+    else if (_generator) {
+        // Generator mode, ignore input CC, generate a smooth stream.
+        if (update) {
+            pkt->clearDiscontinuityIndicator();
+            pkt->setCC(has_payload ? ((state.last_cc_out + 1) & CC_MASK) : state.last_cc_out);
+            _fix_count++;
+            result = false;
+        }
+    }
+    else if (has_discontinuity) {
+        // Discontinuity indicator is set, ignore any discontinuity.
+        state.dup_count = 0;
+    }
+    else if (duplicated) {
+        // Duplicate packet.
+        if (++state.dup_count >= 2) {
+            // The standard allows at most 2 duplicate packets.
+            if (_display_errors) {
+                _report->log(_severity, u"%s, %d duplicate packets", {linePrefix(pid), state.dup_count + 1});
             }
-            if (update && cc != good_cc_out && _fix_errors) {
-                pkt->setCC(good_cc_out);
+            // There is nothing we can do to fix this.
+            _error_count++;
+            result = false;
+        }
+        if (update &&_fix_errors) {
+            // Check if we need to replicate a duplicate packet (same CC) or increment the CC.
+            const uint8_t cc_out = _replicate_dup || !has_payload ? state.last_cc_out : ((state.last_cc_out + 1) & CC_MASK);
+            if (cc != cc_out) {
+                pkt->setCC(cc_out);
                 result = false;
                 _fix_count++;
             }
-            state.dup_count = 0;
         }
-
-        // Save actual CC for next time.
-        state.last_cc_out = pkt->getCC();
-        _processed_packets++;
+    }
+    else {
+        // Compute expected CC for this packet.
+        const uint8_t good_cc_in = has_payload ? ((last_cc_in + 1) & CC_MASK) : last_cc_in;
+        const uint8_t good_cc_out = has_payload ? ((state.last_cc_out + 1) & CC_MASK) : state.last_cc_out;
+
+        if (cc != good_cc_in) {
+            if (_display_errors) {
+                // Display a specific message depending on the error.
+                if (!has_payload && cc == ((last_cc_in + 1) & CC_MASK)) {
+                    _report->log(_severity, u"%s, incorrect CC increment without payload", {linePrefix(pid)});
+                }
+                else {
+                    _report->log(_severity, u"%s, missing %d packets", {linePrefix(pid), MissingPackets(last_cc_in, cc)});
+                }
+            }
+            _error_count++;
+            result = false;
+        }
+        if (update && cc != good_cc_out && _fix_errors) {
+            pkt->setCC(good_cc_out);
+            result = false;
+            _fix_count++;
+        }
+        state.dup_count = 0;
     }
 
-    // Count total packets.
-    _total_packets++;
+    // Save actual CC for next time.
+    state.last_cc_out = pkt->getCC();
     return result;
 }
@@ -72,6 +72,18 @@ namespace ts {
         //!
         bool feedPacket(TSPacket& pkt) { return feedPacketInternal(&pkt, true); }
 
+        //!
+        //! Process or modify a window of TS packets.
+        //! This is functionally equivalent to calling feedPacket() on each packet
+        //! of the window. However, the context of a PID is resolved once per run of
+        //! consecutive packets with the same PID, which is faster on large windows.
+        //! @param [in,out] pkt Address of the first packet in the window.
+        //! The packets can be modified only when error fixing or generator mode is activated.
+        //! @param [in] count Number of packets in the window.
+        //! @return The number of packets with a discontinuity error or a modification.
+        //!
+        size_t feedPackets(TSPacket* pkt, size_t count);
+
         //!
         //! Get the total number of TS packets.
         //! @return The total number of TS packets.
@@ -242,8 +254,8 @@ namespace ts {
             TSPacket last_pkt_in {};           // Last input packet (before modification, if any).
         };
 
-        // A map of PID state, indexed by PID.
-        typedef std::map<PID,PIDState> PIDStateMap;
+        // A flat array of PID states, indexed by PID. Allocated on first use only.
+        typedef std::vector<PIDState> PIDStateVector;
 
         // Private members.
         Report*       _report;                    // Where to report errors, never null.
@@ -258,12 +270,19 @@ namespace ts {
         PacketCounter _fix_count = 0;             // Number of fixed (modified) packets.
         PacketCounter _error_count = 0;           // Number of discontinuity errors.
         PIDSet        _pid_filter {};             // Current set of filtered PID's.
-        PIDStateMap   _pid_states {};             // State of all PID's.
+        PIDStateVector _pid_states {};            // State of all PID's.
 
         // Internal version of feedPacket.
         // The packet is modified only if update is true.
         bool feedPacketInternal(TSPacket* pkt, bool update);
 
+        // Get the state of a PID, allocating the state array on first use.
+        PIDState& pidState(PID pid);
+
+        // Process one packet in the context of its PID state.
+        // The packet is modified only if update is true.
+        bool feedPacketState(PIDState& state, TSPacket* pkt, bool update);
+
         // Build the first part of an error message.
         UString linePrefix(PID pid) const;
     };
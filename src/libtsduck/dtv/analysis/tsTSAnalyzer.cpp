@@ -1376,13 +1376,30 @@ void ts::TSAnalyzer::feedPacket(const TSPacket& pkt)
     _preceding_errors = 0;
     _preceding_suspects = 0;
 
+    // Get PID context
+    PIDContextPtr ps(getPID(pkt.getPID()));
+
+    // Media sampling: on PID's which are known to carry PES packets, only a
+    // fraction of the payload units is fed into the heavy payload analysis
+    // (PES and T2-MI demuxes, PES start code checks). The decision is taken
+    // on payload unit boundaries so that the analyzed PES packets are always
+    // complete ones. SI/PSI PID's and not-yet classified PID's are never
+    // sampled out, all per-packet counters below remain exact.
+    bool analyze_payload = true;
+    if (_media_sampling > 1 && ps->carry_pes) {
+        if (pkt.getPUSI() && pkt.hasPayload()) {
+            ps->sampling_keep = ps->pl_start_cnt % _media_sampling == 0;
+        }
+        analyze_payload = ps->sampling_keep;
+    }
+
     // Feed packets into the various demux
     _demux.feedPacket(pkt);
-    _pes_demux.feedPacket(pkt);
-    _t2mi_demux.feedPacket(pkt);
+    if (analyze_payload) {
+        _pes_demux.feedPacket(pkt);
+        _t2mi_demux.feedPacket(pkt);
+    }
 
-    // Get PID context
-    PIDContextPtr ps(getPID(pkt.getPID()));
     ps->ts_pkt_cnt++;
 
     // Accumulate stat from packet
@@ -1532,7 +1549,7 @@ void ts::TSAnalyzer::feedPacket(const TSPacket& pkt)
 
     size_t header_size(pkt.getHeaderSize());
 
-    if (pkt.getPUSI() && pkt.getScrambling() == SC_CLEAR && header_size <= PKT_SIZE - 3) {
+    if (analyze_payload && pkt.getPUSI() && pkt.getScrambling() == SC_CLEAR && header_size <= PKT_SIZE - 3) {
 
         // Got a "unit start indicator" in a clear packet.
         // This may be the start of a section or a PES packet.
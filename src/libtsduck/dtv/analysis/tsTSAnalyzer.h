@@ -104,6 +104,27 @@ namespace ts {
             _max_consecutive_suspects = count;
         }
 
+        //!
+        //! Set the media packet sampling interval.
+        //! When @a interval is greater than 1, the payload analysis of PID's which are known
+        //! to carry PES packets is sampled: only the payload units starting in one packet
+        //! out of @a interval are fed into the PES and T2-MI demuxes and the PES start code
+        //! checks. The decision is taken on payload unit boundaries so that the analyzed
+        //! PES packets are always complete ones.
+        //!
+        //! Accuracy: all per-packet counters remain exact (packet counts, discontinuities,
+        //! scrambling, crypto-periods, PCR/PTS/DTS counts and leaps, bitrates). Only the
+        //! audio/video attributes and the PES-related error counters (invalid PES start
+        //! codes, invalid PES packets) are evaluated on the sampled subset, ie. are
+        //! underestimated by a factor of up to @a interval.
+        //! Initially set to 1 (all packets are fully analyzed).
+        //! @param [in] interval Number of payload units between two analyzed payload units.
+        //!
+        void setMediaSampling(uint64_t interval)
+        {
+            _media_sampling = std::max<uint64_t>(1, interval);
+        }
+
         //!
         //! Get the list of service ids.
         //! @param [out] list The returned list of service ids.
@@ -346,6 +367,7 @@ namespace ts {
 
             // Public members - Analysis data:
             uint8_t       cur_continuity = 0;   //!< Current continuity count.
+            bool          sampling_keep = true; //!< Media sampling: current payload unit is fed into the payload analysis.
             MPEG2AudioAttributes audio2 {};     //!< Last MPEG-2 audio attributes.
 
             // Public members - Analysis data: Crypto-period evaluation:
@@ -537,6 +559,7 @@ namespace ts {
         uint64_t     _preceding_suspects = 0;        // Number of contiguous suspects packets before current packet
         uint64_t     _min_error_before_suspect = 1;  // Required number of invalid packets before starting suspect
         uint64_t     _max_consecutive_suspects = 1;  // Max number of consecutive suspect packets before clearing suspect
+        uint64_t     _media_sampling = 1;            // Payload analysis sampling interval on PES PID's (1: analyze all)
         SectionDemux _demux {_duck, this, this};     // PSI tables analysis
         PESDemux     _pes_demux {_duck, this};       // Audio/video analysis
         T2MIDemux    _t2mi_demux {_duck, this};      // T2-MI analysis
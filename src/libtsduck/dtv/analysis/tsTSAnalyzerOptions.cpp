@@ -94,6 +94,18 @@ void ts::TSAnalyzerOptions::defineArgs(Args& args)
     args.option(u"title", 0, Args::STRING);
     args.help(u"title", u"Display the specified string as title header.");
 
+    args.option(u"media-sampling", 0, Args::POSITIVE);
+    args.help(u"media-sampling",
+              u"Sample the payload analysis of audio/video PID's: only one payload unit "
+              u"out of the specified number is fed into the PES analysis. This "
+              u"dramatically speeds up the analysis of large capture files. All "
+              u"per-packet counters remain exact (packet counts, discontinuities, "
+              u"scrambling, PCR/PTS/DTS, bitrates); only the audio/video attributes "
+              u"and the PES-related error counters (invalid PES start codes, invalid "
+              u"PES packets) are evaluated on the sampled subset, ie. are "
+              u"underestimated by a factor of up to the sampling interval. "
+              u"The default is 1 (all packets are fully analyzed).");
+
     args.option(u"suspect-min-error-count", 0, Args::UNSIGNED);
     args.help(u"suspect-min-error-count",
               u"Specifies the minimum number of consecutive packets with errors before "
@@ -146,6 +158,7 @@ bool ts::TSAnalyzerOptions::loadArgs(DuckContext& duck, Args& args)
     args.getValue(title, u"title");
     args.getIntValue(suspect_min_error_count, u"suspect-min-error-count", 1);
     args.getIntValue(suspect_max_consecutive, u"suspect-max-consecutive", 1);
+    args.getIntValue(media_sampling, u"media-sampling", 1);
 
     bool ok = json.loadArgs(duck, args);
 
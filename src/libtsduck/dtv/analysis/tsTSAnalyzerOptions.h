@@ -65,6 +65,9 @@ namespace ts {
         uint64_t suspect_min_error_count = 1;  //!< Option -\-suspect-min-error-count
         uint64_t suspect_max_consecutive = 1;  //!< Option -\-suspect-max-consecutive
 
+        // Media packet sampling
+        uint64_t media_sampling = 1;           //!< Option -\-media-sampling
+
         //!
         //! Add command line option definitions in an Args.
         //! @param [in,out] args Command line arguments to update.
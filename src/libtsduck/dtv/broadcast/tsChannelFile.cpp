@@ -13,8 +13,111 @@
 #include "tsxmlElement.h"
 #include "tsFileUtils.h"
 #include "tsErrCodeReport.h"
+#include "tsByteBlock.h"
+#include "tsBuffer.h"
 #include "tsFatal.h"
 
+const ts::UChar* const ts::ChannelFile::DEFAULT_CACHE_FILE_SUFFIX = u".ccache";
+
+// Header of compiled channel cache files: magic number, format version,
+// number of networks, total size in bytes of the serialized data.
+namespace {
+    constexpr uint32_t CACHE_FILE_MAGIC = 0x54534343;  // "TSCC"
+    constexpr uint32_t CACHE_FILE_VERSION = 1;
+    constexpr size_t   CACHE_HEADER_SIZE = 16;
+
+    // Serialize one optional field as a presence bit and a fixed-size value.
+    // The deserialization must use the exact same sequence of fields.
+    template <typename T>
+    void putCacheField(ts::ByteBlock& bb, uint32_t& mask, uint32_t& bit, const std::optional<T>& field)
+    {
+        if (field.has_value()) {
+            mask |= bit;
+            bb.appendUInt64(uint64_t(int64_t(field.value())));
+        }
+        bit <<= 1;
+    }
+
+    template <typename T>
+    void getCacheField(ts::Buffer& buf, uint32_t mask, uint32_t& bit, std::optional<T>& field)
+    {
+        if ((mask & bit) != 0) {
+            field = T(int64_t(buf.getUInt64()));
+        }
+        bit <<= 1;
+    }
+
+    // Serialize one string as a 16-bit byte length followed by the UTF-8 bytes.
+    // The deserialization counterpart is Buffer::getUTF8WithLength(str, 16).
+    void putCacheString(ts::ByteBlock& bb, const ts::UString& str)
+    {
+        const std::string utf8(str.toUTF8());
+        const size_t size = std::min<size_t>(utf8.size(), 0xFFFF);
+        bb.appendUInt16(uint16_t(size));
+        bb.append(utf8.data(), size);
+    }
+
+    // Serialize the modulation parameters which can be represented in the XML
+    // file: a 32-bit presence mask followed by the values of the present fields.
+    void putCacheTune(ts::ByteBlock& bb, const ts::ModulationArgs& mod)
+    {
+        const size_t mask_pos = bb.size();
+        bb.appendUInt32(0); // placeholder for the presence mask
+        uint32_t mask = 0;
+        uint32_t bit = 1;
+        putCacheField(bb, mask, bit, mod.delivery_system);
+        putCacheField(bb, mask, bit, mod.frequency);
+        putCacheField(bb, mask, bit, mod.polarity);
+        putCacheField(bb, mask, bit, mod.inversion);
+        putCacheField(bb, mask, bit, mod.symbol_rate);
+        putCacheField(bb, mask, bit, mod.inner_fec);
+        putCacheField(bb, mask, bit, mod.satellite_number);
+        putCacheField(bb, mask, bit, mod.modulation);
+        putCacheField(bb, mask, bit, mod.bandwidth);
+        putCacheField(bb, mask, bit, mod.fec_hp);
+        putCacheField(bb, mask, bit, mod.fec_lp);
+        putCacheField(bb, mask, bit, mod.transmission_mode);
+        putCacheField(bb, mask, bit, mod.guard_interval);
+        putCacheField(bb, mask, bit, mod.hierarchy);
+        putCacheField(bb, mask, bit, mod.pilots);
+        putCacheField(bb, mask, bit, mod.roll_off);
+        putCacheField(bb, mask, bit, mod.plp);
+        putCacheField(bb, mask, bit, mod.isi);
+        putCacheField(bb, mask, bit, mod.pls_code);
+        putCacheField(bb, mask, bit, mod.pls_mode);
+        putCacheField(bb, mask, bit, mod.stream_id);
+        ts::PutUInt32(&bb[mask_pos], mask);
+    }
+
+    // Deserialize the modulation parameters, same sequence as putCacheTune().
+    void getCacheTune(ts::Buffer& buf, ts::ModulationArgs& mod)
+    {
+        const uint32_t mask = buf.getUInt32();
+        uint32_t bit = 1;
+        getCacheField(buf, mask, bit, mod.delivery_system);
+        getCacheField(buf, mask, bit, mod.frequency);
+        getCacheField(buf, mask, bit, mod.polarity);
+        getCacheField(buf, mask, bit, mod.inversion);
+        getCacheField(buf, mask, bit, mod.symbol_rate);
+        getCacheField(buf, mask, bit, mod.inner_fec);
+        getCacheField(buf, mask, bit, mod.satellite_number);
+        getCacheField(buf, mask, bit, mod.modulation);
+        getCacheField(buf, mask, bit, mod.bandwidth);
+        getCacheField(buf, mask, bit, mod.fec_hp);
+        getCacheField(buf, mask, bit, mod.fec_lp);
+        getCacheField(buf, mask, bit, mod.transmission_mode);
+        getCacheField(buf, mask, bit, mod.guard_interval);
+        getCacheField(buf, mask, bit, mod.hierarchy);
+        getCacheField(buf, mask, bit, mod.pilots);
+        getCacheField(buf, mask, bit, mod.roll_off);
+        getCacheField(buf, mask, bit, mod.plp);
+        getCacheField(buf, mask, bit, mod.isi);
+        getCacheField(buf, mask, bit, mod.pls_code);
+        getCacheField(buf, mask, bit, mod.pls_mode);
+        getCacheField(buf, mask, bit, mod.stream_id);
+    }
+}
+
 
 //----------------------------------------------------------------------------
 // Transport stream accessors.
@@ -308,9 +411,30 @@ bool ts::ChannelFile::load(const UString& fileName, Report& report)
 {
     clear();
     _fileName = fileName.empty() ? DefaultFileName() : fileName;
+
+    // Transparently prefer the compiled cache when it is newer than the XML source.
+    const UString cacheName(_fileName + DEFAULT_CACHE_FILE_SUFFIX);
+    if (_compiledCache &&
+        GetFileModificationTimeUTC(cacheName) > GetFileModificationTimeUTC(_fileName) &&
+        loadCache(cacheName, report))
+    {
+        report.debug(u"loaded compiled channel cache %s", {cacheName});
+        return true;
+    }
+
+    // Load and parse the XML source.
     xml::Document doc(report);
     doc.setTweaks(_xmlTweaks);
-    return doc.load(_fileName, false) && parseDocument(doc);
+    if (!doc.load(_fileName, false) || !parseDocument(doc)) {
+        return false;
+    }
+
+    // Regenerate a missing or obsolete cache. This is a best effort only,
+    // the XML content is already loaded (eg. read-only directories).
+    if (_compiledCache && !saveCache(cacheName, report)) {
+        report.debug(u"cannot create compiled channel cache %s", {cacheName});
+    }
+    return true;
 }
 
 bool ts::ChannelFile::load(std::istream& strm, Report& report)
@@ -332,6 +456,154 @@ bool ts::ChannelFile::parse(const UString& text, Report& report)
 }
 
 
+//----------------------------------------------------------------------------
+// Load a compiled channel cache file.
+//----------------------------------------------------------------------------
+
+bool ts::ChannelFile::loadCache(const UString& fileName, Report& report)
+{
+    std::ifstream strm(fileName.toUTF8().c_str(), std::ios::in | std::ios::binary);
+    if (!strm.is_open()) {
+        return false;
+    }
+
+    // Read and validate the cache header.
+    uint8_t header[CACHE_HEADER_SIZE];
+    strm.read(reinterpret_cast<char*>(header), CACHE_HEADER_SIZE);
+    if (size_t(strm.gcount()) != CACHE_HEADER_SIZE ||
+        GetUInt32(header) != CACHE_FILE_MAGIC ||
+        GetUInt32(header + 4) != CACHE_FILE_VERSION)
+    {
+        report.debug(u"invalid or obsolete compiled channel cache %s", {fileName});
+        return false;
+    }
+    const size_t net_count = GetUInt32(header + 8);
+    const size_t data_size = GetUInt32(header + 12);
+
+    // Read the serialized data in one block.
+    ByteBlock data(data_size);
+    strm.read(reinterpret_cast<char*>(data.data()), std::streamsize(data_size));
+    if (size_t(strm.gcount()) != data_size) {
+        report.debug(u"truncated compiled channel cache %s", {fileName});
+        return false;
+    }
+
+    // Deserialize the networks from the memory block (read-only buffer).
+    Buffer buf(data.data(), data.size(), true);
+    for (size_t inet = 0; inet < net_count && !buf.error(); ++inet) {
+
+        // Build a new Network object at end of our list of networks.
+        const NetworkPtr net(new Network);
+        CheckNonNull(net.pointer());
+        _networks.push_back(net);
+        net->id = buf.getUInt16();
+        net->type = TunerType(int32_t(buf.getUInt32()));
+
+        // Get all TS in the network.
+        const size_t ts_count = buf.getUInt32();
+        for (size_t its = 0; its < ts_count && !buf.error(); ++its) {
+            const TransportStreamPtr ts(net->tsGetOrCreate(buf.getUInt16()));
+            assert(!ts.isNull());
+            ts->onid = buf.getUInt16();
+            getCacheTune(buf, ts->tune);
+
+            // Get all services in the transport stream.
+            const size_t srv_count = buf.getUInt32();
+            for (size_t isrv = 0; isrv < srv_count && !buf.error(); ++isrv) {
+                const ServicePtr srv(new Service(buf.getUInt16()));
+                CheckNonNull(srv.pointer());
+                buf.getUTF8WithLength(srv->name, 16);
+                buf.getUTF8WithLength(srv->provider, 16);
+                const uint32_t mask = buf.getUInt32();
+                uint32_t bit = 1;
+                getCacheField(buf, mask, bit, srv->lcn);
+                getCacheField(buf, mask, bit, srv->pmtPID);
+                getCacheField(buf, mask, bit, srv->type);
+                getCacheField(buf, mask, bit, srv->cas);
+                getCacheField(buf, mask, bit, srv->atscType);
+                getCacheField(buf, mask, bit, srv->atscMajorId);
+                getCacheField(buf, mask, bit, srv->atscMinorId);
+                ts->addService(srv, ShareMode::SHARE, true);
+            }
+        }
+    }
+
+    // Truncated or corrupted cache, discard whatever was loaded from it.
+    if (buf.error() || !buf.endOfRead()) {
+        clear();
+        report.debug(u"corrupted compiled channel cache %s", {fileName});
+        return false;
+    }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Save a compiled channel cache file.
+//----------------------------------------------------------------------------
+
+bool ts::ChannelFile::saveCache(const UString& fileName, Report& report) const
+{
+    // Serialize all networks in one memory block.
+    ByteBlock data;
+    for (const auto& net : _networks) {
+        assert(!net.isNull());
+        data.appendUInt16(net->id);
+        data.appendUInt32(uint32_t(int32_t(net->type)));
+        data.appendUInt32(uint32_t(net->tsCount()));
+        for (size_t its = 0; its < net->tsCount(); ++its) {
+            const TransportStreamPtr ts(net->tsByIndex(its));
+            assert(!ts.isNull());
+            data.appendUInt16(ts->id);
+            data.appendUInt16(ts->onid);
+            putCacheTune(data, ts->tune);
+            data.appendUInt32(uint32_t(ts->serviceCount()));
+            for (size_t isrv = 0; isrv < ts->serviceCount(); ++isrv) {
+                const ServicePtr srv(ts->serviceByIndex(isrv));
+                assert(!srv.isNull());
+                data.appendUInt16(srv->id);
+                putCacheString(data, srv->name);
+                putCacheString(data, srv->provider);
+                const size_t mask_pos = data.size();
+                data.appendUInt32(0); // placeholder for the presence mask
+                uint32_t mask = 0;
+                uint32_t bit = 1;
+                putCacheField(data, mask, bit, srv->lcn);
+                putCacheField(data, mask, bit, srv->pmtPID);
+                putCacheField(data, mask, bit, srv->type);
+                putCacheField(data, mask, bit, srv->cas);
+                putCacheField(data, mask, bit, srv->atscType);
+                putCacheField(data, mask, bit, srv->atscMajorId);
+                putCacheField(data, mask, bit, srv->atscMinorId);
+                PutUInt32(&data[mask_pos], mask);
+            }
+        }
+    }
+
+    std::ofstream strm(fileName.toUTF8().c_str(), std::ios::out | std::ios::binary);
+    if (!strm.is_open()) {
+        return false;
+    }
+
+    // Build and write the cache header, followed by the serialized data.
+    uint8_t header[CACHE_HEADER_SIZE];
+    PutUInt32(header, CACHE_FILE_MAGIC);
+    PutUInt32(header + 4, CACHE_FILE_VERSION);
+    PutUInt32(header + 8, uint32_t(_networks.size()));
+    PutUInt32(header + 12, uint32_t(data.size()));
+    strm.write(reinterpret_cast<const char*>(header), CACHE_HEADER_SIZE);
+    strm.write(reinterpret_cast<const char*>(data.data()), std::streamsize(data.size()));
+    const bool success = strm.good();
+    strm.close();
+
+    // Do not leave a truncated cache file behind on error.
+    if (!success) {
+        fs::remove(fileName, &ErrCodeReport());
+    }
+    return success;
+}
+
+
 //----------------------------------------------------------------------------
 // Parse an XML document.
 //----------------------------------------------------------------------------
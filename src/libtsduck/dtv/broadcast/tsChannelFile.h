@@ -46,6 +46,24 @@ namespace ts {
         //!
         void setTweaks(const xml::Tweaks& tweaks) { _xmlTweaks = tweaks; }
 
+        //!
+        //! Enable or disable the compiled channel cache.
+        //!
+        //! When enabled, loading an XML channel file transparently prefers a sibling
+        //! "compiled" binary cache file when its timestamp is newer than the XML source
+        //! and regenerates the cache after a successful XML parse. This avoids the cost
+        //! of XML parsing on large channel databases which are reloaded by every tool
+        //! invocation (channel lookup, service pre-resolution).
+        //!
+        //! The cache file is named after the XML file, with the suffix
+        //! DEFAULT_CACHE_FILE_SUFFIX appended. It uses a versioned binary format;
+        //! obsolete, truncated or corrupted cache files are ignored and rebuilt from
+        //! the XML source.
+        //!
+        //! @param [in] on True to use the compiled channel cache when loading XML files.
+        //!
+        void setCompiledCache(bool on) { _compiledCache = on; }
+
         //!
         //! Clear all networks.
         //!
@@ -110,6 +128,12 @@ namespace ts {
         //!
         static UString DefaultFileName();
 
+        //!
+        //! Default file name suffix for compiled channel cache files.
+        //! @see setCompiledCache()
+        //!
+        static const UChar* const DEFAULT_CACHE_FILE_SUFFIX;
+
         //!
         //! Description of one service.
         //!
@@ -375,9 +399,15 @@ namespace ts {
         bool serviceToTuning(ModulationArgs& tune, const DeliverySystemSet& delsys, const UString& name, bool strict = true, Report& report = CERR) const;
 
     private:
-        NetworkVector _networks {};    // List of networks in the configuration.
-        xml::Tweaks   _xmlTweaks {};   // XML formatting and parsing tweaks.
-        UString       _fileName {};    // Name of loaded file.
+        NetworkVector _networks {};          // List of networks in the configuration.
+        xml::Tweaks   _xmlTweaks {};         // XML formatting and parsing tweaks.
+        UString       _fileName {};          // Name of loaded file.
+        bool          _compiledCache = false; // Use compiled cache files when loading XML files.
+
+        // Load/save a compiled channel cache file. Loading silently fails on
+        // invalid cache files, the caller falls back to the XML source.
+        bool loadCache(const UString& fileName, Report& report);
+        bool saveCache(const UString& fileName, Report& report) const;
 
         // Parse an XML document and load the content into this object.
         bool parseDocument(const xml::Document& doc);
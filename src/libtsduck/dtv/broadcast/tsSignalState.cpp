@@ -21,6 +21,7 @@ void ts::SignalState::clear()
     signal_noise_ratio.reset();
     bit_error_rate.reset();
     packet_error_rate.reset();
+    input_overflows.reset();
 }
 
 
@@ -74,6 +75,9 @@ ts::UString ts::SignalState::toString() const
     if (packet_error_rate.has_value()) {
         str.format(u", PER: %s", {packet_error_rate.value()});
     }
+    if (input_overflows.has_value()) {
+        str.format(u", overflows: %s", {input_overflows.value()});
+    }
     return str;
 }
 
@@ -97,5 +101,8 @@ std::ostream& ts::SignalState::display(std::ostream& out, const UString& margin,
     if (packet_error_rate.has_value()) {
         out << margin << "Packet error rate: " << packet_error_rate.value() << std::endl;
     }
+    if (input_overflows.has_value()) {
+        out << margin << "Input buffer overflows: " << input_overflows.value() << std::endl;
+    }
     return out;
 }
@@ -84,6 +84,14 @@ namespace ts {
         //!
         std::optional<Value> packet_error_rate {};
 
+        //!
+        //! Number of input buffer overflows in the reception system.
+        //! This is a cumulative counter since the reception started. A non-zero
+        //! value indicates that packets were lost between the demodulator and
+        //! the application (undersized kernel buffer or application too slow).
+        //!
+        std::optional<Value> input_overflows {};
+
         //!
         //! Constructor.
         //!
@@ -119,6 +119,7 @@ bool ts::TunerArgs::loadArgs(DuckContext& duck, Args& args)
                 // To find a match, we need to know the delivery systems which are supported by the tuner.
                 // And to do that, we need to temporarily open the tuner in "info only" mode.
                 ChannelFile file;
+                file.setCompiledCache(true);
                 Tuner tuner(duck);
                 _info_only = true;
                 if (file.load(args.value(u"tuning-file"), duck.report()) && configureTuner(tuner)) {
@@ -203,7 +204,9 @@ void ts::TunerArgs::defineArgs(Args& args, bool allow_short_options)
         args.option(u"demux-buffer-size", 0, Args::UNSIGNED);
         args.help(u"demux-buffer-size",
                   u"Default buffer size, in bytes, of the demux device. "
-                  u"The default is 1 MB.");
+                  u"The default is 1 MB. On high bitrate transponders, increase this "
+                  u"value so that the buffer can absorb system scheduling hiccups at "
+                  u"the full transponder bitrate without packet loss.");
 
 #elif defined(TS_WINDOWS)
 
@@ -13,6 +13,11 @@
 #include "tsxmlModelDocument.h"
 #include "tsFileUtils.h"
 
+// Number of packets which are pre-staged at a time in regulated replay mode.
+// The file or pipe input is performed by bursts of that size, outside the
+// paced delivery path, so that I/O latency does not disturb the regulation.
+#define REPLAY_STAGE_PACKETS  512
+
 
 //-----------------------------------------------------------------------------
 // Constructors and destructors.
@@ -88,12 +93,14 @@ bool ts::TunerEmulator::open(const UString& device_name, bool info_only)
     // Get default values;
     DeliverySystem def_delivery = DS_UNDEFINED;
     uint64_t def_bandwidth = 0;
+    uint64_t def_bitrate = 0;
     UString def_directory;
     const xml::Element* def = root->findFirstChild(u"defaults", true);
     bool success = true;
     if (def != nullptr) {
         success = def->getIntEnumAttribute(def_delivery, DeliverySystemEnum, u"delivery", false, DS_UNDEFINED) &&
                   def->getIntAttribute(def_bandwidth, u"bandwidth", false, 0) &&
+                  def->getIntAttribute(def_bitrate, u"bitrate", false, 0) &&
                   def->getAttribute(def_directory, u"directory", false);
         if (def_directory.empty()) {
             def_directory = base_directory;
@@ -110,11 +117,14 @@ bool ts::TunerEmulator::open(const UString& device_name, bool info_only)
     _channels.reserve(xchannels.size());
     for (auto it = xchannels.begin(); success && it != xchannels.end(); ++it) {
         Channel chan;
+        uint64_t chan_bitrate = 0;
         success = (*it)->getIntAttribute(chan.frequency, u"frequency", true) &&
                   (*it)->getIntAttribute(chan.bandwidth, u"bandwidth", false, def_bandwidth) &&
                 (*it)->getIntEnumAttribute(chan.delivery, DeliverySystemEnum, u"delivery", false, def_delivery) &&
+                  (*it)->getIntAttribute(chan_bitrate, u"bitrate", false, def_bitrate) &&
                   (*it)->getAttribute(chan.file, u"file", false) &&
                   (*it)->getAttribute(chan.pipe, u"pipe", false);
+        chan.bitrate = chan_bitrate;
         chan.file.trim();
         chan.pipe.trim();
         if (success && (chan.file.empty() + chan.pipe.empty()) != 1) {
@@ -305,6 +315,17 @@ bool ts::TunerEmulator::start()
         return false;
     }
 
+    // Initialize the pacing engine for regulated replay.
+    _stage.clear();
+    _stage_next = _stage_count = 0;
+    if (chan.bitrate > 0) {
+        _duck.report().debug(u"tuner emulator: replay regulated at %'d b/s", {chan.bitrate});
+        _stage.resize(REPLAY_STAGE_PACKETS);
+        _regulator.setReport(&_duck.report(), Severity::Debug);
+        _regulator.setFixedBitRate(chan.bitrate);
+        _regulator.start();
+    }
+
     // Started.
     _state = State::STARTED;
     return true;
@@ -319,6 +340,9 @@ bool ts::TunerEmulator::stop(bool silent)
     if (_pipe.isOpen()) {
         _pipe.close(silent ? NULLREP : _duck.report());
     }
+    // Release the staging buffer of regulated replay.
+    _stage.clear();
+    _stage_next = _stage_count = 0;
     // Change state only if started.
     if (_state == State::STARTED) {
         _state = State::TUNED;
@@ -336,15 +360,46 @@ size_t ts::TunerEmulator::receive(TSPacket* buffer, size_t max_packets, const Ab
     if (_state != State::STARTED) {
         return 0;  // error
     }
-    else if (_file.isOpen()) {
-        return _file.readPackets(buffer, nullptr, max_packets, _duck.report());
+
+    // Unregulated replay: read directly from the file or pipe, as fast as possible.
+    if (_stage.empty()) {
+        if (_file.isOpen()) {
+            return _file.readPackets(buffer, nullptr, max_packets, _duck.report());
+        }
+        else if (_pipe.isOpen()) {
+            return _pipe.readPackets(buffer, nullptr, max_packets, _duck.report());
+        }
+        else {
+            return 0;  // error
+        }
     }
-    else if (_pipe.isOpen()) {
-        return _pipe.readPackets(buffer, nullptr, max_packets, _duck.report());
+
+    // Regulated replay: refill the staging buffer when empty. The I/O is done
+    // by large bursts, outside the paced delivery path below.
+    if (_stage_next >= _stage_count) {
+        if (_file.isOpen()) {
+            _stage_count = _file.readPackets(_stage.data(), nullptr, _stage.size(), _duck.report());
+        }
+        else if (_pipe.isOpen()) {
+            _stage_count = _pipe.readPackets(_stage.data(), nullptr, _stage.size(), _duck.report());
+        }
+        else {
+            _stage_count = 0;
+        }
+        _stage_next = 0;
+        if (_stage_count == 0) {
+            return 0;  // error or end of input
+        }
     }
-    else {
-        return 0;  // error
+
+    // Deliver packets from the staging buffer and pace them at the channel bitrate.
+    const size_t count = std::min(max_packets, _stage_count - _stage_next);
+    TSPacket::Copy(buffer, &_stage[_stage_next], count);
+    _stage_next += count;
+    for (size_t n = 0; n < count && (abort == nullptr || !abort->aborting()); ++n) {
+        _regulator.regulate();
     }
+    return count;
 }
 
 
@@ -388,6 +443,9 @@ std::ostream& ts::TunerEmulator::displayStatus(std::ostream& strm, const UString
         const Channel& chan(_channels[i]);
         strm << "  " << UString::Decimal(chan.frequency) << " Hz (" << DeliverySystemEnum.name(chan.delivery)
              << ", width: " << UString::Decimal(chan.bandwidth) << ")";
+        if (chan.bitrate > 0) {
+            strm << " bitrate: " << chan.bitrate.toString() << " b/s";
+        }
         if (!chan.file.empty()) {
             strm << " file: " << chan.file;
         }
@@ -17,6 +17,7 @@
 #include "tsAbortInterface.h"
 #include "tsTSFile.h"
 #include "tsTSForkPipe.h"
+#include "tsBitRateRegulator.h"
 
 namespace ts {
     //!
@@ -96,6 +97,7 @@ namespace ts {
             uint64_t       frequency = 0;            // Center frequency in Hz.
             uint64_t       bandwidth = 0;            // Bandwidth in Hz, over which reception is possible.
             DeliverySystem delivery = DS_UNDEFINED;  // Delivery system for this frequency.
+            BitRate        bitrate = 0;              // Replay bitrate in b/s, zero means replay as fast as possible.
             UString        file {};                  // TS file name.
             UString        pipe {};                  // Command line to pipe output in terminal emulator.
 
@@ -123,5 +125,9 @@ namespace ts {
         size_t               _tune_index = 0;        // Currently tuned channel.
         uint64_t             _tune_frequency = 0;    // Requested frequency.
         int                  _strength = -1;         // Signal strength in percent.
+        BitRateRegulator     _regulator {};          // Pacing engine for regulated replay.
+        std::vector<TSPacket> _stage {};             // Pre-staged packet burst, empty in unregulated mode.
+        size_t               _stage_next = 0;        // Next packet to deliver from _stage.
+        size_t               _stage_count = 0;       // Number of valid packets in _stage.
     };
 }
@@ -8,7 +8,6 @@
 
 #include "tsDVBCharTableSingleByte.h"
 #include "tsUString.h"
-#include "tsAlgorithm.h"
 
 // Static instances of corresponding DVB charsets.
 const ts::DVBCharset ts::DVBCharTableSingleByte::DVB_ISO_6937(u"ISO-6937", &RAW_ISO_6937);
@@ -42,18 +41,26 @@ ts::DVBCharTableSingleByte::DVBCharTableSingleByte(const UChar* name, uint32_t t
         throw InvalidCharset(UString::Format(u"%s (%d entries)", {name, _upperCodePoints.size()}));
     }
 
+    // Size the code point to byte table on the largest mapped code point.
+    uint16_t max_cp = 0x7E;
+    for (auto cp : _upperCodePoints) {
+        max_cp = std::max(max_cp, cp);
+    }
+    _byteLookup.resize(size_t(max_cp) + 1, 0);
+
     // Code point to byte mapping for ASCII range
     for (size_t i = 0x20; i <= 0x7E; i++) {
-        _bytesMap.insert(std::make_pair(UChar(i), uint8_t(i)));
+        _byteLookup[i] = uint8_t(i);
     }
 
     // Control codes
-    _bytesMap.insert(std::make_pair(LINE_FEED, DVB_SINGLE_BYTE_CRLF));
+    _byteLookup[LINE_FEED] = DVB_SINGLE_BYTE_CRLF;
 
     // Code point to byte mapping for 0xA0-0xFF range
     for (size_t i = 0; i < _upperCodePoints.size(); i++) {
-        if (_upperCodePoints[i] != 0) {
-            _bytesMap.insert(std::make_pair(UChar(_upperCodePoints[i]), uint8_t(0xA0 + i)));
+        const uint16_t cp = _upperCodePoints[i];
+        if (cp != 0 && _byteLookup[cp] == 0) {
+            _byteLookup[cp] = uint8_t(0xA0 + i);
         }
     }
 
@@ -72,6 +79,23 @@ ts::DVBCharTableSingleByte::DVBCharTableSingleByte(const UChar* name, uint32_t t
 
 bool ts::DVBCharTableSingleByte::decode(UString& str, const uint8_t* dvb, size_t dvbSize) const
 {
+    // Fast path: pure ASCII strings (the vast majority of service names) are
+    // translated by identity, without diacritical processing. Convert them in
+    // bulk into the preallocated output.
+    if (dvb != nullptr) {
+        size_t ascii = 0;
+        while (ascii < dvbSize && dvb[ascii] >= 0x20 && dvb[ascii] <= 0x7E) {
+            ascii++;
+        }
+        if (ascii == dvbSize) {
+            str.resize(dvbSize);
+            for (size_t i = 0; i < dvbSize; ++i) {
+                str[i] = UChar(dvb[i]);
+            }
+            return true;
+        }
+    }
+
     str.clear();
     str.reserve(dvbSize);
     bool status = true;
@@ -130,7 +154,7 @@ bool ts::DVBCharTableSingleByte::canEncode(const UString& str, size_t start, siz
 {
     for (size_t i = 0; i < str.length(); ++i) {
         const UChar cp = str[i];
-        if (!Contains(_bytesMap, cp) && cp != CARRIAGE_RETURN) {
+        if (cp != CARRIAGE_RETURN && (cp >= _byteLookup.size() || _byteLookup[cp] == 0)) {
             // Untranslatable character.
             return false;
         }
@@ -145,16 +169,37 @@ bool ts::DVBCharTableSingleByte::canEncode(const UString& str, size_t start, siz
 
 size_t ts::DVBCharTableSingleByte::encode(uint8_t*& buffer, size_t& size, const UString& str, size_t start, size_t count) const
 {
+    // Fast path: pure ASCII substrings (the vast majority of service names)
+    // are encoded by identity, without diacritical reordering. Encode them
+    // in bulk when they entirely fit in the buffer.
+    if (buffer != nullptr && start < str.length()) {
+        const size_t chars = std::min(count, str.length() - start);
+        if (chars <= size) {
+            size_t ascii = 0;
+            while (ascii < chars && str[start + ascii] >= 0x20 && str[start + ascii] <= 0x7E) {
+                ascii++;
+            }
+            if (ascii == chars) {
+                for (size_t i = 0; i < chars; ++i) {
+                    buffer[i] = uint8_t(str[start + i]);
+                }
+                buffer += chars;
+                size -= chars;
+                return chars;
+            }
+        }
+    }
+
     uint8_t* const base = buffer;
     size_t result = 0;
 
     // Serialize characters as long as there is free space.
     while (buffer != nullptr && size > 0 && start < str.length() && count > 0) {
         const UChar cp = str[start];
-        const auto it = _bytesMap.find(cp);
-        if (cp != ts::CARRIAGE_RETURN && it != _bytesMap.end()) {
+        const uint8_t b = cp < _byteLookup.size() ? _byteLookup[cp] : 0;
+        if (b != 0) {
             // Encode character.
-            *buffer = it->second;
+            *buffer = b;
             size--;
             // Reverse letter and diacritical mark when necessary.
             if (buffer > base && *buffer >= 0xA0 && _reversedDiacritical.test(*buffer - 0xA0)) {
@@ -87,8 +87,9 @@ namespace ts {
         // List of code points for byte values 0xA0-0xFF. Always contain 96 values.
         const std::vector<uint16_t> _upperCodePoints {};
 
-        // Reverse mapping for complete character set (key = code point, value = byte rep).
-        std::map<UChar, uint8_t> _bytesMap {};
+        // Reverse mapping for complete character set, as a flat table for direct
+        // lookup (index = code point, value = byte rep, zero means unmappable).
+        std::vector<uint8_t> _byteLookup {};
 
         // Bitmap of combining diacritical marks which precede their base letter (and must be reversed from Unicode).
         // This only applies to byte values 0xA0-0xFF (96 values).
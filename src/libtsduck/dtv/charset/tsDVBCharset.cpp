@@ -8,6 +8,7 @@
 
 #include "tsDVBCharset.h"
 #include "tsUString.h"
+#include "tsByteBlock.h"
 #include "tsDVBCharTableSingleByte.h"
 #include "tsDVBCharTableUTF8.h"
 
@@ -38,21 +39,73 @@ bool ts::DVBCharset::canEncode(const UString& str, size_t start, size_t count) c
 }
 
 
+//----------------------------------------------------------------------------
+// Cache of recently decoded strings.
+//----------------------------------------------------------------------------
+
+namespace {
+    // DVB SI carries the same encoded strings (service names, provider names,
+    // network names) in every table cycle. A small per-thread direct-mapped
+    // cache avoids decoding them again. Only short strings are cached.
+    struct DecodedString
+    {
+        const void*   charset = nullptr;  // decoding DVBCharset instance
+        ts::ByteBlock data {};            // encoded bytes
+        ts::UString   str {};             // decoded string
+        bool          status = false;     // decoding status
+    };
+
+    constexpr size_t DECODED_CACHE_SIZE = 64;       // number of entries, a power of two
+    constexpr size_t DECODED_CACHE_MAX_BYTES = 64;  // longest cached encoded string
+
+    // Get the cache entry for an encoded string (FNV-1a hash of the bytes and charset).
+    DecodedString& cacheEntry(const void* charset, const uint8_t* data, size_t size)
+    {
+        thread_local std::array<DecodedString, DECODED_CACHE_SIZE> cache {};
+        uint64_t h = 0xCBF29CE484222325;
+        h = (h ^ uint64_t(reinterpret_cast<uintptr_t>(charset))) * 0x100000001B3;
+        for (size_t i = 0; i < size; ++i) {
+            h = (h ^ data[i]) * 0x100000001B3;
+        }
+        return cache[size_t(h) & (DECODED_CACHE_SIZE - 1)];
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Decode a DVB string from the specified byte buffer.
 //----------------------------------------------------------------------------
 
 bool ts::DVBCharset::decode(UString& str, const uint8_t* data, size_t size) const
 {
-    // Try to minimize reallocation.
-    str.clear();
-    str.reserve(size);
-
     // Null or empty buffer is a valid empty string.
     if (data == nullptr || size == 0) {
+        str.clear();
         return true;
     }
 
+    // Lookup the cache of recently decoded strings.
+    if (size <= DECODED_CACHE_MAX_BYTES) {
+        DecodedString& entry(cacheEntry(this, data, size));
+        if (entry.charset != this || entry.data.size() != size || ::memcmp(entry.data.data(), data, size) != 0) {
+            // Not in the cache, decode and replace the entry.
+            entry.charset = this;
+            entry.data.copy(data, size);
+            entry.status = decodeString(entry.str, data, size);
+        }
+        str = entry.str;
+        return entry.status;
+    }
+
+    return decodeString(str, data, size);
+}
+
+bool ts::DVBCharset::decodeString(UString& str, const uint8_t* data, size_t size) const
+{
+    // Try to minimize reallocation.
+    str.clear();
+    str.reserve(size);
+
     // Get the DVB character set code from the beginning of the string.
     uint32_t code = 0;
     size_t codeSize = 0;
@@ -82,6 +135,39 @@ bool ts::DVBCharset::decode(UString& str, const uint8_t* data, size_t size) cons
 }
 
 
+//----------------------------------------------------------------------------
+// Cache of recently encoded strings.
+//----------------------------------------------------------------------------
+
+namespace {
+    // Table serialization re-encodes the same strings (service names, event
+    // names) in every regeneration cycle. A small per-thread direct-mapped
+    // cache keeps their canonical encoded form, including the leading table
+    // code. Only short complete strings are cached.
+    struct EncodedString
+    {
+        const void*   charset = nullptr;  // encoding DVBCharset instance
+        ts::UString   str {};             // source string
+        ts::ByteBlock data {};            // canonical encoded bytes
+    };
+
+    constexpr size_t ENCODED_CACHE_SIZE = 64;       // number of entries, a power of two
+    constexpr size_t ENCODED_CACHE_MAX_CHARS = 64;  // longest cached source string
+
+    // Get the cache entry for a source string (FNV-1a hash of the characters and charset).
+    EncodedString& encodeCacheEntry(const void* charset, const ts::UString& str)
+    {
+        thread_local std::array<EncodedString, ENCODED_CACHE_SIZE> cache {};
+        uint64_t h = 0xCBF29CE484222325;
+        h = (h ^ uint64_t(reinterpret_cast<uintptr_t>(charset))) * 0x100000001B3;
+        for (auto c : str) {
+            h = (h ^ uint64_t(c)) * 0x100000001B3;
+        }
+        return cache[size_t(h) & (ENCODED_CACHE_SIZE - 1)];
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Encode a C++ Unicode string into a DVB string.
 //----------------------------------------------------------------------------
@@ -98,6 +184,36 @@ size_t ts::DVBCharset::encode(uint8_t*& buffer, size_t& size, const UString& str
         return 0;
     }
 
+    // Lookup the cache of recently encoded strings when the complete string is encoded.
+    if (start == 0 && count == length && length <= ENCODED_CACHE_MAX_CHARS) {
+        EncodedString& entry(encodeCacheEntry(this, str));
+        if (entry.charset != this || entry.str != str) {
+            // Not in the cache, build the canonical encoded form and replace the
+            // entry. Assume a maximum of 6 bytes per character (see Charset::encoded),
+            // plus up to 3 bytes of leading table code.
+            entry.charset = this;
+            entry.str = str;
+            entry.data.resize(3 + 6 * length);
+            uint8_t* data = entry.data.data();
+            size_t remain = entry.data.size();
+            encodeString(data, remain, str, 0, length);
+            entry.data.resize(entry.data.size() - remain);
+        }
+        // Use the canonical form only when it entirely fits in the buffer.
+        // Otherwise, the truncation point must be recomputed by a direct encoding.
+        if (entry.data.size() <= size) {
+            std::memcpy(buffer, entry.data.data(), entry.data.size());
+            buffer += entry.data.size();
+            size -= entry.data.size();
+            return count;
+        }
+    }
+
+    return encodeString(buffer, size, str, start, count);
+}
+
+size_t ts::DVBCharset::encodeString(uint8_t*& buffer, size_t& size, const UString& str, size_t start, size_t count) const
+{
     // Try to encode using these character tables in order
     const DVBCharTable* const lookup_tables[] = {
         _default_table,                                // default table for this charset
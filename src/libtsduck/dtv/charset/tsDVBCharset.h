@@ -64,5 +64,11 @@ namespace ts {
 
     private:
         const DVBCharTable* const _default_table; // Default character table, never null.
+
+        // Decode a DVB string, without the cache of recently decoded strings.
+        bool decodeString(UString& str, const uint8_t* data, size_t size) const;
+
+        // Encode a DVB string, without the cache of recently encoded strings.
+        size_t encodeString(uint8_t*& buffer, size_t& size, const UString& str, size_t start, size_t count) const;
     };
 }
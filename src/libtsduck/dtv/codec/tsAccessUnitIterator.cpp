@@ -97,10 +97,6 @@ bool ts::AccessUnitIterator::next()
         return false;
     }
 
-    // Memory patterns which are used between access units.
-    static const uint8_t Zero3[] = {0x00, 0x00, 0x00};
-    static const uint8_t StartCodePrefix[] = {0x00, 0x00, 0x01};
-
     // Remaining size in data area.
     assert(_nalunit >= _data);
     assert(_nalunit <= _data + _data_size);
@@ -115,7 +111,7 @@ bool ts::AccessUnitIterator::next()
     // Locate next access unit: starts with 00 00 01.
     // The start code prefix 00 00 01 is not part of the NALunit.
     // The NALunit starts at the NALunit type byte (see H.264, 7.3.1).
-    const uint8_t* const p1 = LocatePattern(_nalunit, remain, StartCodePrefix, sizeof(StartCodePrefix));
+    const uint8_t* const p1 = LocateZeroZero(_nalunit, remain, 0x01);
     if (p1 == nullptr) {
         // No next access unit.
         _nalunit = nullptr;
@@ -123,13 +119,13 @@ bool ts::AccessUnitIterator::next()
         return false;
     }
 
-    // Jump to first byte of NALunit.
-    remain -= p1 - _nalunit + sizeof(StartCodePrefix);
-    _nalunit = p1 + sizeof(StartCodePrefix);
+    // Jump to first byte of NALunit, skipping the 3-byte start code prefix.
+    remain -= p1 - _nalunit + 3;
+    _nalunit = p1 + 3;
 
     // Locate end of access unit: ends with 00 00 00, 00 00 01 or end of data.
-    const uint8_t* const p2 = LocatePattern(_nalunit, remain, StartCodePrefix, sizeof(StartCodePrefix));
-    const uint8_t* const p3 = LocatePattern(_nalunit, remain, Zero3, sizeof(Zero3));
+    const uint8_t* const p2 = LocateZeroZero(_nalunit, remain, 0x01);
+    const uint8_t* const p3 = LocateZeroZero(_nalunit, remain, 0x00);
     if (p2 == nullptr && p3 == nullptr) {
         // No 00 00 01, no 00 00 00, the NALunit extends up to the end of data.
         _nalunit_size = remain;
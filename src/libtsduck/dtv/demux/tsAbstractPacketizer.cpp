@@ -52,6 +52,25 @@ void ts::AbstractPacketizer::configurePacket(TSPacket& pkt, bool nullify)
 }
 
 
+//----------------------------------------------------------------------------
+// Get a reference to a pre-built packet template for the packetizer PID.
+//----------------------------------------------------------------------------
+
+const ts::TSPacket& ts::AbstractPacketizer::packetTemplate()
+{
+    if (!_template_ok) {
+        // Rebuild the template: complete header and all-stuffing payload.
+        std::memset(_template.b, 0xFF, PKT_SIZE);
+        _template.b[0] = SYNC_BYTE;
+        PutUInt16(_template.b + 1, 0x0000);  // PUSI clear, PID zero
+        _template.b[3] = 0x10;               // no adaptation field, has payload, CC zero
+        _template.setPID(_pid);
+        _template_ok = true;
+    }
+    return _template;
+}
+
+
 //----------------------------------------------------------------------------
 // Display the internal state of the packetizer, mainly for debug
 //----------------------------------------------------------------------------
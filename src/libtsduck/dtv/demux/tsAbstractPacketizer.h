@@ -13,11 +13,11 @@
 
 #pragma once
 #include "tsTS.h"
+#include "tsTSPacket.h"
 #include "tsDuckContext.h"
 
 namespace ts {
 
-    class TSPacket;
     class DuckContext;
 
     //!
@@ -32,7 +32,7 @@ namespace ts {
         //! Set the default PID for subsequent MPEG packets.
         //! @param [in] pid PID for generated TS packets.
         //!
-        void setPID(PID pid) { _pid = pid & 0x1FFF; }
+        void setPID(PID pid) { _pid = pid & 0x1FFF; _template_ok = false; }
 
         //!
         //! Get the default PID for subsequent MPEG packets.
@@ -116,11 +116,24 @@ namespace ts {
         //!
         void configurePacket(TSPacket& pkt, bool nullify);
 
+        //!
+        //! Get a reference to a pre-built packet template for the packetizer PID.
+        //! The template contains a complete TS header (PUSI clear, no adaptation field,
+        //! payload present, continuity counter zero) and a payload full of stuffing
+        //! bytes (0xFF). Initializing an output packet with one single copy of the
+        //! template is cheaper than building the header field by field and filling
+        //! the trailing stuffing with memset() for each packet.
+        //! @return A constant reference to the template packet.
+        //!
+        const TSPacket& packetTemplate();
+
     private:
-        const DuckContext& _duck;              // TSDuck execution context.
-        PID                _pid = PID_NULL;    // PID for injected sections.
-        uint8_t            _continuity = 0;    // Continuity counter for next packet
-        PacketCounter      _packet_count = 0;  // Number of generated packets
+        const DuckContext& _duck;                 // TSDuck execution context.
+        PID                _pid = PID_NULL;       // PID for injected sections.
+        uint8_t            _continuity = 0;       // Continuity counter for next packet
+        PacketCounter      _packet_count = 0;     // Number of generated packets
+        TSPacket           _template {};          // See packetTemplate().
+        bool               _template_ok = false;  // The template matches the current PID.
     };
 }
 
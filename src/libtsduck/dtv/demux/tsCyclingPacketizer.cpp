@@ -120,11 +120,28 @@ void ts::CyclingPacketizer::addScheduledSection(const SectionDescPtr& sect)
                   sect->section->sectionNumber(), sect->section->lastSectionNumber(),
                   sect->last_cycle, sect->last_packet, sect->due_packet});
 
-    auto it = _sched_sections.begin();
-    while (it != _sched_sections.end() && sect->insertAfter(**it)) {
-        ++it;
+    // The insertion point is almost always at end of list: when a section is
+    // rescheduled after being provided, its new due packet is usually later
+    // than all other scheduled sections. Walk backward from the end of the
+    // list, first past the sections which are due strictly later (most often
+    // none), then to the beginning of the run of sections with the same due
+    // packet, if any.
+    auto it = _sched_sections.end();
+    while (it != _sched_sections.begin() && (*std::prev(it))->due_packet > sect->due_packet) {
+        --it;
     }
-    _sched_sections.insert(it, sect);
+    auto run = it;
+    while (run != _sched_sections.begin() && (*std::prev(run))->due_packet == sect->due_packet) {
+        --run;
+    }
+
+    // Apply the full insertion criteria on the run of sections with the same
+    // due packet, where the relative order implements the cycle and section
+    // number tie-breaking rules.
+    while (run != it && sect->insertAfter(**run)) {
+        ++run;
+    }
+    _sched_sections.insert(run, sect);
 }
 
 
@@ -14,6 +14,7 @@
 #pragma once
 #include "tsTS.h"
 #include "tsByteBlock.h"
+#include "tsByteBlockSlice.h"
 
 namespace ts {
     //!
@@ -192,6 +193,15 @@ namespace ts {
         //!
         size_t rawDataSize() const;
 
+        //!
+        //! Get a shared slice view over the logical binary content of the data.
+        //! Unlike building a ByteBlock from content() and size(), the bytes are
+        //! not copied, the slice references the same shared data as this object.
+        //! @return A slice designating the logical binary content of the data.
+        //! @see ByteBlockSlice
+        //!
+        ByteBlockSlice contentSlice() const { return ByteBlockSlice(_data, 0, size()); }
+
         //!
         //! Check if the start of the data matches a given pattern.
         //! @param [in] pattern A byte block to compare with the start of the data.
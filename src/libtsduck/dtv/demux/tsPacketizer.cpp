@@ -104,10 +104,13 @@ bool ts::Packetizer::getNextPacket(TSPacket& pkt)
         pointer_field = uint8_t(remain_in_section);  // point after current section
     }
 
-    // Build the header
-    pkt.b[0] = SYNC_BYTE;
-    PutUInt16(pkt.b + 1, pusi);
-    pkt.b[3] = 0x10;  // no adaptation field, has payload
+    // Initialize the packet from the pre-built template: complete header for
+    // the output PID and a payload full of stuffing bytes. The trailing
+    // stuffing is then already in place, without per-packet memset().
+    pkt = packetTemplate();
+    if (pusi != 0) {
+        pkt.b[1] |= 0x40;
+    }
     configurePacket(pkt, false);  // PID, continuity, count packets.
 
     // Remaining bytes in the packet.
@@ -168,15 +171,7 @@ bool ts::Packetizer::getNextPacket(TSPacket& pkt)
         }
     }
 
-    // Do packet stuffing if necessary.
-    // Note: the following test is normally useless since memset() works fine when
-    // the size is zero. However, GCC 4.8.x erroneously deduces that remain_in_packet
-    // is always zero (which is not true) and complains that memset() is always useless.
-    // The test fixes this GCC error. However, it has not yet been tested if the behaviour
-    // of the compiled code is correct with this version of GCC.
-    if (remain_in_packet > 0) {
-        std::memset(data, 0xFF, remain_in_packet);
-    }
+    // The end of the packet, if any is left, is already stuffed by the template.
     return true;
 }
 
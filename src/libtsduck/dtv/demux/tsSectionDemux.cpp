@@ -14,6 +14,19 @@
 #include "tsReportFile.h"
 #include "tsEIT.h"
 
+namespace {
+    // 64-bit FNV-1a hash of a section content, used by the corrupt-section
+    // storm control to identify repetitions of the same corrupted section.
+    uint64_t SectionHash(const uint8_t* data, size_t size)
+    {
+        uint64_t hash = 0xCBF29CE484222325;
+        for (size_t i = 0; i < size; ++i) {
+            hash = (hash ^ data[i]) * 0x00000100000001B3;
+        }
+        return hash;
+    }
+}
+
 
 //----------------------------------------------------------------------------
 // Demux status information.
@@ -28,7 +41,8 @@ ts::SectionDemux::Status::Status() :
     inv_sect_version(0),
     wrong_crc(0),
     is_next(0),
-    truncated_sect(0)
+    truncated_sect(0),
+    inv_sect_suppressed(0)
 {
 }
 
@@ -49,6 +63,7 @@ void ts::SectionDemux::Status::reset()
     wrong_crc = 0;
     is_next = 0;
     truncated_sect = 0;
+    inv_sect_suppressed = 0;
 }
 
 // Check if any counter is non zero.
@@ -63,7 +78,8 @@ bool ts::SectionDemux::Status::hasErrors() const
         inv_sect_version != 0 ||
         wrong_crc != 0 ||
         is_next != 0 ||
-        truncated_sect != 0;
+        truncated_sect != 0 ||
+        inv_sect_suppressed != 0;
 }
 
 
@@ -108,6 +124,9 @@ void ts::SectionDemux::Status::display(Report& report, int level, const UString&
     if (!errors_only || is_next != 0) {
         report.log(level, u"%sNext sections (not yet applicable): %'d", {prefix, is_next});
     }
+    if (!errors_only || inv_sect_suppressed != 0) {
+        report.log(level, u"%sSuppressed invalid section repetitions: %'d", {prefix, inv_sect_suppressed});
+    }
 }
 
 
@@ -192,12 +211,30 @@ void ts::SectionDemux::immediateReset()
 {
     SuperClass::immediateReset();
     _pids.clear();
+    _pid_contexts.fill(nullptr);
 }
 
 void ts::SectionDemux::immediateResetPID(PID pid)
 {
     SuperClass::immediateResetPID(pid);
     _pids.erase(pid);
+    _pid_contexts[pid] = nullptr;
+}
+
+
+//----------------------------------------------------------------------------
+// Enable or disable a pool of reusable section data buffers.
+//----------------------------------------------------------------------------
+
+void ts::SectionDemux::setSectionBufferPool(bool on, size_t max_blocks)
+{
+    _use_buffer_pool = on;
+    if (on) {
+        _buffer_pool.setMaxBlocks(max_blocks);
+    }
+    else {
+        _buffer_pool.clear();
+    }
 }
 
 
@@ -221,10 +258,15 @@ void ts::SectionDemux::processPacket(const TSPacket& pkt)
         return;
     }
 
-    // Get PID and reference to the PID context.
-    // The PID context is created if did not exist.
+    // Get PID and reference to the PID context, using the flat dispatch array.
+    // The PID context is created if did not exist. The map entries are
+    // pointer-stable, the cached pointer remains valid until the PID is reset.
     const PID pid = pkt.getPID();
-    PIDContext& pc(_pids[pid]);
+    PIDContext* pcp = _pid_contexts[pid];
+    if (pcp == nullptr) {
+        pcp = _pid_contexts[pid] = &_pids[pid];
+    }
+    PIDContext& pc(*pcp);
 
     // If TS packet is scrambled, we cannot decode it and we loose synchronization
     // on this PID (usually, PID's carrying sections are not scrambled).
@@ -318,12 +360,26 @@ void ts::SectionDemux::processPacket(const TSPacket& pkt)
         pc.sync = true;
     }
 
-    // Copy TS packet payload in PID context
-    pc.ts.append(payload, payload_size);
+    // When no partial section is pending for this PID, parse the sections
+    // directly from the TS packet payload, without copying it into the PID
+    // context buffer. This is the most common case for SI/PSI (sections are
+    // typically contained in one packet). Only a trailing incomplete section,
+    // if any, will be saved in the PID context at the end.
+    const bool direct = pc.ts.empty();
 
     // Locate TS buffer by address and size.
-    const uint8_t* ts_start = pc.ts.data();
-    size_t ts_size = pc.ts.size();
+    const uint8_t* ts_start = nullptr;
+    size_t ts_size = 0;
+    if (direct) {
+        ts_start = payload;
+        ts_size = payload_size;
+    }
+    else {
+        // A partial section is pending, append the new payload after it.
+        pc.ts.append(payload, payload_size);
+        ts_start = pc.ts.data();
+        ts_size = pc.ts.size();
+    }
 
     // If current packet has a PUSI, locate start of this new section inside the TS buffer.
     // This is not useful to locate the section but it is used to check that the previous section was not truncated.
@@ -424,6 +480,30 @@ void ts::SectionDemux::processPacket(const TSPacket& pkt)
             section_ok = false;
         }
 
+        // Corrupt-section storm control. When the last corrupted section of the
+        // PID repeats, suppress its analysis during exponentially growing backoff
+        // periods: the CRC32 check, the error log and the invalid section handler
+        // run on the 1st, 2nd, 4th, 8th, etc. occurrence only. The hash is only
+        // computed while a quarantine is active on the PID, a healthy PID pays
+        // nothing.
+        bool quarantined = false;
+        uint64_t sect_hash = 0;
+        if (section_ok && _invalid_backoff && pc.inv_count > 0) {
+            sect_hash = SectionHash(ts_start, section_length);
+            if (sect_hash == pc.inv_hash) {
+                pc.inv_count++;
+                if (pc.inv_count < pc.inv_next_report) {
+                    _status.inv_sect_suppressed++;
+                    section_ok = false;
+                    quarantined = true;
+                }
+                else {
+                    // Let this occurrence go through the complete analysis once.
+                    pc.inv_next_report *= 2;
+                }
+            }
+        }
+
         if (section_ok) {
 
             // Get the list of standards which define this table id and add them in context.
@@ -478,13 +558,27 @@ void ts::SectionDemux::processPacket(const TSPacket& pkt)
             SectionPtr sect_ptr;
 
             if (section_ok && (_section_handler != nullptr || (tc != nullptr && tc->sects[section_number].isNull()))) {
-                sect_ptr = new Section(ts_start, section_length, pid, CRC32::CHECK);
+                if (_use_buffer_pool) {
+                    // Recycle a data buffer from the pool instead of allocating one.
+                    const ByteBlockPtr data(_buffer_pool.acquire());
+                    data->assign(ts_start, ts_start + section_length);
+                    sect_ptr = new Section(data, pid, CRC32::CHECK);
+                }
+                else {
+                    sect_ptr = new Section(ts_start, section_length, pid, CRC32::CHECK);
+                }
                 sect_ptr->setFirstTSPacketIndex(pusi_pkt_index);
                 sect_ptr->setLastTSPacketIndex(_packet_count);
                 if (!sect_ptr->isValid()) {
                     _duck.report().log(_ts_error_level, u"invalid section CRC, PID 0x%X (%<d), TID 0x%X (%<d), section %d, version %d, packet index %'d", {pid, tid, section_number, version, _packet_count});
                     _status.wrong_crc++;  // only possible error (hum?)
                     section_ok = false;
+                    // Start a quarantine on this section if it is a new one.
+                    if (_invalid_backoff && (pc.inv_count == 0 || sect_hash != pc.inv_hash)) {
+                        pc.inv_hash = sect_hash != 0 ? sect_hash : SectionHash(ts_start, section_length);
+                        pc.inv_count = 1;
+                        pc.inv_next_report = 2;
+                    }
                 }
             }
 
@@ -519,7 +613,8 @@ void ts::SectionDemux::processPacket(const TSPacket& pkt)
         }
 
         // If a handler is defined for invalid sections, call it.
-        if (!section_ok && _invalid_handler != nullptr) {
+        // Occurrences which are suppressed by the storm control are not reported.
+        if (!section_ok && !quarantined && _invalid_handler != nullptr) {
             beforeCallingHandler(pid);
             try {
                 DemuxedData data(ts_start, section_length, pid);
@@ -544,11 +639,15 @@ void ts::SectionDemux::processPacket(const TSPacket& pkt)
         pusi_pkt_index = _packet_count;
     }
 
-    // If an incomplete section remains in the buffer, move it back to the start of the buffer.
+    // If an incomplete section remains, keep it in the PID context buffer.
     if (ts_size <= 0) {
-        // TS buffer becomes empty
+        // TS buffer is or becomes empty
         pc.ts.clear();
     }
+    else if (direct) {
+        // Sections were parsed directly from the packet payload, save the trailing incomplete section.
+        pc.ts.append(ts_start, ts_size);
+    }
     else if (ts_start > pc.ts.data()) {
         // Remove start of TS buffer
         pc.ts.erase(0, ts_start - pc.ts.data());
@@ -17,6 +17,7 @@
 #include "tsTableHandlerInterface.h"
 #include "tsSectionHandlerInterface.h"
 #include "tsInvalidSectionHandlerInterface.h"
+#include "tsByteBlockPool.h"
 #include "tsETID.h"
 
 namespace ts {
@@ -151,6 +152,36 @@ namespace ts {
             _ts_error_level = level;
         }
 
+        //!
+        //! Enable or disable storm control on corrupted sections.
+        //! On badly received streams, the same corrupted section can loop in a carousel
+        //! and be received thousands of times per second. By default, each occurrence is
+        //! fully analyzed, logged and reported to the invalid section handler, which can
+        //! melt the application exactly when the stream needs attention. When storm
+        //! control is enabled, repetitions of the last corrupted section on a PID are
+        //! detected with a hash of the section content and suppressed with an exponential
+        //! backoff: the CRC32 check, the error log and the invalid section handler run on
+        //! the 1st, 2nd, 4th, 8th, etc. occurrence only. Suppressed occurrences are
+        //! simply counted in Status::inv_sect_suppressed.
+        //! @param [in] on True to enable storm control. This is false by default.
+        //!
+        void setInvalidSectionBackoff(bool on)
+        {
+            _invalid_backoff = on;
+        }
+
+        //!
+        //! Enable or disable a pool of reusable section data buffers.
+        //! Section-heavy streams, typically EIT's, create millions of short-lived
+        //! sections. When the pool is enabled, the data buffers of assembled sections
+        //! are recycled instead of being allocated and deallocated with each section,
+        //! eliminating most heap traffic from the section assembly hot path.
+        //! Sections which are still referenced by the application are never recycled.
+        //! @param [in] on True to use a buffer pool. This is false by default.
+        //! @param [in] max_blocks Maximum number of pooled buffers.
+        //!
+        void setSectionBufferPool(bool on, size_t max_blocks = ByteBlockPool::DEFAULT_MAX_BLOCKS);
+
         //!
         //! Demux status information.
         //! It contains error counters.
@@ -167,6 +198,7 @@ namespace ts {
             uint64_t wrong_crc;        //!< Number of sections with wrong CRC32.
             uint64_t is_next;          //!< Number of sections with "next" flag (not yet applicable).
             uint64_t truncated_sect;   //!< Number of truncated sections.
+            uint64_t inv_sect_suppressed;  //!< Number of invalid section repetitions suppressed by storm control.
 
             //!
             //! Default constructor.
@@ -259,6 +291,9 @@ namespace ts {
             uint8_t       continuity = 0;        // Last continuity counter
             bool          sync = false;          // We are synchronous in this PID
             ByteBlock     ts {};                 // TS payload buffer
+            uint64_t      inv_hash = 0;          // Hash of last section with wrong CRC (storm control)
+            uint64_t      inv_count = 0;         // Number of consecutive occurrences of that section
+            uint64_t      inv_next_report = 0;   // Occurrence count at which the section is analyzed again
             std::map<ETID,ETIDContext> tids {};  // TID analysis contexts
 
             // Default constructor.
@@ -279,11 +314,19 @@ namespace ts {
         SectionHandlerInterface*        _section_handler = nullptr;
         InvalidSectionHandlerInterface* _invalid_handler = nullptr;
         std::map<PID,PIDContext>        _pids {};
+        // Flat per-PID dispatch array for the packet hot path. Points to the entries
+        // of _pids, which are pointer-stable. With the PID filter bitset in
+        // feedPacket(), a packet on an already-known PID costs one load and one
+        // branch to reach its context, without a map lookup per packet.
+        std::array<PIDContext*, PID_MAX> _pid_contexts {};
         Status _status {};
         bool   _get_current = true;
         bool   _get_next = false;
         bool   _track_invalid_version = false;
+        bool   _invalid_backoff = false;
+        bool   _use_buffer_pool = false;
         int    _ts_error_level {Severity::Debug};
+        ByteBlockPool _buffer_pool {};
     };
 }
 
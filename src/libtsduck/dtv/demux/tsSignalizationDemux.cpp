@@ -645,6 +645,12 @@ void ts::SignalizationDemux::handleTable(SectionDemux&, const BinaryTable& table
     const PID pid = table.sourcePID();
     const TID tid = table.tableId();
 
+    // Several table ids share the same PID (SDT/BAT, TDT/TOT, ATSC PSIP, NIT's).
+    // Consequently, the demux delivers tables which were never subscribed.
+    // Tables which feed the internal analysis (services, PID's, time) are always
+    // deserialized. Tables which are only reported to the application handler are
+    // deserialized only when their table id is subscribed, see the individual cases.
+
     switch (tid) {
         case TID_PAT: {
             const PAT pat(_duck, table);
@@ -668,39 +674,65 @@ void ts::SignalizationDemux::handleTable(SectionDemux&, const BinaryTable& table
             break;
         }
         case TID_TSDT: {
-            const TSDT tsdt(_duck, table);
-            if (tsdt.isValid() && pid == PID_TSDT && _handler != nullptr && isFilteredTableId(TID_TSDT)) {
-                _handler->handleTSDT(tsdt, pid);
+            // The TSDT feeds no internal analysis, only the application handler.
+            if (pid == PID_TSDT && _handler != nullptr && isFilteredTableId(tid)) {
+                const TSDT tsdt(_duck, table);
+                if (tsdt.isValid()) {
+                    _handler->handleTSDT(tsdt, pid);
+                }
             }
             break;
         }
-        case TID_NIT_ACT:
-        case TID_NIT_OTH:  {
+        case TID_NIT_ACT: {
             const NIT nit(_duck, table);
             if (nit.isValid() && pid == nitPID()) {
                 handleNIT(nit, pid);
             }
             break;
         }
-        case TID_SDT_ACT:
-        case TID_SDT_OTH:  {
+        case TID_NIT_OTH: {
+            // A NIT Other feeds no internal analysis, only the application handler.
+            if (pid == nitPID() && _handler != nullptr && isFilteredTableId(tid)) {
+                const NIT nit(_duck, table);
+                if (nit.isValid()) {
+                    handleNIT(nit, pid);
+                }
+            }
+            break;
+        }
+        case TID_SDT_ACT: {
             const SDT sdt(_duck, table);
             if (sdt.isValid() && pid == PID_SDT) {
                 handleSDT(sdt, pid);
             }
             break;
         }
+        case TID_SDT_OTH: {
+            // An SDT Other feeds no internal analysis, only the application handler.
+            if (pid == PID_SDT && _handler != nullptr && isFilteredTableId(tid)) {
+                const SDT sdt(_duck, table);
+                if (sdt.isValid()) {
+                    handleSDT(sdt, pid);
+                }
+            }
+            break;
+        }
         case TID_BAT: {
-            const BAT bat(_duck, table);
-            if (bat.isValid() && pid == PID_BAT && _handler != nullptr && isFilteredTableId(tid)) {
-                _handler->handleBAT(bat, pid);
+            // The BAT shares the SDT PID, it is often delivered without being subscribed.
+            if (pid == PID_BAT && _handler != nullptr && isFilteredTableId(tid)) {
+                const BAT bat(_duck, table);
+                if (bat.isValid()) {
+                    _handler->handleBAT(bat, pid);
+                }
             }
             break;
         }
         case TID_RST: {
-            const RST rst(_duck, table);
-            if (rst.isValid() && pid == PID_RST && _handler != nullptr && isFilteredTableId(tid)) {
-                _handler->handleRST(rst, pid);
+            if (pid == PID_RST && _handler != nullptr && isFilteredTableId(tid)) {
+                const RST rst(_duck, table);
+                if (rst.isValid()) {
+                    _handler->handleRST(rst, pid);
+                }
             }
             break;
         }
@@ -752,16 +784,22 @@ void ts::SignalizationDemux::handleTable(SectionDemux&, const BinaryTable& table
             break;
         }
         case TID_RRT: {
-            const RRT rrt(_duck, table);
-            if (rrt.isValid() && pid == PID_PSIP && _handler != nullptr && isFilteredTableId(tid)) {
-                _handler->handleRRT(rrt, pid);
+            // The RRT shares the PSIP base PID, it is often delivered without being subscribed.
+            if (pid == PID_PSIP && _handler != nullptr && isFilteredTableId(tid)) {
+                const RRT rrt(_duck, table);
+                if (rrt.isValid()) {
+                    _handler->handleRRT(rrt, pid);
+                }
             }
             break;
         }
         case TID_SAT: {
-            const SAT sat(_duck, table);
-            if (sat.isValid() && pid == PID_SAT) {
-                handleSAT(sat, pid);
+            // The SAT feeds no internal analysis, only the application handler.
+            if (pid == PID_SAT && _handler != nullptr && isFilteredTableId(tid)) {
+                const SAT sat(_duck, table);
+                if (sat.isValid()) {
+                    handleSAT(sat, pid);
+                }
             }
             break;
         }
@@ -109,12 +109,12 @@ bool ts::AbstractDescriptor::serialize(DuckContext& duck, Descriptor& bin) const
         return false;
     }
     else {
-        // Allocate a byte block of the maximum descriptor size.
-        ByteBlockPtr bbp(new ByteBlock(MAX_DESCRIPTOR_SIZE));
-        CheckNonNull(bbp.pointer());
+        // Serialize in a stack buffer of the maximum descriptor size. This avoids
+        // a heap allocation of the maximum size for each serialized descriptor.
+        uint8_t data[MAX_DESCRIPTOR_SIZE] {};
 
         // Map a serialization buffer over the payload part.
-        PSIBuffer buf(duck, bbp->data() + 2, bbp->size() - 2, false);
+        PSIBuffer buf(duck, data + 2, sizeof(data) - 2, false);
 
         // If this is an extension descriptor, add extended tag.
         const DID etag = extendedTag();
@@ -133,12 +133,11 @@ bool ts::AbstractDescriptor::serialize(DuckContext& duck, Descriptor& bin) const
         else {
             // Update the actual descriptor size.
             const size_t size = buf.currentWriteByteOffset();
-            (*bbp)[0] = _tag;
-            (*bbp)[1] = uint8_t(size);
+            data[0] = _tag;
+            data[1] = uint8_t(size);
 
-            // Resize the byte block and store it into the descriptor.
-            bbp->resize(2 + size);
-            bin = Descriptor(bbp, ShareMode::SHARE);
+            // Store the descriptor, with one exact-size copy.
+            bin = Descriptor(data, 2 + size);
             return true;
         }
     }
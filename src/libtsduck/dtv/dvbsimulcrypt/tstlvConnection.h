@@ -68,6 +68,26 @@ namespace ts {
             //!
             bool send(const Message& msg, Logger& logger);
 
+            //!
+            //! Serialize and send a batch of TLV messages.
+            //! All messages are serialized in one buffer and sent in a single
+            //! TCP operation, reducing the system call overhead for bursts.
+            //! @param [in] msg The messages to send, in order.
+            //! @param [in,out] report Where to report errors.
+            //! @return True on success, false on error.
+            //!
+            bool send(const std::vector<const Message*>& msg, Report& report);
+
+            //!
+            //! Serialize and send a batch of TLV messages.
+            //! All messages are serialized in one buffer and sent in a single
+            //! TCP operation, reducing the system call overhead for bursts.
+            //! @param [in] msg The messages to send, in order.
+            //! @param [in,out] logger Where to report errors and messages.
+            //! @return True on success, false on error.
+            //!
+            bool send(const std::vector<const Message*>& msg, Logger& logger);
+
             //!
             //! Receive a TLV message.
             //! Wait for the message, deserialize it and validate it.
@@ -131,6 +151,7 @@ namespace ts {
             size_t          _invalid_msg_count = 0;
             MUTEX           _send_mutex {};
             MUTEX           _receive_mutex {};
+            ByteBlockPtr    _send_bb {new ByteBlock};  // reusable send buffer, under _send_mutex
         };
     }
 }
@@ -177,12 +198,40 @@ bool ts::tlv::Connection<MUTEX>::send(const Message& msg, Logger& logger)
 {
     logger.log(msg, u"sending message to " + peerName());
 
-    ByteBlockPtr bbp(new ByteBlock);
-    Serializer serial(bbp);
+    // Serialize in the reusable send buffer, its capacity remains allocated.
+    std::lock_guard<MUTEX> lock(_send_mutex);
+    _send_bb->clear();
+    Serializer serial(_send_bb);
     msg.serialize(serial);
 
+    return SuperClass::send(_send_bb->data(), _send_bb->size(), logger.report());
+}
+
+// Serialize and send a batch of TLV messages.
+template <class MUTEX>
+bool ts::tlv::Connection<MUTEX>::send(const std::vector<const Message*>& msg, Report& report)
+{
+    tlv::Logger logger(Severity::Debug, &report);
+    return send(msg, logger);
+}
+
+// Serialize and send a batch of TLV messages.
+template <class MUTEX>
+bool ts::tlv::Connection<MUTEX>::send(const std::vector<const Message*>& msg, Logger& logger)
+{
+    // Serialize all messages back to back in the reusable send buffer.
     std::lock_guard<MUTEX> lock(_send_mutex);
-    return SuperClass::send(bbp->data(), bbp->size(), logger.report());
+    _send_bb->clear();
+    for (const Message* m : msg) {
+        if (m != nullptr) {
+            logger.log(*m, u"sending message to " + peerName());
+            Serializer serial(_send_bb);
+            m->serialize(serial);
+        }
+    }
+
+    // Send the complete batch in one single TCP operation.
+    return _send_bb->empty() || SuperClass::send(_send_bb->data(), _send_bb->size(), logger.report());
 }
 
 // Receive a TLV message (wait for the message, deserialize it and validate it)
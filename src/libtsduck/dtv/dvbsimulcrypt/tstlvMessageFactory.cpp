@@ -127,6 +127,13 @@ void ts::tlv::MessageFactory::analyzeMessage()
         return;
     }
 
+    // Pre-scan the parameter list to reserve the parameter arena in one single allocation.
+    size_t param_count = 0;
+    for (tlv::Analyzer pre_anl(params_list, params_length); !pre_anl.endOfMessage(); pre_anl.next()) {
+        param_count++;
+    }
+    _params.reserve(param_count);
+
     // Analyze the parameters
     tlv::Analyzer parm_anl(params_list, params_length);
 
@@ -153,14 +160,15 @@ void ts::tlv::MessageFactory::analyzeMessage()
         // Store the parameter into the message factory
         if (parm_it->second.compound != nullptr) {
             // The parameter is a compound TLV, analyze it.
-            // Store the parameter value in the multimap for this command.
+            // Store the parameter value in the arena for this command.
             // Analyze the compound parameter.
-            auto it = _params.insert(ParameterMultimap::value_type(parm_tag, ExtParameter(tlv_addr, tlv_size, value_addr, value_length, new MessageFactory(tlv_addr, tlv_size, *parm_it->second.compound))));
+            _params.push_back(TaggedParameter(parm_tag, ExtParameter(tlv_addr, tlv_size, value_addr, value_length, new MessageFactory(tlv_addr, tlv_size, *parm_it->second.compound))));
+            const ExtParameter& ext(_params.back().second);
 
             // Check if the analysis is successful
-            if ((_error_status = it->second.compound->_error_status) != OK) {
-                _error_info = it->second.compound->_error_info;
-                _error_info_is_offset = it->second.compound->_error_info_is_offset;
+            if ((_error_status = ext.compound->_error_status) != OK) {
+                _error_info = ext.compound->_error_info;
+                _error_info_is_offset = ext.compound->_error_info_is_offset;
                 if (_error_info_is_offset) {
                     _error_info += uint16_t(uint8_ptr(tlv_addr) - _msg_base); // offset
                 }
@@ -176,8 +184,8 @@ void ts::tlv::MessageFactory::analyzeMessage()
         }
         else {
             // The parameter is not a compound TLV and its length is fine.
-            // Store the parameter value in the multimap for this command
-            _params.insert(ParameterMultimap::value_type (parm_tag, ExtParameter(tlv_addr, tlv_size, value_addr, value_length)));
+            // Store the parameter value in the arena for this command
+            _params.push_back(TaggedParameter(parm_tag, ExtParameter(tlv_addr, tlv_size, value_addr, value_length)));
         }
 
         // Advance to next parameter
@@ -192,6 +200,10 @@ void ts::tlv::MessageFactory::analyzeMessage()
         return;
     }
 
+    // Sort the parameter arena by tag, preserving the relative order of the
+    // occurences of one tag. All range searches use binary lookups from now on.
+    std::stable_sort(_params.begin(), _params.end(), [](const TaggedParameter& a, const TaggedParameter& b) { return a.first < b.first; });
+
     // At this point, we know that the command is defined in the protocol
     // and that all actual parameters are defined for this command in the
     // protocol. Now, we need to check that all protocol-defined parameters
@@ -203,7 +215,7 @@ void ts::tlv::MessageFactory::analyzeMessage()
         // Protocol-defined parameter properties:
         const Protocol::Parameter& desc(parm_it.second);
         // Number of actual occurences in current command:
-        size_t count = _params.count(tag);
+        size_t count = this->count(tag);
 
         if (count < desc.min_count || count > desc.max_count) {
             if (count == 0 && desc.min_count > 0) {
@@ -220,14 +232,29 @@ void ts::tlv::MessageFactory::analyzeMessage()
 }
 
 
+//----------------------------------------------------------------------------
+// Iterators over the range of occurences of one tag in the sorted _params.
+//----------------------------------------------------------------------------
+
+ts::tlv::MessageFactory::ParameterVector::const_iterator ts::tlv::MessageFactory::lowerBound(TAG tag) const
+{
+    return std::lower_bound(_params.begin(), _params.end(), tag, [](const TaggedParameter& p, TAG t) { return p.first < t; });
+}
+
+ts::tlv::MessageFactory::ParameterVector::const_iterator ts::tlv::MessageFactory::upperBound(TAG tag) const
+{
+    return std::upper_bound(_params.begin(), _params.end(), tag, [](TAG t, const TaggedParameter& p) { return t < p.first; });
+}
+
+
 //----------------------------------------------------------------------------
 // Get location of the first occurence of a parameter:
 //----------------------------------------------------------------------------
 
 void ts::tlv::MessageFactory::get(TAG tag, Parameter& param) const
 {
-    const auto it = _params.find(tag);
-    if (it == _params.end()) {
+    const auto it = lowerBound(tag);
+    if (it == _params.end() || it->first != tag) {
         throw DeserializationInternalError(UString::Format(u"No parameter 0x%X in message", {tag}));
     }
     else {
@@ -244,11 +271,11 @@ void ts::tlv::MessageFactory::get(TAG tag, std::vector<Parameter>& param) const
 {
     // Reinitialize result vector
     param.clear();
-    param.reserve(_params.count(tag));
+    param.reserve(count(tag));
 
     // Fill vector with parameter values
-    const auto last = _params.upper_bound(tag);
-    for (auto it = _params.lower_bound(tag); it != last; ++it) {
+    const auto last = upperBound(tag);
+    for (auto it = lowerBound(tag); it != last; ++it) {
         param.push_back(it->second);
     }
 }
@@ -262,10 +289,10 @@ void ts::tlv::MessageFactory::get(TAG tag, std::vector<bool>& param) const
 {
     // Reinitialize result vector
     param.clear();
-    param.reserve(_params.count(tag));
+    param.reserve(count(tag));
     // Fill vector with parameter values
-    const auto last = _params.upper_bound(tag);
-    for (auto it = _params.lower_bound(tag); it != last; ++it) {
+    const auto last = upperBound(tag);
+    for (auto it = lowerBound(tag); it != last; ++it) {
         checkParamSize<uint8_t> (tag, it);
         param.push_back(GetUInt8(it->second.addr) != 0);
     }
@@ -280,10 +307,10 @@ void ts::tlv::MessageFactory::get(TAG tag, std::vector<std::string>& param) cons
 {
     // Reinitialize result vector
     param.clear();
-    param.resize(_params.count(tag));
+    param.resize(count(tag));
     // Fill vector with parameter values
-    auto it = _params.lower_bound(tag);
-    const auto last = _params.upper_bound(tag);
+    auto it = lowerBound(tag);
+    const auto last = upperBound(tag);
     for (int i = 0; it != last; ++it, ++i) {
         param[i].assign(static_cast<const char*>(it->second.addr), it->second.length);
     }
@@ -296,8 +323,8 @@ void ts::tlv::MessageFactory::get(TAG tag, std::vector<std::string>& param) cons
 
 void ts::tlv::MessageFactory::getCompound(TAG tag, MessagePtr& param) const
 {
-    const auto it = _params.find(tag);
-    if (it == _params.end()) {
+    const auto it = lowerBound(tag);
+    if (it == _params.end() || it->first != tag) {
         throw DeserializationInternalError(UString::Format(u"No parameter 0x%X in message", {tag}));
     }
     else if (it->second.compound.isNull()) {
@@ -317,10 +344,10 @@ void ts::tlv::MessageFactory::getCompound(TAG tag, std::vector<MessagePtr>& para
 {
     // Reinitialize result vector
     param.clear();
-    param.resize(_params.count(tag));
+    param.resize(count(tag));
     // Fill vector with parameter values
-    auto it = _params.lower_bound(tag);
-    const auto last = _params.upper_bound(tag);
+    auto it = lowerBound(tag);
+    const auto last = upperBound(tag);
     for (int i = 0; it != last; ++it, ++i) {
         if (it->second.compound.isNull()) {
             throw DeserializationInternalError(UString::Format(u"Occurence %d of parameter 0x%X not a compound TLV", {i, tag}));
@@ -172,7 +172,7 @@ namespace ts {
             //! @param [in] tag Parameter tag to search.
             //! @return The actual number of occurences of a parameter.
             //!
-            size_t count(TAG tag) const { return _params.count(tag); }
+            size_t count(TAG tag) const { return size_t(upperBound(tag) - lowerBound(tag)); }
 
             //!
             //! Get the location of a parameter.
@@ -313,9 +313,18 @@ namespace ts {
             VERSION         _protocol_version = 0;
             TAG             _command_tag = 0;
 
-            // Location of actual parameters. Point into the message block.
-            typedef std::multimap <TAG, ExtParameter> ParameterMultimap;
-            ParameterMultimap _params {};
+            // Location of actual parameters. The parameter views point into the message
+            // block (zero-copy) and are stored in a flat vector which is sorted by tag
+            // once at the end of the analysis. The vector acts as an arena: one single
+            // allocation covers all parameters of a message, instead of one node per
+            // parameter with an associative container.
+            typedef std::pair<TAG, ExtParameter> TaggedParameter;
+            typedef std::vector<TaggedParameter> ParameterVector;
+            ParameterVector _params {};
+
+            // Iterators over the range of occurences of one tag in the sorted _params.
+            ParameterVector::const_iterator lowerBound(TAG tag) const;
+            ParameterVector::const_iterator upperBound(TAG tag) const;
 
             // Analyze the TLV message, called by constructors.
             void analyzeMessage();
@@ -328,7 +337,7 @@ namespace ts {
             // Should never throw an exception, except bug in the
             // constructor of the Message subclasses.
             template <typename T>
-            void checkParamSize(TAG, const ParameterMultimap::const_iterator&) const;
+            void checkParamSize(TAG, const ParameterVector::const_iterator&) const;
         };
 
         // Template specializations for performance.
@@ -346,7 +355,7 @@ namespace ts {
 
 // Internal method: Check the size of a parameter.
 template <typename T>
-void ts::tlv::MessageFactory::checkParamSize(TAG tag, const ParameterMultimap::const_iterator& it) const
+void ts::tlv::MessageFactory::checkParamSize(TAG tag, const ParameterVector::const_iterator& it) const
 {
     const size_t expected = dataSize<T>();
     if (it->second.length != expected) {
@@ -358,8 +367,8 @@ void ts::tlv::MessageFactory::checkParamSize(TAG tag, const ParameterMultimap::c
 template <typename INT, typename std::enable_if<std::is_integral<INT>::value>::type*>
 INT ts::tlv::MessageFactory::get(TAG tag) const
 {
-    const auto it = _params.find(tag);
-    if (it == _params.end()) {
+    const auto it = lowerBound(tag);
+    if (it == _params.end() || it->first != tag) {
         throw DeserializationInternalError(UString::Format(u"No parameter 0x%X in message", {tag}));
     }
     else {
@@ -374,10 +383,10 @@ void ts::tlv::MessageFactory::get(TAG tag, std::vector<INT>& param) const
 {
     // Reinitialize result vector
     param.clear();
-    param.reserve(_params.count(tag));
+    param.reserve(count(tag));
     // Fill vector with parameter values
-    const auto last = _params.upper_bound (tag);
-    for (auto it = _params.lower_bound(tag); it != last; ++it) {
+    const auto last = upperBound(tag);
+    for (auto it = lowerBound(tag); it != last; ++it) {
         checkParamSize<INT>(tag, it);
         param.push_back(GetInt<INT>(it->second.addr));
     }
@@ -403,8 +412,8 @@ void ts::tlv::MessageFactory::getCompound(TAG tag, std::vector<MSG>& param) cons
     // Reinitialize result vector
     param.clear();
     // Fill vector with parameter values
-    auto it = _params.lower_bound(tag);
-    const auto last = _params.upper_bound(tag);
+    auto it = lowerBound(tag);
+    const auto last = upperBound(tag);
     for (int i = 0; it != last; ++it, ++i) {
         if (it->second.compound.isNull()) {
             throw DeserializationInternalError(UString::Format(u"Occurence %d of parameter 0x%X not a compound TLV", {i, tag}));
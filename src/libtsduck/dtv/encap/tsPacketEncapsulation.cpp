@@ -18,6 +18,7 @@ ts::PacketEncapsulation::PacketEncapsulation(PID pidOutput, const PIDSet& pidInp
     _pidInput(pidInput),
     _pcrReference(pcrReference)
 {
+    updateOuterHeader();
 }
 
 
@@ -42,6 +43,7 @@ void ts::PacketEncapsulation::reset(PID pidOutput, const PIDSet& pidInput, PID p
     _lateDistance = 0;
     _lateIndex = 0;
     _latePackets.clear();
+    updateOuterHeader();
     resetPCR();
 }
 
@@ -61,6 +63,7 @@ void ts::PacketEncapsulation::setOutputPID(PID pid)
         _lateDistance = 0;
         _lateIndex = 0;
         _latePackets.clear();
+        updateOuterHeader();
     }
 }
 
@@ -90,6 +93,22 @@ void ts::PacketEncapsulation::setReferencePCR(PID pid)
 }
 
 
+//----------------------------------------------------------------------------
+// Update the precomputed outer packet header after changing the output PID.
+//----------------------------------------------------------------------------
+
+void ts::PacketEncapsulation::updateOuterHeader()
+{
+    // Sync byte, no error, no PUSI, no priority, output PID, not scrambled,
+    // payload only, CC zero. The PUSI bit and the continuity counter are
+    // patched in place on each outer packet.
+    _outerHeader[0] = SYNC_BYTE;
+    _outerHeader[1] = uint8_t(_pidOutput >> 8) & 0x1F;
+    _outerHeader[2] = uint8_t(_pidOutput);
+    _outerHeader[3] = 0x10;
+}
+
+
 //----------------------------------------------------------------------------
 // Reset PCR information, lost synchronization.
 //----------------------------------------------------------------------------
@@ -240,6 +259,46 @@ bool ts::PacketEncapsulation::processPacket(TSPacket& pkt)
         }
         if (packout || addBytes >= PKT_SIZE - (addPCR ? 12 : 4) - 1) {
 
+            // Fast path for the most common configuration: plain encapsulation
+            // (no PES envelope), no PCR to insert, no stuffing needed. The
+            // 4-byte header comes from the precomputed template and the payload
+            // is directly copied from the queued packets, without the full
+            // packet initialization and field-by-field header construction of
+            // the general case below.
+            if (_pesMode == DISABLED && !addPCR && !(_latePackets.size() == 1 && _lateIndex > 4)) {
+
+                // Copy the header template and patch the continuity counter.
+                std::memcpy(pkt.b, _outerHeader, 4);
+                pkt.b[3] |= _ccOutput;
+                _ccOutput = (_ccOutput + 1) & CC_MASK;
+
+                // Index in pkt where we write data, after the 4-byte header.
+                size_t pktIndex = 4;
+
+                // Insert PUSI and pointer field when necessary, same logic as the general case.
+                if (_lateIndex == 1) {
+                    // We immediately start with the start of a packet.
+                    pkt.b[1] |= 0x40;      // PUSI
+                    pkt.b[pktIndex++] = 0; // pointer field
+                }
+                else if (_lateIndex > pktIndex + 1 && _latePackets.size() > 1) {
+                    // The remaining bytes in the first packet are less than the output payload,
+                    // we will start a new packet in this payload.
+                    pkt.b[1] |= 0x40;                                   // PUSI
+                    pkt.b[pktIndex++] = uint8_t(PKT_SIZE - _lateIndex); // pointer field
+                }
+
+                // Copy the payload from the first queued packet, then from the next one.
+                fillPacket(pkt, pktIndex);
+                if (pktIndex < PKT_SIZE) {
+                    fillPacket(pkt, pktIndex);
+                }
+                assert(pktIndex == PKT_SIZE);
+
+                _currentPacket++;
+                return status;
+            }
+
             // Build the new packet.
             pkt.init(_pidOutput, _ccOutput);
 
@@ -307,6 +307,10 @@ namespace ts {
         size_t           _lateMaxPackets = DEFAULT_MAX_BUFFERED_PACKETS;  // Maximum number of packets in _latePackets.
         size_t           _lateIndex = 0;           // Index in first late packet.
         TSPacketPtrQueue _latePackets {};          // Packets to insert later.
+        uint8_t          _outerHeader[4] {};       // Precomputed header template of outer packets.
+
+        // Update the precomputed outer packet header after changing the output PID.
+        void updateOuterHeader();
 
         // Reset PCR information, lost synchronization.
         void resetPCR();
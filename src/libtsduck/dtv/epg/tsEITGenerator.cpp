@@ -65,6 +65,41 @@ void ts::EITGenerator::reset()
     _last_tid = TID_NULL;
     _obsolete_count = 0;
     _versions.clear();
+
+    // Drop binary events which are no longer referenced by any instance.
+    EventStore::Instance().purge();
+}
+
+
+//----------------------------------------------------------------------------
+// Remove one service from the EPG database.
+//----------------------------------------------------------------------------
+
+void ts::EITGenerator::resetService(const ServiceIdTriplet& service)
+{
+    const auto it = _services.find(service);
+    if (it != _services.end()) {
+
+        // Mark all sections of the service as obsolete. The sections which are
+        // queued for injection will be discarded when their turn comes.
+        EService& srv(it->second);
+        for (size_t i = 0; i < srv.pf.size(); ++i) {
+            if (!srv.pf[i].isNull()) {
+                markObsoleteSection(*srv.pf[i]);
+            }
+        }
+        for (const auto& seg : srv.segments) {
+            markObsoleteSegment(*seg);
+        }
+
+        // Remove the service and its events. The version numbers of its sections are
+        // intentionally preserved: if the service is reloaded later, the EIT versions
+        // continue from where they were and receivers notice the update.
+        _services.erase(it);
+
+        // Drop binary events which are no longer referenced by any instance.
+        EventStore::Instance().purge();
+    }
 }
 
 
@@ -81,7 +116,7 @@ ts::EITGenerator::Event::Event(const uint8_t*& data, size_t& size)
         event_id = GetUInt16(data);
         DecodeMJD(data + 2, 5, start_time);
         end_time = start_time + (MilliSecPerHour * DecodeBCD(data[7])) + (MilliSecPerMin * DecodeBCD(data[8])) + (MilliSecPerSec * DecodeBCD(data[9]));
-        event_data.copy(data, event_size);
+        event_data = EventStore::Instance().store(data, event_size);
     }
 
     data += event_size;
@@ -219,7 +254,7 @@ bool ts::EITGenerator::loadEvents(const ServiceIdTriplet& service_id, const uint
 
         // Get the next binary event.
         const EventPtr ev(new Event(data, size));
-        if (ev->event_data.empty()) {
+        if (ev->event_data.isNull()) {
             _duck.report().error(u"error loading EPG event, truncated data");
             success = false;
             break;
@@ -265,7 +300,8 @@ bool ts::EITGenerator::loadEvents(const ServiceIdTriplet& service_id, const uint
         while (ev_iter != seg.events.end() && (*ev_iter)->start_time < ev->start_time) {
             ++ev_iter;
         }
-        if (ev_iter != seg.events.end() && (*ev_iter)->event_id == ev->event_id && (*ev_iter)->event_data == ev->event_data) {
+        // Since event data are deduplicated, identical binary events reference the same data.
+        if (ev_iter != seg.events.end() && (*ev_iter)->event_id == ev->event_id && (*ev_iter)->event_data.pointer() == ev->event_data.pointer()) {
             // Duplicate event, ignore it.
             continue;
         }
@@ -765,7 +801,7 @@ bool ts::EITGenerator::regeneratePresentFollowingSection(const ServiceIdTriplet&
         // The initial state of the section is: no event, no CRC.
         if (!event.isNull()) {
             // Append the event in the payload.
-            sec->section->appendPayload(event->event_data, false);
+            sec->section->appendPayload(*event->event_data, false);
         }
         if (!(_options & EITOptions::SYNC_VERSIONS)) {
             sec->section->recomputeCRC();
@@ -787,15 +823,15 @@ bool ts::EITGenerator::regeneratePresentFollowingSection(const ServiceIdTriplet&
             return true;
         }
     }
-    else if (sec->section->payloadSize() != EIT::EIT_PAYLOAD_FIXED_SIZE + event->event_data.size() ||
-             std::memcmp(sec->section->payload() + EIT::EIT_PAYLOAD_FIXED_SIZE, event->event_data.data(), event->event_data.size()) != 0)
+    else if (sec->section->payloadSize() != EIT::EIT_PAYLOAD_FIXED_SIZE + event->event_data->size() ||
+             std::memcmp(sec->section->payload() + EIT::EIT_PAYLOAD_FIXED_SIZE, event->event_data->data(), event->event_data->size()) != 0)
     {
         // The section already exists. It must be already in an injection queue.
         // The event is not the same as the one in the section, update the section.
         sec->startModifying();
         sec->section->setTableId(tid, false);
         sec->section->truncatePayload(EIT::EIT_PAYLOAD_FIXED_SIZE, false);
-        sec->section->appendPayload(event->event_data, false);
+        sec->section->appendPayload(*event->event_data, false);
         sec->updateVersion(this, true);
         // Section was modified.
         return true;
@@ -847,16 +883,25 @@ void ts::EITGenerator::regenerateSchedule(const Time& now)
             // Check if EIT schedule are needed for the service.
             const bool need_eits = bool(_options & GEN_SCHED);
 
+            // Track if the section layout of the service changed: segments added or removed,
+            // or a different number of sections in a regenerated segment. When the structure
+            // is unchanged, the synthetic fields (last_section_number, segment_last_section_number,
+            // last_table_id) of untouched segments cannot have changed and these sections are
+            // kept as is, without being re-inspected, re-encoded or re-CRCed.
+            bool structure_changed = false;
+
             // Remove initial segments before last midnight.
             while (!srv.segments.empty() && srv.segments.front()->start_time < last_midnight) {
                 markObsoleteSegment(*srv.segments.front());
                 srv.segments.pop_front();
+                structure_changed = true;
             }
 
             // Remove final empty segments (no events). Keep at least one segment for last midnight, even if empty.
             while (!srv.segments.empty() && srv.segments.back()->events.empty() && srv.segments.back()->start_time > last_midnight) {
                 markObsoleteSegment(*srv.segments.back());
                 srv.segments.pop_back();
+                structure_changed = true;
             }
 
             // Make sure that the first segment exists for last midnight.
@@ -865,6 +910,7 @@ void ts::EITGenerator::regenerateSchedule(const Time& now)
                 const ESegmentPtr seg(new ESegment(last_midnight));
                 CheckNonNull(seg.pointer());
                 srv.segments.push_front(seg);
+                structure_changed = true;
             }
 
             // Loop on all segments. The first segment must be at last midnight.
@@ -879,9 +925,13 @@ void ts::EITGenerator::regenerateSchedule(const Time& now)
                     const ESegmentPtr seg(new ESegment(segment_start_time));
                     CheckNonNull(seg.pointer());
                     seg_iter = srv.segments.insert(seg_iter, seg);
+                    structure_changed = true;
                 }
                 ESegment& seg(**seg_iter);
 
+                // Number of sections in the segment before regeneration.
+                const size_t previous_section_count = seg.sections.size();
+
                 if (!need_eits) {
                     // We do not need EIT schedule here, delete all sections.
                     markObsoleteSegment(seg);
@@ -907,8 +957,8 @@ void ts::EITGenerator::regenerateSchedule(const Time& now)
                         size_t pl_size = section_still_valid ? (*sec_iter)->section->payloadSize() - EIT::EIT_PAYLOAD_FIXED_SIZE : 0;
 
                         while (section_still_valid && pl_size > 0 && ev_iter != seg.events.end()) {
-                            const uint8_t* ev = (*ev_iter)->event_data.data();
-                            const size_t ev_size = (*ev_iter)->event_data.size();
+                            const uint8_t* ev = (*ev_iter)->event_data->data();
+                            const size_t ev_size = (*ev_iter)->event_data->size();
                             section_still_valid = pl_size >= ev_size && std::memcmp(pl, ev, ev_size) == 0;
                             if (section_still_valid) {
                                 ++ev_iter;
@@ -919,7 +969,7 @@ void ts::EITGenerator::regenerateSchedule(const Time& now)
                         if (section_still_valid) {
                             // If the next event exists and could fit in the section, then the section is no longer valid.
                             section_still_valid = ev_iter == seg.events.end() ||
-                                (*sec_iter)->section->payloadSize() + (*ev_iter)->event_data.size() > MAX_PRIVATE_LONG_SECTION_PAYLOAD_SIZE;
+                                (*sec_iter)->section->payloadSize() + (*ev_iter)->event_data->size() > MAX_PRIVATE_LONG_SECTION_PAYLOAD_SIZE;
                         }
 
                         // If the current section is still valid, skip those events and move to next section.
@@ -950,9 +1000,9 @@ void ts::EITGenerator::regenerateSchedule(const Time& now)
                         ev_iter = saved_ev_iter;
 
                         // Insert events in the section, as long as they fit.
-                        while (ev_iter != seg.events.end() && sec->section->payloadSize() + (*ev_iter)->event_data.size() <= MAX_PRIVATE_LONG_SECTION_PAYLOAD_SIZE) {
+                        while (ev_iter != seg.events.end() && sec->section->payloadSize() + (*ev_iter)->event_data->size() <= MAX_PRIVATE_LONG_SECTION_PAYLOAD_SIZE) {
                             // Append the event to the section payload.
-                            sec->section->appendPayload((*ev_iter)->event_data, false);
+                            sec->section->appendPayload(*(*ev_iter)->event_data, false);
                             ++ev_iter;
                         }
 
@@ -987,8 +1037,14 @@ void ts::EITGenerator::regenerateSchedule(const Time& now)
                     }
                 }
 
-                // Clear segment regeneration flag.
-                seg.regenerate = false;
+                // A different number of sections changes the section numbering in the rest of the service.
+                structure_changed = structure_changed || seg.sections.size() != previous_section_count;
+
+                // Without EIT schedule, clear the segment regeneration flag now. With EIT schedule,
+                // keep it for the synthetic fields pass below, where it is cleared.
+                if (!need_eits) {
+                    seg.regenerate = false;
+                }
 
                 // Time and index of next expected segment:
                 segment_start_time += EIT::SEGMENT_DURATION;
@@ -1024,28 +1080,34 @@ void ts::EITGenerator::regenerateSchedule(const Time& now)
                         // Last segment.
                         last_table_id = table_id;
                     }
-                    for (const auto& sec_iter : seg.sections) {
-                        ESection& sec(*sec_iter);
-                        const uint8_t* pl = sec.section->payload();
-                        if (sec.section->sectionNumber() != section_number ||
-                            sec.section->lastSectionNumber() != last_section_number ||
-                            pl[4] != segment_last_section_number ||
-                            pl[5] != last_table_id)
-                        {
-                            if (sec.section->sectionNumber() != section_number) {
-                                sec.section->setSectionNumber(section_number, false);
-                                sec.updateVersion(this, true);
-                            }
-                            sec.section->setLastSectionNumber(last_section_number, false);
-                            sec.section->setUInt8(4, segment_last_section_number, false);
-                            sec.section->setUInt8(5, last_table_id, !sync_versions);
-                            if (sync_versions) {
-                                sync_tids.insert(table_id);
+                    // When the structure of the service is unchanged, the synthetic fields of
+                    // untouched segments cannot have changed, do not re-inspect their sections.
+                    if (structure_changed || seg.regenerate) {
+                        for (const auto& sec_iter : seg.sections) {
+                            ESection& sec(*sec_iter);
+                            const uint8_t* pl = sec.section->payload();
+                            if (sec.section->sectionNumber() != section_number ||
+                                sec.section->lastSectionNumber() != last_section_number ||
+                                pl[4] != segment_last_section_number ||
+                                pl[5] != last_table_id)
+                            {
+                                if (sec.section->sectionNumber() != section_number) {
+                                    sec.section->setSectionNumber(section_number, false);
+                                    sec.updateVersion(this, true);
+                                }
+                                sec.section->setLastSectionNumber(last_section_number, false);
+                                sec.section->setUInt8(4, segment_last_section_number, false);
+                                sec.section->setUInt8(5, last_table_id, !sync_versions);
+                                if (sync_versions) {
+                                    sync_tids.insert(table_id);
+                                }
+                                assert(sec.section->sectionNumber() <= sec.section->lastSectionNumber());
                             }
-                            assert(sec.section->sectionNumber() <= sec.section->lastSectionNumber());
+                            section_number++;
                         }
-                        section_number++;
                     }
+                    // Clear segment regeneration flag.
+                    seg.regenerate = false;
                 }
             }
 
@@ -1337,7 +1399,7 @@ void ts::EITGenerator::dumpInternalState(int lev) const
                 rep.log(lev, u"    Events:");
                 for (const auto& it3 : it2->events) {
                     const Event& ev(*it3);
-                    rep.log(lev, u"    - Event id: 0x%X, start: %s, end: %s, %d bytes", {ev.event_id, ev.start_time, ev.end_time, ev.event_data.size()});
+                    rep.log(lev, u"    - Event id: 0x%X, start: %s, end: %s, %d bytes", {ev.event_id, ev.start_time, ev.end_time, ev.event_data->size()});
                 }
                 rep.log(lev, u"    Sections:");
                 for (const auto& it3 : it2->sections) {
@@ -14,6 +14,7 @@
 #pragma once
 #include "tsEITOptions.h"
 #include "tsEITRepetitionProfile.h"
+#include "tsEventStore.h"
 #include "tsSectionFile.h"
 #include "tsSectionDemux.h"
 #include "tsPacketizer.h"
@@ -147,6 +148,10 @@ namespace ts {
     //!   - When an EIT section needs to be injected, we check the global "regenerate" flag. When
     //!     set, all services and segments are inspected and regenerated when necessary. All "regenerate"
     //!     flags are then cleared.
+    //!   - Inside a regenerated segment, leading sections whose events did not change are kept
+    //!     with their CRC32. When the section layout of the service is unchanged (no segment
+    //!     added or removed, same number of sections per segment), the sections of untouched
+    //!     segments are not even re-inspected.
     //!
     //! @see ETSI EN 300 468, 5.2.4
     //! @see ETSI TS 101 211, 4.1.4
@@ -177,6 +182,16 @@ namespace ts {
         //!
         void reset();
 
+        //!
+        //! Remove one service from the EPG database.
+        //! All events of the service are deleted and its generated EIT sections are discarded.
+        //! Other services are left untouched. Combined with loadEvents() and saveEITs(), this
+        //! allows incremental updates of a large EPG: reload the event files of the modified
+        //! services only, instead of rebuilding the complete database.
+        //! @param [in] service The description of the service to remove.
+        //!
+        void resetService(const ServiceIdTriplet& service);
+
         //!
         //! Set new EIT generation options.
         //! If EIT generation is already started, existing EIT's are not affected.
@@ -340,7 +355,12 @@ namespace ts {
             uint16_t  event_id = 0;   // Event id.
             Time      start_time {};  // Decoded event start time.
             Time      end_time {};    // Decoded event end time.
-            ByteBlock event_data {};  // Binary event data, from event_id to end of descriptor loop.
+
+            // Binary event data, from event_id to end of descriptor loop.
+            // The data are immutable and deduplicated in the shared EventStore:
+            // identical events in several EITGenerator instances reference the
+            // same binary copy. Null when the event is invalid.
+            EventStore::EventDataPtr event_data {};
 
             // Constructor based on EIT section payload: extract the next event.
             // The data and size are updated after building the event.
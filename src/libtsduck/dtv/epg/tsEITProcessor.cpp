@@ -40,6 +40,11 @@ void ts::EITProcessor::reset()
     _removed.clear();
     _kept.clear();
     _renamed.clear();
+    _lazy_latched = false;
+    _lazy_active = false;
+    _pending.clear();
+    _pending_head = 0;
+    lazyClearSection();
 }
 
 
@@ -106,12 +111,235 @@ void ts::EITProcessor::setMaxBufferedSections(size_t count)
 void ts::EITProcessor::processPacket(TSPacket& pkt)
 {
     if (_input_pids.test(pkt.getPID())) {
-        _demux.feedPacket(pkt);
-        _packetizer.getNextPacket(pkt);
+        // Select the processing path on the first packet. The pass-through mode
+        // is usable only when all transformations preserve the section sizes.
+        if (!_lazy_latched) {
+            _lazy_latched = true;
+            _lazy_active = _lazy_rewrite &&
+                _removed_tids.empty() && _removed.empty() && _kept.empty() &&
+                _input_pids.count() == 1 && _input_pids.test(_output_pid);
+        }
+        if (_lazy_active) {
+            processPacketLazy(pkt);
+        }
+        else {
+            _demux.feedPacket(pkt);
+            _packetizer.getNextPacket(pkt);
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Pass-through mode: process one packet from the single input PID.
+//----------------------------------------------------------------------------
+
+void ts::EITProcessor::processPacketLazy(TSPacket& pkt)
+{
+    // Delay a copy of the original packet.
+    _pending.push_back(PendingPacket(pkt));
+    const uint64_t pkt_index = _pending_head + _pending.size() - 1;
+
+    const size_t header_size = pkt.getHeaderSize();
+    const uint8_t* const pl = pkt.getPayload();
+    const size_t pl_size = pkt.getPayloadSize();
+    size_t p = 0;
+
+    if (pl_size > 0 && pkt.getPUSI()) {
+        // The pointer field gives the offset of the first section in the payload.
+        const size_t pf = pl[0];
+        p = 1 + pf;
+        if (p > pl_size) {
+            // Invalid pointer field.
+            lazyResync();
+            p = pl_size;
+        }
+        else if (_in_section) {
+            // The bytes before the pointed offset terminate the section in flight.
+            const size_t done = lazyFeed(pkt_index, header_size + 1, pl + 1, pf);
+            if (done < pf || _in_section) {
+                // The section in flight does not end exactly on the pointed offset.
+                lazyResync();
+            }
+        }
+        // When there is no section in flight, the bytes before the pointed offset
+        // are the tail of a section from before we joined the stream, let them go.
+    }
+    else if (pl_size > 0 && _in_section) {
+        // Without PUSI, the payload can only continue the section in flight,
+        // optionally followed by stuffing when the section ends in this packet.
+        p = lazyFeed(pkt_index, header_size, pl, pl_size);
+        if (_in_section && p < pl_size) {
+            lazyResync();
+            p = pl_size;
+        }
+    }
+    else {
+        // Stuffing, no payload or not yet synchronized, pass through.
+        p = pl_size;
+    }
+
+    // Sections start back-to-back in the rest of the payload, until stuffing.
+    while (p < pl_size && pl[p] != 0xFF) {
+        _in_section = true;
+        p += lazyFeed(pkt_index, header_size + p, pl + p, pl_size - p);
+    }
+
+    // Output the front pending packet when fully decided, else a null packet.
+    // The backlog is bounded by the packet span of one maximum size section.
+    if (!_pending.empty() && _pending.front().undecided == 0) {
+        pkt = _pending.front().packet;
+        _pending.pop_front();
+        _pending_head++;
+    }
+    else {
+        pkt = NullPacket;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Pass-through mode: feed bytes of the section in flight, return used size.
+//----------------------------------------------------------------------------
+
+size_t ts::EITProcessor::lazyFeed(uint64_t pkt_index, size_t offset, const uint8_t* data, size_t size)
+{
+    size_t consumed = 0;
+    while (consumed < size && _in_section) {
+        // Accumulate the section prefix until the affected status can be decided,
+        // then buffer the complete content of affected sections only.
+        size_t chunk = 0;
+        if (_sect_total == 0) {
+            // Section size still unknown, accumulate the 3-byte header.
+            chunk = std::min(size - consumed, 3 - _sect_got);
+            _sect_data.append(data + consumed, chunk);
+        }
+        else if (!_sect_decided) {
+            chunk = std::min(size - consumed, std::min<size_t>(12, _sect_total) - _sect_got);
+            _sect_data.append(data + consumed, chunk);
+        }
+        else {
+            chunk = std::min(size - consumed, _sect_total - _sect_got);
+            if (_sect_affected) {
+                _sect_data.append(data + consumed, chunk);
+            }
+        }
+        lazyAddSegment(pkt_index, offset + consumed, chunk);
+        _sect_got += chunk;
+        consumed += chunk;
+
+        if (_sect_total == 0 && _sect_got == 3) {
+            _sect_total = 3 + (GetUInt16(_sect_data.data() + 1) & 0x0FFF);
+        }
+        if (_sect_total != 0) {
+            if (!_sect_decided && _sect_got >= std::min<size_t>(12, _sect_total)) {
+                lazyDecide();
+            }
+            if (_sect_got >= _sect_total) {
+                lazyComplete();
+            }
+        }
+    }
+    return consumed;
+}
+
+
+//----------------------------------------------------------------------------
+// Pass-through mode: record where the section in flight has bytes.
+//----------------------------------------------------------------------------
+
+void ts::EITProcessor::lazyAddSegment(uint64_t pkt_index, size_t offset, size_t size)
+{
+    // The bytes of one section inside one packet are always contiguous.
+    if (!_sect_segs.empty() && _sect_segs.back().packet == pkt_index && _sect_segs.back().offset + _sect_segs.back().size == offset) {
+        _sect_segs.back().size += size;
+    }
+    else {
+        SectionSegment seg;
+        seg.packet = pkt_index;
+        seg.offset = offset;
+        seg.size = size;
+        _sect_segs.push_back(seg);
+        // One more undecided section in this packet.
+        _pending[size_t(pkt_index - _pending_head)].undecided++;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Pass-through mode: decide if the section in flight must be rewritten.
+//----------------------------------------------------------------------------
+
+void ts::EITProcessor::lazyDecide()
+{
+    _sect_decided = true;
+    const uint8_t* const data = _sect_data.data();
+    const TID tid = data[0];
+    // Only EIT's with a long header and at least 4 payload bytes can be affected.
+    // Use the fact that all EIT ids are contiguous.
+    if (tid >= TID_EIT_PF_ACT && tid <= TID_EIT_S_OTH_MAX && _sect_total >= 12) {
+        const uint16_t srv_id = GetUInt16(data + 3);
+        const uint16_t ts_id  = GetUInt16(data + 8);
+        const uint16_t net_id = GetUInt16(data + 10);
+        _sect_affected = _start_time_offset != 0;
+        for (auto it = _renamed.begin(); !_sect_affected && it != _renamed.end(); ++it) {
+            _sect_affected = Match(it->first, srv_id, ts_id, net_id);
+        }
     }
 }
 
 
+//----------------------------------------------------------------------------
+// Pass-through mode: the section in flight is complete.
+//----------------------------------------------------------------------------
+
+void ts::EITProcessor::lazyComplete()
+{
+    if (_sect_affected) {
+        // Rebuild only this section and patch it in place in the delayed packets.
+        Section sec(_sect_data, _output_pid, CRC32::IGNORE);
+        if (sec.isValid() && updateEIT(sec) && sec.size() == _sect_data.size()) {
+            const uint8_t* content = sec.content();
+            for (const auto& seg : _sect_segs) {
+                std::memcpy(_pending[size_t(seg.packet - _pending_head)].packet.b + seg.offset, content, seg.size);
+                content += seg.size;
+            }
+        }
+    }
+    // The delayed packets no longer wait for this section.
+    for (const auto& seg : _sect_segs) {
+        _pending[size_t(seg.packet - _pending_head)].undecided--;
+    }
+    lazyClearSection();
+}
+
+
+//----------------------------------------------------------------------------
+// Pass-through mode: lost the section structure, resynchronize on next PUSI.
+//----------------------------------------------------------------------------
+
+void ts::EITProcessor::lazyResync()
+{
+    // Drop the analysis of the section in flight and let its packets pass through.
+    _duck.report().debug(u"EIT processor lost section synchronization in pass-through mode");
+    for (const auto& seg : _sect_segs) {
+        _pending[size_t(seg.packet - _pending_head)].undecided--;
+    }
+    lazyClearSection();
+}
+
+void ts::EITProcessor::lazyClearSection()
+{
+    _in_section = false;
+    _sect_decided = false;
+    _sect_affected = false;
+    _sect_total = 0;
+    _sect_got = 0;
+    _sect_data.clear();
+    _sect_segs.clear();
+}
+
+
 //----------------------------------------------------------------------------
 // Implementation of SectionProviderInterface.
 //----------------------------------------------------------------------------
@@ -339,55 +567,7 @@ void ts::EITProcessor::handleSection(SectionDemux& demux, const Section& section
 
     // Update the section if this is an EIT.
     if (is_eit) {
-        // Recompute CRC at end only.
-        bool modified = false;
-
-        // Rename EIT's.
-        for (const auto& it : _renamed) {
-            if (Match(it.first, srv_id, ts_id, net_id)) {
-                // Rename the specified fields.
-                if (it.second.hasId()) {
-                    modified = true;
-                    sp->setTableIdExtension(it.second.getId(), false);
-                }
-                if (it.second.hasTSId()) {
-                    modified = true;
-                    sp->setUInt16(0, it.second.getTSId(), false);
-                }
-                if (it.second.hasONId()) {
-                    modified = true;
-                    sp->setUInt16(2, it.second.getONId(), false);
-                }
-            }
-        }
-
-        // Update all events start times.
-        if (_start_time_offset != 0) {
-            uint8_t* data = const_cast<uint8_t*>(sp->payload() + 6);
-            const uint8_t* const end = sp->payload() + sp->payloadSize();
-            while (data + 12 <= end) {
-                // Update event start time.
-                Time time;
-                if (!DecodeMJD(data + 2, MJD_SIZE, time)) {
-                    _duck.report().warning(u"error decoding event start time from EIT");
-                }
-                else {
-                    time += _start_time_offset;
-                    if (!EncodeMJD(time, data + 2, _date_only ? MJD_MIN_SIZE : MJD_SIZE)) {
-                        _duck.report().warning(u"error encoding event start time into EIT");
-                    }
-                    else {
-                        modified = true;
-                    }
-                }
-                data += 12 + (GetUInt16(data + 10) & 0x0FFF);
-            }
-        }
-
-        // Update CRC if the section was modified.
-        if (modified) {
-            sp->recomputeCRC();
-        }
+        updateEIT(*sp);
     }
 
     // Now insert the section in the queue for the packetizer.
@@ -402,3 +582,67 @@ void ts::EITProcessor::handleSection(SectionDemux& demux, const Section& section
         _duck.report().warning(u"dropping EIT section (%d bytes), too many buffered EIT sections (%d)", {sp->size(), _sections.size()});
     }
 }
+
+
+//----------------------------------------------------------------------------
+// Apply the rename rules and start time offset on an EIT section.
+//----------------------------------------------------------------------------
+
+bool ts::EITProcessor::updateEIT(Section& sec)
+{
+    const size_t pl_size = sec.payloadSize();
+    const uint16_t srv_id = sec.tableIdExtension();
+    const uint16_t ts_id  = pl_size < 2 ? 0 : GetUInt16(sec.payload());
+    const uint16_t net_id = pl_size < 4 ? 0 : GetUInt16(sec.payload() + 2);
+
+    // Recompute CRC at end only.
+    bool modified = false;
+
+    // Rename EIT's.
+    for (const auto& it : _renamed) {
+        if (Match(it.first, srv_id, ts_id, net_id)) {
+            // Rename the specified fields.
+            if (it.second.hasId()) {
+                modified = true;
+                sec.setTableIdExtension(it.second.getId(), false);
+            }
+            if (it.second.hasTSId()) {
+                modified = true;
+                sec.setUInt16(0, it.second.getTSId(), false);
+            }
+            if (it.second.hasONId()) {
+                modified = true;
+                sec.setUInt16(2, it.second.getONId(), false);
+            }
+        }
+    }
+
+    // Update all events start times.
+    if (_start_time_offset != 0) {
+        uint8_t* data = const_cast<uint8_t*>(sec.payload() + 6);
+        const uint8_t* const end = sec.payload() + sec.payloadSize();
+        while (data + 12 <= end) {
+            // Update event start time.
+            Time time;
+            if (!DecodeMJD(data + 2, MJD_SIZE, time)) {
+                _duck.report().warning(u"error decoding event start time from EIT");
+            }
+            else {
+                time += _start_time_offset;
+                if (!EncodeMJD(time, data + 2, _date_only ? MJD_MIN_SIZE : MJD_SIZE)) {
+                    _duck.report().warning(u"error encoding event start time into EIT");
+                }
+                else {
+                    modified = true;
+                }
+            }
+            data += 12 + (GetUInt16(data + 10) & 0x0FFF);
+        }
+    }
+
+    // Update CRC if the section was modified.
+    if (modified) {
+        sec.recomputeCRC();
+    }
+    return modified;
+}
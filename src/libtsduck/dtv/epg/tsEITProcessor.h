@@ -195,6 +195,31 @@ namespace ts {
         //!
         void addStartTimeOffet(MilliSecond offset, bool date_only = false);
 
+        //!
+        //! Enable the pass-through mode with lazy rewrite.
+        //!
+        //! In this mode, section headers are inspected in place and the packets of
+        //! unaffected sections are passed through untouched, without deassembly and
+        //! repacketization. Only the sections which actually match a rename rule
+        //! (or all EIT's when a start time offset is set) are rewritten, directly
+        //! inside the original packets. This is possible because these
+        //! transformations never change the size of a section.
+        //!
+        //! The mode is effectively used only when the configuration is limited to
+        //! size-preserving transformations: one single input PID which is also the
+        //! output PID, rename rules and start time offset only, no removed table id,
+        //! no removed or kept service. With any other configuration, the standard
+        //! demux / repacketization path is transparently used. The path is selected
+        //! when the first packet is processed and remains unchanged until reset().
+        //!
+        //! Unlike the standard path, sections with an invalid CRC32 are not dropped,
+        //! they are passed through like the rest of the stream.
+        //!
+        //! @param [in] on If true, use the pass-through mode when the configuration
+        //! allows it. The initial default is false.
+        //!
+        void setLazyRewrite(bool on) { _lazy_rewrite = on; }
+
         //!
         //! Set the maximum number of buffered sections.
         //!
@@ -253,6 +278,51 @@ namespace ts {
         std::list<Service>    _kept {};
         std::list<std::pair<Service,Service>> _renamed {};
 
+        // Pass-through mode: original packets are delayed until all sections they
+        // carry are known to be unaffected, then output unmodified, in order. The
+        // affected sections are rewritten in place in the delayed packets, which is
+        // possible because the allowed transformations never change a section size.
+        // One output packet (possibly null) is produced per input packet.
+        class PendingPacket
+        {
+        public:
+            PendingPacket(const TSPacket& pkt) : packet(pkt) {}
+            TSPacket packet;        // Original packet content.
+            size_t   undecided = 0; // Number of in-flight sections with bytes in this packet.
+        };
+        class SectionSegment
+        {
+        public:
+            uint64_t packet = 0;  // Absolute index of the pending packet holding the bytes.
+            size_t   offset = 0;  // Byte offset in the packet.
+            size_t   size = 0;    // Number of section bytes in the packet.
+        };
+        bool     _lazy_rewrite = false;   // Pass-through mode requested.
+        bool     _lazy_latched = false;   // Processing path was selected on first packet.
+        bool     _lazy_active = false;    // Pass-through mode in use.
+        bool     _in_section = false;     // A section is in flight.
+        bool     _sect_decided = false;   // Affected status of the in-flight section is known.
+        bool     _sect_affected = false;  // The in-flight section must be rewritten.
+        size_t   _sect_total = 0;         // Size of the in-flight section, zero while unknown.
+        size_t   _sect_got = 0;           // Number of bytes received for the in-flight section.
+        uint64_t _pending_head = 0;       // Absolute index of the first pending packet.
+        ByteBlock _sect_data {};          // Section prefix, full section content when affected.
+        std::deque<PendingPacket> _pending {};    // Delayed original packets.
+        std::list<SectionSegment> _sect_segs {};  // Location of the in-flight section bytes.
+
+        // Pass-through mode internals.
+        void processPacketLazy(TSPacket& pkt);
+        size_t lazyFeed(uint64_t pkt_index, size_t offset, const uint8_t* data, size_t size);
+        void lazyAddSegment(uint64_t pkt_index, size_t offset, size_t size);
+        void lazyDecide();
+        void lazyComplete();
+        void lazyResync();
+        void lazyClearSection();
+
+        // Apply the rename rules and start time offset on an EIT section.
+        // Recompute the CRC32 and return true when the section was modified.
+        bool updateEIT(Section& sec);
+
         // Check if a service matches a DVB triplet.
         // The service must have at least a service id or transport id.
         static bool Match(const Service& srv, uint16_t srv_id, uint16_t ts_id, uint16_t net_id);
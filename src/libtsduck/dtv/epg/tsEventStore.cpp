@@ -0,0 +1,94 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsEventStore.h"
+
+TS_DEFINE_SINGLETON(ts::EventStore);
+
+
+//----------------------------------------------------------------------------
+// Constructor.
+//----------------------------------------------------------------------------
+
+ts::EventStore::EventStore()
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Content hash of a binary event (FNV-1a).
+//----------------------------------------------------------------------------
+
+namespace {
+    uint64_t EventHash(const uint8_t* data, size_t size)
+    {
+        uint64_t h = 0xCBF29CE484222325;
+        for (size_t i = 0; i < size; ++i) {
+            h = (h ^ data[i]) * 0x100000001B3;
+        }
+        return h;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Store a binary event, or get a reference to an identical stored one.
+//----------------------------------------------------------------------------
+
+ts::EventStore::EventDataPtr ts::EventStore::store(const uint8_t* data, size_t size)
+{
+    const uint64_t hash = EventHash(data, size);
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // Look for an identical stored event under the same hash.
+    const auto bounds(_events.equal_range(hash));
+    for (auto it = bounds.first; it != bounds.second; ++it) {
+        const ByteBlock& bb(*it->second);
+        if (bb.size() == size && std::memcmp(bb.data(), data, size) == 0) {
+            return it->second;
+        }
+    }
+
+    // Not yet stored, keep one reference in the repository.
+    const EventDataPtr ptr(new ByteBlock(data, size));
+    _events.insert(std::make_pair(hash, ptr));
+    return ptr;
+}
+
+
+//----------------------------------------------------------------------------
+// Get the number of distinct binary events in the repository.
+//----------------------------------------------------------------------------
+
+size_t ts::EventStore::eventCount() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _events.size();
+}
+
+
+//----------------------------------------------------------------------------
+// Remove all events which are no longer referenced outside the repository.
+//----------------------------------------------------------------------------
+
+size_t ts::EventStore::purge()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    size_t removed = 0;
+    for (auto it = _events.begin(); it != _events.end(); ) {
+        if (it->second.count() == 1) {
+            // The repository holds the only reference.
+            it = _events.erase(it);
+            removed++;
+        }
+        else {
+            ++it;
+        }
+    }
+    return removed;
+}
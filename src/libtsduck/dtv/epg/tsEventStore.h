@@ -0,0 +1,67 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Shared repository of deduplicated binary DVB events.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsByteBlock.h"
+#include "tsSafePtr.h"
+#include "tsSingleton.h"
+
+namespace ts {
+    //!
+    //! Shared repository of deduplicated binary DVB events.
+    //! @ingroup mpeg
+    //!
+    //! When several EITGenerator or EITProcessor instances handle regional
+    //! variants of the same EPG, identical events are carried in every variant.
+    //! This singleton stores one reference-counted copy of each distinct binary
+    //! event, keyed by a content hash, and all instances reference the same copy.
+    //!
+    //! Stored events are immutable. A variant which diverges simply stores its
+    //! own binary event and gets a distinct copy, which provides copy-on-write
+    //! semantics at the event level. As a side effect of deduplication, two
+    //! events are binary identical if and only if they reference the same data.
+    //!
+    class TSDUCKDLL EventStore
+    {
+        TS_DECLARE_SINGLETON(EventStore);
+    public:
+        //!
+        //! Thread-safe reference-counted pointer to an immutable binary event.
+        //!
+        typedef SafePtr<const ByteBlock, std::mutex> EventDataPtr;
+
+        //!
+        //! Store a binary event, or get a reference to an identical stored one.
+        //! @param [in] data Address of the binary event data.
+        //! @param [in] size Size in bytes of the binary event data.
+        //! @return A reference-counted pointer to the deduplicated event data.
+        //!
+        EventDataPtr store(const uint8_t* data, size_t size);
+
+        //!
+        //! Get the number of distinct binary events in the repository.
+        //! @return The number of distinct binary events in the repository.
+        //!
+        size_t eventCount() const;
+
+        //!
+        //! Remove all events which are no longer referenced outside the repository.
+        //! @return The number of removed events.
+        //!
+        size_t purge();
+
+    private:
+        mutable std::mutex _mutex {};
+        std::multimap<uint64_t, EventDataPtr> _events {};  // indexed by content hash
+    };
+}
@@ -21,6 +21,10 @@
 #include "tsMemory.h"
 #include "tsTunerDeviceInfo.h"
 
+#include "tsBeforeStandardHeaders.h"
+#include <poll.h>
+#include "tsAfterStandardHeaders.h"
+
 // We used to report "bit error rate", "signal/noise ratio", "signal strength",
 // "uncorrected blocks". But the corresponding ioctl commands (FE_READ_BER, FE_READ_SNR,
 // FE_READ_SIGNAL_STRENGTH, FE_READ_UNCORRECTED_BLOCKS) are marked as deprecated with
@@ -386,7 +390,9 @@ bool ts::TunerDevice::open(const UString& device_name, bool info_only)
         _dvr_fd = _demux_fd = -1;
     }
     else {
-        if ((_dvr_fd = ::open(_dvr_name.toUTF8().c_str(), O_RDONLY)) < 0) {
+        // The DVR device is open in non-blocking mode. The receive() operation
+        // waits for data using poll() and drains the driver buffer in one read.
+        if ((_dvr_fd = ::open(_dvr_name.toUTF8().c_str(), O_RDONLY | O_NONBLOCK)) < 0) {
             _duck.report().error(u"error opening %s: %s", {_dvr_name, SysErrorCodeMessage()});
             close();
             return false;
@@ -573,6 +579,9 @@ bool ts::TunerDevice::getSignalState(SignalState& state)
     getFrontendStatus(status);
     state.signal_locked = (status & ::FE_HAS_LOCK) != 0;
 
+    // Report the overflows of the DVR buffer, as accounted by receive operations.
+    state.input_overflows = SignalState::Value(int64_t(_dvr_overflows));
+
 #if defined(DTV_STAT_SIGNAL_STRENGTH)
 
     // Get the statistics from the DVB API, if supported.
@@ -1311,13 +1320,19 @@ bool ts::TunerDevice::start()
     }
 
     // Set demux buffer size (default value is 2 kB, fine for sections,
-    // completely undersized for full TS capture.
+    // completely undersized for full TS capture. The buffer must be large
+    // enough to absorb scheduling hiccups of the application at the full
+    // bitrate of the transponder (see --demux-buffer-size).
 
+    _duck.report().debug(u"setting demux buffer size to %'d bytes on %s", {_demux_bufsize, _demux_name});
     if (::ioctl(_demux_fd, ioctl_request_t(DMX_SET_BUFFER_SIZE), _demux_bufsize) < 0) {
         _duck.report().error(u"error setting buffer size on %s: %s", {_demux_name, SysErrorCodeMessage()});
         return false;
     }
 
+    // Restart the overflow accounting for this reception session.
+    _dvr_overflows = 0;
+
     // Apply a filter to the demux.
 
     // The Linux DVB API defines two types of filters: sections and PES.
@@ -1543,38 +1558,84 @@ size_t ts::TunerDevice::receive(TSPacket* buffer, size_t max_packets, const Abor
         time_limit = Time::CurrentLocalTime() + _receive_timeout;
     }
 
-    // Loop on read until we get enough
-    while (got_size < req_size && !_aborted) {
-
-        // Read some data
-        bool got_overflow = false;
+    // The dvr device is open in non-blocking mode. Wait for data using poll()
+    // and drain the driver buffer in one single large read, up to the caller's
+    // buffer size. As soon as the driver buffer is empty and the received batch
+    // contains at least one complete packet, return it instead of waiting for
+    // the caller's buffer to fill up. After a scheduling hiccup, the backlog
+    // which accumulated in the driver buffer is thus caught up in one read.
+    bool got_eof = false;
+    while (got_size < req_size && !_aborted && !got_eof) {
+
+        // Wait for some data in the driver buffer. Bound the wait by the remaining
+        // receive timeout, if there is one. The timer signal also interrupts the
+        // poll but, if the timer fires before the poll starts, the signal is lost
+        // and only the poll timeout guarantees the receive timeout.
+        int wait_ms = -1;
+        if (_receive_timeout > 0) {
+            wait_ms = int(std::max<MilliSecond>(0, time_limit - Time::CurrentLocalTime()));
+        }
+        ::pollfd pfd;
+        TS_ZERO(pfd);
+        pfd.fd = _dvr_fd;
+        pfd.events = POLLIN;
         _reading_dvr = true;
-        const ssize_t insize = ::read(_dvr_fd, data + got_size, req_size - got_size);
+        const int polled = ::poll(&pfd, 1, wait_ms);
         _reading_dvr = false;
 
-        if (insize > 0) {
-            // Normal case: some data were read
-            assert(got_size + size_t(insize) <= req_size);
-            got_size += size_t(insize);
-        }
-        else if (insize == 0) {
-            // End of file. Truncate potential partial packet at eof.
-            got_size -= got_size % PKT_SIZE;
-        }
-        else if (errno == EINTR) {
-            // Input was interrupted by a signal.
+        bool got_overflow = false;
+        if (polled < 0 && errno == EINTR) {
+            // Wait was interrupted by a signal.
             // If the application should be interrupted, stop now.
             if (_aborted || (abort != nullptr && abort->aborting())) {
                 break;
             }
         }
-        else if (errno == EOVERFLOW) {
-            got_overflow = true;
-        }
-        else {
-            _duck.report().error(u"receive error on %s: %s", {_dvr_name, SysErrorCodeMessage()});
+        else if (polled < 0) {
+            _duck.report().error(u"poll error on %s: %s", {_dvr_name, SysErrorCodeMessage()});
             break;
         }
+        else if (polled > 0) {
+            // Some data are available (or an error is pending), read as much as
+            // the driver buffer currently holds. Read errors such as overflows
+            // are reported by the read(), not by the poll().
+            const size_t remain = req_size - got_size;
+            const ssize_t insize = ::read(_dvr_fd, data + got_size, remain);
+
+            if (insize > 0) {
+                // Normal case: some data were read
+                assert(size_t(insize) <= remain);
+                got_size += size_t(insize);
+                // A partial read means that the driver buffer is now drained.
+                // Return the batch as soon as it contains complete packets.
+                if (size_t(insize) < remain && got_size >= PKT_SIZE) {
+                    break;
+                }
+            }
+            else if (insize == 0) {
+                // End of file. Truncate potential partial packet at eof.
+                got_size -= got_size % PKT_SIZE;
+                got_eof = true;
+            }
+            else if (errno == EINTR) {
+                // Input was interrupted by a signal.
+                // If the application should be interrupted, stop now.
+                if (_aborted || (abort != nullptr && abort->aborting())) {
+                    break;
+                }
+            }
+            else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                // Spurious wakeup, the driver buffer is empty again, wait more.
+            }
+            else if (errno == EOVERFLOW) {
+                got_overflow = true;
+                _dvr_overflows++;
+            }
+            else {
+                _duck.report().error(u"receive error on %s: %s", {_dvr_name, SysErrorCodeMessage()});
+                break;
+            }
+        }
 
         // Input overflow management: If an input overflow occurs more than
         // MAX_OVERFLOW consecutive times, an error is generated.
@@ -1588,10 +1649,6 @@ size_t ts::TunerDevice::receive(TSPacket* buffer, size_t max_packets, const Abor
         }
 
         // If the receive timeout is exceeded, stop now.
-        // FIXME: There is a race condition here. If the receiver timer is
-        // triggered between this test and the start of the next read, the
-        // next read will not be interrupted and the receive timer will not
-        // apply to this read.
         if (_receive_timeout > 0 && Time::CurrentLocalTime() >= time_limit) {
             if (got_size == 0) {
                 _duck.report().error(u"receive timeout on %s", {_device_name});
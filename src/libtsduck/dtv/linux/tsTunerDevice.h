@@ -84,6 +84,7 @@ namespace ts {
         int                 _frontend_fd = -1;        // Frontend device file descriptor
         int                 _demux_fd = -1;           // Demux device file descriptor
         int                 _dvr_fd = -1;             // DVR device file descriptor
+        uint64_t            _dvr_overflows = 0;       // Cumulative count of DVR buffer overflows since start().
         unsigned long       _demux_bufsize {DEFAULT_DEMUX_BUFFER_SIZE};
         ::dvb_frontend_info _fe_info {};              // Front-end characteristics
         MilliSecond         _signal_poll {DEFAULT_SIGNAL_POLL};
@@ -105,14 +105,16 @@ void ts::MPEDemux::handleSection(SectionDemux& demux, const Section& section)
 
     if (section.tableId() == TID_DSMCC_PD && _pid_filter.test(section.sourcePID())) {
 
-        // Build the corresponding MPE packet.
-        MPEPacket mpe(section);
-        if (mpe.isValid() && _handler != nullptr) {
+        // Build the corresponding MPE packet. The scratch packet is reused from
+        // one datagram to the other: its internal buffer is reallocated only
+        // when the handler kept a reference to the previous datagram.
+        _mpe.copy(section);
+        if (_mpe.isValid() && _handler != nullptr) {
 
             // Send the MPE packet to the application.
             beforeCallingHandler(section.sourcePID());
             try {
-                _handler->handleMPEPacket(*this, mpe);
+                _handler->handleMPEPacket(*this, _mpe);
             }
             catch (...) {
                 afterCallingHandler(false);
@@ -17,6 +17,7 @@
 #include "tsPMT.h"
 #include "tsINT.h"
 #include "tsMPEHandlerInterface.h"
+#include "tsMPEPacket.h"
 
 namespace ts {
     //!
@@ -107,5 +108,6 @@ namespace ts {
         PMTMap               _pmts {};           // Map of all PMT's in the TS.
         PIDSet               _new_pids {};       // New MPE PID's which where signalled to the application.
         std::set<uint32_t>   _int_tags {};       // Set of service_id / component_tag from the INT.
+        MPEPacket            _mpe {};            // Scratch MPE packet, its buffer is reused from datagram to datagram.
     };
 }
@@ -188,6 +188,10 @@ ts::MPEPacket& ts::MPEPacket::copy(const MPEPacket& other)
 
 ts::MPEPacket& ts::MPEPacket::copy(const Section& section)
 {
+    // Keep a reference on the previous datagram buffer. If it is not shared
+    // with another instance, it is reused below instead of reallocating one.
+    ByteBlockPtr buffer(_datagram);
+
     // Clear previous content.
     clear();
 
@@ -214,7 +218,13 @@ ts::MPEPacket& ts::MPEPacket::copy(const Section& section)
 
     // Get the datagram from the rest of the section.
     // Do not include trailing 4 bytes (checksum or CRC32).
-    _datagram = new ByteBlock(data + 12, size - 16);
+    if (buffer.isNull() || buffer.count() > 1) {
+        _datagram = new ByteBlock(data + 12, size - 16);
+    }
+    else {
+        buffer->copy(data + 12, size - 16);
+        _datagram = buffer;
+    }
 
     // Check that the datagram contains a UDP/IP packet.
     _is_valid = true;
@@ -205,6 +205,26 @@ void ts::PESDemux::processPacket(const TSPacket& pkt)
         // If the beginning of a PUSI payload is 00 00 01, this is a PES packet
         // (it is not possible to have 00 00 01 in a PUSI packet containing sections).
         if (pl_size >= 3 && pl[0] == 0 && pl[1] == 0 && pl[2] == 1) {
+            // Notify the PES header as soon as the start of the PES packet is seen.
+            // The TS payload usually contains the complete PES header.
+            if (_pes_handler != nullptr) {
+                beforeCallingHandler(pid);
+                try {
+                    _pes_handler->handlePESHeader(*this, pid, pl, pl_size);
+                }
+                catch (...) {
+                    afterCallingHandler(false);
+                    throw;
+                }
+                afterCallingHandler(true);
+            }
+
+            // In header-only mode, do not assemble the PES packet, drop any partial context.
+            if (_header_only) {
+                _pids.erase(pid);
+                return;
+            }
+
             // We are at the beginning of a PES packet. Create context if non existent.
             PIDContext& pc(_pids[pid]);
             pc.continuity = pkt.getCC();
@@ -518,9 +538,8 @@ void ts::PESDemux::handlePESContent(PIDContext& pc, const PESPacket& pes)
         // Locate all start codes and invoke handler.
         // The beginning of the payload is already a start code prefix.
         for (size_t offset = 0; offset < pl_size; ) {
-            // Look for next start code
-            static const uint8_t StartCodePrefix[] = {0x00, 0x00, 0x01};
-            const uint8_t* pnext = LocatePattern(pl_data + offset + 1, pl_size - offset - 1, StartCodePrefix, sizeof(StartCodePrefix));
+            // Look for next start code prefix: 00 00 01
+            const uint8_t* pnext = LocateZeroZero(pl_data + offset + 1, pl_size - offset - 1, 0x01);
             size_t next = pnext == nullptr ? pl_size : pnext - pl_data;
             // Invoke handler
             _pes_handler->handleVideoStartCode(*this, pes, pl_data[offset + 3], offset, next - offset);
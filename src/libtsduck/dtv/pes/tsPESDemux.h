@@ -75,6 +75,19 @@ namespace ts {
         //!
         void setPESHandler(PESHandlerInterface* h) { _pes_handler = h; }
 
+        //!
+        //! Enable or disable the header-only mode.
+        //! In this mode, the demux no longer accumulates the TS payloads of the PES packets.
+        //! The PES packets are never assembled, handlePESPacket() is never invoked and the
+        //! audio/video contents are not analyzed. The hook handlePESHeader() is invoked as
+        //! soon as the start of each PES packet is seen, typically with the complete PES
+        //! header inside. Use this mode when only the PES headers need to be inspected:
+        //! on video PID's, this saves the buffering and copy of each complete PES packet.
+        //! @param [in] on True to enable the header-only mode, false to fully assemble
+        //! the PES packets (the default).
+        //!
+        void setHeaderOnlyMode(bool on) { _header_only = on; }
+
         //!
         //! Set the default audio or video codec for all analyzed PES PID's.
         //! The analysis of the content of a PES packet sometimes depends on the PES data format.
@@ -229,6 +242,7 @@ namespace ts {
 
         // Private members:
         PESHandlerInterface* _pes_handler = nullptr;
+        bool                 _header_only = false;
         CodecType            _default_codec {CodecType::UNDEFINED};
         PIDContextMap        _pids {};
         PIDTypeMap           _pid_types {};
@@ -11,6 +11,7 @@
 // Default implementations are all empty.
 
 void ts::PESHandlerInterface::handlePESPacket(PESDemux&, const PESPacket&) {}
+void ts::PESHandlerInterface::handlePESHeader(PESDemux&, PID, const uint8_t*, size_t) {}
 void ts::PESHandlerInterface::handleInvalidPESPacket(PESDemux&, const DemuxedData&) {}
 void ts::PESHandlerInterface::handleVideoStartCode(PESDemux&, const PESPacket&, uint8_t, size_t, size_t) {}
 void ts::PESHandlerInterface::handleNewMPEG2VideoAttributes(PESDemux&, const PESPacket&, const MPEG2VideoAttributes&) {}
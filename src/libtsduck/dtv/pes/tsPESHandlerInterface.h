@@ -42,6 +42,20 @@ namespace ts {
         //!
         virtual void handlePESPacket(PESDemux& demux, const PESPacket& packet);
 
+        //!
+        //! This hook is invoked when the start of a PES packet is detected, before the packet is assembled.
+        //! It is invoked on the first TS packet of each PES packet, without waiting for the rest of the
+        //! packet. The data start with the PES start code prefix (00 00 01) and typically contain the
+        //! complete PES header. They may be truncated if the beginning of the PES packet does not fit in
+        //! one TS packet. Unlike the other hooks, this one is also invoked in header-only mode.
+        //! @param [in,out] demux A reference to the PES demux.
+        //! @param [in] pid PID of the PES packet.
+        //! @param [in] data Address of the beginning of the PES packet.
+        //! @param [in] size Size in bytes of the available data, possibly less than the PES header size.
+        //! @see PESDemux::setHeaderOnlyMode()
+        //!
+        virtual void handlePESHeader(PESDemux& demux, PID pid, const uint8_t* data, size_t size);
+
         //!
         //! This hook is invoked when an invalid PES packet is encountered.
         //! @param [in,out] demux A reference to the PES demux.
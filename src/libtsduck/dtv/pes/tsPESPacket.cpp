@@ -526,9 +526,8 @@ size_t ts::PESPacket::FindIntraImage(const uint8_t* data, size_t size, uint8_t s
         // Locate all start codes and detect start of Group of Pictures (GOP).
         // The beginning of the PES payload is already a start code prefix in MPEG-1/2.
         while (pl_size > 0) {
-            // Look for next start code
-            static const uint8_t StartCodePrefix[] = {0x00, 0x00, 0x01};
-            const uint8_t* pl_next = LocatePattern(pl_data + 1, pl_size - 1, StartCodePrefix, sizeof(StartCodePrefix));
+            // Look for next start code prefix: 00 00 01
+            const uint8_t* pl_next = LocateZeroZero(pl_data + 1, pl_size - 1, 0x01);
             if (pl_next == nullptr) {
                 // No next start code, current one extends up to the end of the payload.
                 pl_next = pl_data + pl_size;
@@ -224,6 +224,16 @@ namespace ts {
         //!
         size_t payloadSize() const { return _is_valid ? size() - _header_size : 0; }
 
+        //!
+        //! Get a shared slice view over the payload of the packet.
+        //! The bytes are not copied, the slice references the same shared data
+        //! as the packet. Use this instead of copying payload() into a
+        //! ByteBlock when a read-only payload must be kept or passed around.
+        //! @return A slice designating the payload of the packet.
+        //! @see ByteBlockSlice
+        //!
+        ByteBlockSlice payloadSlice() const { return contentSlice().subSlice(headerSize(), payloadSize()); }
+
         //!
         //! Number of spurious data bytes after the packet.
         //! @return Size of the spurious data bytes after the packet.
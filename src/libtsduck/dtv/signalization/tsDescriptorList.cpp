@@ -11,6 +11,7 @@
 #include "tsAbstractTable.h"
 #include "tsDuckContext.h"
 #include "tsxmlElement.h"
+#include "tsAlgorithm.h"
 #include "tsFatal.h"
 
 
@@ -33,6 +34,8 @@ ts::DescriptorList::DescriptorList(const AbstractTable* table, DescriptorList&&
     _table(table),
     _list(std::move(dl._list))
 {
+    // The list of the source is now in an unspecified state, drop its index.
+    dl._tag_index.clear();
 }
 
 ts::DescriptorList& ts::DescriptorList::operator=(const DescriptorList& dl)
@@ -40,6 +43,7 @@ ts::DescriptorList& ts::DescriptorList::operator=(const DescriptorList& dl)
     if (&dl != this) {
         // Copy the list of descriptors but preserve the parent table.
         _list = dl._list;
+        _tag_index.clear();
     }
     return *this;
 }
@@ -49,6 +53,8 @@ ts::DescriptorList& ts::DescriptorList::operator=(DescriptorList&& dl) noexcept
     if (&dl != this) {
         // Move the list of descriptors but preserve the parent table.
         _list = std::move(dl._list);
+        _tag_index.clear();
+        dl._tag_index.clear();
     }
     return *this;
 }
@@ -113,6 +119,7 @@ bool ts::DescriptorList::add(const DescriptorPtr& desc)
 
     // Add the descriptor in the list
     _list.push_back(Element(desc, pds));
+    _tag_index.clear();
     return true;
 }
 
@@ -179,6 +186,7 @@ void ts::DescriptorList::merge(DuckContext& duck, const AbstractDescriptor& desc
                 case DescriptorDuplication::REPLACE: {
                     // New descriptor shall replace the previous one.
                     _list[index].desc = bindesc;
+                    _tag_index.clear();
                     return;
                 }
                 case DescriptorDuplication::MERGE: {
@@ -192,6 +200,7 @@ void ts::DescriptorList::merge(DuckContext& duck, const AbstractDescriptor& desc
                         dp->serialize(duck, *newdesc);
                         if (newdesc->isValid()) {
                             _list[index].desc = newdesc;
+                            _tag_index.clear();
                             return;
                         }
                     }
@@ -350,6 +359,7 @@ size_t ts::DescriptorList::removeInvalidPrivateDescriptors()
     for (size_t n = 0; n < _list.size(); ) {
         if (_list[n].pds == 0 && !_list[n].desc.isNull() && _list[n].desc->isValid() && _list[n].desc->tag() >= 0x80) {
             _list.erase(_list.begin() + n);
+            _tag_index.clear();
             count++;
         }
         else {
@@ -379,6 +389,7 @@ bool ts::DescriptorList::removeByIndex(size_t index)
 
     // Remove the specified descriptor
     _list.erase(_list.begin() + index);
+    _tag_index.clear();
     return true;
 }
 
@@ -396,6 +407,7 @@ size_t ts::DescriptorList::removeByTag(DID tag, PDS pds)
         const DID itag = it->desc->tag();
         if (itag == tag && (!check_pds || it->pds == pds) && (itag != DID_PRIV_DATA_SPECIF || prepareRemovePDS (it))) {
             it = _list.erase (it);
+            _tag_index.clear();
             ++removed_count;
         }
         else {
@@ -499,6 +511,22 @@ size_t ts::DescriptorList::lengthSerialize(uint8_t*& addr, size_t& size, size_t
 }
 
 
+//----------------------------------------------------------------------------
+// Get the tag index, build it if not already done.
+//----------------------------------------------------------------------------
+
+const std::vector<std::vector<size_t>>& ts::DescriptorList::tagIndex() const
+{
+    if (_tag_index.empty()) {
+        _tag_index.resize(256);
+        for (size_t i = 0; i < _list.size(); ++i) {
+            _tag_index[_list[i].desc->tag()].push_back(i);
+        }
+    }
+    return _tag_index;
+}
+
+
 //----------------------------------------------------------------------------
 // Search a descriptor with the specified tag, starting at the
 // specified index.
@@ -506,17 +534,46 @@ size_t ts::DescriptorList::lengthSerialize(uint8_t*& addr, size_t& size, size_t
 
 size_t ts::DescriptorList::search(DID tag, size_t start_index, PDS pds) const
 {
-    bool check_pds = pds != 0 && tag >= 0x80;
-    size_t index = start_index;
+    const bool check_pds = pds != 0 && tag >= 0x80;
+
+    // On large lists, repeated searches for various tags become quadratic.
+    // Use the per-tag index instead of a linear scan. Each bucket contains
+    // the indexes of all descriptors with that tag, in increasing order.
+    if (_list.size() >= MIN_INDEXED_SIZE) {
+        const std::vector<size_t>& bucket(tagIndex()[tag]);
+        for (auto it = std::lower_bound(bucket.begin(), bucket.end(), start_index); it != bucket.end(); ++it) {
+            if (!check_pds || _list[*it].pds == pds) {
+                return *it;
+            }
+        }
+        return _list.size();
+    }
 
+    // Small list, plain linear scan.
+    size_t index = start_index;
     while (index < _list.size() && (_list[index].desc->tag() != tag || (check_pds && _list[index].pds != pds))) {
         index++;
     }
-
     return index;
 }
 
 
+//----------------------------------------------------------------------------
+// Search all descriptors with one of the specified tags, in one pass.
+//----------------------------------------------------------------------------
+
+void ts::DescriptorList::searchAll(const std::set<DID>& tags, std::vector<size_t>& indexes, PDS pds) const
+{
+    indexes.clear();
+    for (size_t index = 0; index < _list.size(); ++index) {
+        const DID tag = _list[index].desc->tag();
+        if (Contains(tags, tag) && (pds == 0 || tag < 0x80 || _list[index].pds == pds)) {
+            indexes.push_back(index);
+        }
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Search a descriptor with the specified extended tag.
 //----------------------------------------------------------------------------
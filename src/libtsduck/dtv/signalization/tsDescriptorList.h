@@ -157,6 +157,7 @@ namespace ts {
         void add(const DescriptorList& dl)
         {
             _list.insert(_list.end(), dl._list.begin(), dl._list.end());
+            _tag_index.clear();
         }
 
         //!
@@ -238,7 +239,11 @@ namespace ts {
         //!
         //! Clear the content of the descriptor list.
         //!
-        void clear() { _list.clear(); }
+        void clear()
+        {
+            _list.clear();
+            _tag_index.clear();
+        }
 
         //!
         //! Search a descriptor with the specified tag.
@@ -251,6 +256,19 @@ namespace ts {
         //!
         size_t search(DID tag, size_t start_index = 0, PDS pds = 0) const;
 
+        //!
+        //! Search all descriptors with one of the specified tags, in one pass.
+        //! When a caller needs several types of descriptors from the same list,
+        //! collecting them all at once is faster than one search() per tag.
+        //! @param [in] tags A set of descriptor tags to search.
+        //! @param [out] indexes Indexes in the list of all descriptors with one
+        //! of the specified @a tags, in their order in the list.
+        //! @param [in] pds Private data specifier.
+        //! If @a pds is non-zero, private descriptors (tag >= 0x80) are returned
+        //! only when they have the corresponding private data specifier.
+        //!
+        void searchAll(const std::set<DID>& tags, std::vector<size_t>& indexes, PDS pds = 0) const;
+
         //!
         //! Search a descriptor with the specified extended tag.
         //! @param [in] edid Extended tag of descriptor to search.
@@ -403,10 +421,21 @@ namespace ts {
         };
         typedef std::vector <Element> ElementVector;
 
+        // Minimum list size over which search() uses the per-tag index.
+        // On smaller lists, building the index costs more than a linear scan.
+        static constexpr size_t MIN_INDEXED_SIZE = 8;
+
         // Private members
         const AbstractTable* const _table;  // Parent table (zero for descriptor list object outside a table).
         ElementVector _list {};             // Vector of safe pointers to descriptors.
 
+        // Lazily built index of descriptor indexes, one bucket per tag value.
+        // The index is built on demand by search() and cleared on each mutation of the list.
+        mutable std::vector<std::vector<size_t>> _tag_index {};
+
+        // Get the tag index, build it if not already done.
+        const std::vector<std::vector<size_t>>& tagIndex() const;
+
         // Prepare removal of a private_data_specifier descriptor.
         // Return true if can be removed, false if it cannot (private descriptors ahead).
         // When it can be removed, the current PDS of all subsequent descriptors is updated.
@@ -130,6 +130,7 @@ void ts::PSIMerger::reset(Options options)
     _main_bats.clear();
     _merge_bats.clear();
     _eits.clear();
+    _last_merged.clear();
 }
 
 
@@ -366,17 +367,25 @@ void ts::PSIMerger::handleSection(SectionDemux& demux, const Section& section)
         const SectionPtr sp(new Section(section, ShareMode::SHARE));
         CheckNonNull(sp.pointer());
 
-        if (demux.demuxId() != DEMUX_MERGE_EIT || !is_actual) {
-            // Not an EIT-Actual from the merge stream, pass section without modification.
-            _eits.push_back(sp);
-        }
-        else if (sp->payloadSize() >= 2 && _main_tsid.has_value()) {
-            // This is an EIT-Actual from merged stream and we know the main TS id.
-            // Patch the EIT with new TS id before enqueueing.
-            // The TSid is in the first two bytes of the EIT payload.
+        if (demux.demuxId() == DEMUX_MERGE_EIT && is_actual) {
+            // This is an EIT-Actual from the merged stream, it must be patched with
+            // the main TS id before insertion. The TS id is in the first two bytes
+            // of the EIT payload. Drop the section when we cannot patch it yet.
+            if (sp->payloadSize() < 2 || !_main_tsid.has_value()) {
+                return;
+            }
             sp->setUInt16(0, _main_tsid.value(), true);
-            _eits.push_back(sp);
         }
+
+        // Do not enqueue a section which is already queued with the same content.
+        // When the output EIT PID is saturated, repetitions of the input sections
+        // would otherwise accumulate in the queue until the overflow limit.
+        for (const auto& it : _eits) {
+            if (*it == *sp) {
+                return;
+            }
+        }
+        _eits.push_back(sp);
     }
 }
 
@@ -537,6 +546,83 @@ void ts::PSIMerger::handleMergeTable(const BinaryTable& table)
 }
 
 
+//----------------------------------------------------------------------------
+// Compare the content of two long sections, ignoring the version number.
+//----------------------------------------------------------------------------
+
+namespace {
+    bool SameContentIgnoreVersion(const ts::Section& s1, const ts::Section& s2)
+    {
+        const size_t size = s1.size();
+        if (!s1.isLongSection() || !s2.isLongSection() || size != s2.size()) {
+            return false;
+        }
+        // The version number is in bits 0x3E of byte 5 and the CRC32, in the last
+        // four bytes, is a function of the rest of the section. Ignore both.
+        const uint8_t* d1 = s1.content();
+        const uint8_t* d2 = s2.content();
+        return std::memcmp(d1, d2, 5) == 0 &&
+               ((d1[5] ^ d2[5]) & ~0x3E) == 0 &&
+               std::memcmp(d1 + 6, d2 + 6, size - 6 - ts::SECTION_CRC32_SIZE) == 0;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Serialize a merged table and update its packetizer when its content changed.
+//----------------------------------------------------------------------------
+
+uint8_t ts::PSIMerger::replaceTable(CyclingPacketizer& pzer, const AbstractLongTable& table)
+{
+    // Serialize the merged table with its current output version.
+    BinaryTable bin;
+    table.serialize(_duck, bin);
+    if (!bin.isValid()) {
+        return table.version;
+    }
+
+    // Previously emitted binary content for this table.
+    const uint32_t key = (uint32_t(bin.tableId()) << 16) | bin.tableIdExtension();
+    BinaryTable& last(_last_merged[key]);
+
+    // Compare with the previously emitted sections, ignoring version numbers.
+    bool modified = !last.isValid() || last.sectionCount() != bin.sectionCount();
+    for (size_t i = 0; !modified && i < bin.sectionCount(); ++i) {
+        modified = !SameContentIgnoreVersion(*last.sectionAt(i), *bin.sectionAt(i));
+    }
+    if (!modified) {
+        // Nothing changed, keep the packetizer and version untouched to avoid receiver churn.
+        return table.version;
+    }
+
+    // The content changed, re-emit it with the next version number.
+    const uint8_t version = (table.version + 1) & SVERSION_MASK;
+    bin.setVersion(version, true);
+
+    if (!last.isValid()) {
+        // First emission of this table, drop any stale content from the packetizer.
+        pzer.removeSections(bin.tableId(), bin.tableIdExtension());
+        pzer.addTable(bin);
+    }
+    else {
+        // Replace the sections one by one, keeping the section numbering stable.
+        for (size_t i = 0; i < bin.sectionCount(); ++i) {
+            const SectionPtr sec(bin.sectionAt(i));
+            pzer.removeSections(sec->tableId(), sec->tableIdExtension(), sec->sectionNumber());
+            pzer.addSection(sec);
+        }
+        // Remove trailing sections when the table shrank.
+        for (size_t i = bin.sectionCount(); i < last.sectionCount(); ++i) {
+            pzer.removeSections(bin.tableId(), bin.tableIdExtension(), uint8_t(i));
+        }
+    }
+
+    // Keep the emitted content as reference for the next merge.
+    last = bin;
+    return version;
+}
+
+
 //----------------------------------------------------------------------------
 // Merge the PAT's and build a new one into the packetizer.
 //----------------------------------------------------------------------------
@@ -550,9 +636,8 @@ void ts::PSIMerger::mergePAT()
 
     _duck.report().debug(u"merging PAT");
 
-    // Build a new PAT based on last main PAT with incremented version number.
+    // Build a new PAT based on last main PAT, keeping the current output version number.
     PAT pat(_main_pat);
-    pat.version = (pat.version + 1) & SVERSION_MASK;
 
     // Add all services from merged stream into main PAT.
     for (const auto& merge : _merge_pat.pmts) {
@@ -566,12 +651,8 @@ void ts::PSIMerger::mergePAT()
         }
     }
 
-    // Replace the PAT in the packetizer.
-    _pat_pzer.removeSections(TID_PAT);
-    _pat_pzer.addTable(_duck, pat);
-
-    // Save PAT version number for later increment.
-    _main_pat.version = pat.version;
+    // Update the packetizer and save the emitted PAT version number.
+    _main_pat.version = replaceTable(_pat_pzer, pat);
 }
 
 
@@ -588,9 +669,8 @@ void ts::PSIMerger::mergeCAT()
 
     _duck.report().debug(u"merging CAT");
 
-    // Build a new CAT based on last main CAT with incremented version number.
+    // Build a new CAT based on last main CAT, keeping the current output version number.
     CAT cat(_main_cat);
-    cat.version = (cat.version + 1) & SVERSION_MASK;
 
     // Add all CA descriptors from merged stream into main CAT.
     for (size_t index = _merge_cat.descs.search(DID_CA); index < _merge_cat.descs.count(); index = _merge_cat.descs.search(DID_CA, index + 1)) {
@@ -605,12 +685,8 @@ void ts::PSIMerger::mergeCAT()
         }
     }
 
-    // Replace the CAT in the packetizer.
-    _cat_pzer.removeSections(TID_CAT);
-    _cat_pzer.addTable(_duck, cat);
-
-    // Save CAT version number for later increment.
-    _main_cat.version = cat.version;
+    // Update the packetizer and save the emitted CAT version number.
+    _main_cat.version = replaceTable(_cat_pzer, cat);
 }
 
 
@@ -627,9 +703,8 @@ void ts::PSIMerger::mergeSDT()
 
     _duck.report().debug(u"merging SDT");
 
-    // Build a new SDT based on last main SDT with incremented version number.
+    // Build a new SDT based on last main SDT, keeping the current output version number.
     SDT sdt(_main_sdt);
-    sdt.version = (sdt.version + 1) & SVERSION_MASK;
 
     // Add all services from merged stream into main SDT.
     for (const auto& merge : _merge_sdt.services) {
@@ -643,12 +718,8 @@ void ts::PSIMerger::mergeSDT()
         }
     }
 
-    // Replace the SDT in the packetizer.
-    _sdt_bat_pzer.removeSections(TID_SDT_ACT, sdt.ts_id);
-    _sdt_bat_pzer.addTable(_duck, sdt);
-
-    // Save SDT version number for later increment.
-    _main_sdt.version = sdt.version;
+    // Update the packetizer and save the emitted SDT version number.
+    _main_sdt.version = replaceTable(_sdt_bat_pzer, sdt);
 }
 
 
@@ -668,9 +739,8 @@ void ts::PSIMerger::mergeNIT()
 
     _duck.report().debug(u"merging NIT");
 
-    // Build a new NIT based on last main NIT with incremented version number.
+    // Build a new NIT based on last main NIT, keeping the current output version number.
     NIT nit(_main_nit);
-    nit.version = (nit.version + 1) & SVERSION_MASK;
 
     // If the two TS are from the same network and have distinct TS ids, remove the
     // description of the merged TS since it is now merged.
@@ -690,12 +760,8 @@ void ts::PSIMerger::mergeNIT()
         nit.transports[main_tsid].descs.add(merge_ts->second.descs);
     }
 
-    // Replace the NIT in the packetizer.
-    _nit_pzer.removeSections(TID_NIT_ACT, nit.network_id);
-    _nit_pzer.addTable(_duck, nit);
-
-    // Save NIT version number for later increment.
-    _main_nit.version = nit.version;
+    // Update the packetizer and save the emitted NIT version number.
+    _main_nit.version = replaceTable(_nit_pzer, nit);
 }
 
 
@@ -719,9 +785,8 @@ void ts::PSIMerger::mergeBAT(uint16_t bouquet_id)
 
     _duck.report().debug(u"merging BAT for bouquet id 0x%X (%d)", {bouquet_id, bouquet_id});
 
-    // Build a new BAT based on last main BAT with incremented version number.
+    // Build a new BAT based on last main BAT, keeping the current output version number.
     BAT bat(main->second);
-    bat.version = (bat.version + 1) & SVERSION_MASK;
 
     // If the two TS have distinct TS ids, remove the description of the merged TS since it is now merged.
     if (main_tsid != merge_tsid) {
@@ -740,10 +805,6 @@ void ts::PSIMerger::mergeBAT(uint16_t bouquet_id)
         bat.transports[main_tsid].descs.add(merge_ts->second.descs);
     }
 
-    // Replace the BAT in the packetizer.
-    _sdt_bat_pzer.removeSections(TID_BAT, bouquet_id);
-    _sdt_bat_pzer.addTable(_duck, bat);
-
-    // Save NIT version number for later increment.
-    main->second.version = bat.version;
+    // Update the packetizer and save the emitted BAT version number.
+    main->second.version = replaceTable(_sdt_bat_pzer, bat);
 }
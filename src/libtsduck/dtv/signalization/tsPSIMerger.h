@@ -14,6 +14,7 @@
 #pragma once
 #include "tsSectionDemux.h"
 #include "tsCyclingPacketizer.h"
+#include "tsBinaryTable.h"
 #include "tsEnumUtils.h"
 #include "tsPAT.h"
 #include "tsCAT.h"
@@ -133,6 +134,7 @@ namespace ts {
         std::map<uint16_t, BAT> _merge_bats {};    // Map of last input BAT/bouquet_it from merged TS.
         std::list<SectionPtr>   _eits {};          // List of EIT sections to insert.
         size_t                  _max_eits = 128;   // Maximum number of buffered EIT sections (hard-coded for now).
+        std::map<uint32_t, BinaryTable> _last_merged {};  // Last emitted merged tables, indexed by TID / TID-ext.
 
         static constexpr int DEMUX_MAIN      = 1;  // Id of the demux from the main TS.
         static constexpr int DEMUX_MAIN_EIT  = 2;  // Id of the demux from the main TS for EIT's.
@@ -159,6 +161,13 @@ namespace ts {
         void handleMainTable(const BinaryTable& table);
         void handleMergeTable(const BinaryTable& table);
 
+        // Serialize a merged table and update its packetizer, comparing it with the previously
+        // emitted content. When nothing changed, the packetizer and the version number are left
+        // untouched to avoid receiver churn. When the table changed, only the modified sections
+        // are replaced in the packetizer, keeping the section numbering stable.
+        // Return the version which is actually emitted.
+        uint8_t replaceTable(CyclingPacketizer& pzer, const AbstractLongTable& table);
+
         // Generate new/merged tables.
         void mergePAT();
         void mergeCAT();
@@ -74,6 +74,24 @@ void ts::PSIRepository::TableDescription::addPIDs(std::initializer_list<PID> mor
 }
 
 
+//----------------------------------------------------------------------------
+// Binary searches in the flat sorted indexes.
+//----------------------------------------------------------------------------
+
+ts::PSIRepository::TableIndex::const_iterator ts::PSIRepository::tableLowerBound(TID tid) const
+{
+    return std::lower_bound(_tables.begin(), _tables.end(), tid,
+                            [](const TableIndex::value_type& entry, TID id) { return entry.first < id; });
+}
+
+ts::PSIRepository::DescriptorIndex::const_iterator ts::PSIRepository::findDescriptor(const EDID& edid) const
+{
+    const auto it = std::lower_bound(_descriptors.begin(), _descriptors.end(), edid,
+                                     [](const DescriptorIndex::value_type& entry, const EDID& e) { return entry.first < e; });
+    return it != _descriptors.end() && it->first == edid ? it : _descriptors.end();
+}
+
+
 //----------------------------------------------------------------------------
 // Lookup a table function by table id, using standards and CAS id.
 //----------------------------------------------------------------------------
@@ -87,7 +105,7 @@ FUNCTION ts::PSIRepository::getTableFunction(TID tid, Standards standards, PID p
     size_t fallbackCount = 0;
 
     // Look for an exact match.
-    for (auto it = _tables.lower_bound(tid); it != _tables.end() && it->first == tid; ++it) {
+    for (auto it = tableLowerBound(tid); it != _tables.end() && it->first == tid; ++it) {
         // Ignore entries for which the searched function is not present.
         if (it->second.*member != nullptr) {
 
@@ -130,7 +148,7 @@ FUNCTION ts::PSIRepository::getDescriptorFunction(const EDID& edid, TID tid, FUN
 
     if (edid.isStandard() && tid != TID_NULL) {
         // For standard descriptors, first search a table-specific descriptor.
-        it = _descriptors.find(EDID::TableSpecific(edid.did(), tid));
+        it = findDescriptor(EDID::TableSpecific(edid.did(), tid));
         // If not found and there is a table-specific name for the descriptor,
         // do not fallback to non-table-specific function for this descriptor.
         if (it == _descriptors.end() && (edid.isTableSpecific() || names::HasTableSpecificName(edid.did(), tid))) {
@@ -139,7 +157,7 @@ FUNCTION ts::PSIRepository::getDescriptorFunction(const EDID& edid, TID tid, FUN
     }
     if (it == _descriptors.end()) {
         // If non-standard or no table-specific descriptor found, use direct lookup.
-        it = _descriptors.find(edid);
+        it = findDescriptor(edid);
     }
     return it != _descriptors.end() ? it->second.*member : nullptr;
 }
@@ -189,9 +207,12 @@ ts::PSIRepository::RegisterTable::RegisterTable(TableFactory factory,
     desc.addPIDs(pids);
 
     // Store a copy of the table description for each table id.
-    // This is a multimap, distinct definitions for the same table id accumulate.
+    // The index is kept sorted. Distinct definitions for the same table id
+    // accumulate, in registration order, after the existing entries.
     for (auto it : tids) {
-        repo._tables.insert(std::make_pair(it, desc));
+        repo._tables.insert(std::upper_bound(repo._tables.begin(), repo._tables.end(), it,
+                                             [](TID id, const TableIndex::value_type& entry) { return id < entry.first; }),
+                            std::make_pair(it, desc));
     }
 }
 
@@ -219,7 +240,15 @@ ts::PSIRepository::RegisterDescriptor::RegisterDescriptor(DescriptorFactory fact
                                                           const UString& xmlNameLegacy)
 {
     registerXML(factory, edid, xmlName, xmlNameLegacy);
-    PSIRepository::Instance()._descriptors.insert(std::make_pair(edid, DescriptorDescription(factory, displayFunction)));
+
+    // Keep the index sorted, with one entry per extended descriptor id.
+    // The first registration wins, as with std::map::insert.
+    PSIRepository& repo(PSIRepository::Instance());
+    const auto it = std::lower_bound(repo._descriptors.begin(), repo._descriptors.end(), edid,
+                                     [](const DescriptorIndex::value_type& entry, const EDID& e) { return entry.first < e; });
+    if (it == repo._descriptors.end() || it->first != edid) {
+        repo._descriptors.insert(it, std::make_pair(edid, DescriptorDescription(factory, displayFunction)));
+    }
 }
 
 void ts::PSIRepository::RegisterDescriptor::registerXML(DescriptorFactory factory, const EDID& edid, const UString& xmlName, const UString& xmlNameLegacy)
@@ -307,7 +336,7 @@ ts::Standards ts::PSIRepository::getTableStandards(TID tid, PID pid) const
 {
     // Accumulate the common subset of all standards for this table id.
     Standards standards = Standards::NONE;
-    for (auto it = _tables.lower_bound(tid); it != _tables.end() && it->first == tid; ++it) {
+    for (auto it = tableLowerBound(tid); it != _tables.end() && it->first == tid; ++it) {
         if (it->second.hasPID(pid)) {
             // We are in a standard PID for this table id, return the corresponding standards only.
             return it->second.standards;
@@ -380,7 +409,7 @@ void ts::PSIRepository::getRegisteredTableIds(std::vector<TID>& ids) const
     ids.clear();
     TID previous = TID_NULL;
     for (const auto& it : _tables) {
-        // This is a multimap, the same key can be reused, use it once only.
+        // The same table id can be repeated in the index, use it once only.
         if (it.first != previous) {
             ids.push_back(it.first);
             previous = it.first;
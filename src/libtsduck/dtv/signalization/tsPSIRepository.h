@@ -343,15 +343,30 @@ namespace ts {
             DescriptorDescription(DescriptorFactory fact = nullptr, DisplayDescriptorFunction disp = nullptr);
         };
 
+        // The table and descriptor descriptions are stored in flat sorted vectors
+        // instead of node-based containers. The vectors are updated each time a
+        // registration occurs, during the initialization of the application or
+        // when a TSDuck extension is loaded. Lookups, which occur on each
+        // deserialized section or descriptor, are binary searches in contiguous
+        // storage, without pointer chasing.
+        typedef std::vector<std::pair<TID, TableDescription>> TableIndex;
+        typedef std::vector<std::pair<EDID, DescriptorDescription>> DescriptorIndex;
+
         // PSIRepository instance private members.
-        std::multimap<TID, TableDescription>            _tables {};                   // Description of all table ids, potential multiple entries per table idx
-        std::map<EDID, DescriptorDescription>           _descriptors {};              // Description of all descriptors, by extended id.
+        TableIndex                                      _tables {};                   // Description of all table ids, sorted by table id, potential multiple entries per table id.
+        DescriptorIndex                                 _descriptors {};              // Description of all descriptors, sorted by extended id, one entry per id.
         std::map<UString, TableFactory>                 _tableNames {};               // XML table name to table factory
         std::map<UString, DescriptorFactory>            _descriptorNames {};          // XML descriptor name to descriptor factory
         std::multimap<UString, TID>                     _descriptorTablesIds {};      // XML descriptor name to table id for table-specific descriptors
         std::map<uint16_t, DisplayCADescriptorFunction> _casIdDescriptorDisplays {};  // CA_system_id to display function for CA_descriptor.
         UStringList                                     _xmlModelFiles {};            // Additional XML model files for tables.
 
+        // Binary searches in the flat sorted indexes. tableLowerBound() returns
+        // the first entry for a table id, findDescriptor() returns the entry for
+        // an extended descriptor id or _descriptors.end() when not registered.
+        TableIndex::const_iterator tableLowerBound(TID tid) const;
+        DescriptorIndex::const_iterator findDescriptor(const EDID& edid) const;
+
         // Common code to lookup a table function.
         template <typename FUNCTION, typename std::enable_if<std::is_pointer<FUNCTION>::value>::type* = nullptr>
         FUNCTION getTableFunction(TID tid, Standards standards, PID pid, uint16_t cas, FUNCTION TableDescription::* member) const;
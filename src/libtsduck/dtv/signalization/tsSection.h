@@ -350,6 +350,19 @@ namespace ts {
             return _is_valid ? size() - (isLongSection() ? LONG_SECTION_HEADER_SIZE + SECTION_CRC32_SIZE : SHORT_SECTION_HEADER_SIZE) : 0;
         }
 
+        //!
+        //! Get a shared slice view over the payload of the section.
+        //! The bytes are not copied, the slice references the same shared data
+        //! as the section. Use this instead of copying payload() into a
+        //! ByteBlock when a read-only payload must be kept or passed around.
+        //! @return A slice designating the payload of the section.
+        //! @see ByteBlockSlice
+        //!
+        ByteBlockSlice payloadSlice() const
+        {
+            return contentSlice().subSlice(headerSize(), payloadSize());
+        }
+
         //!
         //! Get a hash of the section content.
         //! @return SHA-1 value of the section content.
@@ -15,16 +15,28 @@
 #include "tsDuckContext.h"
 #include "tsxmlElement.h"
 #include "tsxmlJSONConverter.h"
+#include "tsxmlRunningDocument.h"
+#include "tsxmlStreamingDocument.h"
 #include "tsjsonNull.h"
 #include "tsFileUtils.h"
+#include "tsErrCodeReport.h"
 #include "tsEIT.h"
 #include "tsFatal.h"
 
 const ts::UChar* const ts::SectionFile::DEFAULT_BINARY_SECTION_FILE_SUFFIX = u".bin";
 const ts::UChar* const ts::SectionFile::DEFAULT_XML_SECTION_FILE_SUFFIX = u".xml";
 const ts::UChar* const ts::SectionFile::DEFAULT_JSON_SECTION_FILE_SUFFIX = u".json";
+const ts::UChar* const ts::SectionFile::DEFAULT_COMPILED_SECTION_FILE_SUFFIX = u".xcache";
 const ts::UChar* const ts::SectionFile::XML_TABLES_MODEL = u"tsduck.tables.model.xml";
 
+// Header of compiled section cache files: magic number, format version,
+// number of sections, total size in bytes of the section data.
+namespace {
+    constexpr uint32_t CACHE_FILE_MAGIC = 0x54535843;  // "TSXC"
+    constexpr uint32_t CACHE_FILE_VERSION = 1;
+    constexpr size_t   CACHE_HEADER_SIZE = 16;
+}
+
 
 //----------------------------------------------------------------------------
 // Constructors and destructors.
@@ -381,6 +393,93 @@ bool ts::SectionFile::saveBinary(std::ostream& strm, Report& report) const
 }
 
 
+//----------------------------------------------------------------------------
+// Load a compiled section cache file.
+//----------------------------------------------------------------------------
+
+bool ts::SectionFile::loadCompiled(const UString& file_name)
+{
+    std::ifstream strm(file_name.toUTF8().c_str(), std::ios::in | std::ios::binary);
+    if (!strm.is_open()) {
+        return false;
+    }
+
+    // Read and validate the cache header.
+    uint8_t header[CACHE_HEADER_SIZE];
+    strm.read(reinterpret_cast<char*>(header), CACHE_HEADER_SIZE);
+    if (size_t(strm.gcount()) != CACHE_HEADER_SIZE ||
+        GetUInt32(header) != CACHE_FILE_MAGIC ||
+        GetUInt32(header + 4) != CACHE_FILE_VERSION)
+    {
+        _report.debug(u"invalid or obsolete compiled section cache %s", {file_name});
+        return false;
+    }
+    const size_t sec_count = GetUInt32(header + 8);
+    const size_t data_size = GetUInt32(header + 12);
+
+    // Load the sections and validate them against the header metadata.
+    const size_t first_section = _sections.size();
+    const size_t first_size = binarySize();
+    ReportWithPrefix report_internal(_report, file_name + u": ");
+    if (!loadBinary(strm, report_internal) ||
+        _sections.size() - first_section != sec_count ||
+        binarySize() - first_size != data_size)
+    {
+        // Truncated or corrupted cache, discard whatever was loaded from it.
+        _sections.resize(first_section);
+        rebuildTables();
+        _report.debug(u"corrupted compiled section cache %s", {file_name});
+        return false;
+    }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Save a compiled section cache file.
+//----------------------------------------------------------------------------
+
+bool ts::SectionFile::saveCompiled(const UString& file_name, size_t first_section) const
+{
+    std::ofstream strm(file_name.toUTF8().c_str(), std::ios::out | std::ios::binary);
+    if (!strm.is_open()) {
+        return false;
+    }
+
+    // Build and write the cache header.
+    uint32_t sec_count = 0;
+    uint32_t data_size = 0;
+    for (size_t i = first_section; i < _sections.size(); ++i) {
+        if (!_sections[i].isNull() && _sections[i]->isValid()) {
+            sec_count++;
+            data_size += uint32_t(_sections[i]->size());
+        }
+    }
+    uint8_t header[CACHE_HEADER_SIZE];
+    PutUInt32(header, CACHE_FILE_MAGIC);
+    PutUInt32(header + 4, CACHE_FILE_VERSION);
+    PutUInt32(header + 8, sec_count);
+    PutUInt32(header + 12, data_size);
+    strm.write(reinterpret_cast<const char*>(header), CACHE_HEADER_SIZE);
+
+    // Write the sections after the header.
+    ReportWithPrefix report_internal(_report, file_name + u": ");
+    for (size_t i = first_section; i < _sections.size() && strm.good(); ++i) {
+        if (!_sections[i].isNull() && _sections[i]->isValid()) {
+            _sections[i]->write(strm, report_internal);
+        }
+    }
+    const bool success = strm.good();
+    strm.close();
+
+    // Do not leave a truncated cache file behind on error.
+    if (!success) {
+        fs::remove(file_name, &ErrCodeReport());
+    }
+    return success;
+}
+
+
 //----------------------------------------------------------------------------
 // Load a binary section file from a memory buffer.
 //----------------------------------------------------------------------------
@@ -492,42 +591,101 @@ bool ts::SectionFile::loadThisModel()
 // This static method loads the XML model for tables and descriptors.
 //----------------------------------------------------------------------------
 
-bool ts::SectionFile::LoadModel(xml::Document& doc, bool load_extensions)
-{
-    // Load the main model. Use searching rules.
-    if (!doc.load(XML_TABLES_MODEL, true)) {
-        doc.report().error(u"Main model for TSDuck XML files not found: %s", {XML_TABLES_MODEL});
-        return false;
-    }
+namespace {
 
-    // If no extension to be loaded, nothing more to do.
-    if (!load_extensions) {
-        return true;
-    }
+    // Effectively search, load and merge the model and extension files.
+    bool LoadModelFiles(ts::xml::Document& doc, bool load_extensions)
+    {
+        // Load the main model. Use searching rules.
+        if (!doc.load(ts::SectionFile::XML_TABLES_MODEL, true)) {
+            doc.report().error(u"Main model for TSDuck XML files not found: %s", {ts::SectionFile::XML_TABLES_MODEL});
+            return false;
+        }
 
-    // Get the root element in the model.
-    xml::Element* root = doc.rootElement();
-    if (root == nullptr) {
-        doc.report().error(u"Main model for TSDuck XML files is empty: %s", {XML_TABLES_MODEL});
-        return false;
-    }
+        // If no extension to be loaded, nothing more to do.
+        if (!load_extensions) {
+            return true;
+        }
 
-    // Get the list of all registered extension files.
-    UStringList extfiles;
-    PSIRepository::Instance().getRegisteredTablesModels(extfiles);
+        // Get the root element in the model.
+        ts::xml::Element* root = doc.rootElement();
+        if (root == nullptr) {
+            doc.report().error(u"Main model for TSDuck XML files is empty: %s", {ts::SectionFile::XML_TABLES_MODEL});
+            return false;
+        }
 
-    // Load all extension files. Only report a warning in case of failure.
-    for (const auto& name : extfiles) {
-        // Load the extension file. Use searching rules.
-        xml::Document extdoc(doc.report());
-        if (!extdoc.load(name, true)) {
-            extdoc.report().error(u"Extension XML model file not found: %s", {name});
+        // Get the list of all registered extension files.
+        ts::UStringList extfiles;
+        ts::PSIRepository::Instance().getRegisteredTablesModels(extfiles);
+
+        // Load all extension files. Only report a warning in case of failure.
+        for (const auto& name : extfiles) {
+            // Load the extension file. Use searching rules.
+            ts::xml::Document extdoc(doc.report());
+            if (!extdoc.load(name, true)) {
+                extdoc.report().error(u"Extension XML model file not found: %s", {name});
+            }
+            else {
+                root->merge(extdoc.rootElement());
+            }
         }
-        else {
-            root->merge(extdoc.rootElement());
+        return true;
+    }
+
+    // Process-wide cache of the parsed and merged model, with and without
+    // extensions. Applications may load hundreds of section files in a row,
+    // search, read and parse the model files only once per process.
+    class ModelCache
+    {
+        TS_NOCOPY(ModelCache);
+    public:
+        ModelCache() = default;
+
+        // Get a copy of the parsed model, loading the model files on first call.
+        bool get(ts::xml::Document& doc, bool load_extensions)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            const size_t index = load_extensions ? 1 : 0;
+            if (!_loaded[index]) {
+                // First call: load the files, errors go to the caller's report.
+                // A failed load is not cached, the next caller will retry.
+                if (!LoadModelFiles(doc, load_extensions)) {
+                    return false;
+                }
+                CopyDocument(doc, _models[index]);
+                _loaded[index] = true;
+            }
+            else {
+                CopyDocument(_models[index], doc);
+            }
+            return true;
+        }
+
+    private:
+        std::mutex        _mutex {};
+        ts::xml::Document _models[2];            // indexed by load_extensions
+        bool              _loaded[2] {false, false};
+
+        // Replace the content of a document with a deep copy of another one.
+        static void CopyDocument(const ts::xml::Document& from, ts::xml::Document& to)
+        {
+            to.clear();
+            for (const ts::xml::Node* child = from.firstChild(); child != nullptr; child = child->nextSibling()) {
+                child->clone()->reparent(&to);
+            }
         }
+    };
+
+    ModelCache& ModelCacheInstance()
+    {
+        static ModelCache cache;
+        return cache;
     }
-    return true;
+}
+
+bool ts::SectionFile::LoadModel(xml::Document& doc, bool load_extensions)
+{
+    return ModelCacheInstance().get(doc, load_extensions);
 }
 
 
@@ -537,9 +695,69 @@ bool ts::SectionFile::LoadModel(xml::Document& doc, bool load_extensions)
 
 bool ts::SectionFile::loadXML(const UString& file_name)
 {
-    xml::Document doc(_report);
+    // The compiled cache applies to actual files only, not inline XML or standard input.
+    const bool real_file = !file_name.empty() && file_name != u"-" && !xml::Document::IsInlineXML(file_name);
+    const UString cache_name(file_name + DEFAULT_COMPILED_SECTION_FILE_SUFFIX);
+
+    // Transparently prefer the compiled cache when it is newer than the XML source.
+    if (_compiled_cache && real_file &&
+        GetFileModificationTimeUTC(cache_name) > GetFileModificationTimeUTC(file_name) &&
+        loadCompiled(cache_name))
+    {
+        _report.debug(u"loaded compiled section cache %s", {cache_name});
+        return true;
+    }
+
+    // Load the XML model for TSDuck files, if not already done.
+    if (!loadThisModel()) {
+        return false;
+    }
+
+    // Use a "streaming" document: each table element is parsed, validated,
+    // converted and freed on the fly. The complete DOM of a potentially huge
+    // file never exists in memory, the memory usage stays proportional to one
+    // table (see the symmetric comment in saveXML()).
+    xml::StreamingDocument doc(_report);
     doc.setTweaks(_xmlTweaks);
-    return doc.load(file_name, false) && parseDocument(doc);
+    const size_t first_section = _sections.size();
+    const xml::Element* root = doc.open(file_name);
+    if (root == nullptr) {
+        return false;
+    }
+
+    // Check the root element of the document, as ModelDocument::validate() does
+    // on a fully loaded document (validateChildOfRoot() only checks the model root).
+    if (!root->name().similar(u"tsduck")) {
+        _report.error(u"invalid XML document, expected <%s> as root, found <%s>", {u"tsduck", root->name()});
+        return false;
+    }
+
+    // Analyze all tables in the document, one element at a time.
+    bool success = true;
+    xml::Element* node = nullptr;
+    while ((node = doc.nextElement()) != nullptr) {
+        BinaryTablePtr bin(new BinaryTable);
+        CheckNonNull(bin.pointer());
+        if (_model.validateChildOfRoot(u"tsduck", node) && bin->fromXML(_duck, node) && bin->isValid()) {
+            add(bin);
+        }
+        else {
+            _report.error(u"Error in table <%s> at line %d", {node->name(), node->lineNumber()});
+            success = false;
+        }
+        // Free each table element after conversion.
+        delete node;
+    }
+    if (!doc.close() || !success) {
+        return false;
+    }
+
+    // Regenerate a missing or obsolete cache. This is a best effort only,
+    // the XML content is already loaded (eg. read-only directories).
+    if (_compiled_cache && real_file && !saveCompiled(cache_name, first_section)) {
+        _report.debug(u"cannot create compiled section cache %s", {cache_name});
+    }
+    return true;
 }
 
 bool ts::SectionFile::loadXML(std::istream& strm)
@@ -594,9 +812,30 @@ bool ts::SectionFile::parseDocument(const xml::Document& doc)
 
 bool ts::SectionFile::saveXML(const UString& file_name) const
 {
-    xml::Document doc(_report);
+    // Use a "running" document: each table is serialized and freed on the fly.
+    // The complete DOM of a potentially huge file never exists in memory.
+    xml::RunningDocument doc(_report);
     doc.setTweaks(_xmlTweaks);
-    return generateDocument(doc) && doc.save(file_name);
+    xml::Element* root = doc.open(u"tsduck", UString(), file_name);
+    if (root == nullptr) {
+        return false;
+    }
+
+    // Format all tables, one at a time.
+    for (auto& table : _tables) {
+        if (!table.isNull()) {
+            table->toXML(_duck, root);
+            doc.flush();
+        }
+    }
+
+    // Issue a warning if incomplete tables were not saved.
+    if (!_orphanSections.empty()) {
+        _report.warning(u"%d orphan sections not saved in XML document (%d tables saved)", {_orphanSections.size(), _tables.size()});
+    }
+
+    doc.close();
+    return true;
 }
 
 ts::UString ts::SectionFile::toXML() const
@@ -154,6 +154,24 @@ namespace ts {
         //!
         void setCRCValidation(CRC32::Validation crc_op) { _crc_op = crc_op; }
 
+        //!
+        //! Enable or disable the compiled section cache for XML files.
+        //!
+        //! When enabled, loading an XML file transparently prefers a sibling "compiled"
+        //! binary cache file when its timestamp is newer than the XML source and
+        //! regenerates the cache after a successful XML parse, in the same way script
+        //! languages cache their byte-code. This avoids the cost of XML parsing when
+        //! the same table files are repeatedly loaded, for instance on playout restart.
+        //!
+        //! The cache file is named after the XML file, with the suffix
+        //! DEFAULT_COMPILED_SECTION_FILE_SUFFIX appended. It uses a versioned binary
+        //! format; obsolete, truncated or corrupted cache files are ignored and
+        //! rebuilt from the XML source.
+        //!
+        //! @param [in] on True to use the compiled section cache when loading XML files.
+        //!
+        void setCompiledSectionCache(bool on) { _compiled_cache = on; }
+
         //!
         //! Load a binary or XML file.
         //! The loaded sections are added to the content of this object.
@@ -470,6 +488,12 @@ namespace ts {
         //!
         static const UChar* const DEFAULT_JSON_SECTION_FILE_SUFFIX;
 
+        //!
+        //! Default file name suffix for compiled section cache files.
+        //! @see setCompiledSectionCache()
+        //!
+        static const UChar* const DEFAULT_COMPILED_SECTION_FILE_SUFFIX;
+
         //!
         //! File name of the XML model file for tables.
         //!
@@ -484,6 +508,7 @@ namespace ts {
         xml::JSONConverter   _model {_report};        // XML model for tables.
         xml::Tweaks          _xmlTweaks {};           // XML formatting and parsing tweaks.
         CRC32::Validation    _crc_op = CRC32::IGNORE; // Processing of CRC32 when loading sections.
+        bool                 _compiled_cache = false; // Use compiled cache files when loading XML files.
 
         // Load the XML model in this instance, if not already done.
         bool loadThisModel();
@@ -492,6 +517,12 @@ namespace ts {
         bool loadBinary(std::istream& strm, Report& report);
         bool saveBinary(std::ostream& strm, Report& report) const;
 
+        // Load/save a compiled section cache file. Loading silently fails on
+        // invalid cache files. Saving writes the sections starting at the
+        // specified index, ie. the sections from the XML file being cached.
+        bool loadCompiled(const UString& file_name);
+        bool saveCompiled(const UString& file_name, size_t first_section) const;
+
         // Rebuild _tables and _orphanSections from _sections.
         void rebuildTables();
 
@@ -78,6 +78,15 @@ void ts::SectionFileArgs::defineArgs(Args& args)
               u"With --eit-normalization, generate EIT other schedule. "
               u"If no option is specified, all EIT sections are generated.");
 
+    args.option(u"compiled-cache");
+    args.help(u"compiled-cache",
+              u"When loading an XML section file, use a compiled binary cache of that file. "
+              u"The cache file is located in the same directory as the XML file, with an "
+              u"additional extension \"" + UString(SectionFile::DEFAULT_COMPILED_SECTION_FILE_SUFFIX) + u"\". "
+              u"It is transparently used when it is newer than the XML file and rebuilt "
+              u"after the XML file is parsed. This speeds up the repeated loading of "
+              u"large collections of XML files.");
+
     args.option(u"pack-and-flush");
     args.help(u"pack-and-flush",
               u"When loading a binary section file, pack incomplete tables and flush them. "
@@ -93,6 +102,7 @@ void ts::SectionFileArgs::defineArgs(Args& args)
 bool ts::SectionFileArgs::loadArgs(DuckContext& duck, Args& args)
 {
     pack_and_flush = args.present(u"pack-and-flush");
+    compiled_cache = args.present(u"compiled-cache");
     eit_normalize = args.present(u"eit-normalization");
     eit_base_time = Time::Epoch;
 
@@ -7,7 +7,9 @@
 //----------------------------------------------------------------------------
 
 #include "tsServiceDiscovery.h"
+#include "tsChannelFile.h"
 #include "tsDuckContext.h"
+#include "tsNullReport.h"
 #include "tsBinaryTable.h"
 #include "tsPAT.h"
 #include "tsSDT.h"
@@ -69,6 +71,49 @@ void ts::ServiceDiscovery::set(const UString& desc)
 }
 
 
+//----------------------------------------------------------------------------
+// Preload the service description from a channel configuration file.
+//----------------------------------------------------------------------------
+
+bool ts::ServiceDiscovery::preloadFromChannelFile(const UString& fileName)
+{
+    // Only applicable when the service is known by name only.
+    // When the service id is already known, there is nothing to resolve.
+    if (!hasName() || hasId()) {
+        return false;
+    }
+
+    // Load the channel database.
+    ChannelFile file;
+    file.setCompiledCache(true);
+    if (!file.load(fileName, _duck.report())) {
+        return false;
+    }
+
+    // Search the service by name, case-insensitive.
+    ChannelFile::NetworkPtr net;
+    ChannelFile::TransportStreamPtr tstream;
+    ChannelFile::ServicePtr srv;
+    if (!file.searchService(net, tstream, srv, getName(), false, NULLREP)) {
+        _duck.report().debug(u"service \"%s\" not found in %s", {getName(), file.fileDescription()});
+        return false;
+    }
+
+    // Use the service id from the channel database. The live SI are still
+    // monitored and take precedence when they disagree (see processSDT()).
+    setId(srv->id);
+    setTSId(tstream->id);
+    setONId(tstream->onid);
+    _unconfirmedId = true;
+
+    // We can immediately look for the service in the PAT, no need to wait for the SDT or VCT.
+    _demux.addPID(PID_PAT);
+
+    _duck.report().verbose(u"service \"%s\" has id 0x%X (%d) in %s", {getName(), getId(), getId(), file.fileDescription()});
+    return true;
+}
+
+
 //----------------------------------------------------------------------------
 // Clear all fields
 //----------------------------------------------------------------------------
@@ -77,6 +122,7 @@ void ts::ServiceDiscovery::clear()
 {
     _demux.reset();
     _pmt.invalidate();
+    _unconfirmedId = false;
     Service::clear();
 }
 
@@ -162,14 +208,18 @@ void ts::ServiceDiscovery::processSDT(const SDT& sdt)
         }
     }
     else if (sdt.findService(_duck, getName(), service_id)) {
-        // Service is found by name in the SDT.
+        // Service is found by name in the SDT. The actual SI now take
+        // precedence over a service id preloaded from a channel file.
+        _unconfirmedId = false;
         srv = sdt.services.find(service_id);
         assert(srv != sdt.services.end());
     }
     else {
         // Service not found by name in SDT. If we already know the service id, this is fine.
         // If we do not know the service id, then there is no way to find the service.
-        if (!hasId()) {
+        // A service id which was preloaded from a channel file but is not in the live SI
+        // does not count as known.
+        if (!hasId() || _unconfirmedId) {
             _duck.report().error(u"service \"%s\" not found in SDT", {getName()});
             _notFound = true;
         }
@@ -255,13 +305,19 @@ void ts::ServiceDiscovery::analyzeVCT(const VCT& vct)
     else if ((srv = vct.findService(getName())) == vct.channels.end()) {
         // Service not found by name in VCT. If we already know the service id, this is fine.
         // If we do not know the service id, then there is no way to find the service.
-        if (!hasId()) {
+        // A service id which was preloaded from a channel file but is not in the live SI
+        // does not count as known.
+        if (!hasId() || _unconfirmedId) {
             _duck.report().error(u"service \"%s\" not found in VCT", {getName()});
             _notFound = true;
         }
         return;
     }
 
+    // The service was found by name in the VCT, the actual SI now take
+    // precedence over a service id preloaded from a channel file.
+    _unconfirmedId = false;
+
     // If the service id was previously unknown wait for the PAT.
     // If a service id was known but was different, we need to rescan the PAT.
     assert(srv != vct.channels.end());
@@ -303,10 +359,20 @@ void ts::ServiceDiscovery::processPAT(const PAT& pat)
         // A service id was known, locate the service in the PAT.
         it = pat.pmts.find(getId());
         if (it == pat.pmts.end()) {
-            _duck.report().error(u"service id 0x%X (%d) not found in PAT", {getId(), getId()});
-            _notFound = true;
+            if (_unconfirmedId) {
+                // The service id was preloaded from a channel file and is not in the
+                // live PAT. The database may be stale, wait for the SDT or VCT to
+                // resolve the service name from the actual SI.
+                _duck.report().verbose(u"service id 0x%X (%d) from channel database not found in PAT, waiting for actual SI", {getId(), getId()});
+            }
+            else {
+                _duck.report().error(u"service id 0x%X (%d) not found in PAT", {getId(), getId()});
+                _notFound = true;
+            }
             return;
         }
+        // The preloaded service id is present in the actual PAT.
+        _unconfirmedId = false;
     }
     else {
         // If no service was specified, use the first service from the PAT.
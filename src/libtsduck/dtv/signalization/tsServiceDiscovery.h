@@ -50,6 +50,19 @@ namespace ts {
         virtual void set(const UString& desc) override;
         virtual void clear() override;
 
+        //!
+        //! Preload the service description from a channel configuration file.
+        //! When the service is specified by name, its service id is resolved immediately
+        //! from the channel database instead of waiting for the SDT or VCT in the stream.
+        //! Thus, the application can start filtering the service right after the first PAT.
+        //! The live SI are still monitored and take precedence when they disagree with
+        //! the channel database.
+        //! @param [in] fileName Channel configuration file name, use the default file if empty.
+        //! @return True if the service was resolved from the file, false otherwise.
+        //! @see ChannelFile
+        //!
+        bool preloadFromChannelFile(const UString& fileName = UString());
+
         //!
         //! The following method feeds the service discovery with a TS packet.
         //! The application should pass all packets of the TS.
@@ -85,6 +98,7 @@ namespace ts {
     private:
         DuckContext& _duck;
         bool         _notFound = false;     // Set when service does not exist.
+        bool         _unconfirmedId = false; // Service id was preloaded from a channel file, not yet seen in live SI.
         SignalizationHandlerInterface* _pmtHandler = nullptr;  // Handler to call for each new PMT.
         PMT          _pmt {};               // Last valid PMT for the service.
         SectionDemux _demux {_duck, this};  // PSI demux for service discovery.
@@ -9,6 +9,8 @@
 #include "tsTablePatchXML.h"
 #include "tsxmlPatchDocument.h"
 #include "tsxmlElement.h"
+#include "tsPSIRepository.h"
+#include "tsAbstractTable.h"
 #include "tsFatal.h"
 #include "tsArgs.h"
 #include "tsEIT.h"
@@ -23,6 +25,7 @@ void ts::TablePatchXML::clear()
 {
     _patchFiles.clear();
     _patches.clear();
+    _table_names.clear();
 }
 
 
@@ -106,6 +109,58 @@ void ts::TablePatchXML::applyPatches(xml::Document& doc) const
 }
 
 
+//----------------------------------------------------------------------------
+// Get the XML name a known table type serializes to.
+//----------------------------------------------------------------------------
+
+ts::UString ts::TablePatchXML::tableXMLName(const BinaryTable& table) const
+{
+    // Cache the resolution since building a table instance is required to get its XML name.
+    const uint64_t key = (uint64_t(table.tableId()) << 32) | (uint64_t(_duck.standards()) << 16) | uint64_t(table.sourcePID());
+    const auto it = _table_names.find(key);
+    if (it != _table_names.end()) {
+        return it->second;
+    }
+
+    // Get the table factory, the same way BinaryTable::toXML() selects it.
+    UString name;
+    const PSIRepository::TableFactory fac = PSIRepository::Instance().getTableFactory(table.tableId(), _duck.standards(), table.sourcePID());
+    if (fac != nullptr) {
+        const AbstractTablePtr tp(fac());
+        if (!tp.isNull()) {
+            name = tp->xmlName();
+        }
+    }
+    _table_names.insert(std::make_pair(key, name));
+    return name;
+}
+
+
+//----------------------------------------------------------------------------
+// Fast check if some patch may alter a table of that type.
+//----------------------------------------------------------------------------
+
+bool ts::TablePatchXML::canPatch(const BinaryTable& table) const
+{
+    // Invalid tables are rejected later, with the appropriate error message.
+    if (!table.isValid() || table.sectionCount() == 0 || table.sectionAt(0).isNull()) {
+        return true;
+    }
+
+    // XML names the table may serialize to: the specialized name when the table type
+    // is known and the generic name which is used when deserialization fails.
+    const UString spec(tableXMLName(table));
+    const UString generic(table.sectionAt(0)->isShortSection() ? AbstractTable::XML_GENERIC_SHORT_TABLE : AbstractTable::XML_GENERIC_LONG_TABLE);
+
+    for (const auto& patch : _patches) {
+        if ((!spec.empty() && patch->canPatch(spec)) || patch->canPatch(generic)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+
 //----------------------------------------------------------------------------
 // Apply the XML patch files to a binary table.
 //----------------------------------------------------------------------------
@@ -117,6 +172,11 @@ bool ts::TablePatchXML::applyPatches(BinaryTable& table) const
         return true;
     }
 
+    // If no patch can alter that table type, skip the costly XML round trip.
+    if (!canPatch(table)) {
+        return true;
+    }
+
     // Initialize the document structure.
     xml::Document doc(_duck.report());
     xml::Element* root = doc.initialize(u"tsduck");
@@ -130,5 +130,15 @@ namespace ts {
         DuckContext&        _duck;           // TSDuck execution context.
         UStringVector       _patchFiles {};  // XML patch file names.
         PatchDocumentVector _patches {};     // XML patch files as loaded documents
+
+        // Cached XML names of table types, indexed by table id / standards / PID.
+        mutable std::map<uint64_t, UString> _table_names {};
+
+        // Fast check if some patch may alter a table of that type.
+        // When false, the table can skip the XML round trip.
+        bool canPatch(const BinaryTable& table) const;
+
+        // Get the XML name a known table type serializes to, empty string for unknown tables.
+        UString tableXMLName(const BinaryTable& table) const;
     };
 }
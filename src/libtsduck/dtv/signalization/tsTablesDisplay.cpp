@@ -190,6 +190,12 @@ void ts::TablesDisplay::displayTable(const BinaryTable& table, const UString& ma
         return;
     }
 
+    // When the output stream is in error state (closed file or display disabled
+    // by the application), skip all formatting, the text would be discarded anyway.
+    if (strm.fail()) {
+        return;
+    }
+
     // Display hexa dump of each section in the table
     if (_raw_dump) {
         for (size_t i = 0; i < table.sectionCount(); ++i) {
@@ -249,6 +255,11 @@ void ts::TablesDisplay::displaySection(const Section& section, const UString& ma
         return;
     }
 
+    // Skip all formatting when the output stream is in error state.
+    if (strm.fail()) {
+        return;
+    }
+
     // Display hexa dump of the section
     if (_raw_dump) {
         strm << UString::Dump(section.content(), section.size(), _raw_flags | UString::BPL, margin.size(), 16) << std::endl;
@@ -327,11 +338,27 @@ void ts::TablesDisplay::displaySection(const Section& section, const UString& ma
 
 void ts::TablesDisplay::displaySectionData(const Section& section, const UString& margin, uint16_t cas)
 {
+    // Skip all formatting when the output stream is in error state.
+    if (_duck.out().fail()) {
+        return;
+    }
+
     // Update CAS with default one if necessary.
     cas = _duck.casId(cas);
 
     // Find the display handler for this table id (and maybe CAS).
-    DisplaySectionFunction handler = PSIRepository::Instance().getSectionDisplay(section.tableId(), _duck.standards(), section.sourcePID(), cas);
+    // The resolution is cached: the same table types are displayed over and over
+    // in a session and repository lookups are much more expensive than a map read.
+    DisplaySectionFunction handler = nullptr;
+    const uint64_t key = handlerCacheKey(section.tableId(), _duck.standards(), section.sourcePID(), cas);
+    const auto cached = _display_cache.find(key);
+    if (cached != _display_cache.end()) {
+        handler = cached->second;
+    }
+    else {
+        handler = PSIRepository::Instance().getSectionDisplay(section.tableId(), _duck.standards(), section.sourcePID(), cas);
+        _display_cache.insert(std::make_pair(key, handler));
+    }
 
     if (handler != nullptr) {
         PSIBuffer buf(_duck, section.payload(), section.payloadSize());
@@ -376,9 +403,19 @@ void ts::TablesDisplay::logSectionData(const Section& section, const UString& he
     cas = _duck.casId(cas);
 
     // Find the log handler for this table id (and maybe CAS).
-    LogSectionFunction handler = PSIRepository::Instance().getSectionLog(section.tableId(), _duck.standards(), section.sourcePID(), cas);
-    if (handler == nullptr) {
-        handler = LogUnknownSectionData;
+    // Cached for the same reason as the display handlers.
+    LogSectionFunction handler = nullptr;
+    const uint64_t key = handlerCacheKey(section.tableId(), _duck.standards(), section.sourcePID(), cas);
+    const auto cached = _log_cache.find(key);
+    if (cached != _log_cache.end()) {
+        handler = cached->second;
+    }
+    else {
+        handler = PSIRepository::Instance().getSectionLog(section.tableId(), _duck.standards(), section.sourcePID(), cas);
+        if (handler == nullptr) {
+            handler = LogUnknownSectionData;
+        }
+        _log_cache.insert(std::make_pair(key, handler));
     }
 
     // Output exactly one line.
@@ -12,7 +12,9 @@
 //----------------------------------------------------------------------------
 
 #pragma once
+#include "tsTS.h"
 #include "tsPSI.h"
+#include "tsTablesPtr.h"
 #include "tsTLVSyntax.h"
 #include "tsDuckContext.h"
 
@@ -463,5 +465,17 @@ namespace ts {
         uint32_t        _raw_flags = UString::HEXA; // Dump flags in raw mode.
         TLVSyntaxVector _tlv_syntax {};             // TLV syntax to apply to unknown sections.
         size_t          _min_nested_tlv = 0;        // Minimum size of a TLV record after which it is interpreted as a nested TLV (0=disabled).
+
+        // Cached handler resolutions from PSIRepository. The same table types are
+        // typically displayed over and over in a session, no need to resolve the
+        // handler in the repository for each section.
+        std::map<uint64_t, DisplaySectionFunction> _display_cache {};
+        std::map<uint64_t, LogSectionFunction>     _log_cache {};
+
+        // Key of a cached handler resolution: table id, standards, source PID, CAS id.
+        static uint64_t handlerCacheKey(TID tid, Standards standards, PID pid, uint16_t cas)
+        {
+            return (uint64_t(tid) << 45) | (uint64_t(standards) << 29) | (uint64_t(pid) << 16) | uint64_t(cas);
+        }
     };
 }
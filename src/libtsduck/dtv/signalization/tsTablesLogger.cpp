@@ -229,6 +229,28 @@ void ts::TablesLogger::defineArgs(Args& args)
               u"With --json-output, rewrite the same file with each table. "
               u"The specified file always contains one single table, the latest one.");
 
+    args.option(u"sink-queue-size", 0, Args::POSITIVE);
+    args.help(u"sink-queue-size",
+              UString::Format(u"With --binary-output or --ip-udp, specify the maximum number of sections or UDP "
+                              u"messages which can be queued for the output thread. The binary and UDP outputs "
+                              u"are written from a dedicated thread so that a slow disk or network does not "
+                              u"stall the section collection. When the queue is full, new sections or messages "
+                              u"are dropped and counted. The default is %d messages.", {DEFAULT_SINK_QUEUE_SIZE}));
+
+    args.option(u"udp-batch-size", 0, Args::POSITIVE);
+    args.help(u"udp-batch-size", u"bytes",
+              u"With --ip-udp and --no-encapsulation, accumulate several raw sections in "
+              u"each UDP datagram, up to the specified number of bytes. Use a value slightly "
+              u"below the network MTU. Batching drastically reduces the datagram rate on "
+              u"section-heavy streams. The receiver is unchanged: raw datagrams already "
+              u"contain any number of concatenated sections. By default, each section or "
+              u"table is sent in its own datagram.");
+
+    args.option(u"udp-batch-delay", 0, Args::POSITIVE);
+    args.help(u"udp-batch-delay", u"milliseconds",
+              UString::Format(u"With --udp-batch-size, specify the maximum time to hold an "
+                              u"incomplete batch before sending it. The default is %d ms.", {DEFAULT_UDP_BATCH_DELAY}));
+
     args.option(u"text-output", 0, Args::FILENAME);
     args.help(u"text-output", u"filename", u"A synonym for --output-file.");
 
@@ -307,6 +329,9 @@ bool ts::TablesLogger::loadArgs(DuckContext& duck, Args& args)
     _invalid_sections = _invalid_only || args.present(u"invalid-sections");
     _invalid_versions = args.present(u"invalid-versions");
     args.getIntValue(_max_tables, u"max-tables", 0);
+    args.getIntValue(_sink_queue_size, u"sink-queue-size", DEFAULT_SINK_QUEUE_SIZE);
+    args.getIntValue(_udp_batch_size, u"udp-batch-size", 0);
+    args.getIntValue(_udp_batch_delay, u"udp-batch-delay", DEFAULT_UDP_BATCH_DELAY);
     _time_stamp = args.present(u"time-stamp");
     _packet_index = args.present(u"packet-index");
     _logger = args.present(u"log");
@@ -326,6 +351,10 @@ bool ts::TablesLogger::loadArgs(DuckContext& duck, Args& args)
         args.error(u"filtering sections (--all-sections or --all-once) is incompatible with XML or JSON output");
         return false;
     }
+    if (_udp_batch_size > 0 && !_udp_raw) {
+        args.error(u"--udp-batch-size requires --no-encapsulation, TLV messages cannot be batched");
+        return false;
+    }
 
     // Load options from all section filters.
     _initial_pids.reset();
@@ -364,6 +393,13 @@ bool ts::TablesLogger::open()
     _deep_hashes.clear();
     _sections_once.clear();
     _x2j_conv.clear();
+    _sink_error = false;
+    _bin_drop_count = 0;
+    _udp_drop_count = 0;
+    _sink_queue.clear();
+    _sink_queue.setMaxMessages(_sink_queue_size);
+    _udp_batch = new ByteBlock;
+    _udp_batch->reserve(_udp_batch_size);
 
     if (_bin_file.is_open()) {
         _bin_file.close();
@@ -398,6 +434,10 @@ bool ts::TablesLogger::open()
     // Log TS error at verbose level.
     _demux.setTransportErrorLogLevel(Severity::Verbose);
 
+    // Recycle section data buffers. Section-heavy streams (EIT's) would
+    // otherwise allocate one short-lived buffer per assembled section.
+    _demux.setSectionBufferPool(true);
+
     // Load the XML model for tables if we need to convert to JSON.
     if ((_use_json || _log_json_line) && !SectionFile::LoadModel(_x2j_conv)) {
         return false;
@@ -453,6 +493,16 @@ bool ts::TablesLogger::open()
         }
     }
 
+    // Start the sink writer thread when a binary or UDP output is active.
+    // Once started, the thread owns the binary file and the UDP socket.
+    _sink_active = _use_binary || _use_udp;
+    if (_sink_active && !start()) {
+        _report.error(u"error starting the output writer thread");
+        _sink_active = false;
+        _abort = true;
+        return false;
+    }
+
     return true;
 }
 
@@ -464,7 +514,6 @@ bool ts::TablesLogger::open()
 void ts::TablesLogger::close()
 {
     if (!_exit) {
-
         // Pack sections in incomplete tables if required.
         if (_pack_and_flush) {
             _demux.packAndFlushSections();
@@ -472,7 +521,26 @@ void ts::TablesLogger::close()
         if (_fill_eit) {
             _demux.fillAndFlushEITs();
         }
+    }
+
+    // Send the last incomplete UDP batch, if any.
+    if (_udp_batch_size > 0 && !_udp_batch.isNull()) {
+        flushUDPBatch();
+    }
+
+    // Terminate the sink writer thread, it owns the binary file and the UDP
+    // socket. The termination message is queued after all pending data. This
+    // must be done even when _exit is already set (eg. max tables reached).
+    if (_sink_active) {
+        _sink_queue.forceEnqueue(new SinkMessage);
+        waitForTermination();
+        _sink_active = false;
+        if (_bin_drop_count > 0 || _udp_drop_count > 0) {
+            _report.warning(u"output too slow, dropped %'d binary sections and %'d UDP messages", {_bin_drop_count, _udp_drop_count});
+        }
+    }
 
+    if (!_exit) {
         // Close files and documents.
         _xml_doc.close();
         _json_doc.close();
@@ -499,6 +567,10 @@ void ts::TablesLogger::feedPacket(const TSPacket& pkt)
         _demux.feedPacket(pkt);
         _cas_mapper.feedPacket(pkt);
         _packet_count++;
+        // Send an incomplete UDP batch when its flush deadline is reached.
+        if (_udp_batch_size > 0 && !_udp_batch->empty() && Monotonic(true) >= _udp_batch_due) {
+            flushUDPBatch();
+        }
     }
 }
 
@@ -634,16 +706,24 @@ void ts::TablesLogger::handleTable(SectionDemux& demux, const BinaryTable& table
 
     // Save table in binary format.
     if (_use_binary) {
-        // In case of rewrite for each table, create a new file.
-        if (_rewrite_binary && !createBinaryFile(_bin_destination)) {
-            return;
-        }
-        // Save each section in binary format
-        for (size_t i = 0; i < table.sectionCount(); ++i) {
-            saveBinarySection(*table.sectionAt(i));
+        if (_rewrite_binary && !_bin_multi_files) {
+            // Rewrite the file with this single table, all sections in one message.
+            SinkMessage* msg = new SinkMessage;
+            msg->type = SinkMessage::BINARY;
+            msg->name = _bin_destination;
+            msg->close = true;
+            msg->data = new ByteBlock;
+            msg->data->reserve(table.totalSize());
+            for (size_t i = 0; i < table.sectionCount(); ++i) {
+                msg->data->append(table.sectionAt(i)->content(), table.sectionAt(i)->size());
+            }
+            enqueueSink(msg);
         }
-        if (_rewrite_binary && _bin_file.is_open()) {
-            _bin_file.close();
+        else {
+            // Save each section in binary format.
+            for (size_t i = 0; i < table.sectionCount(); ++i) {
+                saveBinarySection(*table.sectionAt(i));
+            }
         }
     }
 
@@ -763,14 +843,7 @@ void ts::TablesLogger::handleSection(SectionDemux& demux, const Section& sect)
     }
 
     if (_use_binary) {
-        // In case of rewrite for each section, create a new file.
-        if (_rewrite_binary && !createBinaryFile(_bin_destination)) {
-            return;
-        }
         saveBinarySection(sect);
-        if (_rewrite_binary && _bin_file.is_open()) {
-            _bin_file.close();
-        }
     }
 
     if (_log_hexa_line) {
@@ -877,21 +950,16 @@ void ts::TablesLogger::logXMLJSON(const BinaryTable& table)
 
 
 //----------------------------------------------------------------------------
-// Send UDP table and section.
+// Post a table or a section to the UDP sink.
 //----------------------------------------------------------------------------
 
 void ts::TablesLogger::sendUDP(const ts::BinaryTable& table)
 {
-    ByteBlockPtr bin(new ByteBlock);
-
-    // Minimize allocation by reserving over size
-    bin->reserve(table.totalSize() + 32 + 4 * table.sectionCount());
-
     if (_udp_raw) {
-        // Add raw content of each section the message
+        // Raw mode: sections are self-contained, batch them individually.
         for (size_t i = 0; i < table.sectionCount(); ++i) {
             const Section& sect(*table.sectionAt(i));
-            bin->append(sect.content(), sect.size());
+            appendUDPBatch(sect.content(), sect.size());
         }
     }
     else {
@@ -902,19 +970,24 @@ void ts::TablesLogger::sendUDP(const ts::BinaryTable& table)
         for (size_t i = 0; i < table.sectionCount(); ++i) {
             msg.sections.push_back(table.sectionAt(i));
         }
+        ByteBlockPtr bin(new ByteBlock);
+        bin->reserve(table.totalSize() + 32 + 4 * table.sectionCount());
         tlv::Serializer serial(bin);
         msg.serialize(serial);
-    }
 
-    // Send TLV message over UDP
-    _sock.send(bin->data(), bin->size(), _report);
+        // The datagram is sent by the sink writer thread.
+        SinkMessage* sink = new SinkMessage;
+        sink->type = SinkMessage::UDP;
+        sink->data = bin;
+        enqueueSink(sink);
+    }
 }
 
 void ts::TablesLogger::sendUDP(const ts::Section& section)
 {
     if (_udp_raw) {
-        // Send raw content of section as one single UDP message
-        _sock.send(section.content(), section.size(), _report);
+        // Raw mode: batch the section or send it as one single UDP message.
+        appendUDPBatch(section.content(), section.size());
     }
     else {
         // Build a TLV message.
@@ -928,8 +1001,61 @@ void ts::TablesLogger::sendUDP(const ts::Section& section)
         tlv::Serializer serial(bin);
         msg.serialize(serial);
 
-        // Send TLV message over UDP
-        _sock.send(bin->data(), bin->size(), _report);
+        // The datagram is sent by the sink writer thread.
+        SinkMessage* sink = new SinkMessage;
+        sink->type = SinkMessage::UDP;
+        sink->data = bin;
+        enqueueSink(sink);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Append a raw section to the UDP batch.
+//----------------------------------------------------------------------------
+
+void ts::TablesLogger::appendUDPBatch(const uint8_t* data, size_t size)
+{
+    if (_udp_batch_size == 0) {
+        // No batching, send the section in its own datagram.
+        SinkMessage* sink = new SinkMessage;
+        sink->type = SinkMessage::UDP;
+        sink->data = new ByteBlock(data, size);
+        enqueueSink(sink);
+        return;
+    }
+
+    // Send the current batch first when this section does not fit in it.
+    if (!_udp_batch->empty() && _udp_batch->size() + size > _udp_batch_size) {
+        flushUDPBatch();
+    }
+
+    // Start the flush deadline with the first section of a batch.
+    if (_udp_batch->empty()) {
+        _udp_batch_due = Monotonic(true);
+        _udp_batch_due += _udp_batch_delay * NanoSecPerMilliSec;
+    }
+
+    _udp_batch->append(data, size);
+    if (_udp_batch->size() >= _udp_batch_size) {
+        flushUDPBatch();
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Post the accumulated UDP batch, if any.
+//----------------------------------------------------------------------------
+
+void ts::TablesLogger::flushUDPBatch()
+{
+    if (!_udp_batch->empty()) {
+        SinkMessage* sink = new SinkMessage;
+        sink->type = SinkMessage::UDP;
+        sink->data = _udp_batch;
+        enqueueSink(sink);
+        _udp_batch = new ByteBlock;
+        _udp_batch->reserve(_udp_batch_size);
     }
 }
 
@@ -1024,7 +1150,69 @@ bool ts::TablesLogger::AnalyzeUDPMessage(const duck::Protocol& protocol, const u
 
 
 //----------------------------------------------------------------------------
-// Create a binary file. On error, set _abort and return false.
+// Post a message to the sink writer thread.
+//----------------------------------------------------------------------------
+
+void ts::TablesLogger::enqueueSink(SinkMessage* msg)
+{
+    // A zero timeout means that the message is dropped when the queue is
+    // full. The demux shall never wait for a slow disk or network.
+    const SinkMessage::Type type = msg->type;
+    if (!_sink_queue.enqueue(msg, 0)) {
+        if (type == SinkMessage::BINARY) {
+            _bin_drop_count++;
+        }
+        else {
+            _udp_drop_count++;
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Invoked in the context of the sink writer thread.
+//----------------------------------------------------------------------------
+
+void ts::TablesLogger::main()
+{
+    _report.debug(u"sink writer thread started");
+
+    for (;;) {
+        SinkQueue::MessagePtr msg;
+        _sink_queue.dequeue(msg);
+        if (msg.isNull() || msg->type == SinkMessage::TERMINATE) {
+            break;
+        }
+        if (msg->type == SinkMessage::UDP) {
+            if (!_sock.send(msg->data->data(), msg->data->size(), _report)) {
+                _sink_error = true;
+            }
+        }
+        else {
+            // Binary sink: optionally create a new file, write, optionally close.
+            if (!msg->name.empty() && !createBinaryFile(msg->name)) {
+                continue;
+            }
+            std::ostream& strm(_bin_stdout ? std::cout : _bin_file);
+            if (!strm.write(reinterpret_cast<const char*>(msg->data->data()), std::streamsize(msg->data->size()))) {
+                _report.error(u"error writing binary section");
+                _sink_error = true;
+            }
+            else if (_flush) {
+                strm.flush();
+            }
+            if (msg->close && _bin_file.is_open()) {
+                _bin_file.close();
+            }
+        }
+    }
+
+    _report.debug(u"sink writer thread completed");
+}
+
+
+//----------------------------------------------------------------------------
+// Create a binary file. On error, set _sink_error and return false.
 //----------------------------------------------------------------------------
 
 bool ts::TablesLogger::createBinaryFile(const ts::UString& name)
@@ -1041,7 +1229,7 @@ bool ts::TablesLogger::createBinaryFile(const ts::UString& name)
         }
         else {
             _report.error(u"error creating %s", {name});
-            _abort = true;
+            _sink_error = true;
             return false;
         }
     }
@@ -1049,12 +1237,15 @@ bool ts::TablesLogger::createBinaryFile(const ts::UString& name)
 
 
 //----------------------------------------------------------------------------
-// Save a section in a binary file
+// Post a section to the binary sink.
 //----------------------------------------------------------------------------
 
 void ts::TablesLogger::saveBinarySection(const Section& sect)
 {
-    // Create individual file for this section if required.
+    SinkMessage* msg = new SinkMessage;
+    msg->type = SinkMessage::BINARY;
+
+    // Individual file for this section if required, created and closed by the writer thread.
     if (_bin_multi_files) {
         // Build a unique file name for this section
         UString outname(PathPrefix(_bin_destination));
@@ -1063,20 +1254,17 @@ void ts::TablesLogger::saveBinarySection(const Section& sect)
             outname.format(u"_e%04X_v%02X_s%02X", {sect.tableIdExtension(), sect.version(), sect.sectionNumber()});
         }
         outname += PathSuffix(_bin_destination);
-        // Create the output file
-        if (!createBinaryFile(outname)) {
-            return;
-        }
+        msg->name = outname;
+        msg->close = true;
     }
-
-    // Write the section to the file
-    const bool success = _bin_stdout ? bool(sect.write(std::cout, _report)) : bool(sect.write(_bin_file, _report));
-    _abort = _abort || !success;
-
-    // Close individual files
-    if (_bin_multi_files && _bin_file.is_open()) {
-        _bin_file.close();
+    else if (_rewrite_binary) {
+        // Rewrite the same file with this single section.
+        msg->name = _bin_destination;
+        msg->close = true;
     }
+
+    msg->data = new ByteBlock(sect.content(), sect.size());
+    enqueueSink(msg);
 }
 
 
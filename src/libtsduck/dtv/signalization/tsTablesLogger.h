@@ -24,6 +24,9 @@
 #include "tsxmlJSONConverter.h"
 #include "tsjsonRunningDocument.h"
 #include "tsDuckProtocol.h"
+#include "tsMessageQueue.h"
+#include "tsMonotonic.h"
+#include "tsThread.h"
 
 namespace ts {
     //!
@@ -33,7 +36,8 @@ namespace ts {
     class TSDUCKDLL TablesLogger :
         protected TableHandlerInterface,
         protected SectionHandlerInterface,
-        protected InvalidSectionHandlerInterface
+        protected InvalidSectionHandlerInterface,
+        private Thread
     {
         TS_NOBUILD_NOCOPY(TablesLogger);
     public:
@@ -56,6 +60,19 @@ namespace ts {
         //!
         static constexpr size_t DEFAULT_LOG_SIZE = 8;
 
+        //!
+        //! Default maximum number of sections or messages which can be queued
+        //! for the binary and UDP outputs.
+        //! @see option -\-sink-queue-size
+        //!
+        static constexpr size_t DEFAULT_SINK_QUEUE_SIZE = 512;
+
+        //!
+        //! Default flush delay in milliseconds for an incomplete UDP batch.
+        //! @see option -\-udp-batch-delay
+        //!
+        static constexpr MilliSecond DEFAULT_UDP_BATCH_DELAY = 20;
+
         //!
         //! Add command line option definitions in an Args.
         //! @param [in,out] args Command line arguments to update.
@@ -110,13 +127,13 @@ namespace ts {
         //! Check if an error was found.
         //! @return True when an error was found.
         //!
-        bool hasErrors() const { return _abort; }
+        bool hasErrors() const { return _abort || _sink_error; }
 
         //!
         //! Check if the operation is complete.
         //! @return True when the operation is complete (eg. max number of logged tables reached).
         //!
-        bool completed() const { return _abort || _exit; }
+        bool completed() const { return _abort || _sink_error || _exit; }
 
         //!
         //! Report the demux errors (if any).
@@ -195,6 +212,9 @@ namespace ts {
         bool                     _fill_eit = false;          // Add missing empty sections to incomplete EIT's before exiting.
         bool                     _use_current = true;        // Use tables with "current" flag.
         bool                     _use_next = false;          // Use tables with "next" flag.
+        size_t                   _sink_queue_size = DEFAULT_SINK_QUEUE_SIZE;  // Max queued messages for the sink writer thread.
+        size_t                   _udp_batch_size = 0;        // Batch raw sections in UDP datagrams up to this size (0: no batching).
+        MilliSecond              _udp_batch_delay = DEFAULT_UDP_BATCH_DELAY;  // Max time to hold an incomplete UDP batch.
         xml::Tweaks              _xml_tweaks {};             // XML tweak options.
         PIDSet                   _initial_pids {};           // Initial PID's to filter.
         BinaryTable::XMLOptions  _xml_options {};            // XML conversion options.
@@ -223,19 +243,54 @@ namespace ts {
         TablesLoggerFilterVector _section_filters {};        // All registered section filters.
         duck::Protocol           _duck_protocol {};          // To generate UDP messages.
 
-        // Create a binary file. On error, set _abort and return false.
+        // The binary file and UDP outputs are written from a dedicated thread.
+        // Writing them synchronously from the demux handlers would stall the
+        // section collection when the disk or the network is slow. Messages
+        // are posted in a bounded queue; when the writer thread cannot keep
+        // up, new messages are dropped and counted instead of blocking.
+        class SinkMessage
+        {
+        public:
+            enum Type {TERMINATE, BINARY, UDP};
+            Type         type = TERMINATE;  // Which sink shall process the message.
+            UString      name {};           // BINARY: file to create first (empty: use the already open file).
+            bool         close = false;     // BINARY: close the file after writing.
+            ByteBlockPtr data {};           // Section content or UDP datagram.
+        };
+        typedef MessageQueue<SinkMessage, std::mutex> SinkQueue;
+        SinkQueue     _sink_queue {};        // Communication with the sink writer thread.
+        volatile bool _sink_error = false;   // The sink writer thread encountered a write error.
+        bool          _sink_active = false;  // The sink writer thread is started.
+        uint64_t      _bin_drop_count = 0;   // Binary sections dropped on sink queue overflow.
+        uint64_t      _udp_drop_count = 0;   // UDP messages dropped on sink queue overflow.
+        ByteBlockPtr  _udp_batch {};         // Raw sections accumulated for the next UDP datagram.
+        Monotonic     _udp_batch_due {};     // When the current UDP batch shall be flushed.
+
+        // Post a message to the sink writer thread. Count drops when the queue is full.
+        void enqueueSink(SinkMessage* msg);
+
+        // Invoked in the context of the sink writer thread.
+        virtual void main() override;
+
+        // Create a binary file. On error, set _sink_error and return false.
         bool createBinaryFile(const UString& name);
 
-        // Save a section in a binary file
+        // Post a section to the binary sink.
         void saveBinarySection(const Section&);
 
         // Log XML and/or JSON one-liners.
         void logXMLJSON(const BinaryTable& table);
 
-        // Send UDP table and section.
+        // Post a table or a section to the UDP sink.
         void sendUDP(const BinaryTable& table);
         void sendUDP(const Section& section);
 
+        // Append a raw section to the UDP batch or post it immediately without batching.
+        void appendUDPBatch(const uint8_t* data, size_t size);
+
+        // Post the accumulated UDP batch, if any.
+        void flushUDPBatch();
+
         // Pre/post-display of a table or section
         void preDisplay(PacketCounter first, PacketCounter last);
         void postDisplay();
@@ -8,6 +8,7 @@
 
 #include "tsDuckContext.h"
 #include "tsDuckConfigFile.h"
+#include "tsDuckExtensionRepository.h"
 #include "tsDVBCharTableSingleByte.h"
 #include "tsDVBCharTableUTF8.h"
 #include "tsARIBCharset.h"
@@ -547,6 +548,11 @@ void ts::DuckContext::defineOptions(Args& args, int cmdOptionsMask)
 
 bool ts::DuckContext::loadArgs(Args& args)
 {
+    // Arguments are loaded, actual processing starts: make sure the extensions
+    // are loaded now (no-op when already done). Their PSI/SI registrations must
+    // be available and the cost stays off the pure command line analysis path.
+    DuckExtensionRepository::Instance().loadExtensions();
+
     // List of forced standards from the command line.
     _cmdStandards = Standards::NONE;
 
@@ -29,6 +29,7 @@ ts::T2MIDemux::PIDContext::PIDContext() :
     continuity(0),
     sync(false),
     t2mi(),
+    pkt_buffer(),
     plps()
 {
 }
@@ -160,8 +161,19 @@ void ts::T2MIDemux::feedPacket(const TSPacket& pkt)
 void ts::T2MIDemux::PIDContext::lostSync()
 {
     t2mi.clear();   // accumulated T2-MI packet buffer.
-    plps.clear();   // we also lose partially demuxed PLP's.
     sync = false;
+    // We also lose partially demuxed PLP's. Reset the contexts but keep them
+    // in the map so that their TS buffers can be reused without reallocation.
+    for (const auto& it : plps) {
+        it.second->reset();
+    }
+}
+
+void ts::T2MIDemux::PLPContext::reset()
+{
+    first_packet = true;
+    ts.clear();   // keep the buffer capacity for reuse.
+    ts_next = 0;
 }
 
 
@@ -191,8 +203,18 @@ void ts::T2MIDemux::processT2MI(PID pid, PIDContext& pc)
                 break;
             }
 
-            // Build a T2-MI packet.
-            T2MIPacket pkt(pc.t2mi.data() + start, packet_size, pid);
+            // Build a T2-MI packet. The binary content is copied into the scratch buffer
+            // of the PID context which is reused from one T2-MI packet to the other,
+            // instead of allocating a new ByteBlock for each packet. The buffer can be
+            // reused only when the handler did not keep a reference to the previous packet.
+            if (pc.pkt_buffer.isNull() || pc.pkt_buffer.count() > 1) {
+                pc.pkt_buffer = new ByteBlock(pc.t2mi.data() + start, packet_size);
+                CheckNonNull(pc.pkt_buffer.pointer());
+            }
+            else {
+                pc.pkt_buffer->copy(pc.t2mi.data() + start, packet_size);
+            }
+            T2MIPacket pkt(pc.pkt_buffer, pid);
             if (pkt.isValid()) {
 
                 // Notify the application.
@@ -307,18 +329,16 @@ void ts::T2MIDemux::demuxTS(PID pid, PIDContext& pc, const T2MIPacket& pkt)
         }
     }
 
-    // Now process each complete TS packet.
-    while (plpp->ts_next + PKT_SIZE <= plpp->ts.size()) {
-
-        // Build the TS packet.
-        TSPacket tsPkt;
-        std::memcpy(tsPkt.b, &plpp->ts[plpp->ts_next], PKT_SIZE);
-        plpp->ts_next += PKT_SIZE;
-
+    // Now process all complete TS packets in one batch. Since the TS buffer is
+    // built from whole 188-byte packets, it can be directly viewed as an array
+    // of TS packets, without copying each of them into a separate structure.
+    const size_t pkt_count = (plpp->ts.size() - plpp->ts_next) / PKT_SIZE;
+    if (pkt_count > 0) {
         // Notify the application. Note that we are already in a protected section.
         if (_handler != nullptr) {
-            _handler->handleTSPacket(*this, pkt, tsPkt);
+            _handler->handleTSPacketBatch(*this, pkt, reinterpret_cast<const TSPacket*>(plpp->ts.data() + plpp->ts_next), pkt_count);
         }
+        plpp->ts_next += pkt_count * PKT_SIZE;
     }
 
     // Compress or cleanup the TS buffer.
@@ -81,6 +81,9 @@ namespace ts {
 
             // Default constructor
             PLPContext();
+
+            // Reset the context, keeping the buffer capacity for reuse.
+            void reset();
         };
 
         // Map of safe pointers to PLPContext, indexed by PLP id.
@@ -93,6 +96,7 @@ namespace ts {
             uint8_t       continuity;  // Last continuity counter
             bool          sync;        // We are synchronous in this PID
             ByteBlock     t2mi;        // Buffer containing the T2-MI data.
+            ByteBlockPtr  pkt_buffer;  // Scratch buffer for one T2-MI packet, reused from frame to frame.
             PLPContextMap plps;        // Map of PLP context per PID.
 
             // Default constructor
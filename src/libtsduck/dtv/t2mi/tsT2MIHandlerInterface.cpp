@@ -11,3 +11,11 @@
 ts::T2MIHandlerInterface::~T2MIHandlerInterface()
 {
 }
+
+// Default implementation: process the extracted packets one by one.
+void ts::T2MIHandlerInterface::handleTSPacketBatch(T2MIDemux& demux, const T2MIPacket& t2mi, const TSPacket* ts, size_t ts_count)
+{
+    for (size_t i = 0; i < ts_count; ++i) {
+        handleTSPacket(demux, t2mi, ts[i]);
+    }
+}
@@ -55,5 +55,18 @@ namespace ts {
         //! @param [in] ts The extracted TS packet.
         //!
         virtual void handleTSPacket(T2MIDemux& demux, const T2MIPacket& t2mi, const TSPacket& ts) = 0;
+
+        //!
+        //! This hook is invoked when several TS packets are extracted from one T2-MI packet.
+        //! The default implementation invokes handleTSPacket() once per packet. Applications
+        //! which process extracted packets in bulk should override this hook instead to avoid
+        //! the per-packet invocation overhead.
+        //! @param [in,out] demux A reference to the T2-MI demux.
+        //! @param [in] t2mi The T2-MI packet from which the TS packets were extracted.
+        //! @param [in] ts Address of the first extracted TS packet. The packets are
+        //! contiguous in memory but are valid only during the execution of the hook.
+        //! @param [in] ts_count Number of extracted TS packets.
+        //!
+        virtual void handleTSPacketBatch(T2MIDemux& demux, const T2MIPacket& t2mi, const TSPacket* ts, size_t ts_count);
     };
 }
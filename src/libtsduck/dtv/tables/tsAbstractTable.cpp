@@ -124,6 +124,18 @@ ts::AbstractTable::EntryWithDescriptors& ts::AbstractTable::EntryWithDescriptors
 //----------------------------------------------------------------------------
 
 bool ts::AbstractTable::serialize(DuckContext& duck, BinaryTable& table) const
+{
+    // Build a one-shot buffer of the appropriate size and serialize into it.
+    PSIBuffer payload(duck, maxPayloadSize());
+    return serialize(table, payload);
+}
+
+
+//----------------------------------------------------------------------------
+// Serialize a table using a caller-supplied (and reusable) buffer.
+//----------------------------------------------------------------------------
+
+bool ts::AbstractTable::serialize(BinaryTable& table, PSIBuffer& payload) const
 {
     // Reinitialize table object.
     table.clear();
@@ -134,10 +146,11 @@ bool ts::AbstractTable::serialize(DuckContext& duck, BinaryTable& table) const
     }
 
     // Add the standards of the serialized table into the context.
-    duck.addStandards(definingStandards());
+    payload.duck().addStandards(definingStandards());
 
-    // Build a buffer of the appropriate size.
-    PSIBuffer payload(duck, maxPayloadSize());
+    // Reset the buffer to the appropriate size. When the buffer is reused across
+    // serializations, its internal memory is reallocated only when it needs to grow.
+    payload.reset(maxPayloadSize());
 
     // Let the subclass serialize the sections payloads.
     serializePayload(table, payload);
@@ -68,6 +68,24 @@ namespace ts {
         //!
         bool serialize(DuckContext& duck, BinaryTable& bin) const;
 
+        //!
+        //! This method serializes a table using a caller-supplied serialization buffer.
+        //!
+        //! This is a variant of serialize() for applications which repeatedly regenerate
+        //! tables, such as cyclic table updates in plugins. The caller owns the buffer and
+        //! reuses it from one serialization to another. The buffer is reset here before use
+        //! and its internal memory is reallocated only when the required payload size exceeds
+        //! the largest size previously used with this buffer (see Buffer::reset()). Thus,
+        //! after a few serializations, no more allocation is performed.
+        //!
+        //! @param [out] bin A binary table object.
+        //! Its content is replaced with a binary representation of this object.
+        //! @param [in,out] buf A serialization buffer which can be reused across calls.
+        //! The TSDuck execution context of the buffer is updated with the standards of the table.
+        //! @return True in case of success, false if the table is invalid.
+        //!
+        bool serialize(BinaryTable& bin, PSIBuffer& buf) const;
+
         //!
         //! This method deserializes a binary table.
         //! In case of success, this object is replaced with the interpreted content of @a bin.
@@ -55,6 +55,65 @@ namespace {
         0x08, 0xFF, 0xFF, 0x05, 0xFF, 0x0E, 0x0D, 0xFF, 0xFF, 0x0E, 0x0F, 0xFF, 0x0E, 0x0E, 0xFF, 0x0E
     };
 
+    // Static tables of partial syndromes for the 24/18 Hamming code, indexed by
+    // each byte of the 24-bit code word. The XOR of the three entries gives the
+    // result of tests A-F (ETS 300 706, section 8.3) on the whole word, which
+    // replaces a 24-iteration bit loop by three table lookups.
+    const uint8_t UNHAM_24_18_PAR0[256] = {
+        0x00, 0x21, 0x22, 0x03, 0x23, 0x02, 0x01, 0x20, 0x24, 0x05, 0x06, 0x27, 0x07, 0x26, 0x25, 0x04,
+        0x25, 0x04, 0x07, 0x26, 0x06, 0x27, 0x24, 0x05, 0x01, 0x20, 0x23, 0x02, 0x22, 0x03, 0x00, 0x21,
+        0x26, 0x07, 0x04, 0x25, 0x05, 0x24, 0x27, 0x06, 0x02, 0x23, 0x20, 0x01, 0x21, 0x00, 0x03, 0x22,
+        0x03, 0x22, 0x21, 0x00, 0x20, 0x01, 0x02, 0x23, 0x27, 0x06, 0x05, 0x24, 0x04, 0x25, 0x26, 0x07,
+        0x27, 0x06, 0x05, 0x24, 0x04, 0x25, 0x26, 0x07, 0x03, 0x22, 0x21, 0x00, 0x20, 0x01, 0x02, 0x23,
+        0x02, 0x23, 0x20, 0x01, 0x21, 0x00, 0x03, 0x22, 0x26, 0x07, 0x04, 0x25, 0x05, 0x24, 0x27, 0x06,
+        0x01, 0x20, 0x23, 0x02, 0x22, 0x03, 0x00, 0x21, 0x25, 0x04, 0x07, 0x26, 0x06, 0x27, 0x24, 0x05,
+        0x24, 0x05, 0x06, 0x27, 0x07, 0x26, 0x25, 0x04, 0x00, 0x21, 0x22, 0x03, 0x23, 0x02, 0x01, 0x20,
+        0x28, 0x09, 0x0A, 0x2B, 0x0B, 0x2A, 0x29, 0x08, 0x0C, 0x2D, 0x2E, 0x0F, 0x2F, 0x0E, 0x0D, 0x2C,
+        0x0D, 0x2C, 0x2F, 0x0E, 0x2E, 0x0F, 0x0C, 0x2D, 0x29, 0x08, 0x0B, 0x2A, 0x0A, 0x2B, 0x28, 0x09,
+        0x0E, 0x2F, 0x2C, 0x0D, 0x2D, 0x0C, 0x0F, 0x2E, 0x2A, 0x0B, 0x08, 0x29, 0x09, 0x28, 0x2B, 0x0A,
+        0x2B, 0x0A, 0x09, 0x28, 0x08, 0x29, 0x2A, 0x0B, 0x0F, 0x2E, 0x2D, 0x0C, 0x2C, 0x0D, 0x0E, 0x2F,
+        0x0F, 0x2E, 0x2D, 0x0C, 0x2C, 0x0D, 0x0E, 0x2F, 0x2B, 0x0A, 0x09, 0x28, 0x08, 0x29, 0x2A, 0x0B,
+        0x2A, 0x0B, 0x08, 0x29, 0x09, 0x28, 0x2B, 0x0A, 0x0E, 0x2F, 0x2C, 0x0D, 0x2D, 0x0C, 0x0F, 0x2E,
+        0x29, 0x08, 0x0B, 0x2A, 0x0A, 0x2B, 0x28, 0x09, 0x0D, 0x2C, 0x2F, 0x0E, 0x2E, 0x0F, 0x0C, 0x2D,
+        0x0C, 0x2D, 0x2E, 0x0F, 0x2F, 0x0E, 0x0D, 0x2C, 0x28, 0x09, 0x0A, 0x2B, 0x0B, 0x2A, 0x29, 0x08
+    };
+    const uint8_t UNHAM_24_18_PAR1[256] = {
+        0x00, 0x29, 0x2A, 0x03, 0x2B, 0x02, 0x01, 0x28, 0x2C, 0x05, 0x06, 0x2F, 0x07, 0x2E, 0x2D, 0x04,
+        0x2D, 0x04, 0x07, 0x2E, 0x06, 0x2F, 0x2C, 0x05, 0x01, 0x28, 0x2B, 0x02, 0x2A, 0x03, 0x00, 0x29,
+        0x2E, 0x07, 0x04, 0x2D, 0x05, 0x2C, 0x2F, 0x06, 0x02, 0x2B, 0x28, 0x01, 0x29, 0x00, 0x03, 0x2A,
+        0x03, 0x2A, 0x29, 0x00, 0x28, 0x01, 0x02, 0x2B, 0x2F, 0x06, 0x05, 0x2C, 0x04, 0x2D, 0x2E, 0x07,
+        0x2F, 0x06, 0x05, 0x2C, 0x04, 0x2D, 0x2E, 0x07, 0x03, 0x2A, 0x29, 0x00, 0x28, 0x01, 0x02, 0x2B,
+        0x02, 0x2B, 0x28, 0x01, 0x29, 0x00, 0x03, 0x2A, 0x2E, 0x07, 0x04, 0x2D, 0x05, 0x2C, 0x2F, 0x06,
+        0x01, 0x28, 0x2B, 0x02, 0x2A, 0x03, 0x00, 0x29, 0x2D, 0x04, 0x07, 0x2E, 0x06, 0x2F, 0x2C, 0x05,
+        0x2C, 0x05, 0x06, 0x2F, 0x07, 0x2E, 0x2D, 0x04, 0x00, 0x29, 0x2A, 0x03, 0x2B, 0x02, 0x01, 0x28,
+        0x30, 0x19, 0x1A, 0x33, 0x1B, 0x32, 0x31, 0x18, 0x1C, 0x35, 0x36, 0x1F, 0x37, 0x1E, 0x1D, 0x34,
+        0x1D, 0x34, 0x37, 0x1E, 0x36, 0x1F, 0x1C, 0x35, 0x31, 0x18, 0x1B, 0x32, 0x1A, 0x33, 0x30, 0x19,
+        0x1E, 0x37, 0x34, 0x1D, 0x35, 0x1C, 0x1F, 0x36, 0x32, 0x1B, 0x18, 0x31, 0x19, 0x30, 0x33, 0x1A,
+        0x33, 0x1A, 0x19, 0x30, 0x18, 0x31, 0x32, 0x1B, 0x1F, 0x36, 0x35, 0x1C, 0x34, 0x1D, 0x1E, 0x37,
+        0x1F, 0x36, 0x35, 0x1C, 0x34, 0x1D, 0x1E, 0x37, 0x33, 0x1A, 0x19, 0x30, 0x18, 0x31, 0x32, 0x1B,
+        0x32, 0x1B, 0x18, 0x31, 0x19, 0x30, 0x33, 0x1A, 0x1E, 0x37, 0x34, 0x1D, 0x35, 0x1C, 0x1F, 0x36,
+        0x31, 0x18, 0x1B, 0x32, 0x1A, 0x33, 0x30, 0x19, 0x1D, 0x34, 0x37, 0x1E, 0x36, 0x1F, 0x1C, 0x35,
+        0x1C, 0x35, 0x36, 0x1F, 0x37, 0x1E, 0x1D, 0x34, 0x30, 0x19, 0x1A, 0x33, 0x1B, 0x32, 0x31, 0x18
+    };
+    const uint8_t UNHAM_24_18_PAR2[256] = {
+        0x00, 0x31, 0x32, 0x03, 0x33, 0x02, 0x01, 0x30, 0x34, 0x05, 0x06, 0x37, 0x07, 0x36, 0x35, 0x04,
+        0x35, 0x04, 0x07, 0x36, 0x06, 0x37, 0x34, 0x05, 0x01, 0x30, 0x33, 0x02, 0x32, 0x03, 0x00, 0x31,
+        0x36, 0x07, 0x04, 0x35, 0x05, 0x34, 0x37, 0x06, 0x02, 0x33, 0x30, 0x01, 0x31, 0x00, 0x03, 0x32,
+        0x03, 0x32, 0x31, 0x00, 0x30, 0x01, 0x02, 0x33, 0x37, 0x06, 0x05, 0x34, 0x04, 0x35, 0x36, 0x07,
+        0x37, 0x06, 0x05, 0x34, 0x04, 0x35, 0x36, 0x07, 0x03, 0x32, 0x31, 0x00, 0x30, 0x01, 0x02, 0x33,
+        0x02, 0x33, 0x30, 0x01, 0x31, 0x00, 0x03, 0x32, 0x36, 0x07, 0x04, 0x35, 0x05, 0x34, 0x37, 0x06,
+        0x01, 0x30, 0x33, 0x02, 0x32, 0x03, 0x00, 0x31, 0x35, 0x04, 0x07, 0x36, 0x06, 0x37, 0x34, 0x05,
+        0x34, 0x05, 0x06, 0x37, 0x07, 0x36, 0x35, 0x04, 0x00, 0x31, 0x32, 0x03, 0x33, 0x02, 0x01, 0x30,
+        0x20, 0x11, 0x12, 0x23, 0x13, 0x22, 0x21, 0x10, 0x14, 0x25, 0x26, 0x17, 0x27, 0x16, 0x15, 0x24,
+        0x15, 0x24, 0x27, 0x16, 0x26, 0x17, 0x14, 0x25, 0x21, 0x10, 0x13, 0x22, 0x12, 0x23, 0x20, 0x11,
+        0x16, 0x27, 0x24, 0x15, 0x25, 0x14, 0x17, 0x26, 0x22, 0x13, 0x10, 0x21, 0x11, 0x20, 0x23, 0x12,
+        0x23, 0x12, 0x11, 0x20, 0x10, 0x21, 0x22, 0x13, 0x17, 0x26, 0x25, 0x14, 0x24, 0x15, 0x16, 0x27,
+        0x17, 0x26, 0x25, 0x14, 0x24, 0x15, 0x16, 0x27, 0x23, 0x12, 0x11, 0x20, 0x10, 0x21, 0x22, 0x13,
+        0x22, 0x13, 0x10, 0x21, 0x11, 0x20, 0x23, 0x12, 0x16, 0x27, 0x24, 0x15, 0x25, 0x14, 0x17, 0x26,
+        0x21, 0x10, 0x13, 0x22, 0x12, 0x23, 0x20, 0x11, 0x15, 0x24, 0x27, 0x16, 0x26, 0x17, 0x14, 0x25,
+        0x14, 0x25, 0x26, 0x17, 0x27, 0x16, 0x15, 0x24, 0x20, 0x11, 0x12, 0x23, 0x13, 0x22, 0x21, 0x10
+    };
+
     // Static table to swap bits in a byte.
     const uint8_t REVERSE_8[256] = {
         0x00, 0x80, 0x40, 0xC0, 0x20, 0xA0, 0x60, 0xE0, 0x10, 0x90, 0x50, 0xD0, 0x30, 0xB0, 0x70, 0xF0,
@@ -95,15 +154,9 @@ uint8_t ts::TeletextDemux::unham_8_4(uint8_t a)
 
 uint32_t ts::TeletextDemux::unham_24_18(uint32_t a)
 {
-    uint8_t test = 0;
-
     // Tests A-F correspond to bits 0-6 respectively in 'test'.
-    for (uint8_t i = 0; i < 23; i++) {
-        test ^= ((a >> i) & 0x01) * (i + 33);
-    }
-
-    // Only parity bit is tested for bit 24
-    test ^= ((a >> 23) & 0x01) * 32;
+    // Table-driven computation, one lookup per byte of the code word.
+    const uint8_t test = UNHAM_24_18_PAR0[a & 0xFF] ^ UNHAM_24_18_PAR1[(a >> 8) & 0xFF] ^ UNHAM_24_18_PAR2[(a >> 16) & 0xFF];
 
     if ((test & 0x1F) != 0x1F) {
         // Not all tests A-E correct
@@ -142,7 +195,9 @@ ts::TeletextDemux::TeletextDemux(DuckContext& duck, TeletextHandlerInterface* ha
     SuperClass(duck, nullptr, pidFilter),
     _txtHandler(handler),
     _pids(),
-    _addColors(false)
+    _addColors(false),
+    _pageFilter(),
+    _magazineMask(0)
 {
 }
 
@@ -178,6 +233,28 @@ ts::TeletextDemux::PIDContext::PIDContext() :
 }
 
 
+//-----------------------------------------------------------------------------
+// Management of the page filter.
+//-----------------------------------------------------------------------------
+
+void ts::TeletextDemux::addPageFilter(int page)
+{
+    // Internally, Teletext page numbers are stored in Binary-Coded Decimal.
+    const int bcdPage = pageBinaryToBcd(page);
+    _pageFilter.insert(bcdPage);
+
+    // Keep track of magazines containing filtered pages for early row discard.
+    const int m = magazineOf(bcdPage);
+    _magazineMask |= uint16_t(1 << (m == 0 ? 8 : m));
+}
+
+void ts::TeletextDemux::resetPageFilter()
+{
+    _pageFilter.clear();
+    _magazineMask = 0;
+}
+
+
 //-----------------------------------------------------------------------------
 // Reset the analysis context (partially built TELETEXT packets).
 //-----------------------------------------------------------------------------
@@ -234,6 +311,23 @@ void ts::TeletextDemux::handlePESPacket(const PESPacket& packet)
             unitSize == TELETEXT_PACKET_SIZE &&
             (unitId == TeletextDataUnitId::NON_SUBTITLE || unitId == TeletextDataUnitId::SUBTITLE))
         {
+            // When a page filter is active, discard rows of other magazines before
+            // bit reversal and error-correction decoding of the 40 data bytes.
+            // Only the two address bytes need to be decoded (ETS 300 706, chapter 7.1.2).
+            if (_magazineMask != 0) {
+                const uint8_t address = uint8_t(unham_8_4(REVERSE_8[pl[3]]) << 4) | unham_8_4(REVERSE_8[pl[2]]);
+                uint8_t m = address & 0x07;
+                if (m == 0) {
+                    m = 8;
+                }
+                const uint8_t y = (address >> 3) & 0x1F;
+                if (y != 0 && !wantedMagazine(m)) {
+                    plSize -= unitSize;
+                    pl += unitSize;
+                    continue;
+                }
+            }
+
             // Reverse bitwise endianess of each data byte via lookup table, ETS 300 706, chapter 7.1.
             uint8_t pkt[TELETEXT_PACKET_SIZE];
             for (int i = 0; i < unitSize; ++i) {
@@ -269,6 +363,13 @@ void ts::TeletextDemux::processTeletextPacket(PID pid, PIDContext& pc, TeletextD
     }
     uint8_t y = (address >> 3) & 0x1F;
     const uint8_t* data = pkt + 4;
+
+    // When a page filter is active, discard rows of unfiltered pages before any further decoding.
+    // Page headers (y == 0) are always processed to track page terminations.
+    if (y != 0 && !(wantedMagazine(m) && wantedPage(pc.currentPage))) {
+        return;
+    }
+
     uint8_t designationCode = (y > 25) ? unham_8_4(data[0]) : 0x00;
 
     if (y == 0) {
@@ -304,18 +405,22 @@ void ts::TeletextDemux::processTeletextPacket(PID pid, PIDContext& pc, TeletextD
             pc.receivingData = false;
         }
 
-        // A new frame starts on a page. If this page had a non-empty frame in progress, flush it now.
-        TeletextPage& page(pc.pages[pageNumber]);
-        if (page.tainted) {
-            // It would not be nice if subtitle hides previous video frame, so we contract 40 ms (1 frame @25 fps)
-            page.hideTimestamp = pidDuration(pid) - 40;
-            processTeletextPage(pid, pc, pageNumber);
-        }
+        // Unfiltered pages are still tracked for the serial/parallel termination
+        // logic above but no page buffer is allocated for them.
+        if (wantedPage(pageNumber)) {
+            // A new frame starts on a page. If this page had a non-empty frame in progress, flush it now.
+            TeletextPage& page(pc.pages[pageNumber]);
+            if (page.tainted) {
+                // It would not be nice if subtitle hides previous video frame, so we contract 40 ms (1 frame @25 fps)
+                page.hideTimestamp = pidDuration(pid) - 40;
+                processTeletextPage(pid, pc, pageNumber);
+            }
 
-        // Start new page.
+            // Start new page.
+            page.reset(pidDuration(pid));
+            page.charset.resetX28(charset);
+        }
         pc.currentPage = pageNumber;
-        page.reset(pidDuration(pid));
-        page.charset.resetX28(charset);
         pc.receivingData = true;
     }
     else if (m == magazineOf(pc.currentPage) && y >= 1 && y <= 23 && pc.receivingData) {
@@ -78,6 +78,21 @@ namespace ts {
             _txtHandler = handler;
         }
 
+        //!
+        //! Add one page in the page filter.
+        //! When the page filter is non-empty, only the filtered pages are decoded.
+        //! Teletext rows from other magazines are discarded before error-correction
+        //! decoding and no buffer is allocated for other pages.
+        //! @param [in] page Teletext page number to demux.
+        //!
+        void addPageFilter(int page);
+
+        //!
+        //! Reset the page filter.
+        //! All Teletext pages are decoded again (the default).
+        //!
+        void resetPageFilter();
+
         //!
         //! Get the number of Teletext frames found in a given page.
         //! @param [in] page Teletext page number.
@@ -220,9 +235,31 @@ namespace ts {
         //!
         static int pageBinaryToBcd(int bin);
 
+        //!
+        //! Check if a page shall be decoded, according to the page filter.
+        //! @param [in] bcdPage BCD page number.
+        //! @return True when the page shall be decoded.
+        //!
+        bool wantedPage(int bcdPage) const
+        {
+            return _pageFilter.empty() || _pageFilter.find(bcdPage) != _pageFilter.end();
+        }
+
+        //!
+        //! Check if a magazine may contain filtered pages.
+        //! @param [in] magazine Magazine number (1 to 8).
+        //! @return True when the magazine shall be decoded.
+        //!
+        bool wantedMagazine(uint8_t magazine) const
+        {
+            return _magazineMask == 0 || (_magazineMask & (1 << magazine)) != 0;
+        }
+
         // Private members:
         TeletextHandlerInterface* _txtHandler;    //!< User handler.
         PIDContextMap             _pids;          //!< Map of PID analysis contexts.
         bool                      _addColors;     //!< Add font color tags.
+        std::set<int>             _pageFilter;    //!< BCD numbers of filtered pages, empty to decode all pages.
+        uint16_t                  _magazineMask;  //!< Bit mask of magazines containing filtered pages.
     };
 }
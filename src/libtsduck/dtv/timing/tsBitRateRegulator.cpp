@@ -55,6 +55,13 @@ void ts::BitRateRegulator::start()
     _burst_duration = 0;
     _cur_bitrate = 0;
     _cur_period = 0;
+    _bits_per_sec = 0;
+    _fast_bits = false;
+
+    // Reset jitter statistics.
+    _jitter_count = 0;
+    _jitter_max = 0;
+    _jitter_cumul = 0;
 }
 
 
@@ -66,6 +73,13 @@ void ts::BitRateRegulator::handleNewBitrate()
 {
     assert(_cur_bitrate > 0);
 
+    // Update the integer fast path for the per-packet credit computations.
+    // Rounding to integer bits per second loses less than one bit per second,
+    // orders of magnitude below the packet granularity over a measurement
+    // period, and all credits are consistently computed with the same value.
+    _bits_per_sec = int64_t(_cur_bitrate.toInt());
+    _fast_bits = _bits_per_sec < std::numeric_limits<int64_t>::max() / NanoSecPerSec;
+
     // Compute the number of packets per burst. Use the packets/burst from the command line or 1 by default.
     PacketCounter burst_pkt_max = _opt_burst == 0 ? 1 : _opt_burst;
 
@@ -74,7 +88,9 @@ void ts::BitRateRegulator::handleNewBitrate()
     _burst_duration = ((NanoSecPerSec * PKT_SIZE_BITS * burst_pkt_max) / _cur_bitrate).toInt();
 
     // If the result is too small for the time precision of the operating system, recompute a larger burst duration.
-    if (_burst_duration < _burst_min) {
+    // When a final active wait is used, the precision no longer depends on the operating system timers
+    // and short bursts remain schedulable: keep the requested packets/burst.
+    if (_opt_spin == 0 && _burst_duration < _burst_min) {
         _burst_duration = _burst_min;
         burst_pkt_max = ((_burst_duration * _cur_bitrate) / (NanoSecPerSec * PKT_SIZE_BITS)).toInt();
     }
@@ -90,6 +106,59 @@ void ts::BitRateRegulator::handleNewBitrate()
 }
 
 
+//----------------------------------------------------------------------------
+// Wait until the scheduled end of burst, update jitter statistics.
+//----------------------------------------------------------------------------
+
+void ts::BitRateRegulator::waitBurstEnd()
+{
+    Monotonic now(true);
+    if (_opt_spin > 0) {
+        // Hybrid wait. First, a coarse system sleep until a few microseconds
+        // before the scheduled end of burst (skipped when the remaining time
+        // is shorter than the active wait duration).
+        if (_burst_end - now > _opt_spin) {
+            Monotonic coarse(_burst_end);
+            coarse -= _opt_spin;
+            coarse.wait();
+            now.getSystemTime();
+        }
+        // Then actively wait on the monotonic clock for the remaining time.
+        while (now < _burst_end) {
+            now.getSystemTime();
+        }
+    }
+    else {
+        // Pure system sleep until the scheduled end of burst.
+        _burst_end.wait();
+        now.getSystemTime();
+    }
+
+    // Accumulate the wake-up jitter, the lateness after the scheduled end of burst.
+    const NanoSecond late = std::max<NanoSecond>(0, now - _burst_end);
+    _jitter_count++;
+    _jitter_cumul += late;
+    _jitter_max = std::max(_jitter_max, late);
+}
+
+
+//----------------------------------------------------------------------------
+// Convert a duration in nano-seconds into a number of bits at the current bitrate.
+//----------------------------------------------------------------------------
+
+int64_t ts::BitRateRegulator::bitsFromDuration(NanoSecond duration) const
+{
+    if (_fast_bits) {
+        // Integer arithmetic only. Split whole seconds and remainder to avoid 64-bit overflow.
+        return _bits_per_sec * (duration / NanoSecPerSec) + (_bits_per_sec * (duration % NanoSecPerSec)) / NanoSecPerSec;
+    }
+    else {
+        // Extreme bitrates, keep the exact Fraction computation.
+        return int64_t(((_cur_bitrate * duration) / NanoSecPerSec).toInt());
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Process one packet in a regulated burst. Wait at end of burst.
 //----------------------------------------------------------------------------
@@ -101,12 +170,12 @@ void ts::BitRateRegulator::regulatePacket(bool& flush)
     NanoSecond duration = now - otherPeriod().start;
 
     // Allowed bits in the total measurement period.
-    int64_t max_bits = ((_cur_bitrate * duration) / NanoSecPerSec).toInt();
+    int64_t max_bits = bitsFromDuration(duration);
 
     // While not enough bit credit for one packet, wait until end of current burst.
     while (otherPeriod().bits + currentPeriod().bits + int64_t(PKT_SIZE_BITS) > max_bits) {
         // Wait until scheduled end of burst.
-        _burst_end.wait();
+        waitBurstEnd();
         // Restart a new burst, use monotonic time.
         _burst_end += _burst_duration;
         // Flush current burst
@@ -114,14 +183,14 @@ void ts::BitRateRegulator::regulatePacket(bool& flush)
         // Update measurement period and bit credit.
         now.getSystemTime();
         duration = now - otherPeriod().start;
-        max_bits = ((_cur_bitrate * duration) / NanoSecPerSec).toInt();
+        max_bits = bitsFromDuration(duration);
     }
 
     // Switch measurement period when necessary.
     if (now - currentPeriod().start >= _period_duration) {
         // The "other" period will disappear.
         // Credit unused bits from the other period to the current period.
-        currentPeriod().bits -= ((_cur_bitrate * (currentPeriod().start - otherPeriod().start)) / NanoSecPerSec).toInt() - otherPeriod().bits;
+        currentPeriod().bits -= bitsFromDuration(currentPeriod().start - otherPeriod().start) - otherPeriod().bits;
         // Current period becomes the other period.
         _cur_period ^= 1;
         // Reset the new current period.
@@ -52,6 +52,37 @@ namespace ts {
         //!
         void setFixedBitRate(BitRate bitrate) { _opt_bitrate = bitrate; }
 
+        //!
+        //! Set the duration of the final active wait at the end of each burst.
+        //! When non-zero, the regulator sleeps until that many nano-seconds before the
+        //! scheduled end of burst, then actively waits on the monotonic clock for the
+        //! remaining time. The precision of the regulation no longer depends on the
+        //! operating system timers, at the expense of some CPU load, and short bursts
+        //! are no longer enlarged beyond the requested packet count.
+        //! @param [in] duration Duration of the active wait in nano-seconds. Zero (the
+        //! default) disables the active wait, the whole wait is a system sleep.
+        //!
+        void setSpinDuration(NanoSecond duration) { _opt_spin = duration; }
+
+        //!
+        //! Get the number of burst waits since start().
+        //! @return The number of burst waits.
+        //!
+        uint64_t jitterCount() const { return _jitter_count; }
+
+        //!
+        //! Get the maximum observed wake-up jitter since start().
+        //! The jitter is the lateness of the actual wake-up after the scheduled end of a burst.
+        //! @return The maximum jitter in nano-seconds.
+        //!
+        NanoSecond jitterMax() const { return _jitter_max; }
+
+        //!
+        //! Get the average wake-up jitter since start().
+        //! @return The average jitter in nano-seconds.
+        //!
+        NanoSecond jitterAverage() const { return _jitter_count == 0 ? 0 : _jitter_cumul / NanoSecond(_jitter_count); }
+
         //!
         //! Start regulation, initialize all timers.
         //!
@@ -93,14 +124,29 @@ namespace ts {
         bool          _regulated = false;   // Currently regulated at known bitrate
         PacketCounter _opt_burst = 0;       // Number of packets to burst at a time
         BitRate       _opt_bitrate = 0;     // Bitrate option, zero means use input
+        NanoSecond    _opt_spin = 0;        // Duration of final active wait, zero means sleep only
         BitRate       _cur_bitrate = 0;     // Current bitrate
         NanoSecond    _burst_min = 0;       // Minimum delay between two bursts
         NanoSecond    _burst_duration = 0;  // Delay between two bursts
         Monotonic     _burst_end {};        // End of current burst
+        uint64_t      _jitter_count = 0;    // Number of burst waits
+        NanoSecond    _jitter_max = 0;      // Maximum wake-up lateness after scheduled end of burst
+        NanoSecond    _jitter_cumul = 0;    // Cumulated wake-up lateness
         Period        _periods[2] {};       // Last two measurement periods, accumulating packets
         NanoSecond    _period_duration = NanoSecPerSec; // Duration of a period of packet measurement, default: 1 second
         size_t        _cur_period = 0;      // Current period index, 0 or 1
 
+        // Integer fast path for the per-packet credit computations. BitRate is a
+        // fraction type: each multiplication or division renormalizes the fraction
+        // with GCD computations, too expensive on the per-packet path. The bitrate
+        // is converted to integer bits per second each time it changes and the
+        // Fraction arithmetic remains at the edges only.
+        int64_t       _bits_per_sec = 0;    // Current bitrate, rounded to integer bits per second.
+        bool          _fast_bits = false;   // _bits_per_sec is small enough for bitsFromDuration().
+
+        // Convert a duration in nano-seconds into a number of bits at the current bitrate.
+        int64_t bitsFromDuration(NanoSecond duration) const;
+
         // Current and other period.
         Period& currentPeriod() { return _periods[_cur_period & 1]; }
         Period& otherPeriod() { return _periods[(_cur_period & 1) ^ 1]; }
@@ -109,6 +155,10 @@ namespace ts {
         // required packets/burst (command line option) and current bitrate.
         void handleNewBitrate();
 
+        // Wait until the scheduled end of burst, using a hybrid sleep/spin wait
+        // when an active wait duration is set. Update jitter statistics.
+        void waitBurstEnd();
+
         // Process one packet in a regulated burst. Wait at end of burst.
         void regulatePacket(bool& flush);
     };
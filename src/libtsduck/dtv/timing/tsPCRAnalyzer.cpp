@@ -200,12 +200,84 @@ void ts::PCRAnalyzer::getStatus(Status& stat) const
 }
 
 
+//----------------------------------------------------------------------------
+// Merge the results of another analyzer into this one.
+//----------------------------------------------------------------------------
+
+void ts::PCRAnalyzer::merge(const PCRAnalyzer& other)
+{
+    // Total packet count before the merge, used to rebase the packet
+    // indexes of the other analyzer (they are relative to its own slice).
+    const uint64_t base_pkt_cnt = _ts_pkt_cnt;
+
+    // Merge per-PID statistics.
+    for (size_t i = 0; i < PID_MAX; ++i) {
+        const PIDAnalysis* ops = other._pid[i];
+        if (ops != nullptr) {
+            PIDAnalysis* ps = _pid[i];
+            if (ps == nullptr) {
+                ps = _pid[i] = new PIDAnalysis;
+            }
+            ps->ts_pkt_cnt += ops->ts_pkt_cnt;
+            ps->ts_bitrate_188 += ops->ts_bitrate_188;
+            ps->ts_bitrate_204 += ops->ts_bitrate_204;
+            ps->ts_bitrate_cnt += ops->ts_bitrate_cnt;
+            // The stream now continues from the end of the other slice.
+            ps->cur_continuity = ops->cur_continuity;
+            ps->last_pcr_value = ops->last_pcr_value;
+            if (ops->last_pcr_value != INVALID_PCR) {
+                ps->last_pcr_packet = base_pkt_cnt + ops->last_pcr_packet;
+            }
+        }
+    }
+
+    // Merge global statistics.
+    _ts_pkt_cnt += other._ts_pkt_cnt;
+    _ts_bitrate_188 += other._ts_bitrate_188;
+    _ts_bitrate_204 += other._ts_bitrate_204;
+    _ts_bitrate_cnt += other._ts_bitrate_cnt;
+    _discontinuities += other._discontinuities;
+
+    // The instantaneous bitrate is the one at the end of the other slice.
+    _inst_ts_bitrate_188 = other._inst_ts_bitrate_188;
+    _inst_ts_bitrate_204 = other._inst_ts_bitrate_204;
+    _packet_pcr_index_map.clear();
+    for (const auto& it : other._packet_pcr_index_map) {
+        _packet_pcr_index_map[it.first] = base_pkt_cnt + it.second;
+    }
+
+    // Re-evaluate the analysis completion criteria on the merged counters.
+    _pcr_pids = 0;
+    _completed_pids = 0;
+    for (size_t i = 0; i < PID_MAX; ++i) {
+        if (_pid[i] != nullptr && _pid[i]->ts_bitrate_cnt > 0) {
+            _pcr_pids++;
+            if (_pid[i]->ts_bitrate_cnt >= _min_pcr) {
+                _completed_pids++;
+            }
+        }
+    }
+    _bitrate_valid = _completed_pids >= _min_pid;
+}
+
+
 //----------------------------------------------------------------------------
 // Feed the PCR analyzer with a new transport packet.
 // Return true if we have collected enough packet to evaluate TS bitrate.
 //----------------------------------------------------------------------------
 
 bool ts::PCRAnalyzer::feedPacket(const TSPacket& pkt)
+{
+    return feedPacketInternal(pkt, _use_dts ? (pkt.hasDTS() ? pkt.getDTS() : INVALID_PCR) : pkt.getPCR());
+}
+
+bool ts::PCRAnalyzer::feedPacket(const TSPacket& pkt, const TSPacketMetadata& mdata)
+{
+    // The metadata cache holds PCR values only. In DTS mode, parse the packet.
+    return !_use_dts && mdata.pcrCached() ? feedPacketInternal(pkt, mdata.getPCR()) : feedPacket(pkt);
+}
+
+bool ts::PCRAnalyzer::feedPacketInternal(const TSPacket& pkt, uint64_t pcr_dts)
 {
     // Count one more packet in the TS
     _ts_pkt_cnt++;
@@ -267,10 +339,7 @@ bool ts::PCRAnalyzer::feedPacket(const TSPacket& pkt)
     }
 
     // Process PCR (or DTS)
-    if ((_use_dts && pkt.hasDTS()) || (!_use_dts && pkt.hasPCR())) {
-
-        // Get PCR value (or DTS)
-        const uint64_t pcr_dts = _use_dts ? pkt.getDTS() : pkt.getPCR();
+    if (pcr_dts != INVALID_PCR) {
 
         // If last PCR/DTS valid, compute transport rate between the two
         if (ps->last_pcr_value != INVALID_PCR && ps->last_pcr_value != pcr_dts) {
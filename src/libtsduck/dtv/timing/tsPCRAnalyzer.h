@@ -13,6 +13,7 @@
 
 #pragma once
 #include "tsTSPacket.h"
+#include "tsTSPacketMetadata.h"
 #include "tsStringifyInterface.h"
 
 namespace ts {
@@ -87,6 +88,30 @@ namespace ts {
         //!
         bool feedPacket(const TSPacket& pkt);
 
+        //!
+        //! The following method feeds the analyzer with a TS packet and its metadata.
+        //! When the metadata contain a cached PCR value, the adaptation field of the
+        //! packet is not parsed again.
+        //! @param [in] pkt A new transport stream packet.
+        //! @param [in] mdata Metadata of the packet.
+        //! @return True if we have collected enough packet to evaluate TS bitrate.
+        //! @see TSPacketMetadata::setPCR()
+        //!
+        bool feedPacket(const TSPacket& pkt, const TSPacketMetadata& mdata);
+
+        //!
+        //! Merge the results of another analyzer into this one.
+        //!
+        //! This is typically used for parallel analysis: successive slices of the
+        //! same transport stream are analyzed by distinct analyzers and the partial
+        //! results are merged in stream order. Both analyzers must have been
+        //! configured identically (PCR vs. DTS, error processing, analysis criteria).
+        //! The PCR interval which crosses the slice boundary is lost, all other
+        //! intervals are accounted for exactly as in a sequential analysis.
+        //! @param [in] other The analyzer to merge, for the next slice of the stream.
+        //!
+        void merge(const PCRAnalyzer& other);
+
         //!
         //! Check if we have collected enough packet to evaluate TS bitrate.
         //! @return True if we have collected enough packet to evaluate TS bitrate.
@@ -178,6 +203,10 @@ namespace ts {
         // Process a discontinuity in the transport stream
         void processDiscontinuity();
 
+        // Common implementation of feedPacket(). The PCR (or DTS) of the packet
+        // is already extracted, INVALID_PCR when the packet has none.
+        bool feedPacketInternal(const TSPacket& pkt, uint64_t pcr_dts);
+
         // Analysis of one PID
         struct PIDAnalysis
         {
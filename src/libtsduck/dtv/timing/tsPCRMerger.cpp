@@ -39,6 +39,36 @@ void ts::PCRMerger::reset()
     _demux.reset();
     _demux.addFilteredTableId(TID_PMT);
     _pid_ctx.clear();
+    _last_pid = PID_NULL;
+    _last_ctx = nullptr;
+}
+
+
+//----------------------------------------------------------------------------
+// Recompute the restamping slopes when the main bitrate changes.
+//----------------------------------------------------------------------------
+
+void ts::PCRMerger::recomputeSlopes(const BitRate& main_bitrate)
+{
+    _slope_bitrate = main_bitrate;
+    const int64_t bitrate = int64_t(main_bitrate.toInt());
+    if (bitrate <= 0) {
+        _pcr_num = 0;
+        _pcr_den = 1;
+        _pdts_num = 0;
+        _pdts_den = 1;
+    }
+    else {
+        // Reduce the fractions to limit the intermediate products.
+        const int64_t pcr_bits = int64_t(PKT_SIZE_BITS * SYSTEM_CLOCK_FREQ);
+        const int64_t pcr_gcd = GCD(pcr_bits, bitrate);
+        _pcr_num = pcr_bits / pcr_gcd;
+        _pcr_den = bitrate / pcr_gcd;
+        const int64_t pdts_bits = int64_t(PKT_SIZE_BITS * SYSTEM_CLOCK_SUBFREQ);
+        const int64_t pdts_gcd = GCD(pdts_bits, bitrate);
+        _pdts_num = pdts_bits / pdts_gcd;
+        _pdts_den = bitrate / pdts_gcd;
+    }
 }
 
 
@@ -51,9 +81,14 @@ void ts::PCRMerger::processPacket(ts::TSPacket& pkt, ts::PacketCounter main_pack
     // Collect PMT's from the merged TS.
     _demux.feedPacket(pkt);
 
+    // Update the precomputed restamping slopes on bitrate change only.
+    if (main_bitrate != _slope_bitrate) {
+        recomputeSlopes(main_bitrate);
+    }
+
     // Collect information on this packet.
     const PID pid = pkt.getPID();
-    const PIDContextPtr ctx(getContext(pid));
+    PIDContext* const ctx = getContext(pid);
     const uint64_t pcr = pkt.getPCR();
     const uint64_t dts = pkt.getDTS();
     const uint64_t pts = pkt.getPTS();
@@ -92,7 +127,7 @@ void ts::PCRMerger::processPacket(ts::TSPacket& pkt, ts::PacketCounter main_pack
             base_pkt = ctx->last_pcr_pkt;
         }
         assert(base_pkt < main_packet_index);
-        ctx->last_pcr = base_pcr + ((BitRate(main_packet_index - base_pkt) * PKT_SIZE_BITS * SYSTEM_CLOCK_FREQ) / main_bitrate).toInt();
+        ctx->last_pcr = base_pcr + uint64_t((int64_t(main_packet_index - base_pkt) * _pcr_num) / _pcr_den);
         ctx->last_pcr_pkt = main_packet_index;
 
         // When --pcr-reset-backwards is specified, check if DTS or PTS have moved backwards PCR.
@@ -105,7 +140,7 @@ void ts::PCRMerger::processPacket(ts::TSPacket& pkt, ts::PacketCounter main_pack
             for (auto it = _pid_ctx.begin(); update_pcr && it != _pid_ctx.end(); ++it) {
                 if (it->second->pcr_pid == pid) {
                     // Extrapolated current PTS/DTS of this PID at current packet.
-                    const uint64_t pdts = it->second->adjustedPDTS(main_packet_index, main_bitrate);
+                    const uint64_t pdts = it->second->adjustedPDTS(main_packet_index, _pdts_num, _pdts_den);
                     if (pdts != INVALID_DTS && (pdts <= subpcr || (pdts - subpcr) > SYSTEM_CLOCK_SUBFREQ)) {
                         // PTS/DTS moved backwards PCR or PCR is far behind PTS/DTS (more than one second).
                         // Reset PCR restamping.
@@ -166,36 +201,44 @@ void ts::PCRMerger::handlePMT(const PMT& pmt, PID pid)
 // Get the description of a PID inside the merged stream.
 //----------------------------------------------------------------------------
 
-ts::PCRMerger::PIDContextPtr ts::PCRMerger::getContext(PID pid)
+ts::PCRMerger::PIDContext* ts::PCRMerger::getContext(PID pid)
 {
+    // One-entry cache first, packets from the same PID come in runs.
+    if (pid == _last_pid && _last_ctx != nullptr) {
+        return _last_ctx;
+    }
     const auto ctx = _pid_ctx.find(pid);
+    PIDContext* ptr = nullptr;
     if (ctx != _pid_ctx.end()) {
-        return ctx->second;
+        ptr = ctx->second.pointer();
     }
     else {
-        PIDContextPtr ptr(new PIDContext(pid));
-        CheckNonNull(ptr.pointer());
-        _pid_ctx[pid] = ptr;
-        return ptr;
+        PIDContextPtr safe(new PIDContext(pid));
+        CheckNonNull(safe.pointer());
+        _pid_ctx[pid] = safe;
+        ptr = safe.pointer();
     }
+    _last_pid = pid;
+    _last_ctx = ptr;
+    return ptr;
 }
 
 
 //----------------------------------------------------------------------------
-// Get the adjusted DTS or PTS according to a bitrate and current packet.
+// Get the adjusted DTS or PTS according to the precomputed slope.
 //----------------------------------------------------------------------------
 
-uint64_t ts::PCRMerger::PIDContext::adjustedPDTS(PacketCounter current_pkt, const BitRate& bitrate) const
+uint64_t ts::PCRMerger::PIDContext::adjustedPDTS(PacketCounter current_pkt, int64_t pdts_num, int64_t pdts_den) const
 {
     // Compute adjusted DTS and PTS.
     uint64_t dts = last_dts;
     uint64_t pts = last_pts;
-    if (bitrate != 0) {
+    if (pdts_num != 0) {
         if (dts != INVALID_DTS) {
-            dts += (((current_pkt - last_dts_pkt) * PKT_SIZE_BITS * SYSTEM_CLOCK_SUBFREQ) / bitrate).toInt();
+            dts += uint64_t((int64_t(current_pkt - last_dts_pkt) * pdts_num) / pdts_den);
         }
         if (pts != INVALID_PTS) {
-            pts += (((current_pkt - last_pts_pkt) * PKT_SIZE_BITS * SYSTEM_CLOCK_SUBFREQ) / bitrate).toInt();
+            pts += uint64_t((int64_t(current_pkt - last_pts_pkt) * pdts_num) / pdts_den);
         }
     }
 
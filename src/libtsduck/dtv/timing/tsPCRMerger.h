@@ -116,8 +116,24 @@ namespace ts {
         PIDContextMap      _pid_ctx {};                   // Description of PID's from the merged stream.
         SignalizationDemux _demux;                        // Analyze the signalization in the merged stream.
 
+        // One-entry cache for the context of the current PID, packets come in runs.
+        PID                _last_pid = PID_NULL;          // PID of the cached context.
+        PIDContext*        _last_ctx = nullptr;           // Cached context, owned by _pid_ctx.
+
+        // Restamping slopes in reduced integer form, recomputed on main bitrate change only.
+        // The restamped PCR or extrapolated PTS/DTS is then one multiplication, one
+        // division and one addition per reference clock, without BitRate arithmetics.
+        BitRate            _slope_bitrate = 0;            // Main bitrate for which the slopes were computed.
+        int64_t            _pcr_num = 0;                  // PCR units per packet, reduced numerator.
+        int64_t            _pcr_den = 1;                  // PCR units per packet, reduced denominator.
+        int64_t            _pdts_num = 0;                 // PTS/DTS units per packet, reduced numerator.
+        int64_t            _pdts_den = 1;                 // PTS/DTS units per packet, reduced denominator.
+
         // Get the description of a PID inside the merged stream.
-        PIDContextPtr getContext(PID pid);
+        PIDContext* getContext(PID pid);
+
+        // Recompute the restamping slopes when the main bitrate changes.
+        void recomputeSlopes(const BitRate& main_bitrate);
 
         // Receives all PMT's of all services in the merged stream.
         virtual void handlePMT(const PMT& table, PID pid) override;
@@ -142,9 +158,9 @@ namespace ts {
             PIDContext(PID);
 
             // Get the DTS or PTS (whichever is defined and early).
-            // Adjust it according to a bitrate and current packet.
+            // Adjust it according to the precomputed slope and current packet.
             // Return INVALID_DTS if none defined.
-            uint64_t adjustedPDTS(PacketCounter, const BitRate&) const;
+            uint64_t adjustedPDTS(PacketCounter, int64_t pdts_num, int64_t pdts_den) const;
         };
     };
 }
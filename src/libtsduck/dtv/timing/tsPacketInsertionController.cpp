@@ -31,6 +31,7 @@ void ts::PacketInsertionController::reset()
     _accel_main_packets = 0;
     _accel_sub_packets = 0;
     _accel_max_wait = 0;
+    _error = 0;
 }
 
 
@@ -105,6 +106,7 @@ void ts::PacketInsertionController::setMainBitRate(const BitRate& rate)
     if (!_main_bitrate.setBitRate(rate)) {
         reset();
     }
+    recomputeSteps();
 }
 
 void ts::PacketInsertionController::setSubBitRate(const BitRate& rate)
@@ -113,6 +115,32 @@ void ts::PacketInsertionController::setSubBitRate(const BitRate& rate)
     if (!_sub_bitrate.setBitRate(rate)) {
         reset();
     }
+    recomputeSteps();
+}
+
+
+//----------------------------------------------------------------------------
+// Recompute the accumulator steps after a bitrate change.
+//----------------------------------------------------------------------------
+
+void ts::PacketInsertionController::recomputeSteps()
+{
+    const int64_t main_rate = int64_t(_main_bitrate.getBitRate().toInt());
+    const int64_t sub_rate = int64_t(_sub_bitrate.getBitRate().toInt());
+    if (main_rate <= 0 || sub_rate <= 0) {
+        // At least one bitrate is unknown, always insert.
+        _step_main = 0;
+        _step_sub = 0;
+        _error = 0;
+    }
+    else {
+        // Reduce the steps to keep the accumulator small.
+        const int64_t gcd = GCD(main_rate, sub_rate);
+        _step_main = sub_rate / gcd;
+        _step_sub = main_rate / gcd;
+        // Resynchronize the accumulator on the current packet counters.
+        _error = int64_t(_main_packets) * _step_main - int64_t(_sub_packets) * _step_sub;
+    }
 }
 
 
@@ -122,11 +150,11 @@ void ts::PacketInsertionController::setSubBitRate(const BitRate& rate)
 
 bool ts::PacketInsertionController::mustInsert(size_t waiting_packets)
 {
-    if (_main_bitrate.getBitRate() == 0 || _sub_bitrate.getBitRate() == 0) {
+    if (_step_main == 0) {
         // Unknow bitrate, always insert.
         return true;
     }
-    else if (_main_packets * _sub_bitrate.getBitRate() >= _sub_packets * _main_bitrate.getBitRate()) {
+    else if (_error >= 0) {
         // It is time to insert in all cases.
         return true;
     }
@@ -147,13 +175,17 @@ bool ts::PacketInsertionController::mustInsert(size_t waiting_packets)
         // If _accel_factor was 1, this is the start of the acceleration.
         // Otherwise, the number of waiting packets has increased and we need to accelerate more.
         // We keep the highest acceleration factor until the number of waiting packets decreases.
-        _accel_factor++;
-        _accel_main_packets = _main_packets;
-        _accel_sub_packets = _sub_packets;
+        // The factor is optionally bounded to smoothen the absorption of large backlogs.
+        if (_accel_limit == 0 || _accel_factor < _accel_limit) {
+            _accel_factor++;
+            _accel_main_packets = _main_packets;
+            _accel_sub_packets = _sub_packets;
+            _report.verbose(u"%'d waiting packets, accelerating %s bitrate by factor %d", {waiting_packets, _sub_name, _accel_factor});
+        }
         _accel_max_wait = waiting_packets;
-        _report.verbose(u"%'d waiting packets, accelerating %s bitrate by factor %d", {waiting_packets, _sub_name, _accel_factor});
     }
 
     // Use the same insertion criteria with the accelerated sub-bitrate over the current accelerated phase.
-    return (_main_packets - _accel_main_packets) * _accel_factor * _sub_bitrate.getBitRate() >= (_sub_packets - _accel_sub_packets) * _main_bitrate.getBitRate();
+    // This is the exceptional path, the precomputed steps avoid BitRate arithmetics here too.
+    return int64_t(_main_packets - _accel_main_packets) * int64_t(_accel_factor) * _step_main >= int64_t(_sub_packets - _accel_sub_packets) * _step_sub;
 }
@@ -74,7 +74,11 @@ namespace ts {
         //! This includes packets which are replaced with content from the sub-stream.
         //! @param [in] packets Number of passed packets in the main transport stream.
         //!
-        void declareMainPackets(size_t packets) { _main_packets += packets; }
+        void declareMainPackets(size_t packets)
+        {
+            _main_packets += packets;
+            _error += int64_t(packets) * _step_main;
+        }
 
         //!
         //! Count packets in the sub-stream.
@@ -82,7 +86,11 @@ namespace ts {
         //! are replaced with content from the sub-stream.
         //! @param [in] packets Number of packets which are replaced with content from the sub-stream.
         //!
-        void declareSubPackets(size_t packets) { _sub_packets += packets; }
+        void declareSubPackets(size_t packets)
+        {
+            _sub_packets += packets;
+            _error -= int64_t(packets) * _step_sub;
+        }
 
         //!
         //! Check if a packet from the sub-stream shall be inserted at the current position in the main transport stream.
@@ -113,6 +121,20 @@ namespace ts {
         //!
         void setWaitPacketsAlertThreshold(size_t packets) { _wait_alert = packets; }
 
+        //!
+        //! Set a limit to the insertion acceleration factor.
+        //!
+        //! During overflow absorption, the insertion rate is accelerated by increasing
+        //! factors as long as the number of waiting packets grows. Without limit, a large
+        //! backlog can be flushed as one big burst in the main stream. Setting a limit
+        //! smoothens the absorption over a longer period.
+        //!
+        //! @param [in] factor Maximum acceleration factor. When set to zero (the default),
+        //! the acceleration is unbounded.
+        //! @see setWaitPacketsAlertThreshold()
+        //!
+        void setAccelerationFactorLimit(size_t factor) { _accel_limit = factor; }
+
         //!
         //! Set a reset threshold for bitrate variation.
         //!
@@ -180,11 +202,22 @@ namespace ts {
         PacketCounter  _main_packets = 0;            // Total number of packets in main stream so far.
         PacketCounter  _sub_packets = 0;             // Total number of packets in sub-stream so far.
         size_t         _wait_alert = DEFAULT_WAIT_ALERT;  // Accelerate insertion above that number of waiting packets.
+        size_t         _accel_limit = 0;             // Maximum acceleration factor, zero means unbounded.
         size_t         _accel_factor = 1;            // Acceleration factor, greater than 1 when too many packets are waiting.
         PacketCounter  _accel_main_packets = 0;      // Number of packets in main stream when current acceleration started.
         PacketCounter  _accel_sub_packets = 0;       // Number of packets in sub-stream wehn current acceleration started.
         size_t         _accel_max_wait = 0;          // Maximum number of waiting packet in current acceleration phase.
         BitRateControl _main_bitrate {_report, _main_name};  // Current bitrate in main stream.
         BitRateControl _sub_bitrate {_report, _sub_name};    // Current bitrate in sub-stream.
+
+        // The nominal insertion decision uses an integer error accumulator, in the
+        // style of the Bresenham algorithm. The steps are precomputed on bitrate
+        // change only, so that each packet costs one addition and one comparison.
+        int64_t        _step_main = 0;               // Error increment per main stream packet (reduced sub-stream bitrate).
+        int64_t        _step_sub = 0;                // Error decrement per sub-stream packet (reduced main stream bitrate).
+        int64_t        _error = 0;                   // Insertion error accumulator, insert when null or positive.
+
+        // Recompute the accumulator steps after a bitrate change.
+        void recomputeSteps();
     };
 }
@@ -63,6 +63,28 @@ bool ts::TimeShiftBuffer::setBackupDirectory(const UString& directory)
     }
 }
 
+bool ts::TimeShiftBuffer::setAsynchronousIO(bool on)
+{
+    if (_is_open) {
+        return false;
+    }
+    else {
+        _async_io = on;
+        return true;
+    }
+}
+
+bool ts::TimeShiftBuffer::setNullPacketElision(bool on)
+{
+    if (_is_open) {
+        return false;
+    }
+    else {
+        _elide_null = on;
+        return true;
+    }
+}
+
 
 //----------------------------------------------------------------------------
 // Open the buffer.
@@ -105,10 +127,38 @@ bool ts::TimeShiftBuffer::open(Report& report)
         // The read and write buffers use half of memory quota each.
         // Since the size of the file is larger than the sum of the two,
         // the read and write caches never overlap when the buffer is full.
-        _wcache.resize(_mem_packets / 2);
-        _wmdata.resize(_mem_packets / 2);
-        _rcache.resize(_mem_packets / 2);
-        _rmdata.resize(_mem_packets / 2);
+        // With asynchronous I/O, the quota is split into four buffers: a
+        // double buffer on the read side and another one on the write side.
+        // The memory quota must hold the four of them, otherwise fall back
+        // to synchronous I/O.
+        _async_io = _async_io && _mem_packets >= 4;
+        const size_t chunk = _async_io ? _mem_packets / 4 : _mem_packets / 2;
+        _wcache.resize(chunk);
+        _wmdata.resize(chunk);
+        _rcache.resize(chunk);
+        _rmdata.resize(chunk);
+
+        // With null packet elision, allocate the elision map, initially empty.
+        if (_elide_null) {
+            _null_map.assign(_total_packets, 0);
+        }
+
+        // Start the background I/O thread when asynchronous I/O is requested.
+        if (_async_io) {
+            _wcache2.resize(chunk);
+            _wmdata2.resize(chunk);
+            _rcache2.resize(chunk);
+            _rmdata2.resize(chunk);
+            _report = &report;
+            _terminate = _io_error = false;
+            _flush_pending = _preload_pending = _preload_ready = false;
+            _flush_index = _preload_index = _preload_count = 0;
+            if (!start()) {
+                report.error(u"error starting time-shift I/O thread");
+                _file.close(report);
+                return false;
+            }
+        }
     }
 
     _cur_packets = 0;
@@ -130,11 +180,30 @@ bool ts::TimeShiftBuffer::close(Report& report)
     }
 
     _is_open = false;
+
+    // Terminate the background I/O thread first. A pending operation is
+    // completed before the thread exits but its result is ignored since
+    // the content of the buffer is discarded anyway.
+    if (_async_io && _file.isOpen()) {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _terminate = true;
+        }
+        _wake.notify_all();
+        waitForTermination();
+    }
+
     _cur_packets = 0;
     _wcache.clear();
     _wmdata.clear();
     _rcache.clear();
     _rmdata.clear();
+    _wcache2.clear();
+    _wmdata2.clear();
+    _rcache2.clear();
+    _rmdata2.clear();
+    _null_map.clear();
+    _report = nullptr;
     return !_file.isOpen() || _file.close(report);
 }
 
@@ -179,7 +248,8 @@ bool ts::TimeShiftBuffer::shift(TSPacket& packet, TSPacketMetadata& mdata, Repor
         // The buffer uses a backup file.
         if (!was_full) {
             // While the buffer is not full, simply write the packet in the file.
-            if (!_file.writePackets(&packet, &mdata, 1, report)) {
+            // Use writeFile() so that null packet elision applies there too.
+            if (!writeFile(_next_write, &packet, &mdata, 1, report)) {
                 return false;
             }
             _cur_packets++;
@@ -188,13 +258,21 @@ bool ts::TimeShiftBuffer::shift(TSPacket& packet, TSPacketMetadata& mdata, Repor
             // The buffer is full, now read and write in caches.
             // First, make sure the read cache is filled.
             if (_rcache_next >= _rcache_end) {
-                // Read cache is empty, load it.
-                const size_t count = std::min(_rcache.size(), _total_packets - _next_read);
-                _rcache_next = 0;
-                _rcache_end = readFile(_next_read, &_rcache[0], &_rmdata[0], count, report);
-                if (_rcache_end == 0) {
-                    report.error(u"error reading time-shift file");
-                    return false;
+                if (_async_io) {
+                    // Swap with the preloaded read cache, waiting for it if necessary.
+                    if (!loadReadCacheAsync(report)) {
+                        return false;
+                    }
+                }
+                else {
+                    // Read cache is empty, load it.
+                    const size_t count = std::min(_rcache.size(), _total_packets - _next_read);
+                    _rcache_next = 0;
+                    _rcache_end = readFile(_next_read, &_rcache[0], &_rmdata[0], count, report);
+                    if (_rcache_end == 0) {
+                        report.error(u"error reading time-shift file");
+                        return false;
+                    }
                 }
             }
             // Return oldest packet from memory cache.
@@ -203,18 +281,26 @@ bool ts::TimeShiftBuffer::shift(TSPacket& packet, TSPacketMetadata& mdata, Repor
             _next_read = (_next_read + 1) % _total_packets;
             // Flush the write cache if necessary.
             if (_wcache_next >= _wcache.size()) {
-                // Flush the entire write cache on disk.
-                // Split in two operations if exceeds the end of file.
                 // Write index in file of the start of the write cache:
                 const size_t file_index = _next_write >= _wcache.size() ? _next_write - _wcache.size() : _total_packets + _next_write - _wcache.size();
                 assert(file_index < _total_packets);
-                const size_t count = std::min(_wcache.size(), _total_packets - file_index);
-                if (!writeFile(file_index, &_wcache[0], &_wmdata[0], count, report)) {
-                    return false;
+                if (_async_io) {
+                    // Hand the full write cache to the background thread.
+                    if (!flushWriteCacheAsync(file_index, report)) {
+                        return false;
+                    }
                 }
-                // Write second part at begining of file if required.
-                if (count < _wcache.size() && !writeFile(0, &_wcache[count], &_wmdata[count], _wcache.size() - count, report)) {
-                    return false;
+                else {
+                    // Flush the entire write cache on disk.
+                    // Split in two operations if exceeds the end of file.
+                    const size_t count = std::min(_wcache.size(), _total_packets - file_index);
+                    if (!writeFile(file_index, &_wcache[0], &_wmdata[0], count, report)) {
+                        return false;
+                    }
+                    // Write second part at begining of file if required.
+                    if (count < _wcache.size() && !writeFile(0, &_wcache[count], &_wmdata[count], _wcache.size() - count, report)) {
+                        return false;
+                    }
                 }
                 // Write cache is now empty.
                 _wcache_next = 0;
@@ -240,6 +326,126 @@ bool ts::TimeShiftBuffer::shift(TSPacket& packet, TSPacketMetadata& mdata, Repor
 }
 
 
+//----------------------------------------------------------------------------
+// Asynchronous I/O: swap in the preloaded read cache.
+//----------------------------------------------------------------------------
+
+bool ts::TimeShiftBuffer::loadReadCacheAsync(Report& report)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    if (!_preload_ready && !_preload_pending) {
+        // First load after the buffer became full. No background operation
+        // was submitted yet, load the read cache synchronously.
+        const size_t count = std::min(_rcache.size(), _total_packets - _next_read);
+        lock.unlock();
+        _rcache_next = 0;
+        _rcache_end = readFile(_next_read, &_rcache[0], &_rmdata[0], count, report);
+        if (_rcache_end == 0) {
+            report.error(u"error reading time-shift file");
+            return false;
+        }
+        lock.lock();
+        _preload_index = (_next_read + _rcache_end) % _total_packets;
+    }
+    else {
+        // Wait for the completion of the background preload, then swap the caches.
+        _done.wait(lock, [this]() { return !_preload_pending; });
+        if (_io_error || !_preload_ready) {
+            report.error(u"error reading time-shift file");
+            return false;
+        }
+        _rcache.swap(_rcache2);
+        _rmdata.swap(_rmdata2);
+        _rcache_next = 0;
+        _rcache_end = _preload_count;
+        _preload_ready = false;
+        _preload_index = (_preload_index + _preload_count) % _total_packets;
+    }
+
+    // Request the preload of the next region of the file in the background.
+    _preload_pending = true;
+    lock.unlock();
+    _wake.notify_all();
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Asynchronous I/O: hand a full write cache to the background thread.
+//----------------------------------------------------------------------------
+
+bool ts::TimeShiftBuffer::flushWriteCacheAsync(size_t file_index, Report& report)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    // Wait for the completion of the previous flush, then swap the caches.
+    _done.wait(lock, [this]() { return !_flush_pending; });
+    if (_io_error) {
+        report.error(u"error writing time-shift file");
+        return false;
+    }
+    _wcache.swap(_wcache2);
+    _wmdata.swap(_wmdata2);
+    _flush_index = file_index;
+    _flush_pending = true;
+    lock.unlock();
+    _wake.notify_all();
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// The background I/O thread.
+//----------------------------------------------------------------------------
+
+void ts::TimeShiftBuffer::main()
+{
+    _report->debug(u"time-shift I/O thread started");
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    for (;;) {
+        // Wait for a flush request, a preload request or a termination request.
+        _wake.wait(lock, [this]() { return _flush_pending || _preload_pending || _terminate; });
+        if (_terminate) {
+            break;
+        }
+        // Serve flushes first: the write cache swap is the most likely to
+        // block the application thread in a steady state.
+        if (_flush_pending) {
+            // Flush the entire second write cache on disk.
+            // Split in two operations if it exceeds the end of file.
+            const size_t index = _flush_index;
+            const size_t count = std::min(_wcache2.size(), _total_packets - index);
+            lock.unlock();
+            bool ok = writeFile(index, &_wcache2[0], &_wmdata2[0], count, *_report);
+            if (ok && count < _wcache2.size()) {
+                ok = writeFile(0, &_wcache2[count], &_wmdata2[count], _wcache2.size() - count, *_report);
+            }
+            lock.lock();
+            _io_error = _io_error || !ok;
+            _flush_pending = false;
+            _done.notify_all();
+        }
+        else if (_preload_pending) {
+            // Preload the next region of the file in the second read cache.
+            const size_t index = _preload_index;
+            const size_t count = std::min(_rcache2.size(), _total_packets - index);
+            lock.unlock();
+            const size_t retcount = readFile(index, &_rcache2[0], &_rmdata2[0], count, *_report);
+            lock.lock();
+            _io_error = _io_error || retcount == 0;
+            _preload_count = retcount;
+            _preload_ready = retcount > 0;
+            _preload_pending = false;
+            _done.notify_all();
+        }
+    }
+
+    _report->debug(u"time-shift I/O thread completed");
+}
+
+
 //----------------------------------------------------------------------------
 // Seek in the backup file.
 //----------------------------------------------------------------------------
@@ -256,23 +462,56 @@ bool ts::TimeShiftBuffer::seekFile(size_t index, Report& report)
 }
 
 
+//----------------------------------------------------------------------------
+// Check if a packet can be elided from the backup file.
+//----------------------------------------------------------------------------
+
+bool ts::TimeShiftBuffer::elidable(const TSPacket& pkt, const TSPacketMetadata& mdata)
+{
+    // The payload of null packets is not preserved. Do not elide null packets
+    // carrying labels or an input time stamp, their metadata would be lost.
+    return pkt.getPID() == PID_NULL && !mdata.hasAnyLabel() && !mdata.hasInputTimeStamp();
+}
+
+
 //----------------------------------------------------------------------------
 // Seek and write in the backup file.
 //----------------------------------------------------------------------------
 
 bool ts::TimeShiftBuffer::writeFile(size_t index, const TSPacket* buffer, const TSPacketMetadata* mdata, size_t count, Report& report)
 {
-    if (!seekFile(index, report)) {
-        return false;
-    }
-    else if (_file.writePackets(buffer, mdata, count, report)) {
-        report.debug(u"written %d packets in time-shift file at packet index %d", {count, index});
-        return true;
-    }
-    else {
-        report.error(u"error writing %d packets in time-shift file at packet index %d", {count, index});
-        return false;
+    // Without elision, there is one single run covering the whole chunk.
+    // With elision, alternate between elided runs of null packets, simply
+    // marked in the map without disk access, and runs of actual packets.
+    size_t i = 0;
+    while (i < count) {
+        size_t j = i;
+        if (_elide_null && elidable(buffer[i], mdata[i])) {
+            // Run of null packets: leave a hole in the file.
+            while (j < count && elidable(buffer[j], mdata[j])) {
+                _null_map[index + j++] = 1;
+            }
+        }
+        else {
+            // Run of packets to actually write on disk.
+            while (j < count && !(_elide_null && elidable(buffer[j], mdata[j]))) {
+                if (_elide_null) {
+                    _null_map[index + j] = 0;
+                }
+                j++;
+            }
+            if (!seekFile(index + i, report)) {
+                return false;
+            }
+            if (!_file.writePackets(buffer + i, mdata + i, j - i, report)) {
+                report.error(u"error writing %d packets in time-shift file at packet index %d", {j - i, index + i});
+                return false;
+            }
+        }
+        i = j;
     }
+    report.debug(u"written %d packets in time-shift file at packet index %d", {count, index});
+    return true;
 }
 
 
@@ -282,15 +521,37 @@ bool ts::TimeShiftBuffer::writeFile(size_t index, const TSPacket* buffer, const
 
 size_t ts::TimeShiftBuffer::readFile(size_t index, TSPacket* buffer, TSPacketMetadata* mdata, size_t count, Report& report)
 {
-    if (!seekFile(index, report)) {
-        return false;
-    }
-    const size_t retcount = _file.readPackets(buffer, mdata, count, report);
-    if (retcount == 0) {
-        report.error(u"error reading %d packets in time-shift file at packet index %d", {count, index});
-    }
-    else {
-        report.debug(u"read %d packets in time-shift file at packet index %d", {retcount, index});
+    // Same run structure as writeFile(): elided runs of null packets are
+    // regenerated without disk access, other runs are read from the file.
+    size_t done = 0;
+    while (done < count) {
+        size_t j = done;
+        if (_elide_null && _null_map[index + done] != 0) {
+            // Run of elided null packets.
+            while (j < count && _null_map[index + j] != 0) {
+                buffer[j] = NullPacket;
+                mdata[j].reset();
+                j++;
+            }
+        }
+        else {
+            // Run of packets to actually read from disk.
+            while (j < count && !(_elide_null && _null_map[index + j] != 0)) {
+                j++;
+            }
+            if (!seekFile(index + done, report)) {
+                return 0;
+            }
+            const size_t retcount = _file.readPackets(buffer + done, mdata + done, j - done, report);
+            if (retcount < j - done) {
+                if (done + retcount == 0) {
+                    report.error(u"error reading %d packets in time-shift file at packet index %d", {j - done, index + done});
+                }
+                return done + retcount;
+            }
+        }
+        done = j;
     }
-    return retcount;
+    report.debug(u"read %d packets in time-shift file at packet index %d", {count, index});
+    return done;
 }
@@ -15,7 +15,10 @@
 #include "tsUString.h"
 #include "tsTSFile.h"
 #include "tsTSPacketMetadata.h"
+#include "tsThread.h"
 #include "tsReport.h"
+#include <mutex>
+#include <condition_variable>
 
 namespace ts {
 
@@ -26,7 +29,7 @@ namespace ts {
     //! The buffer is partly implemented in virtual memory and partly on disk.
     //! @ingroup mpeg
     //!
-    class TSDUCKDLL TimeShiftBuffer
+    class TSDUCKDLL TimeShiftBuffer : private Thread
     {
         TS_NOCOPY(TimeShiftBuffer);
     public:
@@ -86,6 +89,34 @@ namespace ts {
         //!
         bool setBackupDirectory(const UString& directory);
 
+        //!
+        //! Enable or disable asynchronous file I/O.
+        //! Must be called before open(). This is ignored when the buffer is memory resident.
+        //! When enabled, a background thread performs read-ahead of the playback cursor
+        //! and write-behind of the record cursor using double buffering. The memory quota
+        //! is split into four buffers instead of two. The shift() operation then never
+        //! blocks on disk I/O as long as the drive sustains the stream bitrate, which
+        //! avoids periodic stuttering on slow disks or with a cold page cache.
+        //! @param [in] on True to use asynchronous file I/O.
+        //! @return True on success, false if already open.
+        //!
+        bool setAsynchronousIO(bool on);
+
+        //!
+        //! Enable or disable null packet elision in the backup file.
+        //! Must be called before open(). This is ignored when the buffer is memory resident.
+        //! When enabled, runs of null packets are not written to the backup file. They are
+        //! marked in a small in-memory map, one byte per buffered packet, and regenerated
+        //! when the corresponding part of the file is read back. When the time-shifted
+        //! stream contains a large share of null packets, the disk bandwidth is reduced
+        //! accordingly and the skipped areas remain sparse holes in the backup file.
+        //! The payload of elided null packets is not preserved. A null packet with labels
+        //! or an input time stamp in its metadata is never elided.
+        //! @param [in] on True to elide null packets in the backup file.
+        //! @return True on success, false if already open.
+        //!
+        bool setNullPacketElision(bool on);
+
         //!
         //! Open the buffer.
         //! @param [in,out] report Where to report errors.
@@ -171,6 +202,47 @@ namespace ts {
         TSPacketMetadataVector _wmdata {};  // Packet metadata for _wcache.
         TSPacketMetadataVector _rmdata {};  // Packet metadata for _rcache.
 
+        // Null packet elision: one byte per packet in the buffer, non-zero when the
+        // corresponding area of the backup file is an elided run of null packets.
+        // A byte (not a bit) per packet so that the flush and preload operations,
+        // which work on disjoint ranges of packets, never share a memory word.
+        bool    _elide_null = false;        // Elide null packets in the backup file.
+        std::vector<uint8_t> _null_map {};  // Map of elided packets in the file.
+
+        // Asynchronous I/O: a background thread preloads the next read cache and
+        // flushes full write caches, using one additional buffer on each side.
+        // The file is accessed by one thread at a time only: by the application
+        // thread while the buffer is filling up, then exclusively by the I/O
+        // thread (except the initial load of the read cache, done while no
+        // background operation is pending).
+        bool    _async_io = false;          // Use the background I/O thread.
+        Report* _report = nullptr;          // Where the I/O thread reports errors, valid when open.
+        std::mutex _mutex {};               // Protect the fields below.
+        std::condition_variable _wake {};   // Signal a new request to the I/O thread.
+        std::condition_variable _done {};   // Signal a completed request to the application thread.
+        bool    _terminate = false;         // Ask the I/O thread to terminate.
+        bool    _io_error = false;          // An asynchronous operation failed.
+        bool    _flush_pending = false;     // _wcache2 shall be / is being written on disk.
+        size_t  _flush_index = 0;           // Index in file of the start of _wcache2.
+        bool    _preload_pending = false;   // _rcache2 shall be / is being loaded from disk.
+        bool    _preload_ready = false;     // _rcache2 is loaded and not yet consumed.
+        size_t  _preload_index = 0;         // Index in file of the start of the next preload.
+        size_t  _preload_count = 0;         // Number of packets loaded in _rcache2.
+        TSPacketVector         _wcache2 {}; // Second write cache, being flushed in the background.
+        TSPacketVector         _rcache2 {}; // Second read cache, preloaded in the background.
+        TSPacketMetadataVector _wmdata2 {}; // Packet metadata for _wcache2.
+        TSPacketMetadataVector _rmdata2 {}; // Packet metadata for _rcache2.
+
+        // Implementation of Thread, the background I/O thread.
+        virtual void main() override;
+
+        // Asynchronous counterparts of the read cache load and write cache flush.
+        bool loadReadCacheAsync(Report& report);
+        bool flushWriteCacheAsync(size_t file_index, Report& report);
+
+        // Check if a packet can be elided from the backup file.
+        static bool elidable(const TSPacket& pkt, const TSPacketMetadata& mdata);
+
         // Seek, read, write in the backup file.
         bool seekFile(size_t index, Report& report);
         bool writeFile(size_t index, const TSPacket* buffer, const TSPacketMetadata* mdata, size_t count, Report& report);
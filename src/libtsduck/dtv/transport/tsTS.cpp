@@ -7,6 +7,178 @@
 //----------------------------------------------------------------------------
 
 #include "tsTS.h"
+#include "tsMemory.h"
+
+// Vector instructions for sync byte scanning. SSE2 is part of the x86-64 base
+// ABI and NEON is part of the Arm-64 base ABI, no special compilation option
+// is needed for these architectures.
+#if defined(__SSE2__) || (defined(TS_MSC) && (defined(_M_X64) || defined(_M_AMD64)))
+    #include <emmintrin.h>
+    #define TS_SYNC_SCAN_SSE2 1
+#elif defined(__ARM_NEON)
+    #include <arm_neon.h>
+    #define TS_SYNC_SCAN_NEON 1
+#endif
+
+#if defined(TS_SYNC_SCAN_SSE2) || defined(TS_SYNC_SCAN_NEON)
+namespace {
+    // Index of the lowest set bit in a non-zero mask.
+    inline size_t LowestSetBit(uint64_t mask)
+    {
+#if defined(TS_MSC)
+        unsigned long bit = 0;
+        ::_BitScanForward64(&bit, mask);
+        return size_t(bit);
+#else
+        return size_t(__builtin_ctzll(mask));
+#endif
+    }
+}
+#endif
+
+
+//----------------------------------------------------------------------------
+// Locate the next TS sync byte in a data buffer.
+//----------------------------------------------------------------------------
+
+size_t ts::FindSyncByte(const uint8_t* data, size_t size)
+{
+    const uint8_t* cur = data;
+    const uint8_t* const end = data + size;
+
+#if defined(TS_SYNC_SCAN_SSE2)
+    // Test 16 candidate offsets per step.
+    const __m128i sync = _mm_set1_epi8(char(SYNC_BYTE));
+    while (cur + 16 <= end) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cur));
+        const uint32_t mask = uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, sync)));
+        if (mask != 0) {
+            // Lowest set bit is the first sync byte in the chunk.
+            return size_t(cur - data) + LowestSetBit(mask);
+        }
+        cur += 16;
+    }
+#elif defined(TS_SYNC_SCAN_NEON)
+    // Test 16 candidate offsets per step.
+    const uint8x16_t sync = vdupq_n_u8(SYNC_BYTE);
+    while (cur + 16 <= end) {
+        const uint8x16_t eq = vceqq_u8(vld1q_u8(cur), sync);
+        // Narrow the 128-bit comparison result to a 64-bit mask, 4 bits per byte.
+        const uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0);
+        if (mask != 0) {
+            return size_t(cur - data) + LowestSetBit(mask) / 4;
+        }
+        cur += 16;
+    }
+#endif
+
+    // Scalar loop on remaining bytes (and complete buffer without vector instructions).
+    while (cur < end) {
+        if (*cur == SYNC_BYTE) {
+            return size_t(cur - data);
+        }
+        ++cur;
+    }
+    return NPOS;
+}
+
+
+//----------------------------------------------------------------------------
+// Check the periodicity of TS sync bytes in a data buffer.
+//----------------------------------------------------------------------------
+
+bool ts::CheckSyncPeriodicity(const uint8_t* data, size_t size, size_t packet_size, size_t header_size)
+{
+    assert(packet_size > header_size);
+
+    if (size < packet_size) {
+        // Not even one complete packet.
+        return true;
+    }
+
+    const uint8_t* cur = data + header_size;
+    const uint8_t* const end = data + size - packet_size + header_size + 1;
+
+    // Validate 4 packets per step, one test and branch per step.
+    while (cur + 3 * packet_size < end) {
+        const uint8_t acc = uint8_t(cur[0] ^ SYNC_BYTE) |
+                            uint8_t(cur[packet_size] ^ SYNC_BYTE) |
+                            uint8_t(cur[2 * packet_size] ^ SYNC_BYTE) |
+                            uint8_t(cur[3 * packet_size] ^ SYNC_BYTE);
+        if (acc != 0) {
+            return false;
+        }
+        cur += 4 * packet_size;
+    }
+
+    // Remaining packets.
+    while (cur < end) {
+        if (*cur != SYNC_BYTE) {
+            return false;
+        }
+        cur += packet_size;
+    }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Classify a batch of TS packets from their headers.
+//----------------------------------------------------------------------------
+
+namespace {
+    // Decompose the 32-bit header of one TS packet into PID and flags.
+    inline void ClassifyOneHeader(const uint8_t* pkt, ts::PID& pid, uint8_t& flags)
+    {
+        const uint32_t header = ts::GetUInt32(pkt);
+        pid = ts::PID((header >> 8) & 0x1FFF);
+        flags = uint8_t(((header >> 16) & 0xE0) | ((header >> 4) & 0x0F));
+    }
+}
+
+void ts::ClassifyPacketHeaders(const uint8_t* data, size_t stride, size_t packet_count, PID* pids, uint8_t* flags)
+{
+    // Use a local flags buffer when the caller does not need the flags,
+    // keeping one single unconditional loop body.
+    uint8_t unused[4];
+    size_t i = 0;
+
+    // Classify 4 packets per step.
+    while (i + 4 <= packet_count) {
+        uint8_t* const f = flags != nullptr ? flags + i : unused;
+        ClassifyOneHeader(data, pids[i], f[0]);
+        ClassifyOneHeader(data + stride, pids[i + 1], f[1]);
+        ClassifyOneHeader(data + 2 * stride, pids[i + 2], f[2]);
+        ClassifyOneHeader(data + 3 * stride, pids[i + 3], f[3]);
+        data += 4 * stride;
+        i += 4;
+    }
+
+    // Remaining packets.
+    while (i < packet_count) {
+        ClassifyOneHeader(data, pids[i], flags != nullptr ? flags[i] : unused[0]);
+        data += stride;
+        i++;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Match an array of PID values against a PIDSet and build a bitmask.
+//----------------------------------------------------------------------------
+
+void ts::MatchPIDs(const PIDSet& pid_set, const PID* pids, size_t packet_count, uint64_t* mask)
+{
+    for (size_t i = 0; i < packet_count; i += 64) {
+        const size_t chunk = std::min<size_t>(packet_count - i, 64);
+        uint64_t word = 0;
+        for (size_t bit = 0; bit < chunk; ++bit) {
+            // PID values are 13-bit by construction, no need for a range check.
+            word |= uint64_t(pid_set[pids[i + bit] & (PID_MAX - 1)]) << bit;
+        }
+        mask[i / 64] = word;
+    }
+}
 
 
 //----------------------------------------------------------------------------
@@ -96,6 +96,31 @@ namespace ts {
     //!
     constexpr uint8_t SYNC_BYTE = 0x47;
 
+    //!
+    //! Locate the next TS sync byte in a data buffer.
+    //! The scan is vectorized (SSE2 or NEON) when the target architecture permits,
+    //! testing up to 16 candidate offsets at a time. This is typically used to
+    //! resynchronize on corrupted streams where scalar byte loops dominate runtime.
+    //! @param [in] data Address of the data buffer.
+    //! @param [in] size Size in bytes of the data buffer.
+    //! @return The offset of the first @link SYNC_BYTE @endlink in the buffer or NPOS if there is none.
+    //!
+    TSDUCKDLL size_t FindSyncByte(const uint8_t* data, size_t size);
+
+    //!
+    //! Check the periodicity of TS sync bytes in a data buffer.
+    //! Validate that a buffer is filled with packets of a given size, each packet
+    //! starting with an optional header, followed by a @link SYNC_BYTE @endlink.
+    //! Several packets are validated per step, without one test and branch per packet.
+    //! @param [in] data Address of the data buffer. The first packet is assumed to start there.
+    //! @param [in] size Size in bytes of the data buffer.
+    //! @param [in] packet_size Size in bytes of each packet, including optional header. Must be at least @a header_size + 1.
+    //! @param [in] header_size Size in bytes of the header which precedes the sync byte in each packet.
+    //! @return True when all complete packets in the buffer have a sync byte at the expected offset,
+    //! false otherwise. A buffer which is too short to contain one packet returns true.
+    //!
+    TSDUCKDLL bool CheckSyncPeriodicity(const uint8_t* data, size_t size, size_t packet_size, size_t header_size = 0);
+
     //!
     //! Size (in bits) of a PID field.
     //!
@@ -153,6 +178,58 @@ namespace ts {
         SC_ODD_KEY      = 3   //!< Scrambled with odd key (DVB-defined).
     };
 
+    //!
+    //! Header flags of a TS packet, as extracted by ClassifyPacketHeaders().
+    //! The flags of one packet are packed in one byte: the three indicators
+    //! from the second header byte and the top nibble of the fourth header
+    //! byte (scrambling control and adaptation field control).
+    //!
+    enum : uint8_t {
+        TS_HFLAG_TEI        = 0x80,  //!< Transport error indicator.
+        TS_HFLAG_PUSI       = 0x40,  //!< Payload unit start indicator.
+        TS_HFLAG_PRIORITY   = 0x20,  //!< Transport priority.
+        TS_HFLAG_SCRAMBLING = 0x0C,  //!< Scrambling control (use TS_HFLAG_SC_SHIFT to get a SC_* value).
+        TS_HFLAG_AF         = 0x02,  //!< Adaptation field present.
+        TS_HFLAG_PAYLOAD    = 0x01,  //!< Payload present.
+    };
+
+    //!
+    //! Shift to extract a SC_* scrambling control value from TS packet header flags.
+    //! @see TS_HFLAG_SCRAMBLING
+    //!
+    constexpr size_t TS_HFLAG_SC_SHIFT = 2;
+
+    //!
+    //! Classify a batch of TS packets from their headers.
+    //! Extract the PID and header flags of all packets in one pass, into
+    //! parallel arrays. Each packet header is read as one single 32-bit word
+    //! and decomposed branchlessly, several packets per step, instead of one
+    //! byte-level accessor call per field per packet. The headers of
+    //! consecutive packets are @a stride bytes apart, which current vector
+    //! instruction sets cannot gather in one load; the batched scalar kernel
+    //! is the efficient form on all architectures.
+    //! @param [in] data Address of the first TS packet (its sync byte).
+    //! @param [in] stride Distance in bytes between the starts of two consecutive
+    //! packets, typically @link PKT_SIZE @endlink in a contiguous packet buffer.
+    //! @param [in] packet_count Number of packets to classify.
+    //! @param [out] pids Returned array of @a packet_count PID values.
+    //! @param [out] flags Optional returned array of @a packet_count TS_HFLAG_* bytes.
+    //! Can be a null pointer if the flags are not needed.
+    //!
+    TSDUCKDLL void ClassifyPacketHeaders(const uint8_t* data, size_t stride, size_t packet_count, PID* pids, uint8_t* flags = nullptr);
+
+    //!
+    //! Match an array of PID values against a PIDSet and build a bitmask.
+    //! This is typically used on the PID array which is produced by
+    //! ClassifyPacketHeaders() to filter a batch of packets in one pass.
+    //! @param [in] pid_set The set of PID's to match.
+    //! @param [in] pids Array of @a packet_count PID values.
+    //! @param [in] packet_count Number of PID values to match.
+    //! @param [out] mask Returned array of (@a packet_count + 63) / 64 64-bit words.
+    //! Bit number (i %% 64) of word (i / 64) is set when @a pids[i] is in @a pid_set.
+    //!
+    TSDUCKDLL void MatchPIDs(const PIDSet& pid_set, const PID* pids, size_t packet_count, uint64_t* mask);
+
     //---------------------------------------------------------------------
     // Bitrates computations.
     //---------------------------------------------------------------------
@@ -102,6 +102,18 @@ void ts::TSDatagramOutput::defineArgs(Args& args)
                   u"declared, this option may transport multicast IP packets in unicast Ethernet frames "
                   u"to the gateway, preventing multicast reception on the local network (seen on Linux).");
 
+        args.option(u"kernel-pacing", 0, Args::INTEGER, 0, 1, 1, 1000000, true);
+        args.help(u"kernel-pacing", u"micro-seconds",
+                  u"Pace the outgoing datagrams in the kernel using per-packet transmit "
+                  u"timestamps (socket option SO_TXTIME). The transmit time of each datagram "
+                  u"is computed from the transport stream bitrate, typically derived from PCR "
+                  u"analysis, and the kernel packet scheduler releases the datagram at that "
+                  u"time. The pacing precision then no longer depends on user-space wakeup "
+                  u"latency. The optional value is the scheduling lead time in micro-seconds "
+                  u"(default: 1000). This option is available on Linux only and requires an "
+                  u"ETF qdisc configured with \"clockid CLOCK_MONOTONIC\" on the outgoing "
+                  u"network interface.");
+
         args.option(u"local-address", 'l', Args::IPADDR);
         args.help(u"local-address",
                   u"When the destination is a multicast address, specify the IP address "
@@ -162,6 +174,8 @@ bool ts::TSDatagramOutput::loadArgs(DuckContext& duck, Args& args)
         _mc_loopback = !args.present(u"disable-multicast-loop");
         _force_mc_local = args.present(u"force-local-multicast-outgoing");
         _rs204_format = args.present(u"rs204");
+        _kernel_pacing = args.present(u"kernel-pacing");
+        _pacing_lead = args.intValue<NanoSecond>(u"kernel-pacing", 1000) * NanoSecPerMicroSec;
     }
 
     return true;
@@ -218,7 +232,8 @@ bool ts::TSDatagramOutput::open(Report& report)
             (_force_mc_local && _destination.isMulticast() && _local_addr.hasAddress() && !_sock.setOutgoingMulticast(_local_addr, report)) ||
             (_send_bufsize > 0 && !_sock.setSendBufferSize(_send_bufsize, report)) ||
             (_tos >= 0 && !_sock.setTOS(_tos, report)) ||
-            (_ttl > 0 && !_sock.setTTL(_ttl, report)))
+            (_ttl > 0 && !_sock.setTTL(_ttl, report)) ||
+            (_kernel_pacing && !_sock.setTransmitTime(true, report)))
         {
             _sock.close(report);
             return false;
@@ -232,6 +247,13 @@ bool ts::TSDatagramOutput::open(Report& report)
     _last_rtp_pcr_pkt = 0;
     _rtp_pcr_offset = 0;
     _pkt_count = 0;
+    _txtime_next = 0;
+
+    // Prepare the batched transmission queue.
+    _pending_dgrams.clear();
+    _pending_dgrams.reserve(MAX_SEND_BATCH);
+    _pending_blocks.clear();
+    _pending_blocks.reserve(MAX_SEND_BATCH);
 
     _is_open = true;
     return true;
@@ -251,6 +273,7 @@ bool ts::TSDatagramOutput::close(const BitRate& bitrate, Report& report)
             success = sendPackets(_out_buffer.data(), _out_count, bitrate, report);
             _out_count = 0;
         }
+        success = flushDatagrams(report) && success;
         if (_raw_udp) {
             _sock.close(report);
         }
@@ -315,7 +338,9 @@ bool ts::TSDatagramOutput::send(const TSPacket* pkt, size_t packet_count, const
         TSPacket::Copy(_out_buffer.data(), pkt, packet_count);
         _out_count = packet_count;
     }
-    return true;
+
+    // Flush all datagrams which were queued during this call (raw UDP only).
+    return flushDatagrams(report);
 }
 
 
@@ -327,6 +352,19 @@ bool ts::TSDatagramOutput::sendPackets(const TSPacket* pkt, size_t packet_count,
 {
     bool status = true;
 
+    // With kernel pacing, compute the transmit time of this datagram. The schedule
+    // advances by the duration of each datagram at the current bitrate and is
+    // re-anchored on the transmit clock when it falls behind (startup, underflow).
+    NanoSecond txtime = 0;
+    if (_kernel_pacing && _raw_udp && bitrate > 0) {
+        const NanoSecond now = UDPSocket::TransmitClock();
+        if (_txtime_next < now + _pacing_lead) {
+            _txtime_next = now + _pacing_lead;
+        }
+        txtime = _txtime_next;
+        _txtime_next += ((NanoSecPerSec * PKT_SIZE_BITS * packet_count) / bitrate).toInt();
+    }
+
     if (_use_rtp) {
         // RTP datagram are relatively trivial to build, except the time stamp.
         // We cannot use the wall clock time because the plugin is likely to burst its output.
@@ -425,7 +463,7 @@ bool ts::TSDatagramOutput::sendPackets(const TSPacket* pkt, size_t packet_count,
             std::memcpy(buf, pkt, packet_count * PKT_SIZE);
             buffer.resize(RTP_HEADER_SIZE + packet_count * PKT_SIZE);
         }
-        status = _output->sendDatagram(buffer.data(), buffer.size(), report);
+        status = sendOrQueueDatagram(std::move(buffer), txtime, report);
     }
     else if (_rs204_format) {
         // No RTP header, add TS trailer after each packet. Since the default initial value
@@ -436,11 +474,11 @@ bool ts::TSDatagramOutput::sendPackets(const TSPacket* pkt, size_t packet_count,
             std::memcpy(buf, pkt++, PKT_SIZE);
             buf += PKT_SIZE + RS_SIZE;
         }
-        status = _output->sendDatagram(buffer.data(), buffer.size(), report);
+        status = sendOrQueueDatagram(std::move(buffer), txtime, report);
     }
     else {
         // No RTP, send TS packets directly as datagram.
-        status = _output->sendDatagram(pkt, packet_count * PKT_SIZE, report);
+        status = sendOrQueueDatagram(pkt, packet_count * PKT_SIZE, txtime, report);
     }
 
     // Count packets datagram per datagram.
@@ -450,6 +488,49 @@ bool ts::TSDatagramOutput::sendPackets(const TSPacket* pkt, size_t packet_count,
 }
 
 
+//----------------------------------------------------------------------------
+// Send one ready datagram, queueing it for batched transmission (raw UDP).
+//----------------------------------------------------------------------------
+
+bool ts::TSDatagramOutput::sendOrQueueDatagram(ByteBlock&& data, NanoSecond txtime, Report& report)
+{
+    if (!_raw_udp) {
+        // External datagram handler, send immediately.
+        return _output->sendDatagram(data.data(), data.size(), report);
+    }
+    // Keep the locally built buffer alive until the flush. A reallocation of the vector
+    // moves the ByteBlock objects but not their heap storage, queued addresses remain valid.
+    _pending_blocks.push_back(std::move(data));
+    return sendOrQueueDatagram(_pending_blocks.back().data(), _pending_blocks.back().size(), txtime, report);
+}
+
+bool ts::TSDatagramOutput::sendOrQueueDatagram(const void* address, size_t size, NanoSecond txtime, Report& report)
+{
+    if (!_raw_udp) {
+        // External datagram handler, send immediately.
+        return _output->sendDatagram(address, size, report);
+    }
+    _pending_dgrams.push_back({address, size, txtime});
+    return _pending_dgrams.size() < MAX_SEND_BATCH || flushDatagrams(report);
+}
+
+
+//----------------------------------------------------------------------------
+// Flush queued datagrams, if any.
+//----------------------------------------------------------------------------
+
+bool ts::TSDatagramOutput::flushDatagrams(Report& report)
+{
+    bool status = true;
+    if (!_pending_dgrams.empty()) {
+        status = _sock.sendBatch(_pending_dgrams.data(), _pending_dgrams.size(), report);
+        _pending_dgrams.clear();
+        _pending_blocks.clear();
+    }
+    return status;
+}
+
+
 //----------------------------------------------------------------------------
 // Implementation of TSDatagramOutputHandlerInterface.
 // The object is its own handler in case of raw UDP output.
@@ -134,6 +134,8 @@ namespace ts {
         bool              _mc_loopback = true;         // Multicast loopback option
         bool              _force_mc_local = false;     // Force multicast outgoing local interface
         size_t            _send_bufsize = 0;           // Socket send buffer size.
+        bool              _kernel_pacing = false;      // Pace datagrams in the kernel using transmit timestamps (SO_TXTIME).
+        NanoSecond        _pacing_lead = 0;            // Scheduling lead time for kernel pacing.
 
         // Working data.
         bool              _is_open = false;            // Currently in progress
@@ -145,15 +147,33 @@ namespace ts {
         PacketCounter     _last_rtp_pcr_pkt = 0;       // Packet index of last datagram
         uint64_t          _rtp_pcr_offset = 0;         // Value to substract from PCR to get RTP timestamp
         PacketCounter     _pkt_count = 0;              // Total packet counter for output packets
+        NanoSecond        _txtime_next = 0;            // Scheduled transmit time of next datagram with kernel pacing.
         size_t            _out_count = 0;              // Number of packets in _out_buffer
         TSPacketVector    _out_buffer {};              // Buffered packets for output with --enforce-burst
         UDPSocket         _sock {};                    // Outgoing socket for raw UDP
 
+        // Batched transmission, raw UDP only. Datagrams which become ready within one call to
+        // send() are queued and flushed together using UDPSocket::sendBatch(). The queue never
+        // outlives the call to send(), so batching does not delay the actual transmission.
+        static constexpr size_t MAX_SEND_BATCH = 64;   // Maximum number of queued datagrams before a flush.
+        std::vector<UDPSocket::SentMessage> _pending_dgrams {};  // Ready-to-send datagrams.
+        std::vector<ByteBlock> _pending_blocks {};     // Storage for queued datagrams which were built locally (RTP, RS204).
+
         // Implementation of TSDatagramOutputHandlerInterface.
         // The object is its own handler in case of raw UDP output.
         virtual bool sendDatagram(const void* address, size_t size, Report& report) override;
 
         // Send contiguous packets in one single datagram.
         bool sendPackets(const TSPacket* packet, size_t count, const BitRate& bitrate, Report& report);
+
+        // Send one ready datagram, queueing it for batched transmission in raw UDP mode.
+        // The first form hands over a locally built buffer which must remain valid until the flush.
+        // The second form directly references packet memory which is valid for the whole send() call.
+        // The transmit time is used with kernel pacing only, zero means send immediately.
+        bool sendOrQueueDatagram(ByteBlock&& data, NanoSecond txtime, Report& report);
+        bool sendOrQueueDatagram(const void* address, size_t size, NanoSecond txtime, Report& report);
+
+        // Flush queued datagrams, if any.
+        bool flushDatagrams(Report& report);
     };
 }
@@ -20,10 +20,403 @@
     #include <sys/types.h>
     #include <sys/stat.h>
     #include <unistd.h>
+    #if defined(TS_LINUX)
+        #include <sys/syscall.h>
+        #if defined(__NR_io_uring_setup)
+            #include <linux/io_uring.h>
+            #define TS_TSFILE_URING 1
+        #endif
+    #endif
     #include "tsAfterStandardHeaders.h"
 #endif
 
 
+#if defined(TS_LINUX)
+//----------------------------------------------------------------------------
+// io_uring context for asynchronous file I/O.
+// The context keeps up to "depth" sequential block requests in flight on a
+// regular file: read-ahead in read-only mode, write-behind in write-only mode.
+// Everything is implemented with raw system calls, without liburing.
+//----------------------------------------------------------------------------
+
+class ts::TSFile::UringIO
+{
+    TS_NOCOPY(UringIO);
+public:
+    UringIO() = default;
+    ~UringIO();
+
+    // Create the io_uring context on a file. Return false when unsupported, the
+    // caller shall then fall back to synchronous I/O.
+    bool init(int fd, size_t depth, bool write_mode, uint64_t offset, Report& report);
+
+    // Read at the current sequential position. Same semantics as readStreamPartial().
+    bool read(void* buffer, size_t max_size, size_t& ret_size, bool& at_eof, Report& report);
+
+    // Append data at the current sequential position. The data is copied and written behind.
+    bool write(const void* buffer, size_t size, Report& report);
+
+    // Wait for completion of all in-flight writes and write the last partial block.
+    bool flush(Report& report);
+
+    // Drain all in-flight requests and restart the sequential pattern at a new offset (read mode).
+    bool reposition(uint64_t offset, Report& report);
+
+private:
+    // Size of one I/O request. With the default queue depth, up to 2 MB are in flight.
+    static constexpr size_t IO_BLOCK_SIZE = 256 * 1024;
+
+    // State of one block buffer.
+    enum class BlockState {IDLE, PENDING, READY};
+
+    struct Block
+    {
+        BlockState state = BlockState::IDLE;
+        int        result = 0;     // System call result (size or negated errno).
+        size_t     fill = 0;       // Read mode: consumed bytes. Write mode: filled bytes.
+        ByteBlock  buffer {};
+    };
+
+    int       _file_fd = -1;
+    int       _ring_fd = -1;
+    bool      _write_mode = false;
+    size_t    _depth = 0;
+    uint64_t  _next_offset = 0;    // File offset of the next request to submit.
+    size_t    _next_block = 0;     // Round-robin index of next block to consume (read) or fill (write).
+    size_t    _in_flight = 0;      // Number of requests currently submitted.
+    std::vector<Block> _blocks {};
+
+    // Mapped submission and completion rings.
+    uint8_t*  _sq_ring = nullptr;
+    size_t    _sq_ring_size = 0;
+    uint8_t*  _cq_ring = nullptr;
+    size_t    _cq_ring_size = 0;
+    ::io_uring_sqe* _sqes = nullptr;
+    size_t    _sqes_size = 0;
+
+    // Pointers inside the mapped rings.
+    unsigned* _sq_head = nullptr;
+    unsigned* _sq_tail = nullptr;
+    unsigned* _sq_mask = nullptr;
+    unsigned* _sq_array = nullptr;
+    unsigned* _cq_head = nullptr;
+    unsigned* _cq_tail = nullptr;
+    unsigned* _cq_mask = nullptr;
+    ::io_uring_cqe* _cqes = nullptr;
+
+    // Submit one block request at the current sequential offset.
+    void submit(size_t index, size_t size);
+
+    // Process all available completions. When wait is true, block until at least one.
+    bool reap(bool wait, Report& report);
+
+    // Release all resources.
+    void shutdown();
+};
+
+
+//----------------------------------------------------------------------------
+// io_uring context: creation and destruction.
+//----------------------------------------------------------------------------
+
+ts::TSFile::UringIO::~UringIO()
+{
+    shutdown();
+}
+
+bool ts::TSFile::UringIO::init(int fd, size_t depth, bool write_mode, uint64_t offset, Report& report)
+{
+#if !defined(TS_TSFILE_URING)
+    return false;
+#else
+    _file_fd = fd;
+    _write_mode = write_mode;
+    _depth = std::max<size_t>(1, depth);
+    _next_offset = offset;
+
+    // Create the ring. An old kernel without io_uring simply fails here.
+    ::io_uring_params params;
+    TS_ZERO(params);
+    _ring_fd = int(::syscall(__NR_io_uring_setup, unsigned(_depth), &params));
+    if (_ring_fd < 0) {
+        report.debug(u"io_uring_setup failed: %s", {SysErrorCodeMessage()});
+        return false;
+    }
+
+    // IORING_OP_READ/WRITE with a file offset require IORING_FEAT_RW_CUR_POS era kernels (5.6+).
+    // The single mmap feature is not assumed, the two rings are mapped separately.
+    _sq_ring_size = size_t(params.sq_off.array) + params.sq_entries * sizeof(unsigned);
+    _cq_ring_size = size_t(params.cq_off.cqes) + params.cq_entries * sizeof(::io_uring_cqe);
+    _sqes_size = params.sq_entries * sizeof(::io_uring_sqe);
+
+    _sq_ring = reinterpret_cast<uint8_t*>(::mmap(nullptr, _sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ring_fd, IORING_OFF_SQ_RING));
+    _cq_ring = reinterpret_cast<uint8_t*>(::mmap(nullptr, _cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ring_fd, IORING_OFF_CQ_RING));
+    _sqes = reinterpret_cast<::io_uring_sqe*>(::mmap(nullptr, _sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ring_fd, IORING_OFF_SQES));
+    if (_sq_ring == MAP_FAILED || _cq_ring == MAP_FAILED || _sqes == MAP_FAILED) {
+        report.debug(u"io_uring ring mapping failed: %s", {SysErrorCodeMessage()});
+        shutdown();
+        return false;
+    }
+
+    _sq_head = reinterpret_cast<unsigned*>(_sq_ring + params.sq_off.head);
+    _sq_tail = reinterpret_cast<unsigned*>(_sq_ring + params.sq_off.tail);
+    _sq_mask = reinterpret_cast<unsigned*>(_sq_ring + params.sq_off.ring_mask);
+    _sq_array = reinterpret_cast<unsigned*>(_sq_ring + params.sq_off.array);
+    _cq_head = reinterpret_cast<unsigned*>(_cq_ring + params.cq_off.head);
+    _cq_tail = reinterpret_cast<unsigned*>(_cq_ring + params.cq_off.tail);
+    _cq_mask = reinterpret_cast<unsigned*>(_cq_ring + params.cq_off.ring_mask);
+    _cqes = reinterpret_cast<::io_uring_cqe*>(_cq_ring + params.cq_off.cqes);
+
+    // Allocate the block buffers.
+    _blocks.resize(_depth);
+    for (auto& b : _blocks) {
+        b.buffer.resize(IO_BLOCK_SIZE);
+    }
+
+    // In read mode, start the read-ahead immediately on the whole queue depth.
+    if (!_write_mode) {
+        for (size_t i = 0; i < _depth; ++i) {
+            submit(i, IO_BLOCK_SIZE);
+        }
+    }
+    return true;
+#endif
+}
+
+void ts::TSFile::UringIO::shutdown()
+{
+#if defined(TS_TSFILE_URING)
+    if (_sq_ring != nullptr && _sq_ring != MAP_FAILED) {
+        ::munmap(_sq_ring, _sq_ring_size);
+    }
+    if (_cq_ring != nullptr && _cq_ring != MAP_FAILED) {
+        ::munmap(_cq_ring, _cq_ring_size);
+    }
+    if (_sqes != nullptr && _sqes != MAP_FAILED) {
+        ::munmap(_sqes, _sqes_size);
+    }
+    _sq_ring = _cq_ring = nullptr;
+    _sqes = nullptr;
+    if (_ring_fd >= 0) {
+        ::close(_ring_fd);
+        _ring_fd = -1;
+    }
+#endif
+}
+
+
+//----------------------------------------------------------------------------
+// io_uring context: submission and completion plumbing.
+//----------------------------------------------------------------------------
+
+void ts::TSFile::UringIO::submit(size_t index, size_t size)
+{
+#if defined(TS_TSFILE_URING)
+    // There is always a free submission slot: at most "depth" requests are in
+    // flight and the submission queue holds "depth" entries.
+    const unsigned tail = __atomic_load_n(_sq_tail, __ATOMIC_RELAXED);
+    const unsigned slot = tail & *_sq_mask;
+
+    ::io_uring_sqe& sqe(_sqes[slot]);
+    std::memset(&sqe, 0, sizeof(sqe));
+    sqe.opcode = _write_mode ? IORING_OP_WRITE : IORING_OP_READ;
+    sqe.fd = _file_fd;
+    sqe.addr = reinterpret_cast<uintptr_t>(_blocks[index].buffer.data());
+    sqe.len = uint32_t(size);
+    sqe.off = _next_offset;
+    sqe.user_data = uint64_t(index);
+    _sq_array[slot] = slot;
+
+    // Publish the entry, then tell the kernel.
+    __atomic_store_n(_sq_tail, tail + 1, __ATOMIC_RELEASE);
+    ::syscall(__NR_io_uring_enter, _ring_fd, 1U, 0U, 0U, nullptr, 0U);
+
+    _blocks[index].state = BlockState::PENDING;
+    _blocks[index].fill = 0;
+    _next_offset += size;
+    _in_flight++;
+#endif
+}
+
+bool ts::TSFile::UringIO::reap(bool wait, Report& report)
+{
+#if !defined(TS_TSFILE_URING)
+    return false;
+#else
+    for (;;) {
+        // Process all available completions.
+        unsigned head = __atomic_load_n(_cq_head, __ATOMIC_RELAXED);
+        const unsigned tail = __atomic_load_n(_cq_tail, __ATOMIC_ACQUIRE);
+        bool got_one = head != tail;
+        while (head != tail) {
+            const ::io_uring_cqe& cqe(_cqes[head & *_cq_mask]);
+            const size_t index = size_t(cqe.user_data);
+            assert(index < _blocks.size());
+            _blocks[index].state = BlockState::READY;
+            _blocks[index].result = cqe.res;
+            head++;
+            assert(_in_flight > 0);
+            _in_flight--;
+        }
+        __atomic_store_n(_cq_head, head, __ATOMIC_RELEASE);
+
+        if (got_one || !wait) {
+            return got_one;
+        }
+
+        // Wait for at least one completion.
+        if (::syscall(__NR_io_uring_enter, _ring_fd, 0U, 1U, unsigned(IORING_ENTER_GETEVENTS), nullptr, 0U) < 0 && errno != EINTR) {
+            report.error(u"io_uring_enter error: %s", {SysErrorCodeMessage()});
+            return false;
+        }
+    }
+#endif
+}
+
+
+//----------------------------------------------------------------------------
+// io_uring context: sequential read with read-ahead.
+//----------------------------------------------------------------------------
+
+bool ts::TSFile::UringIO::read(void* buffer, size_t max_size, size_t& ret_size, bool& at_eof, Report& report)
+{
+    ret_size = 0;
+    Block& blk(_blocks[_next_block]);
+
+    // Wait for the completion of the next sequential block.
+    while (blk.state == BlockState::PENDING) {
+        if (!reap(true, report)) {
+            return false;
+        }
+    }
+    assert(blk.state == BlockState::READY);
+
+    if (blk.result == 0) {
+        // End of file. Do not resubmit, all subsequent blocks will also be empty.
+        at_eof = true;
+        return false;
+    }
+    if (blk.result < 0) {
+        report.error(u"asynchronous read error: %s", {SysErrorCodeMessage(-blk.result)});
+        return false;
+    }
+
+    // Copy as much as possible from the block. On regular files, a short read
+    // only happens at end of file, the sequential offsets remain contiguous.
+    ret_size = std::min(max_size, size_t(blk.result) - blk.fill);
+    std::memcpy(buffer, blk.buffer.data() + blk.fill, ret_size);
+    blk.fill += ret_size;
+
+    // When the block is fully consumed, resubmit it further down the file.
+    if (blk.fill >= size_t(blk.result)) {
+        blk.state = BlockState::IDLE;
+        if (size_t(blk.result) == IO_BLOCK_SIZE) {
+            submit(_next_block, IO_BLOCK_SIZE);
+        }
+        _next_block = (_next_block + 1) % _depth;
+    }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// io_uring context: sequential write-behind.
+//----------------------------------------------------------------------------
+
+bool ts::TSFile::UringIO::write(const void* buffer, size_t size, Report& report)
+{
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(buffer);
+    while (size > 0) {
+        Block& blk(_blocks[_next_block]);
+
+        // Wait for the previous write on this block to complete before refilling it.
+        while (blk.state == BlockState::PENDING) {
+            if (!reap(true, report)) {
+                return false;
+            }
+        }
+        if (blk.state == BlockState::READY) {
+            // Check the result of the previous write on this buffer.
+            if (blk.result < 0) {
+                report.error(u"asynchronous write error: %s", {SysErrorCodeMessage(-blk.result)});
+                return false;
+            }
+            blk.state = BlockState::IDLE;
+        }
+
+        // Fill the block and submit it when full.
+        const size_t chunk = std::min(size, IO_BLOCK_SIZE - blk.fill);
+        std::memcpy(blk.buffer.data() + blk.fill, data, chunk);
+        blk.fill += chunk;
+        data += chunk;
+        size -= chunk;
+        if (blk.fill == IO_BLOCK_SIZE) {
+            submit(_next_block, IO_BLOCK_SIZE);
+            _next_block = (_next_block + 1) % _depth;
+        }
+    }
+    return true;
+}
+
+bool ts::TSFile::UringIO::flush(Report& report)
+{
+    bool success = true;
+    if (_write_mode) {
+        // Write the last partial block, if any.
+        Block& blk(_blocks[_next_block]);
+        if (blk.state == BlockState::IDLE && blk.fill > 0) {
+            submit(_next_block, blk.fill);
+            _next_block = (_next_block + 1) % _depth;
+        }
+    }
+    // Wait for all in-flight requests and check write results.
+    while (_in_flight > 0) {
+        if (!reap(true, report)) {
+            return false;
+        }
+    }
+    if (_write_mode) {
+        for (auto& b : _blocks) {
+            if (b.state == BlockState::READY && b.result < 0) {
+                report.error(u"asynchronous write error: %s", {SysErrorCodeMessage(-b.result)});
+                success = false;
+            }
+            b.state = BlockState::IDLE;
+            b.fill = 0;
+        }
+    }
+    return success;
+}
+
+
+//----------------------------------------------------------------------------
+// io_uring context: restart the sequential pattern at a new offset.
+//----------------------------------------------------------------------------
+
+bool ts::TSFile::UringIO::reposition(uint64_t offset, Report& report)
+{
+    // Drain all in-flight requests, their data is discarded.
+    while (_in_flight > 0) {
+        if (!reap(true, report)) {
+            return false;
+        }
+    }
+    for (auto& b : _blocks) {
+        b.state = BlockState::IDLE;
+        b.fill = 0;
+    }
+    _next_offset = offset;
+    _next_block = 0;
+    if (!_write_mode) {
+        for (size_t i = 0; i < _depth; ++i) {
+            submit(i, IO_BLOCK_SIZE);
+        }
+    }
+    return true;
+}
+#endif // TS_LINUX
+
+
 //----------------------------------------------------------------------------
 // Default constructor.
 //----------------------------------------------------------------------------
@@ -426,6 +819,56 @@ bool ts::TSFile::openInternal(bool reopen, Report& report)
         return false;
     }
 
+    // Unmap a previous mapping in case of reopen.
+    if (_mmap_base != nullptr) {
+        ::munmap(_mmap_base, size_t(_mmap_size));
+        _mmap_base = nullptr;
+        _mmap_size = _mmap_next = 0;
+    }
+
+    // Memory-map the file when requested, on regular files in read-only mode.
+    // On any failure, silently fall back to standard read operations.
+    if (_prefer_mmap && read_only && _regular && uint64_t(st.st_size) > _start_offset) {
+        const uint64_t file_size = uint64_t(st.st_size);
+        void* const base = ::mmap(nullptr, size_t(file_size), PROT_READ, MAP_SHARED, _fd, 0);
+        if (base == MAP_FAILED) {
+            report.debug(u"cannot memory-map %s, reverting to standard reads: %s", {getDisplayFileName(), SysErrorCodeMessage()});
+        }
+        else {
+            _mmap_base = reinterpret_cast<uint8_t*>(base);
+            _mmap_size = file_size;
+            _mmap_next = _start_offset;
+            // Hint the kernel about the sequential access pattern and trigger read-ahead.
+            ::madvise(base, size_t(file_size), MADV_SEQUENTIAL);
+            ::madvise(base, size_t(file_size), MADV_WILLNEED);
+            report.debug(u"memory-mapped %s, %'d bytes", {getDisplayFileName(), file_size});
+        }
+    }
+
+#if defined(TS_LINUX)
+    // Discard a previous asynchronous I/O context in case of reopen.
+    if (_uring != nullptr) {
+        delete _uring;
+        _uring = nullptr;
+    }
+
+    // Create the asynchronous I/O context when requested, on regular files which are
+    // accessed in one single direction. On failure, silently fall back to synchronous I/O.
+    if (_async_depth > 0 && _regular && !_std_inout && _mmap_base == nullptr && (read_only || !read_access)) {
+        // Writes start at the current position (end of file with --append), reads at the start offset.
+        const uint64_t io_offset = read_access ? _start_offset : (append_access ? uint64_t(st.st_size) : 0);
+        UringIO* const uring = new UringIO;
+        if (uring->init(_fd, _async_depth, !read_access, io_offset, report)) {
+            _uring = uring;
+            report.debug(u"asynchronous I/O enabled on %s, queue depth %d", {getDisplayFileName(), _async_depth});
+        }
+        else {
+            delete uring;
+            report.debug(u"asynchronous I/O not available on %s, using synchronous I/O", {getDisplayFileName()});
+        }
+    }
+#endif
+
 #endif
 
     // Reset counters only if not a reopen.
@@ -479,6 +922,9 @@ bool ts::TSFile::seekCheck(Report& report)
 
 bool ts::TSFile::seekInternal(uint64_t index, Report& report)
 {
+    // Buffered archive records are no longer valid after repositioning.
+    resetArchiveState();
+
     // If seeking at the beginning and REOPEN is set, close and reopen the file.
     if (index == 0 && (_flags & REOPEN) != 0) {
         return openInternal(true, report);
@@ -486,6 +932,26 @@ bool ts::TSFile::seekInternal(uint64_t index, Report& report)
 
     report.debug(u"seeking %s at offset %'d", {_filename, _start_offset + index});
 
+#if !defined(TS_WINDOWS)
+    // With a memory-mapped file, seeking is a simple offset adjustment.
+    if (_mmap_base != nullptr) {
+        _mmap_next = _start_offset + index;
+        _at_eof = false;
+        return true;
+    }
+#endif
+
+#if defined(TS_LINUX)
+    // With asynchronous I/O, drain in-flight requests and restart the read-ahead.
+    if (_uring != nullptr) {
+        if (!_uring->reposition(_start_offset + index, report)) {
+            return false;
+        }
+        _at_eof = false;
+        return true;
+    }
+#endif
+
 #if defined(TS_WINDOWS)
     // In Win32, LARGE_INTEGER is a 64-bit structure, not an integer type
     uint64_t where = _start_offset + index;
@@ -519,6 +985,11 @@ bool ts::TSFile::seek(PacketCounter packet_index, Report& report)
         report.log(_severity, u"file %s is not rewindable", {getDisplayFileName()});
         return false;
     }
+    else if (packetFormat() == TSPacketFormat::ARCHIVE && packet_index != 0) {
+        // Archive records have variable sizes, the byte offset of a packet is unknown.
+        report.log(_severity, u"file %s is an archive file, cannot seek by packet index", {getDisplayFileName()});
+        return false;
+    }
     else {
         return seekInternal(packet_index * (packetHeaderSize() + PKT_SIZE), report);
     }
@@ -541,6 +1012,24 @@ bool ts::TSFile::close(Report& report)
         writeStuffing(_close_null, report);
     }
 
+#if defined(TS_LINUX)
+    // Flush and release the asynchronous I/O context, if any.
+    if (_uring != nullptr) {
+        _uring->flush(report);
+        delete _uring;
+        _uring = nullptr;
+    }
+#endif
+
+#if !defined(TS_WINDOWS)
+    // Release the memory mapping, if any.
+    if (_mmap_base != nullptr) {
+        ::munmap(_mmap_base, size_t(_mmap_size));
+        _mmap_base = nullptr;
+        _mmap_size = _mmap_next = 0;
+    }
+#endif
+
     if (!_std_inout) {
 #if defined(TS_WINDOWS)
         ::CloseHandle(_handle);
@@ -586,6 +1075,30 @@ bool ts::TSFile::readStreamPartial(void* buffer, size_t request_size, size_t& re
         return true;
     }
 
+#if defined(TS_LINUX)
+    // Asynchronous input: serve the bytes from the completed read-ahead blocks.
+    if (_uring != nullptr) {
+        bool eof = false;
+        const bool ok = _uring->read(buffer, request_size, read_size, eof, report);
+        _at_eof = _at_eof || eof;
+        return ok;
+    }
+#endif
+
+#if !defined(TS_WINDOWS)
+    // Memory-mapped input: serve the bytes directly from the page cache.
+    if (_mmap_base != nullptr) {
+        if (_mmap_next >= _mmap_size) {
+            _at_eof = true;
+            return false;
+        }
+        read_size = size_t(std::min(uint64_t(request_size), _mmap_size - _mmap_next));
+        std::memcpy(buffer, _mmap_base + _mmap_next, read_size);
+        _mmap_next += read_size;
+        return true;
+    }
+#endif
+
 #if defined(TS_WINDOWS)
 
     // Windows implementation
@@ -708,6 +1221,17 @@ bool ts::TSFile::writeStream(const void* buffer, size_t data_size, size_t& writt
     written_size = 0;
     SysErrorCode error_code = SYS_SUCCESS;
 
+#if defined(TS_LINUX)
+    // Asynchronous output: copy the data into a write-behind block.
+    if (_uring != nullptr) {
+        if (_uring->write(buffer, data_size, report)) {
+            written_size = data_size;
+            return true;
+        }
+        return false;
+    }
+#endif
+
 #if defined(TS_WINDOWS)
 
     // Windows implementation
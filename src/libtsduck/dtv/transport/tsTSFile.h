@@ -157,6 +157,32 @@ namespace ts {
         //!
         void setStuffing(size_t initial, size_t final);
 
+        //!
+        //! Request the use of memory mapping to read the file.
+        //! This method shall be called before opening the file.
+        //! Memory mapping is used only on Unix systems, on regular files which are opened
+        //! in read-only mode. The complete file is mapped in virtual memory and packets
+        //! are served directly from the page cache, without read system calls. The kernel
+        //! is hinted for a sequential access pattern. When memory mapping is not possible,
+        //! the file is silently read using standard read operations.
+        //! @param [in] on True to use memory mapping when possible.
+        //!
+        void setMemoryMappedRead(bool on) { _prefer_mmap = on; }
+
+        //!
+        //! Request asynchronous file I/O with the specified queue depth.
+        //! This method shall be called before opening the file.
+        //! On Linux, when the file is a regular file which is opened in read-only or
+        //! write-only mode, the file is accessed through an io_uring context which keeps
+        //! up to @a depth sequential requests in flight, overlapping storage latency with
+        //! packet processing. When asynchronous I/O is not possible (non-regular file,
+        //! other systems, old kernel), the file silently falls back to synchronous I/O.
+        //! Asynchronous and memory-mapped modes are exclusive, memory mapping has precedence.
+        //! @param [in] depth Maximum number of in-flight I/O requests. Zero (the default)
+        //! disables asynchronous I/O.
+        //!
+        void setAsyncQueueDepth(size_t depth) { _async_depth = depth; }
+
         //!
         //! Abort any currenly read/write operation in progress.
         //! The file is left in a broken state and can be only closed.
@@ -203,10 +229,19 @@ namespace ts {
         bool          _rewindable = false;   //!< Opened in rewindable mode
         bool          _regular = false;      //!< Is a regular file (ie. not a pipe or special device)
         bool          _std_inout = false;    //!< File is standard input or output.
+        bool          _prefer_mmap = false;  //!< Use memory mapping to read the file when possible.
+        size_t        _async_depth = 0;      //!< Queue depth for asynchronous I/O (0: synchronous).
 #if defined(TS_WINDOWS)
         ::HANDLE      _handle = INVALID_HANDLE_VALUE;
 #else
         int           _fd = -1;
+        uint8_t*      _mmap_base = nullptr;  //!< Base address of the memory-mapped file (null if not mapped).
+        uint64_t      _mmap_size = 0;        //!< Total size of the mapping.
+        uint64_t      _mmap_next = 0;        //!< Offset of next byte to read from the mapping.
+#endif
+#if defined(TS_LINUX)
+        class UringIO;                       //!< io_uring context for asynchronous I/O, see tsTSFile.cpp.
+        UringIO*      _uring = nullptr;      //!< Active io_uring context (null when unused).
 #endif
 
         // Implementation of AbstractReadStreamInterface
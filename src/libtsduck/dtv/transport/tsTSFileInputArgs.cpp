@@ -38,6 +38,14 @@ void ts::TSFileInputArgs::defineArgs(Args& args)
               u"If several input files are specified, several options --add-stop-stuffing are allowed. "
               u"If there are less options than input files, the last value is used for subsequent files.");
 
+    args.option(u"async-io-depth", 0, Args::INTEGER, 0, 1, 1, 1024);
+    args.help(u"async-io-depth",
+              u"Read the input files using asynchronous I/O, with the specified maximum "
+              u"number of in-flight read requests (Linux only, using io_uring). "
+              u"Keeping several requests in flight overlaps storage latency with packet "
+              u"processing. This option is ignored on non-regular files and on systems "
+              u"without asynchronous file I/O, where synchronous reads are used.");
+
     args.option(u"byte-offset", 'b', Args::UNSIGNED);
     args.help(u"byte-offset",
               u"Start reading each file at the specified byte offset (default: 0). "
@@ -70,11 +78,50 @@ void ts::TSFileInputArgs::defineArgs(Args& args)
               u"For a given file, if the computed label is above the maximum (" +
               UString::Decimal(TSPacketLabelSet::MAX) + u"), its packets are not labelled.");
 
+    args.option(u"memory-map");
+    args.help(u"memory-map",
+              u"Use memory mapping to read the input files (Unix only). "
+              u"The files are mapped in virtual memory and packets are served directly from the "
+              u"page cache, without read system calls. This is useful when processing very large "
+              u"capture files offline. This option is ignored on non-regular files and on systems "
+              u"without memory mapping, where standard reads are used.");
+
     args.option(u"packet-offset", 'p', Args::UNSIGNED);
     args.help(u"packet-offset",
               u"Start reading each file at the specified TS packet (default: 0). "
               u"This option is allowed only if all input files are regular files.");
 
+    args.option(u"reproduce-timing", 0, Args::POSITIVE, 0, 1, 1, Args::UNLIMITED_VALUE, true);
+    args.help(u"reproduce-timing",
+              u"Replay the packets at the pace at which they were received, using the input "
+              u"time stamps which were recorded in the packet metadata (duck file format, "
+              u"see option --format). Before delivering a packet, wait until the same delay "
+              u"has elapsed since the start of the replay as was recorded between the first "
+              u"packet and this one. The recorded time stamps have the resolution of the "
+              u"PCR clock, 27 MHz or 37 ns. The optional value is a number of packets to "
+              u"deliver between two waits (default: 1). Larger values reduce the CPU load "
+              u"and the timing accuracy at the same time. Packets without input time stamp "
+              u"are delivered together with the preceding time-stamped packet. "
+              u"This option is not allowed with --interleave.");
+
+    args.option(u"spin-duration", 0, Args::POSITIVE);
+    args.help(u"spin-duration", u"micro-seconds",
+              u"With --reproduce-timing, use a hybrid wait at each pacing point: sleep until "
+              u"the specified number of micro-seconds before the scheduled delivery time, then "
+              u"actively wait on the monotonic clock for the remaining time. The accuracy of "
+              u"the replay no longer depends on the operating system timers, at the expense "
+              u"of some CPU load. By default, use plain system sleeps only.");
+
+    args.option(u"start-time", 0, Args::UNSIGNED);
+    args.help(u"start-time", u"milliseconds",
+              u"Start reading each file at the specified play time in milliseconds, "
+              u"using the sidecar time index file which was created with the file "
+              u"output option --time-index. The index maps PCR time stamps to packet "
+              u"positions, so that the file is directly seeked at the right position, "
+              u"without scanning it from the beginning. "
+              u"This option is allowed only on regular files in plain TS format "
+              u"and is mutually exclusive with --byte-offset and --packet-offset.");
+
     args.option(u"repeat", 'r', Args::POSITIVE);
     args.help(u"repeat",
               u"Repeat the playout of each file the specified number of times (default: only once). "
@@ -91,10 +138,16 @@ bool ts::TSFileInputArgs::loadArgs(DuckContext& duck, Args& args)
     args.getValues(_filenames);
     _repeat_count = args.present(u"infinite") ? 0 : args.intValue<size_t>(u"repeat", 1);
     _start_offset = args.intValue<uint64_t>(u"byte-offset", args.intValue<uint64_t>(u"packet-offset", 0) * PKT_SIZE);
+    _start_time = args.intValue<MilliSecond>(u"start-time", -1);
     _interleave = args.present(u"interleave");
     _first_terminate = args.present(u"first-terminate");
+    _memory_map = args.present(u"memory-map");
+    args.getIntValue(_aio_depth, u"async-io-depth", 0);
     args.getIntValue(_interleave_chunk, u"interleave", 1);
     args.getIntValue(_base_label, u"label-base", TSPacketLabelSet::MAX + 1);
+    _reproduce_timing = args.present(u"reproduce-timing");
+    args.getIntValue(_replay_burst, u"reproduce-timing", 1);
+    _replay_spin = args.intValue<NanoSecond>(u"spin-duration", 0) * NanoSecPerMicroSec;
     args.getIntValues(_start_stuffing, u"add-start-stuffing");
     args.getIntValues(_stop_stuffing, u"add-stop-stuffing");
     _file_format = LoadTSPacketFormatInputOption(args);
@@ -116,6 +169,18 @@ bool ts::TSFileInputArgs::loadArgs(DuckContext& duck, Args& args)
         args.error(u"specifying --infinite is meaningless with more than one file");
         return false;
     }
+    if (_start_time >= 0 && _start_offset > 0) {
+        args.error(u"--start-time is mutually exclusive with --byte-offset and --packet-offset");
+        return false;
+    }
+    if (_reproduce_timing && _interleave) {
+        args.error(u"--reproduce-timing cannot be used with --interleave");
+        return false;
+    }
+    if (_replay_spin > 0 && !_reproduce_timing) {
+        args.error(u"--spin-duration cannot be used without --reproduce-timing");
+        return false;
+    }
 
     // Make sure start and stop stuffing vectors have the same size as the file vector.
     // If the vectors must be enlarged, repeat the last value in the array.
@@ -145,8 +210,29 @@ bool ts::TSFileInputArgs::openFile(size_t name_index, size_t file_index, Report&
     // Preset artificial stuffing.
     _files[file_index].setStuffing(_start_stuffing[name_index], _stop_stuffing[name_index]);
 
+    // Preset memory-mapped or asynchronous input when requested.
+    _files[file_index].setMemoryMappedRead(_memory_map);
+    _files[file_index].setAsyncQueueDepth(_aio_depth);
+
+    // With --start-time, resolve the start offset from the sidecar time index.
+    uint64_t start_offset = _start_offset;
+    if (_start_time >= 0) {
+        if (name.empty()) {
+            report.error(u"--start-time cannot be used on standard input");
+            return false;
+        }
+        TSFileTimeIndex index;
+        uint64_t packet_index = 0;
+        if (!index.openRead(name, report) || !index.lookup(_start_time, packet_index)) {
+            report.error(u"no usable time index for file %s", {name});
+            return false;
+        }
+        report.verbose(u"starting %s at packet %'d for play time %'d ms", {name, packet_index, _start_time});
+        start_offset = packet_index * PKT_SIZE;
+    }
+
     // Actually open the file.
-    return _files[file_index].openRead(name, _repeat_count, _start_offset, report, _file_format);
+    return _files[file_index].openRead(name, _repeat_count, start_offset, report, _file_format);
 }
 
 
@@ -197,6 +283,7 @@ bool ts::TSFileInputArgs::open(Report& report)
     _interleave_remain = _interleave_chunk;
     _aborted = false;
     _eof.clear();
+    _replay_started = false;
 
     return ok;
 }
@@ -247,6 +334,9 @@ size_t ts::TSFileInputArgs::read(TSPacket* buffer, TSPacketMetadata* pkt_data, s
         if (_interleave && _interleave_remain < count) {
             count = _interleave_remain;
         }
+        if (_reproduce_timing && count > _replay_burst) {
+            count = _replay_burst;
+        }
 
         // Check if current file was already at end of file.
         const bool already_eof = Contains(_eof, _current_filename);
@@ -263,6 +353,11 @@ size_t ts::TSFileInputArgs::read(TSPacket* buffer, TSPacketMetadata* pkt_data, s
             count = _files[_current_file].readPackets(buffer + read_count, pkt_data + read_count, count, report);
         }
 
+        // With --reproduce-timing, pace the delivery on the recorded time stamps.
+        if (_reproduce_timing && count > 0 && !_aborted) {
+            waitReplayTime(pkt_data + read_count, count);
+        }
+
         // Mark all read packets with a label.
         const size_t label = _base_label + _current_filename;
         if (label <= TSPacketLabelSet::MAX) {
@@ -305,3 +400,62 @@ size_t ts::TSFileInputArgs::read(TSPacket* buffer, TSPacketMetadata* pkt_data, s
 
     return read_count;
 }
+
+
+//----------------------------------------------------------------------------
+// With --reproduce-timing, wait for the delivery time of a chunk of packets.
+//----------------------------------------------------------------------------
+
+void ts::TSFileInputArgs::waitReplayTime(const TSPacketMetadata* pkt_data, size_t count)
+{
+    // Pace on the first time-stamped packet of the chunk. Packets without
+    // time stamp are delivered together with the preceding time-stamped one.
+    size_t first = 0;
+    while (first < count && !pkt_data[first].hasInputTimeStamp()) {
+        ++first;
+    }
+    if (first >= count) {
+        return;
+    }
+    const uint64_t pts = pkt_data[first].getInputTimeStamp();
+
+    // Elapsed time since the previous pacing point, in PCR units, handling the
+    // wrap-up of the time stamps at PCR_SCALE. A delta of more than half the
+    // PCR scale denotes a backward jump, e.g. when the file play is repeated:
+    // re-anchor the replay clock without waiting. Same thing on the very first
+    // time-stamped packet of the session.
+    const uint64_t delta_pcr = (pts + PCR_SCALE - _replay_pts) % PCR_SCALE;
+    if (!_replay_started || delta_pcr >= PCR_SCALE / 2) {
+        _replay_due.getSystemTime();
+        _replay_pts = pts;
+        _replay_started = true;
+        return;
+    }
+
+    // Scheduled delivery time. The conversion to nano-seconds is split into
+    // whole seconds and remainder to avoid a 64-bit intermediate overflow.
+    _replay_due += NanoSecond((delta_pcr / SYSTEM_CLOCK_FREQ) * NanoSecPerSec + ((delta_pcr % SYSTEM_CLOCK_FREQ) * NanoSecPerSec) / SYSTEM_CLOCK_FREQ);
+    _replay_pts = pts;
+
+    // Wait until the scheduled delivery time, using the same hybrid sleep/spin
+    // scheme as BitRateRegulator when --spin-duration is set.
+    Monotonic now(true);
+    if (_replay_spin > 0) {
+        // Coarse system sleep until a few microseconds before the scheduled
+        // time (skipped when the remaining time is shorter than the active wait).
+        if (_replay_due - now > _replay_spin) {
+            Monotonic coarse(_replay_due);
+            coarse -= _replay_spin;
+            coarse.wait();
+            now.getSystemTime();
+        }
+        // Then actively wait on the monotonic clock for the remaining time.
+        while (now < _replay_due && !_aborted) {
+            now.getSystemTime();
+        }
+    }
+    else if (now < _replay_due) {
+        // Pure system sleep until the scheduled delivery time.
+        _replay_due.wait();
+    }
+}
@@ -13,10 +13,12 @@
 
 #pragma once
 #include "tsTSFile.h"
+#include "tsTSFileTimeIndex.h"
 #include "tsTSPacket.h"
 #include "tsTSPacketMetadata.h"
 #include "tsDuckContext.h"
 #include "tsArgs.h"
+#include "tsMonotonic.h"
 
 namespace ts {
     //!
@@ -84,12 +86,21 @@ namespace ts {
         volatile bool       _aborted = true;          // Set when abortInput() is set.
         bool                _interleave = false;      // Read all files simultaneously with interleaving.
         bool                _first_terminate = false; // With _interleave, terminate when the first file terminates.
+        bool                _memory_map = false;      // Use memory mapping to read regular files.
+        size_t              _aio_depth = 0;           // Queue depth for asynchronous file I/O (0: synchronous).
         size_t              _interleave_chunk = 0;    // Number of packets per chunk when _interleave.
         size_t              _interleave_remain = 0;   // Remaining packets to read in current chunk of current file.
         size_t              _current_filename = 0;    // Current file index in _filenames.
         size_t              _current_file = 0;        // Current file index in _files. Depends on _interleave.
         size_t              _repeat_count = 1;
         uint64_t            _start_offset = 0;
+        MilliSecond         _start_time = -1;     // Start play time from the sidecar time index (-1: unused).
+        bool                _reproduce_timing = false; // Pace the packets on the recorded input time stamps.
+        size_t              _replay_burst = 1;    // With _reproduce_timing, number of packets between two waits.
+        NanoSecond          _replay_spin = 0;     // Duration of final active wait at each pacing point.
+        bool                _replay_started = false;   // A first input time stamp was seen, the replay clock is anchored.
+        uint64_t            _replay_pts = 0;      // Input time stamp (PCR units) at the last pacing point.
+        Monotonic           _replay_due {};       // Scheduled delivery time of the last pacing point.
         size_t              _base_label = 0;
         TSPacketFormat      _file_format = TSPacketFormat::AUTODETECT;
         UStringVector       _filenames {};
@@ -103,5 +114,9 @@ namespace ts {
 
         // Close all files which are currently open.
         bool closeAllFiles(Report& report);
+
+        // With --reproduce-timing, wait until the scheduled delivery time of the
+        // first time-stamped packet in the chunk, using a hybrid sleep/spin wait.
+        void waitReplayTime(const TSPacketMetadata* pkt_data, size_t count);
     };
 }
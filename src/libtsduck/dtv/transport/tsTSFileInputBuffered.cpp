@@ -27,6 +27,24 @@ ts::TSFileInputBuffered::TSFileInputBuffered(size_t buffer_size) :
 
 ts::TSFileInputBuffered::~TSFileInputBuffered()
 {
+    stopReadAhead();
+}
+
+
+//----------------------------------------------------------------------------
+// Enable or disable background read-ahead.
+//----------------------------------------------------------------------------
+
+bool ts::TSFileInputBuffered::setReadAhead(size_t packets, Report& report)
+{
+    if (isOpen()) {
+        report.error(u"file %s is already open, cannot change read-ahead", {getFileName()});
+        return false;
+    }
+    else {
+        _ra_size = packets;
+        return true;
+    }
 }
 
 
@@ -62,11 +80,47 @@ bool ts::TSFileInputBuffered::openRead(const UString& filename, size_t repeat_co
         _first_index = 0;
         _current_offset = 0;
         _total_count = 0;
-        return TSFile::openRead(filename, repeat_count, start_offset, report, format);
+        if (!TSFile::openRead(filename, repeat_count, start_offset, report, format)) {
+            return false;
+        }
+        // Start the read-ahead thread when requested.
+        if (_ra_size > 0) {
+            for (auto& chunk : _ra_chunk) {
+                chunk.packets.resize(_ra_size);
+                chunk.metadata.resize(_ra_size);
+                chunk.next = 0;
+                chunk.count = 0;
+                chunk.filled = false;
+            }
+            _ra_drain = 0;
+            _ra_stop = false;
+            _ra_eof = false;
+            _ra_delivered = 0;
+            _ra_report = &report;
+            _ra_started = Thread::start();
+            if (!_ra_started) {
+                report.error(u"cannot start read-ahead thread for file %s", {getFileName()});
+                _ra_report = nullptr;
+                TSFile::close(report);
+                return false;
+            }
+        }
+        return true;
     }
 }
 
 
+//----------------------------------------------------------------------------
+// Close the file, terminating the read-ahead thread first.
+//----------------------------------------------------------------------------
+
+bool ts::TSFileInputBuffered::close(Report& report)
+{
+    stopReadAhead();
+    return TSFile::close(report);
+}
+
+
 //----------------------------------------------------------------------------
 // Make sure that the generic open() returns an error.
 //----------------------------------------------------------------------------
@@ -84,8 +138,11 @@ bool ts::TSFileInputBuffered::open(const UString& filename, OpenFlags flags, Rep
 
 ts::PacketCounter ts::TSFileInputBuffered::readPacketsCount() const
 {
+    // With read-ahead, the file-level counter runs ahead of the application,
+    // use the number of actually delivered packets instead.
+    const PacketCounter fetched = _ra_size > 0 ? _ra_delivered : TSFile::readPacketsCount();
     // Make sure we do not report packets twice.
-    return isOpen() ? TSFile::readPacketsCount() - (_total_count - _current_offset) : 0;
+    return isOpen() ? fetched - (_total_count - _current_offset) : 0;
 }
 
 
@@ -196,8 +253,9 @@ size_t ts::TSFileInputBuffered::read(TSPacket* user_buffer, size_t max_packets,
         _in_packets += count;
     }
 
-    // Then, read the rest directly from the file into the user's buffer.
-    size_t user_count = TSFile::readPackets(user_buffer, user_metadata, max_packets, report);
+    // Then, read the rest into the user's buffer, from the read-ahead chunks
+    // or directly from the file.
+    size_t user_count = fetchPackets(user_buffer, user_metadata, max_packets, report);
     _in_packets += user_count;
 
     // Finally, read back the rest into our buffer. We do the exchanges that way to
@@ -266,3 +324,116 @@ size_t ts::TSFileInputBuffered::read(TSPacket* user_buffer, size_t max_packets,
 
     return _in_packets;
 }
+
+
+//----------------------------------------------------------------------------
+// Get packets from the read-ahead chunks or synchronously from the file.
+//----------------------------------------------------------------------------
+
+size_t ts::TSFileInputBuffered::fetchPackets(TSPacket* buffer, TSPacketMetadata* metadata, size_t max_packets, Report& report)
+{
+    if (_ra_size == 0) {
+        // Read-ahead disabled, synchronous read from the file.
+        return TSFile::readPackets(buffer, metadata, max_packets, report);
+    }
+
+    size_t total = 0;
+    std::unique_lock<std::mutex> lock(_ra_mutex);
+    while (max_packets > 0) {
+        ReadAheadChunk& chunk(_ra_chunk[_ra_drain]);
+        if (!chunk.filled) {
+            if (_ra_eof || total > 0) {
+                // End of file or some packets already fetched, do not block for more.
+                break;
+            }
+            // Wait for the read-ahead thread to fill a chunk.
+            _ra_filled.wait(lock);
+            continue;
+        }
+        if (chunk.count == 0) {
+            // Filled chunk without packets, end of file.
+            break;
+        }
+        const size_t count = std::min(max_packets, chunk.count - chunk.next);
+        TSPacket::Copy(buffer, &chunk.packets[chunk.next], count);
+        if (metadata != nullptr) {
+            TSPacketMetadata::Copy(metadata, &chunk.metadata[chunk.next], count);
+            metadata += count;
+        }
+        buffer += count;
+        max_packets -= count;
+        chunk.next += count;
+        total += count;
+        if (chunk.next >= chunk.count) {
+            // Chunk fully drained, hand it back to the read-ahead thread.
+            chunk.filled = false;
+            _ra_drain ^= 1;
+            _ra_drained.notify_all();
+        }
+    }
+    _ra_delivered += total;
+    return total;
+}
+
+
+//----------------------------------------------------------------------------
+// The read-ahead thread.
+//----------------------------------------------------------------------------
+
+void ts::TSFileInputBuffered::main()
+{
+    _ra_report->debug(u"read-ahead thread started");
+
+    size_t fill = 0;  // index of the next chunk to fill
+    for (;;) {
+        // Wait for a free chunk.
+        {
+            std::unique_lock<std::mutex> lock(_ra_mutex);
+            while (!_ra_stop && _ra_chunk[fill].filled) {
+                _ra_drained.wait(lock);
+            }
+            if (_ra_stop) {
+                break;
+            }
+        }
+
+        // Fill the chunk without holding the mutex, this thread is the only file reader.
+        ReadAheadChunk& chunk(_ra_chunk[fill]);
+        const size_t count = TSFile::readPackets(chunk.packets.data(), chunk.metadata.data(), _ra_size, *_ra_report);
+
+        // Publish the chunk. A filled chunk without packets marks the end of file.
+        {
+            std::lock_guard<std::mutex> lock(_ra_mutex);
+            chunk.next = 0;
+            chunk.count = count;
+            chunk.filled = true;
+            _ra_eof = count == 0;
+            _ra_filled.notify_all();
+        }
+        if (count == 0) {
+            break;
+        }
+        fill ^= 1;
+    }
+
+    _ra_report->debug(u"read-ahead thread completed");
+}
+
+
+//----------------------------------------------------------------------------
+// Terminate the read-ahead thread, if started.
+//----------------------------------------------------------------------------
+
+void ts::TSFileInputBuffered::stopReadAhead()
+{
+    if (_ra_started) {
+        {
+            std::lock_guard<std::mutex> lock(_ra_mutex);
+            _ra_stop = true;
+            _ra_drained.notify_all();
+        }
+        waitForTermination();
+        _ra_started = false;
+        _ra_report = nullptr;
+    }
+}
@@ -14,6 +14,7 @@
 #pragma once
 #include "tsTSFile.h"
 #include "tsTSPacketMetadata.h"
+#include "tsThread.h"
 
 namespace ts {
     //!
@@ -23,7 +24,7 @@ namespace ts {
     //! This variant of TSFile allows to seek back and forth to some extent
     //! without doing I/O's and can work on non-seekable files (pipes for instance).
     //!
-    class TSDUCKDLL TSFileInputBuffered: public TSFile
+    class TSDUCKDLL TSFileInputBuffered: public TSFile, private Thread
     {
         TS_NOBUILD_NOCOPY(TSFileInputBuffered);
     public:
@@ -53,6 +54,33 @@ namespace ts {
         //!
         bool setBufferSize(size_t buffer_size, Report& report);
 
+        //!
+        //! Enable or disable background read-ahead.
+        //! Can be done only when the file is closed.
+        //!
+        //! When read-ahead is enabled, a dedicated thread fills two alternating
+        //! chunks of packets behind the scene. The read() method drains the filled
+        //! chunks instead of performing file I/O, so the caller is not stalled at
+        //! buffer-refill boundaries as long as the file keeps up. The refill of a
+        //! chunk starts as soon as it is fully drained, keeping between one and two
+        //! chunks of packets ahead of the read position.
+        //!
+        //! @param [in] packets Size in packets of each of the two read-ahead chunks,
+        //! the high watermark being twice this value. When set to zero (the default),
+        //! packets are synchronously read from the file.
+        //! @param [in,out] report Where to report errors.
+        //! @return True on success, false on error.
+        //!
+        bool setReadAhead(size_t packets, Report& report);
+
+        //!
+        //! Close the file.
+        //! Hide TSFile::close(). Also terminate the read-ahead thread when there is one.
+        //! @param [in,out] report Where to report errors.
+        //! @return True on success, false on error.
+        //!
+        bool close(Report& report);
+
         //!
         //! Get the buffer size.
         //! @return The buffer size in number of TS packets.
@@ -164,6 +192,42 @@ namespace ts {
         size_t                 _current_offset = 0; // Offset from _first_index of "current" readable packet
         size_t                 _total_count = 0;    // Total count of valid packets in buffer.
 
+        // One read-ahead chunk, filled by the read-ahead thread, drained by read().
+        class ReadAheadChunk
+        {
+        public:
+            ReadAheadChunk() = default;
+            TSPacketVector         packets {};   // Chunk of packets from the file.
+            TSPacketMetadataVector metadata {};  // Corresponding metadata.
+            size_t                 next = 0;     // Next packet to drain in the chunk.
+            size_t                 count = 0;    // Number of valid packets in the chunk.
+            bool                   filled = false; // The chunk is filled, owned by the draining side.
+        };
+
+        // Read-ahead state. The mutex protects the chunk states, the end of file
+        // indicator and the delivered packet counter. The file itself is accessed
+        // by the read-ahead thread only, outside the mutex.
+        size_t                  _ra_size = 0;        // Chunk size in packets, zero when read-ahead is disabled.
+        bool                    _ra_started = false; // The read-ahead thread is started.
+        bool                    _ra_stop = false;    // Ask the read-ahead thread to terminate.
+        bool                    _ra_eof = false;     // The read-ahead thread reached end of file or error.
+        size_t                  _ra_drain = 0;       // Index of the chunk being drained.
+        PacketCounter           _ra_delivered = 0;   // Number of packets delivered to the caller.
+        Report*                 _ra_report = nullptr; // Report for the read-ahead thread, valid until close.
+        ReadAheadChunk          _ra_chunk[2] {};     // The two alternating chunks.
+        std::mutex              _ra_mutex {};        // Protect the read-ahead state.
+        std::condition_variable _ra_filled {};       // Signaled when a chunk is filled or on end of file.
+        std::condition_variable _ra_drained {};      // Signaled when a chunk is drained or on stop request.
+
+        // Implementation of Thread: the read-ahead thread.
+        virtual void main() override;
+
+        // Get packets from the read-ahead chunks or synchronously from the file.
+        size_t fetchPackets(TSPacket* buffer, TSPacketMetadata* metadata, size_t max_packets, Report& report);
+
+        // Terminate the read-ahead thread, if started.
+        void stopReadAhead();
+
         // Make sure that the generic open() returns an error.
         virtual bool open(const UString& filename, OpenFlags flags, Report& report, TSPacketFormat format) override;
 
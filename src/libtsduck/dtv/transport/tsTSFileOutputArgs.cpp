@@ -46,6 +46,14 @@ void ts::TSFileOutputArgs::defineArgs(Args& args)
               u"Specify that <count> null TS packets must be automatically appended "
               u"at the end of the output file, after what comes from the previous plugins.");
 
+    args.option(u"async-io-depth", 0, Args::INTEGER, 0, 1, 1, 1024);
+    args.help(u"async-io-depth",
+              u"Write the output file using asynchronous I/O, with the specified maximum "
+              u"number of in-flight write requests (Linux only, using io_uring). "
+              u"Keeping several requests in flight overlaps storage latency with packet "
+              u"processing. This option is ignored on non-regular files and on systems "
+              u"without asynchronous file I/O, where synchronous writes are used.");
+
     args.option(u"append", 'a');
     args.help(u"append", u"If the file already exists, append to the end of the file. By default, existing files are overwritten.");
 
@@ -59,6 +67,15 @@ void ts::TSFileOutputArgs::defineArgs(Args& args)
               u"Then, in case of open error, periodically retry to open the file. "
               u"See also options --retry-interval and --max-retry.");
 
+    args.option(u"time-index", 0);
+    args.help(u"time-index",
+              u"Write a sidecar time index file next to each output file, with an additional "
+              u"extension '.tsix'. The index maps PCR time stamps to packet positions in the "
+              u"output file. It is written incrementally, while the output file grows, and is "
+              u"later used by the file input plugin option --start-time to seek directly to a "
+              u"given play time in long recordings, without scanning the file from the beginning. "
+              u"This option is only meaningful when the output file format is the default plain TS.");
+
     args.option(u"retry-interval", 0, Args::POSITIVE);
     args.help(u"retry-interval", u"milliseconds",
               u"With --reopen-on-error, specify the number of milliseconds to wait before "
@@ -107,6 +124,7 @@ bool ts::TSFileOutputArgs::loadArgs(DuckContext& duck, Args& args)
     _reopen = args.present(u"reopen-on-error");
     args.getIntValue(_retry_max, u"max-retry", 0);
     args.getIntValue(_retry_interval, u"retry-interval", DEFAULT_RETRY_INTERVAL);
+    args.getIntValue(_aio_depth, u"async-io-depth", 0);
     args.getIntValue(_start_stuffing, u"add-start-stuffing", 0);
     args.getIntValue(_stop_stuffing, u"add-stop-stuffing", 0);
     args.getIntValue(_max_files, u"max-files", 0);
@@ -114,6 +132,7 @@ bool ts::TSFileOutputArgs::loadArgs(DuckContext& duck, Args& args)
     args.getIntValue(_max_duration, u"max-duration", 0);
     _file_format = LoadTSPacketFormatOutputOption(args);
     _multiple_files = _max_size > 0 || _max_duration > 0;
+    _time_index = args.present(u"time-index");
 
     _flags = TSFile::WRITE | TSFile::SHARED;
     if (args.present(u"append")) {
@@ -131,6 +150,10 @@ bool ts::TSFileOutputArgs::loadArgs(DuckContext& duck, Args& args)
         args.error(u"--max-duration and --max-size cannot be used on standard output");
         return false;
     }
+    if (_name.empty() && _time_index) {
+        args.error(u"--time-index cannot be used on standard output");
+        return false;
+    }
 
     return true;
 }
@@ -154,6 +177,7 @@ bool ts::TSFileOutputArgs::open(Report& report, AbortInterface* abort)
     _next_open_time = Time::CurrentUTC();
     _current_files.clear();
     _file.setStuffing(_start_stuffing, _stop_stuffing);
+    _file.setAsyncQueueDepth(_aio_depth);
     size_t retry_allowed = _retry_max == 0 ? std::numeric_limits<size_t>::max() : _retry_max;
     return openAndRetry(false, retry_allowed, report, abort);
 }
@@ -188,7 +212,16 @@ bool ts::TSFileOutputArgs::openAndRetry(bool initial_wait, size_t& retry_allowed
         // Try to open the file.
         const UString name(_multiple_files ? _name_gen.newFileName() : _name);
         report.verbose(u"creating file %s", {name});
-        const bool success = _file.open(name, _flags, report, _file_format);
+        bool success = _file.open(name, _flags, report, _file_format);
+
+        // Create the sidecar time index next to the newly created file.
+        if (success && _time_index) {
+            _index_packets = 0;
+            success = _index.createWrite(name, report);
+            if (!success) {
+                _file.close(NULLREP);
+            }
+        }
 
         // Remember the list of created files if we need to limit their number.
         if (success && _multiple_files && _max_files > 0) {
@@ -226,6 +259,11 @@ bool ts::TSFileOutputArgs::openAndRetry(bool initial_wait, size_t& retry_allowed
 
 bool ts::TSFileOutputArgs::closeAndCleanup(Report& report)
 {
+    // Close the sidecar time index first.
+    if (_index.isOpen() && !_index.close(report)) {
+        return false;
+    }
+
     // Close the current file.
     if (_file.isOpen() && !_file.close(report)) {
         return false;
@@ -247,6 +285,11 @@ bool ts::TSFileOutputArgs::closeAndCleanup(Report& report)
             // Failed to delete, keep it to retry later.
             failed_delete.push_back(name);
         }
+
+        // Delete its sidecar time index, if there is one.
+        if (_time_index) {
+            fs::remove(TSFileTimeIndex::IndexFileName(name), &ErrCodeReport());
+        }
     }
 
     // Re-insert files we failed to delete at head of list so that we will retry to delete them next time.
@@ -284,6 +327,13 @@ bool ts::TSFileOutputArgs::write(const TSPacket* buffer, const TSPacketMetadata*
         const size_t written = std::min(size_t(_file.writePacketsCount() - where), packet_count);
         _current_size += written * PKT_SIZE;
 
+        // Update the sidecar time index with the written packets.
+        if (_time_index) {
+            for (size_t n = 0; n < written; ++n) {
+                _index.feedPacket(buffer[n], _index_packets++);
+            }
+        }
+
         // In case of success or no retry, return now.
         if (success || !_reopen || (abort != nullptr && abort->aborting())) {
             return success;
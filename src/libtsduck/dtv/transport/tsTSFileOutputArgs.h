@@ -13,6 +13,7 @@
 
 #pragma once
 #include "tsTSFile.h"
+#include "tsTSFileTimeIndex.h"
 #include "tsTSPacket.h"
 #include "tsTSPacketMetadata.h"
 #include "tsFileNameGenerator.h"
@@ -92,17 +93,21 @@ namespace ts {
         bool              _reopen = false;
         MilliSecond       _retry_interval = DEFAULT_RETRY_INTERVAL;
         size_t            _retry_max = 0;
+        size_t            _aio_depth = 0;
         size_t            _start_stuffing = 0;
         size_t            _stop_stuffing = 0;
         uint64_t          _max_size = 0;
         Second            _max_duration = 0;
         size_t            _max_files = 0;
         bool              _multiple_files = false;
+        bool              _time_index = false;
 
         // Working data:
         TSFile            _file {};
+        TSFileTimeIndex   _index {};
         FileNameGenerator _name_gen {};
         uint64_t          _current_size = 0;
+        uint64_t          _index_packets = 0;
         Time              _next_open_time {};
         UStringList       _current_files {};
 
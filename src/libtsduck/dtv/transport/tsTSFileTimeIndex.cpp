@@ -0,0 +1,189 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsTSFileTimeIndex.h"
+#include "tsNullReport.h"
+#include "tsMemory.h"
+
+
+//----------------------------------------------------------------------------
+// Destructor.
+//----------------------------------------------------------------------------
+
+ts::TSFileTimeIndex::~TSFileTimeIndex()
+{
+    if (isOpen()) {
+        close(NULLREP);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Build the name of the index file for a given TS file.
+//----------------------------------------------------------------------------
+
+ts::UString ts::TSFileTimeIndex::IndexFileName(const UString& ts_file_name)
+{
+    return ts_file_name + u".tsix";
+}
+
+
+//----------------------------------------------------------------------------
+// Create an index file for writing.
+//----------------------------------------------------------------------------
+
+bool ts::TSFileTimeIndex::createWrite(const UString& ts_file_name, Report& report, uint64_t pcr_interval)
+{
+    if (isOpen()) {
+        report.error(u"time index already open");
+        return false;
+    }
+
+    const UString name(IndexFileName(ts_file_name));
+    _out.open(name.toUTF8().c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!_out) {
+        report.error(u"error creating time index file %s", {name});
+        return false;
+    }
+
+    // Write the file header.
+    uint8_t header[HEADER_SIZE];
+    PutUInt32BE(header, MAGIC);
+    PutUInt32BE(header + 4, VERSION);
+    _out.write(reinterpret_cast<const char*>(header), HEADER_SIZE);
+
+    _write = true;
+    _pcr_interval = pcr_interval;
+    _last_raw_pcr = _last_indexed_pcr = INVALID_PCR;
+    _pcr_offset = 0;
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Feed one packet of the recorded TS file (writing mode).
+//----------------------------------------------------------------------------
+
+void ts::TSFileTimeIndex::feedPacket(const TSPacket& pkt, uint64_t packet_index)
+{
+    if (_write && pkt.hasPCR()) {
+        // Unwrap the PCR so that the indexed values are monotonic.
+        const uint64_t raw = pkt.getPCR();
+        if (_last_raw_pcr != INVALID_PCR && WrapUpPCR(_last_raw_pcr, raw)) {
+            _pcr_offset += PCR_SCALE;
+        }
+        _last_raw_pcr = raw;
+        const uint64_t pcr = _pcr_offset + raw;
+
+        // Add an entry when this is the first PCR, when the last entry is
+        // older than the index interval or after a backward discontinuity.
+        if (_last_indexed_pcr == INVALID_PCR || pcr >= _last_indexed_pcr + _pcr_interval || pcr < _last_indexed_pcr) {
+            uint8_t entry[ENTRY_SIZE];
+            PutUInt64BE(entry, packet_index);
+            PutUInt64BE(entry + 8, pcr);
+            _out.write(reinterpret_cast<const char*>(entry), ENTRY_SIZE);
+            _last_indexed_pcr = pcr;
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Load an existing index file (reading mode).
+//----------------------------------------------------------------------------
+
+bool ts::TSFileTimeIndex::openRead(const UString& ts_file_name, Report& report)
+{
+    if (isOpen()) {
+        report.error(u"time index already open");
+        return false;
+    }
+
+    const UString name(IndexFileName(ts_file_name));
+    std::ifstream in(name.toUTF8().c_str(), std::ios::in | std::ios::binary);
+    if (!in) {
+        report.error(u"error opening time index file %s", {name});
+        return false;
+    }
+
+    // Read and check the file header.
+    uint8_t header[HEADER_SIZE];
+    in.read(reinterpret_cast<char*>(header), HEADER_SIZE);
+    if (size_t(in.gcount()) != HEADER_SIZE || GetUInt32BE(header) != MAGIC || GetUInt32BE(header + 4) != VERSION) {
+        report.error(u"invalid time index file %s", {name});
+        return false;
+    }
+
+    // Read all entries until the end of file. A truncated trailing entry is
+    // ignored: the index may still be written while the file is replayed.
+    _entries.clear();
+    uint8_t entry[ENTRY_SIZE];
+    for (;;) {
+        in.read(reinterpret_cast<char*>(entry), ENTRY_SIZE);
+        if (size_t(in.gcount()) != ENTRY_SIZE) {
+            break;
+        }
+        _entries.push_back({GetUInt64BE(entry), GetUInt64BE(entry + 8)});
+    }
+
+    report.debug(u"loaded %d entries from time index file %s", {_entries.size(), name});
+    _read = true;
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Close the index file.
+//----------------------------------------------------------------------------
+
+bool ts::TSFileTimeIndex::close(Report& report)
+{
+    bool ok = true;
+    if (_write) {
+        _out.flush();
+        ok = bool(_out);
+        if (!ok) {
+            report.error(u"error writing time index file");
+        }
+        _out.close();
+    }
+    _read = _write = false;
+    _entries.clear();
+    _last_raw_pcr = _last_indexed_pcr = INVALID_PCR;
+    _pcr_offset = 0;
+    return ok;
+}
+
+
+//----------------------------------------------------------------------------
+// Get the total duration which is covered by the index (reading mode).
+//----------------------------------------------------------------------------
+
+ts::MilliSecond ts::TSFileTimeIndex::duration() const
+{
+    return _entries.empty() ? 0 : MilliSecond((_entries.back().pcr - _entries.front().pcr) / (SYSTEM_CLOCK_FREQ / 1000));
+}
+
+
+//----------------------------------------------------------------------------
+// Locate the packet index for a given play time (reading mode).
+//----------------------------------------------------------------------------
+
+bool ts::TSFileTimeIndex::lookup(MilliSecond time_offset, uint64_t& packet_index) const
+{
+    if (_entries.empty()) {
+        packet_index = 0;
+        return false;
+    }
+
+    // Binary search for the last entry at or before the target PCR.
+    const uint64_t target = _entries.front().pcr + uint64_t(std::max<MilliSecond>(0, time_offset)) * (SYSTEM_CLOCK_FREQ / 1000);
+    const auto it = std::upper_bound(_entries.begin(), _entries.end(), target, [](uint64_t pcr, const Entry& e) { return pcr < e.pcr; });
+    packet_index = it == _entries.begin() ? _entries.front().packet : (it - 1)->packet;
+    return true;
+}
@@ -0,0 +1,154 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Sidecar time index for seekable transport stream files.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsTSPacket.h"
+#include "tsUString.h"
+#include "tsReport.h"
+#include <fstream>
+
+namespace ts {
+    //!
+    //! Sidecar time index for seekable transport stream files.
+    //!
+    //! The index is a small binary file, stored next to a recorded transport
+    //! stream file, which maps PCR time stamps to packet indexes in the TS
+    //! file. It is written incrementally while the TS file is recorded and
+    //! is later used to seek to a given play time in one single operation,
+    //! without scanning the TS file from the beginning.
+    //!
+    //! The index file contains an 8-byte header (magic number and format
+    //! version) followed by fixed-size entries. Each entry contains a packet
+    //! index in the TS file and the corresponding PCR value, both as 64-bit
+    //! big-endian integers. The PCR values are "unwrapped": when the PCR
+    //! wraps up (every 26.5 hours), the index values continue to increase,
+    //! so that the entries are always monotonically sorted.
+    //!
+    //! @ingroup mpeg
+    //!
+    class TSDUCKDLL TSFileTimeIndex
+    {
+        TS_NOCOPY(TSFileTimeIndex);
+    public:
+        //!
+        //! Default interval between two index entries, in PCR units (one second).
+        //!
+        static constexpr uint64_t DEFAULT_PCR_INTERVAL = SYSTEM_CLOCK_FREQ;
+
+        //!
+        //! Default constructor.
+        //!
+        TSFileTimeIndex() = default;
+
+        //!
+        //! Destructor.
+        //!
+        ~TSFileTimeIndex();
+
+        //!
+        //! Build the name of the index file for a given TS file.
+        //! @param [in] ts_file_name Name of the transport stream file.
+        //! @return The name of the corresponding index file.
+        //!
+        static UString IndexFileName(const UString& ts_file_name);
+
+        //!
+        //! Create an index file for writing.
+        //! @param [in] ts_file_name Name of the transport stream file being recorded.
+        //! The index file is created next to it, with an additional extension.
+        //! @param [in,out] report Where to report errors.
+        //! @param [in] pcr_interval Minimum difference between the PCR of two
+        //! successive index entries, in PCR units.
+        //! @return True on success, false on error.
+        //!
+        bool createWrite(const UString& ts_file_name, Report& report, uint64_t pcr_interval = DEFAULT_PCR_INTERVAL);
+
+        //!
+        //! Feed one packet of the recorded TS file (writing mode).
+        //! An index entry is added when the packet contains a PCR and the
+        //! previous entry is older than the index interval. Write errors
+        //! are reported by close().
+        //! @param [in] pkt The TS packet.
+        //! @param [in] packet_index Index of this packet in the TS file.
+        //!
+        void feedPacket(const TSPacket& pkt, uint64_t packet_index);
+
+        //!
+        //! Load an existing index file (reading mode).
+        //! @param [in] ts_file_name Name of the recorded transport stream file.
+        //! The index file is searched next to it, with an additional extension.
+        //! @param [in,out] report Where to report errors.
+        //! @return True on success, false on error.
+        //!
+        bool openRead(const UString& ts_file_name, Report& report);
+
+        //!
+        //! Close the index file.
+        //! @param [in,out] report Where to report errors.
+        //! @return True on success, false on error.
+        //!
+        bool close(Report& report);
+
+        //!
+        //! Check if the index is open.
+        //! @return True if the index is open, in reading or writing mode.
+        //!
+        bool isOpen() const { return _read || _write; }
+
+        //!
+        //! Get the number of entries in the index (reading mode).
+        //! @return The number of entries in the index.
+        //!
+        size_t entryCount() const { return _entries.size(); }
+
+        //!
+        //! Get the total duration which is covered by the index (reading mode).
+        //! @return The difference between the first and last indexed PCR, in milliseconds.
+        //!
+        MilliSecond duration() const;
+
+        //!
+        //! Locate the packet index for a given play time (reading mode).
+        //! @param [in] time_offset Play time from the beginning of the recorded
+        //! file, in milliseconds.
+        //! @param [out] packet_index Index in the TS file of the last indexed
+        //! packet at or before the given play time. When @a time_offset is
+        //! beyond the end of the index, return the last indexed packet.
+        //! @return True on success, false when the index is empty.
+        //!
+        bool lookup(MilliSecond time_offset, uint64_t& packet_index) const;
+
+    private:
+        // One entry in the index, in its deserialized form.
+        struct Entry
+        {
+            uint64_t packet;  // Packet index in the TS file.
+            uint64_t pcr;     // Unwrapped PCR value at this packet.
+        };
+
+        // Format of the index file.
+        static constexpr uint32_t MAGIC = 0x54534958;  // "TSIX"
+        static constexpr uint32_t VERSION = 1;
+        static constexpr size_t HEADER_SIZE = 8;
+        static constexpr size_t ENTRY_SIZE = 16;
+
+        bool     _read = false;              // Open in reading mode.
+        bool     _write = false;             // Open in writing mode.
+        uint64_t _pcr_interval = DEFAULT_PCR_INTERVAL;
+        uint64_t _last_raw_pcr = INVALID_PCR;   // Last PCR value seen in the stream.
+        uint64_t _pcr_offset = 0;               // Accumulated PCR wrap-up adjustment.
+        uint64_t _last_indexed_pcr = INVALID_PCR;  // Unwrapped PCR of the last index entry.
+        std::ofstream      _out {};          // Index file in writing mode.
+        std::vector<Entry> _entries {};      // Index content in reading mode.
+    };
+}
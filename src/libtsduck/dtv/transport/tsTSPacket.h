@@ -846,6 +846,51 @@ namespace ts {
         //!
         static bool Locate(const uint8_t* buffer, size_t buffer_size, size_t& start_index, size_t& packet_count);
 
+        //!
+        //! Description of one time stamp which was found by batch extraction.
+        //! @see ExtractPCRs()
+        //! @see ExtractPTSs()
+        //!
+        struct TSDUCKDLL PacketTimestamp
+        {
+            size_t   index;  //!< Index of the packet in the scanned array.
+            PID      pid;    //!< PID of the packet.
+            uint64_t value;  //!< PCR or PTS value, never INVALID_PCR or INVALID_PTS.
+        };
+
+        //!
+        //! A vector of PacketTimestamp.
+        //!
+        typedef std::vector<PacketTimestamp> PacketTimestampVector;
+
+        //!
+        //! This static method extracts all PCR's from an array of contiguous TS packets.
+        //!
+        //! PCR's are sparse: most packets have no adaptation field at all. Scanning a
+        //! large array here is much faster than calling getPCR() on each packet, the
+        //! common no-adaptation-field case is rejected after two byte loads only.
+        //!
+        //! @param [in] packets Address of the first contiguous TS packet to scan.
+        //! @param [in] count Number of TS packets to scan.
+        //! @param [out] pcrs Returned list of all PCR's in the array, with the index
+        //! and PID of the packet which contains each of them, in ascending index order.
+        //!
+        static void ExtractPCRs(const TSPacket* packets, size_t count, PacketTimestampVector& pcrs);
+
+        //!
+        //! This static method extracts all PTS's from an array of contiguous TS packets.
+        //!
+        //! Just like PCR's, PTS's are sparse: they can be present only in packets
+        //! which contain the start of a clear PES header. All other packets are
+        //! rejected after a few byte loads, without parsing the PES header.
+        //!
+        //! @param [in] packets Address of the first contiguous TS packet to scan.
+        //! @param [in] count Number of TS packets to scan.
+        //! @param [out] ptss Returned list of all PTS's in the array, with the index
+        //! and PID of the packet which contains each of them, in ascending index order.
+        //!
+        static void ExtractPTSs(const TSPacket* packets, size_t count, PacketTimestampVector& ptss);
+
         //!
         //! Sanity check routine.
         //! Ensure that the TSPacket structure can
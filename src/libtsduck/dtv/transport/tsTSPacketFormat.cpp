@@ -20,6 +20,7 @@ const ts::Enumeration ts::TSPacketFormatEnum({
     {u"M2TS",       ts::TSPacketFormat::M2TS},
     {u"RS204",      ts::TSPacketFormat::RS204},
     {u"duck",       ts::TSPacketFormat::DUCK},
+    {u"archive",    ts::TSPacketFormat::ARCHIVE},
 });
 
 const ts::Enumeration ts::TSPacketFormatInputEnum({
@@ -28,6 +29,7 @@ const ts::Enumeration ts::TSPacketFormatInputEnum({
     {u"M2TS",       ts::TSPacketFormat::M2TS},
     {u"RS204",      ts::TSPacketFormat::RS204},
     {u"duck",       ts::TSPacketFormat::DUCK},
+    {u"archive",    ts::TSPacketFormat::ARCHIVE},
 });
 
 const ts::Enumeration ts::TSPacketFormatOutputEnum({
@@ -35,6 +37,7 @@ const ts::Enumeration ts::TSPacketFormatOutputEnum({
     {u"M2TS",       ts::TSPacketFormat::M2TS},
     {u"RS204",      ts::TSPacketFormat::RS204},
     {u"duck",       ts::TSPacketFormat::DUCK},
+    {u"archive",    ts::TSPacketFormat::ARCHIVE},
 });
 
 
@@ -27,6 +27,7 @@ namespace ts {
         M2TS,        //!< Bluray compatible, 4-byte timestamp header before each TS packet (30-bit time stamp in PCR units).
         RS204,       //!< 204-byte packet with 16-byte trailing Reed-Solomon (ignored on input, zero place-holder on output).
         DUCK,        //!< Proprietary, 14-byte header before each TS packet (packet metadata).
+        ARCHIVE,     //!< Proprietary storage format, runs of null packets are elided as counts, time stamps are not preserved.
     };
 
     //!
@@ -16,12 +16,15 @@
 
 ts::TSPacketMetadata::TSPacketMetadata() :
     _input_time(INVALID_PCR),
+    _pcr(INVALID_PCR),
     _labels(),
     _time_source(TimeSource::UNDEFINED),
     _flush(false),
     _bitrate_changed(false),
     _input_stuffing(false),
     _nullified(false),
+    _pcr_cached(false),
+    _input_crc_error(false),
     _pad1(0),
     _pad2(0)
 {
@@ -35,11 +38,14 @@ ts::TSPacketMetadata::TSPacketMetadata() :
 void ts::TSPacketMetadata::reset()
 {
     _input_time = INVALID_PCR;
+    _pcr = INVALID_PCR;
     _labels.reset();
     _flush = false;
     _bitrate_changed = false;
     _input_stuffing = false;
     _nullified = false;
+    _pcr_cached = false;
+    _input_crc_error = false;
 }
 
 
@@ -151,6 +157,9 @@ bool ts::TSPacketMetadata::deserialize(const void* bin, size_t size)
     }
 
     _input_time = size >= 9 ? GetUInt64(data + 1) : INVALID_PCR;
+    // The PCR cache is transient and never serialized.
+    _pcr = INVALID_PCR;
+    _pcr_cached = false;
     if (size >= 13) {
         _labels = TSPacketLabelSet(GetUInt32(data + 9));
     }
@@ -183,9 +192,10 @@ void ts::TSPacketMetadata::Copy(TSPacketMetadata* dest, const TSPacketMetadata*
 void ts::TSPacketMetadata::Reset(TSPacketMetadata* dest, size_t count)
 {
     assert(dest != nullptr);
-    for (size_t i = 0; i < count; ++i) {
-        dest[i].reset();
-    }
+    // Fill the array with copies of one default-constructed instance. This is
+    // a plain pattern fill which the compiler vectorizes, unlike a loop of
+    // field-by-field reset() calls.
+    std::fill(dest, dest + count, TSPacketMetadata());
 }
 
 
@@ -231,6 +231,71 @@ namespace ts {
         //!
         UString inputTimeStampString(const UString& none = u"none") const;
 
+        //!
+        //! Check if a cached PCR value was set for the packet.
+        //! @return True if the PCR cache was set, even if the packet carries no PCR.
+        //! @see setPCR()
+        //!
+        bool pcrCached() const { return _pcr_cached; }
+
+        //!
+        //! Check if the cached PCR indicates that the packet carries a PCR.
+        //! @return True if the PCR cache was set and the packet carries a PCR.
+        //! @see setPCR()
+        //!
+        bool hasPCR() const { return _pcr != INVALID_PCR; }
+
+        //!
+        //! Get the cached PCR value of the packet.
+        //! @return The cached PCR value of the packet or INVALID_PCR if the packet
+        //! carries no PCR or if the cache was not set.
+        //! @see setPCR()
+        //!
+        uint64_t getPCR() const { return _pcr; }
+
+        //!
+        //! Set the cached PCR value of the packet.
+        //!
+        //! The PCR cache avoids parsing the adaptation field of the packet again in
+        //! each plugin which needs its PCR. It is typically set once by @c tsp when the
+        //! packet is received from the input plugin and then shared by all timing
+        //! plugins down the chain. A plugin which creates, removes or modifies the PCR
+        //! of a packet shall call setPCR() or clearPCR() to keep the cache consistent
+        //! for the next plugins in the chain. The PCR cache is transient and is not
+        //! serialized with the rest of the metadata.
+        //!
+        //! @param [in] pcr The PCR value of the packet or INVALID_PCR when the packet
+        //! is known to carry no PCR.
+        //!
+        void setPCR(uint64_t pcr) { _pcr = pcr; _pcr_cached = true; }
+
+        //!
+        //! Clear the cached PCR value of the packet.
+        //! The PCR of the packet, if any, becomes unknown to plugins using the cache.
+        //!
+        void clearPCR() { _pcr = INVALID_PCR; _pcr_cached = false; }
+
+        //!
+        //! Specify if a section with a wrong CRC32 ends in this packet.
+        //!
+        //! When input section validation is active (tsp option @c -\-validate-input-crc),
+        //! the CRC32 of the PSI/SI sections of the selected PID's is checked once, in the
+        //! input thread, and the packet in which an invalid section ends is marked using
+        //! this flag. Plugins down the chain can use the result without revalidating the
+        //! same sections. Like the PCR cache, this flag is transient and is not serialized
+        //! with the rest of the metadata.
+        //!
+        //! @param [in] on True when a section with a wrong CRC32 ends in this packet.
+        //!
+        void setInputCRCError(bool on) { _input_crc_error = on; }
+
+        //!
+        //! Check if a section with a wrong CRC32 was detected at input level in this packet.
+        //! @return True when input section validation detected an invalid section ending in this packet.
+        //! @see setInputCRCError()
+        //!
+        bool getInputCRCError() const { return _input_crc_error; }
+
         //!
         //! Copy contiguous TS packet metadata.
         //! @param [out] dest Address of the first contiguous TS packet metadata to write.
@@ -299,15 +364,18 @@ namespace ts {
 
     private:
         uint64_t         _input_time;           // 64 bits: Input timestamp in PCR units, INVALID_PCR if unknown.
+        uint64_t         _pcr;                  // 64 bits: Cached PCR value, INVALID_PCR if absent or not cached.
         TSPacketLabelSet _labels;               // 32 bits: Bit mask of labels.
         TimeSource       _time_source;          // 8 bits: Source for time stamps.
         bool             _flush : 1;            // Flush the packet buffer asap.
         bool             _bitrate_changed : 1;  // Call getBitrate() callback as soon as possible.
         bool             _input_stuffing : 1;   // Packet was artificially inserted as input stuffing.
         bool             _nullified : 1;        // Packet was explicitly turned into a null packet by a plugin.
+        bool             _pcr_cached : 1;       // The PCR cache was set for the packet.
+        bool             _input_crc_error : 1;  // A section with a wrong CRC32 ends in this packet.
         TS_PUSH_WARNING()
         TS_LLVM_NOWARNING(unused-private-field)
-        unsigned int     _pad1 : 4;             // Padding to next byte.
+        unsigned int     _pad1 : 2;             // Padding to next byte.
         unsigned int     _pad2 : 16;            // Padding to next multiple of 4 bytes.
         TS_POP_WARNING()
     };
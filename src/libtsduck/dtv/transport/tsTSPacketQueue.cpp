@@ -7,6 +7,8 @@
 //----------------------------------------------------------------------------
 
 #include "tsTSPacketQueue.h"
+#include "tsMonotonic.h"
+#include "tsProbes.h"
 
 
 //----------------------------------------------------------------------------
@@ -39,6 +41,7 @@ void ts::TSPacketQueue::reset(size_t size)
     _readIndex = 0;
     _writeIndex = 0;
     _bitrate = 0;
+    _stats = Statistics();
 }
 
 
@@ -77,9 +80,17 @@ bool ts::TSPacketQueue::lockWriteBuffer(TSPacket*& buffer, size_t& buffer_size,
     min_size = std::max<size_t>(1, std::min(min_size, max_size));
 
     // Wait until we get enough free space.
-    while (!_stopped && _buffer.size() - _inCount < min_size) {
-        _dequeued.wait(lock);
+    TS_PROBE1(queue_write_wait, min_size);
+    if (!_stopped && _buffer.size() - _inCount < min_size) {
+        // The queue is full, the writer thread experiences backpressure from the reader.
+        const Monotonic start(true);
+        _stats.write_waits++;
+        while (!_stopped && _buffer.size() - _inCount < min_size) {
+            _dequeued.wait(lock);
+        }
+        _stats.write_wait_time += Monotonic(true) - start;
     }
+    TS_PROBE1(queue_write_ready, _buffer.size() - _inCount);
 
     // Return the write window.
     buffer = &_buffer[_writeIndex];
@@ -134,6 +145,10 @@ void ts::TSPacketQueue::releaseWriteBuffer(size_t count)
     _inCount += count;
     _writeIndex = (_writeIndex + count) % _buffer.size();
 
+    // Count enqueued packets and sample the buffer occupancy.
+    _stats.enqueued_packets += count;
+    _stats.occupancy[std::min(OCCUPANCY_BUCKETS - 1, (_inCount * OCCUPANCY_BUCKETS) / _buffer.size())]++;
+
     // Signal that packets have been enqueued
     _enqueued.notify_all();
 }
@@ -221,6 +236,7 @@ bool ts::TSPacketQueue::getPacket(TSPacket& packet, BitRate& bitrate)
         packet = _buffer[_readIndex];
         _readIndex = (_readIndex + 1) % _buffer.size();
         _inCount--;
+        _stats.dequeued_packets++;
 
         // Signal the condition that a packet was freed.
         _dequeued.notify_all();
@@ -241,9 +257,17 @@ bool ts::TSPacketQueue::waitPackets(TSPacket* buffer, size_t buffer_count, size_
 
     // Wait until there is some packet in the buffer.
     std::unique_lock<std::mutex> lock(_mutex);
-    while (!_eof && !_stopped && _inCount == 0) {
-        _enqueued.wait(lock);
+    TS_PROBE1(queue_read_wait, buffer_count);
+    if (!_eof && !_stopped && _inCount == 0) {
+        // The queue is empty, the reader thread is starved by the writer.
+        const Monotonic start(true);
+        _stats.read_waits++;
+        while (!_eof && !_stopped && _inCount == 0) {
+            _enqueued.wait(lock);
+        }
+        _stats.read_wait_time += Monotonic(true) - start;
     }
+    TS_PROBE1(queue_read_ready, _inCount);
 
     // Return as many packets as we can. Ignore eof for now.
     while (_inCount > 0 && buffer_count > 0) {
@@ -256,6 +280,7 @@ bool ts::TSPacketQueue::waitPackets(TSPacket* buffer, size_t buffer_count, size_
 
     // Get bitrate, either from reader thread or from PCR analysis.
     bitrate = getBitrate();
+    _stats.dequeued_packets += actual_count;
 
     // Signal that packets were freed.
     _dequeued.notify_all();
@@ -281,3 +306,33 @@ void ts::TSPacketQueue::stop()
     // a packet but it means that the writer thread should wake up.
     _dequeued.notify_all();
 }
+
+
+//----------------------------------------------------------------------------
+// Get the queue utilization statistics.
+//----------------------------------------------------------------------------
+
+void ts::TSPacketQueue::getStatistics(Statistics& stats) const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    stats = _stats;
+}
+
+
+//----------------------------------------------------------------------------
+// Format a one-line human-readable summary of the queue statistics.
+//----------------------------------------------------------------------------
+
+ts::UString ts::TSPacketQueue::statisticsSummary() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    UString histo;
+    for (size_t i = 0; i < OCCUPANCY_BUCKETS; ++i) {
+        histo.format(u"%s%d", {i == 0 ? u"" : u" ", _stats.occupancy[i]});
+    }
+    return UString::Format(u"packet queue: %'d packets in, %'d out, writer blocked %'d times (%'d ms), reader blocked %'d times (%'d ms), occupancy histogram (deciles): %s",
+                           {_stats.enqueued_packets, _stats.dequeued_packets,
+                            _stats.write_waits, _stats.write_wait_time / NanoSecPerMilliSec,
+                            _stats.read_waits, _stats.read_wait_time / NanoSecPerMilliSec,
+                            histo});
+}
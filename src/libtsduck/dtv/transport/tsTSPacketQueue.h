@@ -14,6 +14,7 @@
 #pragma once
 #include "tsTSPacket.h"
 #include "tsPCRAnalyzer.h"
+#include "tsUString.h"
 
 namespace ts {
     //!
@@ -144,6 +145,42 @@ namespace ts {
         //!
         void stop();
 
+        //!
+        //! Number of buckets in the buffer occupancy histogram.
+        //!
+        static constexpr size_t OCCUPANCY_BUCKETS = 10;
+
+        //!
+        //! Queue utilization statistics.
+        //! All counters are cumulative since the queue was created or last reset.
+        //!
+        class TSDUCKDLL Statistics
+        {
+        public:
+            Statistics() = default;            //!< Constructor.
+            uint64_t   enqueued_packets = 0;   //!< Total number of packets written into the queue.
+            uint64_t   dequeued_packets = 0;   //!< Total number of packets read from the queue.
+            uint64_t   write_waits = 0;        //!< Number of times the writer thread blocked on a full queue (backpressure from the reader).
+            uint64_t   read_waits = 0;         //!< Number of times the reader thread blocked on an empty queue (starvation from the writer).
+            NanoSecond write_wait_time = 0;    //!< Total time the writer thread was blocked.
+            NanoSecond read_wait_time = 0;     //!< Total time the reader thread was blocked.
+            std::array<uint64_t, OCCUPANCY_BUCKETS> occupancy {};  //!< Buffer occupancy histogram, one sample per write operation, bucket @em i for fullness in [i*10%, (i+1)*10%).
+        };
+
+        //!
+        //! Get the queue utilization statistics.
+        //! @param [out] stats Returned statistics.
+        //!
+        void getStatistics(Statistics& stats) const;
+
+        //!
+        //! Format a one-line human-readable summary of the queue statistics.
+        //! Typically displayed in verbose final reports to distinguish input
+        //! starvation from output backpressure.
+        //! @return The formatted summary.
+        //!
+        UString statisticsSummary() const;
+
     private:
         volatile bool     _eof = false;      // The writer thread has reported an end of file.
         volatile bool     _stopped = false;  // The read thread has reported a stop condition.
@@ -156,6 +193,7 @@ namespace ts {
         size_t            _readIndex = 0;    // Index of next packet to read.
         size_t            _writeIndex = 0;   // Index of next packet to write.
         BitRate           _bitrate = 0;      // Bitrate as set by the writer thread.
+        Statistics        _stats {};         // Utilization statistics, protected by _mutex.
 
         // Get bitrate, must be called with mutex held.
         BitRate getBitrate() const;
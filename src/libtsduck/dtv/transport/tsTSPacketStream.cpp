@@ -8,6 +8,19 @@
 
 #include "tsTSPacketStream.h"
 
+namespace {
+    // Description of the ARCHIVE format. The stream is a sequence of variable-size
+    // records: a raw 188-byte TS packet (first byte 0x47) or a 3-byte null-run record
+    // (tag byte, 16-bit count of elided null packets). A zero count identifies the
+    // 188-byte signature block which starts each file. Since the signature block is
+    // parsed as a plain record, rewinding the underlying stream simply works.
+    constexpr uint8_t ARCHIVE_TAG = 0xB5;           // First byte of a null-run record.
+    constexpr uint8_t ARCHIVE_VERSION = 0x01;       // Format version, in the signature block.
+    constexpr size_t  ARCHIVE_RUN_SIZE = 3;         // Size of a null-run record.
+    constexpr size_t  ARCHIVE_MAX_RUN = 0xFFFF;     // Maximum count in one null-run record.
+    constexpr size_t  ARCHIVE_BUFFER_SIZE = 65536;  // Read buffer size.
+}
+
 
 //----------------------------------------------------------------------------
 // Constructors and destructors.
@@ -38,6 +51,8 @@ void ts::TSPacketStream::resetPacketStream(TSPacketFormat format, AbstractReadSt
     _writer = writer;
     _last_timestamp = 0;
     _trail_size = 0;
+    _arch_sig_written = false;
+    resetArchiveState();
 }
 
 
@@ -53,6 +68,7 @@ size_t ts::TSPacketStream::packetHeaderSize() const
         case TSPacketFormat::M2TS:       return 4;
         case TSPacketFormat::RS204:      return 0;
         case TSPacketFormat::DUCK:       return TSPacketMetadata::SERIALIZATION_SIZE;
+        case TSPacketFormat::ARCHIVE:    return 0;
         default:                         return 0;
     }
 }
@@ -65,6 +81,7 @@ size_t ts::TSPacketStream::packetTrailerSize() const
         case TSPacketFormat::M2TS:       return 0;
         case TSPacketFormat::RS204:      return RS_SIZE;
         case TSPacketFormat::DUCK:       return 0;
+        case TSPacketFormat::ARCHIVE:    return 0;
         default:                         return 0;
     }
 }
@@ -115,6 +132,10 @@ size_t ts::TSPacketStream::readPackets(TSPacket *buffer, TSPacketMetadata *metad
             _format = TSPacketFormat::DUCK;
             mdata.deserialize(buffer->b, TSPacketMetadata::SERIALIZATION_SIZE);
         }
+        else if (buffer->b[0] == ARCHIVE_TAG && GetUInt16(buffer->b + 1) == 0 && buffer->b[3] == ARCHIVE_VERSION) {
+            // Signature block of an archive file. It contains no packet, the stream continues with archive records.
+            _format = TSPacketFormat::ARCHIVE;
+        }
         else {
             report.error(u"cannot detect TS file format");
             return 0;
@@ -123,21 +144,23 @@ size_t ts::TSPacketStream::readPackets(TSPacket *buffer, TSPacketMetadata *metad
         // If there was a header, remove it and read the rest of the packet.
         header_size = packetHeaderSize();
         assert(header_size <= sizeof(header));
-        if (header_size > 0) {
-            // memmove() can move overlapping areas.
-            char* data = reinterpret_cast<char*>(buffer);
-            std::memmove(data, data + header_size, PKT_SIZE - header_size);
-            if (!_reader->readStreamComplete(data + PKT_SIZE - header_size, header_size, read_size, report) || read_size < header_size) {
-                return 0; // less than one packet in that file
+        if (_format != TSPacketFormat::ARCHIVE) {
+            if (header_size > 0) {
+                // memmove() can move overlapping areas.
+                char* data = reinterpret_cast<char*>(buffer);
+                std::memmove(data, data + header_size, PKT_SIZE - header_size);
+                if (!_reader->readStreamComplete(data + PKT_SIZE - header_size, header_size, read_size, report) || read_size < header_size) {
+                    return 0; // less than one packet in that file
+                }
             }
-        }
 
-        // Now we have read the first packet.
-        read_packets++;
-        buffer++;
-        max_packets--;
-        if (metadata != nullptr) {
-            *metadata++ = mdata;
+            // Now we have read the first packet.
+            read_packets++;
+            buffer++;
+            max_packets--;
+            if (metadata != nullptr) {
+                *metadata++ = mdata;
+            }
         }
 
         // Check the presence of a 16-byte trailer when the detected format is TS.
@@ -160,8 +183,10 @@ size_t ts::TSPacketStream::readPackets(TSPacket *buffer, TSPacketMetadata *metad
 
     // Repeat reading packets until the buffer is full or error.
     // Rewind on end of file if repeating is set.
+    // In ARCHIVE format, buffered records and elided null packets may remain
+    // to deliver after the reader reached the end of stream.
     bool success = true;
-    while (success && max_packets > 0 && !_reader->endOfStream()) {
+    while (success && max_packets > 0 && (!_reader->endOfStream() || _arch_nulls > 0 || _arch_next < _arch_size)) {
 
         switch (_format) {
             case TSPacketFormat::AUTODETECT: {
@@ -209,6 +234,76 @@ size_t ts::TSPacketStream::readPackets(TSPacket *buffer, TSPacketMetadata *metad
                 }
                 break;
             }
+            case TSPacketFormat::ARCHIVE: {
+                // Variable-size records, bulk-read through an intermediate buffer.
+                if (_arch_buffer.empty()) {
+                    _arch_buffer.resize(ARCHIVE_BUFFER_SIZE);
+                }
+                while (max_packets > 0) {
+                    // Deliver the null packets of the current elided run first.
+                    if (_arch_nulls > 0) {
+                        *buffer++ = NullPacket;
+                        _arch_nulls--;
+                        read_packets++;
+                        max_packets--;
+                        if (metadata != nullptr) {
+                            metadata->reset();
+                            metadata++;
+                        }
+                        continue;
+                    }
+                    // Identify the next record on its first byte.
+                    if (!archiveFill(1, report)) {
+                        break; // end of stream
+                    }
+                    const uint8_t tag = _arch_buffer[_arch_next];
+                    if (tag == SYNC_BYTE) {
+                        // A raw TS packet.
+                        if (!archiveFill(PKT_SIZE, report)) {
+                            report.error(u"truncated TS packet at end of archive stream");
+                            success = false;
+                            break;
+                        }
+                        std::memcpy(buffer->b, _arch_buffer.data() + _arch_next, PKT_SIZE);
+                        _arch_next += PKT_SIZE;
+                        buffer++;
+                        read_packets++;
+                        max_packets--;
+                        if (metadata != nullptr) {
+                            metadata->reset();
+                            metadata++;
+                        }
+                    }
+                    else if (tag == ARCHIVE_TAG) {
+                        if (!archiveFill(ARCHIVE_RUN_SIZE, report)) {
+                            report.error(u"truncated record at end of archive stream");
+                            success = false;
+                            break;
+                        }
+                        const size_t count = GetUInt16(_arch_buffer.data() + _arch_next + 1);
+                        if (count > 0) {
+                            // A run of elided null packets.
+                            _arch_next += ARCHIVE_RUN_SIZE;
+                            _arch_nulls = count;
+                        }
+                        else if (archiveFill(PKT_SIZE, report) && _arch_buffer[_arch_next + 3] == ARCHIVE_VERSION) {
+                            // A signature block, at start of file or after a rewind.
+                            _arch_next += PKT_SIZE;
+                        }
+                        else {
+                            report.error(u"invalid TS archive signature block");
+                            success = false;
+                            break;
+                        }
+                    }
+                    else {
+                        report.error(u"corrupted TS archive stream, invalid record tag 0x%X", {tag});
+                        success = false;
+                        break;
+                    }
+                }
+                break;
+            }
             case TSPacketFormat::M2TS:
             case TSPacketFormat::DUCK: {
                 // Read header + packet. No trailer was read at first packet.
@@ -317,6 +412,50 @@ bool ts::TSPacketStream::writePackets(const TSPacket *buffer, const TSPacketMeta
             }
             break;
         }
+        case TSPacketFormat::ARCHIVE: {
+            // The file starts with a signature block for format auto-detection.
+            size_t written_size = 0;
+            if (!_arch_sig_written) {
+                uint8_t sig[PKT_SIZE];
+                TS_ZERO(sig);
+                sig[0] = ARCHIVE_TAG;
+                sig[3] = ARCHIVE_VERSION;
+                success = _writer->writeStream(sig, PKT_SIZE, written_size, report);
+                _arch_sig_written = success;
+            }
+            // Alternate runs of elided null packets and spans of raw packets.
+            size_t i = 0;
+            while (success && i < packet_count) {
+                if (buffer[i] == NullPacket) {
+                    // Count consecutive canonical null packets, elide them as a count.
+                    size_t run = 1;
+                    while (run < ARCHIVE_MAX_RUN && i + run < packet_count && buffer[i + run] == NullPacket) {
+                        run++;
+                    }
+                    uint8_t record[ARCHIVE_RUN_SIZE];
+                    record[0] = ARCHIVE_TAG;
+                    PutUInt16(record + 1, uint16_t(run));
+                    success = _writer->writeStream(record, ARCHIVE_RUN_SIZE, written_size, report);
+                    if (success) {
+                        _total_write += run;
+                        i += run;
+                    }
+                }
+                else {
+                    // Bulk write the span of packets up to the next null packet.
+                    size_t span = 1;
+                    while (i + span < packet_count && !(buffer[i + span] == NullPacket)) {
+                        span++;
+                    }
+                    success = _writer->writeStream(&buffer[i], span * PKT_SIZE, written_size, report);
+                    if (success) {
+                        _total_write += span;
+                        i += span;
+                    }
+                }
+            }
+            break;
+        }
         default: {
             report.error(u"internal error, invalid TS file format %s", {packetFormatString()});
             return false;
@@ -325,3 +464,29 @@ bool ts::TSPacketStream::writePackets(const TSPacket *buffer, const TSPacketMeta
 
     return success;
 }
+
+
+//----------------------------------------------------------------------------
+// ARCHIVE format: make sure that at least min_size contiguous unparsed bytes
+// are available in the read buffer.
+//----------------------------------------------------------------------------
+
+bool ts::TSPacketStream::archiveFill(size_t min_size, Report& report)
+{
+    assert(min_size <= _arch_buffer.size());
+    if (_arch_size - _arch_next < min_size) {
+        // Move the remaining unparsed bytes at the beginning of the buffer.
+        std::memmove(_arch_buffer.data(), _arch_buffer.data() + _arch_next, _arch_size - _arch_next);
+        _arch_size -= _arch_next;
+        _arch_next = 0;
+        // Refill the buffer. Do not wait for a full buffer, pipes may block.
+        while (_arch_size < min_size) {
+            size_t got = 0;
+            if (!_reader->readStreamPartial(_arch_buffer.data() + _arch_size, _arch_buffer.size() - _arch_size, got, report) || got == 0) {
+                return false;
+            }
+            _arch_size += got;
+        }
+    }
+    return true;
+}
@@ -27,6 +27,16 @@ namespace ts {
     //! Read/write TS packets on a stream.
     //! @ingroup mpeg
     //!
+    //! The ARCHIVE format is a proprietary storage format for long recordings.
+    //! The stream is a sequence of variable-size records: either a raw 188-byte
+    //! TS packet (first byte 0x47) or a 3-byte record which elides a run of
+    //! consecutive null packets as a count. A file starts with a 188-byte
+    //! signature block for format auto-detection. On read, the elided null
+    //! packets are regenerated at their original positions, the stream is
+    //! bit-identical when the null packets are canonical (PID 0x1FFF, 0xFF
+    //! payload); other null packets are stored as raw packets. Since records
+    //! have variable sizes, archive streams are not seekable by packet index.
+    //!
     class TSDUCKDLL TSPacketStream
     {
         TS_NOCOPY(TSPacketStream);
@@ -129,6 +139,16 @@ namespace ts {
         //!
         void resetPacketStream(TSPacketFormat format, AbstractReadStreamInterface* reader, AbstractWriteStreamInterface* writer);
 
+        //!
+        //! Drop the buffered read state of the ARCHIVE format.
+        //! Must be called by subclasses after repositioning the underlying stream.
+        //!
+        void resetArchiveState()
+        {
+            _arch_next = _arch_size = 0;
+            _arch_nulls = 0;
+        }
+
         PacketCounter _total_read = 0;   //!< Total read packets.
         PacketCounter _total_write = 0;  //!< Total written packets.
 
@@ -139,5 +159,14 @@ namespace ts {
         uint64_t _last_timestamp = 0;             // Last write time stamp in PCR units (M2TS files).
         size_t   _trail_size = 0;                 // Number of meaningful bytes in _trail
         uint8_t  _trail[MAX_TRAILER_SIZE+1] {};   // Transient buffer for auto-detection of trailer
+        ByteBlock _arch_buffer {};                // ARCHIVE format: read buffer (records have variable sizes).
+        size_t    _arch_next = 0;                 // ARCHIVE format: index of next unparsed byte in _arch_buffer.
+        size_t    _arch_size = 0;                 // ARCHIVE format: number of valid bytes in _arch_buffer.
+        uint64_t  _arch_nulls = 0;                // ARCHIVE format: remaining null packets in the current elided run.
+        bool      _arch_sig_written = false;      // ARCHIVE format: the output signature block was written.
+
+        // ARCHIVE format: make sure that at least min_size contiguous unparsed bytes
+        // are available in _arch_buffer, refilling it from the reader when necessary.
+        bool archiveFill(size_t min_size, Report& report);
     };
 }
@@ -114,32 +114,47 @@ size_t ts::TSPacketWindow::packetIndexInBuffer(size_t index, const TSPacket* buf
 
 
 //----------------------------------------------------------------------------
-// Same as public get() but returns non-null addresses for dropped packets.
+// Locate the range which contains a given index.
 //----------------------------------------------------------------------------
 
-bool ts::TSPacketWindow::getInternal(size_t index, TSPacket*& pkt, TSPacketMetadata*& mdata) const
+const ts::TSPacketWindow::PacketRange* ts::TSPacketWindow::findRange(size_t index) const
 {
-    if (index < _size) {
-        // Try to reuse last range index for faster sequential index (either ascending or descending).
-        // Special case for restart of sequential access.
-        size_t ri = 0;
-        if (index > 0) {
-            ri = _last_range_index;
+    if (index >= _size) {
+        // Not in the window.
+        return nullptr;
+    }
+
+    // Try to reuse last range index for faster sequential index (either ascending or descending).
+    // Special case for restart of sequential access.
+    size_t ri = 0;
+    if (index > 0) {
+        ri = _last_range_index;
+        assert(ri < _ranges.size());
+        while (index < _ranges[ri].first) {
+            assert(ri > 0);
+            --ri;
+        }
+        while (index >= _ranges[ri].first + _ranges[ri].count) {
+            ++ri;
             assert(ri < _ranges.size());
-            while (index < _ranges[ri].first) {
-                assert(ri > 0);
-                --ri;
-            }
-            while (index >= _ranges[ri].first + _ranges[ri].count) {
-                ++ri;
-                assert(ri < _ranges.size());
-            }
         }
-        // Found the right range.
-        _last_range_index = ri;
-        const PacketRange& ipr(_ranges[ri]);
-        pkt = ipr.packets + (index - ipr.first);
-        mdata = ipr.metadata + (index - ipr.first);
+    }
+    // Found the right range.
+    _last_range_index = ri;
+    return &_ranges[ri];
+}
+
+
+//----------------------------------------------------------------------------
+// Same as public get() but returns non-null addresses for dropped packets.
+//----------------------------------------------------------------------------
+
+bool ts::TSPacketWindow::getInternal(size_t index, TSPacket*& pkt, TSPacketMetadata*& mdata) const
+{
+    const PacketRange* const ipr = findRange(index);
+    if (ipr != nullptr) {
+        pkt = ipr->packets + (index - ipr->first);
+        mdata = ipr->metadata + (index - ipr->first);
         // Check that the packet was not "dropped".
         return pkt->b[0] == SYNC_BYTE;
     }
@@ -151,6 +166,25 @@ bool ts::TSPacketWindow::getInternal(size_t index, TSPacket*& pkt, TSPacketMetad
 }
 
 
+//----------------------------------------------------------------------------
+// Get the address of a contiguous range of packets inside the window.
+//----------------------------------------------------------------------------
+
+size_t ts::TSPacketWindow::getRange(size_t index, TSPacket*& pkt, TSPacketMetadata*& mdata, size_t max_count) const
+{
+    const PacketRange* const ipr = findRange(index);
+    if (ipr == nullptr) {
+        pkt = nullptr;
+        mdata = nullptr;
+        return 0;
+    }
+    const size_t offset = index - ipr->first;
+    pkt = ipr->packets + offset;
+    mdata = ipr->metadata + offset;
+    return std::min(max_count, ipr->count - offset);
+}
+
+
 //----------------------------------------------------------------------------
 // Nullify the packet at the corresponding index.
 //----------------------------------------------------------------------------
@@ -166,6 +200,33 @@ void ts::TSPacketWindow::nullify(size_t index)
 }
 
 
+//----------------------------------------------------------------------------
+// Nullify a contiguous range of packets.
+//----------------------------------------------------------------------------
+
+void ts::TSPacketWindow::nullifyRange(size_t index, size_t count)
+{
+    while (count > 0) {
+        TSPacket* pkt = nullptr;
+        TSPacketMetadata* mdata = nullptr;
+        const size_t range_size = getRange(index, pkt, mdata, count);
+        if (range_size == 0) {
+            // Out of window.
+            return;
+        }
+        for (size_t i = 0; i < range_size; ++i) {
+            // Skip dropped packets, count nullified packets once only.
+            if (pkt[i].b[0] == SYNC_BYTE && pkt[i].getPID() != PID_NULL) {
+                _nullify_count++;
+                pkt[i] = NullPacket;
+            }
+        }
+        index += range_size;
+        count -= range_size;
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Drop the packet at the corresponding index.
 //----------------------------------------------------------------------------
@@ -89,6 +89,22 @@ namespace ts {
         //!
         bool get(size_t index, TSPacket*& packet, TSPacketMetadata*& metadata) const;
 
+        //!
+        //! Get the address of a contiguous range of packets and metadata inside the window.
+        //! This is the bulk version of get(). Instead of resolving one index at a time,
+        //! it returns the contiguous arrays of packets and metadata which start at @a index,
+        //! allowing the caller to iterate cache-linearly inside each physical segment.
+        //! @param [in] index Index of the first packet of the range, from 0 to size()-1.
+        //! @param [out] packet The address of the packet at @a index.
+        //! @param [out] metadata The address of the corresponding packet metadata.
+        //! @param [in] max_count Maximum number of packets in the returned range.
+        //! @return The number of contiguous packets starting at @a index, up to @a max_count.
+        //! Return zero if @a index is out of range (@a packet and @a metadata are null in that case).
+        //! Unlike get(), dropped packets are included in the returned range; they are
+        //! identified by a zeroed sync byte in the packet.
+        //!
+        size_t getRange(size_t index, TSPacket*& packet, TSPacketMetadata*& metadata, size_t max_count = NPOS) const;
+
         //!
         //! Get the physical index of a packet inside a buffer.
         //! @param [in] index Index of the packet inside the window, from 0 to size()-1.
@@ -104,6 +120,15 @@ namespace ts {
         //!
         void nullify(size_t index);
 
+        //!
+        //! Nullify a contiguous range of packets.
+        //! This is the bulk version of nullify(). The packets are nullified segment by
+        //! segment, without one index lookup per packet. Dropped packets are left untouched.
+        //! @param [in] index Index of the first packet to nullify, from 0 to size()-1.
+        //! @param [in] count Number of packets to nullify. The range is clipped to the end of the window.
+        //!
+        void nullifyRange(size_t index, size_t count);
+
         //!
         //! Drop the packet at the corresponding index.
         //! Internally, the sync byte of the packet in the buffer is zeroed and the packet is no longer usable.
@@ -145,6 +170,9 @@ namespace ts {
         // Same as public get() but returns non-null addresses for dropped packets.
         bool getInternal(size_t index, TSPacket*& packet, TSPacketMetadata*& metadata) const;
 
+        // Locate the range which contains a given index. Return null if out of window.
+        const PacketRange* findRange(size_t index) const;
+
         size_t                   _size = 0;              // Number of packets in the window.
         size_t                   _nullify_count = 0;     // Number of nullified packets.
         size_t                   _drop_count = 0;        // Number of dropped packets.
@@ -29,6 +29,7 @@ namespace ts {
         PCR,            //!< PCR (Program Clock Reference), the transport stream system clock.
         DTS,            //!< DTS (Decoding Time Stamp), in a video or audio stream.
         PTS,            //!< PTS (Presentation Time Stamp), in a video or audio stream.
+        DEKTEC,         //!< Arrival time on a Dektec device, based on the on-board FIFO state.
     };
 
     //!
@@ -35,6 +35,7 @@
 #define JCN_CLASS  "java/lang/Class"
 #define JCN_OBJECT "java/lang/Object"
 #define JCN_STRING "java/lang/String"
+#define JCN_BYTE_BUFFER "java/nio/ByteBuffer"
 #define JCN_PLUGIN_EVENT_CONTEXT "io/tsduck/PluginEventContext"
 
 //
@@ -15,7 +15,8 @@
 // Constructors and destructors.
 //----------------------------------------------------------------------------
 
-ts::jni::PluginEventHandler::PluginEventHandler(JNIEnv* env, jobject obj, jstring handle_method) :
+ts::jni::PluginEventHandler::PluginEventHandler(JNIEnv* env, jobject obj, jstring handle_method, bool direct) :
+    _direct(direct),
     _env(env)
 {
     if (env != nullptr && obj != nullptr) {
@@ -24,7 +25,11 @@ ts::jni::PluginEventHandler::PluginEventHandler(JNIEnv* env, jobject obj, jstrin
         // Cache the method id of the handler method in the io.tsduck.PluginEventContext class.
         if (handle_str != nullptr) {
             // Expected profile: boolean handlePluginEvent(PluginEventContext context, byte[] data);
-            _obj_method = env->GetMethodID(env->GetObjectClass(_obj_ref), handle_str, "(" JCS(JCN_PLUGIN_EVENT_CONTEXT) JCS_ARRAY(JCS_BYTE) ")" JCS_BOOLEAN);
+            // or, in direct mode: boolean handlePluginEvent(PluginEventContext context, ByteBuffer data);
+            const char* const profile = _direct ?
+                "(" JCS(JCN_PLUGIN_EVENT_CONTEXT) JCS(JCN_BYTE_BUFFER) ")" JCS_BOOLEAN :
+                "(" JCS(JCN_PLUGIN_EVENT_CONTEXT) JCS_ARRAY(JCS_BYTE) ")" JCS_BOOLEAN;
+            _obj_method = env->GetMethodID(env->GetObjectClass(_obj_ref), handle_str, profile);
             env->ReleaseStringUTFChars(handle_method, handle_str);
         }
         // Get a global reference to class io.tsduck.PluginEventContext.
@@ -87,10 +92,22 @@ void ts::jni::PluginEventHandler::handlePluginEvent(const PluginEventContext& co
                                            jboolean(read_only_data),
                                            jint(max_data_size));
 
-        // Build a Java bytes[] containing the plugin data.
-        const jbyteArray jdata = env->NewByteArray(data_size);
-        if (jdata != nullptr && valid_data && data_size > 0) {
-            env->SetByteArrayRegion(jdata, 0, data_size, reinterpret_cast<const jbyte*>(event_data->data()));
+        // Build the data object for the Java handler. In direct mode, this is a
+        // ByteBuffer view over the plugin buffer, without copy, valid only for
+        // the duration of the call. Otherwise, this is a copied byte[].
+        jobject jdata = nullptr;
+        if (_direct) {
+            // NewDirectByteBuffer() needs a valid address, even with a zero capacity.
+            static uint8_t dummy = 0;
+            void* const addr = valid_data && data_size > 0 ? const_cast<void*>(reinterpret_cast<const void*>(event_data->data())) : &dummy;
+            jdata = env->NewDirectByteBuffer(addr, jlong(data_size));
+        }
+        else {
+            const jbyteArray jarray = env->NewByteArray(data_size);
+            if (jarray != nullptr && valid_data && data_size > 0) {
+                env->SetByteArrayRegion(jarray, 0, data_size, reinterpret_cast<const jbyte*>(event_data->data()));
+            }
+            jdata = jarray;
         }
 
         // Call the Java event handler.
@@ -160,4 +177,32 @@ TSDUCKJNI void JNICALL Java_io_tsduck_AbstractPluginEventHandler_delete(JNIEnv*
     }
 }
 
+//----------------------------------------------------------------------------
+// Implementation of native methods of Java class io.tsduck.AbstractDirectPluginEventHandler
+//----------------------------------------------------------------------------
+
+//
+// private native void initNativeObject(String methodName);
+//
+TSDUCKJNI void JNICALL Java_io_tsduck_AbstractDirectPluginEventHandler_initNativeObject(JNIEnv* env, jobject obj, jstring method)
+{
+    // Make sure we do not allocate twice (and lose previous instance).
+    ts::jni::PluginEventHandler* handler = ts::jni::GetPointerField<ts::jni::PluginEventHandler>(env, obj, "nativeObject");
+    if (env != nullptr && handler == nullptr) {
+        ts::jni::SetPointerField(env, obj, "nativeObject", new ts::jni::PluginEventHandler(env, obj, method, true));
+    }
+}
+
+//
+// public native void delete();
+//
+TSDUCKJNI void JNICALL Java_io_tsduck_AbstractDirectPluginEventHandler_delete(JNIEnv* env, jobject obj)
+{
+    ts::jni::PluginEventHandler* handler = ts::jni::GetPointerField<ts::jni::PluginEventHandler>(env, obj, "nativeObject");
+    if (handler != nullptr) {
+        delete handler;
+        ts::jni::SetLongField(env, obj, "nativeObject", 0);
+    }
+}
+
 #endif // TS_NO_JAVA
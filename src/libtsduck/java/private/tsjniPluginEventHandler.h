@@ -37,8 +37,15 @@ namespace ts {
             //! @code
             //! boolean handlePluginEvent(PluginEventContext context, byte[] data);
             //! @endcode
+            //! @param [in] direct When true, the event data are passed to the Java method as a
+            //! direct ByteBuffer over the plugin buffer, without intermediate copy, and the Java
+            //! profile of the method shall be
+            //! @code
+            //! boolean handlePluginEvent(PluginEventContext context, ByteBuffer data);
+            //! @endcode
+            //! The buffer is valid only for the duration of the call.
             //!
-            PluginEventHandler(JNIEnv* env, jobject obj, jstring handle_method);
+            PluginEventHandler(JNIEnv* env, jobject obj, jstring handle_method, bool direct = false);
 
             //!
             //! Destructor.
@@ -51,6 +58,7 @@ namespace ts {
             virtual void handlePluginEvent(const PluginEventContext& context) override;
 
             bool      _valid = false;              // If true, all JNI references are valid.
+            bool      _direct = false;             // Pass event data as a direct ByteBuffer, without copy.
             JNIEnv*   _env = nullptr;              // JNI environment in the thread which called the constructor.
             jobject   _obj_ref = nullptr;          // Global JNI reference to the Java object to notify.
             jmethodID _obj_method = nullptr;       // Method to handle events in the Java object.
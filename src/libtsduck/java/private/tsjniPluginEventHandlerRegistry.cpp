@@ -51,4 +51,40 @@ TSDUCKJNI void JNICALL Java_io_tsduck_PluginEventHandlerRegistry_registerOutputE
     }
 }
 
+//
+// public native void registerDirectEventHandler(AbstractDirectPluginEventHandler handler, int eventCode);
+//
+TSDUCKJNI void JNICALL Java_io_tsduck_PluginEventHandlerRegistry_registerDirectEventHandler(JNIEnv* env, jobject obj, jobject jhandler, jint eventCode)
+{
+    ts::PluginEventHandlerRegistry* tsp = ts::jni::GetPointerField<ts::PluginEventHandlerRegistry>(env, obj, "nativeObject");
+    ts::PluginEventHandlerInterface* handler = ts::jni::GetPointerField<ts::PluginEventHandlerInterface>(env, jhandler, "nativeObject");
+    if (tsp != nullptr && handler != nullptr) {
+        tsp->registerEventHandler(handler, uint32_t(eventCode));
+    }
+}
+
+//
+// public native void registerDirectInputEventHandler(AbstractDirectPluginEventHandler handler);
+//
+TSDUCKJNI void JNICALL Java_io_tsduck_PluginEventHandlerRegistry_registerDirectInputEventHandler(JNIEnv* env, jobject obj, jobject jhandler)
+{
+    ts::PluginEventHandlerRegistry* tsp = ts::jni::GetPointerField<ts::PluginEventHandlerRegistry>(env, obj, "nativeObject");
+    ts::PluginEventHandlerInterface* handler = ts::jni::GetPointerField<ts::PluginEventHandlerInterface>(env, jhandler, "nativeObject");
+    if (tsp != nullptr && handler != nullptr) {
+        tsp->registerEventHandler(handler, ts::PluginType::INPUT);
+    }
+}
+
+//
+// public native void registerDirectOutputEventHandler(AbstractDirectPluginEventHandler handler);
+//
+TSDUCKJNI void JNICALL Java_io_tsduck_PluginEventHandlerRegistry_registerDirectOutputEventHandler(JNIEnv* env, jobject obj, jobject jhandler)
+{
+    ts::PluginEventHandlerRegistry* tsp = ts::jni::GetPointerField<ts::PluginEventHandlerRegistry>(env, obj, "nativeObject");
+    ts::PluginEventHandlerInterface* handler = ts::jni::GetPointerField<ts::PluginEventHandlerInterface>(env, jhandler, "nativeObject");
+    if (tsp != nullptr && handler != nullptr) {
+        tsp->registerEventHandler(handler, ts::PluginType::OUTPUT);
+    }
+}
+
 #endif // TS_NO_JAVA
@@ -0,0 +1,59 @@
+//----------------------------------------------------------------------------
+//
+//  TSDuck - The MPEG Transport Stream Toolkit
+//  Copyright (c) 2005-2023, Thierry Lelegard
+//  BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+package io.tsduck;
+
+import java.nio.ByteBuffer;
+
+/**
+ * An abstract class which can be derived by applications to get plugin events
+ * without copying the event data.
+ *
+ * Unlike AbstractPluginEventHandler, the event data are passed as a direct
+ * ByteBuffer over the native buffer of the plugin, without intermediate copy.
+ * This is the preferred form for high-bitrate consumers which process large
+ * batches of TS packets per event, typically with the @e memory plugins.
+ * @ingroup java
+ */
+public abstract class AbstractDirectPluginEventHandler extends NativeObject {
+
+    /*
+     * Set the address of the C++ object.
+     */
+    private native void initNativeObject(String handlerMethodName);
+
+    /**
+     * Constructor (for subclasses).
+     */
+    protected AbstractDirectPluginEventHandler() {
+        initNativeObject("handlePluginEvent");
+    }
+
+    /**
+     * Delete the encapsulated C++ object.
+     */
+    @Override
+    public native void delete();
+
+    /**
+     * This handler is invoked when a plugin signals an event for which this object is registered.
+     * The application should override it to collect the event.
+     *
+     * The associated input event data is passed in @a data, a direct ByteBuffer over the native
+     * buffer of the plugin. No copy is performed: the buffer is valid only for the duration of
+     * this call and shall not be kept or modified by the handler. Keep a copy if the data must
+     * survive the call. If @a context.readOnlyData() is false, updated data, if any, should be
+     * set by the handler using @a context.setOutputData(), just like with
+     * AbstractPluginEventHandler.
+     *
+     * @param context An instance of PluginEventContext containing the details of the event.
+     * @param data A direct ByteBuffer over the data of the event, valid only during this call.
+     * @return True in case of success, false to set the error indicator of the event.
+     */
+    abstract public boolean handlePluginEvent(PluginEventContext context, ByteBuffer data);
+}
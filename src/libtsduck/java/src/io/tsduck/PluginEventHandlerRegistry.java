@@ -32,4 +32,23 @@ public abstract class PluginEventHandlerRegistry extends NativeObject {
      * @param handler An instance of AbstractPluginEventHandler.
      */
     public native void registerOutputEventHandler(AbstractPluginEventHandler handler);
+
+    /**
+     * Register a zero-copy event handler by event code.
+     * @param handler An instance of AbstractDirectPluginEventHandler.
+     * @param eventCode The code of the events to handle.
+     */
+    public native void registerDirectEventHandler(AbstractDirectPluginEventHandler handler, int eventCode);
+
+    /**
+     * Register a zero-copy event handler for all events from the input plugin.
+     * @param handler An instance of AbstractDirectPluginEventHandler.
+     */
+    public native void registerDirectInputEventHandler(AbstractDirectPluginEventHandler handler);
+
+    /**
+     * Register a zero-copy event handler for all events from the output plugin.
+     * @param handler An instance of AbstractDirectPluginEventHandler.
+     */
+    public native void registerDirectOutputEventHandler(AbstractDirectPluginEventHandler handler);
 }
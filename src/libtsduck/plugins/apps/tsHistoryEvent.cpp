@@ -0,0 +1,141 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsHistoryEvent.h"
+#include "tsMemory.h"
+#include "tsNames.h"
+
+
+//----------------------------------------------------------------------------
+// Magic string at the beginning of a binary history file.
+//----------------------------------------------------------------------------
+
+const uint8_t* ts::HistoryEvent::FileMagic()
+{
+    static const uint8_t magic[MAGIC_SIZE] = {'T', 'S', 'H', 'I', 'S', 'T'};
+    return magic;
+}
+
+
+//----------------------------------------------------------------------------
+// Serialize the event as one binary record.
+//----------------------------------------------------------------------------
+
+void ts::HistoryEvent::serialize(uint8_t* buffer) const
+{
+    PutUInt64(buffer, timestamp);
+    PutUInt8(buffer + 8, uint8_t(type));
+    PutUInt8(buffer + 9, tid);
+    PutUInt8(buffer + 10, version);
+    PutUInt8(buffer + 11, aux);
+    PutUInt16(buffer + 12, pid);
+    PutUInt16(buffer + 14, ext);
+    PutUInt64(buffer + 16, uint64_t(time - Time::Epoch));
+}
+
+
+//----------------------------------------------------------------------------
+// Deserialize the event from one binary record.
+//----------------------------------------------------------------------------
+
+bool ts::HistoryEvent::deserialize(const uint8_t* buffer)
+{
+    const uint8_t etype = GetUInt8(buffer + 8);
+    if (etype > EIT_SECTION) {
+        return false;
+    }
+    timestamp = GetUInt64(buffer);
+    type = EventType(etype);
+    tid = GetUInt8(buffer + 9);
+    version = GetUInt8(buffer + 10);
+    aux = GetUInt8(buffer + 11);
+    pid = PID(GetUInt16(buffer + 12));
+    ext = GetUInt16(buffer + 14);
+    time = Time::Epoch + MilliSecond(GetUInt64(buffer + 16));
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Format the event as the text line which the history plugin logs.
+//----------------------------------------------------------------------------
+
+ts::UString ts::HistoryEvent::toString(const DuckContext& duck) const
+{
+    switch (type) {
+        case PID_FIRST: {
+            return UString::Format(u"PID %d (0x%<X) first packet, %s", {pid, aux ? u"scrambled" : u"clear"});
+        }
+        case PID_LAST: {
+            return UString::Format(u"PID %d (0x%<X) last packet, %s", {pid, aux ? u"scrambled" : u"clear"});
+        }
+        case PID_SUSPENDED: {
+            return UString::Format(u"PID %d (0x%<X) suspended, %s, service 0x%X", {pid, aux ? u"scrambled" : u"clear", ext});
+        }
+        case PID_RESTARTED: {
+            return UString::Format(u"PID %d (0x%<X) restarted, %s, service 0x%04X", {pid, aux ? u"scrambled" : u"clear", ext});
+        }
+        case CLEAR_TO_SCRAMBLED: {
+            return UString::Format(u"PID %d (0x%<X), clear to scrambled transition, %s key, service 0x%X", {pid, NameFromDTV(u"ts.scrambling_control", aux), ext});
+        }
+        case SCRAMBLED_TO_CLEAR: {
+            return UString::Format(u"PID %d (0x%<X), scrambled to clear transition, service 0x%X", {pid, ext});
+        }
+        case CRYPTO_PERIOD: {
+            return UString::Format(u"PID %d (0x%<X), new crypto-period, %s key, service 0x%X", {pid, NameFromDTV(u"ts.scrambling_control", aux), ext});
+        }
+        case PES_STREAM_ID: {
+            return UString::Format(u"PID %d (0x%<X), PES stream_id is %s", {pid, NameFromDTV(u"pes.stream_id", aux, NamesFlags::FIRST)});
+        }
+        case PES_STREAM_ID_CHANGE: {
+            return UString::Format(u"PID %d (0x%<X), PES stream_id modified from 0x%X to %s", {pid, version, NameFromDTV(u"pes.stream_id", aux, NamesFlags::FIRST)});
+        }
+        case TDT_TIME: {
+            return UString::Format(u"TDT: %s UTC", {time.format(Time::DATETIME)});
+        }
+        case TOT_TIME_UTC: {
+            return UString::Format(u"TOT: %s UTC", {time.format(Time::DATETIME)});
+        }
+        case TOT_TIME_LOCAL: {
+            return UString::Format(u"TOT: %s LOCAL", {time.format(Time::DATETIME)});
+        }
+        case TABLE_LONG: {
+            switch (tid) {
+                case TID_PAT:
+                    return UString::Format(u"PAT v%d, TS 0x%X", {version, ext});
+                case TID_PMT:
+                    return UString::Format(u"PMT v%d, service 0x%X", {version, ext});
+                case TID_NIT_ACT:
+                case TID_NIT_OTH:
+                    return UString::Format(u"%s v%d, network 0x%X", {names::TID(duck, tid), version, ext});
+                case TID_SDT_ACT:
+                case TID_SDT_OTH:
+                    return UString::Format(u"%s v%d, TS 0x%X", {names::TID(duck, tid), version, ext});
+                case TID_BAT:
+                    return UString::Format(u"BAT v%d, bouquet 0x%X", {version, ext});
+                case TID_CAT:
+                case TID_TSDT:
+                    return UString::Format(u"%s v%d", {names::TID(duck, tid), version});
+                default:
+                    return UString::Format(u"%s v%d, TIDext 0x%X", {names::TID(duck, tid), version, ext});
+            }
+        }
+        case TABLE_SHORT: {
+            return UString::Format(u"%s", {names::TID(duck, tid)});
+        }
+        case NEW_ECM: {
+            return UString::Format(u"PID %d (0x%X), service 0x%X, new ECM 0x%X", {pid, pid, ext, tid});
+        }
+        case EIT_SECTION: {
+            return UString::Format(u"%s v%d, service 0x%X", {names::TID(duck, tid), version, ext});
+        }
+        default: {
+            return UString();
+        }
+    }
+}
@@ -0,0 +1,113 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Binary event record for the history plugin and the tshistory utility.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsDuckContext.h"
+#include "tsTime.h"
+#include "tsTS.h"
+
+namespace ts {
+    //!
+    //! One event record in a binary history file.
+    //! @ingroup plugin
+    //!
+    //! The plugin "history" can log the signalization events in a compact
+    //! binary form instead of formatted text. Each event is one fixed-size
+    //! record, the formatting is deferred to the offline utility tshistory
+    //! which reconstructs the same text lines.
+    //!
+    //! A binary history file starts with an 8-byte header: the 6-byte magic
+    //! "TSHIST", one format version byte and one flags byte. The rest of the
+    //! file is a sequence of RECORD_SIZE-byte records.
+    //!
+    class TSDUCKDLL HistoryEvent
+    {
+    public:
+        //!
+        //! Type of an event in a binary history file.
+        //! The enum values are stored in files, do not renumber them.
+        //!
+        enum EventType : uint8_t {
+            PID_FIRST            = 0,   //!< First packet of a PID.
+            PID_LAST             = 1,   //!< Last packet of a PID.
+            PID_SUSPENDED        = 2,   //!< PID suspended (no packet for a long time).
+            PID_RESTARTED        = 3,   //!< PID restarted after suspension.
+            CLEAR_TO_SCRAMBLED   = 4,   //!< Clear to scrambled transition.
+            SCRAMBLED_TO_CLEAR   = 5,   //!< Scrambled to clear transition.
+            CRYPTO_PERIOD        = 6,   //!< New crypto-period (scrambling control change).
+            PES_STREAM_ID        = 7,   //!< First PES stream id in a PID.
+            PES_STREAM_ID_CHANGE = 8,   //!< PES stream id modified in a PID.
+            TDT_TIME             = 9,   //!< TDT time (UTC).
+            TOT_TIME_UTC         = 10,  //!< TOT time without region (UTC).
+            TOT_TIME_LOCAL       = 11,  //!< TOT time of first region (local time).
+            TABLE_LONG           = 12,  //!< New version of a long table.
+            TABLE_SHORT          = 13,  //!< Occurrence of a short table.
+            NEW_ECM              = 14,  //!< New ECM on a PID.
+            EIT_SECTION          = 15,  //!< EIT section.
+        };
+
+        static constexpr size_t HEADER_SIZE = 8;        //!< Size in bytes of a binary history file header.
+        static constexpr size_t MAGIC_SIZE = 6;         //!< Size in bytes of the magic string in the header.
+        static constexpr uint8_t FILE_VERSION = 1;      //!< Current format version byte in the header.
+        static constexpr uint8_t FLAG_MILLISECOND = 0x01; //!< Header flag: timestamps are milliseconds, not packet indexes.
+        static constexpr size_t RECORD_SIZE = 24;       //!< Size in bytes of one serialized event record.
+
+        //!
+        //! Magic string at the beginning of a binary history file (MAGIC_SIZE bytes).
+        //! @return Address of the magic string.
+        //!
+        static const uint8_t* FileMagic();
+
+        // Event fields, directly accessible.
+        uint64_t  timestamp = 0;         //!< Packet index or milliseconds from start of stream.
+        EventType type = PID_FIRST;      //!< Type of the event.
+        TID       tid = TID_NULL;        //!< Table id, for table and section events.
+        uint8_t   version = 0;           //!< Table version or previous PES stream id.
+        uint8_t   aux = 0;               //!< Scrambling control value or PES stream id.
+        PID       pid = PID_NULL;        //!< PID of the event.
+        uint16_t  ext = 0;               //!< Service id or table id extension.
+        Time      time {};               //!< UTC or local time, for time events.
+
+        //!
+        //! Default constructor.
+        //!
+        HistoryEvent() = default;
+
+        //!
+        //! Constructor with an event type.
+        //! @param [in] etype Type of the event.
+        //!
+        HistoryEvent(EventType etype) : type(etype) {}
+
+        //!
+        //! Serialize the event as one binary record.
+        //! @param [out] buffer Address of a RECORD_SIZE-byte buffer.
+        //!
+        void serialize(uint8_t* buffer) const;
+
+        //!
+        //! Deserialize the event from one binary record.
+        //! @param [in] buffer Address of a RECORD_SIZE-byte buffer.
+        //! @return True on success, false on invalid record.
+        //!
+        bool deserialize(const uint8_t* buffer);
+
+        //!
+        //! Format the event as the text line which the history plugin logs.
+        //! The timestamp prefix is not included.
+        //! @param [in] duck TSDuck execution context, for table and value names.
+        //! @return The formatted event.
+        //!
+        UString toString(const DuckContext& duck) const;
+    };
+}
@@ -127,6 +127,8 @@ void ts::InputSwitcherArgs::defineArgs(Args& args)
     args.option(u"max-output-packets", 0, Args::POSITIVE);
     args.help(u"max-output-packets",
               u"Specify the maximum number of TS packets to write at a time. "
+              u"This value may impact the switch response time: an input switch "
+              u"waits for the completion of the output operation in progress. "
               u"The default is " + UString::Decimal(DEFAULT_MAX_OUTPUT_PACKETS) + u" packets.");
 
     args.option(u"primary-input", 'p', Args::UNSIGNED);
@@ -158,6 +160,16 @@ void ts::InputSwitcherArgs::defineArgs(Args& args)
               u"If an optional address is specified, it must be a local IP address of the system. "
               u"By default, there is no remote control.");
 
+    args.option(u"standby-buffer-packets", 0, Args::POSITIVE);
+    args.help(u"standby-buffer-packets",
+              u"With --fast-switch, specify the maximum number of TS packets which are "
+              u"buffered by the input plugins other than the current one. Older packets "
+              u"are dropped to keep the most recent ones only, so that the output resumes "
+              u"close to live data after a switch. "
+              u"By default, non-current inputs fill their complete buffer, as set by "
+              u"--buffer-packets, before dropping packets. "
+              u"The actual value is never less than --max-input-packets.");
+
     args.option(u"terminate", 't');
     args.help(u"terminate", u"Terminate execution when the current input plugin terminates.");
 
@@ -181,6 +193,13 @@ bool ts::InputSwitcherArgs::loadArgs(DuckContext& duck, Args& args)
     args.getIntValue(bufferedPackets, u"buffer-packets", DEFAULT_BUFFERED_PACKETS);
     maxInputPackets = std::min(args.intValue<size_t>(u"max-input-packets", DEFAULT_MAX_INPUT_PACKETS), bufferedPackets / 2);
     args.getIntValue(maxOutputPackets, u"max-output-packets", DEFAULT_MAX_OUTPUT_PACKETS);
+    args.getIntValue(standbyPackets, u"standby-buffer-packets", 0);
+    if (standbyPackets > 0) {
+        if (!fastSwitch) {
+            args.error(u"--standby-buffer-packets requires --fast-switch");
+        }
+        standbyPackets = std::max(standbyPackets, maxInputPackets);
+    }
     args.getSocketValue(remoteServer, u"remote");
     reusePort = !args.present(u"no-reuse-port");
     args.getIntValue(sockBuffer, u"udp-buffer-size");
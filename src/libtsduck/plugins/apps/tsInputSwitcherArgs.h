@@ -38,6 +38,7 @@ namespace ts {
         size_t              bufferedPackets = 0;   //!< Input buffer size in packets.
         size_t              maxInputPackets = 0;   //!< Maximum input packets to read at a time.
         size_t              maxOutputPackets = 0;  //!< Maximum output packets to send at a time.
+        size_t              standbyPackets = 0;    //!< With fastSwitch, maximum packets buffered by non-current inputs (0 = full buffer).
         UString             eventCommand {};       //!< External shell command to run on an event.
         IPv4SocketAddress   eventUDP {};           //!< Remote UDP socket address for event description.
         IPv4Address         eventLocalAddress {};  //!< Outgoing local interface for UDP event description.
@@ -8,6 +8,7 @@
 
 #include "tsLatencyMonitor.h"
 #include "tstslatencymonitorInputExecutor.h"
+#include "tstslatencymonitorDatagramMux.h"
 
 
 //----------------------------------------------------------------------------
@@ -32,10 +33,17 @@ ts::LatencyMonitor::LatencyMonitor(const LatencyMonitorArgs& args, Report& repor
     // Clear errors on the report, used to check further initialisation errors.
     _report.resetErrors();
 
-    // Get all input plugin options.
-    for (size_t i = 0; i < _args.inputs.size(); ++i) {
-        auto inputExecutor = std::make_shared<tslatencymonitor::InputExecutor>(_args, i, *this, _report);
-        _inputs.push_back(InputData{inputExecutor, {}});
+    // Get all input plugin options. With --event-driven, all inputs are
+    // multiplexed in one thread, there is no input executor.
+    if (_args.eventDriven) {
+        _mux = std::make_shared<tslatencymonitor::DatagramMux>(_args, *this, _report);
+        _inputs.resize(_args.inputs.size());
+    }
+    else {
+        for (size_t i = 0; i < _args.inputs.size(); ++i) {
+            auto inputExecutor = std::make_shared<tslatencymonitor::InputExecutor>(_args, i, *this, _report);
+            _inputs.push_back(InputData{inputExecutor, {}});
+        }
     }
 
     // Init last output time
@@ -50,9 +58,11 @@ ts::LatencyMonitor::LatencyMonitor(const LatencyMonitorArgs& args, Report& repor
 bool ts::LatencyMonitor::start()
 {
     // Get all input plugin options.
-    for (size_t i = 0; i < _inputs.size(); ++i) {
-        if (!_inputs[i].inputExecutor -> plugin()->getOptions()) {
-            return false;
+    if (!_args.eventDriven) {
+        for (size_t i = 0; i < _inputs.size(); ++i) {
+            if (!_inputs[i].inputExecutor -> plugin()->getOptions()) {
+                return false;
+            }
         }
     }
 
@@ -71,7 +81,15 @@ bool ts::LatencyMonitor::start()
     // Output header
     csvHeader();
 
-    // Start all input threads
+    // Start the input threads, or the single multiplexer thread with --event-driven.
+    if (_args.eventDriven) {
+        if (!_mux->start()) {
+            return false;
+        }
+        _mux->waitForTermination();
+        return true;
+    }
+
     for (size_t i = 0; i < _inputs.size(); ++i) {
         // Here, start() means start the thread, and start input plugin.
         bool success = _inputs[i].inputExecutor->start();
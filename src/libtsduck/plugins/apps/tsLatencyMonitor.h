@@ -20,6 +20,7 @@ namespace ts {
     // Used in private part.
     namespace tslatencymonitor {
         class InputExecutor;
+        class DatagramMux;
     }
 
     //!
@@ -68,14 +69,15 @@ namespace ts {
 
         struct InputData
         {
-            std::shared_ptr<tslatencymonitor::InputExecutor> inputExecutor;
-            TimingDataList timingDataList;
+            std::shared_ptr<tslatencymonitor::InputExecutor> inputExecutor {};
+            TimingDataList timingDataList {};
         };
         typedef std::vector<InputData> InputDataVector;
 
         Report&              _report;
         LatencyMonitorArgs   _args {};
         InputDataVector      _inputs {};
+        std::shared_ptr<tslatencymonitor::DatagramMux> _mux {};  // Single input thread with --event-driven
         std::recursive_mutex _mutex {};              // Global mutex, protect access to all subsequent fields.
         double               _max_latency = 0;       // Maximum latency between two inputs
         Time                 _last_output_time {};   // Timestamp to record last output time
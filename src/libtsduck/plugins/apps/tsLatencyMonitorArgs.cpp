@@ -29,6 +29,14 @@ void ts::LatencyMonitorArgs::defineArgs(Args& args)
     args.help(u"output-interval",
               u"Specify the time interval between each output in seconds. "
               u"The default is 1 second.");
+
+    args.option(u"event-driven", 'e');
+    args.help(u"event-driven",
+              u"Receive all inputs in one single thread which waits on all "
+              u"sockets at once, instead of one thread per input. This scales "
+              u"to a large number of monitored inputs. All inputs must be UDP "
+              u"datagram inputs (plugin \"ip\") and only the socket-level "
+              u"options of that plugin are supported in this mode.");
 }
 
 
@@ -42,6 +50,7 @@ bool ts::LatencyMonitorArgs::loadArgs(Args& args)
     outputName = args.value(u"output-file");
     args.getIntValue(bufferTime, u"buffer-time", 1);
     args.getIntValue(outputInterval, u"output-interval", 1);
+    eventDriven = args.present(u"event-driven");
 
     // Load all plugin descriptions. Default output is the standard output file.
     ArgsWithPlugins* pargs = dynamic_cast<ArgsWithPlugins*>(&args);
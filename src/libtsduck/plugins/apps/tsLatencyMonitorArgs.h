@@ -30,6 +30,7 @@ namespace ts {
         UString             outputName {};       //!< Output file name (empty means stderr).
         uint64_t            bufferTime = 0;      //!< Buffer time of timing data list
         uint64_t            outputInterval = 0;  //!< Waiting time between every output in seconds
+        bool                eventDriven = false; //!< Multiplex all UDP inputs on one thread instead of one thread per input
 
         //!
         //! Constructor.
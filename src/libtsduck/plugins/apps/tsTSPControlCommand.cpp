@@ -7,6 +7,7 @@
 //----------------------------------------------------------------------------
 
 #include "tsTSPControlCommand.h"
+#include "tsjsonOutputArgs.h"
 
 
 //----------------------------------------------------------------------------
@@ -35,6 +36,19 @@ ts::TSPControlCommand::TSPControlCommand(Report& report) :
 
     arg = command(u"list", u"List all running plugins", u"[options]", flags);
 
+    arg = command(u"metrics", u"Report performance metrics of all running plugins", u"[options]", flags);
+    json::OutputArgs json_args;
+    json_args.defineArgs(*arg, true, u"Report the metrics in JSON format.");
+    arg->option(u"interval", 0, Args::POSITIVE);
+    arg->help(u"interval",
+              u"Repeat the metrics report at the specified interval in seconds. "
+              u"The reports are pushed on the same connection, replacing repeated polling. "
+              u"By default, report the metrics only once.");
+    arg->option(u"count", 0, Args::POSITIVE);
+    arg->help(u"count",
+              u"With --interval, specify the number of reports to produce. "
+              u"By default, with --interval, report metrics until the tsp process terminates.");
+
     arg = command(u"suspend", u"Suspend a plugin", u"[options] plugin-index", flags);
     arg->setIntro(u"Suspend a plugin. When a packet processing plugin is suspended, "
                   u"the TS packets are directly passed from the previous to the next plugin, "
@@ -56,4 +70,14 @@ ts::TSPControlCommand::TSPControlCommand(Report& report) :
     arg->help(u"same",
               u"Restart the plugin with the same options and parameters. "
               u"By default, when no plugin options are specified, restart with no option at all.");
+    arg->option(u"hot");
+    arg->help(u"hot",
+              u"Hot restart. A new instance of the plugin is started in the background, "
+              u"with the new parameters, while the current instance keeps processing packets. "
+              u"The chain then switches to the new instance at a packet boundary, without "
+              u"dropping packets from the buffer. The plugin must support two simultaneous "
+              u"instances: a device or an exclusive network socket cannot be opened twice. "
+              u"When the new instance fails to start, the current one keeps running unchanged. "
+              u"By default, the plugin is stopped, then restarted with the new parameters; "
+              u"the chain is stalled in the meantime.");
 }
@@ -109,10 +109,16 @@ bool ts::TSProcessor::start(const TSProcessorArgs& args)
         // plugin has a hight priority to make room in the buffer, but not as
         // high as the input which must remain the top-most priority?
 
-        _input = new tsp::InputExecutor(_args, *this, _args.input, ThreadAttributes().setPriority(ts::ThreadAttributes::GetMaximumPriority()), _global_mutex, &_report);
+        // CPU affinity of each executor thread, as set by --cpu-affinity.
+        // Stages are numbered in chain order: input, packet processors, output.
+        auto cpuOf = [this](size_t stage) {
+            return _args.cpu_affinity.empty() ? -1 : _args.cpu_affinity[stage % _args.cpu_affinity.size()];
+        };
+
+        _input = new tsp::InputExecutor(_args, *this, _args.input, ThreadAttributes().setPriority(ts::ThreadAttributes::GetMaximumPriority()).setCPUAffinity(cpuOf(0)), _global_mutex, &_report);
         CheckNonNull(_input);
 
-        _output = new tsp::OutputExecutor(_args, *this, _args.output, ThreadAttributes().setPriority(ts::ThreadAttributes::GetHighPriority()), _global_mutex, &_report);
+        _output = new tsp::OutputExecutor(_args, *this, _args.output, ThreadAttributes().setPriority(ts::ThreadAttributes::GetHighPriority()).setCPUAffinity(cpuOf(_args.plugins.size() + 1)), _global_mutex, &_report);
         CheckNonNull(_output);
 
         _output->ringInsertAfter(_input);
@@ -121,7 +127,7 @@ bool ts::TSProcessor::start(const TSProcessorArgs& args)
         bool realtime = _args.realtime == Tristate::True || _input->isRealTime() || _output->isRealTime();
 
         for (size_t i = 0; i < _args.plugins.size(); ++i) {
-            tsp::PluginExecutor* p = new tsp::ProcessorExecutor(_args, *this, i, ThreadAttributes(), _global_mutex, &_report);
+            tsp::PluginExecutor* p = new tsp::ProcessorExecutor(_args, *this, i, ThreadAttributes().setCPUAffinity(cpuOf(i + 1)), _global_mutex, &_report);
             CheckNonNull(p);
             p->ringInsertBefore(_output);
             realtime = realtime || p->isRealTime();
@@ -225,6 +231,42 @@ bool ts::TSProcessor::isStarted()
 }
 
 
+//----------------------------------------------------------------------------
+// Get a snapshot of the performance metrics of all plugin threads.
+//----------------------------------------------------------------------------
+
+void ts::TSProcessor::snapshotMetrics()
+{
+    _metrics.clear();
+    tsp::PluginExecutor* proc = _input;
+    do {
+        // The counters are only written by the executor thread itself,
+        // getMetrics() returns a consistent snapshot without suspending it.
+        tsp::PluginExecutor::Metrics m;
+        proc->getMetrics(m);
+        PluginMetrics& pm(_metrics.emplace_back());
+        pm.plugin_name = proc->pluginName();
+        pm.plugin_type = proc->plugin()->type();
+        pm.packets = m.packets;
+        pm.waits = m.waits;
+        pm.timeouts = m.timeouts;
+        pm.wait_time = m.wait_time;
+        pm.cpu_time = m.cpu_time;
+        static_assert(PluginMetrics::OCCUPANCY_BUCKETS == tsp::PluginExecutor::Metrics::OCCUPANCY_BUCKETS);
+        pm.occupancy = m.occupancy;
+    } while ((proc = proc->ringNext<tsp::PluginExecutor>()) != _input);
+}
+
+void ts::TSProcessor::getMetrics(PluginMetricsVector& metrics)
+{
+    std::lock_guard<std::recursive_mutex> lock(_global_mutex);
+    if (_input != nullptr) {
+        snapshotMetrics();
+    }
+    metrics = _metrics;
+}
+
+
 //----------------------------------------------------------------------------
 // Abort the processing.
 //----------------------------------------------------------------------------
@@ -260,6 +302,12 @@ void ts::TSProcessor::waitForTermination()
             proc->waitForTermination();
         } while ((proc = proc->ringNext<tsp::PluginExecutor>()) != _input);
 
+        // Keep the final metrics of the session before deleting the executors.
+        {
+            std::lock_guard<std::recursive_mutex> lock(_global_mutex);
+            snapshotMetrics();
+        }
+
         // Make sure the control server thread is terminated before deleting plugins.
         _control->close();
 
@@ -82,6 +82,42 @@ namespace ts {
         //!
         void waitForTermination();
 
+        //!
+        //! Performance metrics of one plugin thread.
+        //! @see getMetrics()
+        //!
+        class TSDUCKDLL PluginMetrics
+        {
+        public:
+            //! Number of buckets in the buffer occupancy histogram.
+            static constexpr size_t OCCUPANCY_BUCKETS = 10;
+
+            PluginMetrics() = default;   //!< Constructor.
+            UString     plugin_name {};  //!< Plugin name.
+            PluginType  plugin_type = PluginType::PROCESSOR;  //!< Plugin type (input, packet processor, output).
+            uint64_t    packets = 0;     //!< Number of packets passed to the next plugin.
+            uint64_t    waits = 0;       //!< Number of times the plugin thread blocked, waiting for packets or for buffer space.
+            uint64_t    timeouts = 0;    //!< Number of reception timeouts.
+            MilliSecond wait_time = 0;   //!< Total time the plugin thread spent blocked, in milliseconds.
+            MilliSecond cpu_time = 0;    //!< CPU time of the plugin thread, in milliseconds.
+            std::array<uint64_t, OCCUPANCY_BUCKETS> occupancy {};  //!< Histogram of the plugin's input backlog, in tenths of the global buffer size.
+        };
+
+        //!
+        //! A vector of plugin metrics, describing a processing chain.
+        //!
+        typedef std::vector<PluginMetrics> PluginMetricsVector;
+
+        //!
+        //! Get a snapshot of the performance metrics of all plugin threads, in chain order.
+        //! This is the programmatic equivalent of the "metrics" control command of tsp.
+        //! While the processing is running, this is a live snapshot. After termination,
+        //! the final values of the last session are returned.
+        //! @param [out] metrics Returned metrics, one entry per plugin, from input to
+        //! output. Empty when start() was never called.
+        //!
+        void getMetrics(PluginMetricsVector& metrics);
+
     private:
         // There is one global mutex for protected operations.
         // The resulting bottleneck of this single mutex is acceptable as long
@@ -96,8 +132,12 @@ namespace ts {
         tsp::ControlServer*   _control = nullptr;          // TSP control command server thread.
         PacketBuffer*         _packet_buffer = nullptr;    // Global TS packet buffer.
         PacketMetadataBuffer* _metadata_buffer = nullptr;  // Global packet metabata buffer.
+        PluginMetricsVector   _metrics {};                 // Last snapshot of the plugin metrics.
 
         // Deallocate and cleanup internal resources.
         void cleanupInternal();
+
+        // Refresh _metrics from the executors. The executors must exist.
+        void snapshotMetrics();
     };
 }
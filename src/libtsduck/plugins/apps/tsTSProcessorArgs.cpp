@@ -89,6 +89,18 @@ void ts::TSProcessorArgs::defineArgs(Args& args)
               u"Specify the reception timeout in milliseconds for control commands. "
               u"The default timeout is " + UString::Decimal(DEFAULT_CONTROL_TIMEOUT) + u" ms.");
 
+    args.option(u"cpu-affinity", 0, Args::STRING);
+    args.help(u"cpu-affinity", u"cpu[,cpu...]",
+              u"Pin the plugin executor threads on the specified CPU numbers. "
+              u"The CPU numbers are assigned in chain order: the input plugin first, "
+              u"then each packet processing plugin, finally the output plugin. "
+              u"When fewer CPU numbers than plugins are specified, the list is reused "
+              u"from the beginning. On NUMA systems, keeping all plugins on CPU's of "
+              u"the same node avoids remote memory accesses on the packet buffer. "
+              u"By default, the threads are not pinned and the operating system may "
+              u"migrate them between CPU's. CPU pinning may not be supported on all "
+              u"operating systems, in which case this option is ignored.");
+
     args.option(u"final-wait", 0, Args::INT64);
     args.help(u"final-wait", u"milliseconds",
               u"Wait the specified number of milliseconds after the last input packet. "
@@ -120,6 +132,16 @@ void ts::TSProcessorArgs::defineArgs(Args& args)
               u"This can be useful if the same plugin is used several times "
               u"and all instances log many messages.");
 
+    args.option(u"low-latency");
+    args.help(u"low-latency",
+              u"Reduce the latency of the processing chain. Each plugin flushes its processed "
+              u"packets to the next plugin as soon as this one is idle, instead of waiting for "
+              u"--max-flushed-packets to accumulate. Packets are still processed in batches "
+              u"when the next plugin is busy, so the throughput is preserved under load. "
+              u"This option increases the number of synchronization operations between the "
+              u"plugin threads and is meaningful on real-time streams only. "
+              u"This option implies --realtime.");
+
     args.option(u"receive-timeout", 0, Args::POSITIVE);
     args.help(u"receive-timeout", u"milliseconds",
               u"Specify a timeout in milliseconds for all input operations. "
@@ -157,6 +179,15 @@ void ts::TSProcessorArgs::defineArgs(Args& args)
               u"are enforced. The explicit values 'no', 'false', 'off' are used to enforce "
               u"the offline defaults and the explicit values 'yes', 'true', 'on' are used "
               u"to enforce the real-time defaults.");
+
+    args.option(u"validate-input-crc", 0, Args::PIDVAL, 0, Args::UNLIMITED_COUNT);
+    args.help(u"validate-input-crc", u"pid1[-pid2]",
+              u"Check the CRC32 of the PSI/SI sections of the specified PID's when the packets "
+              u"are received from the input plugin. Sections with an incorrect CRC32 are reported "
+              u"as warnings and the TS packet in which such a section ends is marked in its metadata. "
+              u"The validation is performed once, in the input thread, so that plugins down the "
+              u"chain can use the result without revalidating the same sections. "
+              u"Several --validate-input-crc options may be specified.");
 }
 
 
@@ -179,12 +210,17 @@ bool ts::TSProcessorArgs::loadArgs(DuckContext& duck, Args& args)
     args.getIntValue(instuff_stop, u"add-stop-stuffing", 0);
     ignore_jt = args.present(u"ignore-joint-termination");
     args.getTristateValue(realtime, u"realtime");
+    low_latency = args.present(u"low-latency");
+    if (low_latency && realtime == Tristate::Maybe) {
+        realtime = Tristate::True;
+    }
     args.getIntValue(receive_timeout, u"receive-timeout", 0);
     args.getIntValue(final_wait, u"final-wait", -1);
     args.getIPValue(control_local, u"control-local");
     args.getIntValue(control_port, u"control-port", 0);
     args.getIntValue(control_timeout, u"control-timeout", DEFAULT_CONTROL_TIMEOUT);
     control_reuse = args.present(u"control-reuse-port");
+    args.getIntValues(validate_crc_pids, u"validate-input-crc");
 
     // Convert MB in MiB for buffer size for compatibility with original versions.
     ts_buffer_size = size_t((uint64_t(ts_buffer_size) * 1024 * 1024) / 1000000);
@@ -201,6 +237,22 @@ bool ts::TSProcessorArgs::loadArgs(DuckContext& duck, Args& args)
         }
     }
 
+    // Decode --cpu-affinity cpu[,cpu...].
+    cpu_affinity.clear();
+    if (args.present(u"cpu-affinity")) {
+        UStringVector cpus;
+        args.value(u"cpu-affinity").split(cpus);
+        for (const auto& str : cpus) {
+            int cpu = 0;
+            if (!str.toInteger(cpu) || cpu < 0) {
+                args.error(u"invalid CPU number \"%s\" in --cpu-affinity", {str});
+            }
+            else {
+                cpu_affinity.push_back(cpu);
+            }
+        }
+    }
+
     // Decode --add-input-stuffing nullpkt/inpkt.
     instuff_nullpkt = instuff_inpkt = 0;
     if (args.present(u"add-input-stuffing") && !args.value(u"add-input-stuffing").scan(u"%d/%d", {&instuff_nullpkt, &instuff_inpkt})) {
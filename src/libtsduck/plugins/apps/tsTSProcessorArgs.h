@@ -30,6 +30,7 @@ namespace ts {
         UString           app_name {};              //!< Application name, for help messages.
         bool              ignore_jt = false;        //!< Ignore "joint termination" options in plugins.
         bool              log_plugin_index = false; //!< Log plugin index with plugin name.
+        bool              low_latency = false;      //!< Low-latency mode: flush packets to the next plugin as soon as it is idle.
         size_t            ts_buffer_size = DEFAULT_BUFFER_SIZE; //!< Size in bytes of the global TS packet buffer.
         size_t            max_flush_pkt = 0;        //!< Max processed packets before flush.
         size_t            max_input_pkt = 0;        //!< Max packets per input operation.
@@ -50,6 +51,8 @@ namespace ts {
         bool              control_reuse = false;    //!< Set the 'reuse port' socket option on the control TCP server port.
         IPv4AddressVector control_sources {};       //!< Remote IP addresses which are allowed to send control commands.
         MilliSecond       control_timeout = DEFAULT_CONTROL_TIMEOUT; //!< Reception timeout in milliseconds for control commands.
+        std::vector<int>  cpu_affinity {};          //!< CPU numbers of the plugin executor threads, in chain order (empty = no pinning).
+        PIDSet            validate_crc_pids {};     //!< PID's on which the CRC32 of PSI/SI sections is validated at input level.
         DuckContext::SavedArgs duck_args {};        //!< Default TSDuck context options for all plugins. Each plugin can override them in its context.
         PluginOptions          input {};            //!< Input plugin description.
         PluginOptionsVector    plugins {};          //!< Packet processor plugins descriptions.
@@ -15,9 +15,6 @@
 // Define the singleton.
 TS_DEFINE_SINGLETON(ts::DuckExtensionRepository);
 
-// The internal singleton which loads all extensions.
-const ts::DuckExtensionRepository::Loader ts::DuckExtensionRepository::LoaderInstance;
-
 
 //----------------------------------------------------------------------------
 // Constructors
@@ -27,11 +24,31 @@ ts::DuckExtensionRepository::DuckExtensionRepository()
 {
 }
 
-ts::DuckExtensionRepository::Loader::Loader()
+
+//----------------------------------------------------------------------------
+// Load all available extensions, if not already done.
+//----------------------------------------------------------------------------
+
+void ts::DuckExtensionRepository::loadExtensions()
 {
+    // Fast path: loading was already completed.
+    if (_loaded) {
+        return;
+    }
+
+    // The mutex is recursive: the static initialization of an extension shared
+    // library registers itself here and may call back into the repository.
+    std::lock_guard<std::recursive_mutex> lock(_load_mutex);
+    if (_loaded || _loading) {
+        return;
+    }
+    _loading = true;
+
     // Give up now when TSLIBEXT_NONE is defined.
     if (!GetEnvironment(u"TSLIBEXT_NONE").empty()) {
         CERR.debug(u"TSLIBEXT_NONE defined, no extension loaded");
+        _loading = false;
+        _loaded = true;
         return;
     }
 
@@ -68,7 +85,20 @@ ts::DuckExtensionRepository::Loader::Loader()
         }
     }
 
-    CERR.debug(u"loaded %d extensions", {DuckExtensionRepository::Instance()._extensions.size()});
+    CERR.debug(u"loaded %d extensions", {_extensions.size()});
+    _loading = false;
+    _loaded = true;
+}
+
+
+//----------------------------------------------------------------------------
+// Get the number of loaded extensions.
+//----------------------------------------------------------------------------
+
+size_t ts::DuckExtensionRepository::extensionCount()
+{
+    loadExtensions();
+    return _extensions.size();
 }
 
 //----------------------------------------------------------------------------
@@ -110,6 +140,9 @@ namespace {
 
 ts::UString ts::DuckExtensionRepository::listExtensions(ts::Report& report)
 {
+    // Make sure all extensions are loaded.
+    loadExtensions();
+
     // Compute max name width of all extensions.
     size_t width = 0;
     for (const auto& ext : _extensions) {
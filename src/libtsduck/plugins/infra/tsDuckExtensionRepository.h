@@ -28,28 +28,42 @@ namespace ts {
     //! callable interface. Instead, it statically registers hooks inside the TSDuck library,
     //! when the TSDuck extension shared library is loaded.
     //!
-    //! The extensions repository is responsible for statically loading all available extensions.
+    //! The extensions repository is responsible for loading all available extensions.
     //! The extension shared libraries are all shared libraries named "tslibext_*", using the
     //! same search rules as tsp plugins.
     //!
-    //! Since this operation occurs before entering the main code of any executable using the
-    //! TSDuck library, the application has no control over the loading of extensions.
+    //! The extensions are loaded on first use of the repositories (plugin lookup, extension
+    //! listing), not during the process initialization. Short-lived commands which do not
+    //! use them, a mere -\-help invocation for instance, do not pay the directory scan and
+    //! shared library loading on startup.
     //! The following environment variables can be defined to alter the loading of extensions:
     //!
     //! - TSLIBEXT_DEBUG : If defined and not empty, display debug messages on the standard error.
     //! - TSLIBEXT_NONE : If defined and not empty, do not load any extension.
     //! - TSLIBEXT_IGNORE : A comma-separated list of extensions to ignore (useful when one
     //!   extension creates problems when loaded).
+    //! - TSDUCK_NO_PLUGINS_CACHE : If defined and not empty, do not cache the scan of the
+    //!   extension directories (the shared libraries are rescanned on each process startup).
     //!
     class TSDUCKDLL DuckExtensionRepository
     {
         TS_DECLARE_SINGLETON(DuckExtensionRepository);
     public:
+        //!
+        //! Load all available extensions, if not already done.
+        //! This method is implicitly invoked on first use of the repository, on plugin
+        //! lookups in the plugin repository and when a DuckContext loads its command
+        //! line arguments. Applications do not need to call it, unless they depend on
+        //! extension registrations (PSI/SI tables for instance) without using any of
+        //! these entry points.
+        //!
+        void loadExtensions();
+
         //!
         //! Get the number of loaded extensions.
         //! @return The number of loaded extensions.
         //!
-        size_t extensionCount() const { return _extensions.size(); }
+        size_t extensionCount();
 
         //!
         //! List all loaded extensions.
@@ -102,17 +116,12 @@ namespace ts {
         // List of loaded extensions.
         std::list<Extension> _extensions {};
 
-        // Load all extensions in constructor of an internal singleton.
-        // There is a trick here. If we load all extensions in the constructor of DuckExtensionRepository,
-        // the execution of the constructor of the singleton activates shared libraries which registers
-        // themselves in the DuckExtensionRepository singletion (during its constructor). To void this,
-        // an internal class singleton loads all extensions first.
-        class Loader
-        {
-        public:
-            Loader();
-        };
-        static const Loader LoaderInstance;
+        // Lazy loading state. The mutex is recursive: loading a shared library executes
+        // the static initialization of the extension which registers itself in this
+        // repository and may re-enter here; the _loading flag makes re-entry a no-op.
+        std::atomic<bool>    _loaded {false};
+        bool                 _loading = false;
+        std::recursive_mutex _load_mutex {};
     };
 }
 
@@ -58,7 +58,7 @@ namespace ts {
         //! submitted to the plugin (deleted or excluded packets).
         //!
         PluginEventContext(uint32_t       event_code,
-                           UString        plugin_name,
+                           const UString& plugin_name,
                            size_t         plugin_index,
                            size_t         plugin_count,
                            Plugin*        plugin,
@@ -75,9 +75,9 @@ namespace ts {
 
         //!
         //! Get the plugin name.
-        //! @return Plugin name as found in the plugin registry.
+        //! @return A constant reference to the plugin name as found in the plugin registry.
         //!
-        UString pluginName() const { return _plugin_name; }
+        const UString& pluginName() const { return _plugin_name; }
 
         //!
         //! Get the plugin index in the processing chain.
@@ -111,9 +111,9 @@ namespace ts {
 
         //!
         //! Get the plugin bitrate.
-        //! @return Known bitrate in the context of the plugin at the time of the event.
+        //! @return A constant reference to the known bitrate in the context of the plugin at the time of the event.
         //!
-        BitRate bitrate() const { return _bitrate; }
+        const BitRate& bitrate() const { return _bitrate; }
 
         //!
         //! Get the number of packets which passed through the plugin.
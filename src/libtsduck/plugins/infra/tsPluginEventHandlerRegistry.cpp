@@ -38,6 +38,14 @@ void ts::PluginEventHandlerRegistry::registerEventHandler(PluginEventHandlerInte
 
         // Finally add a new entry at the end of the list.
         _handlers.push_back(std::make_pair(handler, criteria));
+
+        // Update the cached index for hasEventHandlers().
+        if (criteria.event_code.has_value()) {
+            _specific_codes.insert(criteria.event_code.value());
+        }
+        else {
+            _wildcard_count++;
+        }
     }
 }
 
@@ -67,10 +75,33 @@ void ts::PluginEventHandlerRegistry::unregisterEventHandler(PluginEventHandlerIn
                 }
             }
         }
+
+        // Rebuild the cached index for hasEventHandlers().
+        _specific_codes.clear();
+        _wildcard_count = 0;
+        for (const auto& it : _handlers) {
+            if (it.second.event_code.has_value()) {
+                _specific_codes.insert(it.second.event_code.value());
+            }
+            else {
+                _wildcard_count++;
+            }
+        }
     }
 }
 
 
+//----------------------------------------------------------------------------
+// Check if at least one handler is registered for a given event code.
+//----------------------------------------------------------------------------
+
+bool ts::PluginEventHandlerRegistry::hasEventHandlers(uint32_t event_code) const
+{
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    return _wildcard_count > 0 || _specific_codes.find(event_code) != _specific_codes.end();
+}
+
+
 //----------------------------------------------------------------------------
 // Invoke all event handlers for a given event.
 //----------------------------------------------------------------------------
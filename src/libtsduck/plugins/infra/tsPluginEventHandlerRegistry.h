@@ -97,6 +97,17 @@ namespace ts {
         //!
         void unregisterEventHandler(PluginEventHandlerInterface* handler = nullptr);
 
+        //!
+        //! Check if at least one handler is registered for a given event code.
+        //! This is a fast check which the event signalling path can use to skip
+        //! the construction of the event context when no handler can match.
+        //! High-frequency events for which nothing is registered then cost
+        //! almost nothing.
+        //! @param [in] event_code Event code of the event to signal.
+        //! @return True if at least one registered handler may match this event.
+        //!
+        bool hasEventHandlers(uint32_t event_code) const;
+
         //!
         //! Invoke all event handlers for a given event.
         //! @param [in] context Event context.
@@ -114,5 +125,11 @@ namespace ts {
         mutable std::recursive_mutex _mutex {};
         mutable bool _calling_handlers = false;
         HandlerEntryList _handlers {};
+
+        // Cached index of the registered handlers, updated on registration changes:
+        // the event codes with at least one code-specific handler and the number of
+        // handlers without an event code criteria. Used by hasEventHandlers().
+        std::set<uint32_t> _specific_codes {};
+        size_t _wildcard_count = 0;
     };
 }
@@ -7,6 +7,7 @@
 //----------------------------------------------------------------------------
 
 #include "tsPluginRepository.h"
+#include "tsDuckExtensionRepository.h"
 #include "tsApplicationSharedLibrary.h"
 #include "tsAlgorithm.h"
 #include "tsCerrReport.h"
@@ -101,6 +102,9 @@ ts::PluginRepository::Register::Register(const UString& name, OutputPluginFactor
 template<typename FACTORY>
 FACTORY ts::PluginRepository::getFactory(const UString& plugin_name, const UString& plugin_type, const std::map<UString,FACTORY>& plugin_map, Report& report)
 {
+    // Extensions may register plugins, make sure they are loaded.
+    DuckExtensionRepository::Instance().loadExtensions();
+
     // Search plugin in current cache.
     auto it = plugin_map.find(plugin_name);
 
@@ -205,6 +209,9 @@ namespace {
 
 void ts::PluginRepository::loadAllPlugins(Report& report)
 {
+    // Extensions may register plugins, make sure they are loaded.
+    DuckExtensionRepository::Instance().loadExtensions();
+
     // Do nothing if loading dynamic libraries is disallowed.
     if (!_sharedLibraryAllowed) {
         return;
@@ -233,6 +240,9 @@ ts::UString ts::PluginRepository::listPlugins(bool loadAll, Report& report, int
     UString out;
     out.reserve(5000);
 
+    // Extensions may register plugins, make sure they are loaded.
+    DuckExtensionRepository::Instance().loadExtensions();
+
     // Load all shareable plugins first.
     if (loadAll) {
         loadAllPlugins(report);
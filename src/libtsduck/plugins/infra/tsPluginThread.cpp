@@ -114,6 +114,13 @@ ts::Plugin* ts::PluginThread::plugin() const
     return _shlib;
 }
 
+ts::Plugin* ts::PluginThread::swapPlugin(Plugin* shlib)
+{
+    Plugin* const previous = _shlib;
+    _shlib = shlib;
+    return previous;
+}
+
 
 //----------------------------------------------------------------------------
 // Invoked by the plugin shared library to log messages.
@@ -64,6 +64,17 @@ namespace ts {
         //!
         void setLogName(const UString& name) { _logname = name; }
 
+        //!
+        //! Replace the plugin instance with another instance of the same plugin.
+        //! This is used by hot restart, when a new instance was prepared and
+        //! started while the previous one was still processing packets.
+        //! The caller becomes responsible for stopping and deleting the
+        //! previous instance.
+        //! @param [in] shlib New plugin instance.
+        //! @return Address of the previous plugin instance.
+        //!
+        Plugin* swapPlugin(Plugin* shlib);
+
         // Implementation of TSP virtual methods.
         virtual UString pluginName() const override;
         virtual Plugin* plugin() const override;
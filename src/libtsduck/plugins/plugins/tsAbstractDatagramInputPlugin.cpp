@@ -7,6 +7,7 @@
 //----------------------------------------------------------------------------
 
 #include "tsAbstractDatagramInputPlugin.h"
+#include "tsCoarseClock.h"
 #include "tsIPProtocols.h"
 
 
@@ -137,6 +138,8 @@ ts::BitRateConfidence ts::AbstractDatagramInputPlugin::getBitrateConfidence()
 size_t ts::AbstractDatagramInputPlugin::receive(TSPacket* buffer, TSPacketMetadata* pkt_data, size_t max_packets)
 {
     MicroSecond timestamp = -1;
+    TimeSource timestamp_source = TimeSource::KERNEL;
+    TSPacketLabelSet labels;
 
     // Check if we receive new packets or process remain of previous buffer.
     bool new_packets = false;
@@ -147,7 +150,9 @@ size_t ts::AbstractDatagramInputPlugin::receive(TSPacket* buffer, TSPacketMetada
 
         // Wait for a datagram message
         size_t insize = 0;
-        if (!receiveDatagram(_inbuf.data(), _inbuf.size(), insize, timestamp)) {
+        timestamp_source = TimeSource::KERNEL;
+        labels.reset();
+        if (!receiveDatagram(_inbuf.data(), _inbuf.size(), insize, timestamp, timestamp_source, labels)) {
             return 0;
         }
 
@@ -188,16 +193,18 @@ size_t ts::AbstractDatagramInputPlugin::receive(TSPacket* buffer, TSPacketMetada
                     break;
             }
 
-            // Build time stamps in packet metadata.
+            // Build time stamps and labels in packet metadata.
             _mdata_next = 0;
             for (size_t i = 0; i < _inbuf_count; ++i) {
+                _mdata[i].clearAllLabels();
+                _mdata[i].setLabels(labels);
                 if (use_rtp) {
                     // RTP time stamp unit is 90 kHz (RTP_RATE_MP2T)
                     _mdata[i].setInputTimeStamp(rtp_timestamp, RTP_RATE_MP2T, TimeSource::RTP);
                 }
                 else if (use_kernel) {
                     // IP time stamp unit is microseconds.
-                    _mdata[i].setInputTimeStamp(uint64_t(timestamp), MicroSecPerSec, TimeSource::KERNEL);
+                    _mdata[i].setInputTimeStamp(uint64_t(timestamp), MicroSecPerSec, timestamp_source);
                 }
                 else {
                     _mdata[i].clearInputTimeStamp();
@@ -214,7 +221,9 @@ size_t ts::AbstractDatagramInputPlugin::receive(TSPacket* buffer, TSPacketMetada
     // If new packets were received, we may need to re-evaluate the real-time input bitrate.
     if (new_packets && _real_time && _eval_time > 0) {
 
-        const Time now(Time::CurrentUTC());
+        // The coarse clock is enough to delimit evaluation periods of several seconds
+        // and is much cheaper than the regular clock, once per datagram.
+        const Time now(CoarseClock::CurrentUTC());
 
         // Detect start time
         if (_packets == 0) {
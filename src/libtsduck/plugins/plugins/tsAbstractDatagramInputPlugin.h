@@ -66,9 +66,14 @@ namespace ts {
         //! @param [in] buffer_size Size in bytes of the reception buffer.
         //! @param [out] ret_size Size in bytes of the received message. Will never be larger than @a buffer_size.
         //! @param [out] timestamp Receive timestamp in micro-seconds or -1 if not available.
+        //! @param [out] timestamp_source Origin of @a timestamp. Preset to TimeSource::KERNEL
+        //! by the caller, subclasses update it when the timestamp comes from another clock
+        //! (NIC hardware for instance). Reported in the input time stamp of the packet metadata.
+        //! @param [out] labels Labels to set on all TS packets of this datagram. Ignored by most
+        //! subclasses, used to tag the origin of the packets when several sources are aggregated.
         //! @return True on success, false on error.
         //!
-        virtual bool receiveDatagram(uint8_t* buffer, size_t buffer_size, size_t& ret_size, MicroSecond& timestamp) = 0;
+        virtual bool receiveDatagram(uint8_t* buffer, size_t buffer_size, size_t& ret_size, MicroSecond& timestamp, TimeSource& timestamp_source, TSPacketLabelSet& labels) = 0;
 
     private:
         // Order of priority for input timestamps. SYSTEM means lower layer from subclass (UDP, SRT, etc).
@@ -8,6 +8,7 @@
 
 #include "tsAbstractDescrambler.h"
 #include "tsMemory.h"
+#include "tsTime.h"
 
 // Stack usage required by this module in the ECM deciphering thread.
 #define ECM_THREAD_STACK_OVERHEAD (16  * 1024)
@@ -123,6 +124,15 @@ bool ts::AbstractDescrambler::start()
     _scrambled_streams.clear();
     _demux.reset();
 
+    // Reset stall and ECM latency statistics.
+    _stalled_packets = 0;
+    _stall_count = 0;
+    _late_cw_count = 0;
+    _stalled = false;
+    _ecm_count = 0;
+    _total_ecm_time = 0;
+    _max_ecm_time = 0;
+
     // Initialize the scrambling engine.
     if (!_scrambling.start()) {
         return false;
@@ -159,6 +169,18 @@ bool ts::AbstractDescrambler::stop()
         _ecm_thread.waitForTermination();
     }
 
+    // Report stall and ECM latency statistics. They tell if the CAS response
+    // time was compatible with the crypto period of the stream.
+    if (_need_ecm) {
+        if (_ecm_count > 0) {
+            tsp->verbose(u"%'d ECM's deciphered, average: %'d ms, maximum: %'d ms", {_ecm_count, _total_ecm_time / _ecm_count, _max_ecm_time});
+        }
+        if (_stall_count > 0 || _late_cw_count > 0) {
+            tsp->verbose(u"%'d scrambled packets passed during %'d stalls without control word, %'d crypto period changes without renewed control word",
+                         {_stalled_packets, _stall_count, _late_cw_count});
+        }
+    }
+
     _scrambling.stop();
     return true;
 }
@@ -346,9 +368,11 @@ void ts::AbstractDescrambler::processECM(ECMStream& estream)
                UString::Dump(ecm.payload(), dumpSize, UString::SINGLE_LINE),
                dumpSize < ecm.payloadSize() ? u" ..." : u""});
 
-    // Submit the ECM to the CAS (subclass).
+    // Submit the ECM to the CAS (subclass), measuring the CAS response time.
     // Exchange the control words if CW swapping was requested.
+    const Time start_time(Time::CurrentUTC());
     bool ok = decipherECM(ecm, _swap_cw ? cw_odd : cw_even, _swap_cw ? cw_even : cw_odd);
+    const MilliSecond ecm_time = Time::CurrentUTC() - start_time;
 
     if (ok) {
         tsp->debug(u"even CW: %s", {UString::Dump(cw_even.cw, UString::SINGLE_LINE)});
@@ -360,6 +384,11 @@ void ts::AbstractDescrambler::processECM(ECMStream& estream)
         _mutex.lock();
     }
 
+    // Update ECM latency statistics in the protected area.
+    _ecm_count++;
+    _total_ecm_time += ecm_time;
+    _max_ecm_time = std::max(_max_ecm_time, ecm_time);
+
     // Copy the control words in the protected area.
     // Normally, only one CW is modified for each new ECM.
     // Compare extracted CW with previous ones to avoid signaling a new
@@ -495,9 +524,28 @@ ts::ProcessorPlugin::Status ts::AbstractDescrambler::processPacket(TSPacket& pkt
         }
     }
     if (pecm.isNull()) {
-        // No ECM stream has valid Control Word now, cannot descramble
+        // No ECM stream has valid Control Word now, cannot descramble.
+        // Count the stall, the CAS has not delivered the CW in time.
+        _stalled_packets++;
+        if (!_stalled) {
+            _stalled = true;
+            _stall_count++;
+            tsp->debug(u"packet %'d: descrambling stalled, no control word available", {tsp->pluginPackets()});
+        }
         return TSP_OK;
     }
+    _stalled = false;
+
+    // Detect crypto period changes for which the CAS did not deliver a renewed
+    // CW in time (or the CW did not change). The stale key of that parity is
+    // kept, late packets are probably incorrectly descrambled.
+    if (pecm->last_scv != scv) {
+        if (pecm->last_scv != SC_CLEAR && ((scv == SC_EVEN_KEY && !pecm->new_cw_even) || (scv == SC_ODD_KEY && !pecm->new_cw_odd))) {
+            _late_cw_count++;
+            tsp->debug(u"packet %'d: crypto period change without renewed %s control word", {tsp->pluginPackets(), scv == SC_EVEN_KEY ? u"even" : u"odd"});
+        }
+        pecm->last_scv = scv;
+    }
 
     // We found a valid CW, check if new CW were deciphered and store them in the descrambler.
     // Flags new_cw_even/odd are "write-protected, read-volatile", no mutex needed.
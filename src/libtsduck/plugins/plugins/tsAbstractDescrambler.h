@@ -192,6 +192,7 @@ namespace ts {
             ECMStream(AbstractDescrambler* parent) : scrambling(parent->_scrambling) {}
 
             TID           last_tid {TID_NULL};  // Last table id (0x80 or 0x81)
+            uint8_t       last_scv {SC_CLEAR};  // Last scrambling control value of descrambled packets.
             TSScrambling  scrambling;           // Descrambling using CW from the ECM's of this stream.
             // -- start of write-protected, read-volatile area --
             volatile bool cw_valid = false;     // CW's are valid
@@ -248,11 +249,18 @@ namespace ts {
         SectionDemux            _demux {duck, nullptr, this}; // Section demux to extract ECM's.
         ECMStreamMap            _ecm_streams {};              // ECM streams, indexed by PID.
         ScrambledStreamMap      _scrambled_streams {};        // Scrambled streams, indexed by PID.
+        PacketCounter           _stalled_packets = 0;         // Scrambled packets passed while no CW was available.
+        uint32_t                _stall_count = 0;             // Number of stall episodes (no valid CW).
+        uint32_t                _late_cw_count = 0;           // Crypto period changes without a renewed CW.
+        bool                    _stalled = false;             // Currently in a stall episode.
         std::mutex              _mutex {};                    // Exclusive access to protected areas
         std::condition_variable _ecm_to_do {};                // Notify thread to process ECM.
         ECMThread               _ecm_thread {this};           // Thread which deciphers ECM's.
         // -- start of protected area --
         bool                    _stop_thread = false;         // Terminate ECM processing thread
+        uint32_t                _ecm_count = 0;               // Number of deciphered ECM's.
+        MilliSecond             _total_ecm_time = 0;          // Cumulated ECM deciphering time.
+        MilliSecond             _max_ecm_time = 0;            // Maximum ECM deciphering time.
         // -- end of protected area --
     };
 }
@@ -17,11 +17,18 @@
 
 ts::AbstractHTTPInputPlugin::AbstractHTTPInputPlugin(TSP* tsp_, const UString& description, const UString& syntax) :
     InputPlugin(tsp_, description, syntax),
-    _request(*tsp)
+    _request(*tsp),
+    _request2(*tsp)
 {
     webArgs.defineArgs(*this);
 }
 
+ts::AbstractHTTPInputPlugin::~AbstractHTTPInputPlugin()
+{
+    // Make sure the prefetch thread is terminated.
+    stopPrefetchThread();
+}
+
 
 //----------------------------------------------------------------------------
 // Get command line options.
@@ -53,6 +60,7 @@ bool ts::AbstractHTTPInputPlugin::setReceiveTimeout(MilliSecond timeout)
 bool ts::AbstractHTTPInputPlugin::abortInput()
 {
     _request.abort();
+    _request2.abort();
     return true;
 }
 
@@ -63,8 +71,26 @@ bool ts::AbstractHTTPInputPlugin::abortInput()
 
 bool ts::AbstractHTTPInputPlugin::start()
 {
+    _current = &_request;
+    _next = &_request2;
+    _fetchPending = _fetchOK = _terminate = false;
+
+    // Start the prefetch thread when enabled.
+    if (_prefetch && !Thread::start()) {
+        return false;
+    }
+
     // Start the first transfer. Here, terminating the session is an error.
-    return startTransfer();
+    if (!startTransfer()) {
+        stopPrefetchThread();
+        return false;
+    }
+
+    // Request the next transfer while the first one is streaming.
+    if (_prefetch) {
+        submitPrefetch();
+    }
+    return true;
 }
 
 
@@ -74,11 +100,75 @@ bool ts::AbstractHTTPInputPlugin::start()
 
 bool ts::AbstractHTTPInputPlugin::stop()
 {
+    // Terminate the prefetch thread and close the prefetched transfer, if any.
+    if (_prefetch) {
+        stopPrefetchThread();
+        _next->close();
+    }
+
     // Stop current transfer.
     return stopTransfer();
 }
 
 
+//----------------------------------------------------------------------------
+// Prefetch thread: open the next transfer while the current one is streaming.
+//----------------------------------------------------------------------------
+
+void ts::AbstractHTTPInputPlugin::main()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    for (;;) {
+        // Wait for something to do.
+        _wake.wait(lock, [this]() { return _fetchPending || _terminate; });
+        if (_terminate) {
+            break;
+        }
+
+        // Open the next transfer, without holding the mutex (can take time).
+        lock.unlock();
+        const bool ok = openTransfer(*_next);
+        lock.lock();
+
+        // Report the completion to the plugin thread.
+        _fetchOK = ok;
+        _fetchPending = false;
+        _done.notify_all();
+    }
+}
+
+// Submit a prefetch of the next transfer to the prefetch thread.
+void ts::AbstractHTTPInputPlugin::submitPrefetch()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _fetchPending = true;
+    }
+    _wake.notify_all();
+}
+
+// Wait for the completion of the pending prefetch, return its result.
+bool ts::AbstractHTTPInputPlugin::waitPrefetch()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    _done.wait(lock, [this]() { return !_fetchPending; });
+    return _fetchOK;
+}
+
+// Terminate the prefetch thread, wait for its completion.
+void ts::AbstractHTTPInputPlugin::stopPrefetchThread()
+{
+    if (_prefetch) {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _terminate = true;
+        }
+        _wake.notify_all();
+        waitForTermination();
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Input method
 //----------------------------------------------------------------------------
@@ -89,9 +179,24 @@ size_t ts::AbstractHTTPInputPlugin::receive(TSPacket* buffer, TSPacketMetadata*
     for (;;) {
 
         // If no transfer is in progress, try to open one.
-        if (!_request.isOpen() && !startTransfer()) {
-            // Cannot open a new transfer, this is the end of the session.
-            return 0;
+        if (!_current->isOpen()) {
+            if (_prefetch) {
+                // Wait for the prefetched transfer and make it the current one.
+                if (!waitPrefetch()) {
+                    // No next transfer, this is the end of the session.
+                    return 0;
+                }
+                std::swap(_current, _next);
+                if (!setupTransfer()) {
+                    return 0;
+                }
+                // Immediately request the next transfer in the background.
+                submitPrefetch();
+            }
+            else if (!startTransfer()) {
+                // Cannot open a new transfer, this is the end of the session.
+                return 0;
+            }
         }
 
         // Get some packets from the current transfer.
@@ -113,28 +218,38 @@ size_t ts::AbstractHTTPInputPlugin::receive(TSPacket* buffer, TSPacketMetadata*
 
 bool ts::AbstractHTTPInputPlugin::startTransfer()
 {
-    // Set common web request options.
-    _request.setArgs(webArgs);
-    _request.setAutoRedirect(true);
+    return openTransfer(*_current) && setupTransfer();
+}
+
+// Open the next URL on a request object (can run in the prefetch thread).
+bool ts::AbstractHTTPInputPlugin::openTransfer(WebRequest& request)
+{
+    // Set common web request options. Since we typically chain many transfers
+    // on the same server, keep connections alive between transfers.
+    request.setArgs(webArgs);
+    request.setAutoRedirect(true);
+    request.enableConnectionReuse(true);
 
     // Let the subclass start the transfer.
-    if (tsp->aborting() || !openURL(_request)) {
-        return false;
-    }
+    return !tsp->aborting() && openURL(request);
+}
 
+// Post-open operations on the current transfer (log, auto-save file).
+bool ts::AbstractHTTPInputPlugin::setupTransfer()
+{
     // Get content type and size from response headers.
-    const UString mime(_request.mimeType());
-    const size_t size = _request.announdedContentSize();
+    const UString mime(_current->mimeType());
+    const size_t size = _current->announdedContentSize();
 
     // Print a message.
-    tsp->verbose(u"downloading from %s", {_request.finalURL()});
+    tsp->verbose(u"downloading from %s", {_current->finalURL()});
     tsp->verbose(u"MIME type: %s, expected size: %s", {mime.empty() ? u"unknown" : mime, size == 0 ? u"unknown" : UString::Format(u"%d bytes", {size})});
     if (!mime.empty() && !mime.similar(u"video/mp2t")) {
         tsp->warning(u"MIME type is %s, maybe not a valid transport stream", {mime});
     }
 
     // Create the auto-save file when necessary.
-    UString name(BaseName(URL(_request.finalURL()).getPath()));
+    UString name(BaseName(URL(_current->finalURL()).getPath()));
     if (!_autoSaveDir.empty() && !name.empty()) {
         name = _autoSaveDir + fs::path::preferred_separator + name;
         tsp->verbose(u"saving input TS to %s", {name});
@@ -162,7 +277,7 @@ bool ts::AbstractHTTPInputPlugin::stopTransfer()
     }
 
     // Terminate any pending transfer.
-    return _request.close();
+    return _current->close();
 }
 
 
@@ -189,7 +304,7 @@ size_t ts::AbstractHTTPInputPlugin::receiveTransfer(TSPacket* buffer, size_t max
 
             // Receive more data into partial packet. We must receive at least one packet because returning zero means end of transfer.
             while (_partialSize < PKT_SIZE) {
-                if (!_request.receive(_partial.b + _partialSize, PKT_SIZE - _partialSize, receiveSize) || receiveSize == 0) {
+                if (!_current->receive(_partial.b + _partialSize, PKT_SIZE - _partialSize, receiveSize) || receiveSize == 0) {
                     // Error or end of transfer.
                     return 0;
                 }
@@ -207,7 +322,7 @@ size_t ts::AbstractHTTPInputPlugin::receiveTransfer(TSPacket* buffer, size_t max
         // Receive subsequent data directly in the caller's buffer.
         // Don't check the returned bool, we only need the returned size (O on error).
         receiveSize = 0;
-        _request.receive(curBuffer->b, PKT_SIZE * maxPackets, receiveSize);
+        _current->receive(curBuffer->b, PKT_SIZE * maxPackets, receiveSize);
 
         // Compute residue after last complete packet.
         _partialSize = receiveSize % PKT_SIZE;
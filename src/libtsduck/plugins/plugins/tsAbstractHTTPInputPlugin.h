@@ -14,15 +14,18 @@
 #pragma once
 #include "tsInputPlugin.h"
 #include "tsTSFile.h"
+#include "tsThread.h"
 #include "tsWebRequest.h"
 #include "tsWebRequestArgs.h"
+#include <mutex>
+#include <condition_variable>
 
 namespace ts {
     //!
     //! Abstract base class for HTTP-based input plugins.
     //! @ingroup plugin
     //!
-    class TSDUCKDLL AbstractHTTPInputPlugin: public InputPlugin
+    class TSDUCKDLL AbstractHTTPInputPlugin: public InputPlugin, private Thread
     {
         TS_NOBUILD_NOCOPY(AbstractHTTPInputPlugin);
     public:
@@ -35,6 +38,11 @@ namespace ts {
         virtual size_t receive(TSPacket*, TSPacketMetadata*, size_t) override;
         virtual bool setReceiveTimeout(MilliSecond timeout) override;
 
+        //!
+        //! Destructor.
+        //!
+        virtual ~AbstractHTTPInputPlugin() override;
+
     protected:
         //!
         //! Constructor for subclasses.
@@ -59,6 +67,19 @@ namespace ts {
         //!
         void setAutoSaveDirectory(const UString dir) { _autoSaveDir = dir; }
 
+        //!
+        //! Enable or disable the prefetch of the next transfer.
+        //! Must be called before start(). When enabled, while the content of a
+        //! transfer is passed to the plugin chain, the next URL is requested by
+        //! a background thread on a second WebRequest object. Thus, when the
+        //! current transfer completes, the first bytes of the next one are
+        //! usually already available and the connection setup and request round
+        //! trip do not create a gap in the stream. This is designed for inputs
+        //! which chain many small downloads, HLS segments for instance.
+        //! @param [in] on Boolean setting prefetch on or off.
+        //!
+        void enableTransferPrefetch(bool on = true) { _prefetch = on; }
+
         //!
         //! Delete the cookies file, if there is one.
         //! @return True on success, false on error.
@@ -71,11 +92,39 @@ namespace ts {
         WebRequestArgs webArgs {};
 
     private:
-        WebRequest _request;          // Current Web transfer in progress.
-        TSPacket   _partial {};       // Buffer for incomplete packets.
-        size_t     _partialSize = 0;  // Number of bytes in partial.
-        UString    _autoSaveDir {};   // If not empty, automatically save loaded files to this directory.
-        TSFile     _outSave {};       // TS file where to store the loaded file.
+        WebRequest  _request;           // First Web transfer object.
+        WebRequest  _request2;          // Second Web transfer object, used with prefetch.
+        WebRequest* _current = nullptr; // Transfer which currently feeds the plugin.
+        WebRequest* _next = nullptr;    // Transfer which is prefetched in the background.
+        TSPacket    _partial {};        // Buffer for incomplete packets.
+        size_t      _partialSize = 0;   // Number of bytes in partial.
+        UString     _autoSaveDir {};    // If not empty, automatically save loaded files to this directory.
+        TSFile      _outSave {};        // TS file where to store the loaded file.
+
+        // Prefetch thread state.
+        bool _prefetch = false;             // Prefetch the next transfer in the background.
+        std::mutex _mutex {};               // Protect the fields below.
+        std::condition_variable _wake {};   // Signal a prefetch request to the thread.
+        std::condition_variable _done {};   // Signal the completion of a prefetch.
+        bool _fetchPending = false;         // A prefetch is in progress on _next.
+        bool _fetchOK = false;              // Result of the last completed prefetch.
+        bool _terminate = false;            // Ask the prefetch thread to terminate.
+
+        // Implementation of Thread, the prefetch thread.
+        virtual void main() override;
+
+        // Open the next URL on a request object (can run in the prefetch thread).
+        bool openTransfer(WebRequest& request);
+
+        // Post-open operations on the current transfer (log, auto-save file).
+        bool setupTransfer();
+
+        // Submit a prefetch of the next transfer / wait for its completion.
+        void submitPrefetch();
+        bool waitPrefetch();
+
+        // Terminate the prefetch thread, wait for its completion.
+        void stopPrefetchThread();
 
         // Start/receive/stop on one single transfer.
         bool startTransfer();
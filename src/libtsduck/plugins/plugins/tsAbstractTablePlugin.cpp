@@ -26,7 +26,8 @@ ts::AbstractTablePlugin::AbstractTablePlugin(TSP* tsp_,
     _pid(pid),
     _demux(duck, this),
     _pzer(duck, pid),
-    _patch_xml(duck)
+    _patch_xml(duck),
+    _ser_buffer(duck)
 {
     _patch_xml.defineArgs(*this);
 
@@ -161,10 +162,19 @@ void ts::AbstractTablePlugin::handleTable(SectionDemux& demux, const BinaryTable
         return;
     }
 
-    // Call subclass to process the table.
+    // Call subclass to process the table. Use the in-place binary fast path
+    // when the subclass implements it for the requested modifications.
     bool is_target = true;
     bool reinsert = true;
-    modifyTable(table, is_target, reinsert);
+    if (!modifyTableInPlace(table, is_target, reinsert)) {
+        modifyTable(table, is_target, reinsert);
+    }
+    else if (is_target && (_incr_version || _set_version)) {
+        // The fast path may keep sections which are shared with the demux while
+        // the version patch in reinsertTable() modifies the sections in place:
+        // make sure the table owns its sections.
+        table = BinaryTable(table, ShareMode::COPY);
+    }
 
     // Place modified table in the packetizer.
     if (reinsert) {
@@ -173,6 +183,64 @@ void ts::AbstractTablePlugin::handleTable(SectionDemux& demux, const BinaryTable
 }
 
 
+//----------------------------------------------------------------------------
+// In-place binary modification of a table and its patch primitives.
+//----------------------------------------------------------------------------
+
+bool ts::AbstractTablePlugin::modifyTableInPlace(BinaryTable& table, bool& is_target, bool& reinsert)
+{
+    // Default implementation: decline, fall back to modifyTable().
+    return false;
+}
+
+bool ts::AbstractTablePlugin::PatchPID(Section& section, size_t offset, PID pid, bool recompute_crc)
+{
+    if (!section.isValid() || offset + 2 > section.payloadSize()) {
+        return false;
+    }
+    const uint16_t field = GetUInt16(section.payload() + offset);
+    section.setUInt16(offset, uint16_t((field & 0xE000) | (pid & 0x1FFF)), recompute_crc);
+    return true;
+}
+
+bool ts::AbstractTablePlugin::InsertInPayload(Section& section, size_t offset, const ByteBlock& data, size_t length_offset)
+{
+    // The length field, if any, must precede the insertion point.
+    if (!section.isValid() ||
+        offset > section.payloadSize() ||
+        (length_offset != NPOS && length_offset + 2 > offset) ||
+        section.size() + data.size() > MAX_PRIVATE_SECTION_SIZE)
+    {
+        return false;
+    }
+
+    // Rebuild the section content with the inserted data.
+    const size_t insert_at = section.headerSize() + offset;
+    ByteBlock content;
+    content.reserve(section.size() + data.size());
+    content.append(section.content(), insert_at);
+    content.append(data);
+    content.append(section.content() + insert_at, section.size() - insert_at);
+
+    // Adjust the section length.
+    PutUInt16(&content[1], uint16_t((GetUInt16(&content[1]) & 0xF000) | ((content.size() - 3) & 0x0FFF)));
+
+    // Adjust the enclosing loop length.
+    if (length_offset != NPOS) {
+        uint8_t* const field = &content[section.headerSize() + length_offset];
+        const size_t length = (GetUInt16(field) & 0x0FFF) + data.size();
+        if (length > 0x0FFF) {
+            return false;
+        }
+        PutUInt16(field, uint16_t((GetUInt16(field) & 0xF000) | length));
+    }
+
+    // Reload the section with a freshly computed CRC32.
+    section.reload(content, section.sourcePID(), CRC32::COMPUTE);
+    return section.isValid();
+}
+
+
 //----------------------------------------------------------------------------
 // Called by the subclass when some external event forces an update of the table.
 //----------------------------------------------------------------------------
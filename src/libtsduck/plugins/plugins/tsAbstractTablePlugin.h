@@ -16,6 +16,7 @@
 #include "tsSectionDemux.h"
 #include "tsCyclingPacketizer.h"
 #include "tsTablePatchXML.h"
+#include "tsPSIBuffer.h"
 
 namespace ts {
     //!
@@ -75,6 +76,49 @@ namespace ts {
         //!
         virtual void modifyTable(BinaryTable& table, bool& is_target, bool& reinsert) = 0;
 
+        //!
+        //! Modify one table directly in its binary form.
+        //! This optional fast path is invoked before modifyTable(). When the requested
+        //! modifications map to known byte ranges in the sections (PID substitution,
+        //! descriptor append), a subclass can patch the binary sections directly, with
+        //! CRC32 update, and skip the deserialization / reserialization round-trip.
+        //! See PatchPID() and InsertInPayload() for the common patch primitives.
+        //! The default implementation declines, so that modifyTable() is used.
+        //! @param [in,out] table A table from the processed PID.
+        //! @param [in,out] is_target Same semantics as in modifyTable().
+        //! @param [in,out] reinsert Same semantics as in modifyTable().
+        //! @return True when the table was fully processed in place. False to fall back
+        //! to modifyTable(); in that case, @a table must be left unmodified.
+        //!
+        virtual bool modifyTableInPlace(BinaryTable& table, bool& is_target, bool& reinsert);
+
+        //!
+        //! Substitute a PID value in a binary section, a patch primitive for modifyTableInPlace().
+        //! The 13-bit PID field is overwritten, the three upper bits of the 16-bit field are preserved.
+        //! @param [in,out] section The section to patch.
+        //! @param [in] offset Byte offset of the 16-bit field containing the PID, in the payload of the section.
+        //! @param [in] pid New PID value.
+        //! @param [in] recompute_crc If true, immediately recompute the CRC32 of the section.
+        //! When patching several fields in the same section, recompute it once, on the last patch only.
+        //! @return True on success, false when the section is invalid or too short.
+        //!
+        static bool PatchPID(Section& section, size_t offset, PID pid, bool recompute_crc = true);
+
+        //!
+        //! Insert bytes in a binary section payload, a patch primitive for modifyTableInPlace().
+        //! The section length is adjusted and the CRC32 is recomputed. This is typically used
+        //! to append descriptors at the end of a descriptor loop.
+        //! @param [in,out] section The section to patch.
+        //! @param [in] offset Byte offset in the payload of the section where the data are inserted.
+        //! @param [in] data The data to insert.
+        //! @param [in] length_offset Byte offset in the payload of a 12-bit length field (such as
+        //! a descriptor loop length) to increment by the size of the inserted data. The length
+        //! field must precede the insertion point. NPOS when there is no length field to adjust.
+        //! @return True on success, false when the patched section would be malformed or would
+        //! exceed the maximum section size (the caller shall then fall back to modifyTable()).
+        //!
+        static bool InsertInPayload(Section& section, size_t offset, const ByteBlock& data, size_t length_offset = NPOS);
+
         //!
         //! Create a new empty table when none is found in the PID.
         //! Must be implemented by subclasses.
@@ -102,6 +146,15 @@ namespace ts {
         //!
         bool hasError() const { return _abort; }
 
+        //!
+        //! Get a serialization buffer which is reused across table updates.
+        //! Subclasses should pass it to AbstractTable::serialize(BinaryTable&, PSIBuffer&)
+        //! when reserializing a modified table. Since tables are cyclically regenerated,
+        //! reusing one buffer avoids a steady stream of allocations in the packet path.
+        //! @return A reference to the reusable serialization buffer.
+        //!
+        PSIBuffer& serializationBuffer() { return _ser_buffer; }
+
         // Implementation of TableHandlerInterface.
         virtual void handleTable(SectionDemux&, const BinaryTable&) override;
 
@@ -123,6 +176,7 @@ namespace ts {
         SectionDemux      _demux;                 // Section demux.
         CyclingPacketizer _pzer;                  // Packetizer for modified tables.
         TablePatchXML     _patch_xml;             // Table patcher using XML patch files.
+        PSIBuffer         _ser_buffer;            // Reusable serialization buffer for table updates.
 
         // Reinsert a table in the target PID.
         void reinsertTable(BinaryTable& table, bool is_target_table);
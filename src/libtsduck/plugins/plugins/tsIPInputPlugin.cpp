@@ -22,10 +22,45 @@ ts::IPInputPlugin::IPInputPlugin(TSP* tsp_) :
     AbstractDatagramInputPlugin(tsp_, IP_MAX_PACKET_SIZE, u"Receive TS packets from UDP/IP, multicast or unicast", u"[options] [address:]port",
                                 u"kernel", u"A kernel-provided time-stamp for the packet, when available (Linux only)",
                                 true), // real-time network reception
-    _sock(*tsp_)
+    _sock(*tsp_),
+    _fec_col(*this),
+    _fec_row(*this)
 {
-    // Add UDP receiver common options.
-    _sock.defineArgs(*this, true, true, false);
+    // Add UDP receiver common options. Several [address:]port parameters
+    // can be specified to aggregate several UDP streams in one instance.
+    _sock.defineArgs(*this, true, true, true);
+
+    option(u"first-label", 0, INTEGER, 0, 1, 0, TSPacketLabelSet::MAX);
+    help(u"first-label", u"value",
+         u"When several [address:]port parameters are specified, tag the TS packets "
+         u"with a label identifying the receiver they come from. Packets from the "
+         u"first receiver get the specified label value, packets from the second "
+         u"receiver get that value plus one, etc. Downstream plugins can then "
+         u"demultiplex or monitor each source using --only-label options.");
+
+    option(u"receive-threads", 0, POSITIVE);
+    help(u"receive-threads", u"count",
+         u"Receive the stream using the specified number of sockets and threads. "
+         u"All sockets bind to the same port with the reuse-port option and the "
+         u"kernel load-balances the incoming datagrams between them, so the "
+         u"reception of a single very high bitrate stream can scale over several "
+         u"cores. The stream must be RTP: the datagrams received by the various "
+         u"threads are reassembled in RTP sequence order, non-RTP datagrams are "
+         u"dropped. This option implies --rtp-reorder with a default value of 32.");
+
+    option(u"rtp-reorder", 0, POSITIVE);
+    help(u"rtp-reorder", u"count",
+         u"Reorder RTP datagrams which are received out of sequence. "
+         u"The value is the maximum number of datagrams which are held back while "
+         u"waiting for a late datagram. This is also the worst-case additional "
+         u"latency, in datagrams. Non-RTP datagrams are passed unchanged.");
+
+    option(u"smpte-2022-fec");
+    help(u"smpte-2022-fec",
+         u"Receive the SMPTE 2022-1 FEC streams on the media UDP port plus 2 "
+         u"(column FEC) and plus 4 (row FEC) and rebuild the datagrams which are "
+         u"definitely lost, when the rest of their FEC column or row was received. "
+         u"This option implies --rtp-reorder with a default value of 32.");
 }
 
 
@@ -35,8 +70,46 @@ ts::IPInputPlugin::IPInputPlugin(TSP* tsp_) :
 
 bool ts::IPInputPlugin::getOptions()
 {
-    // Get command line arguments for superclass and socket.
-    return AbstractDatagramInputPlugin::getOptions() && _sock.loadArgs(duck, *this);
+    getIntValue(_reorder_window, u"rtp-reorder", 0);
+    getIntValue(_shard_count, u"receive-threads", 1);
+    _fec = present(u"smpte-2022-fec");
+    _rtp_reorder = _fec || _shard_count > 1 || _reorder_window > 0;
+    if (_rtp_reorder && _reorder_window == 0) {
+        _reorder_window = 32;
+    }
+    if (_shard_count > 1 && present(u"no-reuse-port")) {
+        tsp->error(u"--receive-threads requires the reuse-port socket option");
+        return false;
+    }
+
+    // Get command line arguments for superclass and first socket.
+    if (!AbstractDatagramInputPlugin::getOptions() || !_sock.loadArgs(duck, *this)) {
+        return false;
+    }
+
+    // Load additional receivers when several [address:]port parameters are present.
+    _aux_socks.clear();
+    for (size_t i = 1; i < _sock.receiverCount(); ++i) {
+        _aux_socks.push_back(std::make_unique<UDPReceiver>(*tsp));
+        if (!_aux_socks.back()->loadArgs(true, duck, *this, i)) {
+            return false;
+        }
+    }
+
+    // RTP reordering, FEC recovery and sharded reception are per-stream
+    // processes, they cannot work on interleaved datagrams from unrelated streams.
+    if (!_aux_socks.empty() && _rtp_reorder) {
+        tsp->error(u"--rtp-reorder, --smpte-2022-fec and --receive-threads are not allowed with several [address:]port parameters");
+        return false;
+    }
+
+    // Optional per-receiver labels.
+    getIntValue(_first_label, u"first-label", NPOS);
+    if (_first_label != NPOS && _first_label + _sock.receiverCount() - 1 > TSPacketLabelSet::MAX) {
+        tsp->error(u"--first-label too large, labels %d to %d do not fit in 0-%d", {_first_label, _first_label + _sock.receiverCount() - 1, TSPacketLabelSet::MAX});
+        return false;
+    }
+    return true;
 }
 
 
@@ -46,8 +119,76 @@ bool ts::IPInputPlugin::getOptions()
 
 bool ts::IPInputPlugin::start()
 {
-    // Initialize superclass and UDP socket.
-    return AbstractDatagramInputPlugin::start() && _sock.open(*tsp);
+    // Allocate the reception buffers for batched reception, one per datagram.
+    _batch_buffer.resize(RECV_BATCH_SIZE * IP_MAX_PACKET_SIZE);
+    _batch.resize(RECV_BATCH_SIZE);
+    for (size_t i = 0; i < _batch.size(); ++i) {
+        _batch[i].data = _batch_buffer.data() + i * IP_MAX_PACKET_SIZE;
+        _batch[i].max_size = IP_MAX_PACKET_SIZE;
+    }
+    _batch_count = _batch_next = 0;
+    _batch_label = NPOS;
+    _next_sock = 0;
+
+    // Preallocate the RTP reordering engine.
+    if (_rtp_reorder) {
+        _rtp.init(_reorder_window);
+    }
+
+    // Initialize superclass.
+    if (!AbstractDatagramInputPlugin::start()) {
+        return false;
+    }
+
+    // Open the reception sockets. In sharded mode, _sock only carries the
+    // command line parameters, the actual reception sockets are the shards,
+    // all bound to the same port with the reuse-port option.
+    if (_shard_count > 1) {
+        _active_shards = _shard_count;
+        _non_rtp_dropped = 0;
+        _shards.clear();
+        bool ok = true;
+        for (size_t i = 0; ok && i < _shard_count; ++i) {
+            _shards.push_back(std::make_unique<ShardReceiver>(*this));
+            _shards.back()->sock.copyParameters(_sock, 0);
+            ok = _shards.back()->sock.open(*tsp) && _shards.back()->start();
+        }
+        if (!ok) {
+            {
+                // The last shard never ran, it will not signal its termination.
+                std::lock_guard<std::mutex> lock(_rtp_mutex);
+                _active_shards--;
+            }
+            abortInput();    // close the sockets, terminate the running threads
+            _shards.clear(); // join them
+            return false;
+        }
+    }
+    else {
+        if (!_sock.open(*tsp)) {
+            return false;
+        }
+        for (const auto& sock : _aux_socks) {
+            if (!sock->open(*tsp)) {
+                abortInput();
+                return false;
+            }
+        }
+    }
+
+    // Open the FEC sockets, on the media port plus 2 and plus 4, and start
+    // their reception threads. Compatible with sharded mode: the FEC threads
+    // push into the same reassembler as the shard threads.
+    if (_fec) {
+        _fec_col.sock.copyParameters(_sock, 2);
+        _fec_row.sock.copyParameters(_sock, 4);
+        if (!_fec_col.sock.open(*tsp) || !_fec_row.sock.open(*tsp) || !_fec_col.start() || !_fec_row.start()) {
+            abortInput();
+            _shards.clear();
+            return false;
+        }
+    }
+    return true;
 }
 
 
@@ -57,7 +198,28 @@ bool ts::IPInputPlugin::start()
 
 bool ts::IPInputPlugin::stop()
 {
+    // Closing the FEC and shard sockets unblocks and terminates the reception threads.
+    if (_fec) {
+        _fec_col.sock.close(*tsp);
+        _fec_row.sock.close(*tsp);
+        _fec_col.waitForTermination();
+        _fec_row.waitForTermination();
+    }
+    for (const auto& shard : _shards) {
+        shard->sock.close(*tsp);
+    }
+    _shards.clear(); // join the shard threads
+    if (_non_rtp_dropped > 0) {
+        tsp->verbose(u"sharded reception: %'d non-RTP datagrams dropped", {_non_rtp_dropped});
+    }
+    if (_rtp_reorder && (_rtp.reorderedCount() > 0 || _rtp.recoveredCount() > 0 || _rtp.lostCount() > 0)) {
+        tsp->verbose(u"RTP reception: %'d datagrams out of order, %'d rebuilt by FEC, %'d lost",
+                     {_rtp.reorderedCount(), _rtp.recoveredCount(), _rtp.lostCount()});
+    }
     _sock.close(*tsp);
+    for (const auto& sock : _aux_socks) {
+        sock->close(*tsp);
+    }
     return AbstractDatagramInputPlugin::stop();
 }
 
@@ -69,7 +231,17 @@ bool ts::IPInputPlugin::stop()
 bool ts::IPInputPlugin::abortInput()
 {
     tsp->debug(u"aborting IP input");
+    if (_fec) {
+        _fec_col.sock.close(*tsp);
+        _fec_row.sock.close(*tsp);
+    }
     _sock.close(*tsp);
+    for (const auto& sock : _aux_socks) {
+        sock->close(*tsp);
+    }
+    for (const auto& shard : _shards) {
+        shard->sock.close(*tsp);
+    }
     return true;
 }
 
@@ -82,18 +254,207 @@ bool ts::IPInputPlugin::setReceiveTimeout(MilliSecond timeout)
 {
     if (timeout > 0) {
         _sock.setReceiveTimeoutArg(timeout);
+        for (const auto& sock : _aux_socks) {
+            sock->setReceiveTimeoutArg(timeout);
+        }
     }
     return true;
 }
 
 
 //----------------------------------------------------------------------------
-// Datagram reception method.
+// FEC stream reception thread.
 //----------------------------------------------------------------------------
 
-bool ts::IPInputPlugin::receiveDatagram(uint8_t* buffer, size_t buffer_size, size_t& ret_size, MicroSecond& timestamp)
+ts::IPInputPlugin::FECReceiver::FECReceiver(IPInputPlugin& plugin) :
+    sock(*plugin.tsp),
+    _plugin(plugin)
+{
+}
+
+ts::IPInputPlugin::FECReceiver::~FECReceiver()
 {
+    waitForTermination();
+}
+
+void ts::IPInputPlugin::FECReceiver::main()
+{
+    ByteBlock buffer(IP_MAX_PACKET_SIZE);
     IPv4SocketAddress sender;
     IPv4SocketAddress destination;
-    return _sock.receive(buffer, buffer_size, ret_size, sender, destination, tsp, *tsp, &timestamp);
+    size_t ret_size = 0;
+
+    // Terminate when the socket is closed by the plugin.
+    while (sock.receive(buffer.data(), buffer.size(), ret_size, sender, destination, nullptr, *_plugin.tsp)) {
+        std::lock_guard<std::mutex> lock(_plugin._rtp_mutex);
+        _plugin._rtp.putFEC(buffer.data(), ret_size);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Shard reception thread (sharded mode, --receive-threads).
+//----------------------------------------------------------------------------
+
+ts::IPInputPlugin::ShardReceiver::ShardReceiver(IPInputPlugin& plugin) :
+    sock(*plugin.tsp),
+    _plugin(plugin)
+{
+}
+
+ts::IPInputPlugin::ShardReceiver::~ShardReceiver()
+{
+    waitForTermination();
+}
+
+void ts::IPInputPlugin::ShardReceiver::main()
+{
+    // Per-thread reception buffers, same batching as the main socket path.
+    ByteBlock buffer(RECV_BATCH_SIZE * IP_MAX_PACKET_SIZE);
+    std::vector<UDPSocket::ReceivedMessage> batch(RECV_BATCH_SIZE);
+    for (size_t i = 0; i < batch.size(); ++i) {
+        batch[i].data = buffer.data() + i * IP_MAX_PACKET_SIZE;
+        batch[i].max_size = IP_MAX_PACKET_SIZE;
+    }
+
+    // Terminate when the socket is closed by the plugin.
+    size_t count = 0;
+    while (sock.receiveBatch(batch.data(), batch.size(), count, nullptr, *_plugin.tsp)) {
+        std::lock_guard<std::mutex> lock(_plugin._rtp_mutex);
+        for (size_t i = 0; i < count; ++i) {
+            if (!_plugin._rtp.putMedia(reinterpret_cast<const uint8_t*>(batch[i].data), batch[i].ret_size, batch[i].timestamp)) {
+                // Non-RTP datagrams cannot be resequenced between threads.
+                if (_plugin._non_rtp_dropped++ == 0) {
+                    _plugin.tsp->warning(u"received non-RTP datagrams with --receive-threads, dropping them");
+                }
+            }
+        }
+        if (count > 0) {
+            _plugin._rtp_cv.notify_one();
+        }
+    }
+
+    // Signal the termination of this thread to the plugin thread.
+    {
+        std::lock_guard<std::mutex> lock(_plugin._rtp_mutex);
+        _plugin._active_shards--;
+    }
+    _plugin._rtp_cv.notify_all();
+}
+
+
+//----------------------------------------------------------------------------
+// Datagram reception method.
+//----------------------------------------------------------------------------
+
+// Wait until at least one of the sockets has a datagram ready.
+bool ts::IPInputPlugin::waitReadySocket(size_t& index)
+{
+    const size_t sock_count = 1 + _aux_socks.size();
+
+    // Wait for incoming data on any of the sockets.
+    ::fd_set fds;
+    FD_ZERO(&fds);
+    SysSocketType max_sock = 0; // first select() parameter, unused on Windows
+    for (size_t i = 0; i < sock_count; ++i) {
+        const SysSocketType s = receiverAt(i).getSocket();
+        if (s == SYS_SOCKET_INVALID) {
+            // A socket was closed, typically by abortInput() from another thread.
+            return false;
+        }
+        FD_SET(s, &fds);
+#if !defined(TS_WINDOWS)
+        max_sock = std::max(max_sock, s);
+#endif
+    }
+    if (::select(int(max_sock) + 1, &fds, nullptr, nullptr, nullptr) <= 0) {
+        // Errors are expected when a socket is asynchronously closed on abort.
+        tsp->debug(u"socket select error: %s", {SysSocketErrorCodeMessage()});
+        return false;
+    }
+
+    // Pick a ready socket, starting after the previously selected one so that
+    // a flooded low-index port cannot starve the other ones.
+    for (size_t i = 0; i < sock_count; ++i) {
+        const size_t current = (_next_sock + i) % sock_count;
+        if (FD_ISSET(receiverAt(current).getSocket(), &fds)) {
+            index = current;
+            _next_sock = (current + 1) % sock_count;
+            return true;
+        }
+    }
+    return false; // should not happen, select() reported at least one ready socket
+}
+
+
+bool ts::IPInputPlugin::receiveFromSocket(uint8_t* buffer, size_t buffer_size, size_t& ret_size, MicroSecond& timestamp, TimeSource& timestamp_source, TSPacketLabelSet& labels)
+{
+    // Refill the batch when all previously received datagrams have been handed out.
+    // A batch can be legitimately empty when all its datagrams were filtered out,
+    // simply retry in that case. One system call typically returns many datagrams.
+    while (_batch_next >= _batch_count) {
+        size_t index = 0;
+        if (!_aux_socks.empty() && !waitReadySocket(index)) {
+            return false;
+        }
+        if (!receiverAt(index).receiveBatch(_batch.data(), _batch.size(), _batch_count, tsp, *tsp)) {
+            return false;
+        }
+        _batch_label = _first_label == NPOS ? NPOS : _first_label + index;
+        _batch_next = 0;
+    }
+
+    // Hand out the next datagram of the batch.
+    const UDPSocket::ReceivedMessage& msg(_batch[_batch_next++]);
+    ret_size = std::min(msg.ret_size, buffer_size);
+    std::memcpy(buffer, msg.data, ret_size);
+    timestamp = msg.timestamp;
+    timestamp_source = msg.timestamp_hw ? TimeSource::HARDWARE : TimeSource::KERNEL;
+    if (_batch_label != NPOS) {
+        labels.set(_batch_label);
+    }
+    return true;
+}
+
+bool ts::IPInputPlugin::receiveDatagram(uint8_t* buffer, size_t buffer_size, size_t& ret_size, MicroSecond& timestamp, TimeSource& timestamp_source, TSPacketLabelSet& labels)
+{
+    if (_shard_count > 1) {
+        // Sharded mode: the shard threads fill the reassembler, just wait on it.
+        std::unique_lock<std::mutex> lock(_rtp_mutex);
+        for (;;) {
+            if (_rtp.getNext(buffer, buffer_size, ret_size, timestamp)) {
+                return true;
+            }
+            if (_active_shards == 0) {
+                // All reception threads terminated, end of stream.
+                return false;
+            }
+            _rtp_cv.wait(lock);
+        }
+    }
+
+    if (!_rtp_reorder) {
+        return receiveFromSocket(buffer, buffer_size, ret_size, timestamp, timestamp_source, labels);
+    }
+
+    // Reordering mode: push received datagrams into the reassembler and pop
+    // them in RTP sequence order.
+    for (;;) {
+        {
+            std::lock_guard<std::mutex> lock(_rtp_mutex);
+            if (_rtp.getNext(buffer, buffer_size, ret_size, timestamp)) {
+                return true;
+            }
+        }
+        if (!receiveFromSocket(buffer, buffer_size, ret_size, timestamp, timestamp_source, labels)) {
+            return false;
+        }
+        {
+            std::lock_guard<std::mutex> lock(_rtp_mutex);
+            if (!_rtp.putMedia(buffer, ret_size, timestamp)) {
+                // Not an RTP datagram, pass it unchanged.
+                return true;
+            }
+        }
+    }
 }
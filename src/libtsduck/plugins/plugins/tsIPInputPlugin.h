@@ -14,6 +14,11 @@
 #pragma once
 #include "tsAbstractDatagramInputPlugin.h"
 #include "tsUDPReceiver.h"
+#include "tsRTPReassembler.h"
+#include "tsThread.h"
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 
 namespace ts {
     //!
@@ -33,9 +38,83 @@ namespace ts {
 
     protected:
         // Implementation of AbstractDatagramInputPlugin.
-        virtual bool receiveDatagram(uint8_t* buffer, size_t buffer_size, size_t& ret_size, MicroSecond& timestamp) override;
+        virtual bool receiveDatagram(uint8_t* buffer, size_t buffer_size, size_t& ret_size, MicroSecond& timestamp, TimeSource& timestamp_source, TSPacketLabelSet& labels) override;
 
     private:
-        UDPReceiver _sock; // Incoming socket with associated command line options.
+        // Number of datagrams per batched receive operation. Each datagram is received in
+        // its own buffer and handed out one by one to the superclass, so batching only
+        // reduces the number of system calls, it never delays the delivery of packets.
+        static constexpr size_t RECV_BATCH_SIZE = 32;
+
+        // Reception thread for one SMPTE 2022-1 FEC stream (column or row).
+        // The received datagrams are pushed into the RTP reassembler of the plugin.
+        class FECReceiver: public Thread
+        {
+            TS_NOBUILD_NOCOPY(FECReceiver);
+        public:
+            FECReceiver(IPInputPlugin& plugin);
+            virtual ~FECReceiver() override;
+            UDPReceiver sock;  // FEC stream socket, a copy of the media socket parameters.
+
+        private:
+            IPInputPlugin& _plugin;
+            virtual void main() override;
+        };
+
+        // Reception thread for one shard in sharded mode (--receive-threads).
+        // All shard sockets bind to the same port with SO_REUSEPORT, the kernel
+        // load-balances the datagrams between them. Each thread pushes its share
+        // into the RTP reassembler where the plugin thread pops them in sequence.
+        class ShardReceiver: public Thread
+        {
+            TS_NOBUILD_NOCOPY(ShardReceiver);
+        public:
+            ShardReceiver(IPInputPlugin& plugin);
+            virtual ~ShardReceiver() override;
+            UDPReceiver sock;  // Shard socket, a copy of the media socket parameters.
+
+        private:
+            IPInputPlugin& _plugin;
+            virtual void main() override;
+        };
+
+        UDPReceiver _sock;          // First incoming socket with associated command line options.
+        ByteBlock   _batch_buffer {};  // Reception buffers for all datagrams of a batch.
+        std::vector<UDPSocket::ReceivedMessage> _batch {};  // Descriptions of datagrams in the current batch.
+        size_t      _batch_count = 0;  // Number of valid datagrams in the current batch.
+        size_t      _batch_next = 0;   // Index of next datagram to return from the current batch.
+        size_t      _batch_label = NPOS;  // Label to set on packets of the current batch, NPOS if none.
+
+        // Aggregated reception of several UDP streams in one plugin instance.
+        // The first receiver is _sock, additional ones are in _aux_socks.
+        std::vector<std::unique_ptr<UDPReceiver>> _aux_socks {};  // Receivers 1 to N-1 on the command line.
+        size_t _first_label = NPOS;  // Label of packets from the first receiver, NPOS when unused.
+        size_t _next_sock = 0;       // Index of next receiver to poll first (round-robin fairness).
+
+        // Wait until at least one of the sockets has a datagram ready and return its index.
+        // All sockets block forever, so this is where reception actually waits.
+        bool waitReadySocket(size_t& index);
+
+        // Get the receiver at a given index (0 is _sock, then _aux_socks).
+        UDPReceiver& receiverAt(size_t index) { return index == 0 ? _sock : *_aux_socks[index - 1]; }
+
+        // RTP reordering and SMPTE 2022-1 FEC options and state.
+        bool           _rtp_reorder = false;  // Reorder out-of-sequence RTP datagrams.
+        bool           _fec = false;          // Receive and use the SMPTE 2022-1 FEC streams.
+        size_t         _reorder_window = 0;   // Reordering depth in datagrams.
+        RTPReassembler _rtp {};               // Preallocated reorder / recovery engine.
+        std::mutex     _rtp_mutex {};         // Serialize accesses to _rtp with the FEC and shard threads.
+        FECReceiver    _fec_col;              // Column FEC stream, on the media port plus 2.
+        FECReceiver    _fec_row;              // Row FEC stream, on the media port plus 4.
+
+        // Sharded reception options and state (--receive-threads).
+        size_t   _shard_count = 1;      // Number of SO_REUSEPORT sockets and reception threads.
+        size_t   _active_shards = 0;    // Number of shard threads still running, under _rtp_mutex.
+        uint64_t _non_rtp_dropped = 0;  // Non-RTP datagrams dropped in sharded mode, under _rtp_mutex.
+        std::condition_variable _rtp_cv {};  // Signal datagram arrival and thread termination.
+        std::vector<std::unique_ptr<ShardReceiver>> _shards {};
+
+        // Receive the next datagram from the media socket(s) (batched reception).
+        bool receiveFromSocket(uint8_t* buffer, size_t buffer_size, size_t& ret_size, MicroSecond& timestamp, TimeSource& timestamp_source, TSPacketLabelSet& labels);
     };
 }
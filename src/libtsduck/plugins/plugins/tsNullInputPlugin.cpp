@@ -86,11 +86,11 @@ size_t ts::NullInputPlugin::receive (TSPacket* buffer, TSPacketMetadata* pkt_dat
         _limit = std::numeric_limits<PacketCounter>::max();
     }
 
-    // Fill buffer
-    size_t n = 0;
-    while (n < max_packets && _count < _limit) {
-        _count++;
-        buffer[n++] = NullPacket;
+    // Fill buffer in one batch, no per-packet limit check.
+    const size_t n = _count >= _limit ? 0 : size_t(std::min<PacketCounter>(max_packets, _limit - _count));
+    for (size_t i = 0; i < n; ++i) {
+        buffer[i] = NullPacket;
     }
+    _count += n;
     return n;
 }
@@ -86,6 +86,9 @@ bool ts::PushInputPlugin::start()
 
 bool ts::PushInputPlugin::stop()
 {
+    // Report queue utilization statistics in verbose final reports.
+    tsp->verbose(u"%s", {_queue.statisticsSummary()});
+
     // Send the stop condition to the internal packet queue.
     _queue.stop();
 
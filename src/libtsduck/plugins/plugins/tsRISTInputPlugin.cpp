@@ -57,9 +57,12 @@ public:
      ByteBlock      buffer {};             // data in excess from last input.
      int            last_qsize = 0;        // last queue size in data blocks.
      bool           qsize_warned = false;  // a warning was reporting on heavy queue size.
+     bool           got_seq = false;       // a first data block sequence number was received.
+     uint64_t       last_seq = 0;          // sequence number of last data block.
+     uint64_t       seq_gaps = 0;          // number of sequence discontinuities.
 
      // Constructor.
-     Guts(Args* args, TSP* tsp) : rist(*tsp) {}
+     Guts(Args* args, TSP* tsp) : rist(tsp) {}
 };
 
 
@@ -122,6 +125,9 @@ bool ts::RISTInputPlugin::start()
     _guts->buffer.clear();
     _guts->last_qsize = 0;
     _guts->qsize_warned = false;
+    _guts->got_seq = false;
+    _guts->last_seq = 0;
+    _guts->seq_gaps = 0;
 
     // Initialize the RIST context.
     tsp->debug(u"calling rist_receiver_create, profile: %d", {_guts->rist.profile});
@@ -153,6 +159,9 @@ bool ts::RISTInputPlugin::start()
 
 bool ts::RISTInputPlugin::stop()
 {
+    if (_guts->seq_gaps > 0) {
+        tsp->verbose(u"RIST sequence discontinuities: %'d", {_guts->seq_gaps});
+    }
     _guts->rist.cleanup();
     return true;
 }
@@ -212,6 +221,15 @@ size_t ts::RISTInputPlugin::receive(TSPacket* pkt_buffer, TSPacketMetadata* pkt_
                 }
                 _guts->last_qsize = queue_size;
 
+                // Track sequence discontinuities, after recovery and reordering by librist.
+                // The sequence number wraps at 16 or 32 bits, depending on the RTP encapsulation.
+                if (_guts->got_seq && dblock->seq != _guts->last_seq + 1 && !(dblock->seq == 0 && (_guts->last_seq == 0xFFFF || _guts->last_seq == 0xFFFFFFFF))) {
+                    _guts->seq_gaps++;
+                    tsp->debug(u"RIST sequence discontinuity, flow id %d, expected %d, got %d", {dblock->flow_id, _guts->last_seq + 1, dblock->seq});
+                }
+                _guts->got_seq = true;
+                _guts->last_seq = dblock->seq;
+
                 // Assume that we receive an integral number of TS packets.
                 const size_t total_pkt_count = dblock->payload_len / PKT_SIZE;
                 const uint8_t* const data_addr = reinterpret_cast<const uint8_t*>(dblock->payload);
@@ -53,14 +53,17 @@ class ts::RISTOutputPlugin::Guts
 {
      TS_NOBUILD_NOCOPY(Guts);
 public:
-     TSDatagramOutput datagram;
-     RISTPluginData   rist;
-     bool             npd {false};  // null packet deletion
+     TSDatagramOutput  datagram;
+     RISTPluginData    rist;
+     bool              npd {false};          // null packet deletion
+     ::rist_data_block dblock {};            // data block, prepared once, reused for all datagrams
+     uint64_t          sent_datagrams {0};   // datagrams submitted to librist
+     uint64_t          short_writes {0};     // submissions which were partially accepted by librist
 
      // Constructor.
      Guts(RISTOutputPlugin* plugin) :
          datagram(TSDatagramOutputOptions::NONE, plugin),
-         rist(*plugin->tsp)
+         rist(plugin->tsp)
      {
      }
 };
@@ -141,6 +144,13 @@ bool ts::RISTOutputPlugin::start()
         return false;
     }
 
+    // Prepare the data block once. librist distributes each submitted block to
+    // all peers by reference, only the payload address and size change from one
+    // datagram to the next.
+    TS_ZERO(_guts->dblock);
+    _guts->sent_datagrams = 0;
+    _guts->short_writes = 0;
+
     // Start transmission.
     tsp->debug(u"calling rist_start");
     if (::rist_start(_guts->rist.ctx) != 0) {
@@ -160,6 +170,7 @@ bool ts::RISTOutputPlugin::start()
 
 bool ts::RISTOutputPlugin::stop()
 {
+    tsp->verbose(u"submitted %'d datagrams to librist, %'d partially accepted", {_guts->sent_datagrams, _guts->short_writes});
     _guts->datagram.close(tsp->bitrate(), *tsp);
     _guts->rist.cleanup();
     return true;
@@ -182,20 +193,21 @@ bool ts::RISTOutputPlugin::send(const TSPacket* packets, const TSPacketMetadata*
 
 bool ts::RISTOutputPlugin::sendDatagram(const void* address, size_t size, Report& report)
 {
-    // Build a RIST data block describing the data to send.
-    ::rist_data_block dblock;
-    TS_ZERO(dblock);
-    dblock.payload = address;
-    dblock.payload_len = size;
-
-    // Send the RIST message.
-    const int sent = ::rist_sender_data_write(_guts->rist.ctx, &dblock);
+    // Update the payload in the preset data block, prepared once at start().
+    _guts->dblock.payload = address;
+    _guts->dblock.payload_len = size;
+
+    // Send the RIST message. librist enqueues references to the same payload
+    // for all peers, there is no per-peer copy at this level.
+    const int sent = ::rist_sender_data_write(_guts->rist.ctx, &_guts->dblock);
     if (sent < 0) {
         report.error(u"error sending data to RIST");
         return false;
     }
-    else if (size_t(sent) != size) {
+    _guts->sent_datagrams++;
+    if (size_t(sent) != size) {
         // Don't really know what to do, retry with the rest?
+        _guts->short_writes++;
         report.warning(u"sent %d bytes to RIST, only %d were written", {size, sent});
     }
     return true;
@@ -56,6 +56,7 @@ bool ts::SRTInputPlugin::getOptions()
 bool ts::SRTInputPlugin::start()
 {
     // Initialize superclass and UDP socket.
+    _max_queue_size = 0;
     return AbstractDatagramInputPlugin::start() && _sock.open(*tsp);
 }
 
@@ -66,6 +67,9 @@ bool ts::SRTInputPlugin::start()
 
 bool ts::SRTInputPlugin::stop()
 {
+    if (_max_queue_size > 0) {
+        tsp->verbose(u"maximum SRT receive queue depth: %'d packets", {_max_queue_size});
+    }
     _sock.close(*tsp);
     return AbstractDatagramInputPlugin::stop();
 }
@@ -86,7 +90,39 @@ bool ts::SRTInputPlugin::abortInput()
 // Datagram reception method.
 //----------------------------------------------------------------------------
 
-bool ts::SRTInputPlugin::receiveDatagram(uint8_t* buffer, size_t buffer_size, size_t& ret_size, MicroSecond& timestamp)
+bool ts::SRTInputPlugin::receiveDatagram(uint8_t* buffer, size_t buffer_size, size_t& ret_size, MicroSecond& timestamp, TimeSource& timestamp_source, TSPacketLabelSet& labels)
 {
-    return _sock.receive(buffer, buffer_size, ret_size, timestamp, *tsp);
+    // Wait for a first message.
+    if (!_sock.receive(buffer, buffer_size, ret_size, timestamp, *tsp)) {
+        return false;
+    }
+
+    // The timestamp comes from the SRT source time of the message.
+    timestamp_source = TimeSource::SRT;
+
+    // Drain the messages which are already queued in libsrt, as long as they
+    // fit in the buffer and the content remains packet-aligned. Draining the
+    // queue in one plugin round trip is necessary to keep up with very high
+    // bitrates. Non-aligned content (RTP encapsulation for instance) is not
+    // batched because the packet locator needs each message separately.
+    const size_t msg_size = ret_size;
+    size_t queued = 0;
+    size_t more = 0;
+    while (ret_size % PKT_SIZE == 0 &&
+           buffer_size - ret_size >= msg_size &&
+           (queued = _sock.receiveQueueSize(*tsp)) > 0 &&
+           _sock.receive(buffer + ret_size, buffer_size - ret_size, more, *tsp) &&
+           more > 0)
+    {
+        ret_size += more;
+    }
+
+    // Track the high-water mark of the queue depth after draining. A growing
+    // backlog means that this thread does not keep up and that packet drop
+    // will follow; make it visible before loss occurs.
+    if (queued > _max_queue_size) {
+        _max_queue_size = queued;
+        tsp->verbose(u"SRT receive queue depth reached %'d packets", {queued});
+    }
+    return true;
 }
@@ -32,9 +32,10 @@ namespace ts {
 
     protected:
         // Implementation of AbstractDatagramInputPlugin.
-        virtual bool receiveDatagram(uint8_t* buffer, size_t buffer_size, size_t& ret_size, MicroSecond& timestamp) override;
+        virtual bool receiveDatagram(uint8_t* buffer, size_t buffer_size, size_t& ret_size, MicroSecond& timestamp, TimeSource& timestamp_source, TSPacketLabelSet& labels) override;
 
     private:
         SRTSocket _sock {};
+        size_t    _max_queue_size = 0;  // High-water mark of the receive queue depth.
     };
 }
@@ -8,6 +8,8 @@
 
 #include "tsSRTOutputPlugin.h"
 #include "tsPluginRepository.h"
+#include "tsPluginEventData.h"
+#include "tsjsonObject.h"
 
 #if !defined(TS_NO_SRT)
 TS_REGISTER_OUTPUT_PLUGIN(u"srt", ts::SRTOutputPlugin);
@@ -32,6 +34,22 @@ ts::SRTOutputPlugin::SRTOutputPlugin(TSP* tsp_) :
     help(u"restart-delay", u"milliseconds",
          u"With --multiple, wait the specified number of milliseconds before restarting.");
 
+    option(u"sender-queue", 0, POSITIVE, 0, 1, 0, 0, true);
+    help(u"sender-queue", u"count",
+         u"Send datagrams from a dedicated thread, using an internal queue of the "
+         u"specified maximum number of datagrams. The default queue size is 512 datagrams. "
+         u"When the SRT socket applies back-pressure, packets accumulate in the queue "
+         u"instead of stalling the tsp output thread. Without this option, datagrams "
+         u"are synchronously sent from the output thread.");
+
+    option(u"statistics-event", 0, UINT32);
+    help(u"statistics-event", u"code",
+         u"Signal a plugin event with the specified code at each --statistics-interval. "
+         u"The event data is an instance of PluginEventData pointing to a JSON string "
+         u"which describes the congestion state of the SRT socket: retransmissions, "
+         u"round-trip time, flow and congestion windows, estimated link bandwidth. "
+         u"This option requires --statistics-interval.");
+
     // These options are legacy, now use --listener and/or --caller.
     option(u"", 0, STRING, 0, 1);
     help(u"" , u"Local [address:]port. This is a legacy parameter, now use --listener.");
@@ -59,6 +77,14 @@ bool ts::SRTOutputPlugin::getOptions()
 {
     _multiple = present(u"multiple");
     getIntValue(_restart_delay, u"restart-delay", 0);
+    _queue_size = present(u"sender-queue") ? intValue<size_t>(u"sender-queue", DEFAULT_QUEUE_SIZE) : 0;
+    _signal_events = present(u"statistics-event");
+    getIntValue(_event_code, u"statistics-event");
+    getIntValue(_stats_interval, u"statistics-interval", 0);
+    if (_signal_events && _stats_interval == 0) {
+        tsp->error(u"--statistics-event requires --statistics-interval");
+        return false;
+    }
     return _sock.setAddresses(value(u""), value(u"rendezvous"), UString(), *tsp) &&
            _sock.loadArgs(duck, *this) &&
            _datagram.loadArgs(duck, *this);
@@ -78,6 +104,20 @@ bool ts::SRTOutputPlugin::start()
             _datagram.close(0, *tsp);
         }
     }
+    if (success) {
+        _send_error = false;
+        _next_stats = _signal_events ? Time::CurrentUTC() + _stats_interval : Time::Epoch;
+        if (_queue_size > 0) {
+            // Start the sender thread.
+            _queue.clear();
+            _queue.setMaxMessages(_queue_size);
+            success = Thread::start();
+            if (!success) {
+                _sock.close(*tsp);
+                _datagram.close(0, *tsp);
+            }
+        }
+    }
     return success;
 }
 
@@ -88,7 +128,14 @@ bool ts::SRTOutputPlugin::start()
 
 bool ts::SRTOutputPlugin::stop()
 {
+    // Flush buffered packets first, this may enqueue a last datagram.
     _datagram.close(tsp->bitrate(), *tsp);
+    if (_queue_size > 0) {
+        // An empty datagram instructs the sender thread to terminate
+        // after sending all previously queued ones.
+        _queue.forceEnqueue(new ByteBlock);
+        waitForTermination();
+    }
     _sock.close(*tsp);
     return true;
 }
@@ -109,11 +156,63 @@ bool ts::SRTOutputPlugin::send(const TSPacket* packets, const TSPacketMetadata*
 //----------------------------------------------------------------------------
 
 bool ts::SRTOutputPlugin::sendDatagram(const void* address, size_t size, Report& report)
+{
+    if (_queue_size == 0) {
+        // Synchronous mode, send from the caller thread.
+        return sendOneDatagram(address, size, report);
+    }
+    else if (_send_error) {
+        // The sender thread reported an error, propagate it on the packet path.
+        return false;
+    }
+    else {
+        // Copy the datagram and pass it to the sender thread. When the queue is
+        // full, wait for free space: this is the back-pressure which paces the
+        // output thread on a slow link.
+        DatagramQueue::MessagePtr dgram(new ByteBlock(address, size));
+        return _queue.enqueue(dgram);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// The sender thread.
+//----------------------------------------------------------------------------
+
+void ts::SRTOutputPlugin::main()
+{
+    tsp->debug(u"sender thread started");
+
+    DatagramQueue::MessagePtr dgram;
+    bool terminate = false;
+    while (!terminate && _queue.dequeue(dgram)) {
+        if (dgram->empty()) {
+            // An empty datagram is the termination request from stop().
+            terminate = true;
+        }
+        else if (!_send_error && !sendOneDatagram(dgram->data(), dgram->size(), *tsp)) {
+            // After an error, keep draining the queue without sending so that
+            // the output thread never hangs on a full queue.
+            _send_error = true;
+        }
+        dgram.clear();
+    }
+
+    tsp->debug(u"sender thread completed");
+}
+
+
+//----------------------------------------------------------------------------
+// Send one datagram on the SRT socket.
+//----------------------------------------------------------------------------
+
+bool ts::SRTOutputPlugin::sendOneDatagram(const void* address, size_t size, Report& report)
 {
     // Loop on restart with multiple sessions.
     for (;;) {
         // Send the datagram.
         if (_sock.send(address, size, report)) {
+            exportStatistics(report);
             return true;
         }
         // Send error.
@@ -127,12 +226,42 @@ bool ts::SRTOutputPlugin::sendDatagram(const void* address, size_t size, Report&
             return false;
         }
         // Multiple sessions, close socket and re-open to acquire another receiver.
-        stop();
+        _sock.close(report);
         if (_restart_delay > 0) {
             SleepThread(_restart_delay);
         }
-        if (!start()) {
+        if (!_sock.open(report)) {
             return false;
         }
     }
 }
+
+
+//----------------------------------------------------------------------------
+// Export sender statistics through a plugin event.
+//----------------------------------------------------------------------------
+
+void ts::SRTOutputPlugin::exportStatistics(Report& report)
+{
+    if (_signal_events && Time::CurrentUTC() >= _next_stats) {
+        _next_stats = Time::CurrentUTC() + _stats_interval;
+        SRTSendStatus status;
+        if (_sock.getSendStatus(status, report)) {
+            // Build a JSON description of the congestion state of the link.
+            json::Object root;
+            root.add(u"rtt-ms", status.rtt_ms);
+            root.add(u"flow-window-packets", status.flow_window_packets);
+            root.add(u"congestion-window-packets", status.congestion_window_packets);
+            root.add(u"in-flight-packets", status.in_flight_packets);
+            root.add(u"sent-packets", status.sent_packets);
+            root.add(u"retransmitted-packets", status.retransmitted_packets);
+            root.add(u"lost-packets", status.lost_packets);
+            root.add(u"dropped-packets", status.dropped_packets);
+            root.add(u"link-bandwidth-mbps", status.link_bandwidth_mbps);
+            root.add(u"send-rate-mbps", status.send_rate_mbps);
+            const std::string line(root.oneLiner(report).toUTF8());
+            PluginEventData data(reinterpret_cast<const uint8_t*>(line.data()), line.size());
+            tsp->signalPluginEvent(_event_code, &data);
+        }
+    }
+}
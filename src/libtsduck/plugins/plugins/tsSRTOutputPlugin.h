@@ -15,13 +15,16 @@
 #include "tsOutputPlugin.h"
 #include "tsTSDatagramOutput.h"
 #include "tsSRTSocket.h"
+#include "tsMessageQueue.h"
+#include "tsByteBlock.h"
+#include "tsThread.h"
 
 namespace ts {
     //!
     //! Secure Reliable Transport (SRT) output plugin for tsp.
     //! @ingroup plugin
     //!
-    class TSDUCKDLL SRTOutputPlugin: public OutputPlugin, private TSDatagramOutputHandlerInterface
+    class TSDUCKDLL SRTOutputPlugin: public OutputPlugin, private TSDatagramOutputHandlerInterface, private Thread
     {
         TS_PLUGIN_CONSTRUCTORS(SRTOutputPlugin);
     public:
@@ -33,12 +36,35 @@ namespace ts {
         virtual bool send(const TSPacket*, const TSPacketMetadata*, size_t) override;
 
     private:
-        bool             _multiple = false;   // Accept multiple (sequential) connections.
-        MilliSecond      _restart_delay = 0;  // If _multiple, wait before reconnecting.
+        // Default size, in datagrams, of the sender thread queue.
+        static constexpr size_t DEFAULT_QUEUE_SIZE = 512;
+
+        // Each message to the sender thread is one datagram.
+        // An empty datagram instructs the thread to terminate.
+        typedef MessageQueue<ByteBlock, std::mutex> DatagramQueue;
+
+        bool             _multiple = false;       // Accept multiple (sequential) connections.
+        MilliSecond      _restart_delay = 0;      // If _multiple, wait before reconnecting.
+        size_t           _queue_size = 0;         // Queue size in datagrams, zero when sending synchronously.
+        bool             _signal_events = false;  // Export sender statistics through plugin events.
+        uint32_t         _event_code = 0;         // Event code for statistics export.
+        MilliSecond      _stats_interval = 0;     // Interval between two statistics exports.
         TSDatagramOutput _datagram {TSDatagramOutputOptions::NONE, this}; // Buffering TS packets.
-        SRTSocket        _sock {};            // Outgoing SRT socket.
+        SRTSocket        _sock {};                // Outgoing SRT socket.
+        DatagramQueue    _queue {};               // Datagram queue to the sender thread.
+        volatile bool    _send_error = false;     // An error occurred in the sender thread.
+        Time             _next_stats {};          // Next UTC time to export statistics.
 
         // Implementation of TSDatagramOutputHandlerInterface.
         virtual bool sendDatagram(const void* address, size_t size, Report& report) override;
+
+        // Implementation of Thread: the sender thread.
+        virtual void main() override;
+
+        // Send one datagram on the SRT socket, reconnecting on clean disconnection with --multiple.
+        bool sendOneDatagram(const void* address, size_t size, Report& report);
+
+        // Export sender statistics through a plugin event when the interval has elapsed.
+        void exportStatistics(Report& report);
     };
 }
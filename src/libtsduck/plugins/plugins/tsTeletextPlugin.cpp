@@ -84,6 +84,12 @@ bool ts::TeletextPlugin::start()
     getValue(_outFile, u"output-file");
     _demux.setAddColors(present(u"colors"));
 
+    // When a specific page is requested, the demux can discard other pages early.
+    _demux.resetPageFilter();
+    if (_page >= 0) {
+        _demux.addPageFilter(_page);
+    }
+
     // Create the output file.
     if (_outFile.empty()) {
         // No output file specified, use standard output.
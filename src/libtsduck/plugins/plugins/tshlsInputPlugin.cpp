@@ -210,6 +210,10 @@ bool ts::hls::InputPlugin::getOptions()
     setAutoSaveDirectory(saveDirectory);
     _playlist.setAutoSaveDirectory(saveDirectory);
 
+    // Request the next media segment while the previous one is streaming.
+    // This avoids a gap in the stream at each segment transition.
+    enableTransferPrefetch(true);
+
     return true;
 }
 
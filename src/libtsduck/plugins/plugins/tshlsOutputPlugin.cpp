@@ -11,6 +11,7 @@
 #include "tsOneShotPacketizer.h"
 #include "tsFileUtils.h"
 #include "tsErrCodeReport.h"
+#include "tsNullReport.h"
 #include "tsPESPacket.h"
 #include "tsPAT.h"
 #include "tsPMT.h"
@@ -21,6 +22,8 @@ TS_REGISTER_OUTPUT_PLUGIN(u"hls", ts::hls::OutputPlugin);
 #define DEFAULT_OUT_LIVE_DURATION  5  // Default segment target duration for output live streams.
 #define DEFAULT_EXTRA_DURATION     2  // Default segment extra duration when intra image is not found.
 #define DEFAULT_LIVE_EXTRA_DEPTH   1  // Default additional segments to keep in live streams.
+#define WRITE_CHUNK_PACKETS      512  // Number of packets which are buffered before being passed to the writer thread.
+#define MAX_WRITER_COMMANDS       64  // Maximum number of queued commands to the writer thread (back-pressure above).
 
 
 //----------------------------------------------------------------------------
@@ -227,15 +230,26 @@ bool ts::hls::OutputPlugin::start()
     _liveSegmentFiles.clear();
     _segStarted = false;
     _segClosePending = false;
-    if (_segmentFile.isOpen()) {
-        _segmentFile.close(*tsp);
+    _pending.clear();
+    _pending.reserve(WRITE_CHUNK_PACKETS);
+    _segPackets = 0;
+    _writeError = false;
+    _queue.clear();
+    _queue.setMaxMessages(MAX_WRITER_COMMANDS);
+    _currentFile = 0;
+    for (auto& file : _segmentFiles) {
+        if (file.isOpen()) {
+            file.close(NULLREP);
+        }
     }
     if (!_playlistFile.empty()) {
         _playlist.reset(_playlistType, _playlistFile);
         _playlist.setTargetDuration(_targetDuration, *tsp);
         _playlist.setMediaSequence(_initialMediaSeq, *tsp);
     }
-    return true;
+
+    // Start the segment writer thread.
+    return Thread::start();
 }
 
 
@@ -245,64 +259,77 @@ bool ts::hls::OutputPlugin::start()
 
 bool ts::hls::OutputPlugin::stop()
 {
-    // Simply close the current segment (and generate the corresponding playlist).
-    return closeCurrentSegment(true);
+    // Flush buffered packets, instruct the writer thread to close the current
+    // segment (and generate the corresponding playlist), then exit.
+    const bool ok = flushPackets();
+    WriterQueue::MessagePtr cmd(new WriterCommand(WriterCommand::CLOSE));
+    cmd->bitrate = _pcrAnalyzer.bitrateIsValid() ? _pcrAnalyzer.bitrate188() : 0;
+    _queue.forceEnqueue(cmd);
+    waitForTermination();
+    return ok && !_writeError;
 }
 
 
 //----------------------------------------------------------------------------
-// Create the next segment file (also close the previous one if necessary).
+// Open the next segment file and pre-create the following one.
+// Invoked in the context of the segment writer thread.
 //----------------------------------------------------------------------------
 
-bool ts::hls::OutputPlugin::createNextSegment()
+bool ts::hls::OutputPlugin::openNextSegment()
 {
-    // Close the previous segment file.
-    if (!closeCurrentSegment(false)) {
-        return false;
-    }
-
-    // Generate a new segment file name.
-    const UString fileName(_nameGenerator.newFileName());
-
-    // Create the segment file.
-    tsp->verbose(u"creating media segment %s", {fileName});
-    if (!_segmentFile.open(fileName, TSFile::WRITE | TSFile::SHARED, *tsp)) {
-        return false;
-    }
-
-    // Reset the PCR analysis in each segment to get to bitrate of this segment.
-    _pcrAnalyzer.reset();
-
-    // Reset the indication to close the segment file.
-    _segClosePending = false;
-
-    // Add a copy of the PAT and PMT at the beginning of each segment.
-    if (!_sliceOnly) {
-        return writePackets(_patPackets.data(), _patPackets.size()) && writePackets(_pmtPackets.data(), _pmtPackets.size());
+    // Use the pre-created segment file when there is one. Otherwise (first
+    // segment or previous pre-creation failed), create the file now.
+    _currentFile ^= 1;
+    TSFile& file(_segmentFiles[_currentFile]);
+    if (!file.isOpen()) {
+        const UString fileName(_nameGenerator.newFileName());
+        tsp->verbose(u"creating media segment %s", {fileName});
+        if (!file.open(fileName, TSFile::WRITE | TSFile::SHARED, *tsp)) {
+            return false;
+        }
     }
 
-    return true;
+    // Pre-create the next segment file, outside any segment boundary, so that
+    // the next rollover does not wait for the file creation.
+    TSFile& next(_segmentFiles[_currentFile ^ 1]);
+    assert(!next.isOpen());
+    const UString nextName(_nameGenerator.newFileName());
+    tsp->verbose(u"pre-creating media segment %s", {nextName});
+    return next.open(nextName, TSFile::WRITE | TSFile::SHARED, *tsp);
 }
 
 
 //----------------------------------------------------------------------------
 // Close current segment file.
 // Also purge obsolete segment files and regenerate playlist.
+// Invoked in the context of the segment writer thread.
 //----------------------------------------------------------------------------
 
-bool ts::hls::OutputPlugin::closeCurrentSegment(bool endOfStream)
+bool ts::hls::OutputPlugin::closeCurrentSegment(bool endOfStream, const BitRate& bitrate)
 {
-    // If no segment file is open, there is nothing to do.
-    if (!_segmentFile.isOpen()) {
+    // At end of stream, delete the pre-created next segment file, if any.
+    // It is empty and was never referenced in the playlist.
+    if (endOfStream) {
+        TSFile& next(_segmentFiles[_currentFile ^ 1]);
+        if (next.isOpen()) {
+            const UString nextName(next.getFileName());
+            next.close(NULLREP);
+            fs::remove(nextName, &ErrCodeReport(*tsp, u"error deleting", nextName));
+        }
+    }
+
+    // If no segment file is open, there is nothing else to do.
+    TSFile& segmentFile(_segmentFiles[_currentFile]);
+    if (!segmentFile.isOpen()) {
         return true;
     }
 
     // Get the segment file name and size (to be inserted in the playlist).
-    const UString segName(_segmentFile.getFileName());
-    const PacketCounter segPackets = _segmentFile.writePacketsCount();
+    const UString segName(segmentFile.getFileName());
+    const PacketCounter segPackets = segmentFile.writePacketsCount();
 
     // Close the TS file.
-    if (!_segmentFile.close(*tsp)) {
+    if (!segmentFile.close(*tsp)) {
         return false;
     }
 
@@ -321,14 +348,15 @@ bool ts::hls::OutputPlugin::closeCurrentSegment(bool endOfStream)
         hls::MediaSegment seg;
         _playlist.buildURL(seg, segName);
 
-        // Estimate duration and bitrate of the segment. We use PCR's from the
-        // segment to compute the average bitrate. Then we compute the duration
-        // from the bitrate and segment file size. If we cannot get the bitrate
-        // of a segment but got one from previous segment, assume that bitrate
-        // did not change and reuse previous one.
-        if (_pcrAnalyzer.bitrateIsValid()) {
+        // Estimate duration and bitrate of the segment. The packet thread uses
+        // PCR's from the segment to compute the average bitrate and passes the
+        // estimate in the command. Then we compute the duration from the bitrate
+        // and segment file size. If we cannot get the bitrate of a segment but
+        // got one from previous segment, assume that bitrate did not change and
+        // reuse previous one.
+        if (bitrate > 0) {
             // We have an estimation of the bitrate of the segment file.
-            _previousBitrate = _pcrAnalyzer.bitrate188();
+            _previousBitrate = bitrate;
         }
         if (_previousBitrate > 0) {
             // Compute duration based on segment bitrate (or previous one).
@@ -454,41 +482,125 @@ void ts::hls::OutputPlugin::handleTable(SectionDemux& demux, const BinaryTable&
 
 
 //----------------------------------------------------------------------------
-// Write packets into the current segment file, adjust CC in PAT and PMT PID.
+// Enqueue the buffered packets to the segment writer thread.
+// Invoked in the context of the packet thread.
 //----------------------------------------------------------------------------
 
-bool ts::hls::OutputPlugin::writePackets(const TSPacket* pkt, size_t packetCount)
+bool ts::hls::OutputPlugin::flushPackets()
 {
-    // Temporary packet buffer if a packet needs to be modified.
-    TSPacket tmp;
+    bool ok = true;
+    if (!_pending.empty()) {
+        WriterQueue::MessagePtr cmd(new WriterCommand(WriterCommand::WRITE));
+        cmd->packets.swap(_pending);
+        ok = _queue.enqueue(cmd);
+        _pending.clear();
+        _pending.reserve(WRITE_CHUNK_PACKETS);
+    }
+    return ok;
+}
 
-    // Loop on all packets.
-    for (size_t i = 0; i < packetCount; ++i) {
 
-        // Address of the next packet to write.
-        const TSPacket* p = pkt + i;
+//----------------------------------------------------------------------------
+// Buffer one packet for the current segment, adjust CC in PAT and PMT PID.
+// Invoked in the context of the packet thread.
+//----------------------------------------------------------------------------
 
-        // If the packet comes from the PAT or PMT, get a copy and fix continuity counter.
-        if (!_sliceOnly) {
-            const PID pid = pkt[i].getPID();
-            if (pid == PID_PAT) {
-                tmp = *p;
-                _ccFixer.feedPacket(tmp);
-                p = &tmp;
+bool ts::hls::OutputPlugin::queuePacket(const TSPacket& pkt)
+{
+    // Buffer a copy of the packet. If it comes from the PAT or PMT, fix its continuity counter.
+    TSPacket& p(_pending.emplace_back(pkt));
+    if (!_sliceOnly) {
+        const PID pid = pkt.getPID();
+        if (pid == PID_PAT || (_pmtPID != PID_NULL && pid == _pmtPID)) {
+            _ccFixer.feedPacket(p);
+        }
+    }
+    _segPackets++;
+
+    // Pass the buffer to the writer thread when full.
+    return _pending.size() < WRITE_CHUNK_PACKETS || flushPackets();
+}
+
+
+//----------------------------------------------------------------------------
+// Flush buffered packets and instruct the writer thread to move to the next segment.
+// Invoked in the context of the packet thread.
+//----------------------------------------------------------------------------
+
+bool ts::hls::OutputPlugin::enqueueSegmentRenewal()
+{
+    // The buffered packets belong to the segment being closed, flush them first.
+    if (!flushPackets()) {
+        return false;
+    }
+
+    WriterQueue::MessagePtr cmd(new WriterCommand(WriterCommand::RENEW));
+
+    // Bitrate estimate of the segment being closed, for the playlist.
+    cmd->bitrate = _pcrAnalyzer.bitrateIsValid() ? _pcrAnalyzer.bitrate188() : 0;
+
+    // Add a copy of the PAT and PMT at the beginning of the new segment.
+    if (!_sliceOnly) {
+        for (const auto& pkt : _patPackets) {
+            _ccFixer.feedPacket(cmd->packets.emplace_back(pkt));
+        }
+        for (const auto& pkt : _pmtPackets) {
+            _ccFixer.feedPacket(cmd->packets.emplace_back(pkt));
+        }
+    }
+
+    // Reset the PCR analysis in each segment to get the bitrate of this segment.
+    _pcrAnalyzer.reset();
+
+    // Reset the per-segment state.
+    _segClosePending = false;
+    _segPackets = 0;
+
+    return _queue.enqueue(cmd);
+}
+
+
+//----------------------------------------------------------------------------
+// The segment writer thread.
+//----------------------------------------------------------------------------
+
+void ts::hls::OutputPlugin::main()
+{
+    tsp->debug(u"segment writer thread started");
+
+    WriterQueue::MessagePtr cmd;
+    bool terminate = false;
+    while (!terminate && _queue.dequeue(cmd)) {
+        bool ok = true;
+        switch (cmd->type) {
+            case WriterCommand::WRITE: {
+                // Write a chunk of packets into the current segment file.
+                TSFile& file(_segmentFiles[_currentFile]);
+                ok = !file.isOpen() || file.writePackets(cmd->packets.data(), nullptr, cmd->packets.size(), *tsp);
+                break;
             }
-            else if (_pmtPID != PID_NULL && pid == _pmtPID) {
-                tmp = *p;
-                _ccFixer.feedPacket(tmp);
-                p = &tmp;
+            case WriterCommand::RENEW: {
+                // Close the current segment, move to the next one, write the initial PAT and PMT.
+                ok = closeCurrentSegment(false, cmd->bitrate) &&
+                     openNextSegment() &&
+                     (cmd->packets.empty() || _segmentFiles[_currentFile].writePackets(cmd->packets.data(), nullptr, cmd->packets.size(), *tsp));
+                break;
+            }
+            case WriterCommand::CLOSE:
+            default: {
+                // Final close, then terminate the thread.
+                ok = closeCurrentSegment(true, cmd->bitrate);
+                terminate = true;
+                break;
             }
         }
-
-        // Write the packet in the segment file.
-        if (!_segmentFile.writePackets(p, nullptr, 1, *tsp)) {
-            return false;
+        if (!ok) {
+            _writeError = true;
         }
+        cmd.clear();
     }
-    return true;
+
+    tsp->debug(u"segment writer thread completed");
 }
 
 
@@ -499,7 +611,7 @@ bool ts::hls::OutputPlugin::writePackets(const TSPacket* pkt, size_t packetCount
 bool ts::hls::OutputPlugin::send(const TSPacket* pkt, const TSPacketMetadata* pktData, size_t packetCount)
 {
     const TSPacket* const lastPkt = pkt + packetCount;
-    bool ok = true;
+    bool ok = !_writeError;
 
     // Process packets one by one.
     while (ok && pkt < lastPkt) {
@@ -525,7 +637,7 @@ bool ts::hls::OutputPlugin::send(const TSPacket* pkt, const TSPacketMetadata* pk
             }
             if (_segStarted) {
                 // Create the first segment file.
-                ok = createNextSegment();
+                ok = enqueueSegmentRenewal();
             }
         }
 
@@ -537,7 +649,7 @@ bool ts::hls::OutputPlugin::send(const TSPacket* pkt, const TSPacketMetadata* pk
             bool renewOnPUSI = false;
             if (_fixedSegmentSize > 0) {
                 // Each segment shall have a fixed size.
-                renewNow = _segmentFile.writePacketsCount() >= _fixedSegmentSize;
+                renewNow = _segPackets >= _fixedSegmentSize;
             }
             else if (!_segClosePending) {
                 if (pktData->hasAnyLabel(_closeLabels)) {
@@ -546,7 +658,7 @@ bool ts::hls::OutputPlugin::send(const TSPacket* pkt, const TSPacketMetadata* pk
                 }
                 else if (_pcrAnalyzer.bitrateIsValid()) {
                     // The segment file shall be closed when the estimated duration exceeds the target duration.
-                    const MilliSecond segDuration = PacketInterval(_pcrAnalyzer.bitrate188(), _segmentFile.writePacketsCount());
+                    const MilliSecond segDuration = PacketInterval(_pcrAnalyzer.bitrate188(), _segPackets);
                     _segClosePending = segDuration >= _targetDuration * MilliSecPerSec;
                     // With --intra-close, force renew on next PES packet if extra duration is exceeded.
                     renewOnPUSI = segDuration >= (_targetDuration + _maxExtraDuration) * MilliSecPerSec;
@@ -577,8 +689,8 @@ bool ts::hls::OutputPlugin::send(const TSPacket* pkt, const TSPacketMetadata* pk
             }
 
             // Close current segment and recreate a new one when necessary.
-            // Finally write the packet.
-            ok = (!renewNow || createNextSegment()) && writePackets(pkt, 1);
+            // Finally buffer the packet for the writer thread.
+            ok = (!renewNow || enqueueSegmentRenewal()) && queuePacket(*pkt);
         }
 
         // Process next packet.
@@ -19,6 +19,8 @@
 #include "tsContinuityAnalyzer.h"
 #include "tsFileNameGenerator.h"
 #include "tshlsPlayList.h"
+#include "tsMessageQueue.h"
+#include "tsThread.h"
 
 namespace ts {
     namespace hls {
@@ -31,7 +33,11 @@ namespace ts {
         //! playlists. To setup a complete HLS server, it is necessary to setup an
         //! external HTTP server such as Apache which simply serves these files.
         //!
-        class TSDUCKDLL OutputPlugin: public ts::OutputPlugin, private TableHandlerInterface
+        //! All file and playlist operations are performed by an internal segment
+        //! writer thread. The packet thread only buffers packets and posts commands,
+        //! so that segment rollovers do not create latency spikes on the packet path.
+        //!
+        class TSDUCKDLL OutputPlugin: public ts::OutputPlugin, private TableHandlerInterface, private Thread
         {
             TS_PLUGIN_CONSTRUCTORS(OutputPlugin);
         public:
@@ -43,6 +49,19 @@ namespace ts {
             virtual bool send(const TSPacket*, const TSPacketMetadata* pkt_data, size_t) override;
 
         private:
+            // Command to the segment writer thread.
+            class WriterCommand
+            {
+            public:
+                enum Type {WRITE, RENEW, CLOSE};
+                Type           type;                 // Command type.
+                TSPacketVector packets {};           // Packets to write (WRITE) or header packets of the new segment (RENEW).
+                BitRate        bitrate = 0;          // Bitrate estimate of the segment being closed (RENEW, CLOSE), zero if unknown.
+
+                WriterCommand(Type t = WRITE) : type(t) {}
+            };
+            typedef MessageQueue<WriterCommand, std::mutex> WriterQueue;
+
             // Command line options.
             UString            _segmentTemplate {};         // Command line segment file names template.
             UString            _playlistFile {};            // Playlist file name.
@@ -70,24 +89,38 @@ namespace ts {
             uint8_t            _videoStreamType = ST_NULL;  // Stream type for video PID in PMT.
             bool               _segStarted = false;         // Generation of output segments has started.
             bool               _segClosePending = false;    // Close the current segment when possible.
-            TSFile             _segmentFile {};             // Output segment file.
-            UStringList        _liveSegmentFiles {};        // List of current segments in a live stream.
-            hls::PlayList      _playlist {};                // Generated playlist.
+            TSPacketVector     _pending {};                 // Buffered packets, not yet passed to the writer thread.
+            PacketCounter      _segPackets = 0;             // Number of packets queued for the current segment.
+            WriterQueue        _queue {};                   // Command queue to the segment writer thread.
+            volatile bool      _writeError = false;         // An error occurred in the segment writer thread.
+            TSFile             _segmentFiles[2] {};         // Current and pre-created next segment files (writer thread).
+            size_t             _currentFile = 0;            // Index of current segment file in _segmentFiles (writer thread).
+            UStringList        _liveSegmentFiles {};        // List of current segments in a live stream (writer thread).
+            hls::PlayList      _playlist {};                // Generated playlist (writer thread).
             PCRAnalyzer        _pcrAnalyzer {1, 4};         // PCR analyzer to compute bitrates. Minimum required: 1 PID, 4 PCR.
-            BitRate            _previousBitrate = 0;        // Bitrate of previous segment.
+            BitRate            _previousBitrate = 0;        // Bitrate of previous segment (writer thread).
             ContinuityAnalyzer _ccFixer;                    // To fix continuity counters in PAT and PMT PID's.
 
-            // Create the next segment file (also close the previous one if necessary).
-            bool createNextSegment();
+            // Enqueue the buffered packets to the segment writer thread (packet thread).
+            bool flushPackets();
+
+            // Buffer one packet for the current segment, adjust CC in PAT and PMT PID (packet thread).
+            bool queuePacket(const TSPacket&);
+
+            // Flush buffered packets and instruct the writer thread to move to the next segment (packet thread).
+            bool enqueueSegmentRenewal();
+
+            // Open the next segment file and pre-create the following one (writer thread).
+            bool openNextSegment();
 
-            // Close current segment file (also purge obsolete segment files and regenerate playlist).
-            bool closeCurrentSegment(bool endOfStream);
+            // Close current segment file (also purge obsolete segment files and regenerate playlist) (writer thread).
+            bool closeCurrentSegment(bool endOfStream, const BitRate& bitrate);
 
             // Implementation of TableHandlerInterface.
             virtual void handleTable(SectionDemux&, const BinaryTable&) override;
 
-            // Write packets into the current segment file, adjust CC in PAT and PMT PID.
-            bool writePackets(const TSPacket*, size_t);
+            // Implementation of Thread: the segment writer thread.
+            virtual void main() override;
         };
     }
 }
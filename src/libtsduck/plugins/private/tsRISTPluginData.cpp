@@ -7,6 +7,7 @@
 //----------------------------------------------------------------------------
 
 #include "tsRISTPluginData.h"
+#include "tsPluginEventData.h"
 
 #if defined(TS_NO_RIST)
 TS_LLVM_NOWARNING(missing-variable-declarations)
@@ -17,8 +18,9 @@ bool tsRISTPluginDataIsEmpty = true; // Avoid warning about empty module.
 // Input/output common data constructor.
 //----------------------------------------------------------------------------
 
-ts::RISTPluginData::RISTPluginData(Report& report) :
-    _report(report)
+ts::RISTPluginData::RISTPluginData(TSP* tsp) :
+    _tsp(tsp),
+    _report(*tsp)
 {
     log.log_level = SeverityToRistLog(_report.maxSeverity());
     log.log_cb = LogCallback;
@@ -86,6 +88,16 @@ void ts::RISTPluginData::defineArgs(Args& args)
     args.help(u"stats-prefix", u"'prefix'",
               u"With --stats-interval, specify a prefix to prepend on the statistics line "
               u"before the JSON text to locate the appropriate line in the logs.");
+
+    args.option(u"event-code", 0, Args::UINT32);
+    args.help(u"event-code",
+              u"This option is for C++, Java or Python developers only.\n\n"
+              u"Signal a plugin event with the specified code each time librist reports "
+              u"statistics. The event data is an instance of PluginEventData pointing to "
+              u"the statistics in JSON format, including the per-link counters (RTT, "
+              u"received, missing, recovered, etc). This can be used to feed monitoring "
+              u"applications without parsing the log. The reporting interval is set with "
+              u"--stats-interval (default: 1000 ms with --event-code alone).");
 }
 
 
@@ -106,6 +118,8 @@ bool ts::RISTPluginData::loadArgs(DuckContext& duck, Args& args)
     args.getValue(_secret, u"secret");
     args.getIntValue(_stats_interval, u"stats-interval", 0);
     args.getValue(_stats_prefix, u"stats-prefix");
+    _signal_event = args.present(u"event-code");
+    args.getIntValue(_event_code, u"event-code");
 
     // Client address filter lists.
     if (!getSocketValues(args, _allowed, u"allow") || !getSocketValues(args, _denied, u"deny")) {
@@ -204,8 +218,9 @@ bool ts::RISTPluginData::getSocketValues(Args& args, IPv4SocketAddressVector& li
 
 bool ts::RISTPluginData::addPeers()
 {
-    // Setup statistics callback if required.
-    if (_stats_interval > 0 && ::rist_stats_callback_set(ctx, _stats_interval, StatsCallback, this) < 0) {
+    // Setup statistics callback if required. With --event-code alone, use a default interval.
+    const int stats_interval = _stats_interval > 0 ? _stats_interval : (_signal_event ? 1000 : 0);
+    if (stats_interval > 0 && ::rist_stats_callback_set(ctx, stats_interval, StatsCallback, this) < 0) {
         _report.warning(u"error setting statistics callback");
     }
 
@@ -374,7 +389,16 @@ int ts::RISTPluginData::StatsCallback(void* arg, const ::rist_stats* stats)
 {
     RISTPluginData* data = reinterpret_cast<RISTPluginData*>(arg);
     if (data != nullptr && stats != nullptr) {
-        data->_report.info(u"%s%s", {data->_stats_prefix, stats->stats_json});
+        // Log the statistics line when --stats-interval was specified.
+        if (data->_stats_interval > 0) {
+            data->_report.info(u"%s%s", {data->_stats_prefix, stats->stats_json});
+        }
+        // Signal the statistics as a plugin event if requested. The callback
+        // registry is thread-safe, this callback runs on a librist thread.
+        if (data->_signal_event && stats->stats_json != nullptr) {
+            PluginEventData event(reinterpret_cast<const uint8_t*>(stats->stats_json), std::strlen(stats->stats_json));
+            data->_tsp->signalPluginEvent(data->_event_code, &event);
+        }
         ::rist_stats_free(stats);
     }
     return 0; // undocumented, 0 seems safe
@@ -30,9 +30,9 @@ namespace ts {
         //!
         //! Constructor.
         //! Also define common command line arguments for RIST plugins.
-        //! @param [in,out] report Where to report errors.
+        //! @param [in] tsp Object to communicate with the Transport Stream Processor main executable.
         //!
-        RISTPluginData(Report& report);
+        RISTPluginData(TSP* tsp);
 
         //!
         //! Destructor.
@@ -72,12 +72,15 @@ namespace ts {
 
     private:
         // Working data.
+        TSP*     _tsp;
         Report&  _report;
         uint32_t _buffer_size = 0;
         int      _encryption_type = 0;
         UString  _secret {};
         int      _stats_interval = 0;
         UString  _stats_prefix {};
+        bool     _signal_event = false;
+        uint32_t _event_code = 0;
         IPv4SocketAddressVector          _allowed {};
         IPv4SocketAddressVector          _denied {};
         UStringVector                    _peer_urls {};
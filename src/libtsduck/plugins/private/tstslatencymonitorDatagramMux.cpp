@@ -0,0 +1,168 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Amos Cheung
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tstslatencymonitorDatagramMux.h"
+#include "tsLatencyMonitor.h"
+#include "tsIPProtocols.h"
+#include "tsSysUtils.h"
+
+
+//----------------------------------------------------------------------------
+// Constructor and destructor.
+//----------------------------------------------------------------------------
+
+ts::tslatencymonitor::DatagramMux::DatagramMux(const LatencyMonitorArgs& opt, LatencyMonitor& monitor, Report& log) :
+    // Same rationale as the input executor threads: stay ready to drain incoming datagrams.
+    Thread(ThreadAttributes().setPriority(ThreadAttributes::GetHighPriority())),
+    _log(log),
+    _monitor(monitor),
+    _args(opt),
+    _duck(&log)
+{
+}
+
+ts::tslatencymonitor::DatagramMux::~DatagramMux()
+{
+    waitForTermination();
+}
+
+
+//----------------------------------------------------------------------------
+// Open all input sockets and start the multiplexer thread.
+//----------------------------------------------------------------------------
+
+bool ts::tslatencymonitor::DatagramMux::start()
+{
+    for (size_t i = 0; i < _args.inputs.size(); ++i) {
+        const PluginOptions& opt(_args.inputs[i]);
+
+        // Only direct UDP reception can be multiplexed on sockets.
+        if (opt.name != u"ip") {
+            _log.error(u"--event-driven supports UDP datagram inputs only, not plugin \"%s\"", {opt.name});
+            return false;
+        }
+
+        // Parse the UDP reception options of this input. Only the socket-level
+        // options of the "ip" plugin are supported in event-driven mode.
+        Args parser(UString(), u"[options] [address:]port",
+                    Args::NO_EXIT_ON_ERROR | Args::NO_EXIT_ON_HELP | Args::NO_EXIT_ON_VERSION | Args::NO_HELP | Args::NO_VERSION);
+        auto ctx = std::make_unique<InputContext>(_log);
+        ctx->sock.defineArgs(parser, true, true, false);
+        if (!parser.analyze(UString::Format(u"%s[%d]", {opt.name, i}), opt.args, false)) {
+            _log.error(u"invalid options for input #%d in event-driven mode", {i});
+            return false;
+        }
+        if (!ctx->sock.loadArgs(_duck, parser) || !ctx->sock.open(_log)) {
+            return false;
+        }
+        _inputs.push_back(std::move(ctx));
+    }
+
+    return Thread::start();
+}
+
+
+//----------------------------------------------------------------------------
+// Wait for a ready input socket, round-robin selection.
+//----------------------------------------------------------------------------
+
+bool ts::tslatencymonitor::DatagramMux::waitReadyInput(size_t& index)
+{
+    // Wait for incoming data on any of the sockets.
+    ::fd_set fds;
+    FD_ZERO(&fds);
+    SysSocketType max_sock = 0; // first select() parameter, unused on Windows
+    for (const auto& ctx : _inputs) {
+        const SysSocketType s = ctx->sock.getSocket();
+        if (s == SYS_SOCKET_INVALID) {
+            return false;
+        }
+        FD_SET(s, &fds);
+#if !defined(TS_WINDOWS)
+        max_sock = std::max(max_sock, s);
+#endif
+    }
+    if (::select(int(max_sock) + 1, &fds, nullptr, nullptr, nullptr) <= 0) {
+        _log.debug(u"socket select error: %s", {SysSocketErrorCodeMessage()});
+        return false;
+    }
+
+    // Pick a ready socket, starting after the previously selected one so that
+    // a flooded low-index input cannot starve the other ones.
+    for (size_t i = 0; i < _inputs.size(); ++i) {
+        const size_t current = (_next_input + i) % _inputs.size();
+        if (FD_ISSET(_inputs[current]->sock.getSocket(), &fds)) {
+            index = current;
+            _next_input = (current + 1) % _inputs.size();
+            return true;
+        }
+    }
+    return false; // should not happen, select() reported at least one ready socket
+}
+
+
+//----------------------------------------------------------------------------
+// Invoked in the context of the multiplexer thread.
+//----------------------------------------------------------------------------
+
+void ts::tslatencymonitor::DatagramMux::main()
+{
+    _log.debug(u"datagram multiplexer thread started, %d inputs", {_inputs.size()});
+
+    // Reception buffers. A datagram never holds more TS packets than this.
+    ByteBlock inbuf(IP_MAX_PACKET_SIZE);
+    const size_t max_packets = IP_MAX_PACKET_SIZE / PKT_SIZE;
+    TSPacketVector buffer(max_packets);
+    TSPacketMetadataVector metadata(max_packets);
+
+    for (;;) {
+        // Wait for a datagram on any input.
+        size_t index = 0;
+        if (!waitReadyInput(index)) {
+            break;
+        }
+
+        // Read one datagram from the ready socket.
+        size_t insize = 0;
+        MicroSecond timestamp = -1;
+        IPv4SocketAddress sender;
+        IPv4SocketAddress destination;
+        UDPReceiver& sock(_inputs[index]->sock);
+        if (!sock.receive(inbuf.data(), inbuf.size(), insize, sender, destination, nullptr, _log, &timestamp)) {
+            break;
+        }
+
+        // Look for TS packets in the UDP message (same heuristics as the datagram input plugins).
+        size_t start_index = 0;
+        size_t count = 0;
+        if (!TSPacket::Locate(inbuf.data(), insize, start_index, count)) {
+            continue;
+        }
+        count = std::min(count, max_packets);
+
+        // Look for an RTP header before the first packet, use its time stamp
+        // when the kernel did not provide one.
+        const bool rtp = start_index >= RTP_HEADER_SIZE && (inbuf[1] & 0x7F) == RTP_PT_MP2T;
+        for (size_t i = 0; i < count; ++i) {
+            buffer[i].copyFrom(inbuf.data() + start_index + i * PKT_SIZE);
+            metadata[i].reset();
+            if (timestamp >= 0) {
+                metadata[i].setInputTimeStamp(uint64_t(timestamp), MicroSecPerSec, TimeSource::KERNEL);
+            }
+            else if (rtp) {
+                // RTP time stamp unit is 90 kHz (RTP_RATE_MP2T)
+                metadata[i].setInputTimeStamp(GetUInt32(inbuf.data() + 4), RTP_RATE_MP2T, TimeSource::RTP);
+            }
+        }
+
+        // Pass packets to monitor for analyzing.
+        _monitor.processPacket(buffer, metadata, count, index);
+    }
+
+    _log.debug(u"datagram multiplexer thread terminated");
+}
@@ -0,0 +1,82 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Amos Cheung
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Latency monitor (tslatencymonitor) event-driven datagram multiplexer.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsThread.h"
+#include "tsLatencyMonitorArgs.h"
+#include "tsUDPReceiver.h"
+#include "tsDuckContext.h"
+
+namespace ts {
+
+    class LatencyMonitor;
+
+    namespace tslatencymonitor {
+        //!
+        //! Event-driven datagram input multiplexer of tslatencymonitor.
+        //! @ingroup plugin
+        //!
+        //! With option --event-driven, all UDP inputs are received in one
+        //! single thread which waits on all sockets at once, instead of one
+        //! input plugin executor thread per input. This scales to a large
+        //! number of monitored inputs with a single thread.
+        //!
+        class DatagramMux : public Thread
+        {
+            TS_NOBUILD_NOCOPY(DatagramMux);
+        public:
+            //!
+            //! Constructor.
+            //! @param [in] opt Command line options.
+            //! @param [in,out] monitor Monitor instance.
+            //! @param [in,out] log Log report.
+            //!
+            DatagramMux(const LatencyMonitorArgs& opt, LatencyMonitor& monitor, Report& log);
+
+            //!
+            //! Virtual destructor.
+            //!
+            ~DatagramMux() override;
+
+            //!
+            //! Open all input sockets and start the multiplexer thread.
+            //! All inputs must be UDP datagram inputs (plugin "ip").
+            //! @return True on success, false on error.
+            //!
+            bool start();
+
+        private:
+            // Context of one monitored input.
+            class InputContext
+            {
+                TS_NOBUILD_NOCOPY(InputContext);
+            public:
+                InputContext(Report& report) : sock(report) {}
+                UDPReceiver sock;
+            };
+
+            Report&            _log;        // Log report.
+            LatencyMonitor&    _monitor;    // Monitor core instance.
+            LatencyMonitorArgs _args;       // Command line options.
+            DuckContext        _duck;       // TSDuck execution context for options parsing.
+            size_t             _next_input = 0;  // Round-robin index over ready sockets.
+            std::vector<std::unique_ptr<InputContext>> _inputs {};  // One context per input.
+
+            // Wait for a ready input socket, round-robin selection.
+            bool waitReadyInput(size_t& index);
+
+            // Implementation of Thread.
+            void main() override;
+        };
+    }
+}
@@ -403,6 +403,10 @@ ts::tsmux::Core::Input::Input(Core& core, size_t index) :
     _next_insertion(0),
     _next_packet(),
     _next_metadata(),
+    _pkt_buffer(core._opt.maxInputPackets),
+    _mdata_buffer(core._opt.maxInputPackets),
+    _buffer_next(0),
+    _buffer_count(0),
     _pid_clocks()
 {
     // Filter all global PSI/SI for merging in output PSI.
@@ -451,12 +455,19 @@ bool ts::tsmux::Core::Input::getPacket(TSPacket& pkt, TSPacketMetadata& pkt_data
         }
     }
 
-    // Get one packet from the input executor thread, non-blocking.
-    size_t ret_count = 0;
-    _terminated = _terminated || !_input.getPackets(&pkt, &pkt_data, 1, ret_count, false);
-    if (_terminated || ret_count == 0) {
-        return false;
+    // Get one packet from the local prefetch buffer. When it is empty, refill
+    // it from the input executor thread, non-blocking. Getting packets by
+    // batches avoids one lock/unlock of the executor mutex per packet.
+    if (_buffer_next >= _buffer_count) {
+        _buffer_next = _buffer_count = 0;
+        _terminated = _terminated || !_input.getPackets(_pkt_buffer.data(), _mdata_buffer.data(), _pkt_buffer.size(), _buffer_count, false);
+        if (_terminated || _buffer_count == 0) {
+            return false;
+        }
     }
+    pkt = _pkt_buffer[_buffer_next];
+    pkt_data = _mdata_buffer[_buffer_next];
+    _buffer_next++;
     const PID pid = pkt.getPID();
 
     // Feed the two PSI/SI demux.
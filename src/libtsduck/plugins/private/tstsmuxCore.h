@@ -172,6 +172,10 @@ namespace ts {
                 PacketCounter    _next_insertion; // Insertion point of next packet.
                 TSPacket         _next_packet;    // Next packet to insert if already received but not yet inserted.
                 TSPacketMetadata _next_metadata;  // Associated metadata.
+                TSPacketVector   _pkt_buffer;     // Prefetch buffer of packets from the input executor.
+                TSPacketMetadataVector _mdata_buffer; // Associated metadata.
+                size_t           _buffer_next;    // Next packet to read in _pkt_buffer.
+                size_t           _buffer_count;   // Number of valid packets in _pkt_buffer.
                 std::map<PID,PIDClock> _pid_clocks;  // Output clock of each input PID.
 
                 // Adjust the PCR of a packet before insertion.
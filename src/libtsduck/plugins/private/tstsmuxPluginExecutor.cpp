@@ -73,8 +73,11 @@ size_t ts::tsmux::PluginExecutor::pluginCount() const
 
 void ts::tsmux::PluginExecutor::signalPluginEvent(uint32_t event_code, Object* plugin_data) const
 {
-    const PluginEventContext ctx(event_code, pluginName(), pluginIndex(), pluginCount(), plugin(), plugin_data, bitrate(), pluginPackets(), totalPacketsInThread());
-    _handlers.callEventHandlers(ctx);
+    // Build the event context only when at least one handler may match.
+    if (_handlers.hasEventHandlers(event_code)) {
+        const PluginEventContext ctx(event_code, pluginName(), pluginIndex(), pluginCount(), plugin(), plugin_data, bitrate(), pluginPackets(), totalPacketsInThread());
+        _handlers.callEventHandlers(ctx);
+    }
 }
 
 
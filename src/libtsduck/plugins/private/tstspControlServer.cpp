@@ -12,6 +12,9 @@
 #include "tsReportBuffer.h"
 #include "tsTelnetConnection.h"
 #include "tsSysUtils.h"
+#include "tsDuckContext.h"
+#include "tsjsonObject.h"
+#include "tsjsonOutputArgs.h"
 
 
 //----------------------------------------------------------------------------
@@ -46,6 +49,7 @@ ts::tsp::ControlServer::ControlServer(TSProcessorArgs& options, Report& log, std
     _reference.setCommandLineHandler(this, &ControlServer::executeExit, u"exit");
     _reference.setCommandLineHandler(this, &ControlServer::executeSetLog, u"set-log");
     _reference.setCommandLineHandler(this, &ControlServer::executeList, u"list");
+    _reference.setCommandLineHandler(this, &ControlServer::executeMetrics, u"metrics");
     _reference.setCommandLineHandler(this, &ControlServer::executeSuspend, u"suspend");
     _reference.setCommandLineHandler(this, &ControlServer::executeResume, u"resume");
     _reference.setCommandLineHandler(this, &ControlServer::executeRestart, u"restart");
@@ -133,15 +137,35 @@ void ts::tsp::ControlServer::main()
             conn.sendLine("error: client address is not authorized", _log);
         }
         else if (conn.setReceiveTimeout(_options.control_timeout, _log) && conn.receiveLine(line, nullptr, _log)) {
-            _log.verbose(u"received from %s: %s", {source, line});
+            if (line == u"--session") {
+                // Persistent control session: serve pipelined commands on the same
+                // connection. Each response is terminated by a "--end" line so that
+                // the client does not need the end of stream to frame responses.
+                // The receive timeout still applies between two commands, an idle
+                // session is closed.
+                _log.verbose(u"control session started from %s", {source});
+                conn.sendLine(u"--ready", _log);
+                while (!_terminate && conn.receiveLine(line, nullptr, _log) && !line.empty()) {
+                    _log.verbose(u"received from %s: %s", {source, line});
+                    conn.setMaxSeverity(Severity::Info);
+                    if (_reference.processCommand(line, &conn) != CommandStatus::SUCCESS) {
+                        conn.error(u"invalid tsp control command: %s", {line});
+                    }
+                    conn.sendLine(u"--end", _log);
+                }
+                _log.verbose(u"control session from %s completed", {source});
+            }
+            else {
+                _log.verbose(u"received from %s: %s", {source, line});
 
-            // Reset the severity of the connection before analysing the line.
-            // A previous analysis may have used --verbose or --debug.
-            conn.setMaxSeverity(Severity::Info);
+                // Reset the severity of the connection before analysing the line.
+                // A previous analysis may have used --verbose or --debug.
+                conn.setMaxSeverity(Severity::Info);
 
-            // Analyze the command, return errors on the client connection.
-            if (_reference.processCommand(line, &conn) != CommandStatus::SUCCESS) {
-                conn.error(u"invalid tsp control command: %s", {line});
+                // Analyze the command, return errors on the client connection.
+                if (_reference.processCommand(line, &conn) != CommandStatus::SUCCESS) {
+                    conn.error(u"invalid tsp control command: %s", {line});
+                }
             }
         }
 
@@ -240,6 +264,106 @@ void ts::tsp::ControlServer::listOnePlugin(size_t index, UChar type, PluginExecu
 }
 
 
+//----------------------------------------------------------------------------
+// Metrics command.
+//----------------------------------------------------------------------------
+
+ts::CommandStatus ts::tsp::ControlServer::executeMetrics(const UString& command, Args& args)
+{
+    json::OutputArgs json;
+    DuckContext duck(&_log);
+    if (!json.loadArgs(duck, args)) {
+        return CommandStatus::ERROR;
+    }
+
+    // Optional subscription mode: repeat the report at regular intervals,
+    // pushing the metrics on the same connection.
+    const Second interval = args.intValue<Second>(u"interval", 0);
+    const size_t count = args.intValue<size_t>(u"count", 0);
+
+    for (size_t iter = 0; ; ++iter) {
+        if (iter > 0) {
+            // Wait between two reports, in small slices, to detect tsp termination.
+            for (Second sec = 0; sec < interval && !_terminate; ++sec) {
+                SleepThread(MilliSecPerSec);
+            }
+            if (_terminate) {
+                break;
+            }
+        }
+
+        if (json.useJSON()) {
+            // Build a JSON description of all plugins.
+            json::Object root;
+            metricsOnePlugin(0, u'I', _input, &root, args);
+            size_t index = 1;
+            for (size_t i = 0; i < _plugins.size(); ++i) {
+                metricsOnePlugin(index++, u'P', _plugins[i], &root, args);
+            }
+            metricsOnePlugin(index, u'O', _output, &root, args);
+
+            if (json.useFile()) {
+                // With --json, report the JSON text on the client connection.
+                args.info(root.printed(2, args));
+            }
+            else {
+                // Other JSON modes (one-liner, TCP, UDP) do not use the output stream.
+                json.report(root, std::cout, args);
+            }
+        }
+        else {
+            // Plain text report, one line per plugin.
+            metricsOnePlugin(0, u'I', _input, nullptr, args);
+            size_t index = 1;
+            for (size_t i = 0; i < _plugins.size(); ++i) {
+                metricsOnePlugin(index++, u'P', _plugins[i], nullptr, args);
+            }
+            metricsOnePlugin(index, u'O', _output, nullptr, args);
+        }
+
+        if (interval == 0 || (count != 0 && iter + 1 >= count)) {
+            break;
+        }
+    }
+    return CommandStatus::SUCCESS;
+}
+
+void ts::tsp::ControlServer::metricsOnePlugin(size_t index, UChar type, PluginExecutor* plugin, json::Value* parent, Report& report)
+{
+    // Get a snapshot of the counters of this executor. No need to suspend the
+    // plugin, the counters are only written by the executor thread itself.
+    PluginExecutor::Metrics m;
+    plugin->getMetrics(m);
+
+    // Note: the input executor waits when the buffer is full (back-pressure
+    // from the rest of the chain) while the other executors wait when their
+    // area of the buffer is empty (starvation from the previous plugins).
+    if (parent != nullptr) {
+        json::Value& jv(parent->query(u"plugins[]", true));
+        jv.add(u"index", index);
+        jv.add(u"type", UString(1, type));
+        jv.add(u"plugin", plugin->pluginName());
+        jv.add(u"packets", m.packets);
+        jv.add(u"waits", m.waits);
+        jv.add(u"wait-ms", m.wait_time);
+        jv.add(u"timeouts", m.timeouts);
+        jv.add(u"cpu-ms", m.cpu_time);
+        json::Value& occ(jv.query(u"buffer-occupancy", true, json::Type::Array));
+        for (const auto& count : m.occupancy) {
+            occ.set(count);
+        }
+    }
+    else {
+        UString occ;
+        for (const auto& count : m.occupancy) {
+            occ.format(u"%s%d", {occ.empty() ? u"" : u" ", count});
+        }
+        report.info(u"%2d: %c %s: packets: %'d, waits: %'d (%'d ms), timeouts: %'d, cpu: %'d ms, occupancy: [%s]",
+                    {index, type, plugin->pluginName(), m.packets, m.waits, m.wait_time, m.timeouts, m.cpu_time, occ});
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Suspend/resume commands.
 //----------------------------------------------------------------------------
@@ -293,6 +417,7 @@ ts::CommandStatus ts::tsp::ControlServer::executeRestart(const UString& command,
 
     // Same we use new parameters?
     const bool same = args.present(u"same");
+    const bool hot = args.present(u"hot");
     if (same && !params.empty()) {
         args.error(u"do not specify new plugin options with --same");
         return CommandStatus::ERROR;
@@ -312,10 +437,10 @@ ts::CommandStatus ts::tsp::ControlServer::executeRestart(const UString& command,
 
     // Restart the plugin.
     if (same) {
-        plugin->restart(args);
+        plugin->restart(hot, args);
     }
     else {
-        plugin->restart(params, args);
+        plugin->restart(params, hot, args);
     }
     return CommandStatus::SUCCESS;
 }
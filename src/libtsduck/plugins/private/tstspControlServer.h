@@ -20,6 +20,7 @@
 #include "tsThread.h"
 #include "tsTCPServer.h"
 #include "tsReportWithPrefix.h"
+#include "tsjsonValue.h"
 
 namespace ts {
     namespace tsp {
@@ -77,6 +78,8 @@ namespace ts {
             CommandStatus executeSetLog(const UString&, Args&);
             CommandStatus executeList(const UString&, Args&);
             void listOnePlugin(size_t index, UChar type, PluginExecutor* plugin, Report& report);
+            CommandStatus executeMetrics(const UString&, Args&);
+            void metricsOnePlugin(size_t index, UChar type, PluginExecutor* plugin, json::Value* parent, Report& report);
             CommandStatus executeSuspend(const UString&, Args&);
             CommandStatus executeResume(const UString&, Args&);
             CommandStatus executeSuspendResume(bool state, Args&);
@@ -8,6 +8,7 @@
 
 #include "tstspInputExecutor.h"
 #include "tsTime.h"
+#include "tsProbes.h"
 
 // Minimum number of PID's and PCR/DTS to analyze before getting a valid bitrate.
 #define MIN_ANALYZE_PID   1
@@ -46,6 +47,14 @@ ts::tsp::InputExecutor::InputExecutor(const TSProcessorArgs& options,
         debug(u"%s input plugin does not support receive timeout, using watchdog and abort", {pluginName()});
         _use_watchdog = true;
     }
+
+    // Configure the optional CRC validation of PSI/SI sections at input level.
+    _crc_validate = options.validate_crc_pids.any();
+    if (_crc_validate) {
+        _crc_demux.setPIDFilter(options.validate_crc_pids);
+        _crc_demux.setInvalidSectionHandler(this);
+        _crc_demux.setTransportErrorLogLevel(Severity::Warning);
+    }
 }
 
 ts::tsp::InputExecutor::~InputExecutor()
@@ -170,6 +179,18 @@ size_t ts::tsp::InputExecutor::pluginIndex() const
 }
 
 
+//----------------------------------------------------------------------------
+// Replace the plugin instance during a hot restart.
+//----------------------------------------------------------------------------
+
+ts::Plugin* ts::tsp::InputExecutor::replacePlugin(Plugin* new_plugin)
+{
+    Plugin* const previous = PluginExecutor::replacePlugin(new_plugin);
+    _input = dynamic_cast<InputPlugin*>(plugin());
+    return previous;
+}
+
+
 //----------------------------------------------------------------------------
 // Implementation of WatchDogHandlerInterface
 //----------------------------------------------------------------------------
@@ -183,6 +204,24 @@ void ts::tsp::InputExecutor::handleWatchDogTimeout(WatchDog& watchdog)
 }
 
 
+//----------------------------------------------------------------------------
+// Implementation of SectionHandlerInterface and InvalidSectionHandlerInterface
+//----------------------------------------------------------------------------
+
+void ts::tsp::InputExecutor::handleSection(SectionDemux& demux, const Section& section)
+{
+    // Registering a section handler forces the demux to rebuild each section
+    // and check its CRC32. There is nothing to do on valid sections.
+}
+
+void ts::tsp::InputExecutor::handleInvalidSection(SectionDemux& demux, const DemuxedData& data)
+{
+    // The only possible error is an invalid CRC32. The demux logs the error
+    // at the configured level. Remember it for the packet being validated.
+    _crc_error = true;
+}
+
+
 //----------------------------------------------------------------------------
 // Receive null packets.
 //----------------------------------------------------------------------------
@@ -193,12 +232,13 @@ size_t ts::tsp::InputExecutor::receiveNullPackets(size_t index, size_t max_packe
     TSPacketMetadata* const data = _metadata->base() + index;
 
     // Fill the buffer with null packets.
+    TSPacketMetadata::Reset(data, max_packets);
     for (size_t n = 0; n < max_packets; ++n) {
         pkt[n] = NullPacket;
         _pcr_analyzer.feedPacket(pkt[n]);
         _dts_analyzer.feedPacket(pkt[n]);
-        data[n].reset();
         data[n].setInputStuffing(true);
+        data[n].setPCR(INVALID_PCR); // null packets never carry a PCR
     }
 
     // Count those packets as not coming from the real input plugin.
@@ -222,10 +262,10 @@ size_t ts::tsp::InputExecutor::receiveAndValidate(size_t index, size_t max_packe
     TSPacket* const pkt = _buffer->base() + index;
     TSPacketMetadata* const data = _metadata->base() + index;
 
-    // Reset metadata for new incoming packets.
-    for (size_t n = 0; n < max_packets; ++n) {
-        data[n].reset();
-    }
+    // Reset metadata for new incoming packets. One vectorized pattern fill
+    // instead of a per-packet reset() loop, this is a fixed cost on each
+    // receive operation.
+    TSPacketMetadata::Reset(data, max_packets);
 
     // Invoke the plugin receive method
     if (_use_watchdog) {
@@ -237,10 +277,14 @@ size_t ts::tsp::InputExecutor::receiveAndValidate(size_t index, size_t max_packe
         _watchdog.suspend();
     }
 
+    // Static tracing probe on packet receipt from the input plugin.
+    TS_PROBE1(input_receive, count);
+
     // Fill input time stamps with monotonic clock if none was provided by the input plugin.
     // Only check the first returned packet. Assume that the input plugin generates time stamps for all or none.
+    // The coarse clock is sufficient here: one receive operation is much shorter than its precision anyway.
     if (count > 0 && !data[0].hasInputTimeStamp()) {
-        const NanoSecond current = Monotonic(true) - _start_time;
+        const NanoSecond current = CoarseClock::MonotonicNanoSeconds() - _start_time;
         for (size_t n = 0; n < count; ++n) {
             data[n].setInputTimeStamp(current, NanoSecPerSec, TimeSource::TSP);
         }
@@ -248,13 +292,36 @@ size_t ts::tsp::InputExecutor::receiveAndValidate(size_t index, size_t max_packe
 
     // Validate sync byte (0x47) at beginning of each packet
     for (size_t n = 0; n < count; ++n) {
+        // Prefetch the next packet while this one is analyzed. The packets
+        // were just written by the input plugin, possibly from another
+        // thread, and are usually not in this core's cache.
+        if (n + 1 < count) {
+            TS_PREFETCH(pkt + n + 1);
+        }
         if (pkt[n].hasValidSync()) {
             // Count good packets from plugin
             addPluginPackets(1);
 
+            // Parse the PCR once and cache it in the packet metadata. The timing
+            // plugins down the chain share this value instead of parsing the
+            // adaptation field again in each plugin.
+            data[n].setPCR(pkt[n].getPCR());
+
             // Include packet in bitrate analysis.
-            _pcr_analyzer.feedPacket(pkt[n]);
+            _pcr_analyzer.feedPacket(pkt[n], data[n]);
             _dts_analyzer.feedPacket(pkt[n]);
+
+            // Optional CRC validation of PSI/SI sections. The demux checks the
+            // CRC32 of each section once and reports errors. The packet in which
+            // an invalid section ends is marked in its metadata so that plugins
+            // down the chain can use the result without revalidating sections.
+            if (_crc_validate) {
+                _crc_error = false;
+                _crc_demux.feedPacket(pkt[n]);
+                if (_crc_error) {
+                    data[n].setInputCRCError(true);
+                }
+            }
         }
         else {
             // Report error
@@ -15,8 +15,10 @@
 #include "tstspPluginExecutor.h"
 #include "tsInputPlugin.h"
 #include "tsPCRAnalyzer.h"
-#include "tsMonotonic.h"
+#include "tsCoarseClock.h"
 #include "tsWatchDog.h"
+#include "tsSectionDemux.h"
+#include "tsDuckContext.h"
 
 namespace ts {
     namespace tsp {
@@ -25,7 +27,11 @@ namespace ts {
         //! This class is internal to the TSDuck library and cannot be called by applications.
         //! @ingroup plugin
         //!
-        class InputExecutor: public PluginExecutor, private WatchDogHandlerInterface
+        class InputExecutor:
+            public PluginExecutor,
+            private WatchDogHandlerInterface,
+            private SectionHandlerInterface,
+            private InvalidSectionHandlerInterface
         {
             TS_NOBUILD_NOCOPY(InputExecutor);
         public:
@@ -69,6 +75,10 @@ namespace ts {
             virtual void setAbort() override;
             virtual size_t pluginIndex() const override;
 
+        protected:
+            // Overridden methods.
+            virtual Plugin* replacePlugin(Plugin* new_plugin) override;
+
         private:
             InputPlugin* _input = nullptr;           // Plugin API
             bool         _in_sync_lost = false;      // Input synchronization lost (no 0x47 at start of packet)
@@ -82,7 +92,15 @@ namespace ts {
             bool         _use_dts_analyzer = false;  // Use DTS analyzer, not PCR analyzer.
             WatchDog     _watchdog {};               // Watchdog when plugin does not support receive timeout.
             bool         _use_watchdog = false;      // The watchdog shall be used.
-            Monotonic    _start_time {true};         // Creation time in a monotonic clock, initialized with current system time.
+            NanoSecond   _start_time {CoarseClock::MonotonicNanoSeconds()};  // Creation time on the coarse monotonic clock.
+
+            // Optional validation of the PSI/SI section CRC32 at input level (--validate-input-crc).
+            // The validation is part of the single per-chunk pass over incoming packets and its
+            // result is published in the packet metadata for the plugins down the chain.
+            DuckContext  _duck {this};               // TSDuck execution context for the validation demux.
+            SectionDemux _crc_demux {_duck, nullptr, this};  // Demux assembling sections on the validated PID's.
+            bool         _crc_validate = false;      // Input CRC validation is active.
+            bool         _crc_error = false;         // An invalid section ends in the packet being fed.
 
             // Inherited from Thread
             virtual void main() override;
@@ -90,6 +108,10 @@ namespace ts {
             // Implementation of WatchDogHandlerInterface
             virtual void handleWatchDogTimeout(WatchDog& watchdog) override;
 
+            // Implementation of SectionHandlerInterface and InvalidSectionHandlerInterface.
+            virtual void handleSection(SectionDemux& demux, const Section& section) override;
+            virtual void handleInvalidSection(SectionDemux& demux, const DemuxedData& data) override;
+
             // Receive null packets.
             size_t receiveNullPackets(size_t index, size_t max_packets);
 
@@ -7,6 +7,7 @@
 //----------------------------------------------------------------------------
 
 #include "tstspOutputExecutor.h"
+#include "tsProbes.h"
 
 
 //----------------------------------------------------------------------------
@@ -46,6 +47,18 @@ size_t ts::tsp::OutputExecutor::pluginIndex() const
 }
 
 
+//----------------------------------------------------------------------------
+// Replace the plugin instance during a hot restart.
+//----------------------------------------------------------------------------
+
+ts::Plugin* ts::tsp::OutputExecutor::replacePlugin(Plugin* new_plugin)
+{
+    Plugin* const previous = PluginExecutor::replacePlugin(new_plugin);
+    _output = dynamic_cast<OutputPlugin*>(plugin());
+    return previous;
+}
+
+
 //----------------------------------------------------------------------------
 // Output plugin thread
 //----------------------------------------------------------------------------
@@ -122,6 +135,8 @@ void ts::tsp::OutputExecutor::main()
             // Output contiguous ranges of non-dropped packets with respect to --max-output-packets.
             while (!aborted && out_cnt > 0) {
                 const size_t out_subcnt = std::min(out_cnt, _options.max_output_pkt);
+                // Static tracing probe before handing packets to the output plugin.
+                TS_PROBE1(output_send, out_subcnt);
                 if (_suspended) {
                     // Don't output packet when the plugin is suspended.
                     addNonPluginPackets(out_subcnt);
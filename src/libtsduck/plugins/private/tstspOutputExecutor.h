@@ -50,6 +50,10 @@ namespace ts {
             // Overridden methods.
             virtual size_t pluginIndex() const override;
 
+        protected:
+            // Overridden methods.
+            virtual Plugin* replacePlugin(Plugin* new_plugin) override;
+
         private:
             OutputPlugin* _output = nullptr;
 
@@ -8,6 +8,8 @@
 
 #include "tstspPluginExecutor.h"
 #include "tsPluginRepository.h"
+#include "tsSysUtils.h"
+#include "tsTime.h"
 
 
 //----------------------------------------------------------------------------
@@ -54,8 +56,11 @@ size_t ts::tsp::PluginExecutor::pluginCount() const
 
 void ts::tsp::PluginExecutor::signalPluginEvent(uint32_t event_code, Object* plugin_data) const
 {
-    const PluginEventContext ctx(event_code, pluginName(), pluginIndex(), pluginCount(), plugin(), plugin_data, bitrate(), pluginPackets(), totalPacketsInThread());
-    _handlers.callEventHandlers(ctx);
+    // Build the event context only when at least one handler may match.
+    if (_handlers.hasEventHandlers(event_code)) {
+        const PluginEventContext ctx(event_code, pluginName(), pluginIndex(), pluginCount(), plugin(), plugin_data, bitrate(), pluginPackets(), totalPacketsInThread());
+        _handlers.callEventHandlers(ctx);
+    }
 }
 
 
@@ -120,6 +125,32 @@ bool ts::tsp::PluginExecutor::passPackets(size_t count, const BitRate& bitrate,
 
     log(10, u"passPackets(count = %'d, bitrate = %'d, input_end = %s, aborted = %s)", {count, bitrate, input_end, aborted});
 
+    _m_packets += count;
+
+    PluginExecutor* next1 = ringNext<PluginExecutor>();
+
+    // Lock-free single-producer / single-consumer fast path. This executor is the only producer for
+    // the next one and the only consumer of its own area, so the steady-state hand-off is a plain
+    // atomic transfer of the packet count. Everything else (end of input, aborts, bitrate changes,
+    // joint termination) falls back to the global mutex below.
+    if (count > 0 && !input_end && !aborted && !next1->_tsp_aborting &&
+        bitrate == _passed_bitrate && br_confidence == _passed_br_confidence)
+    {
+        // Remove the packets from the beginning of our slice of the buffer, add them to the next one.
+        _pkt_first = (_pkt_first + count) % _buffer->count();
+        _pkt_cnt.fetch_sub(count);
+        next1->_pkt_cnt.fetch_add(count);
+
+        // Wake up the next processor only when it is (or is about to be) blocked in waitWork().
+        // Taking the mutex before notifying serializes with the consumer's check-then-wait sequence
+        // and avoids a lost wakeup; this only happens when the consumer has drained its area.
+        if (next1->_waiting.load()) {
+            std::lock_guard<std::recursive_mutex> lock(_global_mutex);
+            next1->_to_do.notify_one();
+        }
+        return true;
+    }
+
     // We access data under the protection of the global mutex.
     std::lock_guard<std::recursive_mutex> lock(_global_mutex);
 
@@ -129,13 +160,23 @@ bool ts::tsp::PluginExecutor::passPackets(size_t count, const BitRate& bitrate,
 
     // Update next processor's buffer: add 'count' packets at the end of its slice of the buffer.
     PluginExecutor* next = ringNext<PluginExecutor>();
+    // Bug in GCC 12: it reports an incorrect "writing 8 bytes into a region of size 0"
+    // on this atomic increment through the ring pointer -> gcc bug.
+    TS_PUSH_WARNING()
+    TS_GCC_NOWARNING(stringop-overflow)
     next->_pkt_cnt += count;
+    TS_POP_WARNING()
 
     // Propagate bitrate and end of input flag to next processor.
     next->_bitrate = bitrate;
     next->_br_confidence = br_confidence;
     next->_input_end = next->_input_end || input_end;
 
+    // Remember what we last propagated so that the lock-free fast path can be used
+    // as long as the bitrate remains unchanged.
+    _passed_bitrate = bitrate;
+    _passed_br_confidence = br_confidence;
+
     // Wake the next processor when there is some new input data or end of input.
     if (count > 0 || input_end) {
         next->_to_do.notify_one();
@@ -174,14 +215,31 @@ void ts::tsp::PluginExecutor::waitWork(size_t min_pkt_cnt, size_t& pkt_first, si
         min_pkt_cnt = _buffer->count();
     }
 
+    // Sample the CPU time of this thread, once per work session.
+    _m_cpu_time = GetThreadCpuTime();
+
     // We access data under the protection of the global mutex.
     std::unique_lock<std::recursive_mutex> lock(_global_mutex);
 
     PluginExecutor* next = ringNext<PluginExecutor>();
     timeout = false;
+    bool waited = false;
+    Time wait_start(Time::Epoch);
+
+    // Declare ourselves as (potentially) waiting before evaluating the condition. The previous
+    // executor checks this flag in its lock-free fast path: setting it before the check and
+    // entering the wait under the mutex guarantees that no wakeup can be lost.
+    _waiting = true;
 
     // Loop until enough packets are available (or some error condition).
     while (_pkt_cnt < min_pkt_cnt && !_input_end && !timeout && !next->_tsp_aborting) {
+        // Account the stall: for the input executor, this is back-pressure from the
+        // chain (no free buffer space), for the others this is packet starvation.
+        if (!waited) {
+            waited = true;
+            wait_start = Time::CurrentUTC();
+            _m_waits++;
+        }
         // If packet area for this processor is empty, wait for some packet.
         // The mutex is implicitely released, we wait for the condition
         // '_to_do' and, once we get it, implicitely relock the mutex.
@@ -196,6 +254,18 @@ void ts::tsp::PluginExecutor::waitWork(size_t min_pkt_cnt, size_t& pkt_first, si
         }
     }
 
+    // No longer waiting, the previous executor can skip the notification in its fast path.
+    _waiting = false;
+
+    // Update the performance metrics.
+    if (waited) {
+        _m_wait_time += Time::CurrentUTC() - wait_start;
+    }
+    if (timeout) {
+        _m_timeouts++;
+    }
+    _m_occupancy[std::min(Metrics::OCCUPANCY_BUCKETS - 1, (Metrics::OCCUPANCY_BUCKETS * _pkt_cnt.load()) / _buffer->count())]++;
+
     // The number of returned packets is limited up to the wrap-up point of the circular buffer,
     // if allowed by the requested minimum number of packets.
     if (timeout) {
@@ -204,7 +274,7 @@ void ts::tsp::PluginExecutor::waitWork(size_t min_pkt_cnt, size_t& pkt_first, si
     }
     else if (_pkt_first + min_pkt_cnt <= _buffer->count()) {
         // Return up to the wrap-up point. This will satisfy the requested minimum.
-        pkt_cnt = std::min(_pkt_cnt, _buffer->count() - _pkt_first);
+        pkt_cnt = std::min(_pkt_cnt.load(), _buffer->count() - _pkt_first);
     }
     else {
         // The requested minimum does not fit into a contiguous area.
@@ -226,13 +296,31 @@ void ts::tsp::PluginExecutor::waitWork(size_t min_pkt_cnt, size_t& pkt_first, si
 }
 
 
+//----------------------------------------------------------------------------
+// Get a snapshot of the performance metrics of this executor.
+//----------------------------------------------------------------------------
+
+void ts::tsp::PluginExecutor::getMetrics(Metrics& metrics) const
+{
+    metrics.packets = _m_packets.load();
+    metrics.waits = _m_waits.load();
+    metrics.timeouts = _m_timeouts.load();
+    metrics.wait_time = _m_wait_time.load();
+    metrics.cpu_time = _m_cpu_time.load();
+    for (size_t i = 0; i < Metrics::OCCUPANCY_BUCKETS; ++i) {
+        metrics.occupancy[i] = _m_occupancy[i].load();
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Description of a restart operation (constructor).
 //----------------------------------------------------------------------------
 
-ts::tsp::PluginExecutor::RestartData::RestartData(const UStringVector& params, bool same, Report& rep) :
+ts::tsp::PluginExecutor::RestartData::RestartData(const UStringVector& params, bool same, bool hot_restart, Report& rep) :
     report(rep),
     same_args(same),
+    hot(hot_restart),
     args(params)
 {
 }
@@ -242,18 +330,25 @@ ts::tsp::PluginExecutor::RestartData::RestartData(const UStringVector& params, b
 // Restart the plugin.
 //----------------------------------------------------------------------------
 
-void ts::tsp::PluginExecutor::restart(Report& report)
+void ts::tsp::PluginExecutor::restart(bool hot, Report& report)
 {
-    restart(RestartDataPtr(new RestartData(UStringVector(), true, report)));
+    restart(RestartDataPtr(new RestartData(UStringVector(), true, hot, report)));
 }
 
-void ts::tsp::PluginExecutor::restart(const UStringVector& params, Report& report)
+void ts::tsp::PluginExecutor::restart(const UStringVector& params, bool hot, Report& report)
 {
-    restart(RestartDataPtr(new RestartData(params, false, report)));
+    restart(RestartDataPtr(new RestartData(params, false, hot, report)));
 }
 
 void ts::tsp::PluginExecutor::restart(const RestartDataPtr& rd)
 {
+    // With a hot restart, prepare and start the new plugin instance first, in the
+    // context of the calling thread, while the current instance keeps processing
+    // packets in the executor thread. On failure, the current instance is untouched.
+    if (rd->hot && !prepareHotRestart(rd)) {
+        return;
+    }
+
     // Acquire the global mutex to modify global data.
     // To avoid deadlocks, always acquire the global mutex first, then a RestartData mutex.
     {
@@ -279,6 +374,88 @@ void ts::tsp::PluginExecutor::restart(const RestartDataPtr& rd)
     // Now wait for the restart operation to complete.
     std::unique_lock<std::recursive_mutex> lock3(rd->mutex);
     rd->condition.wait(lock3, [rd]() { return rd->completed; });
+
+    // After a hot restart, retire the previous instance here, without blocking the
+    // executor thread. If the operation was canceled by another concurrent restart
+    // before the switch, discard the unused new instance the same way.
+    Plugin* retired = rd->old_plugin != nullptr ? rd->old_plugin : rd->new_plugin;
+    rd->old_plugin = rd->new_plugin = nullptr;
+    lock3.unlock();
+    if (retired != nullptr) {
+        retired->stop();
+        delete retired;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Hot restart: create, analyze and start a new instance of the plugin.
+//----------------------------------------------------------------------------
+
+bool ts::tsp::PluginExecutor::prepareHotRestart(const RestartDataPtr& rd)
+{
+    // Allocate a second instance of the same plugin.
+    Plugin* np = nullptr;
+    switch (plugin()->type()) {
+        case PluginType::INPUT: {
+            PluginRepository::InputPluginFactory allocator = PluginRepository::Instance().getInput(pluginName(), rd->report);
+            np = allocator == nullptr ? nullptr : allocator(this);
+            break;
+        }
+        case PluginType::PROCESSOR: {
+            PluginRepository::ProcessorPluginFactory allocator = PluginRepository::Instance().getProcessor(pluginName(), rd->report);
+            np = allocator == nullptr ? nullptr : allocator(this);
+            break;
+        }
+        case PluginType::OUTPUT: {
+            PluginRepository::OutputPluginFactory allocator = PluginRepository::Instance().getOutput(pluginName(), rd->report);
+            np = allocator == nullptr ? nullptr : allocator(this);
+            break;
+        }
+        default: {
+            break;
+        }
+    }
+    if (np == nullptr) {
+        rd->report.error(u"cannot create a new instance of plugin %s", {pluginName()});
+        return false;
+    }
+
+    // Configure the new instance like the running one.
+    np->setShell(plugin()->getShell());
+    np->setMaxSeverity(maxSeverity());
+    np->setFlags(np->getFlags() | Args::NO_HELP | Args::NO_EXIT_ON_ERROR);
+    np->resetContext(_options.duck_args);
+
+    // With --same, reuse the parameters of the running instance.
+    UStringVector params(rd->args);
+    if (rd->same_args) {
+        plugin()->getCommandArgs(params);
+    }
+
+    // Analyze the command line and start the new instance.
+    // Errors go back to the remote tspcontrol.
+    Report* previous_report = np->redirectReport(&rd->report);
+    const bool success = np->analyze(pluginName(), params, false) && np->getOptions() && np->start();
+    np->redirectReport(previous_report);
+
+    if (!success) {
+        rd->report.error(u"failed to start a new instance of plugin %s, the current instance keeps running", {pluginName()});
+        delete np;
+        return false;
+    }
+    rd->new_plugin = np;
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Replace the plugin instance during a hot restart.
+//----------------------------------------------------------------------------
+
+ts::Plugin* ts::tsp::PluginExecutor::replacePlugin(Plugin* new_plugin)
+{
+    return swapPlugin(new_plugin);
 }
 
 
@@ -317,6 +494,22 @@ bool ts::tsp::PluginExecutor::processPendingRestart(bool& restarted)
     // Now lock the content of the restart data.
     std::lock_guard<std::recursive_mutex> lock2(_restart_data->mutex);
 
+    // Hot restart: the new instance is already started, just switch to it at
+    // this packet boundary. The requesting thread retires the previous instance.
+    if (_restart_data->new_plugin != nullptr) {
+        verbose(u"switching to new plugin instance due to remote tspcontrol");
+        _restart_data->report.verbose(u"switching plugin %s to its new instance", {pluginName()});
+        _restart_data->old_plugin = replacePlugin(_restart_data->new_plugin);
+        _restart_data->new_plugin = nullptr;
+        restartPluginSession();
+        _restart_data->completed = true;
+        _restart_data->condition.notify_one();
+        _restart = false;
+        _restart_data.clear();
+        debug(u"hot-restarted plugin %s", {pluginName()});
+        return true;
+    }
+
     // Verbose message in the current tsp process and back to the remote tspcontrol.
     verbose(u"restarting due to remote tspcontrol");
     _restart_data->report.verbose(u"restarting plugin %s", {pluginName()});
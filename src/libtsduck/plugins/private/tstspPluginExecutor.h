@@ -105,20 +105,55 @@ namespace ts {
             //!
             bool getSuspended() const { return _suspended; }
 
+            //!
+            //! Performance metrics of a plugin executor.
+            //! The fields are maintained by the executor thread and a snapshot
+            //! can be taken at any time from another thread using getMetrics().
+            //!
+            class Metrics
+            {
+            public:
+                //! Number of buckets in the buffer occupancy histogram.
+                static constexpr size_t OCCUPANCY_BUCKETS = 10;
+
+                Metrics() = default;                //!< Constructor.
+                uint64_t    packets = 0;            //!< Number of packets passed to the next plugin.
+                uint64_t    waits = 0;              //!< Number of times the executor thread blocked in waitWork().
+                uint64_t    timeouts = 0;           //!< Number of reception timeouts.
+                MilliSecond wait_time = 0;          //!< Total time spent blocked in waitWork(), in milliseconds.
+                MilliSecond cpu_time = 0;           //!< CPU time of the executor thread, in milliseconds.
+                std::array<uint64_t, OCCUPANCY_BUCKETS> occupancy {};  //!< Histogram of this plugin's input backlog, in tenths of the global buffer size.
+            };
+
+            //!
+            //! Get a snapshot of the performance metrics of this executor.
+            //! This method is typically called from the control server thread.
+            //! @param [out] metrics Current metrics values.
+            //!
+            void getMetrics(Metrics& metrics) const;
+
             //!
             //! Restart the plugin with new parameters.
             //! This method is called from another thread, not the plugin thread.
             //! @param [in] params New command line parameters.
+            //! @param [in] hot With hot restart, a new instance of the plugin is prepared and
+            //! started in the context of the calling thread while the current instance keeps
+            //! processing packets. The executor thread then switches to the new instance at
+            //! a packet boundary and the calling thread retires the previous instance. The
+            //! packet buffer is preserved and the chain is never stalled. When the new
+            //! instance fails to start (a device or an exclusive socket cannot be opened
+            //! twice for instance), the current instance keeps running unchanged.
             //! @param [in,out] report Where to report errors.
             //!
-            void restart(const UStringVector& params, Report& report);
+            void restart(const UStringVector& params, bool hot, Report& report);
 
             //!
             //! Restart the plugin with same parameters.
             //! This method is called from another thread, not the plugin thread.
+            //! @param [in] hot Hot restart, see the other form of restart().
             //! @param [in,out] report Where to report errors.
             //!
-            void restart(Report& report);
+            void restart(bool hot, Report& report);
 
             // Implementation of TSP virtual methods.
             virtual size_t pluginCount() const override;
@@ -178,6 +213,18 @@ namespace ts {
                           BitRate& bitrate, BitRateConfidence& br_confidence,
                           bool& input_end, bool& aborted, bool &timeout);
 
+            //!
+            //! Check if the next plugin executor is idle, waiting for packets.
+            //!
+            //! This is a hint only: the next executor may start working at any time.
+            //! It is used in low-latency mode to flush processed packets as soon as
+            //! the downstream plugin has nothing to do, while keeping the batching
+            //! behavior when it is busy.
+            //!
+            //! @return True if the next plugin executor is (about to be) blocked in waitWork().
+            //!
+            bool nextPluginIdle() const { return ringNext<PluginExecutor>()->_waiting.load(); }
+
             //!
             //! Check if there is a pending restart operation (but do not execute it).
             //! @return True if there is a pending restart operation.
@@ -192,6 +239,15 @@ namespace ts {
             //!
             bool processPendingRestart(bool& restarted);
 
+            //!
+            //! Replace the plugin instance during a hot restart.
+            //! Subclasses which cache a typed pointer to the plugin shall override
+            //! this method and refresh their pointer.
+            //! @param [in] new_plugin New plugin instance, already started.
+            //! @return Address of the previous plugin instance.
+            //!
+            virtual Plugin* replacePlugin(Plugin* new_plugin);
+
         private:
             // Registry of plugin event handlers.
             const PluginEventHandlerRegistry& _handlers;
@@ -203,33 +259,58 @@ namespace ts {
             // The following private data must be accessed exclusively under the protection of the global mutex.
             // Implementation details: see the file src/docs/developing-plugins.dox.
             // [*] After initialization, these fields are read/written only in passPackets() and waitWork().
+            //
+            // Lock-free fast path: each executor is the single producer of packets for the next one in
+            // the ring and the single consumer of its own area. In the steady state (packets available,
+            // no end of input, no abort, unchanged bitrate), passPackets() only moves an atomic packet
+            // count from this executor to the next one and never takes the global mutex. The mutex path
+            // is kept as fallback for bitrate changes, end of input, aborts and joint termination.
+            // _pkt_cnt is therefore atomic: incremented by the previous executor, decremented by this one.
             std::condition_variable_any _to_do {}; // Notify the processor thread to do something.
-            size_t            _pkt_first = 0;      // Starting index of packets area [*]
-            size_t            _pkt_cnt = 0;        // Size of packets area [*]
+            size_t              _pkt_first = 0;    // Starting index of packets area, accessed by this executor only [*]
+            std::atomic<size_t> _pkt_cnt {0};      // Size of packets area [*]
+            std::atomic<bool>   _waiting {false};  // This executor is (about to be) blocked in waitWork().
             bool              _input_end = false;  // No more packet after current ones [*]
             BitRate           _bitrate = 0;        // Input bitrate (set by previous plugin) [*]
             BitRateConfidence _br_confidence = BitRateConfidence::LOW;  // Input bitrate confidence (set by previous plugin) [*]
+            BitRate           _passed_bitrate = -1;  // Last bitrate this executor propagated to the next one (producer-private).
+            BitRateConfidence _passed_br_confidence = BitRateConfidence::LOW;  // Last confidence this executor propagated (producer-private).
             bool              _restart = false;    // Restart the plugin asap using _restart_data
             RestartDataPtr    _restart_data {};    // How to restart the plugin
 
+            // Performance metrics, written by the executor thread, read by the control server thread.
+            std::atomic<uint64_t>    _m_packets {0};    // Packets passed to the next executor.
+            std::atomic<uint64_t>    _m_waits {0};      // Number of blocking waits in waitWork().
+            std::atomic<uint64_t>    _m_timeouts {0};   // Number of reception timeouts.
+            std::atomic<MilliSecond> _m_wait_time {0};  // Total blocked time in waitWork().
+            std::atomic<MilliSecond> _m_cpu_time {0};   // CPU time of the executor thread.
+            std::array<std::atomic<uint64_t>, Metrics::OCCUPANCY_BUCKETS> _m_occupancy {};  // Input backlog histogram.
+
             // Description of a restart operation.
             class RestartData
             {
                 TS_NOBUILD_NOCOPY(RestartData);
             public:
                 // Constructor.
-                RestartData(const UStringVector& params, bool same, Report& rep);
+                RestartData(const UStringVector& params, bool same, bool hot_restart, Report& rep);
 
                 Report&                     report;             // Report progress and error messages.
                 bool                        same_args = false;  // Use same args as previously.
+                bool                        hot = false;        // Hot restart: switch to a pre-started instance.
                 UStringVector               args {};            // New command line parameters for the plugin (read-only).
                 std::recursive_mutex        mutex {};           // Mutex to protect the following fields.
                 std::condition_variable_any condition {};       // Condition to report the end of restart (for the requesting thread).
                 bool                        completed = false;  // End of operation, restarted or aborted.
+                Plugin*                     new_plugin = nullptr;  // Hot restart: new instance, already started, to switch to.
+                Plugin*                     old_plugin = nullptr;  // Hot restart: retired instance, stopped and deleted by the requesting thread.
             };
 
             // Restart this plugin.
             void restart(const RestartDataPtr&);
+
+            // Hot restart: create, analyze and start a new instance of the plugin.
+            // Executed in the context of the requesting thread, errors are reported in the restart data.
+            bool prepareHotRestart(const RestartDataPtr&);
         };
     }
 }
@@ -8,6 +8,7 @@
 
 #include "tstspProcessorExecutor.h"
 #include "tsEnvironment.h"
+#include "tsProbes.h"
 
 
 //----------------------------------------------------------------------------
@@ -47,6 +48,18 @@ size_t ts::tsp::ProcessorExecutor::pluginIndex() const
 }
 
 
+//----------------------------------------------------------------------------
+// Replace the plugin instance during a hot restart.
+//----------------------------------------------------------------------------
+
+ts::Plugin* ts::tsp::ProcessorExecutor::replacePlugin(Plugin* new_plugin)
+{
+    Plugin* const previous = PluginExecutor::replacePlugin(new_plugin);
+    _processor = dynamic_cast<ProcessorPlugin*>(plugin());
+    return previous;
+}
+
+
 //----------------------------------------------------------------------------
 // Packet processor plugin thread
 //----------------------------------------------------------------------------
@@ -134,6 +147,7 @@ void ts::tsp::ProcessorExecutor::processIndividualPackets()
         }
 
         // Now process the packets.
+        TS_PROBE2(processor_batch_start, pluginIndex(), pkt_cnt);
         size_t pkt_done = 0;
         size_t pkt_flush = 0;
 
@@ -211,6 +225,8 @@ void ts::tsp::ProcessorExecutor::processIndividualPackets()
                 // Detect if the packet was nullified by the plugin, either by returning TSP_NULL or by overwriting the packet.
                 if (!was_null && pkt->getPID() == PID_NULL) {
                     pkt_data->setNullified(true);
+                    // The PCR which was possibly stamped by the input executor is gone with the packet.
+                    pkt_data->clearPCR();
                     nullified_packets++;
                 }
 
@@ -229,16 +245,23 @@ void ts::tsp::ProcessorExecutor::processIndividualPackets()
             // Do not wait to process pkt_cnt packets before notifying the next processor.
             // Perform periodic flush to avoid waiting too long before two output operations.
             // Also propagate new bitrate values immediately.
-            if (pkt_data->getFlush() || got_new_bitrate || pkt_done == pkt_cnt || (_options.max_flush_pkt > 0 && pkt_flush >= _options.max_flush_pkt)) {
+            // In low-latency mode, also flush whenever the next plugin is idle: the flush
+            // is immediate when the chain is faster than the stream and batching naturally
+            // resumes when the next plugin is busy.
+            if (pkt_data->getFlush() || got_new_bitrate || pkt_done == pkt_cnt ||
+                (_options.max_flush_pkt > 0 && pkt_flush >= _options.max_flush_pkt) ||
+                (_options.low_latency && nextPluginIdle()))
+            {
                 aborted = !passPackets(pkt_flush, output_bitrate, br_confidence, pkt_done == pkt_cnt && input_end, aborted);
                 pkt_flush = 0;
             }
         }
+        TS_PROBE2(processor_batch_end, pluginIndex(), pkt_done);
 
     } while (!input_end && !aborted);
 
     debug(u"packet processing thread %s after %'d packets, %'d passed, %'d dropped, %'d nullified",
-          {input_end ? u"terminated" : u"aborted", pluginPackets(), passed_packets, dropped_packets, nullified_packets});
+          input_end ? u"terminated" : u"aborted", pluginPackets(), passed_packets, dropped_packets, nullified_packets);
 }
 
 
@@ -248,7 +271,7 @@ void ts::tsp::ProcessorExecutor::processIndividualPackets()
 
 void ts::tsp::ProcessorExecutor::processPacketWindows(size_t window_size)
 {
-    debug(u"packet processing window size: %'d packets", {window_size});
+    debug(u"packet processing window size: %'d packets", window_size);
 
     TSPacketLabelSet only_labels(_processor->getOnlyLabelOption());
     PacketCounter passed_packets = 0;
@@ -288,6 +311,7 @@ void ts::tsp::ProcessorExecutor::processPacketWindows(size_t window_size)
 
             // Wait for packets to process.
             waitWork(request_packets, first_packet_index, allocated_packets, _tsp_bitrate, _tsp_bitrate_confidence, input_end, aborted, timeout);
+            TS_PROBE2(processor_batch_start, pluginIndex(), allocated_packets);
 
             // If bitrate was never modified by the plugin, always copy the input bitrate as output bitrate.
             // Otherwise, keep previous output bitrate, as modified by the plugin.
@@ -407,10 +431,11 @@ void ts::tsp::ProcessorExecutor::processPacketWindows(size_t window_size)
 
         // Pass all allocated packets to the next plugin.
         // Can be less than actually allocated in case of termination.
+        TS_PROBE2(processor_batch_end, pluginIndex(), allocated_packets);
         passPackets(allocated_packets, output_bitrate, br_confidence, input_end, aborted);
 
     } while (!input_end && !aborted);
 
     debug(u"packet processing thread %s after %'d packets, %'d passed, %'d dropped, %'d nullified",
-          {input_end ? u"terminated" : u"aborted", pluginPackets(), passed_packets, dropped_packets, nullified_packets});
+          input_end ? u"terminated" : u"aborted", pluginPackets(), passed_packets, dropped_packets, nullified_packets);
 }
@@ -121,7 +121,11 @@ void ts::tsswitch::InputExecutor::getOutputArea(ts::TSPacket*& first, TSPacketMe
     std::lock_guard<std::recursive_mutex> lock(_mutex);
     first = &_buffer[_outFirst];
     data = &_metadata[_outFirst];
-    count = std::min(_outCount, _buffer.size() - _outFirst);
+    // Bound each chunk by --max-output-packets. One output operation was
+    // previously sized by the whole contiguous backlog and a switchover had
+    // to wait for its completion. The batch size still follows the buffer
+    // occupancy, a backlog is drained in successive bounded chunks.
+    count = std::min(std::min(_outCount, _opt.maxOutputPackets), _buffer.size() - _outFirst);
     _outputInUse = count > 0;
     _todo.notify_one();
 }
@@ -256,6 +260,13 @@ void ts::tsswitch::InputExecutor::main()
             {
                 std::lock_guard<std::recursive_mutex> lock(_mutex);
                 _outCount += inCount;
+                // In hot standby mode, non-current inputs keep only the most recent
+                // packets so that the output resumes close to live data after a switch.
+                if (!_isCurrent && _opt.standbyPackets > 0 && _outCount > _opt.standbyPackets && !_outputInUse) {
+                    const size_t excess = _outCount - _opt.standbyPackets;
+                    _outFirst = (_outFirst + excess) % _buffer.size();
+                    _outCount -= excess;
+                }
             }
             _core.inputReceived(_pluginIndex);
         }
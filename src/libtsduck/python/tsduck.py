@@ -766,8 +766,14 @@ class AbstractPluginEventHandler(NativeObject):
             context.read_only_data = bool(data_read_only)
             context.max_data_size = 0 if data_read_only else data_max_size
 
-            # Build the input binary data of the event.
-            event_data = bytes(ctypes.string_at(data_addr, data_size))
+            # Build the input binary data of the event as a read-only memoryview
+            # over the native buffer of the plugin, without copy. The view is
+            # valid only for the duration of the callback.
+            if data_size > 0:
+                carray = ctypes.cast(data_addr, ctypes.POINTER(ctypes.c_ubyte * data_size)).contents
+                event_data = memoryview(carray).toreadonly()
+            else:
+                event_data = memoryview(b'')
 
             # Call the public Python callback.
             ret = self.handlePluginEvent(context, event_data)
@@ -863,8 +869,9 @@ class AbstractPluginEventHandler(NativeObject):
     # @endcode
     #
     # @param context An instance of PluginEventContext containing the details of the event.
-    # @param data A bytes object containing the data of the event. This is a read-only
-    # sequence of bytes. There is no way to return data from Python to the plugin.
+    # @param data A read-only memoryview over the data of the event, directly mapped on the
+    # native buffer of the plugin, without copy. The view is valid only for the duration of
+    # this call; use bytes(data) to keep a copy of the data after the call.
     # @return A bool, a bytearray or a tuple of both.
     #
     def handlePluginEvent(self, context, data):
@@ -57,6 +57,16 @@ public:
     int32_t          m_index = -1;
     Pusbstream_slice m_slicebuf = nullptr;
 
+    // Transfer statistics, reset in start(), reported in stop().
+    // The SDK streams committed slice buffers from its own thread, several
+    // transfers are in flight at a time. When no free slice buffer is left,
+    // send() can only poll: these are the moments when the device queue
+    // risks draining, so count and time them.
+    uint32_t m_committed = 0;   // Slice buffers committed to the USB stream.
+    uint32_t m_waits = 0;       // Episodes without any free slice buffer.
+    uint32_t m_wait_ms = 0;     // Total polling time without free slice buffer (approximate, 1 ms ticks).
+    bool     m_starved = false; // Currently polling for a free slice buffer.
+
     // Same as in parent plugin.
     bool start();
     bool stop();
@@ -456,6 +466,8 @@ bool ts::VatekOutputPlugin::Guts::start()
                     else {
                         nres = vatek_usbstream_start(m_husbstream, &m_param);
                         if (is_vatek_success(nres)) {
+                            m_committed = m_waits = m_wait_ms = 0;
+                            m_starved = false;
                             TS_PUSH_WARNING()
                             TS_LLVM_NOWARNING(cast-qual)
                             tsp->info(u"modulation start - [%s:%s:%d]", {vatek_device_get_name(m_hchip), ui_enum_get_str(modulator_type,m_param.modulator.type)});
@@ -496,6 +508,9 @@ bool ts::VatekOutputPlugin::Guts::stop()
         if (status == usbstream_status_running || status == usbstream_status_moredata) {
             vatek_usbstream_stop(m_husbstream);
         }
+        if (m_committed > 0 || m_waits > 0) {
+            tsp->verbose(u"usb stream: %'d slice buffers committed, %'d waits for a free buffer, %'d ms total wait", {m_committed, m_waits, m_wait_ms});
+        }
     }
     if (m_husbstream) {
         vatek_usbstream_close(m_husbstream);
@@ -542,6 +557,7 @@ bool ts::VatekOutputPlugin::Guts::send(const TSPacket* pkts, const TSPacketMetad
                 nres = vatek_result(1);
             }
             if (nres > vatek_success) {
+                m_starved = false;
                 size_t pktnums = m_slicebuf->packet_len - m_slicebuf->packet_pos;
                 if (pktnums > remain) {
                     pktnums = remain;
@@ -554,10 +570,18 @@ bool ts::VatekOutputPlugin::Guts::send(const TSPacket* pkts, const TSPacketMetad
                 if (m_slicebuf->packet_pos == m_slicebuf->packet_len) {
                     nres = vatek_ustream_async_commit_buffer(m_husbstream, m_slicebuf);
                     m_slicebuf = nullptr;
+                    m_committed++;
                 }
                 remain -= pktnums;
             }
             else if (nres == vatek_success) {
+                // All slice buffers are in flight, wait for a completion to reuse one.
+                if (!m_starved) {
+                    m_starved = true;
+                    m_waits++;
+                    tsp->debug(u"no free usb slice buffer, %'d waits so far", {m_waits});
+                }
+                m_wait_ms++;
                 cross_os_sleep(1);
             }
             if (!is_vatek_success(nres)){
@@ -15,6 +15,10 @@
 #include "tsTSAnalyzerReport.h"
 #include "tsTSSpeedMetrics.h"
 #include "tsFileNameGenerator.h"
+#include "tsThread.h"
+
+#include <condition_variable>
+#include <mutex>
 
 
 //----------------------------------------------------------------------------
@@ -22,7 +26,7 @@
 //----------------------------------------------------------------------------
 
 namespace ts {
-    class AnalyzePlugin: public ProcessorPlugin
+    class AnalyzePlugin: public ProcessorPlugin, private Thread
     {
         TS_PLUGIN_CONSTRUCTORS(AnalyzePlugin);
     public:
@@ -33,11 +37,16 @@ namespace ts {
         virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
 
     private:
+        // Default size in packets of the shadow analysis buffer.
+        static constexpr size_t DEFAULT_SHADOW_BUFFER = 1024;
+
         // Command line options:
         UString           _output_name {};
         NanoSecond        _output_interval = 0;
         bool              _multiple_output = false;
         bool              _cumulative = false;
+        bool              _shadow = false;
+        size_t            _shadow_buffer = 0;
         TSAnalyzerOptions _analyzer_options {};
 
         // Working data:
@@ -48,6 +57,23 @@ namespace ts {
         TSAnalyzerReport  _analyzer {duck};
         FileNameGenerator _name_gen {};
 
+        // Shadow analysis mode: the packet thread only copies packets into a
+        // lossy ring buffer and the analyzer runs in a separate thread. When
+        // the ring is full, packets are dropped from the analysis (never from
+        // the stream) and counted.
+        std::vector<TSPacket>   _ring {};           // Fixed-size ring buffer of packet copies.
+        size_t                  _ring_head = 0;     // Index of next packet to consume.
+        size_t                  _ring_count = 0;    // Number of packets in the ring.
+        PacketCounter           _shadow_fed = 0;    // Packets passed to the analyzer thread.
+        PacketCounter           _shadow_dropped = 0; // Packets dropped from analysis under pressure.
+        bool                    _terminate = false; // Request analyzer thread termination.
+        std::mutex              _ring_mutex {};     // Protect the ring buffer state.
+        std::condition_variable _ring_signal {};    // Signal the analyzer thread.
+        std::mutex              _analyzer_mutex {}; // Serialize analyzer access vs. reports.
+
+        // Implementation of the analyzer thread in shadow mode.
+        virtual void main() override;
+
         bool openOutput();
         void closeOutput();
         bool produceReport();
@@ -95,6 +121,23 @@ ts::AnalyzePlugin::AnalyzePlugin(TSP* tsp_) :
     help(u"output-file", u"filename",
          u"Specify the output text file for the analysis result. "
          u"By default, use the standard output.");
+
+    option(u"shadow");
+    help(u"shadow",
+         u"Run the analysis in a separate thread, off the packet path. "
+         u"The packet processing thread only copies the packets into a buffer "
+         u"which is consumed by the analyzer thread. When the analyzer cannot "
+         u"keep up, packets are dropped from the analysis, never from the "
+         u"stream. The number of packets which were excluded from the analysis "
+         u"is reported at the end of the session. "
+         u"Use this option on live production chains where the inline analysis "
+         u"cost is not acceptable.");
+
+    option(u"shadow-buffer-size", 0, POSITIVE);
+    help(u"shadow-buffer-size", u"packets",
+         u"With --shadow, specify the size in packets of the analysis buffer. "
+         u"A larger buffer absorbs longer bursts before dropping packets from "
+         u"the analysis. The default is " + UString::Decimal(DEFAULT_SHADOW_BUFFER) + u" packets.");
 }
 
 
@@ -110,6 +153,8 @@ bool ts::AnalyzePlugin::getOptions()
     _output_interval = NanoSecPerSec * intValue<Second>(u"interval", 0);
     _multiple_output = present(u"multiple-files");
     _cumulative = present(u"cumulative");
+    _shadow = present(u"shadow");
+    _shadow_buffer = intValue<size_t>(u"shadow-buffer-size", DEFAULT_SHADOW_BUFFER);
     return true;
 }
 
@@ -136,6 +181,20 @@ bool ts::AnalyzePlugin::start()
         return false;
     }
 
+    // In shadow mode, start the analyzer thread.
+    if (_shadow) {
+        _ring.resize(_shadow_buffer);
+        _ring_head = 0;
+        _ring_count = 0;
+        _shadow_fed = 0;
+        _shadow_dropped = 0;
+        _terminate = false;
+        if (!Thread::start()) {
+            tsp->error(u"cannot start analyzer thread");
+            return false;
+        }
+    }
+
     return true;
 }
 
@@ -188,6 +247,9 @@ bool ts::AnalyzePlugin::produceReport()
         return false;
     }
     else {
+        // Do not report while the analyzer thread is feeding packets.
+        std::lock_guard<std::mutex> lock(_analyzer_mutex);
+
         // Set last known input bitrate as hint
         _analyzer.setBitrateHint(tsp->bitrate(), tsp->bitrateConfidence());
 
@@ -205,6 +267,23 @@ bool ts::AnalyzePlugin::produceReport()
 
 bool ts::AnalyzePlugin::stop()
 {
+    // In shadow mode, let the analyzer thread drain the ring buffer and exit,
+    // so that the final report covers all buffered packets.
+    if (_shadow) {
+        {
+            std::lock_guard<std::mutex> lock(_ring_mutex);
+            _terminate = true;
+            _ring_signal.notify_one();
+        }
+        Thread::waitForTermination();
+        if (_shadow_dropped > 0) {
+            tsp->verbose(u"shadow analysis: %'d packets analyzed, %'d dropped under pressure (%d%%)",
+                         {_shadow_fed, _shadow_dropped, (100 * _shadow_dropped) / (_shadow_fed + _shadow_dropped)});
+        }
+        else {
+            tsp->debug(u"shadow analysis: %'d packets analyzed, none dropped", {_shadow_fed});
+        }
+    }
     produceReport();
     return true;
 }
@@ -216,8 +295,25 @@ bool ts::AnalyzePlugin::stop()
 
 ts::ProcessorPlugin::Status ts::AnalyzePlugin::processPacket(TSPacket& pkt, TSPacketMetadata& pkt_data)
 {
-    // Feed the analyzer with one packet
-    _analyzer.feedPacket(pkt);
+    if (_shadow) {
+        // Shadow mode: only copy the packet into the ring buffer, the
+        // analyzer thread does the actual work. When the ring is full, the
+        // packet is dropped from the analysis, never delay the stream.
+        std::lock_guard<std::mutex> lock(_ring_mutex);
+        if (_ring_count < _ring.size()) {
+            _ring[(_ring_head + _ring_count) % _ring.size()] = pkt;
+            if (_ring_count++ == 0) {
+                _ring_signal.notify_one();
+            }
+        }
+        else {
+            ++_shadow_dropped;
+        }
+    }
+    else {
+        // Feed the analyzer with one packet
+        _analyzer.feedPacket(pkt);
+    }
 
     // With --interval, check if it is time to produce a report
     if (_output_interval > 0 && _metrics.processedPacket() && _metrics.sessionNanoSeconds() >= _next_report) {
@@ -227,6 +323,7 @@ ts::ProcessorPlugin::Status ts::AnalyzePlugin::processPacket(TSPacket& pkt, TSPa
         }
         // Reset analysis context.
         if (!_cumulative) {
+            std::lock_guard<std::mutex> lock(_analyzer_mutex);
             _analyzer.reset();
         }
         // Compute next report time.
@@ -235,3 +332,45 @@ ts::ProcessorPlugin::Status ts::AnalyzePlugin::processPacket(TSPacket& pkt, TSPa
 
     return TSP_OK;
 }
+
+
+//----------------------------------------------------------------------------
+// Analyzer thread in shadow mode.
+//----------------------------------------------------------------------------
+
+void ts::AnalyzePlugin::main()
+{
+    tsp->debug(u"analyzer thread started");
+
+    // Local batch of packets, same size as the ring. The ring content is
+    // moved here so that the packet thread is never blocked behind the
+    // analyzer itself, only behind the short copy.
+    std::vector<TSPacket> batch(_ring.size());
+
+    for (;;) {
+        size_t count = 0;
+        {
+            // Wait for packets in the ring buffer or a termination request.
+            std::unique_lock<std::mutex> lock(_ring_mutex);
+            _ring_signal.wait(lock, [this]() { return _ring_count > 0 || _terminate; });
+            if (_ring_count == 0) {
+                // Terminated and fully drained.
+                break;
+            }
+            while (_ring_count > 0) {
+                batch[count++] = _ring[_ring_head];
+                _ring_head = (_ring_head + 1) % _ring.size();
+                _ring_count--;
+            }
+        }
+
+        // Feed the analyzer outside the ring lock.
+        std::lock_guard<std::mutex> lock(_analyzer_mutex);
+        for (size_t i = 0; i < count; ++i) {
+            _analyzer.feedPacket(batch[i]);
+        }
+        _shadow_fed += count;
+    }
+
+    tsp->debug(u"analyzer thread terminated");
+}
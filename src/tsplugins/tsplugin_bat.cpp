@@ -123,7 +123,7 @@ void ts::BATPlugin::createNewTable(BinaryTable& table)
         bat.bouquet_id = _bouquet_id;
     }
 
-    bat.serialize(duck, table);
+    bat.serialize(table, serializationBuffer());
 }
 
 
@@ -169,7 +169,7 @@ void ts::BATPlugin::modifyTable(BinaryTable& table, bool& is_target, bool& reins
 
     // Reserialize modified BAT.
     bat.clearPreferredSections();
-    bat.serialize(duck, table);
+    bat.serialize(table, serializationBuffer());
 }
 
 
@@ -70,6 +70,8 @@ namespace ts {
         Second           _periodic_bitrate = 0;  // Report bitrate at regular intervals, even if in range.
         Second           _periodic_command = 0;  // Run alarm command at regular intervals, even if in range.
         size_t           _window_size = 0;       // Size (in seconds) of the time window, used to compute bitrate.
+        MilliSecond      _burst_window_ms = 0;   // Size (in milliseconds) of the burst detection sub-window (0: disabled).
+        int64_t          _burst_max_bits = 0;    // Maximum allowed bits in one burst sub-window (0: no alarm).
         UString          _alarm_command {};      // Alarm command name.
         UString          _alarm_prefix {};       // Prefix for alarm messages.
         UString          _alarm_target {};       // "target" parameter to the alarm command.
@@ -88,15 +90,24 @@ namespace ts {
         bool                _startup = false;         // Measurement in progress.
         size_t              _periods_index = 0;       // Index for packet number array.
         std::vector<Period> _periods {};              // Number of packets received during last time window, second per second.
+        Period              _window_total {};         // Running sums over the whole time window, updated in O(1).
         TSPacketLabelSet    _labels_next {};          // Set these labels on next packet.
         SingleDataStatistics<int64_t> _stats {};      // Bitrate statistics.
         SingleDataStatistics<int64_t> _net_stats {};  // Non-null bitrate statistics.
 
+        // Burst detection: time stamps of the packets in the last burst sub-window.
+        std::deque<Monotonic> _burst_times {};
+        int64_t             _burst_peak_bits = 0;     // Peak bits observed in one sub-window since start.
+        bool                _burst_exceeded = false;  // Currently over the allowed burst maximum.
+
         // Compute bitrate. Report any alarm.
         void computeBitrate();
 
         // Check time and compute bitrate when necessary.
-        void checkTime();
+        void checkTime(const Monotonic& now);
+
+        // Update the burst detection sliding sub-window with one packet.
+        void checkBurst(const Monotonic& now);
     };
 }
 
@@ -132,6 +143,19 @@ ts::BitrateMonitorPlugin::BitrateMonitorPlugin(TSP* tsp_) :
          u"6. Maximum bitrate in b/s (decimal integer).\n"
          u"7. Net bitrate, without null packets, in b/s (decimal integer).");
 
+    option(u"burst-window", 0, POSITIVE);
+    help(u"burst-window", u"milliseconds",
+         u"Detect traffic bursts over a short sliding sub-window of the specified duration "
+         u"in milliseconds (typically 1 or 10). The peak number of bits which were observed "
+         u"in one such sub-window is reported in the final summary (see option --summary). "
+         u"See also option --max-burst.");
+
+    option(u"max-burst", 0, POSITIVE);
+    help(u"max-burst", u"bits",
+         u"With --burst-window, set the maximum allowed number of bits in one burst sub-window. "
+         u"A warning is reported each time a burst exceeds that value. "
+         u"By default, bursts are only measured, without alarm.");
+
     option(u"time-interval", 't', UINT16);
     help(u"time-interval",
          u"Time interval (in seconds) used to compute the bitrate. "
@@ -229,6 +253,8 @@ bool ts::BitrateMonitorPlugin::getOptions()
     getValue(_max_bitrate, u"max", DEFAULT_BITRATE_MAX);
     getIntValue(_periodic_bitrate, u"periodic-bitrate", 0);
     getIntValue(_periodic_command, u"periodic-command", 0);
+    getIntValue(_burst_window_ms, u"burst-window", 0);
+    getIntValue(_burst_max_bits, u"max-burst", 0);
     getIntValues(_labels_below, u"set-label-below");
     getIntValues(_labels_normal, u"set-label-normal");
     getIntValues(_labels_above, u"set-label-above");
@@ -240,6 +266,10 @@ bool ts::BitrateMonitorPlugin::getOptions()
         tsp->error(u"bad parameters, bitrate min (%'d) > max (%'d), exiting", {_min_bitrate, _max_bitrate});
         ok = false;
     }
+    if (_burst_max_bits > 0 && _burst_window_ms == 0) {
+        tsp->error(u"--max-burst requires --burst-window");
+        ok = false;
+    }
     if (_periodic_command > 0 && _alarm_command.empty()) {
         tsp->warning(u"no --alarm-command set, --periodic-command ignored");
         _periodic_command = 0;
@@ -280,6 +310,10 @@ bool ts::BitrateMonitorPlugin::start()
     }
 
     _periods_index = 0;
+    _window_total.clear();
+    _burst_times.clear();
+    _burst_peak_bits = 0;
+    _burst_exceeded = false;
     _labels_next.reset();
     _bitrate_countdown = _periodic_bitrate;
     _command_countdown = _periodic_command;
@@ -309,6 +343,9 @@ bool ts::BitrateMonitorPlugin::stop()
         else {
             tsp->info(u"%s average bitrate: %'d bits/s", {_alarm_prefix, _stats.meanRound()});
         }
+        if (_burst_window_ms > 0) {
+            tsp->info(u"%s peak burst: %'d bits in %'d milliseconds", {_alarm_prefix, _burst_peak_bits, _burst_window_ms});
+        }
     }
     return true;
 }
@@ -320,15 +357,10 @@ bool ts::BitrateMonitorPlugin::stop()
 
 void ts::BitrateMonitorPlugin::computeBitrate()
 {
-    // Compute total duration and packets.
-    NanoSecond duration = 0;
-    PacketCounter total_pkt_count = 0;
-    PacketCounter non_null_count = 0;
-    for (auto& p : _periods) {
-        duration += p.duration;
-        total_pkt_count += p.packets;
-        non_null_count += p.non_null;
-    }
+    // Total duration and packets over the time window, from the running sums.
+    NanoSecond duration = _window_total.duration;
+    const PacketCounter total_pkt_count = _window_total.packets;
+    const PacketCounter non_null_count = _window_total.non_null;
 
     // Nanoseconds is an unusually large precision which may lead to overflows.
     // Using seconds is not precise enough. Use microseconds.
@@ -428,10 +460,8 @@ void ts::BitrateMonitorPlugin::computeBitrate()
 // Check time and compute bitrate when necessary.
 //----------------------------------------------------------------------------
 
-void ts::BitrateMonitorPlugin::checkTime()
+void ts::BitrateMonitorPlugin::checkTime(const Monotonic& now)
 {
-    // Current system time.
-    Monotonic now(true);
     const NanoSecond since_last_second = now - _last_second;
 
     // New second : compute the bitrate for the last time window
@@ -439,6 +469,7 @@ void ts::BitrateMonitorPlugin::checkTime()
 
         // Exact duration of the last period and restart a new period.
         _periods[_periods_index].duration = since_last_second;
+        _window_total.duration += since_last_second;
         _last_second = now;
 
         // Bitrate computation is done only when the packet counter
@@ -447,9 +478,13 @@ void ts::BitrateMonitorPlugin::checkTime()
             computeBitrate();
         }
 
-        // update index, and reset packet count.
+        // Update index, evict the oldest period from the running sums and reset it.
         _periods_index = (_periods_index + 1) % _periods.size();
-        _periods[_periods_index].clear();
+        Period& oldest(_periods[_periods_index]);
+        _window_total.duration -= oldest.duration;
+        _window_total.packets -= oldest.packets;
+        _window_total.non_null -= oldest.non_null;
+        oldest.clear();
 
         // We are no more at startup if the index cycles.
         if (_startup) {
@@ -459,6 +494,43 @@ void ts::BitrateMonitorPlugin::checkTime()
 }
 
 
+//----------------------------------------------------------------------------
+// Update the burst detection sliding sub-window with one packet.
+//----------------------------------------------------------------------------
+
+void ts::BitrateMonitorPlugin::checkBurst(const Monotonic& now)
+{
+    // Record the packet and evict all packets older than the sub-window.
+    // The eviction is O(1) amortized: each packet is pushed and popped once.
+    _burst_times.push_back(now);
+    Monotonic limit(now);
+    limit -= _burst_window_ms * NanoSecPerMilliSec;
+    while (_burst_times.front() < limit) {
+        _burst_times.pop_front();
+    }
+
+    // Number of bits in the sub-window ending at this packet.
+    const int64_t bits = int64_t(_burst_times.size() * PKT_SIZE_BITS);
+    if (bits > _burst_peak_bits) {
+        _burst_peak_bits = bits;
+    }
+
+    // Report a warning when a burst starts to exceed the allowed maximum.
+    // The state is reset when the sub-window drains below the maximum.
+    if (_burst_max_bits > 0) {
+        if (bits > _burst_max_bits) {
+            if (!_burst_exceeded) {
+                _burst_exceeded = true;
+                tsp->warning(u"%s burst of %'d bits in %'d milliseconds exceeds allowed maximum (%'d bits)", {_alarm_prefix, bits, _burst_window_ms, _burst_max_bits});
+            }
+        }
+        else {
+            _burst_exceeded = false;
+        }
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Packet timeout processing method.
 //----------------------------------------------------------------------------
@@ -466,7 +538,7 @@ void ts::BitrateMonitorPlugin::checkTime()
 bool ts::BitrateMonitorPlugin::handlePacketTimeout()
 {
     // Check time and bitrates.
-    checkTime();
+    checkTime(Monotonic(true));
 
     // Always continue waiting, never abort.
     return true;
@@ -479,16 +551,24 @@ bool ts::BitrateMonitorPlugin::handlePacketTimeout()
 
 ts::ProcessorPlugin::Status ts::BitrateMonitorPlugin::processPacket(TSPacket& pkt, TSPacketMetadata& pkt_data)
 {
+    // Current system time, shared by the window and burst computations.
+    const Monotonic now(true);
+
     // If packet's PID matches, increment the number of packets received during the current second.
     if (_pids.test(pkt.getPID())) {
         _periods[_periods_index].packets++;
+        _window_total.packets++;
         if (pkt.getPID() != PID_NULL) {
             _periods[_periods_index].non_null++;
+            _window_total.non_null++;
+        }
+        if (_burst_window_ms > 0) {
+            checkBurst(now);
         }
     }
 
     // Check time and bitrates.
-    checkTime();
+    checkTime(now);
 
     // Set labels according to trigger.
     pkt_data.setLabels(_labels_next);
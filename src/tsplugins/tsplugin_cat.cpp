@@ -106,7 +106,7 @@ bool ts::CATPlugin::getOptions()
 void ts::CATPlugin::createNewTable(BinaryTable& table)
 {
     CAT cat;
-    cat.serialize(duck, table);
+    cat.serialize(table, serializationBuffer());
 }
 
 
@@ -160,5 +160,5 @@ void ts::CATPlugin::modifyTable(BinaryTable& table, bool& is_target, bool& reins
     cat.descs.add(_add_descs);
 
     // Reserialize modified CAT.
-    cat.serialize(duck, table);
+    cat.serialize(table, serializationBuffer());
 }
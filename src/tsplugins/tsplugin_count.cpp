@@ -15,6 +15,8 @@
 #include "tsTime.h"
 #include "tsMemory.h"
 
+#define PACKET_WINDOW_SIZE 512  // Process packets by windows of that size.
+
 
 //----------------------------------------------------------------------------
 // Plugin definition
@@ -30,6 +32,8 @@ namespace ts {
         virtual bool start() override;
         virtual bool stop() override;
         virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
+        virtual size_t getPacketWindowSize() override;
+        virtual size_t processPacketWindow(TSPacketWindow&) override;
 
     private:
         // This structure is used at each --interval.
@@ -45,8 +49,7 @@ namespace ts {
 
         // Command  line options:
         UString        _tag {};                  // Message tag
-        bool           _negate = false;          // Negate filter (exclude selected packets)
-        PIDSet         _pids {};                 // PID values to filter
+        PIDSet         _pids {};                 // PID values to filter (--negate already applied)
         bool           _brief_report = false;    // Display biref report, values but not comments
         bool           _report_all = false;      // Report packet index and PID of each packet
         bool           _report_summary = false;  // Report summary
@@ -56,7 +59,7 @@ namespace ts {
         // Working data:
         std::ofstream  _outfile {};              // User-specified output file
         IntervalReport _last_report {};          // Last report content
-        PacketCounter  _counters[PID_MAX] {};    // Packet counter per PID
+        PacketCounter  _counters[PID_MAX] {};    // Packet counter per PID, all PID's counted, filter applied on reporting
 
         // Report a line
         void report(const UChar* fmt, const std::initializer_list<ArgMixIn> args);
@@ -129,7 +132,6 @@ bool ts::CountPlugin::getOptions()
     _report_total = present(u"total");
     _report_summary = (!_report_all && !_report_total) || present(u"summary");
     _brief_report = present(u"brief");
-    _negate = present(u"negate");
     getIntValue(_report_interval, u"interval");
     getIntValues(_pids, u"pid");
     _tag = value(u"tag");
@@ -141,6 +143,11 @@ bool ts::CountPlugin::getOptions()
     if (!present(u"pid")) {
         _pids.set();
     }
+
+    // Fold the negation into the PID filter once for all.
+    if (present(u"negate")) {
+        _pids.flip();
+    }
     return true;
 }
 
@@ -178,7 +185,7 @@ bool ts::CountPlugin::stop()
     // Display final report
     if (_report_summary) {
         for (size_t pid = 0; pid < PID_MAX; pid++) {
-            if (_counters[pid] > 0) {
+            if (_pids[pid] && _counters[pid] > 0) {
                 if (_brief_report) {
                     report(u"%d %d", {pid, _counters[pid]});
                 }
@@ -191,7 +198,9 @@ bool ts::CountPlugin::stop()
     if (_report_total) {
         PacketCounter total = 0;
         for (size_t pid = 0; pid < PID_MAX; pid++) {
-            total += _counters[pid];
+            if (_pids[pid]) {
+                total += _counters[pid];
+            }
         }
         if (_brief_report) {
             report(u"%d", {total});
@@ -231,12 +240,10 @@ void ts::CountPlugin::report(const UChar* fmt, const std::initializer_list<ArgMi
 
 ts::ProcessorPlugin::Status ts::CountPlugin::processPacket(TSPacket& pkt, TSPacketMetadata& pkt_data)
 {
-    // Check if the packet must be counted
+    // Count the packet. All PID's are counted unconditionally, without filter
+    // test; the PID filter is applied when reporting.
     const PID pid = pkt.getPID();
-    bool ok = _pids[pid];
-    if (_negate) {
-        ok = !ok;
-    }
+    _counters[pid]++;
 
     // Process reporting intervals.
     if (_report_interval > 0) {
@@ -254,7 +261,9 @@ ts::ProcessorPlugin::Status ts::CountPlugin::processPacket(TSPacket& pkt, TSPack
             now.total_packets = tsp->pluginPackets();
             now.counted_packets = 0;
             for (size_t p = 0; p < PID_MAX; p++) {
-                now.counted_packets += _counters[p];
+                if (_pids[p]) {
+                    now.counted_packets += _counters[p];
+                }
             }
 
             // Compute bitrates.
@@ -274,17 +283,49 @@ ts::ProcessorPlugin::Status ts::CountPlugin::processPacket(TSPacket& pkt, TSPack
     }
 
     // Report packets
-    if (ok) {
-        if (_report_all) {
-            if (_brief_report) {
-                report(u"%d %d", {tsp->pluginPackets(), pid});
-            }
-            else {
-                report(u"%spacket: %10'd, PID: %4d (0x%04X)", {_tag, tsp->pluginPackets(), pid, pid});
-            }
+    if (_report_all && _pids[pid]) {
+        if (_brief_report) {
+            report(u"%d %d", {tsp->pluginPackets(), pid});
+        }
+        else {
+            report(u"%spacket: %10'd, PID: %4d (0x%04X)", {_tag, tsp->pluginPackets(), pid, pid});
         }
-        _counters[pid]++;
     }
 
     return TSP_OK;
 }
+
+
+//----------------------------------------------------------------------------
+// Packet window processing methods.
+//----------------------------------------------------------------------------
+
+size_t ts::CountPlugin::getPacketWindowSize()
+{
+    // Batch counting is possible only when no per-packet processing is
+    // needed, ie. without per-packet reporting and without interval reports.
+    return _report_all || _report_interval > 0 ? 0 : PACKET_WINDOW_SIZE;
+}
+
+size_t ts::CountPlugin::processPacketWindow(TSPacketWindow& win)
+{
+    // Count a whole window in one pass over the flat counter array,
+    // iterating cache-linearly inside each physical segment.
+    size_t index = 0;
+    while (index < win.size()) {
+        TSPacket* pkt = nullptr;
+        TSPacketMetadata* mdata = nullptr;
+        const size_t count = win.getRange(index, pkt, mdata, win.size() - index);
+        if (count == 0) {
+            break;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            // Dropped packets are identified by a zeroed sync byte.
+            if (pkt[i].b[0] == SYNC_BYTE) {
+                _counters[pkt[i].getPID()]++;
+            }
+        }
+        index += count;
+    }
+    return win.size();
+}
@@ -39,7 +39,8 @@ namespace ts {
 
         // Working data:
         PacketCounter _limit = 0;           // Current max number of packets
-        TSPacket      _packet {NullPacket}; // Template of packet to generate
+        bool          _incrementCC = false; // The continuity counter varies from packet to packet
+        TSPacket      _packet {NullPacket}; // Precompiled template of packet to generate
     };
 }
 
@@ -61,10 +62,6 @@ namespace ts {
         // Command line options:
         bool      _setDiscontinuity = false;
         bool      _clearDiscontinuity = false;
-        bool      _setTransportError = false;
-        bool      _clearTransportError = false;
-        bool      _setTransportPriority = false;
-        bool      _clearTransportPriority = false;
         bool      _setESPriority = false;
         bool      _clearESPriority = false;
         bool      _resizePayload = false;
@@ -83,21 +80,20 @@ namespace ts {
         uint64_t  _newPCR = 0;
         bool      _clearOPCR = false;
         uint64_t  _newOPCR = 0;
-        bool      _setPID = false;
-        PID       _newPID = PID_NULL;
-        bool      _setPUSI = false;
-        bool      _clearPUSI = false;
         bool      _setRandomAccess = false;
         bool      _clearRandomAccess = false;
         bool      _packPESHeader = false;
-        bool      _setScrambling = false;
-        uint8_t   _newScrambling = 0;
-        bool      _setCC = false;
-        uint8_t   _newCC = 0;
         bool      _setSpliceCountdown = false;
         bool      _clearSpliceCountdown = false;
         uint8_t   _newSpliceCountdown = 0;
 
+        // Working data:
+        // The fixed-position header operations (error and priority indicators, PUSI,
+        // PID, scrambling control, continuity counter) are precompiled into a pair of
+        // masks, applied in one pass per packet: header = (header & AND) | OR.
+        uint8_t   _headerAnd[4] {0xFF, 0xFF, 0xFF, 0xFF};
+        uint8_t   _headerOr[4] {0x00, 0x00, 0x00, 0x00};
+
         // Perform --pack-pes-header on a packet.
         void packPESHeader(TSPacket&);
 
@@ -359,6 +355,9 @@ bool ts::CraftInput::start()
 {
     _packet.setCC(_initCC);
     _limit = _maxCount;
+    // All constant fields are precompiled in the template packet. The continuity
+    // counter is the only field to patch from packet to packet.
+    _incrementCC = !_constantCC && _packet.hasPayload();
     return true;
 }
 
@@ -395,15 +394,26 @@ size_t ts::CraftInput::receive(TSPacket* buffer, TSPacketMetadata* pkt_data, siz
         _limit = std::numeric_limits<PacketCounter>::max();
     }
 
-    // Fill buffer
-    size_t n;
-    for (n = 0; n < maxPackets && previousCount + n < _limit; n++) {
-        buffer[n] = _packet;
-        // Increment the continuity counter for the next packet when necessary.
-        if (!_constantCC && _packet.hasPayload()) {
-            _packet.setCC((_packet.getCC() + 1) & CC_MASK);
+    // Number of packets to generate in this call.
+    const size_t n = previousCount >= _limit ? 0 : size_t(std::min<PacketCounter>(maxPackets, _limit - previousCount));
+
+    if (!_incrementCC) {
+        // Fully constant packets, batch copies of the precompiled template.
+        for (size_t i = 0; i < n; ++i) {
+            buffer[i] = _packet;
         }
     }
+    else {
+        // Copy the template and patch the continuity counter in each copy.
+        uint8_t cc = _packet.getCC();
+        for (size_t i = 0; i < n; ++i) {
+            buffer[i] = _packet;
+            buffer[i].b[3] = uint8_t((buffer[i].b[3] & ~CC_MASK) | cc);
+            cc = (cc + 1) & CC_MASK;
+        }
+        // Continuity counter of the first packet of the next call.
+        _packet.setCC(cc);
+    }
     return n;
 }
 
@@ -567,10 +577,6 @@ bool ts::CraftPlugin::getOptions()
 {
     _setDiscontinuity = present(u"discontinuity");
     _clearDiscontinuity = present(u"clear-discontinuity");
-    _setTransportError = present(u"error");
-    _clearTransportError = present(u"clear-error");
-    _setTransportPriority = present(u"priority");
-    _clearTransportPriority = present(u"clear-priority");
     _setESPriority = present(u"es-priority");
     _clearESPriority = present(u"clear-es-priority");
     _noPayload = present(u"no-payload");
@@ -583,17 +589,9 @@ bool ts::CraftPlugin::getOptions()
     getIntValue(_newPCR, u"pcr", INVALID_PCR);
     _clearOPCR = present(u"no-opcr");
     getIntValue(_newOPCR, u"opcr", INVALID_PCR);
-    _setPID = present(u"pid");
-    getIntValue(_newPID, u"pid");
-    _setPUSI = present(u"pusi");
-    _clearPUSI = present(u"clear-pusi");
     _setRandomAccess = present(u"random-access");
     _clearRandomAccess = present(u"clear-random-access");
     _packPESHeader = present(u"pack-pes-header");
-    _setScrambling = present(u"scrambling");
-    getIntValue(_newScrambling, u"scrambling");
-    _setCC = present(u"continuity-counter");
-    getIntValue(_newCC, u"continuity-counter");
     _setSpliceCountdown = present(u"splice-countdown");
     _clearSpliceCountdown = present(u"no-splice-countdown");
     getIntValue(_newSpliceCountdown, u"splice-countdown");
@@ -608,44 +606,60 @@ bool ts::CraftPlugin::getOptions()
         tsp->error(u"options --no-payload and --payload-size are mutually exclusive");
         return false;
     }
-    return true;
-}
-
 
-//----------------------------------------------------------------------------
-// Packet processing method
-//----------------------------------------------------------------------------
-
-ts::ProcessorPlugin::Status ts::CraftPlugin::processPacket(TSPacket& pkt, TSPacketMetadata& pkt_data)
-{
-    // Hack the packet header. Just overwrite a few bits in place, nothing to move.
-    if (_clearTransportError) {
-        pkt.clearTEI();
+    // Precompile the fixed-position header operations into AND/OR masks.
+    // Clearing a field contributes to AND, setting one to OR. The OR mask is
+    // applied last: when a field is both cleared and set, set wins.
+    _headerAnd[1] = _headerAnd[2] = _headerAnd[3] = 0xFF;
+    _headerOr[1] = _headerOr[2] = _headerOr[3] = 0x00;
+    if (present(u"clear-error")) {
+        _headerAnd[1] &= ~0x80;
     }
-    if (_setTransportError) {
-        pkt.setTEI();
+    if (present(u"error")) {
+        _headerOr[1] |= 0x80;
     }
-    if (_clearTransportPriority) {
-        pkt.clearPriority();
+    if (present(u"clear-pusi")) {
+        _headerAnd[1] &= ~0x40;
     }
-    if (_setTransportPriority) {
-        pkt.setPriority();
+    if (present(u"pusi")) {
+        _headerOr[1] |= 0x40;
     }
-    if (_clearPUSI) {
-        pkt.clearPUSI();
+    if (present(u"clear-priority")) {
+        _headerAnd[1] &= ~0x20;
     }
-    if (_setPUSI) {
-        pkt.setPUSI();
+    if (present(u"priority")) {
+        _headerOr[1] |= 0x20;
     }
-    if (_setPID) {
-        pkt.setPID(_newPID);
+    if (present(u"pid")) {
+        const PID pid = intValue<PID>(u"pid");
+        _headerAnd[1] &= 0xE0;
+        _headerOr[1] |= uint8_t(pid >> 8) & 0x1F;
+        _headerAnd[2] = 0x00;
+        _headerOr[2] = uint8_t(pid);
     }
-    if (_setScrambling) {
-        pkt.setScrambling(_newScrambling);
+    if (present(u"scrambling")) {
+        _headerAnd[3] &= 0x3F;
+        _headerOr[3] |= uint8_t(intValue<uint8_t>(u"scrambling") << 6);
     }
-    if (_setCC) {
-        pkt.setCC(_newCC);
+    if (present(u"continuity-counter")) {
+        _headerAnd[3] &= 0xF0;
+        _headerOr[3] |= intValue<uint8_t>(u"continuity-counter") & CC_MASK;
     }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Packet processing method
+//----------------------------------------------------------------------------
+
+ts::ProcessorPlugin::Status ts::CraftPlugin::processPacket(TSPacket& pkt, TSPacketMetadata& pkt_data)
+{
+    // Hack the packet header. The fixed-position operations were precompiled
+    // into masks, just overwrite a few bits in place, nothing to move.
+    pkt.b[1] = uint8_t((pkt.b[1] & _headerAnd[1]) | _headerOr[1]);
+    pkt.b[2] = uint8_t((pkt.b[2] & _headerAnd[2]) | _headerOr[2]);
+    pkt.b[3] = uint8_t((pkt.b[3] & _headerAnd[3]) | _headerOr[3]);
 
     // Remove fields or clear bits in the adaptation field.
     // These operations always succeed and do not change the size of the AF,
@@ -661,6 +675,7 @@ ts::ProcessorPlugin::Status ts::CraftPlugin::processPacket(TSPacket& pkt, TSPack
     }
     if (_clearPCR) {
         pkt.removePCR();
+        pkt_data.setPCR(INVALID_PCR);
     }
     if (_clearOPCR) {
         pkt.removeOPCR();
@@ -703,8 +718,13 @@ ts::ProcessorPlugin::Status ts::CraftPlugin::processPacket(TSPacket& pkt, TSPack
     }
 
     // Set fields which need more space in the adaptation field.
-    if (_newPCR != INVALID_PCR && !pkt.setPCR(_newPCR, canShrinkPayload)) {
-        tsp->warning(u"packet %'d: no adaptation field to set PCR", {tsp->pluginPackets()});
+    if (_newPCR != INVALID_PCR) {
+        if (pkt.setPCR(_newPCR, canShrinkPayload)) {
+            pkt_data.setPCR(_newPCR);
+        }
+        else {
+            tsp->warning(u"packet %'d: no adaptation field to set PCR", {tsp->pluginPackets()});
+        }
     }
     if (_newOPCR != INVALID_PCR && !pkt.setOPCR(_newOPCR, canShrinkPayload)) {
         tsp->warning(u"packet %'d: no adaptation field to set OPCR", {tsp->pluginPackets()});
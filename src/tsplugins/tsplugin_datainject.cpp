@@ -36,7 +36,7 @@
 //----------------------------------------------------------------------------
 
 namespace ts {
-    class DataInjectPlugin: public ProcessorPlugin, private SectionProviderInterface
+    class DataInjectPlugin: public ProcessorPlugin
     {
         TS_PLUGIN_CONSTRUCTORS(DataInjectPlugin);
     public:
@@ -54,6 +54,48 @@ namespace ts {
         typedef PacketQueue::MessagePtr PacketPtrMT;
         typedef SectionQueue::MessagePtr SectionPtrMT;
 
+        // Context of one data stream. The EMMG/PDG <=> MUX protocol allows several
+        // simultaneous streams on the data channel, typically one per EMM stream.
+        // Each stream has its own queues and its own bandwidth allocation.
+        class StreamContext: public SectionProviderInterface
+        {
+            TS_NOBUILD_NOCOPY(StreamContext);
+        public:
+            // Constructor.
+            StreamContext(DuckContext& duck, uint16_t sid, uint16_t did, uint16_t dtype, size_t queue_size) :
+                stream_id(sid), data_id(did), data_type(dtype), packetizer(duck, PID_NULL, this)
+            {
+                packet_queue.setMaxMessages(queue_size);
+                section_queue.setMaxMessages(queue_size);
+            }
+
+            const uint16_t stream_id;           // DVB SimulCrypt data_stream_id.
+            const uint16_t data_id;             // DVB SimulCrypt data_id.
+            const uint16_t data_type;           // DVB SimulCrypt data_type.
+            BitRate        req_bitrate = 0;     // Bandwidth requested by the client for this stream.
+            BitRate        alloc_bitrate = 0;   // Bandwidth allocated to this stream.
+            PacketQueue    packet_queue {};     // Queue of incoming TS packets.
+            SectionQueue   section_queue {};    // Queue of incoming sections.
+            Packetizer     packetizer;          // Generate packets in the case of incoming sections.
+            int64_t        deficit = 0;         // Token count of the round-robin scheduler (scaled by DEFICIT_SCALE).
+            PacketCounter  inserted = 0;        // Number of packets inserted in the TS for this stream.
+            PacketCounter  next_ideal = 0;      // Ideal insertion point of the next packet, in TS packets.
+            PacketCounter  drift_cumul = 0;     // Cumulated insertion drift, in TS packets.
+            PacketCounter  drift_max = 0;       // Maximum insertion drift, in TS packets.
+
+            // Implementation of SectionProviderInterface, feeding the packetizer in section mode.
+            virtual void provideSection(SectionCounter counter, SectionPtr& section) override;
+            virtual bool doStuffing() override { return false; }
+        };
+        typedef SafePtr<StreamContext> StreamContextPtr;
+        typedef std::map<uint16_t, StreamContextPtr> StreamContextMap;
+
+        // One packet of tokens in the deficit round-robin scheduler. Each time a data packet
+        // can be inserted, DEFICIT_SCALE tokens are distributed over the established streams,
+        // proportionally to their allocated bandwidth, and inserting one packet costs
+        // DEFICIT_SCALE tokens to the selected stream.
+        static constexpr int64_t DEFICIT_SCALE = 0x10000;
+
         // TCP listener thread.
         class TCPListener : public Thread
         {
@@ -112,19 +154,17 @@ namespace ts {
         TCPServer          _server {};                     // EMMG/PDG <=> MUX TCP server
         TCPListener        _tcp_listener {this};           // TCP listener thread.
         UDPListener        _udp_listener {this};           // UDP listener thread.
-        PacketQueue        _packet_queue {};               // Queue of incoming TS packets.
-        SectionQueue       _section_queue {};              // Queue of incoming sections.
+        size_t             _queue_size = DEFAULT_QUEUE_SIZE; // Maximum queued sections or packets per stream.
         tlv::Logger        _logger {Severity::Debug, tsp}; // Message logger.
         volatile bool      _channel_established = false;   // Data channel open.
-        volatile bool      _stream_established = false;    // Data stream open.
         volatile bool      _req_bitrate_changed = false;   // Requested bitrate has changed.
         // Start of protected area.
         std::mutex         _mutex {};                      // Mutex for access to protected area
         uint32_t           _client_id = 0;                 // DVB SimilCrypt client id.
-        uint16_t           _data_id = 0;                   // DVB SimilCrypt data id.
         bool               _section_mode = false;          // Datagrams are sections.
-        Packetizer         _packetizer {duck, PID_NULL, this}; // Generate packets in the case of incoming sections.
-        BitRate            _req_bitrate = 0;               // Requested bitrate
+        StreamContextMap   _streams {};                    // Established data streams, indexed by stream id.
+        uint16_t           _sched_last = 0;                // Stream id after which the round-robin scan resumes.
+        BitRate            _total_bitrate = 0;             // Total allocated bitrate over all streams.
         size_t             _lost_packets = 0;              // Lost packets (queue full)
 
         // Reset all client session context information.
@@ -139,9 +179,22 @@ namespace ts {
         // Report packet/session loss. Invoked with _mutex held.
         void processPacketLoss(const UChar* type, bool enqueueSuccess);
 
-        // Implementation of SectionProviderInterface.
-        virtual void provideSection(SectionCounter counter, SectionPtr& section) override;
-        virtual bool doStuffing() override { return false; }
+        // Recompute the per-stream bandwidth allocation and the total data bitrate.
+        // Invoked with _mutex held.
+        void updateAllocation();
+
+        // Get the next data packet to insert, using a weighted deficit round-robin
+        // over the established streams. Invoked with _mutex held.
+        bool getSchedulerPacket(TSPacket&);
+
+        // Try to get a packet from one stream. Invoked with _mutex held.
+        bool fetchPacket(StreamContext&, TSPacket&);
+
+        // Update the insertion drift statistics of one stream. Invoked with _mutex held.
+        void updateDrift(StreamContext&);
+
+        // Report the insertion statistics of one stream.
+        void reportStreamStats(const StreamContext&);
     };
 }
 
@@ -235,7 +288,7 @@ bool ts::DataInjectPlugin::start()
     // Command line options
     getValue(_max_bitrate, u"bitrate-max");
     getIntValue(_data_pid, u"pid");
-    const size_t queue_size = intValue<size_t>(u"queue-size", DEFAULT_QUEUE_SIZE);
+    _queue_size = intValue<size_t>(u"queue-size", DEFAULT_QUEUE_SIZE);
     _reuse_port = !present(u"no-reuse-port");
     getIntValue(_sock_buf_size, u"buffer-size");
     _unregulated = present(u"unregulated");
@@ -248,10 +301,6 @@ bool ts::DataInjectPlugin::start()
     _logger.setDefaultSeverity(log_protocol);
     _logger.setSeverity(ts::emmgmux::Tags::data_provision, log_data);
 
-    // Limit internal queues sizes.
-    _packet_queue.setMaxMessages(queue_size);
-    _section_queue.setMaxMessages(queue_size);
-
     // Specify which EMMG/PDG <=> MUX version to use.
     _protocol.setVersion(intValue<tlv::VERSION>(u"emmg-mux-version", DEFAULT_PROTOCOL_VERSION));
 
@@ -280,7 +329,7 @@ bool ts::DataInjectPlugin::start()
 
     // Clear client session.
     clearSession();
-    tsp->verbose(u"initial bandwidth allocation is %'d", {_req_bitrate == 0 ? u"unlimited" : _req_bitrate.toString() + u" b/s"});
+    tsp->verbose(u"initial bandwidth allocation is %'d", {_total_bitrate == 0 ? u"unlimited" : _total_bitrate.toString() + u" b/s"});
 
     // TS processing state
     _cc_fixer.reset();
@@ -307,16 +356,17 @@ void ts::DataInjectPlugin::clearSession()
 
     // No client session is established.
     _channel_established = false;
-    _stream_established = false;
 
-    // Reset queues.
-    _packet_queue.clear();
-    _section_queue.clear();
-    _packetizer.reset();
+    // Close all data streams, reporting their insertion statistics.
+    for (const auto& it : _streams) {
+        reportStreamStats(*it.second);
+    }
+    _streams.clear();
+    _sched_last = 0;
     _lost_packets = 0;
 
     // Initial bandwidth allocation (zero means unlimited)
-    _req_bitrate = _max_bitrate;
+    _total_bitrate = _max_bitrate;
     _req_bitrate_changed = false;
 }
 
@@ -327,6 +377,14 @@ void ts::DataInjectPlugin::clearSession()
 
 bool ts::DataInjectPlugin::stop()
 {
+    // Report final insertion statistics on all streams.
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (const auto& it : _streams) {
+            reportStreamStats(*it.second);
+        }
+    }
+
     // Stop the internal threads.
     _tcp_listener.stop();
     _udp_listener.stop();
@@ -365,31 +423,16 @@ ts::ProcessorPlugin::Status ts::DataInjectPlugin::processPacket(TSPacket& pkt, T
             // Time to insert data packet, if any is available immediately.
             std::lock_guard<std::mutex> lock(_mutex);
 
-            // Get next packet to insert.
-            bool got_packet = false;
-            if (_section_mode) {
-                // Section mode: Get a packet from the packetizer.
-                got_packet = _packetizer.getNextPacket(pkt);
-            }
-            else {
-                // Packet mode: Dequeue a packet immediately.
-                PacketPtrMT pp;
-                got_packet = _packet_queue.dequeue(pp, 0);
-                if (got_packet) {
-                    pkt = *pp;
-                }
-            }
-
-            // Update new inserted packet.
-            if (got_packet) {
+            // Get next packet to insert from the stream scheduler.
+            if (getSchedulerPacket(pkt)) {
                 // Update PID and continuity counter.
                 pkt.setPID(_data_pid);
                 _cc_fixer.feedPacket(pkt);
-                // Compute next insertion point if the data PID bitrate is specified.
+                // Compute next insertion point if the data bitrate is specified.
                 // Otherwise, try to update any null packet (unbounded bitrate).
-                if (!_unregulated || _req_bitrate != 0) {
+                if (_total_bitrate != 0) {
                     // TODO: refine this, works only for low injection bitrates.
-                    _pkt_next_data += (tsp->bitrate() / _req_bitrate).toInt();
+                    _pkt_next_data += (tsp->bitrate() / _total_bitrate).toInt();
                 }
             }
         }
@@ -400,15 +443,160 @@ ts::ProcessorPlugin::Status ts::DataInjectPlugin::processPacket(TSPacket& pkt, T
 
 
 //----------------------------------------------------------------------------
-// Implementation of SectionProviderInterface.
+// Get the next data packet to insert. Invoked with _mutex held.
+//----------------------------------------------------------------------------
+
+bool ts::DataInjectPlugin::getSchedulerPacket(TSPacket& pkt)
+{
+    if (_streams.empty()) {
+        return false;
+    }
+
+    // Weighted deficit round-robin over the established streams. On the first pass,
+    // each visited stream earns tokens proportional to its allocated bandwidth and
+    // the first stream which accumulated one full packet of tokens and has data
+    // ready is served. The token count is capped to bound the burst which a stream
+    // can accumulate and streams without data do not retain their tokens, so a
+    // stream which becomes active again does not disrupt the others. When no stream
+    // collected enough tokens, a second work-conserving pass serves the first
+    // stream with available data, regardless of tokens.
+    for (int pass = 1; pass <= 2; ++pass) {
+        auto it = _streams.upper_bound(_sched_last);
+        for (size_t count = _streams.size(); count > 0; --count) {
+            if (it == _streams.end()) {
+                it = _streams.begin();
+            }
+            StreamContext& stream(*it->second);
+            if (pass == 1) {
+                const int64_t quantum = stream.alloc_bitrate > 0 && _total_bitrate > 0 ?
+                    std::max<int64_t>(1, ((stream.alloc_bitrate * DEFICIT_SCALE) / _total_bitrate).toInt()) :
+                    std::max<int64_t>(1, DEFICIT_SCALE / int64_t(_streams.size()));
+                stream.deficit = std::min(stream.deficit + quantum, 2 * DEFICIT_SCALE);
+            }
+            if ((pass == 2 || stream.deficit >= DEFICIT_SCALE) && fetchPacket(stream, pkt)) {
+                stream.deficit = std::max<int64_t>(0, stream.deficit - DEFICIT_SCALE);
+                _sched_last = stream.stream_id;
+                updateDrift(stream);
+                return true;
+            }
+            if (pass == 1 && stream.deficit >= DEFICIT_SCALE) {
+                // Enough tokens but no data available, do not hoard tokens while idle.
+                stream.deficit = 0;
+            }
+            ++it;
+        }
+    }
+    return false;
+}
+
+
+//----------------------------------------------------------------------------
+// Try to get a packet from one stream. Invoked with _mutex held.
+//----------------------------------------------------------------------------
+
+bool ts::DataInjectPlugin::fetchPacket(StreamContext& stream, TSPacket& pkt)
+{
+    if (_section_mode) {
+        // Section mode: Get a packet from the packetizer.
+        return stream.packetizer.getNextPacket(pkt);
+    }
+    else {
+        // Packet mode: Dequeue a packet immediately.
+        PacketPtrMT pp;
+        const bool got_packet = stream.packet_queue.dequeue(pp, 0);
+        if (got_packet) {
+            pkt = *pp;
+        }
+        return got_packet;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Update the insertion drift statistics of one stream. Invoked with _mutex held.
+//----------------------------------------------------------------------------
+
+void ts::DataInjectPlugin::updateDrift(StreamContext& stream)
+{
+    if (stream.inserted++ == 0) {
+        stream.next_ideal = _pkt_current;
+    }
+    const PacketCounter drift = _pkt_current > stream.next_ideal ? _pkt_current - stream.next_ideal : stream.next_ideal - _pkt_current;
+    stream.drift_cumul += drift;
+    stream.drift_max = std::max(stream.drift_max, drift);
+
+    // Ideal insertion point of the next packet, based on the TS bitrate and the
+    // stream allocation. When running late, resynchronize on the current position
+    // instead of accumulating a growing debt.
+    if (stream.alloc_bitrate > 0) {
+        stream.next_ideal = std::max(stream.next_ideal, _pkt_current) + (tsp->bitrate() / stream.alloc_bitrate).toInt();
+    }
+    else {
+        stream.next_ideal = _pkt_current;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Report the insertion statistics of one stream.
+//----------------------------------------------------------------------------
+
+void ts::DataInjectPlugin::reportStreamStats(const StreamContext& stream)
+{
+    if (stream.inserted > 0) {
+        tsp->verbose(u"stream %d: inserted %'d packets, insertion drift: mean %'d packets, max %'d packets",
+                     {stream.stream_id, stream.inserted, stream.drift_cumul / stream.inserted, stream.drift_max});
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Recompute the bandwidth allocation. Invoked with _mutex held.
+//----------------------------------------------------------------------------
+
+void ts::DataInjectPlugin::updateAllocation()
+{
+    // Total requested bandwidth over all streams.
+    BitRate requested = 0;
+    for (const auto& it : _streams) {
+        requested += it.second->req_bitrate;
+    }
+
+    if (requested == 0) {
+        // No stream requested bandwidth yet, fall back to the global maximum (zero means unlimited).
+        _total_bitrate = _max_bitrate;
+        for (const auto& it : _streams) {
+            it.second->alloc_bitrate = 0;
+        }
+    }
+    else if (_max_bitrate == 0 || requested <= _max_bitrate) {
+        // All requests can be satisfied.
+        _total_bitrate = requested;
+        for (const auto& it : _streams) {
+            it.second->alloc_bitrate = it.second->req_bitrate;
+        }
+    }
+    else {
+        // Scale down all allocations proportionally.
+        _total_bitrate = _max_bitrate;
+        for (const auto& it : _streams) {
+            it.second->alloc_bitrate = (it.second->req_bitrate * _max_bitrate) / requested;
+        }
+    }
+    _req_bitrate_changed = true;
+}
+
+
+//----------------------------------------------------------------------------
+// Implementation of SectionProviderInterface on one stream.
 // Provide next section to packetize in section mode.
 //----------------------------------------------------------------------------
 
-void ts::DataInjectPlugin::provideSection(SectionCounter counter, SectionPtr& section)
+void ts::DataInjectPlugin::StreamContext::provideSection(SectionCounter counter, SectionPtr& section)
 {
     // Try to dequeue a section immediately.
     SectionPtrMT mt_section;
-    if (_section_queue.dequeue(mt_section, 0)) {
+    if (section_queue.dequeue(mt_section, 0)) {
         // A section was dequeue. Change the mutex of the safe pointer.
         section = mt_section.changeMutex<SectionPtr::MutexType>();
     }
@@ -435,25 +623,28 @@ bool ts::DataInjectPlugin::processBandwidthRequest(const tlv::MessagePtr& reques
     std::lock_guard<std::mutex> lock(_mutex);
 
     // Check that the stream is established.
-    if (!_stream_established) {
-        tsp->error(u"unexpected stream_BW_request, stream not setup");
+    const auto it = _streams.find(m->stream_id);
+    if (it == _streams.end()) {
+        tsp->error(u"unexpected stream_BW_request, stream %d not setup", {m->stream_id});
         return false;
     }
+    StreamContext& stream(*it->second);
 
     // Compute new bandwidth
     if (m->has_bandwidth) {
-        BitRate requested = 1000 * BitRate(m->bandwidth); // protocol unit is kb/s
-        _req_bitrate = _max_bitrate == 0 ? requested : std::min(requested, _max_bitrate);
-        _req_bitrate_changed = true;
-        tsp->verbose(u"requested bandwidth %'d b/s, allocated %'d b/s", {requested, _req_bitrate});
+        const BitRate requested = 1000 * BitRate(m->bandwidth); // protocol unit is kb/s
+        stream.req_bitrate = requested;
+        updateAllocation();
+        tsp->verbose(u"stream %d: requested bandwidth %'d b/s, allocated %'d b/s, total %'d b/s",
+                     {m->stream_id, requested, stream.alloc_bitrate, _total_bitrate});
     }
 
     // Build the response
     response.channel_id = m->channel_id;
     response.stream_id = m->stream_id;
     response.client_id = m->client_id;
-    response.has_bandwidth = _req_bitrate > 0;
-    response.bandwidth = uint16_t(_req_bitrate.toInt() / 1000); // protocol unit is kb/s
+    response.has_bandwidth = stream.alloc_bitrate > 0;
+    response.bandwidth = uint16_t(stream.alloc_bitrate.toInt() / 1000); // protocol unit is kb/s
     return true;
 }
 
@@ -473,30 +664,39 @@ bool ts::DataInjectPlugin::processDataProvision(const tlv::MessagePtr& msg)
 
     std::lock_guard<std::mutex> lock(_mutex);
 
-    // Check that the stream is established.
-    if (!_stream_established) {
-        tsp->error(u"unexpected data_provision, stream not setup");
-        return false;
-    }
-
-    // Check that the client and data id are expected.
+    // Check that the client id is expected.
     if (m->client_id != _client_id) {
         tsp->error(u"unexpected client id 0x%X in data_provision, expected 0x%X", {m->client_id, _client_id});
         return false;
     }
-    if (m->data_id != _data_id) {
-        tsp->error(u"unexpected data id 0x%X in data_provision, expected 0x%X", {m->data_id, _data_id});
+
+    // Locate the target stream. On TCP, the message carries the stream id. On UDP,
+    // the stream id is forbidden and the stream is located using the data id.
+    StreamContextPtr stream;
+    const auto it = _streams.find(m->stream_id);
+    if (it != _streams.end() && it->second->data_id == m->data_id) {
+        stream = it->second;
+    }
+    else {
+        for (const auto& s : _streams) {
+            if (s.second->data_id == m->data_id) {
+                stream = s.second;
+                break;
+            }
+        }
+    }
+    if (stream.isNull()) {
+        tsp->error(u"unexpected data_provision, no stream setup for data id 0x%X", {m->data_id});
         return false;
     }
 
-    // Check that the stream is established.
     bool ok = true;
     if (_section_mode) {
         // Section mode, one section per datagram parameter, enqueue them.
         for (size_t i = 0; i < m->datagram.size(); ++i) {
             SectionPtrMT sp(new Section(m->datagram[i]));
             if (sp->isValid()) {
-                processPacketLoss(u"sections", _section_queue.enqueue(sp, 0));
+                processPacketLoss(u"sections", stream->section_queue.enqueue(sp, 0));
             }
             else {
                 tsp->error(u"received an invalid section (%d bytes)", {m->datagram[i]->size()});
@@ -515,7 +715,7 @@ bool ts::DataInjectPlugin::processDataProvision(const tlv::MessagePtr& msg)
                 else {
                     PacketPtrMT p(new TSPacket());
                     p->copyFrom(data);
-                    processPacketLoss(u"packets", _packet_queue.enqueue(p, 0));
+                    processPacketLoss(u"packets", stream->packet_queue.enqueue(p, 0));
                     data += PKT_SIZE;
                     size -= PKT_SIZE;
                 }
@@ -638,68 +838,95 @@ void ts::DataInjectPlugin::TCPListener::main()
                 }
 
                 case emmgmux::Tags::channel_close: {
-                    std::lock_guard<std::mutex> lock(_plugin->_mutex);
-                    _plugin->_channel_established = false;
-                    _plugin->_stream_established = false;
+                    // Closing the channel also closes all its streams.
+                    _plugin->clearSession();
                     break;
                 }
 
                 case emmgmux::Tags::stream_setup: {
+                    emmgmux::StreamSetup* m = dynamic_cast<emmgmux::StreamSetup*>(msg.pointer());
+                    assert(m != nullptr);
                     if (!_plugin->_channel_established) {
                         _report.error(u"unexpected stream_setup, channel not setup");
                         ok = false;
                     }
-                    else if (_plugin->_stream_established) {
-                        _report.error(u"received stream_setup when stream is already setup");
-                        ok = false;
-                    }
                     else {
-                        emmgmux::StreamSetup* m = dynamic_cast<emmgmux::StreamSetup*>(msg.pointer());
-                        assert(m != nullptr);
                         // First, declare the stream as established.
+                        bool created = false;
                         {
                             std::lock_guard<std::mutex> lock(_plugin->_mutex);
-                            _plugin->_data_id = m->data_id;
-                            _plugin->_stream_established = true;
+                            if (_plugin->_streams.find(m->stream_id) == _plugin->_streams.end()) {
+                                _plugin->_streams[m->stream_id] = new StreamContext(_plugin->duck, m->stream_id, m->data_id, m->data_type, _plugin->_queue_size);
+                                _plugin->updateAllocation();
+                                created = true;
+                            }
+                        }
+                        if (!created) {
+                            _report.error(u"received stream_setup for stream %d which is already setup", {m->stream_id});
+                            ok = false;
+                        }
+                        else {
+                            // Build and send the stream_status
+                            stream_status.channel_id = m->channel_id;
+                            stream_status.stream_id = m->stream_id;
+                            stream_status.client_id = m->client_id;
+                            stream_status.data_id = m->data_id;
+                            stream_status.data_type = m->data_type;
+                            ok = _client.send(stream_status, _plugin->_logger);
                         }
-                        // Build and send the stream_status
-                        stream_status.channel_id = m->channel_id;
-                        stream_status.stream_id = m->stream_id;
-                        stream_status.client_id = m->client_id;
-                        stream_status.data_id = m->data_id;
-                        stream_status.data_type = m->data_type;
-                        ok = _client.send(stream_status, _plugin->_logger);
                     }
                     break;
                 }
 
                 case emmgmux::Tags::stream_test: {
-                    if (_plugin->_stream_established) {
-                        // Automatic reply to stream_test
-                        ok = _client.send(stream_status, _plugin->_logger);
+                    emmgmux::StreamTest* m = dynamic_cast<emmgmux::StreamTest*>(msg.pointer());
+                    assert(m != nullptr);
+                    StreamContextPtr stream;
+                    {
+                        std::lock_guard<std::mutex> lock(_plugin->_mutex);
+                        const auto it = _plugin->_streams.find(m->stream_id);
+                        if (it != _plugin->_streams.end()) {
+                            stream = it->second;
+                        }
                     }
-                    else {
-                        _report.error(u"unexpected stream_test, stream not setup");
+                    if (stream.isNull()) {
+                        _report.error(u"unexpected stream_test, stream %d not setup", {m->stream_id});
                         ok = false;
                     }
+                    else {
+                        // Automatic reply to stream_test
+                        stream_status.channel_id = m->channel_id;
+                        stream_status.stream_id = m->stream_id;
+                        stream_status.client_id = m->client_id;
+                        stream_status.data_id = stream->data_id;
+                        stream_status.data_type = stream->data_type;
+                        ok = _client.send(stream_status, _plugin->_logger);
+                    }
                     break;
                 }
 
                 case emmgmux::Tags::stream_close_request: {
-                    if (!_plugin->_stream_established) {
-                        _report.error(u"unexpected stream_close_request, stream not setup");
+                    emmgmux::StreamCloseRequest* m = dynamic_cast<emmgmux::StreamCloseRequest*>(msg.pointer());
+                    assert(m != nullptr);
+                    // First, declare the stream as closed.
+                    StreamContextPtr stream;
+                    {
+                        std::lock_guard<std::mutex> lock(_plugin->_mutex);
+                        const auto it = _plugin->_streams.find(m->stream_id);
+                        if (it != _plugin->_streams.end()) {
+                            stream = it->second;
+                            _plugin->_streams.erase(it);
+                            _plugin->updateAllocation();
+                        }
+                    }
+                    if (stream.isNull()) {
+                        _report.error(u"unexpected stream_close_request, stream %d not setup", {m->stream_id});
                         ok = false;
                     }
                     else {
-                        // First, declare the stream as closed.
-                        {
-                            std::lock_guard<std::mutex> lock(_plugin->_mutex);
-                            _plugin->_stream_established = false;
-                        }
+                        _plugin->reportStreamStats(*stream);
                         // Send the stream_close_response
                         emmgmux::StreamCloseResponse resp(_plugin->_protocol);
-                        emmgmux::StreamCloseRequest* m = dynamic_cast<emmgmux::StreamCloseRequest*>(msg.pointer());
-                        assert (m != nullptr);
                         resp.channel_id = m->channel_id;
                         resp.stream_id = m->stream_id;
                         resp.client_id = m->client_id;
@@ -28,9 +28,12 @@ namespace ts {
         virtual bool getOptions() override;
         virtual bool start() override;
         virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
+        virtual size_t getPacketWindowSize() override;
+        virtual size_t processPacketWindow(TSPacketWindow&) override;
 
     private:
         bool                _ignoreErrors;  // Ignore encapsulation errors.
+        size_t              _batchPackets;  // Packet window size, zero means per-packet processing.
         PID                 _pid;           // Input PID.
         PacketDecapsulation _decap;         // Decapsulation engine.
     };
@@ -46,9 +49,17 @@ TS_REGISTER_PROCESSOR_PLUGIN(u"decap", ts::DecapPlugin);
 ts::DecapPlugin::DecapPlugin(TSP* tsp_) :
     ProcessorPlugin(tsp_, u"Decapsulate TS packets from a PID produced by encap plugin", u"[options]"),
     _ignoreErrors(false),
+    _batchPackets(0),
     _pid(PID_NULL),
     _decap()
 {
+    option(u"batch-packets", 'b', POSITIVE);
+    help(u"batch-packets",
+         u"Process packets by windows of the specified size instead of one by one. "
+         u"This reduces the per-packet processing overhead at very high bitrates, "
+         u"at the expense of an additional latency of up to the specified number of packets. "
+         u"By default, packets are processed one by one.");
+
     option(u"ignore-errors", 'i');
     help(u"ignore-errors",
          u"Ignore errors such malformed encapsulated stream.");
@@ -67,6 +78,7 @@ ts::DecapPlugin::DecapPlugin(TSP* tsp_) :
 bool ts::DecapPlugin::getOptions()
 {
     _ignoreErrors = present(u"ignore-errors");
+    _batchPackets = intValue<size_t>(u"batch-packets", 0);
     _pid = intValue<PID>(u"pid", PID_NULL);
     return true;
 }
@@ -97,3 +109,27 @@ ts::ProcessorPlugin::Status ts::DecapPlugin::processPacket(TSPacket& pkt, TSPack
         return TSP_END;
     }
 }
+
+
+//----------------------------------------------------------------------------
+// Packet window processing methods.
+//----------------------------------------------------------------------------
+
+size_t ts::DecapPlugin::getPacketWindowSize()
+{
+    return _batchPackets;
+}
+
+size_t ts::DecapPlugin::processPacketWindow(TSPacketWindow& win)
+{
+    // Run the decapsulation engine over the whole window in one pass.
+    for (size_t i = 0; i < win.size(); ++i) {
+        TSPacket* pkt = nullptr;
+        TSPacketMetadata* pkt_data = nullptr;
+        if (win.get(i, pkt, pkt_data) && !_decap.processPacket(*pkt) && !_ignoreErrors && !_decap.lastError().empty()) {
+            tsp->error(_decap.lastError());
+            return i;
+        }
+    }
+    return win.size();
+}
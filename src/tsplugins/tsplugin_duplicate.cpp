@@ -16,6 +16,7 @@
 #include "tsSafePtr.h"
 
 #define DEF_MAX_BUFFERED 1024
+#define PACKET_WINDOW_SIZE 512  // Process packets by windows of that size.
 
 
 //----------------------------------------------------------------------------
@@ -31,6 +32,8 @@ namespace ts {
         virtual bool getOptions() override;
         virtual bool start() override;
         virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
+        virtual size_t getPacketWindowSize() override;
+        virtual size_t processPacketWindow(TSPacketWindow&) override;
 
     private:
         typedef SafePtr<TSPacket> TSPacketPtr;
@@ -140,3 +143,88 @@ ts::ProcessorPlugin::Status ts::DuplicatePlugin::processPacket(TSPacket& pkt, TS
 
     return TSP_OK;
 }
+
+
+//----------------------------------------------------------------------------
+// Packet window processing methods.
+//----------------------------------------------------------------------------
+
+size_t ts::DuplicatePlugin::getPacketWindowSize()
+{
+    return PACKET_WINDOW_SIZE;
+}
+
+size_t ts::DuplicatePlugin::processPacketWindow(TSPacketWindow& win)
+{
+    // Duplicate intents in this window: index of the source packet and new
+    // PID. A duplicate is materialized by one copy, from the source packet to
+    // a later null packet of the same window, without intermediate buffering.
+    // Only the intents which are still pending at the end of the window are
+    // copied into the buffer, as in the per-packet mode.
+    std::vector<std::pair<size_t, PID>> intents;
+    size_t next_intent = 0;
+
+    for (size_t i = 0; i < win.size(); ++i) {
+        TSPacket* pkt = nullptr;
+        TSPacketMetadata* pkt_data = nullptr;
+        if (!win.get(i, pkt, pkt_data)) {
+            continue;
+        }
+        const PID pid = pkt->getPID();
+        const auto it = _pidMap.find(pid);
+        const bool duplicate = it != _pidMap.end();
+
+        // Check PID conflicts.
+        if (!_unchecked && !duplicate && _newPIDs.test(pid)) {
+            tsp->error(u"PID conflict: PID %d (0x%X) present both in input and duplicate", {pid, pid});
+            return i;
+        }
+
+        // Replace null packets, first with packets buffered from previous
+        // windows (older), then with pending intents from this window.
+        if (pid == PID_NULL) {
+            if (!_queue.empty()) {
+                *pkt = *_queue.front();
+                _queue.pop_front();
+                pkt_data->setLabels(_setLabels);
+                pkt_data->clearLabels(_resetLabels);
+            }
+            else if (next_intent < intents.size()) {
+                TSPacket* src = nullptr;
+                TSPacketMetadata* src_data = nullptr;
+                if (win.get(intents[next_intent].first, src, src_data)) {
+                    *pkt = *src;
+                    pkt->setPID(intents[next_intent].second);
+                    pkt_data->setLabels(_setLabels);
+                    pkt_data->clearLabels(_resetLabels);
+                }
+                next_intent++;
+            }
+        }
+
+        // Record packets to duplicate. A null packet can only be replaced by
+        // a packet which precedes it, as in the per-packet mode.
+        if (duplicate) {
+            intents.push_back(std::make_pair(i, it->second));
+        }
+    }
+
+    // Buffer the intents which could not be materialized in this window.
+    for (; next_intent < intents.size(); ++next_intent) {
+        TSPacket* src = nullptr;
+        TSPacketMetadata* src_data = nullptr;
+        if (win.get(intents[next_intent].first, src, src_data)) {
+            if (_queue.size() >= _maxBuffered) {
+                // Buffer overflow, drop the oldest packet.
+                _queue.pop_front();
+                if (!_silentDrop) {
+                    tsp->warning(u"buffer overflow, dropping packet");
+                }
+            }
+            const TSPacketPtr newpkt(new TSPacket(*src));
+            newpkt->setPID(intents[next_intent].second);
+            _queue.push_back(newpkt);
+        }
+    }
+    return win.size();
+}
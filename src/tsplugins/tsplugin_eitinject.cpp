@@ -16,6 +16,8 @@
 #include "tsPollFiles.h"
 #include "tsErrCodeReport.h"
 #include "tsThread.h"
+#include "tsTCPServer.h"
+#include "tsTCPConnection.h"
 
 namespace {
     // Default interval in milliseconds between two poll operations.
@@ -26,6 +28,15 @@ namespace {
 
     // Stack size of listener threads.
     constexpr size_t SERVER_THREAD_STACK_SIZE = 128 * 1024;
+
+    // TCP server backlog, accept one event provider at a time.
+    constexpr int SERVER_BACKLOG = 1;
+
+    // Default maximum number of sections loaded from the event server queue per TS packet.
+    constexpr size_t DEFAULT_MAX_SECTIONS_PER_PACKET = 16;
+
+    // Maximum number of queued sections from the event server before dropping.
+    constexpr size_t MAX_QUEUED_SECTIONS = 50000;
 }
 
 
@@ -68,6 +79,28 @@ namespace ts {
             virtual bool updatePollFiles(UString& wildcard, MilliSecond& poll_interval, MilliSecond& min_stable_delay) override;
         };
 
+        // Event server internal thread. Receives length-prefixed binary EIT
+        // sections over TCP and queues them for the plugin thread.
+        class ServerListener : public Thread
+        {
+            TS_NOBUILD_NOCOPY(ServerListener);
+        public:
+            ServerListener(EITInjectPlugin* plugin);
+            virtual ~ServerListener() override;
+            bool open();
+            void stop();
+
+        private:
+            EITInjectPlugin* const _plugin;
+            TSP* const             _tsp;
+            TCPServer              _server {};
+            TCPConnection          _client {};
+            volatile bool          _terminate = false;
+
+            // Implementation of Thread.
+            virtual void main() override;
+        };
+
         // Command line options:
         bool          _delete_files = false;
         bool          _wait_first_batch = false;
@@ -79,14 +112,21 @@ namespace ts {
         MilliSecond   _poll_interval = 0;
         MilliSecond   _min_stable_delay = 0;
         int           _ts_id = -1;
+        bool          _server_enabled = false;
+        IPv4SocketAddress _server_address {};
+        size_t        _max_sections_per_packet = DEFAULT_MAX_SECTIONS_PER_PACKET;
         EITRepetitionProfile _eit_profile {};
 
         // Working data.
         FileListener  _file_listener;
+        ServerListener _server_listener;
         EITGenerator  _eit_gen;
         volatile bool _check_files = false;    // there are files in _polled_files
         std::mutex    _polled_files_mutex {};  // exclusive access to _polled_files
         UStringList   _polled_files {};        // accessed by two threads, protected by mutex above.
+        volatile bool _check_events = false;   // there are sections in _event_queue
+        std::mutex    _event_queue_mutex {};   // exclusive access to _event_queue
+        std::list<SectionPtr> _event_queue {}; // sections from the event server, protected by mutex above.
 
         // Specific support for deterministic start (wfb = wait first batch, non-regression testing).
         volatile bool _wfb_received = false;   // First batch was received.
@@ -96,6 +136,12 @@ namespace ts {
         // Load files in the context of the plugin thread.
         void loadFiles();
 
+        // Load a bounded number of queued sections in the context of the plugin thread.
+        void loadQueuedSections();
+
+        // Signal the reception of the first batch of events (--wait-first-batch).
+        void signalFirstBatch();
+
         // Read an integer option, using its current version as default value.
         template <typename INT>
         void updateIntValue(INT& value, const UChar* name) {
@@ -114,6 +160,7 @@ TS_REGISTER_PROCESSOR_PLUGIN(u"eitinject", ts::EITInjectPlugin);
 ts::EITInjectPlugin::EITInjectPlugin(TSP* tsp_) :
     ProcessorPlugin(tsp_, u"Generate and inject EIT's in a transport stream", u"[options]"),
     _file_listener(this),
+    _server_listener(this),
     _eit_gen(duck, PID_EIT)
 {
     duck.defineArgsForCharset(*this);
@@ -175,6 +222,19 @@ ts::EITInjectPlugin::EITInjectPlugin(TSP* tsp_) :
          u"By default, the files are left unmodified after being loaded. "
          u"When a loaded file is modified later, it is reloaded and re-injected.");
 
+    option(u"event-server", 0, IPSOCKADDR_OA);
+    help(u"event-server",
+         u"Specifies a local TCP port on which the plugin listens for an incoming "
+         u"event provider connection. The optional address shall specify a local IP "
+         u"address or host name (by default, the plugin accepts connections on any "
+         u"local IP interface). Only one provider connection is accepted at a time. "
+         u"The provider pushes a stream of binary EIT sections, each preceded by a "
+         u"16-bit big-endian length. As with --files, the structure of the EIT "
+         u"sections is ignored, the events are individually extracted and loaded in "
+         u"the EPG. The sections are loaded incrementally, with a bounded amount of "
+         u"work per TS packet, so that a large EPG update does not stall injection "
+         u"(see --max-sections-per-packet).");
+
     option(u"files", 'f', FILENAME);
     help(u"files", u"'file-wildcard'",
          u"A file specification with optional wildcards indicating which event files should be polled. "
@@ -200,6 +260,13 @@ ts::EITInjectPlugin::EITInjectPlugin(TSP* tsp_) :
          u"With this option, EIT schedule update is less frequent and the load on the plugin and "
          u"the receiver is lower.");
 
+    option(u"max-sections-per-packet", 0, POSITIVE);
+    help(u"max-sections-per-packet",
+         u"With --event-server, specify the maximum number of queued sections which "
+         u"are loaded in the EPG for each processed TS packet. This bounds the CPU "
+         u"time which is spent on event loading between two packets. "
+         u"The default is " + UString::Decimal(DEFAULT_MAX_SECTIONS_PER_PACKET) + u" sections.");
+
     option(u"min-stable-delay", 0, UNSIGNED);
     help(u"min-stable-delay", u"milliseconds",
          u"An input file size needs to be stable during that duration, in milliseconds, for "
@@ -294,6 +361,9 @@ bool ts::EITInjectPlugin::getOptions()
     getIntValue(_ts_id, u"ts-id", -1);
     _delete_files = present(u"delete-files");
     _wait_first_batch = present(u"wait-first-batch");
+    _server_enabled = present(u"event-server");
+    getSocketValue(_server_address, u"event-server");
+    getIntValue(_max_sections_per_packet, u"max-sections-per-packet", DEFAULT_MAX_SECTIONS_PER_PACKET);
 
     // Initial reference time.
     const UString time(value(u"time"));
@@ -356,13 +426,13 @@ bool ts::EITInjectPlugin::getOptions()
     updateIntValue(_eit_profile.cycle_seconds[size_t(EITProfile::SCHED_OTHER_PRIME)], u"cycle-schedule-other-prime");
     updateIntValue(_eit_profile.cycle_seconds[size_t(EITProfile::SCHED_OTHER_LATER)], u"cycle-schedule-other-later");
 
-    // We need at least one of --files and --incoming-eits.
-    if (_files.empty() && !(_eit_options & EITOptions::LOAD_INPUT)) {
-        tsp->error(u"specify at least one of --files and --incoming-eits");
+    // We need at least one of --files, --event-server and --incoming-eits.
+    if (_files.empty() && !_server_enabled && !(_eit_options & EITOptions::LOAD_INPUT)) {
+        tsp->error(u"specify at least one of --files, --event-server and --incoming-eits");
         return false;
     }
-    if (_wait_first_batch && _files.empty()) {
-        tsp->error(u"--files is required with --wait-first-batch");
+    if (_wait_first_batch && _files.empty() && !_server_enabled) {
+        tsp->error(u"--files or --event-server is required with --wait-first-batch");
         return false;
     }
 
@@ -408,21 +478,35 @@ bool ts::EITInjectPlugin::start()
         _check_files = false;
         _polled_files.clear();
     }
-    if (!_files.empty()) {
+    {
+        std::lock_guard<std::mutex> lock(_event_queue_mutex);
+        _check_events = false;
+        _event_queue.clear();
+    }
+
+    // Start the event server thread.
+    if (_server_enabled) {
+        if (!_server_listener.open()) {
+            return false;
+        }
+        _server_listener.start();
+    }
 
-        // Start the file listener thread.
+    // Start the file listener thread.
+    if (!_files.empty()) {
         _file_listener.start();
+    }
 
-        // If --wait-first-batch was specified, suspend until a first batch of events is loaded.
-        if (_wait_first_batch) {
-            tsp->verbose(u"waiting for first batch of events");
-            {
-                std::unique_lock<std::mutex> lock(_wfb_mutex);
-                _wfb_cond.wait(lock, [this]() { return _wfb_received; });
-            }
-            tsp->verbose(u"received first batch of events");
-            loadFiles();
+    // If --wait-first-batch was specified, suspend until a first batch of events is received.
+    if (_wait_first_batch && (!_files.empty() || _server_enabled)) {
+        tsp->verbose(u"waiting for first batch of events");
+        {
+            std::unique_lock<std::mutex> lock(_wfb_mutex);
+            _wfb_cond.wait(lock, [this]() { return _wfb_received; });
         }
+        tsp->verbose(u"received first batch of events");
+        loadFiles();
+        loadQueuedSections();
     }
 
     return true;
@@ -435,10 +519,13 @@ bool ts::EITInjectPlugin::start()
 
 bool ts::EITInjectPlugin::stop()
 {
-    // Stop the internal thread.
+    // Stop the internal threads.
     if (!_files.empty()) {
         _file_listener.stop();
     }
+    if (_server_enabled) {
+        _server_listener.stop();
+    }
     return true;
 }
 
@@ -454,6 +541,11 @@ ts::ProcessorPlugin::Status ts::EITInjectPlugin::processPacket(TSPacket& pkt, TS
         loadFiles();
     }
 
+    // If the event server thread queued sections, load a bounded batch of them.
+    if (_check_events) {
+        loadQueuedSections();
+    }
+
     // Let the EIT generator process the packet.
     _eit_gen.setTransportStreamBitRate(tsp->bitrate());
     _eit_gen.processPacket(pkt);
@@ -526,16 +618,120 @@ bool ts::EITInjectPlugin::FileListener::handlePolledFiles(const PolledFileList&
     }
 
     // If --wait-first-batch was specified, signal when the first batch of commands is queued.
-    if (_plugin->_wait_first_batch && !_plugin->_wfb_received) {
-        std::lock_guard<std::mutex> lock(_plugin->_wfb_mutex);
-        _plugin->_wfb_received = true;
-        _plugin->_wfb_cond.notify_one();
-    }
+    _plugin->signalFirstBatch();
 
     return !_terminate;
 }
 
 
+//----------------------------------------------------------------------------
+// Event server internal thread.
+//----------------------------------------------------------------------------
+
+// Constructor.
+ts::EITInjectPlugin::ServerListener::ServerListener(EITInjectPlugin* plugin) :
+    Thread(ThreadAttributes().setStackSize(SERVER_THREAD_STACK_SIZE)),
+    _plugin(plugin),
+    _tsp(plugin->tsp)
+{
+}
+
+// Destructor.
+ts::EITInjectPlugin::ServerListener::~ServerListener()
+{
+    stop();
+}
+
+// Open the TCP server, in the context of the plugin thread, before starting the thread.
+bool ts::EITInjectPlugin::ServerListener::open()
+{
+    _terminate = false;
+    if (!_server.open(*_tsp)) {
+        return false;
+    }
+    if (!_server.reusePort(true, *_tsp) || !_server.bind(_plugin->_server_address, *_tsp) || !_server.listen(SERVER_BACKLOG, *_tsp)) {
+        _server.close(*_tsp);
+        return false;
+    }
+    return true;
+}
+
+// Terminate the thread.
+void ts::EITInjectPlugin::ServerListener::stop()
+{
+    // Close the server, then break the client connection.
+    // This will force the server thread to terminate.
+    _terminate = true;
+    _server.close(NULLREP);
+    _client.disconnect(NULLREP);
+    _client.close(NULLREP);
+
+    // Wait for actual thread termination.
+    Thread::waitForTermination();
+}
+
+// Invoked in the context of the event server thread.
+void ts::EITInjectPlugin::ServerListener::main()
+{
+    _tsp->debug(u"event server thread started");
+
+    IPv4SocketAddress client_address;
+    uint8_t header[2];
+    ByteBlock buffer;
+
+    // Loop on client acceptance (accept only one provider at a time).
+    while (!_terminate && _server.accept(_client, client_address, *_tsp)) {
+        _tsp->verbose(u"incoming event provider connection from %s", {client_address});
+
+        // Loop on length-prefixed binary sections from the client.
+        for (;;) {
+            // Read the 16-bit big-endian length prefix, then the section.
+            if (!_client.receive(header, sizeof(header), nullptr, NULLREP)) {
+                break; // disconnected
+            }
+            const size_t size = GetUInt16(header);
+            if (size == 0 || size > MAX_PRIVATE_SECTION_SIZE) {
+                _tsp->error(u"invalid section length %d from event provider, disconnecting", {size});
+                break;
+            }
+            buffer.resize(size);
+            if (!_client.receive(buffer.data(), size, nullptr, NULLREP)) {
+                _tsp->error(u"truncated section from event provider");
+                break;
+            }
+
+            // Rebuild and validate the section.
+            const SectionPtr section(new Section(buffer.data(), size, PID_NULL, CRC32::CHECK));
+            if (!section->isValid()) {
+                // Framing is preserved by the length prefix, just drop the section.
+                _tsp->warning(u"invalid section from event provider, dropped");
+                continue;
+            }
+
+            // Queue the section for the plugin thread.
+            {
+                std::lock_guard<std::mutex> lock(_plugin->_event_queue_mutex);
+                if (_plugin->_event_queue.size() >= MAX_QUEUED_SECTIONS) {
+                    _tsp->warning(u"event queue overflow, dropping section");
+                }
+                else {
+                    _plugin->_event_queue.push_back(section);
+                    _plugin->_check_events = true;
+                }
+            }
+
+            // If --wait-first-batch was specified, signal the first received events.
+            _plugin->signalFirstBatch();
+        }
+
+        _client.disconnect(NULLREP);
+        _client.close(NULLREP);
+    }
+
+    _tsp->debug(u"event server thread completed");
+}
+
+
 //----------------------------------------------------------------------------
 // Load files in the context of the plugin thread.
 //----------------------------------------------------------------------------
@@ -563,3 +759,41 @@ void ts::EITInjectPlugin::loadFiles()
     _polled_files.clear();
     _check_files = false;
 }
+
+
+//----------------------------------------------------------------------------
+// Load a bounded number of queued sections in the context of the plugin thread.
+//----------------------------------------------------------------------------
+
+void ts::EITInjectPlugin::loadQueuedSections()
+{
+    // Extract a bounded batch under mutex protection, load it outside.
+    // The rest of the queue is processed with the next packets, so that a
+    // large EPG update is amortized instead of stalling the stream.
+    std::list<SectionPtr> batch;
+    {
+        std::lock_guard<std::mutex> lock(_event_queue_mutex);
+        for (size_t i = 0; i < _max_sections_per_packet && !_event_queue.empty(); ++i) {
+            batch.push_back(_event_queue.front());
+            _event_queue.pop_front();
+        }
+        _check_events = !_event_queue.empty();
+    }
+    for (const auto& it : batch) {
+        _eit_gen.loadEvents(*it);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Signal the reception of the first batch of events (--wait-first-batch).
+//----------------------------------------------------------------------------
+
+void ts::EITInjectPlugin::signalFirstBatch()
+{
+    if (_wait_first_batch && !_wfb_received) {
+        std::lock_guard<std::mutex> lock(_wfb_mutex);
+        _wfb_received = true;
+        _wfb_cond.notify_one();
+    }
+}
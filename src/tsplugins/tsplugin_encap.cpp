@@ -29,9 +29,12 @@ namespace ts {
         virtual bool getOptions() override;
         virtual bool start() override;
         virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
+        virtual size_t getPacketWindowSize() override;
+        virtual size_t processPacketWindow(TSPacketWindow&) override;
 
     private:
         bool                         _ignoreErrors = false;  // Ignore encapsulation errors.
+        size_t                       _batchPackets = 0;      // Packet window size, zero means per-packet processing.
         bool                         _pack = false;          // Outer packet packing option.
         size_t                       _packLimit = 0;         // Max limit distance.
         size_t                       _maxBuffered = 0;       // Max buffered packets.
@@ -54,6 +57,13 @@ TS_REGISTER_PROCESSOR_PLUGIN(u"encap", ts::EncapPlugin);
 ts::EncapPlugin::EncapPlugin(TSP* tsp_) :
     ProcessorPlugin(tsp_, u"Encapsulate packets from several PID's into one single PID", u"[options]")
 {
+    option(u"batch-packets", 'b', POSITIVE);
+    help(u"batch-packets",
+         u"Process packets by windows of the specified size instead of one by one. "
+         u"This reduces the per-packet processing overhead at very high bitrates, "
+         u"at the expense of an additional latency of up to the specified number of packets. "
+         u"By default, packets are processed one by one.");
+
     option(u"ignore-errors", 'i');
     help(u"ignore-errors",
          u"Ignore errors such as PID conflict or packet overflow. By default, a PID conflict is "
@@ -120,6 +130,7 @@ ts::EncapPlugin::EncapPlugin(TSP* tsp_) :
 bool ts::EncapPlugin::getOptions()
 {
     _ignoreErrors = present(u"ignore-errors");
+    getIntValue(_batchPackets, u"batch-packets", 0);
     _pack = present(u"pack");
     getIntValue(_packLimit, u"pack", 0);
     getIntValue(_maxBuffered, u"max-buffered-packets", PacketEncapsulation::DEFAULT_MAX_BUFFERED_PACKETS);
@@ -163,7 +174,12 @@ bool ts::EncapPlugin::start()
 
 ts::ProcessorPlugin::Status ts::EncapPlugin::processPacket(TSPacket& pkt, TSPacketMetadata& pkt_data)
 {
+    const PID pid = pkt.getPID();
     if (_encap.processPacket(pkt) || _ignoreErrors || _encap.lastError().empty()) {
+        if (pkt.getPID() != pid) {
+            // The packet was replaced by the encapsulation engine, the cached PCR is stale.
+            pkt_data.clearPCR();
+        }
         return TSP_OK;
     }
     else {
@@ -171,3 +187,34 @@ ts::ProcessorPlugin::Status ts::EncapPlugin::processPacket(TSPacket& pkt, TSPack
         return TSP_END;
     }
 }
+
+
+//----------------------------------------------------------------------------
+// Packet window processing methods.
+//----------------------------------------------------------------------------
+
+size_t ts::EncapPlugin::getPacketWindowSize()
+{
+    return _batchPackets;
+}
+
+size_t ts::EncapPlugin::processPacketWindow(TSPacketWindow& win)
+{
+    // Run the encapsulation engine over the whole window in one pass.
+    for (size_t i = 0; i < win.size(); ++i) {
+        TSPacket* pkt = nullptr;
+        TSPacketMetadata* pkt_data = nullptr;
+        if (win.get(i, pkt, pkt_data)) {
+            const PID pid = pkt->getPID();
+            if (!_encap.processPacket(*pkt) && !_ignoreErrors && !_encap.lastError().empty()) {
+                tsp->error(_encap.lastError());
+                return i;
+            }
+            if (pkt->getPID() != pid) {
+                // The packet was replaced by the encapsulation engine, the cached PCR is stale.
+                pkt_data->clearPCR();
+            }
+        }
+    }
+    return win.size();
+}
@@ -16,6 +16,8 @@
 #include "tsAlgorithm.h"
 #include "tsMemory.h"
 
+#define PACKET_WINDOW_SIZE 512  // Process packets by windows of that size.
+
 
 //----------------------------------------------------------------------------
 // Plugin definition
@@ -31,6 +33,8 @@ namespace ts {
         virtual bool start() override;
         virtual bool stop() override;
         virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
+        virtual size_t getPacketWindowSize() override;
+        virtual size_t processPacketWindow(TSPacketWindow&) override;
 
     private:
         // Packet intervals and list of them.
@@ -89,6 +93,10 @@ namespace ts {
         std::set<uint16_t> _all_service_ids {};         // All service ids to filter, after service name resolution
         SignalizationDemux _demux {duck};               // Full signalization demux
 
+        // Process one packet, non-virtual core of processPacket().
+        // The packet index in the plugin session is passed by the caller.
+        Status processOnePacket(TSPacket&, TSPacketMetadata&, PacketCounter packet_index);
+
         // Implementation of SignalizationHandlerInterface
         virtual void handleService(uint16_t ts_id, const Service& service, const PMT& pmt, bool removed) override;
     };
@@ -459,6 +467,11 @@ bool ts::FilterPlugin::stop()
 //----------------------------------------------------------------------------
 
 ts::ProcessorPlugin::Status ts::FilterPlugin::processPacket(TSPacket& pkt, TSPacketMetadata& pkt_data)
+{
+    return processOnePacket(pkt, pkt_data, tsp->pluginPackets());
+}
+
+ts::ProcessorPlugin::Status ts::FilterPlugin::processOnePacket(TSPacket& pkt, TSPacketMetadata& pkt_data, PacketCounter packetIndex)
 {
     const PID pid = pkt.getPID();
 
@@ -468,7 +481,6 @@ ts::ProcessorPlugin::Status ts::FilterPlugin::processPacket(TSPacket& pkt, TSPac
     }
 
     // Pass initial packets without filtering.
-    const PacketCounter packetIndex = tsp->pluginPackets();
     if (packetIndex < _after_packets) {
         return TSP_OK;
     }
@@ -511,7 +523,7 @@ ts::ProcessorPlugin::Status ts::FilterPlugin::processPacket(TSPacket& pkt, TSPac
         (int(pkt.getPayloadSize()) <= _max_payload) ||
         (_min_af >= 0 && int(pkt.getAFSize()) >= _min_af) ||
         (int(pkt.getAFSize()) <= _max_af) ||
-        (_every_packets > 0 && (tsp->pluginPackets() - _after_packets) % _every_packets == 0) ||
+        (_every_packets > 0 && (packetIndex - _after_packets) % _every_packets == 0) ||
         (_with_pes && pkt.startPES());
 
     // Search binary patterns in packets.
@@ -554,6 +566,42 @@ ts::ProcessorPlugin::Status ts::FilterPlugin::processPacket(TSPacket& pkt, TSPac
 }
 
 
+//----------------------------------------------------------------------------
+// Packet window processing methods.
+//----------------------------------------------------------------------------
+
+size_t ts::FilterPlugin::getPacketWindowSize()
+{
+    return PACKET_WINDOW_SIZE;
+}
+
+size_t ts::FilterPlugin::processPacketWindow(TSPacketWindow& win)
+{
+    // Process the packets of a window in sequence, without going back to tsp
+    // between packets. On high-volume streams, the per-packet executor
+    // overhead and virtual dispatch are paid once per window only.
+    PacketCounter packet_index = tsp->pluginPackets();
+    for (size_t i = 0; i < win.size(); ++i) {
+        TSPacket* pkt = nullptr;
+        TSPacketMetadata* mdata = nullptr;
+        if (win.get(i, pkt, mdata)) {
+            const Status status = processOnePacket(*pkt, *mdata, packet_index);
+            if (status == TSP_NULL) {
+                win.nullify(i);
+            }
+            else if (status == TSP_DROP) {
+                win.drop(i);
+            }
+            else if (status == TSP_END) {
+                return i;
+            }
+        }
+        packet_index++;
+    }
+    return win.size();
+}
+
+
 //----------------------------------------------------------------------------
 // Handle potential changes in the service list.
 //----------------------------------------------------------------------------
@@ -15,6 +15,11 @@
 #include "tsHiDesDevice.h"
 #include "tsModulationArgs.h"
 #include "tsLegacyBandWidth.h"
+#include "tsThread.h"
+
+#define DEFAULT_IO_THREAD_BUFFER_PACKETS 16384 // default size in packets of the staging buffer with --io-thread
+#define WRITE_ALIGN_PACKETS 172                // size in packets of one device transfer (ITE_MAX_SEND_PACKETS in the driver interface)
+#define WRITE_CHUNK_PACKETS (4 * WRITE_ALIGN_PACKETS) // max size in packets of one write operation of the writer thread
 
 
 //----------------------------------------------------------------------------
@@ -35,11 +40,41 @@ namespace ts {
         virtual BitRateConfidence getBitrateConfidence() override;
 
     private:
+        // Dedicated writer thread (option --io-thread).
+        class Writer : public Thread
+        {
+            TS_NOBUILD_NOCOPY(Writer);
+        public:
+            Writer(HiDesOutputPlugin* plugin) : _plugin(plugin) {}
+            virtual void main() override { _plugin->writerMain(); }
+        private:
+            HiDesOutputPlugin* const _plugin;
+        };
+
+        // Main loop of the dedicated writer thread (option --io-thread).
+        void writerMain();
+
+        // Command line options:
         int             _dev_number = -1;  // Device adapter number.
         UString         _dev_name {};      // Device name.
+        bool            _use_io_thread = false;  // Option --io-thread.
+
+        // Working data:
         BitRate         _bitrate = 0;      // Nominal output bitrate.
         HiDesDevice     _device {};        // HiDes device object.
         HiDesDeviceInfo _dev_info {};      // HiDes device information.
+        bool            _writer_started = false;  // The writer thread is running.
+        volatile bool   _stop_writer = false;     // Ask the writer thread to terminate.
+        volatile bool   _writer_error = false;    // A write failed in the writer thread.
+        std::mutex      _mutex {};                // Protect the staging ring.
+        std::condition_variable _staged {};       // Signal packets added in the staging ring.
+        std::condition_variable _unstaged {};     // Signal packets removed from the staging ring.
+        TSPacketVector  _ring {};                 // Staging ring between send() and the writer thread.
+        size_t          _ring_head = 0;           // Index of the oldest staged packet in the ring.
+        size_t          _ring_size = 0;           // Number of staged packets in the ring.
+        bool            _starved = false;         // The writer thread is currently starved.
+        PacketCounter   _underruns = 0;           // Number of times the writer thread starved during transmission.
+        Writer          _writer {this};           // Dedicated writer thread.
     };
 }
 
@@ -95,6 +130,14 @@ ts::HiDesOutputPlugin::HiDesOutputPlugin(TSP* tsp_) :
     }));
     help(u"guard-interval", u"Guard interval. The default is 1/32.");
 
+    option(u"io-thread", 0, INTEGER, 0, 1, 64, UNLIMITED_VALUE, true);
+    help(u"io-thread",
+         u"Write packets to the device from a dedicated thread. "
+         u"The optional value is the size in packets of the staging buffer between "
+         u"the plugin thread and the writer thread. The default is " TS_USTRINGIFY(DEFAULT_IO_THREAD_BUFFER_PACKETS) u" packets. "
+         u"The writer thread absorbs the latency spikes of the device interface "
+         u"which could otherwise starve the modulator at high bitrates.");
+
     option(u"high-priority-fec", 'h', Enumeration({
         {u"1/2", FEC_1_2},
         {u"2/3", FEC_2_3},
@@ -130,6 +173,7 @@ bool ts::HiDesOutputPlugin::start()
     // Get options.
     _dev_number = intValue<int>(u"adapter", -1);
     _dev_name = value(u"device");
+    _use_io_thread = present(u"io-thread");
     const bool set_gain = present(u"gain");
     const int gain = intValue<int>(u"gain");
     const bool set_dc = present(u"dc-compensation");
@@ -214,6 +258,23 @@ bool ts::HiDesOutputPlugin::start()
         return false;
     }
 
+    // Start the dedicated writer thread when requested.
+    if (_use_io_thread) {
+        _ring.resize(intValue<size_t>(u"io-thread", DEFAULT_IO_THREAD_BUFFER_PACKETS));
+        _ring_head = _ring_size = 0;
+        _starved = false;
+        _underruns = 0;
+        _stop_writer = _writer_error = false;
+        if (!_writer.start()) {
+            tsp->error(u"error starting the I/O thread");
+            _device.stopTransmission(*tsp);
+            _device.close(*tsp);
+            return false;
+        }
+        _writer_started = true;
+        tsp->verbose(u"started dedicated writer thread, staging buffer: %'d packets", {_ring.size()});
+    }
+
     // Now fully ready to transmit.
     return true;
 }
@@ -225,6 +286,19 @@ bool ts::HiDesOutputPlugin::start()
 
 bool ts::HiDesOutputPlugin::stop()
 {
+    // Terminate the writer thread first. It drains the staging ring before exiting.
+    if (_writer_started) {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop_writer = true;
+        }
+        _staged.notify_all();
+        _writer.waitForTermination();
+        _writer_started = false;
+        _ring.clear();
+        tsp->verbose(u"writer thread terminated, %'d output buffer underruns", {_underruns});
+    }
+
     return _device.stopTransmission(*tsp) && _device.close(*tsp);
 }
 
@@ -252,5 +326,101 @@ ts::BitRateConfidence ts::HiDesOutputPlugin::getBitrateConfidence()
 
 bool ts::HiDesOutputPlugin::send(const TSPacket* pkt, const TSPacketMetadata* pkt_data, size_t packet_count)
 {
-    return _device.send(pkt, packet_count, *tsp, tsp);
+    // Without writer thread, write to the device directly from the plugin thread.
+    if (!_writer_started) {
+        return _device.send(pkt, packet_count, *tsp, tsp);
+    }
+
+    // With --io-thread, hand the packets over to the writer thread through the staging ring.
+    size_t remain = packet_count;
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (remain > 0) {
+        if (_writer_error) {
+            // The error was already reported by the writer thread.
+            return false;
+        }
+        if (_ring_size >= _ring.size()) {
+            // The staging ring is full, wait for the writer thread to drain part of it.
+            // Wake up regularly to check for error and abort conditions.
+            if (tsp->aborting()) {
+                return false;
+            }
+            _unstaged.wait_for(lock, std::chrono::milliseconds(1));
+            continue;
+        }
+        // Copy as much as possible at the back of the staging ring, up to the wrap-around point.
+        const size_t back = (_ring_head + _ring_size) % _ring.size();
+        const size_t count = std::min(std::min(remain, _ring.size() - _ring_size), _ring.size() - back);
+        TSPacket::Copy(&_ring[back], pkt, count);
+        _ring_size += count;
+        pkt += count;
+        remain -= count;
+        _staged.notify_all();
+    }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Main loop of the dedicated writer thread (option --io-thread).
+//----------------------------------------------------------------------------
+
+void ts::HiDesOutputPlugin::writerMain()
+{
+    // The device interface transfers bursts of WRITE_ALIGN_PACKETS packets.
+    // Write in multiples of that size when possible, so that the last burst
+    // of a write operation is not a small remainder.
+    TSPacketVector chunk(WRITE_CHUNK_PACKETS);
+    bool ok = true;
+
+    while (ok) {
+
+        // Wait until packets are staged or termination is requested.
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            if (!_stop_writer && _ring_size == 0 && _starved) {
+                // The upstream processing does not sustain the modulator bitrate,
+                // the device FIFO drains while we have nothing to write. Count
+                // one underrun per starvation episode, not per wakeup.
+                _starved = false;
+                _underruns++;
+                tsp->debug(u"output buffer underrun, %'d so far", {_underruns});
+            }
+            _staged.wait(lock, [this]() { return _stop_writer || _ring_size > 0; });
+            if (_ring_size == 0) {
+                // Termination was requested and the ring is drained.
+                break;
+            }
+        }
+
+        // Extract a chunk from the staging ring, in aligned bursts when possible.
+        size_t count = 0;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            count = std::min(_ring_size, chunk.size());
+            if (count >= WRITE_ALIGN_PACKETS) {
+                count -= count % WRITE_ALIGN_PACKETS;
+            }
+            const size_t part1 = std::min(count, _ring.size() - _ring_head);
+            TSPacket::Copy(&chunk[0], &_ring[_ring_head], part1);
+            if (part1 < count) {
+                TSPacket::Copy(&chunk[part1], &_ring[0], count - part1);
+            }
+            _ring_head = (_ring_head + count) % _ring.size();
+            _ring_size -= count;
+        }
+        _unstaged.notify_all();
+
+        // The initial wait of a session is not an underrun, arm the detection
+        // only once something was written to the device.
+        _starved = true;
+
+        ok = _device.send(chunk.data(), count, *tsp, tsp);
+    }
+
+    if (!ok) {
+        // Remember the error and release a potentially blocked send().
+        _writer_error = true;
+        _unstaged.notify_all();
+    }
 }
@@ -15,6 +15,7 @@
 #include "tsBinaryTable.h"
 #include "tsSectionDemux.h"
 #include "tsCASFamily.h"
+#include "tsHistoryEvent.h"
 #include "tsNames.h"
 #include "tsTime.h"
 #include "tsPES.h"
@@ -63,6 +64,7 @@ namespace ts {
         bool          _time_all = false;          // Report all TDT/TOT
         bool          _ignore_stream_id = false;  // Ignore stream_id modifications
         bool          _use_milliseconds = false;  // Report playback time instead of packet number
+        bool          _binary = false;            // Write binary event records instead of text
         PacketCounter _suspend_after = 0;         // Number of missing packets after which a PID is considered as suspended
         UString       _outfile_name {};           // Output file name
 
@@ -81,9 +83,12 @@ namespace ts {
         // Analyze a list of descriptors, looking for ECM PID's
         void analyzeCADescriptors(const DescriptorList& dlist, uint16_t service_id);
 
-        // Report a history line
-        void report(const UChar* fmt, const std::initializer_list<ArgMixIn> args);
-        void report(PacketCounter, const UChar* fmt, const std::initializer_list<ArgMixIn> args);
+        // Report the new version of a long table.
+        void reportLongTable(const BinaryTable& table);
+
+        // Report a history event
+        void report(const HistoryEvent& event);
+        void report(PacketCounter, const HistoryEvent& event);
     };
 }
 
@@ -97,6 +102,13 @@ TS_REGISTER_PROCESSOR_PLUGIN(u"history", ts::HistoryPlugin);
 ts::HistoryPlugin::HistoryPlugin(TSP* tsp_) :
     ProcessorPlugin(tsp_, u"Report a history of major events on the transport stream", u"[options]")
 {
+    option(u"binary", 'b');
+    help(u"binary",
+         u"With --output-file, write compact binary event records instead of "
+         u"formatted text. Each event is one small fixed-size record, no text "
+         u"formatting is performed on the packet path. Use the command "
+         u"tshistory to convert such a file to the usual text format.");
+
     option(u"cas", 'c');
     help(u"cas", u"Report all CAS events (ECM, crypto-periods).");
 
@@ -149,8 +161,13 @@ bool ts::HistoryPlugin::getOptions()
     _time_all = present(u"time-all");
     _ignore_stream_id = present(u"ignore-stream-id-change");
     _use_milliseconds = present(u"milli-seconds");
+    _binary = present(u"binary");
     getIntValue(_suspend_after, u"suspend-packet-threshold");
     getValue(_outfile_name, u"output-file");
+    if (_binary && _outfile_name.empty()) {
+        tsp->error(u"--binary requires --output-file");
+        return false;
+    }
     return true;
 }
 
@@ -164,11 +181,19 @@ bool ts::HistoryPlugin::start()
     // Create output file
     if (!_outfile_name.empty()) {
         tsp->verbose(u"creating %s", {_outfile_name});
-        _outfile.open(_outfile_name.toUTF8().c_str(), std::ios::out);
+        _outfile.open(_outfile_name.toUTF8().c_str(), _binary ? (std::ios::out | std::ios::binary) : std::ios::out);
         if (!_outfile) {
             tsp->error(u"cannot create %s", {_outfile_name});
             return false;
         }
+        if (_binary) {
+            // File header: magic, format version, flags.
+            uint8_t header[HistoryEvent::HEADER_SIZE];
+            std::memcpy(header, HistoryEvent::FileMagic(), HistoryEvent::MAGIC_SIZE);
+            header[HistoryEvent::MAGIC_SIZE] = HistoryEvent::FILE_VERSION;
+            header[HistoryEvent::MAGIC_SIZE + 1] = _use_milliseconds ? HistoryEvent::FLAG_MILLISECOND : 0;
+            _outfile.write(reinterpret_cast<const char*>(header), HistoryEvent::HEADER_SIZE);
+        }
     }
 
     // Reinitialize state
@@ -204,7 +229,10 @@ bool ts::HistoryPlugin::stop()
     // Report last packet of each PID
     for (const auto& it : _cpids) {
         if (it.second.pkt_count > 0) {
-            report(it.second.last_pkt, u"PID %d (0x%<X) last packet, %s", {it.first, it.second.scrambling ? u"scrambled" : u"clear"});
+            HistoryEvent ev(HistoryEvent::PID_LAST);
+            ev.pid = it.first;
+            ev.aux = it.second.scrambling;
+            report(it.second.last_pkt, ev);
         }
     }
 
@@ -224,7 +252,11 @@ bool ts::HistoryPlugin::stop()
 void ts::HistoryPlugin::handleSection(SectionDemux& demux, const Section& section)
 {
     if (_report_eit && EIT::IsEIT(section.tableId())) {
-        report(u"%s v%d, service 0x%X", {names::TID(duck, section.tableId()), section.version(), section.tableIdExtension()});
+        HistoryEvent ev(HistoryEvent::EIT_SECTION);
+        ev.tid = section.tableId();
+        ev.version = section.version();
+        ev.ext = section.tableIdExtension();
+        report(ev);
     }
 }
 
@@ -241,7 +273,7 @@ void ts::HistoryPlugin::handleTable(SectionDemux& demux, const BinaryTable& tabl
 
         case TID_PAT: {
             if (table.sourcePID() == PID_PAT) {
-                report(u"PAT v%d, TS 0x%X", {table.version(), table.tableIdExtension()});
+                reportLongTable(table);
                 PAT pat(duck, table);
                 if (pat.isValid()) {
                     // Filter all PMT PIDs.
@@ -262,7 +294,9 @@ void ts::HistoryPlugin::handleTable(SectionDemux& demux, const BinaryTable& tabl
                 _last_tdt_reported = false;
                 // Report TDT only if --time-all
                 if (_time_all && _last_tdt.isValid()) {
-                    report(u"TDT: %s UTC", {_last_tdt.utc_time.format(Time::DATETIME)});
+                    HistoryEvent ev(HistoryEvent::TDT_TIME);
+                    ev.time = _last_tdt.utc_time;
+                    report(ev);
                 }
             }
             break;
@@ -274,10 +308,14 @@ void ts::HistoryPlugin::handleTable(SectionDemux& demux, const BinaryTable& tabl
                     TOT tot(duck, table);
                     if (tot.isValid()) {
                         if (tot.regions.empty()) {
-                            report(u"TOT: %s UTC", {tot.utc_time.format(Time::DATETIME)});
+                            HistoryEvent ev(HistoryEvent::TOT_TIME_UTC);
+                            ev.time = tot.utc_time;
+                            report(ev);
                         }
                         else {
-                            report(u"TOT: %s LOCAL", {tot.localTime(tot.regions[0]).format(Time::DATETIME)});
+                            HistoryEvent ev(HistoryEvent::TOT_TIME_LOCAL);
+                            ev.time = tot.localTime(tot.regions[0]);
+                            report(ev);
                         }
                     }
                 }
@@ -286,7 +324,7 @@ void ts::HistoryPlugin::handleTable(SectionDemux& demux, const BinaryTable& tabl
         }
 
         case TID_PMT: {
-            report(u"PMT v%d, service 0x%X", {table.version(), table.tableIdExtension()});
+            reportLongTable(table);
             PMT pmt(duck, table);
             if (pmt.isValid()) {
                 // Get components of the service, including ECM PID's
@@ -302,7 +340,7 @@ void ts::HistoryPlugin::handleTable(SectionDemux& demux, const BinaryTable& tabl
         case TID_NIT_ACT:
         case TID_NIT_OTH: {
             if (table.sourcePID() == PID_NIT) {
-                report(u"%s v%d, network 0x%X", {names::TID(duck, table.tableId()), table.version(), table.tableIdExtension()});
+                reportLongTable(table);
             }
             break;
         }
@@ -310,14 +348,14 @@ void ts::HistoryPlugin::handleTable(SectionDemux& demux, const BinaryTable& tabl
         case TID_SDT_ACT:
         case TID_SDT_OTH: {
             if (table.sourcePID() == PID_SDT) {
-                report(u"%s v%d, TS 0x%X", {names::TID(duck, table.tableId()), table.version(), table.tableIdExtension()});
+                reportLongTable(table);
             }
             break;
         }
 
         case TID_BAT: {
             if (table.sourcePID() == PID_BAT) {
-                report(u"BAT v%d, bouquet 0x%X", {table.version(), table.tableIdExtension()});
+                reportLongTable(table);
             }
             break;
         }
@@ -325,7 +363,7 @@ void ts::HistoryPlugin::handleTable(SectionDemux& demux, const BinaryTable& tabl
         case TID_CAT:
         case TID_TSDT: {
             // Long sections without TID extension
-            report(u"%s v%d", {names::TID(duck, table.tableId()), table.version()});
+            reportLongTable(table);
             break;
         }
 
@@ -334,19 +372,24 @@ void ts::HistoryPlugin::handleTable(SectionDemux& demux, const BinaryTable& tabl
             // Got an ECM
             if (_report_cas && _cpids[pid].last_tid != table.tableId()) {
                 // Got a new ECM
-                report(u"PID %d (0x%X), service 0x%X, new ECM 0x%X", {pid, pid, _cpids[pid].service_id, table.tableId()});
+                HistoryEvent ev(HistoryEvent::NEW_ECM);
+                ev.pid = pid;
+                ev.ext = _cpids[pid].service_id;
+                ev.tid = table.tableId();
+                report(ev);
             }
             break;
         }
 
         default: {
             if (!EIT::IsEIT(table.tableId())) {
-                const UString name(names::TID(duck, table.tableId()));
                 if (table.sectionCount() > 0 && table.sectionAt(0)->isLongSection()) {
-                    report(u"%s v%d, TIDext 0x%X", {name, table.version(), table.tableIdExtension()});
+                    reportLongTable(table);
                 }
                 else {
-                    report(u"%s", {name});
+                    HistoryEvent ev(HistoryEvent::TABLE_SHORT);
+                    ev.tid = table.tableId();
+                    report(ev);
                 }
             }
             break;
@@ -434,37 +477,58 @@ ts::ProcessorPlugin::Status ts::HistoryPlugin::processPacket(TSPacket& pkt, TSPa
     // immediately followed by clear-to-scrambled transistions.
     const bool ignore_scrambling = !pkt.hasPayload() || pkt.getPayloadSize() < 8;
 
+    // Common fields of packet-level events.
+    HistoryEvent ev;
+    ev.pid = pid;
+    ev.ext = cpid.service_id;
+
     if (cpid.pkt_count == 0) {
         // First packet in a PID
         cpid.first_pkt = tsp->pluginPackets();
-        report(u"PID %d (0x%<X) first packet, %s", {pid, scrambling ? u"scrambled" : u"clear"});
+        ev.type = HistoryEvent::PID_FIRST;
+        ev.aux = scrambling;
+        report(ev);
     }
     else if (cpid.last_pkt + _suspend_after < tsp->pluginPackets()) {
         // Last packet in the PID is so old that we consider the PID as suspended, and now restarted
-        report(cpid.last_pkt, u"PID %d (0x%<X) suspended, %s, service 0x%X", {pid, cpid.scrambling ? u"scrambled" : u"clear", _cpids[pid].service_id});
-        report(u"PID %d (0x%<X) restarted, %s, service 0x%04X", {pid, scrambling ? u"scrambled" : u"clear", _cpids[pid].service_id});
+        ev.type = HistoryEvent::PID_SUSPENDED;
+        ev.aux = cpid.scrambling;
+        report(cpid.last_pkt, ev);
+        ev.type = HistoryEvent::PID_RESTARTED;
+        ev.aux = scrambling;
+        report(ev);
     }
     else if (!ignore_scrambling && cpid.scrambling == 0 && scrambling != 0) {
         // Clear to scrambled transition
-        report(u"PID %d (0x%<X), clear to scrambled transition, %s key, service 0x%X", {pid, NameFromDTV(u"ts.scrambling_control", scrambling), _cpids[pid].service_id});
+        ev.type = HistoryEvent::CLEAR_TO_SCRAMBLED;
+        ev.aux = scrambling;
+        report(ev);
     }
     else if (!ignore_scrambling && cpid.scrambling != 0 && scrambling == 0) {
         // Scrambled to clear transition
-        report(u"PID %d (0x%<X), scrambled to clear transition, service 0x%X", {pid, _cpids[pid].service_id});
+        ev.type = HistoryEvent::SCRAMBLED_TO_CLEAR;
+        report(ev);
     }
     else if (!ignore_scrambling && _report_cas && cpid.scrambling != scrambling) {
         // New crypto-period
-        report(u"PID %d (0x%<X), new crypto-period, %s key, service 0x%X", {pid, NameFromDTV(u"ts.scrambling_control", scrambling), _cpids[pid].service_id});
+        ev.type = HistoryEvent::CRYPTO_PERIOD;
+        ev.aux = scrambling;
+        report(ev);
     }
 
     if (has_pes_start) {
         if (!cpid.pes_strid.has_value()) {
             // Found first PES stream id in the PID.
-            report(u"PID %d (0x%<X), PES stream_id is %s", {pid, NameFromDTV(u"pes.stream_id", pes_stream_id, NamesFlags::FIRST)});
+            ev.type = HistoryEvent::PES_STREAM_ID;
+            ev.aux = pes_stream_id;
+            report(ev);
         }
         else if (cpid.pes_strid != pes_stream_id && !_ignore_stream_id) {
             // PES stream id has changed in the PID.
-            report(u"PID %d (0x%<X), PES stream_id modified from 0x%X to %s", {pid, cpid.pes_strid.value(), NameFromDTV(u"pes.stream_id", pes_stream_id, NamesFlags::FIRST)});
+            ev.type = HistoryEvent::PES_STREAM_ID_CHANGE;
+            ev.version = cpid.pes_strid.value();
+            ev.aux = pes_stream_id;
+            report(ev);
         }
         cpid.pes_strid = pes_stream_id;
     }
@@ -484,20 +548,36 @@ ts::ProcessorPlugin::Status ts::HistoryPlugin::processPacket(TSPacket& pkt, TSPa
 
 
 //----------------------------------------------------------------------------
-// Report a history line
+// Report the new version of a long table.
+//----------------------------------------------------------------------------
+
+void ts::HistoryPlugin::reportLongTable(const BinaryTable& table)
+{
+    HistoryEvent ev(HistoryEvent::TABLE_LONG);
+    ev.tid = table.tableId();
+    ev.version = table.version();
+    ev.ext = table.tableIdExtension();
+    report(ev);
+}
+
+
+//----------------------------------------------------------------------------
+// Report a history event
 //----------------------------------------------------------------------------
 
-void ts::HistoryPlugin::report(const UChar* fmt, const std::initializer_list<ArgMixIn> args)
+void ts::HistoryPlugin::report(const HistoryEvent& event)
 {
-    report(tsp->pluginPackets(), fmt, args);
+    report(tsp->pluginPackets(), event);
 }
 
-void ts::HistoryPlugin::report(PacketCounter pkt, const UChar* fmt, const std::initializer_list<ArgMixIn> args)
+void ts::HistoryPlugin::report(PacketCounter pkt, const HistoryEvent& event)
 {
     // Reports the last TDT if required
     if (!_time_all && _last_tdt.isValid() && !_last_tdt_reported) {
         _last_tdt_reported = true;
-        report(_last_tdt_pkt, u"TDT: %s UTC", {_last_tdt.utc_time.format(Time::DATETIME)});
+        HistoryEvent tdt_event(HistoryEvent::TDT_TIME);
+        tdt_event.time = _last_tdt.utc_time;
+        report(_last_tdt_pkt, tdt_event);
     }
 
     // Convert pkt number in playback time when necessary.
@@ -505,11 +585,19 @@ void ts::HistoryPlugin::report(PacketCounter pkt, const UChar* fmt, const std::i
         pkt = PacketInterval(tsp->bitrate(), pkt);
     }
 
-    // Then report the message.
-    if (_outfile.is_open()) {
-        _outfile << UString::Format(u"%d: ", {pkt}) << UString::Format(fmt, args) << std::endl;
+    // Then report the event.
+    if (_binary) {
+        // Compact binary record, no formatting on the packet path.
+        HistoryEvent record(event);
+        record.timestamp = pkt;
+        uint8_t buffer[HistoryEvent::RECORD_SIZE];
+        record.serialize(buffer);
+        _outfile.write(reinterpret_cast<const char*>(buffer), HistoryEvent::RECORD_SIZE);
+    }
+    else if (_outfile.is_open()) {
+        _outfile << UString::Format(u"%d: ", {pkt}) << event.toString(duck) << std::endl;
     }
     else {
-        tsp->info(u"%d: %s", {pkt, UString::Format(fmt, args)});
+        tsp->info(u"%d: %s", {pkt, event.toString(duck)});
     }
 }
@@ -309,6 +309,7 @@ bool ts::InjectPlugin::reloadFiles()
     uint64_t bits_per_1000s = 0;  // Total bits in 1000 seconds.
     SectionFile file(duck);
     file.setCRCValidation(_crc_op);
+    file.setCompiledSectionCache(_sections_opt.compiled_cache);
 
     for (auto& it : _infiles) {
         file.clear();
@@ -14,7 +14,7 @@
 #include "tsPluginRepository.h"
 #include "tsSectionDemux.h"
 #include "tsBinaryTable.h"
-#include "tsMonotonic.h"
+#include "tsCoarseClock.h"
 #include "tsPAT.h"
 #include "tsPMT.h"
 
@@ -37,6 +37,7 @@ namespace ts {
     public:
         // Implementation of plugin API
         virtual bool start() override;
+        virtual bool stop() override;
         virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
 
     private:
@@ -61,8 +62,9 @@ namespace ts {
         PIDSet        _pids1 {};            // PIDs to sacrifice at threshold 1.
         SectionDemux  _demux {duck, this};  // Demux to collect PAT and PMT's.
         PIDContextMap _pidContexts {};      // One context per PID in the TS.
-        Monotonic     _clock {};            // Monotonic clock for live streams.
-        size_t        _bitsSecond = 0;      // Number of bits in current second.
+        int64_t       _tokens = 0;          // Token bucket level in bits (wall-clock mode).
+        int64_t       _bucketSize = 0;      // Token bucket capacity in bits (wall-clock mode).
+        NanoSecond    _lastRefill = 0;      // Coarse clock value at last token refill.
 
         // Context per PID in the TS.
         class PIDContext
@@ -124,6 +126,14 @@ ts::LimitPlugin::LimitPlugin(TSP* tsp_) :
          u"Limit the overall bitrate of the transport stream to the specified value "
          u"in bits/second. This is a mandatory option, there is no default.");
 
+    option(u"burst-packets", 0, POSITIVE);
+    help(u"burst-packets",
+         u"With --wall-clock, specify the capacity of the token bucket in packets, "
+         u"i.e. the maximum size of a burst which is let through at full speed "
+         u"before packets start to count in excess. "
+         u"By default, the capacity is computed from the maximum bitrate and the "
+         u"precision of the system clock.");
+
     option(u"pid", 'p', PIDVAL, 0, UNLIMITED_COUNT);
     help(u"pid", u"pid1[-pid2]",
          u"Specify PID's the content of which can be dropped when the maximum bitrate "
@@ -151,7 +161,8 @@ ts::LimitPlugin::LimitPlugin(TSP* tsp_) :
 
     option(u"wall-clock", 'w');
     help(u"wall-clock",
-         u"Compute bitrates based on real wall-clock time. The option is meaningful "
+         u"Compute bitrates based on real wall-clock time, using a token bucket "
+         u"which is refilled at the maximum bitrate. The option is meaningful "
          u"with live streams only. By default, compute bitrates based on PCR's.");
 }
 
@@ -190,9 +201,24 @@ bool ts::LimitPlugin::start()
 
     tsp->debug(u"threshold 1: %'d, threshold 2: %'d, threshold 3: %'d, threshold 4: %'d, audio/video threshold: %'d", {_threshold1, _threshold2, _threshold3, _threshold4, _thresholdAV});
 
+    // Size the token bucket for wall-clock mode. The capacity must cover at least
+    // the number of bits which can arrive between two updates of the coarse clock,
+    // otherwise legitimate traffic at the maximum bitrate would count in excess.
+    size_t burstPackets = 0;
+    getIntValue(burstPackets, u"burst-packets", 0);
+    if (burstPackets > 0) {
+        _bucketSize = int64_t(burstPackets) * PKT_SIZE_BITS;
+    }
+    else {
+        const NanoSecond window = std::max<NanoSecond>(2 * CoarseClock::Precision(), 20 * NanoSecPerMilliSec);
+        _bucketSize = std::max<int64_t>(((_maxBitrate * window) / NanoSecPerSec).toInt(), 8 * PKT_SIZE_BITS);
+    }
+    tsp->debug(u"token bucket capacity: %'d bits", {_bucketSize});
+
     // Reset plugin state.
     _currentPacket = 0;
-    _bitsSecond = 0;
+    _tokens = _bucketSize;
+    _lastRefill = 0;
     _excessPoint = 0;
     _excessPackets = 0;
     _excessBits = 0;
@@ -205,6 +231,43 @@ bool ts::LimitPlugin::start()
 }
 
 
+//----------------------------------------------------------------------------
+// Stop method
+//----------------------------------------------------------------------------
+
+bool ts::LimitPlugin::stop()
+{
+    // Report dropped packets by class of PID.
+    PacketCounter nullDrop = 0;
+    PacketCounter videoDrop = 0;
+    PacketCounter audioDrop = 0;
+    PacketCounter psiDrop = 0;
+    PacketCounter otherDrop = 0;
+    for (const auto& it : _pidContexts) {
+        const PIDContext& pc(*it.second);
+        if (pc.pid == PID_NULL) {
+            nullDrop += pc.dropCount;
+        }
+        else if (pc.video) {
+            videoDrop += pc.dropCount;
+        }
+        else if (pc.audio) {
+            audioDrop += pc.dropCount;
+        }
+        else if (pc.psi) {
+            psiDrop += pc.dropCount;
+        }
+        else {
+            otherDrop += pc.dropCount;
+        }
+    }
+    if (nullDrop + videoDrop + audioDrop + psiDrop + otherDrop > 0) {
+        tsp->verbose(u"dropped packets: %'d null, %'d video, %'d audio, %'d PSI/SI, %'d other", {nullDrop, videoDrop, audioDrop, psiDrop, otherDrop});
+    }
+    return true;
+}
+
+
 //----------------------------------------------------------------------------
 // Get or create the context for a PID.
 //----------------------------------------------------------------------------
@@ -298,9 +361,9 @@ ts::ProcessorPlugin::Status ts::LimitPlugin::processPacket(TSPacket& pkt, TSPack
     Status status = TSP_OK;
     const PID pid = pkt.getPID();
 
-    // Get system clock at first packet.
-    if (_currentPacket == 0) {
-        _clock.getSystemTime();
+    // Get the coarse clock at first packet.
+    if (_currentPacket == 0 && _useWallClock) {
+        _lastRefill = CoarseClock::MonotonicNanoSeconds();
     }
 
     // Filter sections to process.
@@ -311,30 +374,27 @@ ts::ProcessorPlugin::Status ts::LimitPlugin::processPacket(TSPacket& pkt, TSPack
 
     // Process bitrates.
     if (_useWallClock) {
-        // Compute bitrates from wall clock.
-        // Reset the monotonic clock every second.
-        const NanoSecond duration = Monotonic(true) - _clock;
-        if (duration >= NanoSecPerSec) {
-            // More than one second elapsed, reset.
-            _bitsSecond = 0;
-            if (duration < 2 * NanoSecPerSec) {
-                // Slightly more than 1 second, keep a monotonic behaviour.
-                _clock += NanoSecPerSec;
+        // Token bucket: each packet spends its size in bits, the bucket is refilled
+        // at the maximum bitrate. In the normal case (bitrate below the maximum),
+        // this is one subtraction and one branch per packet, the clock is only read
+        // when the bucket runs empty.
+        _tokens -= PKT_SIZE_BITS;
+        if (_tokens < 0) {
+            // Refill from the coarse clock.
+            const NanoSecond now = CoarseClock::MonotonicNanoSeconds();
+            if (now > _lastRefill) {
+                _tokens += ((_maxBitrate * (now - _lastRefill)) / NanoSecPerSec).toInt();
+                _lastRefill = now;
+                if (_tokens > _bucketSize) {
+                    _tokens = _bucketSize;
+                }
             }
-            else {
-                // More than 1 second, probably a hole in broadcast, missed next
-                // monotonic second => resync with current time.
-                _clock += duration;
+            if (_tokens < 0) {
+                // Still empty after refill: this packet is in excess, at least partially.
+                addExcessBits(std::min<uint64_t>(uint64_t(-_tokens), PKT_SIZE_BITS));
+                _tokens = 0;
             }
         }
-
-        // Accumulate packets in current second.
-        _bitsSecond += PKT_SIZE_BITS;
-        if (_bitsSecond > _maxBitrate) {
-            // This packet is in excess, at least partially.
-            const size_t excess = size_t((_bitsSecond - _maxBitrate).toInt());
-            addExcessBits(excess < PKT_SIZE_BITS ? excess : PKT_SIZE_BITS);
-        }
     }
     else if (pkt.hasPCR()) {
         // Compute bitrates from PCR's.
@@ -407,6 +407,9 @@ bool ts::MergePlugin::stop()
     tsp->debug(u"stopping, last merge bitrate: %'d, merged: %'d, hold: %'d, empty: %'d",
                {_insert_control.currentSubBitRate(), _merged_count, _hold_count, _empty_count});
 
+    // Report queue utilization statistics in verbose final reports.
+    tsp->verbose(u"%s", {_queue.statisticsSummary()});
+
     // Send the stop condition to the internal packet queue.
     _queue.stop();
 
@@ -592,6 +595,10 @@ ts::ProcessorPlugin::Status ts::MergePlugin::processMergePacket(TSPacket& pkt, T
         }
     }
 
+    // The null packet was replaced by a packet from the merged stream (and its PCR
+    // was possibly restamped): refresh the PCR cache in the metadata accordingly.
+    pkt_data.setPCR(pkt.getPCR());
+
     // Apply labels on merged packets.
     pkt_data.setLabels(_set_labels);
     pkt_data.clearLabels(_reset_labels);
@@ -0,0 +1,352 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  Transport stream processor shared library:
+//  Expose stream metrics over an embedded HTTP scrape endpoint.
+//
+//----------------------------------------------------------------------------
+
+#include "tsPluginRepository.h"
+#include "tsCounterRegistry.h"
+#include "tsContinuityAnalyzer.h"
+#include "tsSwitchableReport.h"
+#include "tsTCPServer.h"
+#include "tsTCPConnection.h"
+#include "tsVersionString.h"
+#include "tsNullReport.h"
+#include "tsThread.h"
+
+#define DEFAULT_PREFIX            u"tsp"  // Default metrics name prefix.
+#define SERVER_BACKLOG            1       // One connection at a time.
+#define SERVER_THREAD_STACK_SIZE  (128 * 1024)
+
+
+//----------------------------------------------------------------------------
+// Plugin definition
+//----------------------------------------------------------------------------
+
+namespace ts {
+    class MetricsPlugin: public ProcessorPlugin
+    {
+        TS_PLUGIN_CONSTRUCTORS(MetricsPlugin);
+    public:
+        // Implementation of plugin API
+        virtual bool getOptions() override;
+        virtual bool start() override;
+        virtual bool stop() override;
+        virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
+
+    private:
+        // HTTP listener thread, serving scrape requests.
+        class Listener: public Thread
+        {
+            TS_NOBUILD_NOCOPY(Listener);
+        public:
+            // Constructor.
+            Listener(MetricsPlugin* plugin);
+
+            // Terminate the thread.
+            void stop();
+
+            // Invoked in the context of the server thread.
+            virtual void main() override;
+
+        private:
+            MetricsPlugin* const _plugin;
+            SwitchableReport     _report;
+            TCPConnection        _client {};
+
+            // Read one HTTP request, send the scrape report. Return false on client error.
+            bool handleRequest();
+
+            // Send one response header or body line.
+            bool sendLine(const std::string& line);
+        };
+
+        // Command line options:
+        UString           _prefix {};
+        IPv4SocketAddress _server_address {};
+        bool              _reuse_port = false;
+
+        // Working data:
+        TCPServer             _server {};
+        Listener              _listener {this};
+        ContinuityAnalyzer    _cc_analyzer {AllPIDs, tsp};
+        PacketCounter         _last_cc_errors = 0;
+        std::atomic<uint64_t> _bitrate {0};  // Last known input bitrate in bits/second, for the scrape thread.
+
+        // Counters in the process-wide registry. Updated in the plugin thread, read by the scrape thread.
+        CounterRegistry::Counter* _packets = nullptr;
+        CounterRegistry::Counter* _null_packets = nullptr;
+        CounterRegistry::Counter* _cc_errors = nullptr;
+
+        // Build the scrape report body. Invoked in the server thread.
+        std::string buildReport() const;
+    };
+}
+
+TS_REGISTER_PROCESSOR_PLUGIN(u"metrics", ts::MetricsPlugin);
+
+
+//----------------------------------------------------------------------------
+// Constructor
+//----------------------------------------------------------------------------
+
+ts::MetricsPlugin::MetricsPlugin(TSP* tsp_) :
+    ProcessorPlugin(tsp_, u"Expose stream metrics over an embedded HTTP endpoint", u"[options]")
+{
+    setIntro(u"The plugin counts packets, null packets and continuity errors at its "
+             u"location in the chain and exposes them over a rudimentary HTTP server, "
+             u"in the common text exposition format of monitoring systems. "
+             u"Use several instances of the plugin, with distinct prefixes, to observe "
+             u"the stream at several stages of the processing chain. "
+             u"A scrape request is served from a separate thread, without impact on the "
+             u"packet processing, and the counter updates are wait-free.\n\n"
+             u"Only one client is accepted at a time. No SSL/TLS is supported. "
+             u"The requests \"GET /\" and \"GET /metrics\" return all counters of the "
+             u"process-wide counter registry, all other requests are rejected.");
+
+    option(u"no-reuse-port");
+    help(u"no-reuse-port",
+         u"Disable the reuse port socket option. Do not use unless completely necessary.");
+
+    option(u"prefix", 'p', STRING);
+    help(u"prefix", u"name",
+         u"Prefix of the metric names which are registered by this plugin instance. "
+         u"Use distinct prefixes when several instances of the plugin run in the same chain. "
+         u"The default is \"" DEFAULT_PREFIX u"\".");
+
+    option(u"server", 's', IPSOCKADDR_OA, 1, 1);
+    help(u"server",
+         u"Specifies the local TCP port on which the plugin listens for incoming HTTP "
+         u"scrape requests. This option is mandatory. "
+         u"When present, the optional address shall specify a local IP address or host name. "
+         u"By default, the server listens on all local interfaces.");
+}
+
+
+//----------------------------------------------------------------------------
+// Get command line options.
+//----------------------------------------------------------------------------
+
+bool ts::MetricsPlugin::getOptions()
+{
+    _reuse_port = !present(u"no-reuse-port");
+    getValue(_prefix, u"prefix", DEFAULT_PREFIX);
+    getSocketValue(_server_address, u"server");
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Start method.
+//----------------------------------------------------------------------------
+
+bool ts::MetricsPlugin::start()
+{
+    // Register the counters. The returned references remain valid for the process lifetime.
+    _packets = &CounterRegistry::Instance().getCounter(_prefix + u"_packets_total");
+    _null_packets = &CounterRegistry::Instance().getCounter(_prefix + u"_null_packets_total");
+    _cc_errors = &CounterRegistry::Instance().getCounter(_prefix + u"_cc_errors_total");
+
+    // Reset the continuity analysis.
+    _cc_analyzer.reset();
+    _last_cc_errors = _cc_analyzer.errorCount();
+    _bitrate = 0;
+
+    // Create the TCP server and start the listener thread.
+    if (!_server.open(*tsp)) {
+        return false;
+    }
+    if (!_server.reusePort(_reuse_port, *tsp) ||
+        !_server.bind(_server_address, *tsp) ||
+        !_server.listen(SERVER_BACKLOG, *tsp) ||
+        !_listener.start())
+    {
+        _server.close(*tsp);
+        return false;
+    }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Stop method.
+//----------------------------------------------------------------------------
+
+bool ts::MetricsPlugin::stop()
+{
+    _listener.stop();
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Packet processing method.
+//----------------------------------------------------------------------------
+
+ts::ProcessorPlugin::Status ts::MetricsPlugin::processPacket(TSPacket& pkt, TSPacketMetadata& pkt_data)
+{
+    // One wait-free addition per counter, the dominant per-packet cost is the continuity check.
+    _packets->add();
+    if (pkt.getPID() == PID_NULL) {
+        _null_packets->add();
+    }
+    _cc_analyzer.feedPacket(pkt);
+    const PacketCounter errors = _cc_analyzer.errorCount();
+    if (errors != _last_cc_errors) {
+        _cc_errors->add(errors - _last_cc_errors);
+        _last_cc_errors = errors;
+    }
+
+    // Refresh the bitrate gauge for the scrape thread, not on each packet.
+    if (tsp->pluginPackets() % 128 == 0) {
+        _bitrate.store(tsp->bitrate().toInt(), std::memory_order_relaxed);
+    }
+    return TSP_OK;
+}
+
+
+//----------------------------------------------------------------------------
+// Build the scrape report body. Invoked in the server thread.
+//----------------------------------------------------------------------------
+
+std::string ts::MetricsPlugin::buildReport() const
+{
+    // Aggregate all counters of the registry, not only ours, so that any other
+    // instrumented component of the process is scraped as well.
+    std::map<UString, uint64_t> counters;
+    CounterRegistry::Instance().getAllCounters(counters);
+
+    UString text;
+    for (const auto& it : counters) {
+        text.format(u"# TYPE %s counter\n%s %d\n", {it.first, it.first, it.second});
+    }
+    text.format(u"# TYPE %s_bitrate_bits gauge\n%s_bitrate_bits %d\n", {_prefix, _prefix, _bitrate.load(std::memory_order_relaxed)});
+    return text.toUTF8();
+}
+
+
+//----------------------------------------------------------------------------
+// HTTP listener thread.
+//----------------------------------------------------------------------------
+
+ts::MetricsPlugin::Listener::Listener(MetricsPlugin* plugin) :
+    Thread(ThreadAttributes().setStackSize(SERVER_THREAD_STACK_SIZE)),
+    _plugin(plugin),
+    _report(*plugin->tsp)
+{
+}
+
+void ts::MetricsPlugin::Listener::stop()
+{
+    // Switch off error messages from the network client.
+    _report.setSwitch(false);
+
+    // Close the server, then break the client connection.
+    // This will force the server thread to terminate.
+    _plugin->_server.close(NULLREP);
+    _client.disconnect(NULLREP);
+    _client.close(NULLREP);
+
+    // Wait for actual thread termination.
+    Thread::waitForTermination();
+}
+
+void ts::MetricsPlugin::Listener::main()
+{
+    _plugin->tsp->debug(u"metrics server thread started");
+
+    // Loop on client acceptance (accept only one client at a time).
+    IPv4SocketAddress client_address;
+    while (_plugin->_server.accept(_client, client_address, _report)) {
+        _report.debug(u"incoming scrape connection from %s", {client_address});
+        handleRequest();
+        _client.disconnect(NULLREP);
+        _client.close(NULLREP);
+    }
+
+    _plugin->tsp->debug(u"metrics server thread completed");
+}
+
+
+//----------------------------------------------------------------------------
+// Send one response header or body line.
+//----------------------------------------------------------------------------
+
+bool ts::MetricsPlugin::Listener::sendLine(const std::string& line)
+{
+    std::string data(line);
+    data += "\r\n";
+    return _client.send(data.data(), data.size(), _report);
+}
+
+
+//----------------------------------------------------------------------------
+// Read one HTTP request, send the scrape report.
+//----------------------------------------------------------------------------
+
+bool ts::MetricsPlugin::Listener::handleRequest()
+{
+    UString request;
+    UString header(1, SPACE); // Need an initial non-empty value
+    ByteBlock data;
+    data.reserve(1024);
+
+    // Read request header lines, until an empty line is read.
+    do {
+        // Read a chunk of data.
+        const size_t previous = data.size();
+        size_t ret_size = 0;
+        data.resize(previous + 512);
+        if (!_client.receive(data.data() + previous, data.size() - previous, ret_size, nullptr, _report)) {
+            return false; // receive error
+        }
+        data.resize(previous + ret_size);
+
+        // Look for a header line.
+        size_t eol = 0;
+        while (!header.empty() && (eol = data.find('\n')) != NPOS) {
+            // Extract the header line from the buffer.
+            header.assignFromUTF8(reinterpret_cast<const char*>(data.data()), eol);
+            header.trim();
+            data.erase(0, eol + 1);
+
+            // The first header is the request.
+            if (request.empty()) {
+                request = header;
+            }
+        }
+    } while (!header.empty());
+
+    // Expected request: "GET / HTTP/1.1" or "GET /metrics HTTP/1.1".
+    UStringVector fields;
+    request.split(fields, ' ', true, true);
+    const bool valid = fields.size() >= 3 &&
+        fields[0] == u"GET" &&
+        (fields[1] == u"/" || fields[1] == u"/metrics") &&
+        fields[2].startWith(u"HTTP/");
+
+    if (!valid) {
+        _report.debug(u"invalid scrape request: %s", {request});
+        sendLine("HTTP/1.1 404 Not Found");
+        sendLine("Connection: close");
+        sendLine("");
+        return false;
+    }
+
+    // Build and send the report.
+    const std::string body(_plugin->buildReport());
+    sendLine("HTTP/1.1 200 OK");
+    sendLine("Server: TSDuck/" TS_VERSION_STRING);
+    sendLine("Content-Type: text/plain; version=0.0.4");
+    sendLine("Content-Length: " + std::to_string(body.size()));
+    sendLine("Connection: close");
+    sendLine("");
+    return _client.send(body.data(), body.size(), _report);
+}
@@ -56,6 +56,7 @@ namespace ts {
         size_t        _skip_size = 0;           // Initial bytes to skip for --dump and --output-file.
         uint32_t      _event_code = 0;          // Event code to signal.
         int           _ttl = 0;                 // Time to live option.
+        size_t        _udp_batch = 1;           // Number of datagrams to group per batched send operation.
         PIDSet        _pids {};                 // Explicitly specified PID's to extract.
         IPv4SocketAddress _ip_source {};        // IP source filter.
         IPv4SocketAddress _ip_dest {};          // IP destination filter.
@@ -72,10 +73,26 @@ namespace ts {
         std::ofstream _outfile {};              // Output file for extracted datagrams.
         MPEDemux      _demux {duck, this};      // MPE demux to extract MPE datagrams.
 
+        // Pending datagrams for one destination with --udp-batch.
+        // The datagram buffers are preallocated and reused from batch to batch.
+        struct UDPBatch
+        {
+            std::vector<ByteBlock> datagrams {};  // Datagram buffers, only the first 'count' ones are pending.
+            size_t                 count = 0;     // Number of pending datagrams in the batch.
+            int                    ttl = 0;       // TTL of the first datagram in the batch.
+        };
+        std::map<IPv4SocketAddress, UDPBatch> _udp_batches {};  // Pending batches, per destination.
+
         // Inherited methods.
         virtual void handleMPENewPID(MPEDemux&, const PMT&, PID) override;
         virtual void handleMPEPacket(MPEDemux&, const MPEPacket&) override;
 
+        // Set the TTL on the forwarding socket, using the TTL of an MPE datagram.
+        void setForwardTTL(const IPv4SocketAddress& dest, int mpe_ttl);
+
+        // Send all pending datagrams of a batch in one operation.
+        void flushUDPBatch(const IPv4SocketAddress& dest, UDPBatch& batch);
+
         // Build the string for --sync-layout.
         UString syncLayoutString(const uint8_t* udp, size_t udpSize);
     };
@@ -195,6 +212,14 @@ ts::MPEPlugin::MPEPlugin(TSP* tsp_) :
          u"depending on the destination address. By default, use the same TTL "
          u"as specified in the received MPE encapsulated datagram.");
 
+    option(u"udp-batch", 0, POSITIVE);
+    help(u"udp-batch", u"count",
+         u"With --udp-forward, group the forwarded datagrams by destination and send "
+         u"each group of the specified size in as few operations as possible (using "
+         u"sendmmsg() on Linux). This significantly reduces the system call overhead "
+         u"on streams with a high datagram rate. Note that a datagram can be delayed "
+         u"until its group is complete. By default, send each datagram immediately.");
+
     option(u"udp-forward", 'u');
     help(u"udp-forward",
          u"Forward all received MPE encapsulated UDP datagrams on the local network. "
@@ -237,6 +262,7 @@ bool ts::MPEPlugin::getOptions()
     getIntValue(_skip_size, u"skip");
     getIntValue(_event_code, u"event-code");
     getIntValue(_ttl, u"ttl");
+    getIntValue(_udp_batch, u"udp-batch", 1);
     getIntValues(_pids, u"pid");
     getSocketValue(_ip_source, u"source");
     getSocketValue(_ip_dest, u"destination");
@@ -323,6 +349,7 @@ bool ts::MPEPlugin::start()
     // Other states.
     _datagram_count = 0;
     _previous_uc_ttl = _previous_mc_ttl = 0;
+    _udp_batches.clear();
 
     return true;
 }
@@ -334,6 +361,12 @@ bool ts::MPEPlugin::start()
 
 bool ts::MPEPlugin::stop()
 {
+    // Flush pending batches of forwarded datagrams.
+    for (auto& it : _udp_batches) {
+        flushUDPBatch(it.first, it.second);
+    }
+    _udp_batches.clear();
+
     // Close output file.
     if (_outfile.is_open()) {
         _outfile.close();
@@ -462,22 +495,33 @@ void ts::MPEPlugin::handleMPEPacket(MPEDemux& demux, const MPEPacket& mpe)
             dest.setPort(_ip_forward.port());
         }
 
-        // Set the TTL from the datagram is not already set by user-specified value.
-        const bool mc = dest.isMulticast();
-        const int previous_ttl = mc ? _previous_mc_ttl : _previous_uc_ttl;
-        const int mpe_ttl = mpe.datagram()[8]; // in original IP header
-        if (_ttl <= 0 && mpe_ttl != previous_ttl && _sock.setTTL(mpe_ttl, mc, *tsp)) {
-            if (mc) {
-                _previous_mc_ttl = mpe_ttl;
-            }
-            else {
-                _previous_uc_ttl = mpe_ttl;
+        // TTL of the datagram, from the original IP header.
+        const int mpe_ttl = mpe.datagram()[8];
+
+        if (_udp_batch <= 1) {
+            // Set the TTL from the datagram if not already set by user-specified value.
+            setForwardTTL(dest, mpe_ttl);
+
+            // Send the UDP datagram.
+            if (!_sock.send(udp_data, udp_size, dest, *tsp)) {
+                _abort = true;
             }
         }
+        else {
+            // Accumulate the datagram in the batch of its destination.
+            UDPBatch& batch(_udp_batches[dest]);
+            if (batch.count == 0) {
+                batch.ttl = mpe_ttl;
+            }
+            if (batch.count >= batch.datagrams.size()) {
+                batch.datagrams.resize(batch.count + 1);
+            }
+            batch.datagrams[batch.count++].copy(udp_data, udp_size);
 
-        // Send the UDP datagram.
-        if (!_sock.send(udp_data, udp_size, dest, *tsp)) {
-            _abort = true;
+            // Flush the batch when it is full.
+            if (batch.count >= _udp_batch) {
+                flushUDPBatch(dest, batch);
+            }
         }
     }
 
@@ -495,6 +539,53 @@ void ts::MPEPlugin::handleMPEPacket(MPEDemux& demux, const MPEPacket& mpe)
 }
 
 
+//----------------------------------------------------------------------------
+// Set the TTL on the forwarding socket, using the TTL of an MPE datagram.
+//----------------------------------------------------------------------------
+
+void ts::MPEPlugin::setForwardTTL(const IPv4SocketAddress& dest, int mpe_ttl)
+{
+    // Do nothing when the TTL was set once for all by a user-specified value.
+    const bool mc = dest.isMulticast();
+    const int previous_ttl = mc ? _previous_mc_ttl : _previous_uc_ttl;
+    if (_ttl <= 0 && mpe_ttl != previous_ttl && _sock.setTTL(mpe_ttl, mc, *tsp)) {
+        if (mc) {
+            _previous_mc_ttl = mpe_ttl;
+        }
+        else {
+            _previous_uc_ttl = mpe_ttl;
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Send all pending datagrams of a batch in one operation.
+//----------------------------------------------------------------------------
+
+void ts::MPEPlugin::flushUDPBatch(const IPv4SocketAddress& dest, UDPBatch& batch)
+{
+    if (batch.count > 0) {
+
+        // Set the TTL from the first datagram of the batch.
+        setForwardTTL(dest, batch.ttl);
+
+        // Build the message descriptions and send the whole batch in one operation.
+        std::vector<UDPSocket::SentMessage> messages(batch.count);
+        for (size_t i = 0; i < batch.count; ++i) {
+            messages[i].data = batch.datagrams[i].data();
+            messages[i].size = batch.datagrams[i].size();
+        }
+        if (!_sock.sendBatch(messages.data(), messages.size(), dest, *tsp)) {
+            _abort = true;
+        }
+
+        // Keep the datagram buffers for reuse by the next batch.
+        batch.count = 0;
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Build the string for --sync-layout.
 //----------------------------------------------------------------------------
@@ -385,7 +385,7 @@ void ts::NITPlugin::handleTable(SectionDemux& demux, const BinaryTable& table)
             _last_nit.version = (_last_nit.version + 1) & SVERSION_MASK;
             // We need to force the modified NIT.
             BinaryTable bin;
-            _last_nit.serialize(duck, bin);
+            _last_nit.serialize(bin, serializationBuffer());
             forceTableUpdate(bin);
         }
     }
@@ -409,7 +409,7 @@ void ts::NITPlugin::createNewTable(BinaryTable& table)
         nit.network_id = _nit_other_id;
     }
 
-    nit.serialize(duck, table);
+    nit.serialize(table, serializationBuffer());
 
     // Keep track of last valid NIT.
     _last_nit = nit;
@@ -476,7 +476,7 @@ void ts::NITPlugin::modifyTable(BinaryTable& table, bool& is_target, bool& reins
 
     // Reserialize modified NIT.
     nit.clearPreferredSections();
-    nit.serialize(duck, table);
+    nit.serialize(table, serializationBuffer());
 
     // Keep track of last valid NIT.
     _last_nit = nit;
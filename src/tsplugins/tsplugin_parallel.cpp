@@ -0,0 +1,356 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  Transport stream processor shared library:
+//  Run several instances of another processor plugin in parallel threads,
+//  sharding the packets by PID.
+//
+//----------------------------------------------------------------------------
+
+#include "tsPluginRepository.h"
+#include "tsThread.h"
+#include "tsFatal.h"
+
+#define PACKETS_PER_PROCESSOR_THREAD 512  // Packet window share of one worker thread
+
+
+//----------------------------------------------------------------------------
+// Plugin definition
+//----------------------------------------------------------------------------
+
+namespace ts {
+    class ParallelPlugin: public ProcessorPlugin
+    {
+        TS_PLUGIN_CONSTRUCTORS(ParallelPlugin);
+    public:
+        // Implementation of plugin API
+        virtual bool getOptions() override;
+        virtual bool start() override;
+        virtual bool stop() override;
+        virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
+        virtual size_t getPacketWindowSize() override;
+        virtual size_t processPacketWindow(TSPacketWindow&) override;
+
+    private:
+        // Each worker thread owns one instance of the encapsulated plugin.
+        // The packets of a window are distributed to the workers by PID, so
+        // that all packets of one PID are always processed by the same
+        // instance, in stream order. The packets are modified in place in the
+        // window, which preserves the input order of the stream.
+        class ProcessorWorker: public Thread
+        {
+            TS_NOBUILD_NOCOPY(ProcessorWorker);
+        public:
+            // Constructor and destructor.
+            ProcessorWorker(ParallelPlugin* plugin);
+            virtual ~ProcessorWorker() override;
+
+            // Create the encapsulated plugin instance and analyze its command line.
+            bool createPlugin(const UString& name, const UStringVector& args);
+
+            // Access the encapsulated plugin instance.
+            ProcessorPlugin* processor() const { return _processor; }
+
+            // Add the index of a window packet in the shard of this worker.
+            // Only valid between two "slices" of work, when the thread is idle.
+            void addPacket(size_t index) { _indexes.push_back(index); }
+
+            // Submit the current shard of packets to process.
+            void startWork(TSPacketWindow* window, std::vector<Status>* status);
+
+            // Wait for the completion of the current shard.
+            void waitWork();
+
+            // Request the termination of the thread, to be followed by waitForTermination().
+            void stopThread();
+
+        private:
+            ParallelPlugin*      _plugin;                 // Reference to parent plugin.
+            ProcessorPlugin*     _processor = nullptr;    // Encapsulated plugin instance.
+            std::vector<size_t>  _indexes {};             // Window indexes of the packets of this shard.
+            std::mutex              _mutex {};            // Protect access to the fields below.
+            std::condition_variable _wake {};             // Signalled when work is submitted or termination requested.
+            std::condition_variable _completed {};        // Signalled when the current shard is completed.
+            TSPacketWindow*      _window = nullptr;       // Current packet window to work on.
+            std::vector<Status>* _status = nullptr;       // Where to store the status of each processed packet.
+            bool                 _terminate = false;      // Termination was requested.
+
+            // Thread main code.
+            virtual void main() override;
+        };
+        typedef SafePtr<ProcessorWorker, ts::null_mutex> ProcessorWorkerPtr;
+
+        // Command line options.
+        size_t _num_threads = 0;  // Number of instances of the encapsulated plugin.
+
+        // Working data.
+        std::vector<ProcessorWorkerPtr> _workers {};  // Worker threads, one instance of the plugin each.
+        std::vector<Status>             _status {};   // Per-packet status of the current window.
+    };
+}
+
+TS_REGISTER_PROCESSOR_PLUGIN(u"parallel", ts::ParallelPlugin);
+
+
+//----------------------------------------------------------------------------
+// Constructor
+//----------------------------------------------------------------------------
+
+ts::ParallelPlugin::ParallelPlugin(TSP* tsp_) :
+    ProcessorPlugin(tsp_, u"Run several instances of a processor plugin in parallel", u"[options] 'plugin [plugin-options]'")
+{
+    option(u"", 0, STRING, 1, 1);
+    help(u"",
+         u"Specifies the command line of the processor plugin to run, the plugin name "
+         u"followed by its options. Since the command contains spaces, it must be "
+         u"surrounded by quotes on the shell command line, so that it forms one single "
+         u"parameter of this plugin.\n\n"
+         u"Several instances of the plugin are created, each with the same options. "
+         u"The packets are distributed between the instances according to their PID, "
+         u"all packets of one PID being processed by the same instance, in their "
+         u"order in the stream. The order of the packets in the transport stream is "
+         u"always preserved.\n\n"
+         u"Because each instance only receives a subset of the PID's, this is suitable "
+         u"for CPU-bound plugins which work independently on each PID. Plugins which "
+         u"correlate several PID's (eg. a service and its components) may behave "
+         u"incorrectly when their PID's land in distinct instances.");
+
+    option(u"threads", 't', POSITIVE);
+    help(u"threads",
+         u"Specify the number of instances of the plugin to run in parallel, "
+         u"each in its own thread. The default is 2.");
+}
+
+
+//----------------------------------------------------------------------------
+// Get options method
+//----------------------------------------------------------------------------
+
+bool ts::ParallelPlugin::getOptions()
+{
+    getIntValue(_num_threads, u"threads", 2);
+
+    // Split the plugin command into a plugin name and its arguments.
+    UString command;
+    getValue(command, u"");
+    UStringVector args;
+    command.splitShellStyle(args);
+    if (args.empty()) {
+        tsp->error(u"no plugin command specified");
+        return false;
+    }
+    const UString name(args.front());
+    args.erase(args.begin());
+
+    // Create one instance of the plugin per thread.
+    _workers.clear();
+    for (size_t i = 0; i < _num_threads; ++i) {
+        const ProcessorWorkerPtr worker(new ProcessorWorker(this));
+        CheckNonNull(worker.pointer());
+        if (!worker->createPlugin(name, args)) {
+            _workers.clear();
+            return false;
+        }
+        _workers.push_back(worker);
+    }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Start method
+//----------------------------------------------------------------------------
+
+bool ts::ParallelPlugin::start()
+{
+    _status.clear();
+    for (const auto& worker : _workers) {
+        if (!worker->processor()->start() || !worker->start()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Stop method
+//----------------------------------------------------------------------------
+
+bool ts::ParallelPlugin::stop()
+{
+    bool success = true;
+    for (const auto& worker : _workers) {
+        worker->stopThread();
+    }
+    for (const auto& worker : _workers) {
+        worker->waitForTermination();
+        success = worker->processor()->stop() && success;
+    }
+    return success;
+}
+
+
+//----------------------------------------------------------------------------
+// Packet processing method (without packet window)
+//----------------------------------------------------------------------------
+
+ts::ProcessorPlugin::Status ts::ParallelPlugin::processPacket(TSPacket& pkt, TSPacketMetadata& pkt_data)
+{
+    // When tsp does not use the packet window interface, process the packet
+    // inline, in the instance which owns the shard of this PID.
+    return _workers[pkt.getPID() % _workers.size()]->processor()->processPacket(pkt, pkt_data);
+}
+
+
+//----------------------------------------------------------------------------
+// Packet window processing methods.
+//----------------------------------------------------------------------------
+
+size_t ts::ParallelPlugin::getPacketWindowSize()
+{
+    return _num_threads * PACKETS_PER_PROCESSOR_THREAD;
+}
+
+size_t ts::ParallelPlugin::processPacketWindow(TSPacketWindow& win)
+{
+    // Distribute the packets of the window between the workers, by PID.
+    _status.assign(win.size(), TSP_OK);
+    for (size_t i = 0; i < win.size(); ++i) {
+        const TSPacket* const pkt = win.packet(i);
+        if (pkt != nullptr) {
+            _workers[pkt->getPID() % _workers.size()]->addPacket(i);
+        }
+    }
+
+    // Process all shards in parallel and wait for their completion.
+    for (const auto& worker : _workers) {
+        worker->startWork(&win, &_status);
+    }
+    for (const auto& worker : _workers) {
+        worker->waitWork();
+    }
+
+    // Apply the returned statuses in input order. The window methods are not
+    // thread-safe, the workers only record the status of each packet.
+    for (size_t i = 0; i < win.size(); ++i) {
+        switch (_status[i]) {
+            case TSP_NULL:
+                win.nullify(i);
+                break;
+            case TSP_DROP:
+                win.drop(i);
+                break;
+            case TSP_END:
+                // Terminate the stream, the rest of the window is discarded.
+                return i;
+            default:
+                break;
+        }
+    }
+    return win.size();
+}
+
+
+//----------------------------------------------------------------------------
+// Worker threads.
+//----------------------------------------------------------------------------
+
+ts::ParallelPlugin::ProcessorWorker::ProcessorWorker(ParallelPlugin* plugin) :
+    Thread(),
+    _plugin(plugin)
+{
+}
+
+ts::ParallelPlugin::ProcessorWorker::~ProcessorWorker()
+{
+    if (_processor != nullptr) {
+        delete _processor;
+        _processor = nullptr;
+    }
+}
+
+bool ts::ParallelPlugin::ProcessorWorker::createPlugin(const UString& name, const UStringVector& args)
+{
+    // Locate the plugin in the repository (error already reported when not found).
+    PluginRepository::ProcessorPluginFactory allocator = PluginRepository::Instance().getProcessor(name, *_plugin->tsp);
+    if (allocator == nullptr) {
+        return false;
+    }
+
+    // Create the plugin instance. All instances share the TSP interface of
+    // the encapsulating plugin (thread-safe logging, bitrate, abort).
+    _processor = allocator(_plugin->tsp);
+    CheckNonNull(_processor);
+    _processor->setMaxSeverity(_plugin->tsp->maxSeverity());
+
+    // Submit the plugin arguments for analysis.
+    // Do not process argument redirection, already done at tsp command level.
+    _processor->analyze(name, args, false);
+
+    // The process should have terminated on argument error.
+    assert(_processor->valid());
+
+    return _processor->getOptions();
+}
+
+void ts::ParallelPlugin::ProcessorWorker::startWork(TSPacketWindow* window, std::vector<Status>* status)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _window = window;
+    _status = status;
+    _wake.notify_one();
+}
+
+void ts::ParallelPlugin::ProcessorWorker::waitWork()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (_window != nullptr) {
+        _completed.wait(lock);
+    }
+}
+
+void ts::ParallelPlugin::ProcessorWorker::stopThread()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _terminate = true;
+    _wake.notify_one();
+}
+
+void ts::ParallelPlugin::ProcessorWorker::main()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    for (;;) {
+        // Wait for a shard of packets or a termination request.
+        while (_window == nullptr && !_terminate) {
+            _wake.wait(lock);
+        }
+        if (_window == nullptr) {
+            break;
+        }
+        TSPacketWindow* const window = _window;
+        std::vector<Status>* const status = _status;
+        lock.unlock();
+
+        // Process all packets of the shard with the plugin instance.
+        for (const size_t index : _indexes) {
+            TSPacket* const pkt = window->packet(index);
+            TSPacketMetadata* const mdata = window->metadata(index);
+            if (pkt != nullptr && mdata != nullptr) {
+                (*status)[index] = _processor->processPacket(*pkt, *mdata);
+            }
+        }
+
+        // Signal the completion of the shard.
+        lock.lock();
+        _indexes.clear();
+        _window = nullptr;
+        _status = nullptr;
+        _completed.notify_one();
+    }
+}
@@ -124,7 +124,7 @@ bool ts::PATPlugin::start()
 void ts::PATPlugin::createNewTable(BinaryTable& table)
 {
     PAT pat;
-    pat.serialize(duck, table);
+    pat.serialize(table, serializationBuffer());
 }
 
 
@@ -169,5 +169,5 @@ void ts::PATPlugin::modifyTable(BinaryTable& table, bool& is_target, bool& reins
     }
 
     // Reserialize modified PAT.
-    pat.serialize(duck, table);
+    pat.serialize(table, serializationBuffer());
 }
@@ -26,13 +26,20 @@ namespace ts {
     public:
         // Implementation of plugin API
         virtual bool start() override;
+        virtual bool stop() override;
         virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
 
     private:
         uint8_t   _offset_pusi = 0;      // Start offset in packets with PUSI
         uint8_t   _offset_non_pusi = 0;  // Start offset in packets without PUSI
+        bool      _verify = false;       // Check payloads instead of overwriting them
         ByteBlock _pattern {};           // Binary pattern to apply
         PIDSet    _pid_list {};          // Array of pid values to filter
+
+        // Working data:
+        ByteBlock     _expanded {};          // Pattern pre-expanded to full packet size
+        PacketCounter _checked_count = 0;    // Number of checked packets with --verify
+        PacketCounter _mismatch_count = 0;   // Number of mismatching packets with --verify
     };
 }
 
@@ -74,6 +81,14 @@ ts::PatternPlugin::PatternPlugin(TSP* tsp_) :
          u"Select packets with these PID values. Several -p or --pid options "
          u"may be specified to select multiple PID's. If no such option is "
          u"specified, packets from all PID's are modified.");
+
+    option(u"verify", 'v');
+    help(u"verify",
+         u"Do not modify the packets. Instead, verify that the payload of the "
+         u"selected packets contains the expected pattern. Each mismatching "
+         u"packet is reported with the offset of the first divergent byte. This "
+         u"is typically used to check a stream which was generated with the same "
+         u"plugin and pattern on the other side of a transmission link.");
 }
 
 
@@ -87,11 +102,35 @@ bool ts::PatternPlugin::start()
     getIntValue(_offset_pusi, u"offset-pusi", 0);
     getIntValue(_offset_non_pusi, u"offset-non-pusi", 0);
     getIntValues(_pid_list, u"pid", true);
+    _verify = present(u"verify");
 
     if (present(u"negate")) {
         _pid_list.flip();
     }
 
+    // Pre-expand the pattern to a full packet size. Since the pattern always
+    // restarts at the beginning of the replaced area, each packet then needs
+    // one single bulk copy or compare, instead of one per pattern repetition.
+    _expanded.clear();
+    while (_expanded.size() < PKT_SIZE) {
+        _expanded.append(_pattern);
+    }
+
+    _checked_count = 0;
+    _mismatch_count = 0;
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Stop method
+//----------------------------------------------------------------------------
+
+bool ts::PatternPlugin::stop()
+{
+    if (_verify) {
+        tsp->verbose(u"%'d packets checked, %'d mismatched", {_checked_count, _mismatch_count});
+    }
     return true;
 }
 
@@ -111,14 +150,28 @@ ts::ProcessorPlugin::Status ts::PatternPlugin::processPacket(TSPacket& pkt, TSPa
     uint8_t* pl = pkt.b + pkt.getHeaderSize() + (pkt.getPUSI() ? _offset_pusi : _offset_non_pusi);
 
     // Compute remaining size to replace (maybe negative if starting offset is beyond the end of the packet).
-    int remain = int(pkt.b + PKT_SIZE - pl);
-
-    // Replace the payload with the pattern
-    while (remain > 0) {
-        int cursize = std::min(remain, int(_pattern.size()));
-        std::memcpy(pl, _pattern.data(), cursize);  // Flawfinder: ignore: memcpy()
-        pl += cursize;
-        remain -= cursize;
+    const int remain = int(pkt.b + PKT_SIZE - pl);
+
+    if (remain <= 0) {
+        return TSP_OK;
+    }
+    else if (!_verify) {
+        // Replace the payload with the pre-expanded pattern in one bulk copy.
+        std::memcpy(pl, _expanded.data(), remain);  // Flawfinder: ignore: memcpy()
+    }
+    else {
+        // Verify the payload against the pre-expanded pattern in one bulk compare.
+        _checked_count++;
+        if (std::memcmp(pl, _expanded.data(), remain) != 0) {
+            _mismatch_count++;
+            // Locate the first divergent byte for the error message.
+            size_t diff = 0;
+            while (pl[diff] == _expanded[diff]) {
+                diff++;
+            }
+            tsp->warning(u"packet %'d: PID 0x%X (%<d), pattern mismatch at offset %d in replaced area, 0x%X instead of 0x%X",
+                         {tsp->pluginPackets(), pkt.getPID(), diff, pl[diff], _expanded[diff]});
+        }
     }
 
     return TSP_OK;
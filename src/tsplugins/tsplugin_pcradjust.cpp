@@ -361,11 +361,12 @@ ts::ProcessorPlugin::Status ts::PCRAdjustPlugin::processPacket(TSPacket& pkt, TS
     // Only process packets from selected PID's (all by default).
     if (bitrate != 0 && _pids.test(pid) && (!ctx->scrambled || !_ignore_scrambled)) {
 
-        // Process PCR.
-        if (pkt.hasPCR()) {
+        // Process PCR. Use the cached value from the metadata when available.
+        const uint64_t pcr_value = pkt_data.pcrCached() ? pkt_data.getPCR() : pkt.getPCR();
+        if (pcr_value != INVALID_PCR) {
             // The PID is its own PCR reference.
             ctx->pcr_ctx = ctx;
-            ctx->last_original_pcr = pkt.getPCR();
+            ctx->last_original_pcr = pcr_value;
 
             if (ctx->last_updated_pcr == INVALID_PCR) {
                 // First packet in this PID with a PCR, use it as base.
@@ -376,6 +377,7 @@ ts::ProcessorPlugin::Status ts::PCRAdjustPlugin::processPacket(TSPacket& pkt, TS
                 // A previous PCR value was known in the PID. Compute the new PCR from the previous one.
                 const uint64_t pcr = ctx->updatedPCR(current_packet, bitrate);
                 pkt.setPCR(pcr);
+                pkt_data.setPCR(pcr);
                 ctx->last_updated_pcr = pcr;
             }
             ctx->last_pcr_packet = current_packet;
@@ -427,6 +429,7 @@ ts::ProcessorPlugin::Status ts::PCRAdjustPlugin::processPacket(TSPacket& pkt, TS
             pkt.setPID(pcr_ctx->pid);
             pkt.setCC(pcr_ctx->last_cc); // Don't increment CC since there is no payload
             pkt.setPCR(pcr_value, true);
+            pkt_data.setPCR(pcr_value);
 
             // Remember we inserted the packet.
             pcr_ctx->last_created_pcr = pcr_value;
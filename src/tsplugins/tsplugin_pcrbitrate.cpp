@@ -130,7 +130,7 @@ ts::ProcessorPlugin::Status ts::PCRBitratePlugin::processPacket(TSPacket& pkt, T
 {
     // Feed the packet into the PCR analyzer.
 
-    if (_pcr_analyzer.feedPacket(pkt)) {
+    if (_pcr_analyzer.feedPacket(pkt, pkt_data)) {
         // A new bitrate is available, get it and restart analysis
         BitRate new_bitrate = _pcr_analyzer.bitrate188();
         _pcr_analyzer.reset();
@@ -53,7 +53,7 @@ namespace ts {
 
         // Process a packet from the target PID, insert PCR when needed, shift payload.
         // Can also be used on the null PID to insert shifted payload.
-        void processTargetPacket(TSPacket& pkt);
+        void processTargetPacket(TSPacket& pkt, TSPacketMetadata& pkt_data);
     };
 }
 
@@ -191,11 +191,11 @@ ts::ProcessorPlugin::Status ts::PCRCopyPlugin::processPacket(TSPacket& pkt, TSPa
     }
     else if (pid == _target_pid && pid != PID_NULL && pid != _ref_pid) {
         // Process a packet from the target PID.
-        processTargetPacket(pkt);
+        processTargetPacket(pkt, pkt_data);
     }
     else if (pid == PID_NULL && (_shift_buffer.size() >= PKT_MAX_PAYLOAD_SIZE || _shift_pusi != NPOS)) {
         // Steal null packet to copy a full shifted payload or end of shifted PES packet.
-        processTargetPacket(pkt);
+        processTargetPacket(pkt, pkt_data);
     }
 
     return TSP_OK;
@@ -206,7 +206,7 @@ ts::ProcessorPlugin::Status ts::PCRCopyPlugin::processPacket(TSPacket& pkt, TSPa
 // Process a packet from the target PID, insert PCR when needed, shift payload.
 //----------------------------------------------------------------------------
 
-void ts::PCRCopyPlugin::processTargetPacket(TSPacket& pkt)
+void ts::PCRCopyPlugin::processTargetPacket(TSPacket& pkt, TSPacketMetadata& pkt_data)
 {
     // At the start of a PES packet, check the overflow status of the shift buffer.
     if (pkt.getPUSI()) {
@@ -298,6 +298,7 @@ void ts::PCRCopyPlugin::processTargetPacket(TSPacket& pkt)
         // Replace the PCR value. We know that we can safely overwrite the payload if the
         // adaptation field must be extended since we saved the payload in the shift buffer.
         pkt.setPCR(pcr, true);
+        pkt_data.setPCR(pcr);
     }
 
     // Fill the packet payload. There is no need to do that if the payload is not unused
@@ -331,8 +331,8 @@ ts::ProcessorPlugin::Status ts::PCRExtractPlugin::processPacket(TSPacket& pkt, T
     // Get context for this PID.
     PIDContext& pc(*getPIDContext(pid));
 
-    // Get PCR from packet, if there is one.
-    uint64_t pcr = pkt.getPCR();
+    // Get PCR from packet, if there is one. Use the cached value from the metadata when available.
+    uint64_t pcr = pkt_data.pcrCached() ? pkt_data.getPCR() : pkt.getPCR();
     const bool has_pcr = pcr != INVALID_PCR;
 
     // Note that we must keep track in PCR in all PID's, not only PID's to display,
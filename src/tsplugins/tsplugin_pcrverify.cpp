@@ -183,15 +183,18 @@ ts::ProcessorPlugin::Status ts::PCRVerifyPlugin::processPacket(TSPacket& pkt, TS
 {
     const PID pid = pkt.getPID();
 
+    // Get PCR from packet, if there is one. Use the cached value from the metadata when available.
+    const uint64_t pcr_value = pkt_data.pcrCached() ? pkt_data.getPCR() : pkt.getPCR();
+
     // Check if this PID shall be filtered and packet has a PCR
-    if (_pid_list[pid] && pkt.hasPCR()) {
+    if (_pid_list[pid] && pcr_value != INVALID_PCR) {
 
         // PID context at previous PCR packet.
         PIDContext& pc(_stats[pid]);
 
         // PID context at current packet.
         PIDContext next_pc;
-        next_pc.pcr_value = pkt.getPCR();
+        next_pc.pcr_value = pcr_value;
         next_pc.pcr_packet = tsp->pluginPackets();
         next_pc.pcr_timestamp = pkt_data.getInputTimeStamp(); // in PCR units, INVALID_PCR if there is no timestamp
         next_pc.pcr_timesource = pkt_data.getInputTimeSource();
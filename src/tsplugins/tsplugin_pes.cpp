@@ -13,6 +13,9 @@
 
 #include "tsPluginRepository.h"
 #include "tsFileNameGenerator.h"
+#include "tsMessageQueue.h"
+#include "tsThread.h"
+#include "tsFatal.h"
 #include "tsPESDemux.h"
 #include "tsAVCAccessUnitDelimiter.h"
 #include "tsAVCSequenceParameterSet.h"
@@ -56,6 +59,7 @@ namespace ts {
         bool      _negate_nal_unit_filter = false;
         bool      _multiple_files = false;
         bool      _flush_last = false;
+        size_t    _save_threads = 0;   // Number of writer threads (0: save inline)
         uint32_t  _hexa_flags = 0;
         size_t    _hexa_bpl = 0;
         size_t    _max_dump_size = 0;
@@ -83,6 +87,55 @@ namespace ts {
         FileNameGenerator _pes_name_gen {};
         FileNameGenerator _es_name_gen {};
 
+        // With --parallel-save, the binary save operations (--save-pes, --save-es)
+        // are executed by a pool of writer threads. Each PID is always dispatched
+        // to the same writer so that the saved data of one PID remain in stream
+        // order. The PES packet data are shared with the writer, not copied.
+        class Writer: public Thread
+        {
+            TS_NOBUILD_NOCOPY(Writer);
+        public:
+            // One save operation or a termination request.
+            class Job
+            {
+            public:
+                bool         terminate = false;  // termination request, after all previous jobs
+                PESPacketPtr pes {};             // the PES packet to save
+                UString      pes_filename {};    // per-packet file name (--multiple-files), empty for common stream
+                UString      es_filename {};     // per-packet file name (--multiple-files), empty for common stream
+                bool         save_pes = false;   // save the complete PES packet
+                bool         save_es = false;    // save the PES payload
+            };
+
+            // Build a writer for this plugin.
+            Writer(PESPlugin& plugin) : _plugin(plugin) { _queue.setMaxMessages(SAVE_QUEUE_SIZE); }
+
+            // Queue one job without waiting. On overload, the job is dropped and counted.
+            void put(Job* job) { _queue.tryEnqueue(job); }
+
+            // Queue a termination request, after all previous jobs.
+            void putTermination();
+
+            // Number of jobs which were dropped on overload.
+            uint64_t droppedCount() const { return _queue.droppedCount(); }
+
+        private:
+            PESPlugin& _plugin;
+            MessageQueue<Job, std::mutex> _queue {};
+
+            // Invoked in the context of the writer thread.
+            virtual void main() override;
+
+            // Perform one write, either in a per-packet file or a common stream.
+            void write(const UString& filename, std::ostream* stream, const UString& stream_name, const uint8_t* data, size_t size);
+        };
+
+        // Queue size of each writer thread.
+        static constexpr size_t SAVE_QUEUE_SIZE = 64;
+
+        std::vector<SafePtr<Writer>> _writers {};      // empty without --parallel-save
+        std::mutex                   _stream_mutex {}; // serialize the writers on a common output stream
+
         // Open output file.
         bool openOutput(const UString&, std::ofstream*, std::ostream**, bool binary);
 
@@ -221,6 +274,18 @@ ts::PESPlugin::PESPlugin(TSP* tsp_) :
     help(u"packet-index",
          u"Display the index of the first and last TS packet of each displayed PES packet.");
 
+    option(u"parallel-save", 0, INTEGER, 0, 1, 1, 64, true);
+    help(u"parallel-save", u"threads",
+         u"With --save-pes or --save-es, write the saved data using a pool of "
+         u"writer threads instead of writing them inline. Each PID is always "
+         u"dispatched to the same thread, so the saved data of each PID remain "
+         u"in stream order. When the writers cannot keep up, the saving of new "
+         u"PES packets is dropped rather than slowing down the transport stream; "
+         u"the number of dropped packets is reported at the end. The optional "
+         u"value is the number of threads to use; the default is the number of "
+         u"processor cores. This is mostly efficient with --multiple-files where "
+         u"each PES packet is written in a distinct file.");
+
     option(u"payload", 0);
     help(u"payload", u"Dump PES packet payload.");
 
@@ -298,6 +363,11 @@ bool ts::PESPlugin::getOptions()
     getValue(_out_filename, u"output-file");
     getValue(_pes_filename, u"save-pes");
     getValue(_es_filename, u"save-es");
+    _save_threads = present(u"parallel-save") ? intValue<size_t>(u"parallel-save", std::max<size_t>(1, std::thread::hardware_concurrency())) : 0;
+    if (_save_threads > 0 && _pes_filename.empty() && _es_filename.empty()) {
+        error(u"--parallel-save requires --save-pes or --save-es");
+        return false;
+    }
     _negate_nal_unit_filter = present(u"negate-nal-unit-type");
     getIntValues(_nal_unit_filter, u"nal-unit-type");
     getIntValues(_sei_type_filter, u"sei-type");
@@ -367,6 +437,16 @@ bool ts::PESPlugin::start()
         ok = ok && openOutput(_pes_filename, &_pes_file, &_pes_stream, true) && openOutput(_es_filename, &_es_file, &_es_stream, true);
     }
 
+    // Start the writer threads.
+    if (ok && _save_threads > 0) {
+        for (size_t i = 0; i < _save_threads; ++i) {
+            const SafePtr<Writer> writer(new Writer(*this));
+            CheckNonNull(writer.pointer());
+            _writers.push_back(writer);
+            ok = ok && writer->start();
+        }
+    }
+
     if (!ok) {
         // Close files which were open before failure
         stop();
@@ -428,6 +508,62 @@ void ts::PESPlugin::saveOnePES(FileNameGenerator& namegen, const uint8_t* data,
 }
 
 
+//----------------------------------------------------------------------------
+// Writer thread (--parallel-save).
+//----------------------------------------------------------------------------
+
+void ts::PESPlugin::Writer::putTermination()
+{
+    Job* job = new Job;
+    CheckNonNull(job);
+    job->terminate = true;
+    _queue.forceEnqueue(job);
+}
+
+void ts::PESPlugin::Writer::main()
+{
+    for (;;) {
+        MessageQueue<Job, std::mutex>::MessagePtr job;
+        _queue.dequeue(job);
+        if (job.isNull() || job->terminate) {
+            break;
+        }
+        const PESPacket& pkt(*job->pes);
+        if (job->save_pes) {
+            write(job->pes_filename, _plugin._pes_stream, _plugin._pes_filename, pkt.content(), pkt.size());
+        }
+        if (job->save_es) {
+            write(job->es_filename, _plugin._es_stream, _plugin._es_filename, pkt.payload(), pkt.payloadSize());
+        }
+    }
+}
+
+void ts::PESPlugin::Writer::write(const UString& filename, std::ostream* stream, const UString& stream_name, const uint8_t* data, size_t size)
+{
+    if (!filename.empty()) {
+        // One file per PES packet (--multiple-files).
+        _plugin.tsp->debug(u"creating %s", {filename});
+        std::ofstream file(filename.toUTF8().c_str(), std::ios::out | std::ios::binary);
+        if (!file) {
+            _plugin.tsp->error(u"cannot create %s", {filename});
+            _plugin._abort = true;
+        }
+        else {
+            file.write(reinterpret_cast<const char*>(data), std::streamsize(size));
+        }
+    }
+    else if (stream != nullptr) {
+        // Common output stream, shared by all writer threads.
+        std::lock_guard<std::mutex> lock(_plugin._stream_mutex);
+        stream->write(reinterpret_cast<const char*>(data), std::streamsize(size));
+        if (!(*stream)) {
+            _plugin.tsp->error(u"error writing PES data to %s", {stream_name == u"-" ? u"standard output" : stream_name});
+            _plugin._abort = true;
+        }
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Stop method
 //----------------------------------------------------------------------------
@@ -437,6 +573,24 @@ bool ts::PESPlugin::stop()
     if (_flush_last && !_abort) {
         _demux.flushUnboundedPES();
     }
+
+    // Terminate the writer threads after the last PES packets were queued
+    // and before closing the output files they may still write into.
+    if (!_writers.empty()) {
+        uint64_t dropped = 0;
+        for (const auto& writer : _writers) {
+            writer->putTermination();
+        }
+        for (const auto& writer : _writers) {
+            writer->waitForTermination();
+            dropped += writer->droppedCount();
+        }
+        _writers.clear();
+        if (dropped > 0) {
+            tsp->warning(u"%'d PES packets not saved, the writer threads could not keep up", {dropped});
+        }
+    }
+
     if (_out_file.is_open()) {
         _out_file.close();
     }
@@ -591,7 +745,27 @@ void ts::PESPlugin::handlePESPacket(PESDemux&, const PESPacket& pkt)
     }
 
     // Save binary PES packet and payload.
-    if (_multiple_files) {
+    if (!_writers.empty()) {
+        // Hand the packet off to a writer thread, sharing the packet data.
+        // The file names are generated here, in the plugin thread, so that
+        // the file sequence follows the stream order.
+        Writer::Job* job = new Writer::Job;
+        CheckNonNull(job);
+        job->pes = new PESPacket(pkt, ShareMode::SHARE);
+        CheckNonNull(job->pes.pointer());
+        job->save_pes = !_pes_filename.empty();
+        job->save_es = !_es_filename.empty();
+        if (_multiple_files) {
+            if (job->save_pes) {
+                job->pes_filename = _pes_name_gen.newFileName();
+            }
+            if (job->save_es) {
+                job->es_filename = _es_name_gen.newFileName();
+            }
+        }
+        _writers[pkt.sourcePID() % _writers.size()]->put(job);
+    }
+    else if (_multiple_files) {
         if (!_pes_filename.empty()) {
             saveOnePES(_pes_name_gen, pkt.content(), pkt.size());
         }
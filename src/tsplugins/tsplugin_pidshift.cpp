@@ -90,6 +90,13 @@ ts::PIDShiftPlugin::PIDShiftPlugin (TSP* tsp_) :
          u"This is a transport stream playout duration, not a wall-clock duration. "
          u"The default is " + UString::Decimal(DEF_EVAL_MS) + u" milliseconds.");
 
+    option(u"elide-null-packets");
+    help(u"elide-null-packets",
+         u"Do not store null packets in the shift buffer file, regenerate them on output. "
+         u"With --backward, null packets are usually part of the shifted stream and may "
+         u"occupy a large share of the buffer. The payload of null packets is not preserved. "
+         u"This is ignored when the buffer is entirely memory resident.");
+
     option(u"ignore-errors");
     help(u"ignore-errors",
          u"Ignore shift buffer size evaluation errors or shift buffer write errors, pass packets without shifting.");
@@ -125,6 +132,7 @@ bool ts::PIDShiftPlugin::getOptions()
 
     _buffer.setBackupDirectory(value(u"directory"));
     _buffer.setMemoryPackets(intValue<size_t>(u"memory-packets", TimeShiftBuffer::DEFAULT_MEMORY_PACKETS));
+    _buffer.setNullPacketElision(present(u"elide-null-packets"));
 
     // With --backward, the PID's to shift forward are all others.
     if (present(u"backward")) {
@@ -24,6 +24,7 @@
 #include "tsDVBEnhancedAC3Descriptor.h"
 #include "tsCueIdentifierDescriptor.h"
 #include "tsAlgorithm.h"
+#include "tsFatal.h"
 
 
 //----------------------------------------------------------------------------
@@ -74,6 +75,8 @@ namespace ts {
         bool                 _cleanup_priv_desc = false; // Remove private desc without preceding PDS desc
         DescriptorList       _add_descs {nullptr};       // List of descriptors to add at program level
         DescriptorListByPID  _add_pid_descs {};          // Lists of descriptors to add by PID
+        bool                 _patch_in_place = false;    // Modifications can be patched in binary sections (see modifyTableInPlace)
+        ByteBlock            _add_descs_bin {};          // Binary form of _add_descs, for in-place patching
         AudioLanguageOptionsVector _languages {};        // Audio languages to set
         std::vector<PID>     _sort_pids {};              // Sorting order of PIDs in PMT
         UStringVector        _sort_languages {};         // Sorting order of audio and subtitles PIDs in PMT
@@ -81,6 +84,7 @@ namespace ts {
         // Implementation of AbstractTablePlugin.
         virtual void createNewTable(BinaryTable& table) override;
         virtual void modifyTable(BinaryTable& table, bool& is_target, bool& reinsert) override;
+        virtual bool modifyTableInPlace(BinaryTable& table, bool& is_target, bool& reinsert) override;
 
         // Add a descriptor for a given PID in _add_pid_descs.
         void addComponentDescriptor(PID pid, const AbstractDescriptor& desc);
@@ -471,6 +475,18 @@ bool ts::PMTPlugin::start()
         _service.set(value(u"service"));
     }
 
+    // Determine if the requested modifications map to known byte ranges in the
+    // binary sections, in which case the PMT is patched in place, without a
+    // deserialization / reserialization round-trip (see modifyTableInPlace()).
+    _patch_in_place = !_set_servid && !_ac3_atsc2dvb && !_eac3_atsc2dvb && !_add_stream_id && !_cleanup_priv_desc &&
+                      _removed_pids.empty() && _removed_desc_tags.empty() && _removed_stream_types.empty() &&
+                      _added_pids.empty() && _add_pid_descs.empty() && _languages.empty() &&
+                      _sort_pids.empty() && _sort_languages.empty();
+    _add_descs_bin.clear();
+    for (size_t i = 0; i < _add_descs.count(); ++i) {
+        _add_descs_bin.append(_add_descs[i]->content(), _add_descs[i]->size());
+    }
+
     // Start superclass.
     return AbstractTablePlugin::start();
 }
@@ -489,7 +505,101 @@ void ts::PMTPlugin::createNewTable(BinaryTable& table)
         pmt.service_id = _service.getId();
     }
 
-    pmt.serialize(duck, table);
+    pmt.serialize(table, serializationBuffer());
+}
+
+
+//----------------------------------------------------------------------------
+// Invoked by the superclass to attempt an in-place binary modification.
+//----------------------------------------------------------------------------
+
+bool ts::PMTPlugin::modifyTableInPlace(BinaryTable& table, bool& is_target, bool& reinsert)
+{
+    // If not the PMT we are looking for, it is reinserted without modification,
+    // there is no need for a round-trip either.
+    is_target = table.tableId() == TID_PMT && (!_service.hasId() || table.tableIdExtension() == _service.getId());
+    if (!is_target) {
+        return true;
+    }
+
+    // Fall back to the object round-trip when some requested modification does
+    // not map to known byte ranges.
+    if (!_patch_in_place) {
+        return false;
+    }
+
+    // Patch copies of the sections, the input sections are shared with the demux.
+    // Commit them in the table only when all sections could be patched.
+    SectionPtrVector patched(table.sectionCount());
+    for (size_t i = 0; i < table.sectionCount(); ++i) {
+        const SectionPtr sec(table.sectionAt(i));
+        if (sec.isNull() || !sec->isValid() || sec->payloadSize() < 4) {
+            return false;
+        }
+        const uint8_t* const pl = sec->payload();
+        const size_t pl_size = sec->payloadSize();
+
+        // The elementary stream loop starts after the program info descriptors.
+        const size_t pinfo_length = GetUInt16(pl + 2) & 0x0FFF;
+        if (4 + pinfo_length > pl_size) {
+            return false;
+        }
+
+        // Patch a copy of the section, with a single CRC32 update at the end.
+        const SectionPtr newsec(new Section(*sec, ShareMode::COPY));
+        CheckNonNull(newsec.pointer());
+        bool changed = false;
+
+        // PCR PID substitution.
+        if (_set_pcrpid && (GetUInt16(pl) & 0x1FFF) != _new_pcrpid) {
+            changed = PatchPID(*newsec, 0, _new_pcrpid, false);
+            if (!changed) {
+                return false;
+            }
+        }
+
+        // PID substitutions in the elementary stream loop.
+        size_t offset = 4 + pinfo_length;
+        while (offset + 5 <= pl_size) {
+            const auto it = _moved_pids.find(PID(GetUInt16(pl + offset + 1) & 0x1FFF));
+            if (it != _moved_pids.end()) {
+                if (!PatchPID(*newsec, offset + 1, it->second, false)) {
+                    return false;
+                }
+                changed = true;
+            }
+            offset += 5 + (GetUInt16(pl + offset + 3) & 0x0FFF);
+        }
+        if (offset != pl_size) {
+            return false;  // malformed loop, let the object round-trip report it
+        }
+
+        // Program-level descriptors are appended in the first section, where a
+        // reserialized PMT object would put them. Enforce the PSI section limit,
+        // the generic helper only enforces the larger private section limit.
+        if (i == 0 && !_add_descs_bin.empty()) {
+            if (newsec->size() + _add_descs_bin.size() > MAX_PSI_SECTION_SIZE ||
+                !InsertInPayload(*newsec, 4 + pinfo_length, _add_descs_bin, 2))
+            {
+                return false;
+            }
+        }
+        else if (changed) {
+            newsec->recomputeCRC();
+        }
+        else {
+            continue;  // nothing to change in this section
+        }
+        patched[i] = newsec;
+    }
+
+    // All sections were successfully patched, commit them in the table.
+    for (const auto& newsec : patched) {
+        if (!newsec.isNull()) {
+            table.addSection(newsec);
+        }
+    }
+    return true;
 }
 
 
@@ -701,7 +811,7 @@ void ts::PMTPlugin::modifyTable(BinaryTable& table, bool& is_target, bool& reins
     }
 
     // Reserialize modified PMT.
-    pmt.serialize(duck, table);
+    pmt.serialize(table, serializationBuffer());
 }
 
 
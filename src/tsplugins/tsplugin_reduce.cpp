@@ -410,13 +410,20 @@ ts::BitRate ts::ReducePlugin::computeBitRate(const TSPacketWindow& win) const
     PCRAnalyzer pa(1, 2);
 
     // Pass all packets in the window to the PCR analyzer.
-    for (size_t i = 0; i < win.size(); ++i) {
-        const TSPacket* pkt = win.packet(i);
-        if (pkt != nullptr) {
-            // Pass null packet when this packet is not in a reference PID.
-            // We maintain the bitrate while avoiding excluded PID's with PCR's.
-            pa.feedPacket(_pcr_pids.test(pkt->getPID()) ? *pkt : NullPacket);
+    // Iterate segment by segment to stay cache-linear inside the window buffer.
+    for (size_t i = 0; i < win.size(); ) {
+        TSPacket* pkt = nullptr;
+        TSPacketMetadata* mdata = nullptr;
+        const size_t count = win.getRange(i, pkt, mdata);
+        for (size_t j = 0; j < count; ++j) {
+            // Skip dropped packets (zeroed sync byte).
+            if (pkt[j].b[0] == SYNC_BYTE) {
+                // Pass null packet when this packet is not in a reference PID.
+                // We maintain the bitrate while avoiding excluded PID's with PCR's.
+                pa.feedPacket(_pcr_pids.test(pkt[j].getPID()) ? pkt[j] : NullPacket);
+            }
         }
+        i += count;
     }
 
     // Return extracted bitrate or zero if none found.
@@ -30,6 +30,7 @@ namespace ts {
         // Implementation of plugin API
         virtual bool getOptions() override;
         virtual bool start() override;
+        virtual bool stop() override;
         virtual bool isRealTime() override {return true;}
         virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
 
@@ -39,6 +40,7 @@ namespace ts {
         BitRate       _bitrate = 0;
         PacketCounter _burst = 0;
         MilliSecond   _wait_min = 0;
+        NanoSecond    _spin = 0;
         PID           _pid_pcr = PID_NULL;
 
         // Working data:
@@ -74,6 +76,17 @@ ts::RegulatePlugin::RegulatePlugin(TSP* tsp_) :
          u"Regulate the flow based on the Program Clock Reference from the transport "
          u"stream. By default, use a bitrate, not PCR's.");
 
+    option(u"spin-duration", 0, POSITIVE);
+    help(u"spin-duration", u"micro-seconds",
+         u"Use a hybrid wait at the end of each packet burst: sleep until the specified "
+         u"number of micro-seconds before the scheduled end of burst, then actively wait "
+         u"on the monotonic clock for the remaining time. This makes the regulation much "
+         u"more precise at high bitrates, at the expense of some CPU load, and keeps the "
+         u"bursts at --packet-burst packets even when the burst duration is smaller than "
+         u"the precision of the operating system timers. Wake-up jitter statistics are "
+         u"reported at the end of the session, in verbose mode. "
+         u"By default, use plain system sleeps only.");
+
     option(u"pid-pcr", 0, PIDVAL);
     help(u"pid-pcr",
          u"With --pcr-synchronous, specify the reference PID for PCR's. By default, "
@@ -96,6 +109,7 @@ bool ts::RegulatePlugin::getOptions()
     getIntValue(_burst, u"packet-burst", DEF_PACKET_BURST);
     getIntValue(_wait_min, u"wait-min", PCRRegulator::DEFAULT_MIN_WAIT_NS / NanoSecPerMilliSec);
     getIntValue(_pid_pcr, u"pid-pcr", PID_NULL);
+    _spin = intValue<NanoSecond>(u"spin-duration", 0) * NanoSecPerMicroSec;
     _pcr_synchronous = present(u"pcr-synchronous");
 
     if (present(u"bitrate") && _pcr_synchronous) {
@@ -106,6 +120,10 @@ bool ts::RegulatePlugin::getOptions()
         tsp->error(u"--pid-pcr cannot be used without --pcr-synchronous");
         return false;
     }
+    if (present(u"spin-duration") && _pcr_synchronous) {
+        tsp->error(u"--spin-duration cannot be used with --pcr-synchronous");
+        return false;
+    }
     return true;
 }
 
@@ -128,12 +146,28 @@ bool ts::RegulatePlugin::start()
         tsp->debug(u"starting bitrate-based regulation");
         _bitrate_regulator.setBurstPacketCount(_burst);
         _bitrate_regulator.setFixedBitRate(_bitrate);
+        _bitrate_regulator.setSpinDuration(_spin);
         _bitrate_regulator.start();
     }
     return true;
 }
 
 
+//----------------------------------------------------------------------------
+// Stop method
+//----------------------------------------------------------------------------
+
+bool ts::RegulatePlugin::stop()
+{
+    // Report wake-up jitter statistics to evaluate the CBR conformance of the output.
+    if (!_pcr_synchronous && _bitrate_regulator.jitterCount() > 0) {
+        tsp->verbose(u"regulation wake-up jitter: average %'d ns, maximum %'d ns over %'d waits",
+                     {_bitrate_regulator.jitterAverage(), _bitrate_regulator.jitterMax(), _bitrate_regulator.jitterCount()});
+    }
+    return true;
+}
+
+
 //----------------------------------------------------------------------------
 // Packet processing method
 //----------------------------------------------------------------------------
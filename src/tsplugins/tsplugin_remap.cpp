@@ -21,6 +21,8 @@
 #include "tsCADescriptor.h"
 #include "tsSafePtr.h"
 
+#define PACKET_WINDOW_SIZE 512  // Process packets by windows of that size.
+
 
 //----------------------------------------------------------------------------
 // Plugin definition
@@ -35,6 +37,8 @@ namespace ts {
         virtual bool getOptions() override;
         virtual bool start() override;
         virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
+        virtual size_t getPacketWindowSize() override;
+        virtual size_t processPacketWindow(TSPacketWindow&) override;
 
     private:
         typedef SafePtr<CyclingPacketizer, ts::null_mutex> CyclingPacketizerPtr;
@@ -45,6 +49,12 @@ namespace ts {
         SectionDemux  _demux {duck, this};  // Section demux
         PacketizerMap _pzer {};             // Packetizer for sections
 
+        // Flat remapping table, indexed by input PID. The value is the output
+        // PID (identity when not remapped), already positioned in the 13-bit
+        // PID field of TS header bytes 1 and 2. The per-packet remapping is
+        // one table load and two byte stores, without map lookup.
+        uint16_t _remap_table[PID_MAX] {};
+
         // Invoked by the demux when a complete table is available.
         virtual void handleTable(SectionDemux&, const BinaryTable&) override;
 
@@ -56,6 +66,9 @@ namespace ts {
 
         // Process a list of descriptors, remap PIDs in CA descriptors.
         void processDescriptors(DescriptorList&, TID);
+
+        // Process one packet, non-virtual core of processPacket().
+        Status processOnePacket(TSPacket&, TSPacketMetadata&);
     };
 }
 
@@ -112,6 +125,14 @@ bool ts::RemapPlugin::start()
     // Do not care about PMT if no need to update PSI
     _pmt_ready = !_update_psi;
 
+    // Build the flat remapping table: identity, then the remapped PID's.
+    for (size_t pid = 0; pid < PID_MAX; ++pid) {
+        _remap_table[pid] = uint16_t(pid);
+    }
+    for (const auto& it : _pidMap) {
+        _remap_table[it.first] = it.second;
+    }
+
     tsp->verbose(u"%d PID's remapped", {_pidMap.size()});
     return true;
 }
@@ -123,8 +144,7 @@ bool ts::RemapPlugin::start()
 
 ts::PID ts::RemapPlugin::remap(PID pid)
 {
-    const auto it = _pidMap.find(pid);
-    return it == _pidMap.end() ? pid : it->second;
+    return pid < PID_MAX ? PID(_remap_table[pid]) : pid;
 }
 
 
@@ -230,9 +250,14 @@ void ts::RemapPlugin::handleTable(SectionDemux& demux, const BinaryTable& table)
 //----------------------------------------------------------------------------
 
 ts::ProcessorPlugin::Status ts::RemapPlugin::processPacket(TSPacket& pkt, TSPacketMetadata& pkt_data)
+{
+    return processOnePacket(pkt, pkt_data);
+}
+
+ts::ProcessorPlugin::Status ts::RemapPlugin::processOnePacket(TSPacket& pkt, TSPacketMetadata& pkt_data)
 {
     const PID pid = pkt.getPID();
-    const PID new_pid = remap(pid);
+    const PID new_pid = PID(_remap_table[pid]);
 
     // PSI processing
     if (_update_psi) {
@@ -258,9 +283,11 @@ ts::ProcessorPlugin::Status ts::RemapPlugin::processPacket(TSPacket& pkt, TSPack
         return TSP_END;
     }
 
-    // Finally, perform remapping.
+    // Finally, perform remapping: two byte stores in the TS header, preserving
+    // the error, unit start and priority bits of the first byte.
     if (pid != new_pid) {
-        pkt.setPID(new_pid);
+        pkt.b[1] = uint8_t((pkt.b[1] & 0xE0) | (new_pid >> 8));
+        pkt.b[2] = uint8_t(new_pid);
         // Apply labels on remapped packets.
         pkt_data.setLabels(_setLabels);
         pkt_data.clearLabels(_resetLabels);
@@ -268,3 +295,37 @@ ts::ProcessorPlugin::Status ts::RemapPlugin::processPacket(TSPacket& pkt, TSPack
 
     return TSP_OK;
 }
+
+
+//----------------------------------------------------------------------------
+// Packet window processing methods.
+//----------------------------------------------------------------------------
+
+size_t ts::RemapPlugin::getPacketWindowSize()
+{
+    return PACKET_WINDOW_SIZE;
+}
+
+size_t ts::RemapPlugin::processPacketWindow(TSPacketWindow& win)
+{
+    // Process the packets of a window in sequence, without going back to tsp
+    // between packets. On high-volume streams, the per-packet executor
+    // overhead and virtual dispatch are paid once per window only.
+    for (size_t i = 0; i < win.size(); ++i) {
+        TSPacket* pkt = nullptr;
+        TSPacketMetadata* mdata = nullptr;
+        if (win.get(i, pkt, mdata)) {
+            const Status status = processOnePacket(*pkt, *mdata);
+            if (status == TSP_NULL) {
+                win.nullify(i);
+            }
+            else if (status == TSP_DROP) {
+                win.drop(i);
+            }
+            else if (status == TSP_END) {
+                return i;
+            }
+        }
+    }
+    return win.size();
+}
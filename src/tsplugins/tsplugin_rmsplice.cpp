@@ -594,7 +594,9 @@ ts::ProcessorPlugin::Status ts::RMSplicePlugin::processPacket(TSPacket& pkt, TSP
                     pkt.setDTS((pkt.getDTS() - state.totalAdjust) & PTS_DTS_MASK);
                 }
                 if (pkt.hasPCR()) {
-                    pkt.setPCR(pkt.getPCR() - state.totalAdjust * SYSTEM_CLOCK_SUBFACTOR);
+                    const uint64_t pcr = pkt.getPCR() - state.totalAdjust * SYSTEM_CLOCK_SUBFACTOR;
+                    pkt.setPCR(pcr);
+                    pkt_data.setPCR(pcr);
                 }
                 if (pkt.hasOPCR()) {
                     pkt.setOPCR(pkt.getOPCR() - state.totalAdjust * SYSTEM_CLOCK_SUBFACTOR);
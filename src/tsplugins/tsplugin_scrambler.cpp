@@ -14,6 +14,7 @@
 #include "tsPluginRepository.h"
 #include "tsServiceDiscovery.h"
 #include "tsTSScrambling.h"
+#include "tsThread.h"
 #include "tsByteBlock.h"
 #include "tsCyclingPacketizer.h"
 #include "tsOneShotPacketizer.h"
@@ -22,10 +23,12 @@
 #include "tsBetterSystemRandomGenerator.h"
 #include "tsCADescriptor.h"
 #include "tsScramblingDescriptor.h"
+#include "tsFatal.h"
 
 #define DEFAULT_ECM_BITRATE 30000
 #define DEFAULT_ECM_INTER_PACKET  7000  // When bitrate is unknown, use 10 ECM/s for TS @10Mb/s
 #define ASYNC_HANDLER_EXTRA_STACK_SIZE (1024 * 1024)
+#define PACKETS_PER_SCRAMBLING_THREAD 512  // Packet window share of one scrambling thread
 
 
 //----------------------------------------------------------------------------
@@ -82,6 +85,8 @@ namespace ts {
         virtual bool start() override;
         virtual bool stop() override;
         virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
+        virtual size_t getPacketWindowSize() override;
+        virtual size_t processPacketWindow(TSPacketWindow&) override;
 
     private:
         // Description of a crypto-period.
@@ -134,6 +139,46 @@ namespace ts {
             virtual void handleECM(const ecmgscs::ECMResponse&) override;
         };
 
+        // A scrambling worker thread, used with --threads.
+        // Each worker owns a private copy of the scrambling engine, configured
+        // from the same command line as the main one. A single TSScrambling
+        // object cannot be shared between threads: the underlying ciphers
+        // update their internal state on each scrambled packet.
+        class ScrambleWorker: public Thread
+        {
+            TS_NOBUILD_NOCOPY(ScrambleWorker);
+        public:
+            // Constructor.
+            ScrambleWorker(ScramblerPlugin* plugin);
+
+            // Access the private scrambling engine (setup of parameters and keys).
+            TSScrambling& scrambling() { return _scrambling; }
+
+            // Submit a slice of packets to scramble. The packets are modified in place.
+            void startWork(TSPacket* const* packets, size_t count);
+
+            // Wait for the completion of the current slice. Return false on scrambling error.
+            bool waitWork();
+
+            // Request the termination of the thread, to be followed by waitForTermination().
+            void stopThread();
+
+        private:
+            ScramblerPlugin* _plugin;                 // Reference to scrambler plugin.
+            TSScrambling     _scrambling;             // Private scrambling engine.
+            std::mutex              _mutex {};        // Protect access to the fields below.
+            std::condition_variable _wake {};         // Signalled when work is submitted or termination requested.
+            std::condition_variable _completed {};    // Signalled when the current slice is completed.
+            TSPacket* const* _packets = nullptr;      // Current slice of packets to scramble.
+            size_t           _count = 0;              // Number of packets in the slice.
+            bool             _success = true;         // Completion status of the last slice.
+            bool             _terminate = false;      // Termination was requested.
+
+            // Thread main code.
+            virtual void main() override;
+        };
+        typedef SafePtr<ScrambleWorker, ts::null_mutex> ScrambleWorkerPtr;
+
         // ScramblerPlugin parameters, remain constant after start()
         ServiceDiscovery  _service {duck, this};        // Service description
         bool              _use_service = false;         // Scramble a service (ie. not a specific list of PID's).
@@ -147,6 +192,7 @@ namespace ts {
         bool              _need_cp = false;             // Need to manage crypto-periods (ie. not one single fixed CW).
         bool              _need_ecm = false;            // Need to manage ECM insertion (ie. not fixed CW's).
         bool              _pre_reduce_cw = false;       // Reduce the control word before sending to the ECMG.
+        size_t            _num_threads = 0;             // Number of scrambling worker threads (0: scramble inline).
         MilliSecond       _delay_start = 0;             // Delay between CP start and ECM start (can be negative)
         ByteBlock         _ca_desc_private {};          // Private data to insert in CA_descriptor
         BitRate           _ecm_bitrate = 0;             // ECM PID's bitrate
@@ -179,6 +225,8 @@ namespace ts {
         size_t            _current_ecm = 0;             // Index to current ECM (ECM being broadcast)
         TSScrambling      _scrambling {*tsp};           // Scrambler
         CyclingPacketizer _pzer_pmt {duck};             // Packetizer for modified PMT
+        std::vector<ScrambleWorkerPtr> _workers {};     // Scrambling worker threads.
+        std::vector<TSPacket*> _batch {};               // Packets of the window waiting to be scrambled by the workers.
 
         // Initialize ECM and CP scheduling.
         void initializeScheduling();
@@ -193,6 +241,17 @@ namespace ts {
         bool changeCW();
         void changeECM();
 
+        // Packet processing. When deferred is not null, the packets to scramble
+        // are recorded in _batch instead of being scrambled inline.
+        Status processPacketInternal(TSPacket&, TSPacketMetadata&, bool* deferred);
+
+        // Distribute the pending packets to the worker threads and wait for completion.
+        bool flushScrambleBatch();
+
+        // Set the encryption parity or CW on the main scrambler and all workers.
+        bool setScramblingParity(size_t parity);
+        bool setScramblingCW(const ByteBlock& cw, size_t parity);
+
         // Check if we are in degraded mode or if we enter degraded mode
         bool inDegradedMode();
 
@@ -302,6 +361,15 @@ ts::ScramblerPlugin::ScramblerPlugin(TSP* tsp_) :
          u"mode, the packet processing continues while generating ECM's. This option "
          u"is always on in offline mode.");
 
+    option(u"threads", 0, POSITIVE);
+    help(u"threads", u"count",
+         u"Scramble the packets using the specified number of worker threads. "
+         u"By default, the packets are scrambled in the context of the plugin thread. "
+         u"With worker threads, the packets of a crypto-period are distributed over "
+         u"the threads while crypto-period transitions act as synchronization barriers. "
+         u"This can be necessary to sustain the bitrate of heavily loaded transport "
+         u"streams in real-time mode.");
+
     // ECMG and scrambling options.
     _ecmg_args.defineArgs(*this);
     _scrambling.defineArgs(*this);
@@ -330,12 +398,25 @@ bool ts::ScramblerPlugin::getOptions()
     getIntValue(_ecm_pid, u"pid-ecm", PID_NULL);
     getValue(_ecm_bitrate, u"bitrate-ecm", DEFAULT_ECM_BITRATE);
     getHexaValue(_ca_desc_private, u"private-data");
+    getIntValue(_num_threads, u"threads", 0);
 
     // Other common parameters.
     if (!_ecmg_args.loadArgs(duck, *this) || !_scrambling.loadArgs(duck, *this)) {
         return false;
     }
 
+    // Create the scrambling worker threads. The private scrambling engine of
+    // each worker is configured from the same command line as the main one.
+    _workers.clear();
+    for (size_t i = 0; i < _num_threads; ++i) {
+        const ScrambleWorkerPtr worker(new ScrambleWorker(this));
+        CheckNonNull(worker.pointer());
+        if (!worker->scrambling().loadArgs(duck, *this)) {
+            return false;
+        }
+        _workers.push_back(worker);
+    }
+
     // Set logging levels.
     _logger.setDefaultSeverity(_ecmg_args.log_protocol);
     _logger.setSeverity(ecmgscs::Tags::CW_provision, _ecmg_args.log_data);
@@ -394,6 +475,15 @@ bool ts::ScramblerPlugin::start()
         return false;
     }
 
+    // Start the scrambling worker threads. Their engines must be started
+    // before the first key is set since key changes are mirrored to them.
+    _batch.clear();
+    for (const auto& worker : _workers) {
+        if (!worker->scrambling().start() || !worker->start()) {
+            return false;
+        }
+    }
+
     // Initialize ECMG.
     if (_need_ecm) {
         if (!_ecmg_args.ecmg_address.hasAddress()) {
@@ -455,6 +545,15 @@ bool ts::ScramblerPlugin::stop()
         _ecmg.disconnect();
     }
 
+    // Terminate the scrambling worker threads.
+    for (const auto& worker : _workers) {
+        worker->stopThread();
+    }
+    for (const auto& worker : _workers) {
+        worker->waitForTermination();
+        worker->scrambling().stop();
+    }
+
     // Terminate the scrambling engine.
     _scrambling.stop();
 
@@ -661,6 +760,12 @@ bool ts::ScramblerPlugin::tryExitDegradedMode()
 
 bool ts::ScramblerPlugin::changeCW()
 {
+    // With worker threads, all packets of the previous crypto-period must be
+    // scrambled before changing any key (crypto-period transition barrier).
+    if (!flushScrambleBatch()) {
+        return false;
+    }
+
     if (_scrambling.hasFixedCW()) {
         // A list of fixed CW was loaded from a file.
 
@@ -673,7 +778,7 @@ bool ts::ScramblerPlugin::changeCW()
         }
 
         // Set next crypto-period key.
-        return _scrambling.setEncryptParity(int(_current_cw));
+        return setScramblingParity(_current_cw);
     }
     else if (!inDegradedMode()) {
         // Random CW and ECM generation at each crypto-period.
@@ -724,6 +829,11 @@ void ts::ScramblerPlugin::changeECM()
 //----------------------------------------------------------------------------
 
 ts::ProcessorPlugin::Status ts::ScramblerPlugin::processPacket(TSPacket& pkt, TSPacketMetadata& pkt_data)
+{
+    return processPacketInternal(pkt, pkt_data, nullptr);
+}
+
+ts::ProcessorPlugin::Status ts::ScramblerPlugin::processPacketInternal(TSPacket& pkt, TSPacketMetadata& pkt_data, bool* deferred)
 {
     // Count packets
     _packet_count++;
@@ -830,7 +940,11 @@ ts::ProcessorPlugin::Status ts::ScramblerPlugin::processPacket(TSPacket& pkt, TS
     }
 
     // Scramble the packet payload.
-    if (!_scrambling.encrypt(pkt)) {
+    if (deferred != nullptr) {
+        // Worker threads in use, the packet is scrambled later with the rest of the window.
+        *deferred = true;
+    }
+    else if (!_scrambling.encrypt(pkt)) {
         return TSP_END;
     }
     _scrambled_count++;
@@ -839,6 +953,104 @@ ts::ProcessorPlugin::Status ts::ScramblerPlugin::processPacket(TSPacket& pkt, TS
 }
 
 
+//----------------------------------------------------------------------------
+// Packet window processing method, used with --threads.
+//----------------------------------------------------------------------------
+
+size_t ts::ScramblerPlugin::getPacketWindowSize()
+{
+    // A non-zero value selects the packet window API in tsp.
+    return _num_threads == 0 ? 0 : _num_threads * PACKETS_PER_SCRAMBLING_THREAD;
+}
+
+size_t ts::ScramblerPlugin::processPacketWindow(TSPacketWindow& win)
+{
+    for (size_t i = 0; i < win.size(); ++i) {
+        TSPacket* const pkt = win.packet(i);
+        TSPacketMetadata* const data = win.metadata(i);
+        if (pkt == nullptr) {
+            // The packet was dropped by a previous plugin.
+            continue;
+        }
+        bool deferred = false;
+        const Status status = processPacketInternal(*pkt, *data, &deferred);
+        if (status == TSP_OK) {
+            if (deferred) {
+                // To be scrambled, accumulate until the next flush.
+                _batch.push_back(pkt);
+            }
+        }
+        else if (status == TSP_NULL) {
+            win.nullify(i);
+        }
+        else if (status == TSP_DROP) {
+            win.drop(i);
+        }
+        else {
+            // TSP_END: scramble what was accumulated so far and terminate.
+            flushScrambleBatch();
+            return i;
+        }
+    }
+
+    // Scramble all remaining packets of the window.
+    return flushScrambleBatch() ? win.size() : 0;
+}
+
+
+//----------------------------------------------------------------------------
+// Distribute the pending packets to the worker threads, wait for completion.
+//----------------------------------------------------------------------------
+
+bool ts::ScramblerPlugin::flushScrambleBatch()
+{
+    if (_batch.empty()) {
+        return true;
+    }
+    assert(!_workers.empty());
+
+    // Distribute contiguous slices of the batch over the workers. All packets
+    // of the batch belong to the same crypto-period, the slicing is arbitrary.
+    const size_t slice = (_batch.size() + _workers.size() - 1) / _workers.size();
+    size_t started = 0;
+    for (size_t start = 0; start < _batch.size(); start += slice) {
+        _workers[started++]->startWork(&_batch[start], std::min(slice, _batch.size() - start));
+    }
+
+    // Wait for all workers. The packets are scrambled in place, inside the
+    // packet window, so the output order is preserved without reordering.
+    bool success = true;
+    for (size_t i = 0; i < started; ++i) {
+        success = _workers[i]->waitWork() && success;
+    }
+    _batch.clear();
+    return success;
+}
+
+
+//----------------------------------------------------------------------------
+// Set the encryption parity or CW on the main scrambler and all workers.
+//----------------------------------------------------------------------------
+
+bool ts::ScramblerPlugin::setScramblingParity(size_t parity)
+{
+    bool success = _scrambling.setEncryptParity(int(parity));
+    for (const auto& worker : _workers) {
+        success = worker->scrambling().setEncryptParity(int(parity)) && success;
+    }
+    return success;
+}
+
+bool ts::ScramblerPlugin::setScramblingCW(const ByteBlock& cw, size_t parity)
+{
+    bool success = _scrambling.setCW(cw, int(parity));
+    for (const auto& worker : _workers) {
+        success = worker->scrambling().setCW(cw, int(parity)) && success;
+    }
+    return success;
+}
+
+
 //----------------------------------------------------------------------------
 // Initialize first crypto period.
 //----------------------------------------------------------------------------
@@ -897,8 +1109,8 @@ bool ts::ScramblerPlugin::CryptoPeriod::initScramblerKey() const
 
     // Change the parity of the scrambled packets.
     // Set our random current control word if no fixed CW.
-    return _plugin->_scrambling.setEncryptParity(_cp_number) &&
-        (!_plugin->_need_ecm || _plugin->_scrambling.setCW(_cw_current, _cp_number));
+    return _plugin->setScramblingParity(_cp_number) &&
+        (!_plugin->_need_ecm || _plugin->setScramblingCW(_cw_current, _cp_number));
 }
 
 
@@ -1008,3 +1220,89 @@ void ts::ScramblerPlugin::CryptoPeriod::getNextECMPacket(TSPacket& pkt)
         _plugin->_ecm_cc = (_plugin->_ecm_cc + 1) & 0x0F;
     }
 }
+
+
+//----------------------------------------------------------------------------
+// Scrambling worker thread.
+//----------------------------------------------------------------------------
+
+ts::ScramblerPlugin::ScrambleWorker::ScrambleWorker(ScramblerPlugin* plugin) :
+    _plugin(plugin),
+    _scrambling(*plugin->tsp)
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Submit a slice of packets to a worker thread.
+//----------------------------------------------------------------------------
+
+void ts::ScramblerPlugin::ScrambleWorker::startWork(TSPacket* const* packets, size_t count)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _packets = packets;
+    _count = count;
+    _wake.notify_one();
+}
+
+
+//----------------------------------------------------------------------------
+// Wait for the completion of the current slice in a worker thread.
+//----------------------------------------------------------------------------
+
+bool ts::ScramblerPlugin::ScrambleWorker::waitWork()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (_packets != nullptr) {
+        _completed.wait(lock);
+    }
+    return _success;
+}
+
+
+//----------------------------------------------------------------------------
+// Request the termination of a worker thread.
+//----------------------------------------------------------------------------
+
+void ts::ScramblerPlugin::ScrambleWorker::stopThread()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _terminate = true;
+    _wake.notify_one();
+}
+
+
+//----------------------------------------------------------------------------
+// Worker thread main code.
+//----------------------------------------------------------------------------
+
+void ts::ScramblerPlugin::ScrambleWorker::main()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    for (;;) {
+        // Wait for a slice of packets or a termination request.
+        while (_packets == nullptr && !_terminate) {
+            _wake.wait(lock);
+        }
+        if (_packets == nullptr) {
+            break;
+        }
+
+        // Scramble the slice without holding the mutex. The plugin thread
+        // does not touch these packets until waitWork() returns.
+        TSPacket* const* const packets = _packets;
+        const size_t count = _count;
+        lock.unlock();
+        bool success = true;
+        for (size_t i = 0; success && i < count; ++i) {
+            success = _scrambling.encrypt(*packets[i]);
+        }
+        lock.lock();
+
+        // Report the completion to the plugin thread.
+        _success = success;
+        _packets = nullptr;
+        _count = 0;
+        _completed.notify_one();
+    }
+}
@@ -199,7 +199,7 @@ void ts::SDTPlugin::createNewTable(BinaryTable& table)
         sdt.ts_id = _other_ts_id;
     }
 
-    sdt.serialize(duck, table);
+    sdt.serialize(table, serializationBuffer());
 }
 
 
@@ -286,5 +286,5 @@ void ts::SDTPlugin::modifyTable(BinaryTable& table, bool& is_target, bool& reins
     }
 
     // Reserialize modified SDT.
-    sdt.serialize(duck, table);
+    sdt.serialize(table, serializationBuffer());
 }
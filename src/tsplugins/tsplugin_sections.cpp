@@ -17,6 +17,8 @@
 #include "tsPacketizer.h"
 #include "tsAlgorithm.h"
 #include "tsBoolPredicate.h"
+#include "tsMessageQueue.h"
+#include "tsThread.h"
 #include "tsFatal.h"
 
 
@@ -35,6 +37,7 @@ namespace ts {
         // Implementation of plugin API
         virtual bool getOptions() override;
         virtual bool start() override;
+        virtual bool stop() override;
         virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
 
     private:
@@ -48,6 +51,8 @@ namespace ts {
         MonoBoolPredicate      _valid_predicate = nullptr;     // see method condition()
         BoolPredicate          _cond_predicate = nullptr;      // see method condition()
         size_t                 _max_buffered_sections = 1024;  // hard-coded for now
+        size_t                 _shard_queue_size = 256;        // hard-coded for now
+        size_t                 _num_shards = 0;                // see option --shards
         PIDSet                 _input_pids {};
         PID                    _output_pid = PID_NULL;
         std::set<TID>          _tids {};
@@ -64,6 +69,68 @@ namespace ts {
         Packetizer            _packetizer {duck, PID_NULL, this};
         TablePatchXML         _patch_xml {duck};
 
+        // With --shards, the input PID's are partitioned across worker threads.
+        // Each shard demuxes, filters and patches its own subset of PID's in a
+        // dedicated thread. Kept sections are tagged with the index of the
+        // input packet which completed them and are merged back in input
+        // order, see drainShards().
+        class Shard: public Thread, private SectionHandlerInterface
+        {
+            TS_NOBUILD_NOCOPY(Shard);
+        public:
+            // Build a shard processing a subset of the input PID's.
+            Shard(SectionsPlugin& plugin, const PIDSet& pids);
+
+            // Load the patch files. Must be called before starting the thread.
+            bool init() { return _patch.loadPatchFiles(); }
+
+            // Queue one input packet. Blocking when the shard is saturated,
+            // applying back-pressure on the plugin thread.
+            void putPacket(const TSPacket& pkt, PacketCounter index);
+
+            // Queue a termination request, after all packets.
+            void putTermination();
+
+            // Output data, all guarded by the plugin's _merge_mutex:
+            std::list<std::pair<PacketCounter, SectionPtr>> done {};  // final sections, in input order
+            PacketCounter watermark = 0;  // all packets up to this index are fully processed
+            size_t        pending = 0;    // queued packets, not yet processed
+
+        private:
+            // One queued message: an input packet or a termination request.
+            class Job
+            {
+            public:
+                bool          terminate = false;
+                PacketCounter index = 0;
+                TSPacket      pkt {};
+            };
+
+            SectionsPlugin& _plugin;
+            SectionDemux    _demux;
+            TablePatchXML   _patch;
+            MessageQueue<Job, std::mutex> _queue {};
+            PacketCounter   _current_index = 0;  // index of the packet being demuxed
+            std::list<std::pair<PacketCounter, SectionPtr>> _current {};  // sections from that packet
+
+            // Invoked in the context of the shard thread.
+            virtual void main() override;
+
+            // Implementation of SectionHandlerInterface, in the context of the shard thread.
+            virtual void handleSection(SectionDemux& demux, const Section& section) override;
+        };
+
+        std::vector<SafePtr<Shard>> _shards {};       // empty when processing in the plugin thread
+        std::map<PID, size_t>       _shard_of_pid {}; // which shard demuxes each input PID
+        std::mutex                  _merge_mutex {};  // protects the output data of all shards
+        PacketCounter               _packet_index = 0;
+
+        // Check if a section shall be kept, according to the selection options.
+        bool keepSection(const Section& section) const;
+
+        // Move the sections which are final, in input order, from the shards to _sections.
+        void drainShards();
+
         // Compute a condition in the chain of _predicate.
         // - valid: the condition needs to be checked (eg. there are some tids to remove).
         // - cond: the condition itself (eg. this section has a tid to remove).
@@ -166,6 +233,16 @@ ts::SectionsPlugin::SectionsPlugin(TSP* tsp_) :
          u"Remove/keep all sections with the corresponding section number. "
          u"Several options --section-number can be specified.");
 
+    option(u"shards", 0, INTEGER, 0, 1, 1, 16);
+    help(u"shards", u"count",
+         u"Process the input PID's in the specified number of parallel threads. "
+         u"The input PID's are partitioned across the threads, each one running "
+         u"its own section demux and XML patcher, and the filtered sections are "
+         u"merged back in their input order before repacketization. "
+         u"This can be useful on SI-dense streams with many input PID's and "
+         u"expensive filters or patches. By default, or with one single shard, "
+         u"all sections are processed in the plugin thread.");
+
     option(u"stuffing", 's');
     help(u"stuffing",
          u"Insert stuffing at end of each section, up to the next TS packet "
@@ -219,6 +296,7 @@ bool ts::SectionsPlugin::getOptions()
     getIntValues(_etids, u"etid");
     getIntValues(_versions, u"version");
     getIntValues(_section_numbers, u"section-number");
+    getIntValue(_num_shards, u"shards", 0);
 
     _contents.resize(count(u"section-content"));
     for (size_t i = 0; i < _contents.size(); ++i) {
@@ -271,10 +349,56 @@ bool ts::SectionsPlugin::start()
     _packetizer.reset();
     _packetizer.setPID(_output_pid);
     _sections.clear();
+    _packet_index = 0;
+
+    // Create and start the worker shards if requested.
+    _shards.clear();
+    _shard_of_pid.clear();
+    if (_num_shards > 1) {
+        // Partition the input PID's across the shards, round-robin over the sorted PID's.
+        std::vector<PIDSet> parts(_num_shards);
+        size_t next = 0;
+        for (PID pid = 0; pid < PID_MAX; ++pid) {
+            if (_input_pids.test(pid)) {
+                _shard_of_pid[pid] = next % _num_shards;
+                parts[next++ % _num_shards].set(pid);
+            }
+        }
+        for (size_t i = 0; i < _num_shards; ++i) {
+            SafePtr<Shard> sh(new Shard(*this, parts[i]));
+            CheckNonNull(sh.pointer());
+            if (!sh->init() || !sh->start()) {
+                stop();
+                return false;
+            }
+            _shards.push_back(sh);
+        }
+        return true;
+    }
+
     return _patch_xml.loadPatchFiles();
 }
 
 
+//----------------------------------------------------------------------------
+// Stop method
+//----------------------------------------------------------------------------
+
+bool ts::SectionsPlugin::stop()
+{
+    // Terminate the shard threads and collect their last sections.
+    for (auto& sh : _shards) {
+        sh->putTermination();
+    }
+    for (auto& sh : _shards) {
+        sh->waitForTermination();
+    }
+    drainShards();
+    _shards.clear();
+    return true;
+}
+
+
 //----------------------------------------------------------------------------
 // Check if a section matches any selected leading content.
 //----------------------------------------------------------------------------
@@ -327,6 +451,28 @@ void ts::SectionsPlugin::provideSection(SectionCounter counter, SectionPtr& sect
 //----------------------------------------------------------------------------
 
 void ts::SectionsPlugin::handleSection(SectionDemux& demux, const Section& section)
+{
+    if (keepSection(section)) {
+        // Build a copy of the section for insertion in the queue.
+        SectionPtr sp(new Section(section, ShareMode::SHARE));
+        CheckNonNull(sp.pointer());
+
+        // Process XML patching. On patch error, drop that section.
+        // Errors are displayed in applyPatches().
+        // Then insert the section in the queue for the packetizer
+        // (if not deleted by the patch file).
+        if (_patch_xml.applyPatches(sp) && !sp.isNull()) {
+            _sections.push_back(sp);
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Check if a section shall be kept, according to the selection options.
+//----------------------------------------------------------------------------
+
+bool ts::SectionsPlugin::keepSection(const Section& section) const
 {
     // Section characteristics.
     const TID tid = section.tableId();
@@ -344,23 +490,113 @@ void ts::SectionsPlugin::handleSection(SectionDemux& demux, const Section& secti
         condition(!_contents.empty(), matchContent(section)),
     });
 
-    if (!_selections_present || (_keep_selected && selected) || (!_keep_selected && !selected)) {
-        // At this point, we need to keep the section.
+    return !_selections_present || (_keep_selected && selected) || (!_keep_selected && !selected);
+}
 
-        // Build a copy of it for insertion in the queue.
-        SectionPtr sp(new Section(section, ShareMode::SHARE));
-        CheckNonNull(sp.pointer());
 
-        // Process XML patching.
-        if (!_patch_xml.applyPatches(sp)) {
-            // Patch error, drop that section. Errors are displayed in applyPatches().
-            return;
+//----------------------------------------------------------------------------
+// Worker shard implementation.
+//----------------------------------------------------------------------------
+
+ts::SectionsPlugin::Shard::Shard(SectionsPlugin& plugin, const PIDSet& pids) :
+    _plugin(plugin),
+    // The plugin's DuckContext is shared by all shards. It is only used for
+    // reporting (thread-safe in tsp) and character sets. The only concurrent
+    // update is the accumulation of standards, a bit-mask where a lost
+    // update is harmless.
+    _demux(plugin.duck, nullptr, this),
+    _patch(plugin.duck)
+{
+    _demux.setPIDFilter(pids);
+    _queue.setMaxMessages(plugin._shard_queue_size);
+}
+
+void ts::SectionsPlugin::Shard::putPacket(const TSPacket& pkt, PacketCounter index)
+{
+    {
+        std::lock_guard<std::mutex> lock(_plugin._merge_mutex);
+        pending++;
+    }
+    Job* job = new Job;
+    CheckNonNull(job);
+    job->index = index;
+    job->pkt = pkt;
+    _queue.enqueue(job);
+}
+
+void ts::SectionsPlugin::Shard::putTermination()
+{
+    Job* job = new Job;
+    CheckNonNull(job);
+    job->terminate = true;
+    _queue.forceEnqueue(job);
+}
+
+void ts::SectionsPlugin::Shard::main()
+{
+    for (;;) {
+        MessageQueue<Job, std::mutex>::MessagePtr job;
+        _queue.dequeue(job);
+        if (job.isNull() || job->terminate) {
+            break;
         }
 
-        // Now insert the section in the queue for the packetizer (if not deleted by the patch file).
-        if (!sp.isNull()) {
-            _sections.push_back(sp);
+        // Demux the packet. Kept sections accumulate in _current.
+        _current_index = job->index;
+        _demux.feedPacket(job->pkt);
+
+        // Publish the sections and the progress.
+        std::lock_guard<std::mutex> lock(_plugin._merge_mutex);
+        done.splice(done.end(), _current);
+        watermark = job->index;
+        pending--;
+    }
+}
+
+void ts::SectionsPlugin::Shard::handleSection(SectionDemux& demux, const Section& section)
+{
+    if (_plugin.keepSection(section)) {
+        // Duplicate the section content. A shared copy would share a
+        // non-thread-safe reference count with the demux of this shard.
+        SectionPtr sp(new Section(section, ShareMode::COPY));
+        CheckNonNull(sp.pointer());
+        if (_patch.applyPatches(sp) && !sp.isNull()) {
+            _current.push_back(std::make_pair(_current_index, sp));
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Move the sections which are final from the shards to _sections.
+//----------------------------------------------------------------------------
+
+void ts::SectionsPlugin::drainShards()
+{
+    std::lock_guard<std::mutex> lock(_merge_mutex);
+    for (;;) {
+        // Compute the release frontier: no shard can still produce a section
+        // at or before this packet index. A shard with an empty queue can
+        // only produce sections for packets which are not yet received.
+        PacketCounter safe = _packet_index;
+        Shard* next = nullptr;
+        for (const auto& sh : _shards) {
+            if (!sh->done.empty()) {
+                const PacketCounter head = sh->done.front().first;
+                safe = std::min(safe, head);
+                if (next == nullptr || head < next->done.front().first) {
+                    next = sh.pointer();
+                }
+            }
+            else if (sh->pending > 0) {
+                safe = std::min(safe, sh->watermark);
+            }
+        }
+        if (next == nullptr || next->done.front().first > safe) {
+            break;
         }
+        _sections.push_back(next->done.front().second);
+        next->done.pop_front();
     }
 }
 
@@ -380,7 +616,18 @@ ts::ProcessorPlugin::Status ts::SectionsPlugin::processPacket(TSPacket& pkt, TSP
     }
 
     // Filter sections to process / merge.
-    _demux.feedPacket(pkt);
+    _packet_index++;
+    if (_shards.empty()) {
+        _demux.feedPacket(pkt);
+    }
+    else {
+        // Route the packet to the shard owning its PID, then collect the
+        // sections which are final, in input order.
+        if (_input_pids.test(pid)) {
+            _shards[_shard_of_pid[pid]]->putPacket(pkt, _packet_index);
+        }
+        drainShards();
+    }
 
     // Fool-proof check. It the input PID's contain packed sections and
     // we perform section stuffing and we do not reuse null packets or
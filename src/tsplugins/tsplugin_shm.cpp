@@ -0,0 +1,418 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  Transport stream processor shared library:
+//  Transfer TS packets between two tsp processes through a lock-free ring
+//  of packets in a named shared memory segment.
+//
+//----------------------------------------------------------------------------
+
+#include "tsPluginRepository.h"
+#include "tsSysUtils.h"
+
+// Default number of packets in the shared memory ring.
+#define DEFAULT_RING_PACKETS 2048
+
+// Polling interval in milliseconds when the ring is full (producer) or empty (consumer).
+#define POLL_INTERVAL 1
+
+
+//----------------------------------------------------------------------------
+// Layout of the shared memory segment.
+//----------------------------------------------------------------------------
+
+namespace ts {
+    //
+    // The segment contains a fixed header followed by a ring of packet slots.
+    // This is a classic single-producer single-consumer lock-free ring: the
+    // indices are free-running counters, the slot number is the counter modulo
+    // the ring size. The producer only writes write_index, the consumer only
+    // writes read_index, each with release semantics after accessing the slots.
+    //
+    struct ShmRingHeader
+    {
+        uint32_t version;                      // Layout version of the segment.
+        uint64_t ring_packets;                 // Number of slots in the ring.
+        std::atomic<uint32_t> magic;           // Magic number, written last by the creator.
+        alignas(64) std::atomic<uint64_t> write_index;  // Next slot to write, owned by the producer.
+        alignas(64) std::atomic<uint64_t> read_index;   // Next slot to read, owned by the consumer.
+        alignas(64) std::atomic<uint32_t> eof;          // Producer completed, no more packets after write_index.
+    };
+
+    // One ring slot: one TS packet and its serialized metadata.
+    struct ShmRingSlot
+    {
+        uint8_t packet[PKT_SIZE];
+        uint8_t metadata[TSPacketMetadata::SERIALIZATION_SIZE];
+    };
+
+    // Magic number ("TSSM"), also validates endianness between the two processes.
+    constexpr uint32_t SHM_RING_MAGIC = 0x5453534D;
+    constexpr uint32_t SHM_RING_VERSION = 1;
+
+
+    //------------------------------------------------------------------------
+    // Common part of the input and output plugins: map the segment.
+    //------------------------------------------------------------------------
+
+    class ShmRing
+    {
+        TS_NOCOPY(ShmRing);
+    public:
+        ShmRing() = default;
+        ~ShmRing() { unmap(); }
+
+        // Create the segment (producer) or attach to an existing one (consumer).
+        bool create(const UString& name, size_t ring_packets, Report& report);
+        bool attach(const UString& name, MilliSecond timeout, Report& report);
+
+        // Unmap the segment. With remove, also delete the name (producer).
+        void unmap(bool remove = false);
+
+        // Access to the mapped segment.
+        bool isMapped() const { return _header != nullptr; }
+        ShmRingHeader& header() { return *_header; }
+        ShmRingSlot& slot(uint64_t index) { return _slots[index % _header->ring_packets]; }
+
+    private:
+        UString        _name {};              // Name of the segment, for shm_unlink.
+        void*          _base = nullptr;       // Base address of the mapping.
+        size_t         _size = 0;             // Size in bytes of the mapping.
+        ShmRingHeader* _header = nullptr;
+        ShmRingSlot*   _slots = nullptr;
+    };
+}
+
+
+//----------------------------------------------------------------------------
+// Map the shared memory segment.
+//----------------------------------------------------------------------------
+
+bool ts::ShmRing::create(const UString& name, size_t ring_packets, Report& report)
+{
+#if defined(TS_UNIX)
+    _name = name;
+    _size = sizeof(ShmRingHeader) + ring_packets * sizeof(ShmRingSlot);
+
+    // Create or recreate the segment. An old segment with the same name is replaced.
+    const std::string name8(name.toUTF8());
+    ::shm_unlink(name8.c_str());
+    const int fd = ::shm_open(name8.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+        report.error(u"error creating shared memory segment %s: %s", {name, SysErrorCodeMessage()});
+        return false;
+    }
+    if (::ftruncate(fd, ::off_t(_size)) < 0) {
+        report.error(u"error resizing shared memory segment %s: %s", {name, SysErrorCodeMessage()});
+        ::close(fd);
+        ::shm_unlink(name8.c_str());
+        return false;
+    }
+    _base = ::mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd); // the mapping keeps its own reference
+    if (_base == MAP_FAILED) {
+        report.error(u"error mapping shared memory segment %s: %s", {name, SysErrorCodeMessage()});
+        _base = nullptr;
+        ::shm_unlink(name8.c_str());
+        return false;
+    }
+
+    // Initialize the header. The magic number is written last, with release
+    // semantics, so that a consumer which sees it also sees a complete header.
+    _header = reinterpret_cast<ShmRingHeader*>(_base);
+    _slots = reinterpret_cast<ShmRingSlot*>(_header + 1);
+    _header->version = SHM_RING_VERSION;
+    _header->ring_packets = ring_packets;
+    _header->write_index.store(0);
+    _header->read_index.store(0);
+    _header->eof.store(0);
+    _header->magic.store(SHM_RING_MAGIC, std::memory_order_release);
+    return true;
+#else
+    report.error(u"shared memory plugins are not supported on this system");
+    return false;
+#endif
+}
+
+bool ts::ShmRing::attach(const UString& name, MilliSecond timeout, Report& report)
+{
+#if defined(TS_UNIX)
+    _name = name;
+    const std::string name8(name.toUTF8());
+
+    // The producer may not have created the segment yet, retry during the timeout.
+    int fd = -1;
+    for (MilliSecond remain = timeout; ; remain -= POLL_INTERVAL) {
+        fd = ::shm_open(name8.c_str(), O_RDWR, 0600);
+        if (fd >= 0) {
+            // Check that the segment is fully initialized (see create()).
+            const ::off_t size = ::lseek(fd, 0, SEEK_END);
+            if (size > ::off_t(sizeof(ShmRingHeader))) {
+                void* base = ::mmap(nullptr, size_t(size), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                ::close(fd);
+                if (base == MAP_FAILED) {
+                    report.error(u"error mapping shared memory segment %s: %s", {name, SysErrorCodeMessage()});
+                    return false;
+                }
+                ShmRingHeader* header = reinterpret_cast<ShmRingHeader*>(base);
+                if (header->magic.load(std::memory_order_acquire) == SHM_RING_MAGIC) {
+                    if (header->version != SHM_RING_VERSION) {
+                        report.error(u"incompatible version %d in shared memory segment %s", {header->version, name});
+                        ::munmap(base, size_t(size));
+                        return false;
+                    }
+                    _base = base;
+                    _size = size_t(size);
+                    _header = header;
+                    _slots = reinterpret_cast<ShmRingSlot*>(_header + 1);
+                    return true;
+                }
+                // Not yet initialized, retry.
+                ::munmap(base, size_t(size));
+            }
+            else {
+                ::close(fd);
+            }
+        }
+        if (remain <= 0) {
+            report.error(u"shared memory segment %s not found after %'d milliseconds", {name, timeout});
+            return false;
+        }
+        SleepThread(POLL_INTERVAL);
+    }
+#else
+    report.error(u"shared memory plugins are not supported on this system");
+    return false;
+#endif
+}
+
+void ts::ShmRing::unmap(bool remove)
+{
+#if defined(TS_UNIX)
+    if (_base != nullptr) {
+        ::munmap(_base, _size);
+        _base = nullptr;
+        _header = nullptr;
+        _slots = nullptr;
+    }
+    if (remove && !_name.empty()) {
+        // Only removes the name, an attached consumer keeps its mapping.
+        ::shm_unlink(_name.toUTF8().c_str());
+        _name.clear();
+    }
+#endif
+}
+
+
+//----------------------------------------------------------------------------
+// Output plugin definition (the producer).
+//----------------------------------------------------------------------------
+
+namespace ts {
+    class ShmOutputPlugin: public OutputPlugin
+    {
+        TS_PLUGIN_CONSTRUCTORS(ShmOutputPlugin);
+    public:
+        // Implementation of plugin API
+        virtual bool getOptions() override;
+        virtual bool start() override;
+        virtual bool stop() override;
+        virtual bool isRealTime() override { return true; }
+        virtual bool send(const TSPacket*, const TSPacketMetadata*, size_t) override;
+
+    private:
+        // Command line options:
+        UString _name {};          // Name of the shared memory segment.
+        size_t  _ring_packets = 0; // Number of packets in the ring.
+
+        // Working data:
+        ShmRing _ring {};
+    };
+}
+
+TS_REGISTER_OUTPUT_PLUGIN(u"shm", ts::ShmOutputPlugin);
+
+
+//----------------------------------------------------------------------------
+// Output plugin constructor
+//----------------------------------------------------------------------------
+
+ts::ShmOutputPlugin::ShmOutputPlugin(TSP* tsp_) :
+    OutputPlugin(tsp_, u"Send TS packets to another tsp process through shared memory", u"[options] name")
+{
+    option(u"", 0, STRING, 1, 1);
+    help(u"",
+         u"Name of the shared memory segment. The same name shall be used by the "
+         u"shm input plugin of the receiving tsp process.");
+
+    option(u"packets", 'p', POSITIVE);
+    help(u"packets",
+         u"Number of TS packets in the shared memory ring. When the ring is full, "
+         u"the output plugin waits for the reader. The default is "
+         TS_STRINGIFY(DEFAULT_RING_PACKETS) u" packets.");
+}
+
+
+//----------------------------------------------------------------------------
+// Output plugin methods
+//----------------------------------------------------------------------------
+
+bool ts::ShmOutputPlugin::getOptions()
+{
+    getValue(_name, u"");
+    getIntValue(_ring_packets, u"packets", DEFAULT_RING_PACKETS);
+
+    // POSIX shared memory names must start with a slash.
+    if (!_name.startWith(u"/")) {
+        _name.insert(0, 1, u'/');
+    }
+    return true;
+}
+
+bool ts::ShmOutputPlugin::start()
+{
+    return _ring.create(_name, _ring_packets, *tsp);
+}
+
+bool ts::ShmOutputPlugin::stop()
+{
+    if (_ring.isMapped()) {
+        // Let the consumer drain the remaining packets, then remove the name.
+        _ring.header().eof.store(1, std::memory_order_release);
+        _ring.unmap(true);
+    }
+    return true;
+}
+
+bool ts::ShmOutputPlugin::send(const TSPacket* packets, const TSPacketMetadata* pkt_data, size_t packet_count)
+{
+    ShmRingHeader& hdr(_ring.header());
+    uint64_t windex = hdr.write_index.load(std::memory_order_relaxed);
+
+    for (size_t i = 0; i < packet_count; ++i) {
+        // Wait for a free slot when the ring is full.
+        while (windex - hdr.read_index.load(std::memory_order_acquire) >= hdr.ring_packets) {
+            if (tsp->aborting()) {
+                return false;
+            }
+            SleepThread(POLL_INTERVAL);
+        }
+        // Fill the slot, then publish it.
+        ShmRingSlot& slot(_ring.slot(windex));
+        std::memcpy(slot.packet, packets[i].b, PKT_SIZE);
+        pkt_data[i].serialize(slot.metadata, sizeof(slot.metadata));
+        hdr.write_index.store(++windex, std::memory_order_release);
+    }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Input plugin definition (the consumer).
+//----------------------------------------------------------------------------
+
+namespace ts {
+    class ShmInputPlugin: public InputPlugin
+    {
+        TS_PLUGIN_CONSTRUCTORS(ShmInputPlugin);
+    public:
+        // Implementation of plugin API
+        virtual bool getOptions() override;
+        virtual bool start() override;
+        virtual bool stop() override;
+        virtual bool isRealTime() override { return true; }
+        virtual bool abortInput() override { return true; }
+        virtual size_t receive(TSPacket*, TSPacketMetadata*, size_t) override;
+
+    private:
+        // Command line options:
+        UString     _name {};     // Name of the shared memory segment.
+        MilliSecond _timeout = 0; // Timeout waiting for the segment creation.
+
+        // Working data:
+        ShmRing _ring {};
+    };
+}
+
+TS_REGISTER_INPUT_PLUGIN(u"shm", ts::ShmInputPlugin);
+
+
+//----------------------------------------------------------------------------
+// Input plugin constructor
+//----------------------------------------------------------------------------
+
+ts::ShmInputPlugin::ShmInputPlugin(TSP* tsp_) :
+    InputPlugin(tsp_, u"Receive TS packets from another tsp process through shared memory", u"[options] name")
+{
+    option(u"", 0, STRING, 1, 1);
+    help(u"",
+         u"Name of the shared memory segment, as specified to the shm output plugin "
+         u"of the sending tsp process.");
+
+    option(u"timeout", 't', POSITIVE);
+    help(u"timeout",
+         u"Timeout in milliseconds while waiting for the sending process to create "
+         u"the shared memory segment. The default is 5000 ms.");
+}
+
+
+//----------------------------------------------------------------------------
+// Input plugin methods
+//----------------------------------------------------------------------------
+
+bool ts::ShmInputPlugin::getOptions()
+{
+    getValue(_name, u"");
+    getIntValue(_timeout, u"timeout", 5000);
+
+    // POSIX shared memory names must start with a slash.
+    if (!_name.startWith(u"/")) {
+        _name.insert(0, 1, u'/');
+    }
+    return true;
+}
+
+bool ts::ShmInputPlugin::start()
+{
+    return _ring.attach(_name, _timeout, *tsp);
+}
+
+bool ts::ShmInputPlugin::stop()
+{
+    _ring.unmap();
+    return true;
+}
+
+size_t ts::ShmInputPlugin::receive(TSPacket* buffer, TSPacketMetadata* pkt_data, size_t max_packets)
+{
+    ShmRingHeader& hdr(_ring.header());
+    uint64_t rindex = hdr.read_index.load(std::memory_order_relaxed);
+
+    // Wait for at least one packet.
+    uint64_t avail = 0;
+    while ((avail = hdr.write_index.load(std::memory_order_acquire) - rindex) == 0) {
+        if (hdr.eof.load(std::memory_order_acquire) != 0) {
+            // Producer completed and the ring is drained, end of stream.
+            return 0;
+        }
+        if (tsp->aborting()) {
+            return 0;
+        }
+        SleepThread(POLL_INTERVAL);
+    }
+
+    // Copy as many packets as available, then release the slots.
+    const size_t count = size_t(std::min<uint64_t>(avail, max_packets));
+    for (size_t i = 0; i < count; ++i) {
+        ShmRingSlot& slot(_ring.slot(rindex));
+        std::memcpy(buffer[i].b, slot.packet, PKT_SIZE);
+        pkt_data[i].deserialize(slot.metadata, sizeof(slot.metadata));
+        hdr.read_index.store(++rindex, std::memory_order_release);
+    }
+    return count;
+}
@@ -174,7 +174,7 @@ ts::ProcessorPlugin::Status ts::SlicePlugin::processPacket(TSPacket& pkt, TSPack
 {
     // Feed PCR analyzer if necessary
     if (_use_time && !_ignore_pcr) {
-        _pcr_analyzer.feedPacket(pkt);
+        _pcr_analyzer.feedPacket(pkt, pkt_data);
     }
 
     // Compute current "value" (depends on interpretation);
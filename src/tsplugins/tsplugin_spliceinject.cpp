@@ -741,20 +741,46 @@ void ts::SpliceInjectPlugin::processSectionMessage(const uint8_t* addr, size_t s
         return;
     }
 
-    // Consider the memory as a C++ input stream.
-    std::istringstream strm(std::string(reinterpret_cast<const char*>(addr), size));
-    tsp->debug(u"parsing section:\n%s", {UString::Dump(addr, size, UString::HEXA | UString::ASCII, 4)});
-
-    // Analyze the message as a binary, XML or JSON section file.
-    SectionFile secFile(duck);
-    if (!secFile.load(strm, type)) {
-        // Error loading sections, error message already reported.
-        return;
+    // The hex dump of the message is expensive, build it only when debug is active.
+    if (tsp->debug()) {
+        tsp->debug(u"parsing section:\n%s", {UString::Dump(addr, size, UString::HEXA | UString::ASCII, 4)});
+    }
+
+    // Collect the sections of the message.
+    SectionPtrVector sections;
+    if (type == FType::BINARY) {
+        // Binary messages are the ones which arrive on tight deadlines during
+        // ad-break bursts. Build the sections directly from the message buffer,
+        // without the string copy and stream parsing of SectionFile.
+        const uint8_t* data = addr;
+        size_t remain = size;
+        while (remain > 0) {
+            const size_t sec_size = Section::SectionSize(data, remain);
+            if (sec_size == 0 || sec_size > remain) {
+                tsp->error(u"invalid binary section, %d trailing bytes", {remain});
+                return;
+            }
+            sections.push_back(SectionPtr(new Section(data, sec_size, PID_NULL, CRC32::IGNORE)));
+            data += sec_size;
+            remain -= sec_size;
+        }
+    }
+    else {
+        // Consider the memory as a C++ input stream.
+        std::istringstream strm(std::string(reinterpret_cast<const char*>(addr), size));
+
+        // Analyze the message as an XML or JSON section file.
+        SectionFile secFile(duck);
+        if (!secFile.load(strm, type)) {
+            // Error loading sections, error message already reported.
+            return;
+        }
+        sections = secFile.sections();
     }
 
     // Loop on all sections in the file or message.
     // Each section is expected to be a splice information section.
-    for (auto it = secFile.sections().begin(); it != secFile.sections().end(); ++it) {
+    for (auto it = sections.begin(); it != sections.end(); ++it) {
         SectionPtr sec(*it);
         if (!sec.isNull()) {
             if (sec->tableId() != TID_SCTE35_SIT) {
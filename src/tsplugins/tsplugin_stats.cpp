@@ -48,6 +48,7 @@ namespace ts {
         bool       _csv = false;             // Use CSV format for statistics.
         bool       _header = false;          // Display header lines.
         bool       _multiple_output = false; // Don't rewrite output files with --interval.
+        bool       _quantiles = false;       // Report percentiles of the inter-packet distance.
         UString    _csv_separator {DefaultCsvSeparator}; // Separator character in CSV lines.
         UString    _output_name {};          // Output file name.
         NanoSecond _output_interval = 0;     // Recreate output at this time interval.
@@ -141,6 +142,14 @@ ts::StatsPlugin::StatsPlugin(TSP* tsp_) :
          u"Several -p or --pid options may be specified. "
          u"By default, all PID's are analyzed.");
 
+    option(u"quantiles", 'q');
+    help(u"quantiles",
+         u"Report the 50th, 95th and 99th percentiles of the inter-packet distance "
+         u"of each PID or label. The percentiles are estimated over a bounded random "
+         u"sample of the data (\"reservoir sampling\"). The memory usage remains "
+         u"constant, whatever the duration of the analysis, making the option "
+         u"suitable for very long sessions.");
+
     option(u"separator", 's', STRING);
     help(u"separator", u"string",
          u"Field separator string in CSV output (default: '" + UString(DefaultCsvSeparator) + u"').");
@@ -157,6 +166,7 @@ bool ts::StatsPlugin::getOptions()
     _csv = present(u"csv");
     _header = !present(u"noheader");
     _multiple_output = present(u"multiple-files");
+    _quantiles = present(u"quantiles");
     _output_interval = NanoSecPerSec * intValue<Second>(u"interval", 0);
     getValue(_csv_separator, u"separator", DefaultCsvSeparator);
     getValue(_output_name, u"output-file");
@@ -266,13 +276,22 @@ bool ts::StatsPlugin::produceReport()
                 << "IPD min" << _csv_separator
                 << "IPD max" << _csv_separator
                 << "IPD mean" << _csv_separator
-                << "IPD std dev" << std::endl;
+                << "IPD std dev";
+            if (_quantiles) {
+                out << _csv_separator << "IPD p50"
+                    << _csv_separator << "IPD p95"
+                    << _csv_separator << "IPD p99";
+            }
+            out << std::endl;
         }
         else {
-            out << "          Total nb  ......Inter-packet distance......." << std::endl
+            out << "          Total nb  ......Inter-packet distance......."
+                << (_quantiles ? "  ....IPD percentiles..." : "") << std::endl
                 << name.toJustifiedLeft(6)
-                <<       "  of packets     min     max      mean   std dev" << std::endl
-                << "------  ----------  ------  ------  --------  --------" << std::endl;
+                <<       "  of packets     min     max      mean   std dev"
+                << (_quantiles ? "     p50     p95     p99" : "") << std::endl
+                << "------  ----------  ------  ------  --------  --------"
+                << (_quantiles ? "  ------  ------  ------" : "") << std::endl;
         }
     }
 
@@ -284,8 +303,13 @@ bool ts::StatsPlugin::produceReport()
         const Context& ctx(*(it.second));
 
         if (_log) {
-            tsp->info(u"%s: 0x%X  Total: %8'd  IPD min: %3d  max: %5d  mean: %s  std-dev: %s",
-                      {name, index, ctx.total_pkt, ctx.ipkt.minimum(), ctx.ipkt.maximum(), ctx.ipkt.meanString(7), ctx.ipkt.standardDeviationString(7)});
+            UString line(UString::Format(u"%s: 0x%X  Total: %8'd  IPD min: %3d  max: %5d  mean: %s  std-dev: %s",
+                         {name, index, ctx.total_pkt, ctx.ipkt.minimum(), ctx.ipkt.maximum(), ctx.ipkt.meanString(7), ctx.ipkt.standardDeviationString(7)}));
+            if (_quantiles) {
+                line.append(UString::Format(u"  p50: %3d  p95: %3d  p99: %3d",
+                            {ctx.ipkt.quantile(0.50), ctx.ipkt.quantile(0.95), ctx.ipkt.quantile(0.99)}));
+            }
+            tsp->info(line);
         }
         else if (_csv) {
             out << index << _csv_separator
@@ -293,12 +317,21 @@ bool ts::StatsPlugin::produceReport()
                 << ctx.ipkt.minimum() << _csv_separator
                 << ctx.ipkt.maximum() << _csv_separator
                 << ctx.ipkt.meanString() << _csv_separator
-                << ctx.ipkt.standardDeviationString() << std::endl;
+                << ctx.ipkt.standardDeviationString();
+            if (_quantiles) {
+                out << _csv_separator << ctx.ipkt.quantile(0.50)
+                    << _csv_separator << ctx.ipkt.quantile(0.95)
+                    << _csv_separator << ctx.ipkt.quantile(0.99);
+            }
+            out << std::endl;
         }
         else {
             out << UString::Format(_track_pids ? u"0x%04X" : u"%-6d", {index})
-                << UString::Format(u"  %10'd  %6d  %6d  %s  %s", {ctx.total_pkt, ctx.ipkt.minimum(), ctx.ipkt.maximum(), ctx.ipkt.meanString(8), ctx.ipkt.standardDeviationString(8)})
-                << std::endl;
+                << UString::Format(u"  %10'd  %6d  %6d  %s  %s", {ctx.total_pkt, ctx.ipkt.minimum(), ctx.ipkt.maximum(), ctx.ipkt.meanString(8), ctx.ipkt.standardDeviationString(8)});
+            if (_quantiles) {
+                out << UString::Format(u"  %6d  %6d  %6d", {ctx.ipkt.quantile(0.50), ctx.ipkt.quantile(0.95), ctx.ipkt.quantile(0.99)});
+            }
+            out << std::endl;
         }
     }
 
@@ -372,6 +405,9 @@ ts::StatsPlugin::ContextPtr ts::StatsPlugin::getContext(size_t index)
     else {
         ContextPtr ptr(new Context);
         CheckNonNull(ptr.pointer());
+        if (_quantiles) {
+            ptr->ipkt.enableQuantiles();
+        }
         _ctx_map[index] = ptr;
         return ptr;
     }
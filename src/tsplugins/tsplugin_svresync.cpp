@@ -234,6 +234,7 @@ ts::ProcessorPlugin::Status ts::SVResyncPlugin::processPacket(TSPacket& pkt, TSP
 
             // Replace PCR with extrapolated reference PCR.
             pkt.setPCR(ref_pcr);
+            pkt_data.setPCR(ref_pcr);
             _pcr_adjust_count++;
             _modified_pids.set(pid);
         }
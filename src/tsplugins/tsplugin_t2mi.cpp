@@ -63,6 +63,7 @@ namespace ts {
         virtual void handleT2MINewPID(T2MIDemux& demux, const PMT& pmt, PID pid, const T2MIDescriptor& desc) override;
         virtual void handleT2MIPacket(T2MIDemux& demux, const T2MIPacket& pkt) override;
         virtual void handleTSPacket(T2MIDemux& demux, const T2MIPacket& t2mi, const TSPacket& ts) override;
+        virtual void handleTSPacketBatch(T2MIDemux& demux, const T2MIPacket& t2mi, const TSPacket* ts, size_t ts_count) override;
     };
 }
 
@@ -302,19 +303,30 @@ void ts::T2MIPlugin::handleT2MIPacket(T2MIDemux& demux, const T2MIPacket& pkt)
 
 void ts::T2MIPlugin::handleTSPacket(T2MIDemux& demux, const T2MIPacket& t2mi, const TSPacket& ts)
 {
-    // Keep packet from the filtered PLP only.
+    // All extracted packets are processed in batches.
+    handleTSPacketBatch(demux, t2mi, &ts, 1);
+}
+
+
+//----------------------------------------------------------------------------
+// Process a batch of extracted TS packets from the T2-MI stream.
+//----------------------------------------------------------------------------
+
+void ts::T2MIPlugin::handleTSPacketBatch(T2MIDemux& demux, const T2MIPacket& t2mi, const TSPacket* ts, size_t ts_count)
+{
+    // Keep packets from the filtered PLP only.
     if (_extract && _plp_valid && t2mi.plp() == _plp) {
         if (_replace_ts) {
-            // Enqueue the TS packet for replacement later.
+            // Enqueue the TS packets for replacement later.
             // We do not really care about queue size because an overflow is not possible.
             // This plugin deletes all input packets and replaces them with demux'ed packets.
             // And the number of input TS packets is always higher than the number of output
             // packets because of T2-MI encapsulation and other PID's.
-            _ts_queue.push_back(ts);
+            _ts_queue.insert(_ts_queue.end(), ts, ts + ts_count);
         }
         else {
-            // Write the packet to output file.
-            _abort = _abort || !_outfile.writePackets(&ts, nullptr, 1, *tsp);
+            // Write the packets to the output file in one single operation.
+            _abort = _abort || !_outfile.writePackets(ts, nullptr, ts_count, *tsp);
         }
     }
 }
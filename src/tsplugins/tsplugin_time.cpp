@@ -16,6 +16,7 @@
 #include "tsBinaryTable.h"
 #include "tsEnumeration.h"
 #include "tsTime.h"
+#include "tsCoarseClock.h"
 #include "tsTDT.h"
 
 
@@ -61,8 +62,9 @@ namespace ts {
         // Invoked by the demux when a complete table is available.
         virtual void handleTable(SectionDemux&, const BinaryTable&) override;
 
-        // Get current time.
-        Time currentTime() const { return _use_utc ? Time::CurrentUTC() : Time::CurrentLocalTime(); }
+        // Get current time. This is called once per packet, use the coarse
+        // clock, time events are specified with a one second granularity.
+        Time currentTime() const { return _use_utc ? CoarseClock::CurrentUTC() : CoarseClock::CurrentUTC().UTCToLocal(); }
 
         // Add time events in the list fro one option. Return false if a time string is invalid
         bool addEvents(const UChar* option, Status status);
@@ -51,6 +51,14 @@ TS_REGISTER_PROCESSOR_PLUGIN(u"timeshift", ts::TimeShiftPlugin);
 ts::TimeShiftPlugin::TimeShiftPlugin (TSP* tsp_) :
     ProcessorPlugin(tsp_, u"Delay transmission by a fixed amount of packets", u"[options]")
 {
+    option(u"async-io", 'a');
+    help(u"async-io",
+         u"Perform the disk I/O of the buffer file in a background thread, "
+         u"with read-ahead and write-behind of the buffer content. "
+         u"This is useful on slow disks when the buffer is much larger than the memory cache: "
+         u"the plugin no longer periodically blocks on disk accesses. "
+         u"This option is ignored when the buffer is entirely resident in memory.");
+
     option(u"directory", 0, DIRECTORY);
     help(u"directory",
          u"Specify a directory where the temporary buffer file is created. "
@@ -97,6 +105,7 @@ bool ts::TimeShiftPlugin::getOptions()
     const size_t packets = intValue<size_t>(u"packets", 0);
     _buffer.setBackupDirectory(value(u"directory"));
     _buffer.setMemoryPackets(intValue<size_t>(u"memory-packets", TimeShiftBuffer::DEFAULT_MEMORY_PACKETS));
+    _buffer.setAsynchronousIO(present(u"async-io"));
 
     if ((packets > 0 && _time_shift_ms > 0) || (packets == 0 && _time_shift_ms == 0)) {
         tsp->error(u"specify exactly one of --packets and --time for time-shift buffer sizing");
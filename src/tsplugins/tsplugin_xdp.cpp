@@ -0,0 +1,647 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  Transport stream processor shared library:
+//  AF_XDP (kernel bypass) network input, Linux only.
+//
+//  The plugin binds an AF_XDP socket on one receive queue of a network
+//  interface. The frames are exchanged with the kernel driver through
+//  memory-mapped rings over a shared packet buffer area (the "UMEM"),
+//  without per-packet system call. Ethernet, IPv4 and UDP headers are
+//  decapsulated in user space.
+//
+//  A minimal XDP program, redirecting the frames of the receive queue to
+//  the socket, is assembled and loaded using raw bpf(2) system calls so
+//  that no external BPF library is required.
+//
+//----------------------------------------------------------------------------
+
+#include "tsAbstractDatagramInputPlugin.h"
+#include "tsPluginRepository.h"
+#include "tsIPv4Packet.h"
+#include "tsIPProtocols.h"
+
+#if defined(TS_LINUX) && !defined(TS_NO_XDP)
+
+#include <sys/socket.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/if_xdp.h>
+#include <linux/bpf.h>
+#include <net/if.h>
+#include <poll.h>
+#include <unistd.h>
+
+
+//----------------------------------------------------------------------------
+// Plugin definition
+//----------------------------------------------------------------------------
+
+namespace ts {
+    class XDPInputPlugin: public AbstractDatagramInputPlugin
+    {
+        TS_PLUGIN_CONSTRUCTORS(XDPInputPlugin);
+    public:
+        // Implementation of plugin API
+        virtual bool getOptions() override;
+        virtual bool start() override;
+        virtual bool stop() override;
+        virtual bool abortInput() override;
+
+    protected:
+        // Implementation of AbstractDatagramInputPlugin.
+        virtual bool receiveDatagram(uint8_t* buffer, size_t buffer_size, size_t& ret_size, MicroSecond& timestamp, TimeSource& timestamp_source, TSPacketLabelSet& labels) override;
+
+    private:
+        // Each UMEM frame holds one Ethernet frame. The chunk size must be a
+        // power of two, between 2048 and the page size.
+        static constexpr size_t FRAME_SIZE = 4096;
+
+        // A memory-mapped AF_XDP ring (fill ring or RX ring).
+        class XDPRing
+        {
+        public:
+            XDPRing() = default;
+            volatile uint32_t* producer = nullptr;  // shared with the kernel.
+            volatile uint32_t* consumer = nullptr;  // shared with the kernel.
+            volatile uint32_t* flags = nullptr;     // XDP_RING_NEED_WAKEUP.
+            void*     desc = nullptr;               // descriptor array.
+            uint32_t  entries = 0;                  // number of descriptors, a power of two.
+            bool map(int fd, uint64_t pgoff, const ::xdp_ring_offset& off, uint32_t count, size_t desc_size, Report& report);
+            void unmap();
+        private:
+            void*  _mem = MAP_FAILED;
+            size_t _mem_size = 0;
+        };
+
+        // Command line options:
+        UString           _iface_name {};       // Network interface name.
+        uint32_t          _queue = 0;           // Receive queue index on the interface.
+        IPv4SocketAddress _destination {};      // Optional destination filter.
+        size_t            _frames = 0;          // Number of UMEM frames.
+        bool              _busy_wait = false;   // Poll the RX ring without sleeping.
+        bool              _force_zcopy = false; // Require zero-copy mode.
+        bool              _force_copy = false;  // Require copy mode.
+        bool              _no_program = false;  // Do not load the builtin XDP program.
+
+        // Working data:
+        int        _xsk_fd = -1;                // AF_XDP socket.
+        int        _map_fd = -1;                // BPF map of type XSKMAP.
+        int        _prog_fd = -1;               // XDP redirect program.
+        int        _link_fd = -1;               // BPF link attaching the program to the interface.
+        uint8_t*   _umem = nullptr;             // Shared packet buffer area.
+        size_t     _umem_size = 0;
+        XDPRing    _fill {};                    // Frames which are given to the kernel.
+        XDPRing    _rx {};                      // Frames which were received by the kernel.
+        uint32_t   _rx_cons = 0;                // Cached consumer index on the RX ring.
+        uint32_t   _fill_prod = 0;              // Cached producer index on the fill ring.
+        std::vector<uint64_t> _recycle {};      // Frame addresses to give back to the fill ring.
+
+        // Release all kernel resources.
+        void cleanup();
+
+        // Load and attach the builtin XDP redirect program.
+        bool loadProgram();
+
+        // Give back the recycled frames to the fill ring, wake up the driver when needed.
+        void refillRing();
+
+        // Locate the UDP payload in an Ethernet frame. Return false if the
+        // frame is not a matching IPv4/UDP packet.
+        bool decapsulate(const uint8_t* frame, size_t size, const uint8_t*& payload, size_t& payload_size);
+
+        // A wrapper around the bpf(2) system call.
+        static long BPFCall(int cmd, ::bpf_attr* attr) { return ::syscall(SYS_bpf, cmd, attr, sizeof(*attr)); }
+    };
+}
+
+TS_REGISTER_INPUT_PLUGIN(u"xdp", ts::XDPInputPlugin);
+
+
+//----------------------------------------------------------------------------
+// Input constructor
+//----------------------------------------------------------------------------
+
+ts::XDPInputPlugin::XDPInputPlugin(TSP* tsp_) :
+    AbstractDatagramInputPlugin(tsp_, 512 * PKT_SIZE,
+                                u"Receive TS packets from the network using an AF_XDP socket (Linux only)", u"[options] interface-name",
+                                UString(), UString(),
+                                true) // real-time network reception
+{
+    option(u"", 0, STRING, 1, 1);
+    help(u"",
+         u"Name of the network interface to receive from (eg. eth0). "
+         u"All frames of one receive queue of this interface are redirected to this plugin and "
+         u"bypass the kernel network stack. Use the flow steering rules of the network adapter "
+         u"(eg. 'ethtool --config-ntuple') to direct the multicast streams to that queue.");
+
+    option(u"queue", 'q', UINT32);
+    help(u"queue",
+         u"Index of the receive queue to bind to on the interface. "
+         u"The default is queue 0.");
+
+    option(u"destination", 'd', STRING);
+    help(u"destination", u"address[:port]",
+         u"Filter UDP datagrams based on the specified destination socket address. "
+         u"Non-matching frames are dropped. By default, all UDP datagrams which are "
+         u"received on the queue are used.");
+
+    option(u"frames", 'f', POSITIVE);
+    help(u"frames",
+         u"Number of frames in the shared packet buffer area (the XDP \"UMEM\"). "
+         u"Each frame is " + UString::Decimal(FRAME_SIZE) + u" bytes and holds one datagram. "
+         u"The value is rounded up to a power of two. The default is 4096 frames.");
+
+    option(u"busy-wait");
+    help(u"busy-wait",
+         u"Do not sleep when the receive ring is empty, keep polling it from user space. "
+         u"This eliminates the wakeup latency at the expense of burning one CPU core. "
+         u"Dedicate a core to this plugin thread when using this option.");
+
+    option(u"zero-copy");
+    help(u"zero-copy",
+         u"Force zero-copy mode, where the network adapter writes the frames directly "
+         u"into the shared packet buffer area. Fail if the driver does not support it. "
+         u"By default, zero-copy is attempted first with a fallback on copy mode.");
+
+    option(u"copy");
+    help(u"copy",
+         u"Force copy mode, where the kernel copies each frame into the shared packet "
+         u"buffer area. This works with all drivers, at a higher CPU cost.");
+
+    option(u"no-program");
+    help(u"no-program",
+         u"Do not load the builtin XDP redirect program on the interface. "
+         u"Another XDP program, which redirects the frames of the receive queue to "
+         u"this AF_XDP socket, must have been attached by other means.");
+}
+
+
+//----------------------------------------------------------------------------
+// Input command line options method
+//----------------------------------------------------------------------------
+
+bool ts::XDPInputPlugin::getOptions()
+{
+    getValue(_iface_name, u"");
+    getIntValue(_queue, u"queue", 0);
+    getIntValue(_frames, u"frames", 4096);
+    _busy_wait = present(u"busy-wait");
+    _force_zcopy = present(u"zero-copy");
+    _force_copy = present(u"copy");
+    _no_program = present(u"no-program");
+
+    if (_force_zcopy && _force_copy) {
+        tsp->error(u"--zero-copy and --copy are mutually exclusive");
+        return false;
+    }
+
+    // Optional destination filter.
+    _destination.clear();
+    const UString dest(value(u"destination"));
+    if (!dest.empty() && !_destination.resolve(dest, *tsp)) {
+        return false;
+    }
+
+    // The ring sizes must be powers of two.
+    size_t pow2 = 1;
+    while (pow2 < _frames) {
+        pow2 <<= 1;
+    }
+    if (pow2 != _frames) {
+        tsp->verbose(u"rounding --frames up to %'d", {pow2});
+        _frames = pow2;
+    }
+
+    return AbstractDatagramInputPlugin::getOptions();
+}
+
+
+//----------------------------------------------------------------------------
+// Map one AF_XDP ring in the process address space.
+//----------------------------------------------------------------------------
+
+bool ts::XDPInputPlugin::XDPRing::map(int fd, uint64_t pgoff, const ::xdp_ring_offset& off, uint32_t count, size_t desc_size, Report& report)
+{
+    _mem_size = size_t(off.desc) + count * desc_size;
+    _mem = ::mmap(nullptr, _mem_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, off_t(pgoff));
+    if (_mem == MAP_FAILED) {
+        report.error(u"error mapping AF_XDP ring: %s", {SysErrorCodeMessage()});
+        return false;
+    }
+    uint8_t* const base = reinterpret_cast<uint8_t*>(_mem);
+    producer = reinterpret_cast<volatile uint32_t*>(base + off.producer);
+    consumer = reinterpret_cast<volatile uint32_t*>(base + off.consumer);
+    flags = reinterpret_cast<volatile uint32_t*>(base + off.flags);
+    desc = base + off.desc;
+    entries = count;
+    return true;
+}
+
+void ts::XDPInputPlugin::XDPRing::unmap()
+{
+    if (_mem != MAP_FAILED) {
+        ::munmap(_mem, _mem_size);
+        _mem = MAP_FAILED;
+    }
+    producer = consumer = flags = nullptr;
+    desc = nullptr;
+    entries = 0;
+}
+
+
+//----------------------------------------------------------------------------
+// Load and attach the builtin XDP redirect program.
+//----------------------------------------------------------------------------
+
+bool ts::XDPInputPlugin::loadProgram()
+{
+    // Create the XSKMAP, mapping a queue index to an AF_XDP socket.
+    ::bpf_attr attr;
+    TS_ZERO(attr);
+    attr.map_type = BPF_MAP_TYPE_XSKMAP;
+    attr.key_size = 4;
+    attr.value_size = 4;
+    attr.max_entries = _queue + 1;
+    if ((_map_fd = int(BPFCall(BPF_MAP_CREATE, &attr))) < 0) {
+        tsp->error(u"error creating BPF map: %s", {SysErrorCodeMessage()});
+        return false;
+    }
+
+    // Register our socket for our queue index.
+    const uint32_t key = _queue;
+    const uint32_t value = uint32_t(_xsk_fd);
+    TS_ZERO(attr);
+    attr.map_fd = uint32_t(_map_fd);
+    attr.key = uint64_t(reinterpret_cast<uintptr_t>(&key));
+    attr.value = uint64_t(reinterpret_cast<uintptr_t>(&value));
+    if (BPFCall(BPF_MAP_UPDATE_ELEM, &attr) < 0) {
+        tsp->error(u"error updating BPF map: %s", {SysErrorCodeMessage()});
+        return false;
+    }
+
+    // The XDP program, hand-assembled:
+    //   r2 = ((struct xdp_md*)r1)->rx_queue_index
+    //   r1 = the XSKMAP (ld_imm64 of the map file descriptor)
+    //   r3 = XDP_PASS (default action when the queue is not in the map)
+    //   return bpf_redirect_map(r1, r2, r3)
+    const ::bpf_insn insns[] = {
+        {BPF_LDX | BPF_MEM | BPF_W, 2, 1, int16_t(offsetof(::xdp_md, rx_queue_index)), 0},
+        {BPF_LD | BPF_DW | BPF_IMM, 1, BPF_PSEUDO_MAP_FD, 0, _map_fd},
+        {0, 0, 0, 0, 0},
+        {BPF_ALU64 | BPF_MOV | BPF_K, 3, 0, 0, XDP_PASS},
+        {BPF_JMP | BPF_CALL, 0, 0, 0, BPF_FUNC_redirect_map},
+        {BPF_JMP | BPF_EXIT, 0, 0, 0, 0},
+    };
+    static const char license[] = "Dual BSD/GPL";
+    TS_ZERO(attr);
+    attr.prog_type = BPF_PROG_TYPE_XDP;
+    attr.insn_cnt = uint32_t(sizeof(insns) / sizeof(insns[0]));
+    attr.insns = uint64_t(reinterpret_cast<uintptr_t>(insns));
+    attr.license = uint64_t(reinterpret_cast<uintptr_t>(license));
+    if ((_prog_fd = int(BPFCall(BPF_PROG_LOAD, &attr))) < 0) {
+        tsp->error(u"error loading XDP program: %s", {SysErrorCodeMessage()});
+        return false;
+    }
+
+    // Attach the program to the interface.
+    TS_ZERO(attr);
+    attr.link_create.prog_fd = uint32_t(_prog_fd);
+    attr.link_create.target_ifindex = uint32_t(::if_nametoindex(_iface_name.toUTF8().c_str()));
+    attr.link_create.attach_type = BPF_XDP;
+    if ((_link_fd = int(BPFCall(BPF_LINK_CREATE, &attr))) < 0) {
+        tsp->error(u"error attaching XDP program to %s: %s", {_iface_name, SysErrorCodeMessage()});
+        return false;
+    }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Input start method
+//----------------------------------------------------------------------------
+
+bool ts::XDPInputPlugin::start()
+{
+    if (_xsk_fd >= 0) {
+        tsp->error(u"already started");
+        return false;
+    }
+
+    // Resolve the interface name.
+    const unsigned int ifindex = ::if_nametoindex(_iface_name.toUTF8().c_str());
+    if (ifindex == 0) {
+        tsp->error(u"unknown network interface %s", {_iface_name});
+        return false;
+    }
+
+    // Create the AF_XDP socket.
+    if ((_xsk_fd = ::socket(AF_XDP, SOCK_RAW, 0)) < 0) {
+        tsp->error(u"error creating AF_XDP socket: %s", {SysErrorCodeMessage()});
+        return false;
+    }
+
+    // Allocate and register the UMEM, the packet buffer area which is shared
+    // with the kernel (and with the network adapter in zero-copy mode).
+    _umem_size = _frames * FRAME_SIZE;
+    _umem = reinterpret_cast<uint8_t*>(::mmap(nullptr, _umem_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+    if (_umem == MAP_FAILED) {
+        tsp->error(u"error allocating %'d bytes of packet buffer: %s", {_umem_size, SysErrorCodeMessage()});
+        _umem = nullptr;
+        cleanup();
+        return false;
+    }
+    ::xdp_umem_reg ureg;
+    TS_ZERO(ureg);
+    ureg.addr = uint64_t(reinterpret_cast<uintptr_t>(_umem));
+    ureg.len = _umem_size;
+    ureg.chunk_size = FRAME_SIZE;
+    if (::setsockopt(_xsk_fd, SOL_XDP, XDP_UMEM_REG, &ureg, sizeof(ureg)) < 0) {
+        tsp->error(u"error registering packet buffer: %s", {SysErrorCodeMessage()});
+        cleanup();
+        return false;
+    }
+
+    // Declare the ring sizes. The completion ring is unused (no transmission)
+    // but some kernels require it.
+    const uint32_t fill_count = uint32_t(_frames);
+    const uint32_t rx_count = uint32_t(_frames / 2);
+    const uint32_t comp_count = 8;
+    if (::setsockopt(_xsk_fd, SOL_XDP, XDP_UMEM_FILL_RING, &fill_count, sizeof(fill_count)) < 0 ||
+        ::setsockopt(_xsk_fd, SOL_XDP, XDP_UMEM_COMPLETION_RING, &comp_count, sizeof(comp_count)) < 0 ||
+        ::setsockopt(_xsk_fd, SOL_XDP, XDP_RX_RING, &rx_count, sizeof(rx_count)) < 0)
+    {
+        tsp->error(u"error setting AF_XDP ring sizes: %s", {SysErrorCodeMessage()});
+        cleanup();
+        return false;
+    }
+
+    // Map the fill and RX rings in our address space.
+    ::xdp_mmap_offsets off;
+    TS_ZERO(off);
+    ::socklen_t optlen = sizeof(off);
+    if (::getsockopt(_xsk_fd, SOL_XDP, XDP_MMAP_OFFSETS, &off, &optlen) < 0) {
+        tsp->error(u"error getting AF_XDP ring layout: %s", {SysErrorCodeMessage()});
+        cleanup();
+        return false;
+    }
+    if (!_fill.map(_xsk_fd, XDP_UMEM_PGOFF_FILL_RING, off.fr, fill_count, sizeof(uint64_t), *tsp) ||
+        !_rx.map(_xsk_fd, XDP_PGOFF_RX_RING, off.rx, rx_count, sizeof(::xdp_desc), *tsp))
+    {
+        cleanup();
+        return false;
+    }
+
+    // Give all frames to the kernel through the fill ring.
+    uint64_t* const fdesc = reinterpret_cast<uint64_t*>(_fill.desc);
+    for (size_t i = 0; i < _frames; ++i) {
+        fdesc[i] = i * FRAME_SIZE;
+    }
+    _fill_prod = uint32_t(_frames);
+    __atomic_store_n(_fill.producer, _fill_prod, __ATOMIC_RELEASE);
+    _rx_cons = 0;
+    _recycle.clear();
+    _recycle.reserve(_frames);
+
+    // Bind to the interface queue. Try zero-copy first unless a mode is forced.
+    ::sockaddr_xdp sxdp;
+    TS_ZERO(sxdp);
+    sxdp.sxdp_family = AF_XDP;
+    sxdp.sxdp_ifindex = ifindex;
+    sxdp.sxdp_queue_id = _queue;
+    sxdp.sxdp_flags = XDP_USE_NEED_WAKEUP | (_force_copy ? XDP_COPY : XDP_ZEROCOPY);
+    if (::bind(_xsk_fd, reinterpret_cast<::sockaddr*>(&sxdp), sizeof(sxdp)) < 0) {
+        if (_force_zcopy || _force_copy) {
+            tsp->error(u"error binding AF_XDP socket to %s queue %d: %s", {_iface_name, _queue, SysErrorCodeMessage()});
+            cleanup();
+            return false;
+        }
+        // Fall back on copy mode, supported by all drivers.
+        sxdp.sxdp_flags = XDP_USE_NEED_WAKEUP | XDP_COPY;
+        if (::bind(_xsk_fd, reinterpret_cast<::sockaddr*>(&sxdp), sizeof(sxdp)) < 0) {
+            tsp->error(u"error binding AF_XDP socket to %s queue %d: %s", {_iface_name, _queue, SysErrorCodeMessage()});
+            cleanup();
+            return false;
+        }
+        tsp->verbose(u"zero-copy not supported by the driver of %s, using copy mode", {_iface_name});
+    }
+    else if (!_force_copy) {
+        tsp->verbose(u"using zero-copy mode on %s queue %d", {_iface_name, _queue});
+    }
+
+    // Load and attach the redirect program, unless one is attached externally.
+    if (!_no_program && !loadProgram()) {
+        cleanup();
+        return false;
+    }
+
+    return AbstractDatagramInputPlugin::start();
+}
+
+
+//----------------------------------------------------------------------------
+// Input stop method
+//----------------------------------------------------------------------------
+
+bool ts::XDPInputPlugin::stop()
+{
+    // Report the kernel-side drop counters before closing.
+    ::xdp_statistics stats;
+    TS_ZERO(stats);
+    ::socklen_t optlen = sizeof(stats);
+    if (_xsk_fd >= 0 && ::getsockopt(_xsk_fd, SOL_XDP, XDP_STATISTICS, &stats, &optlen) == 0) {
+        if (stats.rx_dropped != 0 || stats.rx_ring_full != 0 || stats.rx_fill_ring_empty_descs != 0) {
+            tsp->verbose(u"AF_XDP drops: %'d dropped, %'d on full RX ring, %'d on empty fill ring",
+                         {stats.rx_dropped, stats.rx_ring_full, stats.rx_fill_ring_empty_descs});
+        }
+    }
+    cleanup();
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Input abort method
+//----------------------------------------------------------------------------
+
+bool ts::XDPInputPlugin::abortInput()
+{
+    // The receive loop polls tsp->aborting(), nothing to unblock here.
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Release all kernel resources.
+//----------------------------------------------------------------------------
+
+void ts::XDPInputPlugin::cleanup()
+{
+    // Closing the link detaches the XDP program from the interface.
+    for (int* fd : {&_link_fd, &_prog_fd, &_map_fd}) {
+        if (*fd >= 0) {
+            ::close(*fd);
+            *fd = -1;
+        }
+    }
+    _fill.unmap();
+    _rx.unmap();
+    if (_xsk_fd >= 0) {
+        ::close(_xsk_fd);
+        _xsk_fd = -1;
+    }
+    if (_umem != nullptr) {
+        ::munmap(_umem, _umem_size);
+        _umem = nullptr;
+    }
+    _recycle.clear();
+}
+
+
+//----------------------------------------------------------------------------
+// Give back the recycled frames to the fill ring.
+//----------------------------------------------------------------------------
+
+void ts::XDPInputPlugin::refillRing()
+{
+    if (!_recycle.empty()) {
+        uint64_t* const fdesc = reinterpret_cast<uint64_t*>(_fill.desc);
+        const uint32_t mask = _fill.entries - 1;
+        size_t avail = _fill.entries - (_fill_prod - __atomic_load_n(_fill.consumer, __ATOMIC_ACQUIRE));
+        while (avail > 0 && !_recycle.empty()) {
+            fdesc[_fill_prod & mask] = _recycle.back();
+            _recycle.pop_back();
+            _fill_prod++;
+            avail--;
+        }
+        __atomic_store_n(_fill.producer, _fill_prod, __ATOMIC_RELEASE);
+    }
+    // In need-wakeup mode, tell the driver that the fill ring was replenished.
+    if ((*_fill.flags & XDP_RING_NEED_WAKEUP) != 0) {
+        ::recvfrom(_xsk_fd, nullptr, 0, MSG_DONTWAIT, nullptr, nullptr);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Locate the UDP payload in an Ethernet frame.
+//----------------------------------------------------------------------------
+
+bool ts::XDPInputPlugin::decapsulate(const uint8_t* frame, size_t size, const uint8_t*& payload, size_t& payload_size)
+{
+    // Ethernet header, with optional 802.1Q VLAN tags.
+    if (size < ETHER_HEADER_SIZE) {
+        return false;
+    }
+    uint16_t ether_type = GetUInt16(frame + ETHER_TYPE_OFFSET);
+    size_t header_size = ETHER_HEADER_SIZE;
+    while (ether_type == ETHERTYPE_802_1Q && size >= header_size + 4) {
+        ether_type = GetUInt16(frame + header_size + 2);
+        header_size += 4;
+    }
+    if (ether_type != ETHERTYPE_IPv4) {
+        return false;
+    }
+
+    // IPv4 and UDP headers.
+    IPv4Packet ip;
+    if (!ip.reset(frame + header_size, size - header_size) || !ip.isUDP()) {
+        return false;
+    }
+    if (_destination.hasAddress() || _destination.hasPort()) {
+        const IPv4SocketAddress dst(ip.destinationSocketAddress());
+        if (!_destination.match(dst)) {
+            return false;
+        }
+    }
+    payload = ip.protocolData();
+    payload_size = ip.protocolDataSize();
+    return payload_size > 0;
+}
+
+
+//----------------------------------------------------------------------------
+// Datagram reception method.
+//----------------------------------------------------------------------------
+
+bool ts::XDPInputPlugin::receiveDatagram(uint8_t* buffer, size_t buffer_size, size_t& ret_size, MicroSecond& timestamp, TimeSource& timestamp_source, TSPacketLabelSet& labels)
+{
+    // There is no kernel time stamp on AF_XDP frames.
+    timestamp = -1;
+    ret_size = 0;
+
+    const ::xdp_desc* const rdesc = reinterpret_cast<const ::xdp_desc*>(_rx.desc);
+    const uint32_t mask = _rx.entries - 1;
+
+    for (;;) {
+        // Replenish the fill ring with the frames which were consumed so far.
+        refillRing();
+
+        // Wait for received frames.
+        uint32_t prod = __atomic_load_n(_rx.producer, __ATOMIC_ACQUIRE);
+        while (prod == _rx_cons) {
+            if (tsp->aborting()) {
+                return false;
+            }
+            if (!_busy_wait) {
+                ::pollfd pfd;
+                pfd.fd = _xsk_fd;
+                pfd.events = POLLIN;
+                pfd.revents = 0;
+                ::poll(&pfd, 1, 100);
+            }
+            else if ((*_fill.flags & XDP_RING_NEED_WAKEUP) != 0) {
+                ::recvfrom(_xsk_fd, nullptr, 0, MSG_DONTWAIT, nullptr, nullptr);
+            }
+            prod = __atomic_load_n(_rx.producer, __ATOMIC_ACQUIRE);
+        }
+
+        // Consume the received frames, without system call. Multiple datagrams
+        // with an integral number of TS packets are batched in the buffer.
+        // Datagrams with an extra encapsulation (RTP) are delivered one by one
+        // because the superclass locates the TS packets per datagram.
+        while (_rx_cons != prod) {
+            const ::xdp_desc& d(rdesc[_rx_cons & mask]);
+            const uint8_t* payload = nullptr;
+            size_t payload_size = 0;
+            if (decapsulate(_umem + d.addr, d.len, payload, payload_size)) {
+                const bool aligned = payload_size % PKT_SIZE == 0 && payload[0] == SYNC_BYTE;
+                if (ret_size == 0) {
+                    // First matching datagram, always deliver it.
+                    const size_t size = std::min(payload_size, buffer_size);
+                    std::memcpy(buffer, payload, size);
+                    ret_size = size;
+                    if (!aligned || payload_size > buffer_size) {
+                        // Cannot batch more datagrams after this one.
+                        _recycle.push_back(d.addr);
+                        _rx_cons++;
+                        break;
+                    }
+                }
+                else if (aligned && ret_size % PKT_SIZE == 0 && payload_size <= buffer_size - ret_size) {
+                    std::memcpy(buffer + ret_size, payload, payload_size);
+                    ret_size += payload_size;
+                }
+                else {
+                    // Does not fit or not aligned, keep the frame for the next call.
+                    break;
+                }
+            }
+            _recycle.push_back(d.addr);
+            _rx_cons++;
+        }
+        __atomic_store_n(_rx.consumer, _rx_cons, __ATOMIC_RELEASE);
+
+        // Loop until at least one matching datagram was received.
+        if (ret_size > 0) {
+            return true;
+        }
+    }
+}
+
+#endif // TS_LINUX && !TS_NO_XDP
@@ -12,6 +12,8 @@
 //----------------------------------------------------------------------------
 
 #include "tsPluginRepository.h"
+#include "tsChannelFile.h"
+#include "tsNullReport.h"
 #include "tsSectionDemux.h"
 #include "tsCyclingPacketizer.h"
 #include "tsEITProcessor.h"
@@ -51,6 +53,7 @@ namespace ts {
             // Working data:
             uint16_t          service_id = 0;      // Service id.
             bool              id_known = false;    // Service id is known.
+            bool              unconfirmed_id = false;  // Service id was preloaded from a channel file, not yet seen in live SI.
             CyclingPacketizer pzer_pmt;            // Packetizer for modified PMT.
             std::set<PID>     pids {};             // Set of component PID's.
             PID               pmt_pid = PID_NULL;  // PID for the PMT (PID _NULL if unknown).
@@ -75,6 +78,7 @@ namespace ts {
 
         // Plugin command line options:
         ServiceContextVector _services {};             // Description of services.
+        UString              _channel_file {};         // Channel configuration file to preload service ids.
         UStringVector        _audio_langs {};          // Audio language codes to keep
         std::set<PID>        _audio_pids {};           // Audio PID's to keep
         UStringVector        _subtitles_langs {};      // Subtitles language codes to keep
@@ -172,6 +176,15 @@ ts::ZapPlugin::ZapPlugin(TSP* tsp_) :
          u"Remove them by default. "
          u"Note that the ECM's for the specified services are always kept.");
 
+    option(u"channel-file", 0, FILENAME);
+    help(u"channel-file", u"name",
+         u"Preload the service ids from the specified channel configuration file. "
+         u"Services which are specified by name are resolved from this file, without "
+         u"waiting for the SDT or VCT from the stream, and the filtering starts right "
+         u"after the first PAT. The SI from the stream are still monitored and take "
+         u"precedence when they disagree with the channel configuration file. "
+         u"If the file name is \"-\", use the default channel configuration file.");
+
     option(u"eit");
     help(u"eit",
         u"Keep EIT sections for the specified services. "
@@ -233,6 +246,11 @@ bool ts::ZapPlugin::getOptions()
         _services[i] = new ServiceContext(duck, value(u"", u"", i));
     }
 
+    getValue(_channel_file, u"channel-file");
+    if (_channel_file == u"-") {
+        _channel_file = ChannelFile::DefaultFileName();
+    }
+
     getValues(_audio_langs, u"audio");
     getIntValues(_audio_pids, u"audio-pid");
     getValues(_subtitles_langs, u"subtitles");
@@ -278,16 +296,36 @@ bool ts::ZapPlugin::start()
     _eit_process.reset();
     _eit_process.removeOther();
 
+    // Preload the channel database when a channel configuration file is specified.
+    ChannelFile channels;
+    const bool use_channels = !_channel_file.empty() && channels.load(_channel_file, *tsp);
+
     // Initialize service descriptions.
     bool all_ids_known = true;
+    bool any_by_name = false;
     for (size_t i = 0; i < _services.size(); ++i) {
         ServiceContext& ctx(*_services[i]);
         ctx.id_known = ctx.spec_by_id;
+        ctx.unconfirmed_id = false;
         ctx.pzer_pmt.reset();
         ctx.pids.clear();
         ctx.pmt_pid = PID_NULL;
+        any_by_name = any_by_name || !ctx.spec_by_id;
+        if (!ctx.id_known && use_channels) {
+            // Try to resolve the service name from the channel database.
+            // The live SDT or VCT will later correct the service id if it changed.
+            ChannelFile::NetworkPtr net;
+            ChannelFile::TransportStreamPtr tstream;
+            ChannelFile::ServicePtr srv;
+            if (channels.searchService(net, tstream, srv, ctx.service_spec, false, NULLREP)) {
+                ctx.service_id = srv->id;
+                ctx.id_known = true;
+                ctx.unconfirmed_id = true;
+                tsp->verbose(u"service \"%s\" has id 0x%X (%<d) in %s", {ctx.service_spec, srv->id, channels.fileDescription()});
+            }
+        }
         all_ids_known = all_ids_known && ctx.id_known;
-        if (ctx.spec_by_id && _include_eit) {
+        if (ctx.id_known && _include_eit) {
             _eit_process.keepService(ctx.service_id);
         }
     }
@@ -305,9 +343,11 @@ bool ts::ZapPlugin::start()
         // how to modify the PAT. We will handle it after receiving the DVB-SDT or ATSC-VCT.
         _demux.addPID(PID_PAT);
     }
-    else {
+    if (any_by_name) {
         // Handle the ATSC-VCT only when a service is specified by name.
         // We won't modify the VCT, so there is no need to get them if all service ids are known.
+        // When ids were preloaded from the channel database, the VCT is still monitored since
+        // the live tables take precedence over the possibly outdated database.
         _demux.addPID(PID_PSIP);
     }
 
@@ -541,8 +581,15 @@ void ts::ZapPlugin::handlePAT(PAT& pat)
             // Service id is known, locate it in the PAT.
             const auto it(pat.pmts.find(ctx.service_id));
             if (it == pat.pmts.end()) {
-                // Service not found in PAT.
-                serviceNotPresent(ctx, u"PAT");
+                if (ctx.unconfirmed_id) {
+                    // The service id was preloaded from a possibly outdated channel database.
+                    // Do not treat its absence as an error, wait for the SDT or VCT to resolve the name.
+                    tsp->verbose(u"service id 0x%X (%<d) for %s not found in PAT, waiting for the SDT or VCT", {ctx.service_id, ctx.service_spec});
+                }
+                else {
+                    // Service not found in PAT.
+                    serviceNotPresent(ctx, u"PAT");
+                }
             }
             else if (ctx.pmt_pid != it->second) {
                 // Service found with a new PMT PID.
@@ -551,6 +598,7 @@ void ts::ZapPlugin::handlePAT(PAT& pat)
                     forgetServiceComponents(ctx);
                 }
                 // Need to process the PMT on that PID.
+                ctx.unconfirmed_id = false;
                 ctx.pmt_pid = it->second;
                 _demux.addPID(ctx.pmt_pid);
                 tsp->verbose(u"found service id 0x%X, PMT PID is 0x%X", {ctx.service_id,ctx.pmt_pid});
@@ -577,6 +625,7 @@ void ts::ZapPlugin::handleSDT(SDT& sdt)
             uint16_t service_id = 0;
             if (sdt.findService(duck, ctx.service_spec, service_id)) {
                 setServiceId(ctx, service_id);
+                ctx.unconfirmed_id = false;
             }
             else {
                 serviceNotPresent(ctx, u"SDT");
@@ -628,6 +677,7 @@ void ts::ZapPlugin::handleVCT(VCT& vct)
             const auto it(vct.findService(ctx.service_spec));
             if (it != vct.channels.end()) {
                 setServiceId(ctx, it->second.program_number);
+                ctx.unconfirmed_id = false;
             }
             else {
                 serviceNotPresent(ctx, u"VCT");
@@ -0,0 +1,313 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  Benchmark a chain of packet processing plugins.
+//
+//  A synthetic transport stream is generated in memory and pushed through
+//  a user-specified chain of packet processing plugins, as fast as the host
+//  can sustain. The input and output plugins are imposed ("memory" and
+//  "drop") so that no I/O device limits the throughput. The results can be
+//  reported in JSON to track regressions from one release to another.
+//
+//----------------------------------------------------------------------------
+
+#include "tsMain.h"
+#include "tsTSProcessor.h"
+#include "tsArgsWithPlugins.h"
+#include "tsDuckContext.h"
+#include "tsPluginRepository.h"
+#include "tsPluginEventData.h"
+#include "tsAsyncReport.h"
+#include "tsUserInterrupt.h"
+#include "tsSysUtils.h"
+#include "tsByteBlock.h"
+#include "tsTime.h"
+#include "tsjsonOutputArgs.h"
+#include "tsjsonObject.h"
+TS_MAIN(MainCode);
+
+namespace {
+    // Event code of the memory input plugin, used to fetch synthetic packets.
+    constexpr uint32_t INPUT_EVENT_CODE = 0x42454E43; // "BENC"
+
+    // First PID of the synthetic stream.
+    constexpr ts::PID FIRST_PID = 0x0100;
+}
+
+
+//----------------------------------------------------------------------------
+//  Command line options
+//----------------------------------------------------------------------------
+
+namespace {
+    class BenchOptions: public ts::ArgsWithPlugins
+    {
+        TS_NOBUILD_NOCOPY(BenchOptions);
+    public:
+        BenchOptions(int argc, char *argv[]);
+
+        // Option values
+        ts::PacketCounter   packets = 0;     // Number of packets to push through the chain.
+        size_t              pid_count = 0;   // Number of distinct PID's in the synthetic stream.
+        ts::DuckContext     duck {this};     // TSDuck context
+        ts::AsyncReportArgs log_args {};     // Asynchronous logger arguments.
+        ts::TSProcessorArgs tsp_args {};     // TS processing arguments.
+        ts::json::OutputArgs json {};        // Reporting in JSON format.
+    };
+}
+
+BenchOptions::BenchOptions(int argc, char *argv[]) :
+    ts::ArgsWithPlugins(0, 0, 0, UNLIMITED_COUNT, 0, 0, u"Benchmark a chain of packet processing plugins", u"[options] [-P plugin-options] ...")
+{
+    setIntro(u"A synthetic transport stream is generated in memory and pushed through "
+             u"the specified chain of packet processing plugins, as fast as the host "
+             u"can sustain. The input and output plugins are imposed (direct memory "
+             u"input, dropped output) so that no I/O device limits the throughput. "
+             u"The reported figures characterize the CPU cost of the chain itself.");
+
+    duck.defineArgsForCAS(*this);
+    duck.defineArgsForCharset(*this);
+    duck.defineArgsForHFBand(*this);
+    duck.defineArgsForPDS(*this);
+    duck.defineArgsForTimeReference(*this);
+    duck.defineArgsForStandards(*this);
+    log_args.defineArgs(*this);
+    tsp_args.defineArgs(*this);
+    json.defineArgs(*this, true);
+
+    option(u"packets", 'p', POSITIVE);
+    help(u"packets",
+         u"Total number of TS packets to push through the chain. "
+         u"The default is 1,000,000 packets.");
+
+    option(u"pid-count", 0, INTEGER, 0, 1, 1, 4096);
+    help(u"pid-count",
+         u"Number of distinct PID's in the synthetic stream, starting at PID 0x0100. "
+         u"The packets cycle through the PID's, with valid continuity counters in "
+         u"each PID. The default is 8 PID's.");
+
+    // Analyze the command.
+    analyze(argc, argv);
+
+    // Load option values.
+    duck.loadArgs(*this);
+    log_args.loadArgs(duck, *this);
+    tsp_args.loadArgs(duck, *this);
+    json.loadArgs(duck, *this);
+    getIntValue(packets, u"packets", 1000000);
+    getIntValue(pid_count, u"pid-count", 8);
+
+    // The input and output plugins are imposed.
+    tsp_args.input.set(u"memory", {u"--event-code", ts::UString::Format(u"%d", {INPUT_EVENT_CODE})});
+    tsp_args.output.set(u"drop");
+
+    // Final checking
+    exitOnError();
+}
+
+
+//----------------------------------------------------------------------------
+//  Synthetic packet generator, feeding the memory input plugin.
+//----------------------------------------------------------------------------
+
+namespace {
+    class BenchInput: public ts::PluginEventHandlerInterface
+    {
+        TS_NOBUILD_NOCOPY(BenchInput);
+    public:
+        // Constructor: pre-build the cyclic pattern of synthetic packets.
+        BenchInput(const BenchOptions& opt);
+
+        // Number of packets which were actually generated.
+        ts::PacketCounter generatedPackets() const { return _generated; }
+
+        // Implementation of PluginEventHandlerInterface.
+        // Invoked in the context of the input plugin thread only.
+        virtual void handlePluginEvent(const ts::PluginEventContext& context) override;
+
+    private:
+        ts::PacketCounter _remaining;       // Number of packets still to generate.
+        ts::PacketCounter _generated = 0;   // Number of packets already generated.
+        ts::ByteBlock     _pattern {};      // Pre-built cycle of synthetic packets.
+        size_t            _next = 0;        // Offset of next packet in the pattern.
+    };
+}
+
+BenchInput::BenchInput(const BenchOptions& opt) :
+    _remaining(opt.packets)
+{
+    // Pre-build one full cycle of packets: each PID appears 16 times, once per
+    // continuity counter value, so that the pattern can repeat seamlessly.
+    // Generating the packets once outside the measurement path ensures that
+    // the benchmark measures the plugin chain, not the generator.
+    const size_t cycle = opt.pid_count * ts::CC_MAX;
+    _pattern.resize(cycle * ts::PKT_SIZE);
+    for (size_t i = 0; i < cycle; ++i) {
+        ts::TSPacket pkt;
+        pkt.init(ts::PID(FIRST_PID + i % opt.pid_count), uint8_t(i / opt.pid_count), uint8_t(i));
+        std::memcpy(&_pattern[i * ts::PKT_SIZE], pkt.b, ts::PKT_SIZE);
+    }
+}
+
+void BenchInput::handlePluginEvent(const ts::PluginEventContext& context)
+{
+    // The event data points to the input buffer of the memory plugin.
+    // Returning zero packet means end of input.
+    ts::PluginEventData* data = dynamic_cast<ts::PluginEventData*>(context.pluginData());
+    if (data != nullptr && _remaining > 0) {
+        const size_t count = size_t(std::min<ts::PacketCounter>(_remaining, data->maxSize() / ts::PKT_SIZE));
+        size_t bytes = count * ts::PKT_SIZE;
+        while (bytes > 0) {
+            const size_t chunk = std::min(bytes, _pattern.size() - _next);
+            data->append(&_pattern[_next], chunk);
+            _next = (_next + chunk) % _pattern.size();
+            bytes -= chunk;
+        }
+        _remaining -= count;
+        _generated += count;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+//  Interrupt handler
+//----------------------------------------------------------------------------
+
+namespace {
+    class BenchInterruptHandler: public ts::InterruptHandler
+    {
+        TS_NOBUILD_NOCOPY(BenchInterruptHandler);
+    public:
+        BenchInterruptHandler(ts::AsyncReport* report, ts::TSProcessor* tsproc) : _report(report), _tsproc(tsproc) {}
+        virtual void handleInterrupt() override
+        {
+            _report->info(u"tsbench: user interrupt, terminating...");
+            _tsproc->abort();
+        }
+    private:
+        ts::AsyncReport* _report;
+        ts::TSProcessor* _tsproc;
+    };
+}
+
+
+//----------------------------------------------------------------------------
+//  Program main code.
+//----------------------------------------------------------------------------
+
+int MainCode(int argc, char *argv[])
+{
+    // Internal sanity check about TS packets.
+    ts::TSPacket::SanityCheck();
+
+    // If plugins were statically linked, disallow the dynamic loading of plugins.
+#if defined(TSDUCK_STATIC_PLUGINS)
+    ts::PluginRepository::Instance().setSharedLibraryAllowed(false);
+#endif
+
+    // Get command line options.
+    BenchOptions opt(argc, argv);
+    CERR.setMaxSeverity(opt.maxSeverity());
+
+    // Prevent from being killed when writing on broken pipes.
+    ts::IgnorePipeSignal();
+
+    // Create an asynchronous error logger. Can be used in multi-threaded context.
+    ts::AsyncReport report(opt.maxSeverity(), opt.log_args);
+
+    // The TS processing is performed into this object.
+    // The synthetic packets are injected through a plugin event handler.
+    ts::TSProcessor tsproc(report);
+    BenchInput input(opt);
+    tsproc.registerEventHandler(&input, INPUT_EVENT_CODE);
+
+    // Use a Ctrl+C interrupt handler
+    BenchInterruptHandler interrupt_handler(&report, &tsproc);
+    ts::UserInterrupt interrupt_manager(&interrupt_handler, true, true);
+
+    // Run the chain and measure elapsed and process CPU time around it.
+    const ts::Time start_time(ts::Time::CurrentUTC());
+    const ts::MilliSecond start_cpu = ts::GetProcessCpuTime();
+    if (!tsproc.start(opt.tsp_args)) {
+        return EXIT_FAILURE;
+    }
+    tsproc.waitForTermination();
+    const ts::MilliSecond duration = std::max<ts::MilliSecond>(1, ts::Time::CurrentUTC() - start_time);
+    const ts::MilliSecond cpu_time = ts::GetProcessCpuTime() - start_cpu;
+
+    // Get the final metrics of all plugin threads.
+    ts::TSProcessor::PluginMetricsVector metrics;
+    tsproc.getMetrics(metrics);
+
+    // The relevant throughput is the number of packets which made it to the
+    // output plugin, not the number of generated packets (they differ when
+    // the processing was aborted or packets were dropped in the chain).
+    const ts::PacketCounter out_packets = metrics.empty() ? 0 : metrics.back().packets;
+    const ts::PacketCounter pkt_per_sec = (out_packets * ts::PacketCounter(ts::MilliSecPerSec)) / ts::PacketCounter(duration);
+    const ts::BitRate bitrate = (ts::BitRate(out_packets) * ts::PKT_SIZE_BITS * ts::MilliSecPerSec) / duration;
+
+    // Command line equivalent of the benchmarked chain, to identify the run in JSON records.
+    ts::UString chain;
+    for (const auto& p : opt.tsp_args.plugins) {
+        chain.append((chain.empty() ? u"" : u" ") + p.toString(ts::PluginType::PROCESSOR));
+    }
+
+    if (opt.json.useJSON()) {
+        // Build a JSON description of the benchmark results.
+        // The "plugins" array uses the same fields as the "metrics" control command of tsp.
+        ts::json::Object root;
+        root.add(u"command", chain);
+        root.add(u"packets", out_packets);
+        root.add(u"generated-packets", input.generatedPackets());
+        root.add(u"duration-ms", duration);
+        root.add(u"packets-per-second", pkt_per_sec);
+        root.add(u"bitrate-188", bitrate.toString());
+        root.add(u"cpu-ms", cpu_time);
+        root.add(u"cpu-percent", (100 * cpu_time) / duration);
+        for (size_t i = 0; i < metrics.size(); ++i) {
+            const auto& m(metrics[i]);
+            ts::json::Value& jv(root.query(u"plugins[]", true));
+            jv.add(u"index", i);
+            const ts::UChar type = m.plugin_type == ts::PluginType::INPUT ? u'I' : (m.plugin_type == ts::PluginType::OUTPUT ? u'O' : u'P');
+            jv.add(u"type", ts::UString(1, type));
+            jv.add(u"plugin", m.plugin_name);
+            jv.add(u"packets", m.packets);
+            jv.add(u"waits", m.waits);
+            jv.add(u"wait-ms", m.wait_time);
+            jv.add(u"timeouts", m.timeouts);
+            jv.add(u"cpu-ms", m.cpu_time);
+            ts::json::Value& occ(jv.query(u"buffer-occupancy", true, ts::json::Type::Array));
+            for (const auto& count : m.occupancy) {
+                occ.set(count);
+            }
+        }
+        opt.json.report(root, std::cout, opt);
+    }
+
+    if (!opt.json.useFile()) {
+        // Plain text report.
+        std::cout << ts::UString::Format(u"Processed: %'d packets in %'d ms, %'d packets/second (%'d b/s at 188 bytes/packet)",
+                                         {out_packets, duration, pkt_per_sec, bitrate})
+                  << std::endl
+                  << ts::UString::Format(u"Process CPU time: %'d ms (%d%% of elapsed time)", {cpu_time, (100 * cpu_time) / duration})
+                  << std::endl;
+        for (size_t i = 0; i < metrics.size(); ++i) {
+            const auto& m(metrics[i]);
+            const ts::UChar type = m.plugin_type == ts::PluginType::INPUT ? u'I' : (m.plugin_type == ts::PluginType::OUTPUT ? u'O' : u'P');
+            ts::UString occ;
+            for (const auto& count : m.occupancy) {
+                occ.format(u"%s%d", {occ.empty() ? u"" : u" ", count});
+            }
+            std::cout << ts::UString::Format(u"%2d: %c %s: packets: %'d, waits: %'d (%'d ms), timeouts: %'d, cpu: %'d ms, occupancy: [%s]",
+                                             {i, type, m.plugin_name, m.packets, m.waits, m.wait_time, m.timeouts, m.cpu_time, occ})
+                      << std::endl;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -13,6 +13,10 @@
 #include "tsMain.h"
 #include "tsTSFile.h"
 #include "tsPCRAnalyzer.h"
+#include "tsThread.h"
+#include "tsSafePtr.h"
+#include "tsNullReport.h"
+#include "tsErrCodeReport.h"
 TS_MAIN(MainCode);
 
 
@@ -35,6 +39,7 @@ namespace {
         bool               full = false;           // Full analysis
         bool               value_only = false;     // Output value only
         bool               ignore_errors = false;  // Ignore TS errors
+        size_t             parallel = 0;           // Number of analysis threads (0: sequential)
         ts::UString        infile {};              // Input file name
         ts::TSPacketFormat format = ts::TSPacketFormat::AUTODETECT;
     };
@@ -76,6 +81,17 @@ Options::Options(int argc, char *argv[]) :
     option(u"min-pid", 0, INTEGER, 0, 1, 1, ts::PID_MAX);
     help(u"min-pid", u"Minimum number of PID's to get PCR from (default: 1).");
 
+    option(u"parallel", 0, INTEGER, 0, 1, 1, 256, true);
+    help(u"parallel", u"threads",
+         u"Analyze the file using several threads. Each thread analyzes one "
+         u"contiguous slice of the file and the partial results are merged in "
+         u"stream order. This is much faster on large files. The complete file "
+         u"is analyzed, as with --all. The accuracy is identical to a sequential "
+         u"analysis, except that the PCR intervals which cross a slice boundary "
+         u"are ignored. The optional value is the number of threads to use; the "
+         u"default is the number of processor cores. The input must be a regular "
+         u"file in plain TS format (188-byte packets).");
+
     option(u"value-only", 'v');
     help(u"value-only",
          u"Display only the bitrate value, in bits/seconds, based on "
@@ -94,10 +110,146 @@ Options::Options(int argc, char *argv[]) :
     ignore_errors = present(u"ignore-errors");
     format = ts::LoadTSPacketFormatInputOption(*this);
 
+    if (present(u"parallel")) {
+        parallel = intValue<size_t>(u"parallel", std::max<size_t>(1, std::thread::hardware_concurrency()));
+        if (infile.empty()) {
+            error(u"--parallel requires an input file, cannot read standard input");
+        }
+        if (format != ts::TSPacketFormat::AUTODETECT && format != ts::TSPacketFormat::TS) {
+            error(u"--parallel is allowed on plain TS files only");
+        }
+    }
+
     exitOnError();
 }
 
 
+//----------------------------------------------------------------------------
+//  Parallel file analyzer (--parallel)
+//----------------------------------------------------------------------------
+
+namespace ts {
+    class ParallelAnalyzer
+    {
+        TS_NOBUILD_NOCOPY(ParallelAnalyzer);
+    public:
+        // Constructor, analyze the file and merge the results into zer.
+        ParallelAnalyzer(Options& opt, PCRAnalyzer& zer);
+
+        // Final status.
+        bool success = false;
+
+    private:
+        // One worker thread, analyzing one contiguous slice of the file.
+        class Slice: public Thread
+        {
+            TS_NOBUILD_NOCOPY(Slice);
+        public:
+            Slice(ParallelAnalyzer& an, Options& opt, PacketCounter first, PacketCounter count) :
+                zer(opt.min_pid, opt.min_pcr), _an(an), _first(first), _count(count)
+            {
+                if (opt.use_dts) {
+                    zer.resetAndUseDTS(opt.min_pid, opt.min_pcr);
+                }
+                zer.setIgnoreErrors(opt.ignore_errors);
+            }
+            virtual void main() override { _an.analyzeSlice(zer, _first, _count); }
+
+            // Partial results for this slice.
+            PCRAnalyzer zer;
+
+        private:
+            ParallelAnalyzer&   _an;
+            const PacketCounter _first;
+            const PacketCounter _count;
+        };
+        typedef SafePtr<Slice> SlicePtr;
+
+        // Number of packets per read operation (about 4 MB).
+        static constexpr PacketCounter CHUNK_PACKETS = 22000;
+
+        Options&   _opt;
+        std::mutex _mutex {};      // Protect _io_error during the parallel phase.
+        bool       _io_error = false;
+
+        // Analyze one slice of the file. Executed in a worker thread.
+        void analyzeSlice(PCRAnalyzer& zer, PacketCounter first, PacketCounter count);
+    };
+}
+
+
+// Parallel analyzer constructor.
+ts::ParallelAnalyzer::ParallelAnalyzer(Options& opt, PCRAnalyzer& zer) :
+    _opt(opt)
+{
+    // Get the file size and deduce the number of packets to analyze.
+    const uint64_t size = fs::file_size(_opt.infile, &ErrCodeReport(_opt, u"error accessing", _opt.infile));
+    if (_opt.gotErrors()) {
+        return;
+    }
+    const PacketCounter packets = PacketCounter(size / PKT_SIZE);
+
+    // Distribute the packets over the worker threads, one contiguous slice each.
+    // Do not create more threads than chunks to analyze.
+    const size_t threads = std::max<PacketCounter>(1, std::min<PacketCounter>(_opt.parallel, 1 + packets / CHUNK_PACKETS));
+    std::vector<SlicePtr> slices;
+    PacketCounter first = 0;
+    for (size_t n = 0; n < threads; ++n) {
+        const PacketCounter count = packets / threads + (n < packets % threads ? 1 : 0);
+        slices.push_back(new Slice(*this, _opt, first, count));
+        first += count;
+    }
+    assert(first == packets);
+    for (const auto& sl : slices) {
+        sl->start();
+    }
+    for (const auto& sl : slices) {
+        sl->waitForTermination();
+    }
+    if (_io_error) {
+        _opt.error(u"error reading %s", {_opt.infile});
+        return;
+    }
+
+    // Merge the partial results in stream order.
+    for (const auto& sl : slices) {
+        zer.merge(sl->zer);
+    }
+    success = true;
+}
+
+
+// Analyze one slice of the file. Executed in a worker thread.
+void ts::ParallelAnalyzer::analyzeSlice(PCRAnalyzer& zer, PacketCounter first, PacketCounter count)
+{
+    // Each worker uses its own memory-mapped view of the file.
+    TSFile file;
+    file.setMemoryMappedRead(true);
+    if (!file.openRead(_opt.infile, 1, first * PKT_SIZE, NULLREP, TSPacketFormat::TS)) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _io_error = true;
+        return;
+    }
+    TSPacketVector buf {size_t(CHUNK_PACKETS)};
+    PacketCounter done = 0;
+    while (done < count) {
+        const size_t chunk = size_t(std::min(CHUNK_PACKETS, count - done));
+        const size_t got = file.readPackets(buf.data(), nullptr, chunk, NULLREP);
+        if (got == 0) {
+            // Unexpected end of file, the slice sizes were computed from the file size.
+            std::lock_guard<std::mutex> lock(_mutex);
+            _io_error = true;
+            break;
+        }
+        for (size_t i = 0; i < got; ++i) {
+            zer.feedPacket(buf[i]);
+        }
+        done += got;
+    }
+    file.close(NULLREP);
+}
+
+
 //----------------------------------------------------------------------------
 //  Program entry point
 //----------------------------------------------------------------------------
@@ -114,16 +266,25 @@ int MainCode(int argc, char *argv[])
         zer.resetAndUseDTS(opt.min_pid, opt.min_pcr);
     }
 
-    // Open the TS file.
-    ts::TSFile file;
-    if (!file.openRead(opt.infile, 1, 0, opt, opt.format)) {
-        return EXIT_FAILURE;
+    if (opt.parallel > 0) {
+        // Analyze contiguous slices of the file in parallel.
+        ts::ParallelAnalyzer an(opt, zer);
+        if (!an.success) {
+            return EXIT_FAILURE;
+        }
     }
+    else {
+        // Open the TS file.
+        ts::TSFile file;
+        if (!file.openRead(opt.infile, 1, 0, opt, opt.format)) {
+            return EXIT_FAILURE;
+        }
 
-    // Read all packets in the file and pass them to the PCR analyzer.
-    ts::TSPacket pkt;
-    while (file.readPackets(&pkt, nullptr, 1, opt) > 0 && (!zer.feedPacket(pkt) || opt.all)) {}
-    file.close(opt);
+        // Read all packets in the file and pass them to the PCR analyzer.
+        ts::TSPacket pkt;
+        while (file.readPackets(&pkt, nullptr, 1, opt) > 0 && (!zer.feedPacket(pkt) || opt.all)) {}
+        file.close(opt);
+    }
 
     // Display results.
     ts::PCRAnalyzer::Status status;
@@ -15,7 +15,11 @@
 #include "tsjsonOutputArgs.h"
 #include "tsTSFile.h"
 #include "tsFileUtils.h"
+#include "tsErrCodeReport.h"
 #include "tsjsonObject.h"
+#include "tsThread.h"
+#include "tsSafePtr.h"
+#include <fstream>
 TS_MAIN(MainCode);
 
 #define DEFAULT_BUFFERED_PACKETS 10000
@@ -39,6 +43,7 @@ namespace ts {
         UString          filename0 {};
         UString          filename1 {};
         uint64_t         byte_offset = 0;
+        size_t           parallel = 0;
         size_t           buffered_packets = 0;
         size_t           threshold_diff = 0;
         size_t           min_reorder = 0;
@@ -96,6 +101,17 @@ ts::TSCompareOptions::TSCompareOptions(int argc, char *argv[]) :
     option(u"packet-offset", 'p', UNSIGNED);
     help(u"packet-offset", u"count", u"Start reading the files at the specified TS packet. The default is 0.");
 
+    option(u"parallel", 0, INTEGER, 0, 1, 1, 256, true);
+    help(u"parallel", u"threads",
+         u"Compare the files block by block, using several threads. "
+         u"Large blocks of raw data are compared first and only the blocks which "
+         u"differ are re-examined packet by packet, honoring options such as "
+         u"--pcr-ignore or --payload-only. This is much faster on large files "
+         u"which are identical or almost identical. The optional value is the "
+         u"number of threads to use; the default is the number of processor cores. "
+         u"The files must be regular files in plain TS format. "
+         u"This option is mutually exclusive with --search-reorder.");
+
     option(u"payload-only", 0);
     help(u"payload-only", u"Compare only the payload of the packets, ignore header and adaptation field.");
 
@@ -155,6 +171,15 @@ ts::TSCompareOptions::TSCompareOptions(int argc, char *argv[]) :
     if (json.useFile() && normalized) {
         error(u"options --json and --normalized are mutually exclusive");
     }
+    if (present(u"parallel")) {
+        parallel = intValue<size_t>(u"parallel", std::max<size_t>(1, std::thread::hardware_concurrency()));
+        if (search_reorder) {
+            error(u"options --parallel and --search-reorder are mutually exclusive");
+        }
+        if (format != TSPacketFormat::AUTODETECT && format != TSPacketFormat::TS) {
+            error(u"--parallel is allowed on plain TS files only");
+        }
+    }
     if (quiet) {
         setMaxSeverity(Severity::Info);
     }
@@ -825,6 +850,316 @@ void ts::FileComparator::displayReorder(size_t file0_index, const FileToCompare&
 }
 
 
+//----------------------------------------------------------------------------
+// Fast block-level file comparator class (--parallel)
+//----------------------------------------------------------------------------
+
+namespace ts {
+    class FastFileComparator
+    {
+        TS_NOBUILD_NOCOPY(FastFileComparator);
+    public:
+        // Constructor, compare the files.
+        FastFileComparator(TSCompareOptions& opt);
+
+        // Final status.
+        bool success = false;
+
+    private:
+        // One worker thread, comparing one contiguous slice of the two files.
+        class Slice: public Thread
+        {
+            TS_NOBUILD_NOCOPY(Slice);
+        public:
+            Slice(FastFileComparator& comp, PacketCounter first, PacketCounter count) :
+                _comp(comp), _first(first), _count(count) {}
+            virtual void main() override { _comp.compareSlice(_first, _count); }
+        private:
+            FastFileComparator& _comp;
+            const PacketCounter _first;
+            const PacketCounter _count;
+        };
+        typedef SafePtr<Slice> SlicePtr;
+
+        // Number of packets per compared block (about 4 MB).
+        static constexpr PacketCounter CHUNK_PACKETS = 22000;
+
+        // Maximum number of individually recorded differences.
+        static constexpr size_t MAX_RECORDED_DIFFS = 65536;
+
+        TSCompareOptions& _opt;
+        bool              _exact;            // No ignore option, raw inequality means different packets.
+        bool              _stop_first;       // Stop each slice at its first difference.
+        PacketCounter     _packets0 = 0;     // Number of packets in first file, after --byte-offset.
+        PacketCounter     _packets1 = 0;     // Number of packets in second file, after --byte-offset.
+        json::Object      _jroot {};
+        PacketCounter     _diff_count = 0;
+        std::mutex        _mutex {};         // Protect the fields below during the parallel phase.
+        bool              _io_error = false;
+        std::vector<PacketCounter> _diffs {};  // Indexes of differing packets.
+
+        // Compare one slice of the two files. Executed in a worker thread.
+        void compareSlice(PacketCounter first, PacketCounter count);
+
+        // Read one packet during the reporting phase.
+        bool readPacket(std::ifstream& file, const UString& filename, PacketCounter index, TSPacket& pkt);
+
+        // Display one difference, a truncated file, the final report.
+        void displayOneDifference(const PacketComparator& comp, const TSPacket& pkt0, const TSPacket& pkt1, PacketCounter index);
+        void displayTruncated(size_t file_index, const UString& filename, PacketCounter packets);
+        void displayFinal();
+    };
+}
+
+
+// Fast file comparator constructor.
+ts::FastFileComparator::FastFileComparator(TSCompareOptions& opt) :
+    _opt(opt),
+    _exact(!opt.payload_only && !opt.pcr_ignore && !opt.pid_ignore && !opt.cc_ignore),
+    _stop_first(opt.quiet || !opt.continue_all)
+{
+    // Get the file sizes and deduce the number of packets to compare.
+    const uint64_t size0 = fs::file_size(_opt.filename0, &ErrCodeReport(_opt, u"error accessing", _opt.filename0));
+    const uint64_t size1 = fs::file_size(_opt.filename1, &ErrCodeReport(_opt, u"error accessing", _opt.filename1));
+    if (_opt.gotErrors()) {
+        return;
+    }
+    _packets0 = size0 <= _opt.byte_offset ? 0 : PacketCounter((size0 - _opt.byte_offset) / PKT_SIZE);
+    _packets1 = size1 <= _opt.byte_offset ? 0 : PacketCounter((size1 - _opt.byte_offset) / PKT_SIZE);
+    const PacketCounter compared = std::min(_packets0, _packets1);
+
+    if (_opt.json.useJSON()) {
+        _jroot.query(u"files[0]", true).add(u"name", AbsoluteFilePath(_opt.filename0));
+        _jroot.query(u"files[1]", true).add(u"name", AbsoluteFilePath(_opt.filename1));
+    }
+    else if (!_opt.normalized && _opt.verbose() && !_opt.json.useFile()) {
+        std::cout << "* Comparing " << _opt.filename0 << " and " << _opt.filename1 << std::endl;
+    }
+
+    // Distribute the packets over the worker threads, one contiguous slice each.
+    // Do not create more threads than chunks to compare.
+    const size_t threads = std::max<PacketCounter>(1, std::min<PacketCounter>(_opt.parallel, 1 + compared / CHUNK_PACKETS));
+    std::vector<SlicePtr> slices;
+    PacketCounter first = 0;
+    for (size_t n = 0; n < threads; ++n) {
+        const PacketCounter count = compared / threads + (n < compared % threads ? 1 : 0);
+        slices.push_back(new Slice(*this, first, count));
+        first += count;
+    }
+    assert(first == compared);
+    for (const auto& sl : slices) {
+        sl->start();
+    }
+    for (const auto& sl : slices) {
+        sl->waitForTermination();
+    }
+    if (_io_error) {
+        _opt.error(u"error reading input files");
+        return;
+    }
+
+    // Report the recorded differences in file order. The differing packets are
+    // re-read from the files, there are usually only a few of them.
+    std::sort(_diffs.begin(), _diffs.end());
+    std::ifstream file0(_opt.filename0.toUTF8().c_str(), std::ios::in | std::ios::binary);
+    std::ifstream file1(_opt.filename1.toUTF8().c_str(), std::ios::in | std::ios::binary);
+    for (auto index : _diffs) {
+        TSPacket pkt0;
+        TSPacket pkt1;
+        if (!readPacket(file0, _opt.filename0, index, pkt0) || !readPacket(file1, _opt.filename1, index, pkt1)) {
+            return;
+        }
+        const PacketComparator comp(pkt0, pkt1, _opt);
+        displayOneDifference(comp, pkt0, pkt1, index);
+        if (_stop_first) {
+            break;
+        }
+    }
+
+    // Report a truncated file.
+    if (_packets0 < _packets1) {
+        displayTruncated(0, _opt.filename0, _packets0);
+    }
+    else if (_packets1 < _packets0) {
+        displayTruncated(1, _opt.filename1, _packets1);
+    }
+
+    displayFinal();
+    success = _diff_count == 0 && _opt.valid() && !_opt.gotErrors();
+}
+
+
+// Compare one slice of the two files. Executed in a worker thread.
+void ts::FastFileComparator::compareSlice(PacketCounter first, PacketCounter count)
+{
+    // Each worker uses its own pair of file descriptors.
+    std::ifstream file0(_opt.filename0.toUTF8().c_str(), std::ios::in | std::ios::binary);
+    std::ifstream file1(_opt.filename1.toUTF8().c_str(), std::ios::in | std::ios::binary);
+    file0.seekg(std::streamoff(_opt.byte_offset + first * PKT_SIZE));
+    file1.seekg(std::streamoff(_opt.byte_offset + first * PKT_SIZE));
+    std::vector<char> buf0(size_t(CHUNK_PACKETS) * PKT_SIZE);
+    std::vector<char> buf1(size_t(CHUNK_PACKETS) * PKT_SIZE);
+
+    PacketCounter done = 0;
+    while (done < count) {
+        // Read one chunk from each file.
+        const size_t chunk = size_t(std::min(CHUNK_PACKETS, count - done));
+        file0.read(buf0.data(), std::streamsize(chunk * PKT_SIZE));
+        file1.read(buf1.data(), std::streamsize(chunk * PKT_SIZE));
+        if (size_t(file0.gcount()) != chunk * PKT_SIZE || size_t(file1.gcount()) != chunk * PKT_SIZE) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _io_error = true;
+            return;
+        }
+        // Compare the chunks as raw blocks. The memcmp is the fast path,
+        // differing chunks are re-examined packet by packet.
+        if (std::memcmp(buf0.data(), buf1.data(), chunk * PKT_SIZE) != 0) {
+            for (size_t n = 0; n < chunk; ++n) {
+                if (std::memcmp(buf0.data() + n * PKT_SIZE, buf1.data() + n * PKT_SIZE, PKT_SIZE) != 0) {
+                    // When some fields are ignored, check if the packets really differ.
+                    if (!_exact) {
+                        TSPacket pkt0;
+                        TSPacket pkt1;
+                        std::memcpy(pkt0.b, buf0.data() + n * PKT_SIZE, PKT_SIZE);
+                        std::memcpy(pkt1.b, buf1.data() + n * PKT_SIZE, PKT_SIZE);
+                        const PacketComparator comp(pkt0, pkt1, _opt);
+                        if (comp.equal) {
+                            continue;
+                        }
+                    }
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    _diff_count++;
+                    if (_diffs.size() < MAX_RECORDED_DIFFS) {
+                        _diffs.push_back(first + done + n);
+                    }
+                    if (_stop_first) {
+                        // Stop this slice at its own first difference. Other
+                        // slices continue up to their own first difference, so
+                        // the smallest recorded index is the first difference
+                        // between the two files.
+                        return;
+                    }
+                }
+            }
+        }
+        done += chunk;
+    }
+}
+
+
+// Read one packet during the reporting phase.
+bool ts::FastFileComparator::readPacket(std::ifstream& file, const UString& filename, PacketCounter index, TSPacket& pkt)
+{
+    file.seekg(std::streamoff(_opt.byte_offset + index * PKT_SIZE));
+    file.read(reinterpret_cast<char*>(pkt.b), PKT_SIZE);
+    if (size_t(file.gcount()) == PKT_SIZE) {
+        return true;
+    }
+    else {
+        _opt.error(u"error reading packet %'d from %s", {index, filename});
+        return false;
+    }
+}
+
+
+// Report a difference in a packet.
+void ts::FastFileComparator::displayOneDifference(const PacketComparator& comp, const TSPacket& pkt0, const TSPacket& pkt1, PacketCounter index)
+{
+    const PID pid0 = pkt0.getPID();
+    const PID pid1 = pkt1.getPID();
+
+    if (_opt.json.useJSON()) {
+        json::Value& jv(_jroot.query(u"events[]", true));
+        jv.add(u"type", u"difference");
+        jv.add(u"packet", index);
+        jv.add(u"payload-only", json::Bool(_opt.payload_only));
+        jv.add(u"offset", comp.first_diff);
+        jv.add(u"end-offset", comp.end_diff);
+        jv.add(u"diff-bytes", comp.diff_count);
+        jv.add(u"comp-size", comp.compared_size);
+        jv.add(u"pid0", pid0);
+        jv.add(u"pid1", pid1);
+        jv.add(u"same-pid", json::Bool(pid0 == pid1));
+    }
+    if (_opt.normalized) {
+        std::cout << "diff:packet=" << index
+                  << (_opt.payload_only ? ":payload" : "")
+                  << ":offset=" << comp.first_diff
+                  << ":endoffset=" << comp.end_diff
+                  << ":diffbytes= " << comp.diff_count
+                  << ":compsize=" << comp.compared_size
+                  << ":pid1=" << pid0
+                  << ":pid2=" << pid1
+                  << (pid1 == pid0 ? ":samepid" : "")
+                  << ":" << std::endl;
+    }
+    else if (!_opt.quiet && !_opt.json.useFile()) {
+        std::cout << "* Packet " << UString::Decimal(index) << " differ at offset " << comp.first_diff;
+        if (_opt.payload_only) {
+            std::cout << " in payload";
+        }
+        std::cout << ", " << comp.diff_count;
+        if (comp.diff_count != comp.end_diff - comp.first_diff) {
+            std::cout << "/" << (comp.end_diff - comp.first_diff);
+        }
+        std::cout << " bytes differ, PID " << pid0;
+        if (pid1 != pid0) {
+            std::cout << "/" << pid1;
+        }
+        std::cout << std::endl;
+        if (_opt.dump) {
+            std::cout << "  Packet from " << _opt.filename0 << ":" << std::endl;
+            pkt0.display(std::cout, _opt.dump_flags, 6);
+            std::cout << "  Packet from " << _opt.filename1 << ":" << std::endl;
+            pkt1.display(std::cout, _opt.dump_flags, 6);
+        }
+    }
+}
+
+
+// Report a truncated file.
+void ts::FastFileComparator::displayTruncated(size_t file_index, const UString& filename, PacketCounter packets)
+{
+    if (_opt.json.useJSON()) {
+        json::Value& jv(_jroot.query(u"events[]", true));
+        jv.add(u"type", u"truncated");
+        jv.add(u"packet", packets);
+        jv.add(u"file-index", file_index);
+    }
+    if (_opt.normalized) {
+        std::cout << "truncated:file=" << file_index << ":packet=" << packets << ":filename=" << filename << ":" << std::endl;
+    }
+    else if (!_opt.quiet && !_opt.json.useFile()) {
+        std::cout << "* Packet " << UString::Decimal(packets) << ": file " << filename << " is truncated" << std::endl;
+    }
+    _diff_count++;
+}
+
+
+// Display final report.
+void ts::FastFileComparator::displayFinal()
+{
+    if (_opt.json.useJSON()) {
+        json::Value& jv0(_jroot.query(u"files[0]"));
+        jv0.add(u"packets", _packets0);
+        json::Value& jv1(_jroot.query(u"files[1]"));
+        jv1.add(u"packets", _packets1);
+        _jroot.query(u"summary", true).add(u"differences", _diff_count);
+    }
+    if (_opt.normalized) {
+        std::cout << "file:file=1:filename=" << _opt.filename0 << ":packets=" << _packets0 << ":" << std::endl;
+        std::cout << "file:file=2:filename=" << _opt.filename1 << ":packets=" << _packets1 << ":" << std::endl;
+        std::cout << "total:diff=" << _diff_count << ":" << std::endl;
+    }
+    else if (_opt.verbose() && !_opt.json.useFile()) {
+        std::cout << "* Found " << UString::Decimal(_diff_count) << " differences" << std::endl;
+    }
+
+    // JSON output if required.
+    _opt.json.report(_jroot, std::cout, _opt);
+}
+
+
 //----------------------------------------------------------------------------
 // Program entry point
 //----------------------------------------------------------------------------
@@ -832,6 +1167,12 @@ void ts::FileComparator::displayReorder(size_t file0_index, const FileToCompare&
 int MainCode(int argc, char *argv[])
 {
     ts::TSCompareOptions opt(argc, argv);
-    ts::FileComparator comp(opt);
-    return comp.success ? EXIT_SUCCESS : EXIT_FAILURE;
+    if (opt.parallel > 0) {
+        ts::FastFileComparator comp(opt);
+        return comp.success ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    else {
+        ts::FileComparator comp(opt);
+        return comp.success ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
 }
@@ -172,7 +172,7 @@ namespace {
             for (size = 0; size < raw_bpl && (c = in->get()) != EOF; size++) {
                 buffer[size] = uint8_t(c);
             }
-            out << ts::UString::Dump(buffer, size, flags, 0, raw_bpl, offset);
+            ts::UString::Dump(out, buffer, size, flags, 0, raw_bpl, offset);
             offset += size;
         }
     }
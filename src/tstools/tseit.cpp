@@ -122,6 +122,16 @@ ts::EITMainOptions::EITMainOptions(int argc, char *argv[]) :
 
     cmdline.command(u"reset", u"Reset the content of the EIT database", u"", flags);
 
+    cmd = cmdline.command(u"clear-service", u"Remove all events of one service from the EIT database", u"[options]", flags);
+    cmd->option(u"service-id", 's', UINT16, 1, 1);
+    cmd->help(u"service-id", u"Service id of the service to remove. "
+              u"With \"load\" and \"save\", this allows incremental updates of a large EIT database: "
+              u"clear and reload the services which changed, then save the complete database again.");
+    cmd->option(u"transport-stream-id", 't', UINT16, 1, 1);
+    cmd->help(u"transport-stream-id", u"Transport stream id of the service to remove.");
+    cmd->option(u"original-network-id", 'n', UINT16, 1, 1);
+    cmd->help(u"original-network-id", u"Original network id of the service to remove.");
+
     cmdline.command(u"dump", u"Dump the content of the EIT database", u"", flags);
 
     cmd = cmdline.command(u"set", u"Set EIT generation options", u"[options]", flags);
@@ -241,6 +251,7 @@ namespace ts {
         CommandStatus process(const UString&, Args&);
         CommandStatus generate(const UString&, Args&);
         CommandStatus reset(const UString&, Args&);
+        CommandStatus clearService(const UString&, Args&);
         CommandStatus dump(const UString&, Args&);
         CommandStatus set(const UString&, Args&);
     };
@@ -265,6 +276,7 @@ ts::EITCommand::EITCommand(EITMainOptions& opt) :
     _opt.cmdline.setCommandLineHandler(this, &EITCommand::process, u"process");
     _opt.cmdline.setCommandLineHandler(this, &EITCommand::generate, u"generate");
     _opt.cmdline.setCommandLineHandler(this, &EITCommand::reset, u"reset");
+    _opt.cmdline.setCommandLineHandler(this, &EITCommand::clearService, u"clear-service");
     _opt.cmdline.setCommandLineHandler(this, &EITCommand::dump, u"dump");
     _opt.cmdline.setCommandLineHandler(this, &EITCommand::set, u"set");
 }
@@ -423,6 +435,14 @@ ts::CommandStatus ts::EITCommand::reset(const UString& command, Args& args)
     return CommandStatus::SUCCESS;
 }
 
+ts::CommandStatus ts::EITCommand::clearService(const UString& command, Args& args)
+{
+    _eit_gen.resetService(ServiceIdTriplet(args.intValue<uint16_t>(u"service-id"),
+                                           args.intValue<uint16_t>(u"transport-stream-id"),
+                                           args.intValue<uint16_t>(u"original-network-id")));
+    return CommandStatus::SUCCESS;
+}
+
 ts::CommandStatus ts::EITCommand::dump(const UString& command, Args& args)
 {
     _eit_gen.dumpInternalState(Severity::Info);
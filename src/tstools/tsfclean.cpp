@@ -16,6 +16,8 @@
 #include "tsCyclingPacketizer.h"
 #include "tsEITProcessor.h"
 #include "tsTSFile.h"
+#include "tsThread.h"
+#include "tsMonotonic.h"
 #include "tsPAT.h"
 #include "tsCAT.h"
 #include "tsPMT.h"
@@ -42,6 +44,7 @@ namespace ts {
         UStringVector in_files {};  // Input file names.
         UString       out_file {};  // Output file name or directory.
         bool          out_dir {};   // Output name is a directory.
+        size_t        parallel {};  // Number of worker threads, 0 for sequential processing.
     };
 }
 
@@ -60,11 +63,21 @@ ts::FileCleanOptions::FileCleanOptions(int argc, char *argv[]) :
          u"This is a mandatory parameter, there is no default. "
          u"If more than one input file is specified, the output name shall specify a directory.");
 
+    option(u"parallel", 'p', INTEGER, 0, 1, 1, 256, true);
+    help(u"parallel", u"threads",
+         u"Clean the input files in parallel, using several threads, one file per thread. "
+         u"The optional value is the number of threads to use; the default is the "
+         u"number of processor cores. "
+         u"This is only useful when several input files are specified.");
+
     analyze(argc, argv);
 
     getValues(in_files, u"");
     getValue(out_file, u"output");
     out_dir = fs::is_directory(out_file);
+    if (present(u"parallel")) {
+        parallel = intValue<size_t>(u"parallel", std::max<size_t>(1, std::thread::hardware_concurrency()));
+    }
 
     if (in_files.size() > 1 && !out_dir) {
         error(u"the output name must be a directory when more than one input file is specified");
@@ -87,7 +100,9 @@ namespace ts {
         TS_NOBUILD_NOCOPY(FileCleaner);
     public:
         // Constructor, performing the TS file cleanup.
-        FileCleaner(FileCleanOptions& opt, const UString& infile_name);
+        // The DuckContext is passed separately because each worker thread
+        // must have its own context in parallel mode.
+        FileCleaner(FileCleanOptions& opt, DuckContext& duck, const UString& infile_name);
 
         // Status of the cleanup.
         bool success() const { return _success; }
@@ -115,14 +130,15 @@ namespace ts {
         // File cleaner private fields:
         bool               _success = true;
         FileCleanOptions&  _opt;
+        DuckContext&       _duck;
         TSFile             _in_file {};
         TSFile             _out_file {};
         PAT                _pat {};
-        CyclingPacketizer  _pat_pzer {_opt.duck, PID_PAT, CyclingPacketizer::StuffingPolicy::ALWAYS};
+        CyclingPacketizer  _pat_pzer {_duck, PID_PAT, CyclingPacketizer::StuffingPolicy::ALWAYS};
         CAT                _cat {};
-        CyclingPacketizer  _cat_pzer {_opt.duck, PID_CAT, CyclingPacketizer::StuffingPolicy::ALWAYS};
+        CyclingPacketizer  _cat_pzer {_duck, PID_CAT, CyclingPacketizer::StuffingPolicy::ALWAYS};
         SDT                _sdt {};
-        CyclingPacketizer  _sdt_pzer {_opt.duck, PID_SDT, CyclingPacketizer::StuffingPolicy::ALWAYS};
+        CyclingPacketizer  _sdt_pzer {_duck, PID_SDT, CyclingPacketizer::StuffingPolicy::ALWAYS};
         PMTContextMap      _pmts {};
 
         // Implementation of SignalizationHandlerInterface:
@@ -147,8 +163,9 @@ namespace ts {
 // File cleaner constructor.
 //----------------------------------------------------------------------------
 
-ts::FileCleaner::FileCleaner(FileCleanOptions& opt, const UString& infile_name) :
-    _opt(opt)
+ts::FileCleaner::FileCleaner(FileCleanOptions& opt, DuckContext& duck, const UString& infile_name) :
+    _opt(opt),
+    _duck(duck)
 {
     // Mark all tables as invalid. The first occurrence in the input file will initialize them.
     _pat.invalidate();
@@ -177,7 +194,7 @@ ts::FileCleaner::FileCleaner(FileCleanOptions& opt, const UString& infile_name)
     }
 
     // First pass: read all packets, process TS structure.
-    SignalizationDemux sig(_opt.duck, this, {TID_PAT, TID_CAT, TID_PMT, TID_SDT_ACT});
+    SignalizationDemux sig(_duck, this, {TID_PAT, TID_CAT, TID_PMT, TID_SDT_ACT});
     TSPacket pkt;
     while (_success && _in_file.readPackets(&pkt, nullptr, 1, _opt) == 1) {
         sig.feedPacket(pkt);
@@ -193,7 +210,7 @@ ts::FileCleaner::FileCleaner(FileCleanOptions& opt, const UString& infile_name)
     }
 
     // Process EIT's in the second pass: keep only EITp/f Actual for known services.
-    EITProcessor eit_proc(_opt.duck);
+    EITProcessor eit_proc(_duck);
     eit_proc.removeOther();
     eit_proc.removeSchedule();
     for (const auto& it : _pmts) {
@@ -328,7 +345,7 @@ void ts::FileCleaner::handleCAT(const CAT& cat, PID pid)
     else {
         // Updated CAT, merge descriptors (don't duplicate existing ones).
         _opt.verbose(u"got CAT update, version %d", {cat.version});
-        _cat.descs.merge(_opt.duck, cat.descs);
+        _cat.descs.merge(_duck, cat.descs);
     }
 }
 
@@ -356,7 +373,7 @@ void ts::FileCleaner::handleSDT(const SDT& sdt, PID pid)
             }
             else {
                 // Existing service, merge descriptors.
-                cur->second.descs.merge(_opt.duck, it.second.descs);
+                cur->second.descs.merge(_duck, it.second.descs);
             }
         }
     }
@@ -390,7 +407,7 @@ void ts::FileCleaner::handlePMT(const PMT& pmt, PID pid)
             }
             else {
                 // Existing component, merge descriptors.
-                cur->second.descs.merge(_opt.duck, it.second.descs);
+                cur->second.descs.merge(_duck, it.second.descs);
             }
         }
     }
@@ -416,7 +433,7 @@ ts::FileCleaner::PMTContextPtr ts::FileCleaner::getPMTContext(PID pmt_pid, bool
         return it->second;
     }
     else if (create) {
-        return _pmts[pmt_pid] = PMTContextPtr(new PMTContext(_opt.duck, pmt_pid));
+        return _pmts[pmt_pid] = PMTContextPtr(new PMTContext(_duck, pmt_pid));
     }
     else {
         return PMTContextPtr();
@@ -433,7 +450,7 @@ void ts::FileCleaner::initCycle(AbstractLongTable& table, CyclingPacketizer& pze
     if (table.isValid()) {
         table.version = 0;
         table.is_current = true;
-        pzer.addTable(_opt.duck, table);
+        pzer.addTable(_duck, table);
         do {
             writeFromPacketizer(pzer);
         } while (_success && !pzer.atCycleBoundary());
@@ -454,6 +471,55 @@ void ts::FileCleaner::writeFromPacketizer(Packetizer& pzer)
 }
 
 
+//----------------------------------------------------------------------------
+// Worker thread for --parallel.
+//----------------------------------------------------------------------------
+
+namespace ts {
+    class CleanerThread: public Thread
+    {
+        TS_NOBUILD_NOCOPY(CleanerThread);
+    public:
+        // The constructor is invoked in the main thread, before starting any worker.
+        CleanerThread(FileCleanOptions& opt, std::atomic<size_t>& next, std::atomic<size_t>& done, std::atomic<size_t>& errors, std::atomic<uint64_t>& bytes) :
+            _opt(opt), _next(next), _done(done), _errors(errors), _bytes(bytes), _duck(&opt)
+        {
+        }
+        virtual ~CleanerThread() override
+        {
+            waitForTermination();
+        }
+        virtual void main() override
+        {
+            for (;;) {
+                const size_t i = _next.fetch_add(1);
+                if (i >= _opt.in_files.size()) {
+                    break;
+                }
+                const UString& name(_opt.in_files[i]);
+                const FileCleaner fclean(_opt, _duck, name);
+                if (!fclean.success()) {
+                    _errors.fetch_add(1);
+                }
+                std::error_code ec;
+                const std::uintmax_t size = fs::file_size(name, ec);
+                if (!ec) {
+                    _bytes.fetch_add(uint64_t(size));
+                }
+                _opt.verbose(u"completed %s (%d/%d files done)", {name, _done.fetch_add(1) + 1, _opt.in_files.size()});
+            }
+        }
+    private:
+        FileCleanOptions&      _opt;
+        std::atomic<size_t>&   _next;    // Index of next input file to process.
+        std::atomic<size_t>&   _done;    // Number of completed files (for progress reporting).
+        std::atomic<size_t>&   _errors;  // Number of files in error.
+        std::atomic<uint64_t>& _bytes;   // Total size of processed input files.
+        DuckContext            _duck;    // Each worker has its own context.
+    };
+}
+
+
 //----------------------------------------------------------------------------
 // Program entry point.
 //----------------------------------------------------------------------------
@@ -463,9 +529,40 @@ int MainCode(int argc, char *argv[])
     ts::FileCleanOptions opt(argc, argv);
     bool success = true;
 
-    for (size_t i = 0; i < opt.in_files.size(); ++i) {
-        ts::FileCleaner fclean(opt, opt.in_files[i]);
-        success = success && fclean.success();
+    if (opt.parallel > 0) {
+        // Parallel processing: the input files are distributed over a pool of worker threads.
+        // Do not create more threads than input files.
+        const ts::Monotonic start(true);
+        std::atomic<size_t> next(0);
+        std::atomic<size_t> done(0);
+        std::atomic<size_t> errors(0);
+        std::atomic<uint64_t> bytes(0);
+        std::list<ts::SafePtr<ts::CleanerThread>> workers;
+        const size_t count = std::min(opt.parallel, opt.in_files.size());
+        for (size_t n = 0; n < count; ++n) {
+            workers.push_back(new ts::CleanerThread(opt, next, done, errors, bytes));
+        }
+        for (const auto& th : workers) {
+            th->start();
+        }
+        for (const auto& th : workers) {
+            th->waitForTermination();
+        }
+        success = errors == 0;
+
+        // Aggregate throughput report.
+        const ts::Monotonic stop(true);
+        const ts::MilliSecond ms = std::max<ts::MilliSecond>(1, (stop - start) / ts::NanoSecPerMilliSec);
+        opt.verbose(u"cleaned %d files (%d in error) in %d.%03d seconds, %s, %s/s",
+                    {done.load(), errors.load(), ms / 1000, ms % 1000,
+                     ts::UString::HumanSize(int64_t(bytes.load())),
+                     ts::UString::HumanSize(int64_t((bytes.load() * ts::MilliSecPerSec) / uint64_t(ms)))});
+    }
+    else {
+        for (size_t i = 0; i < opt.in_files.size(); ++i) {
+            ts::FileCleaner fclean(opt, opt.duck, opt.in_files[i]);
+            success = success && fclean.success();
+        }
     }
 
     return success ? EXIT_SUCCESS : EXIT_FAILURE;
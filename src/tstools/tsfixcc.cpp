@@ -14,6 +14,9 @@
 #include "tsContinuityAnalyzer.h"
 TS_MAIN(MainCode);
 
+// Number of packets per processing window.
+#define WINDOW_PACKETS 1000
+
 
 //----------------------------------------------------------------------------
 //  Command line options
@@ -117,33 +120,46 @@ int MainCode(int argc, char *argv[])
         return EXIT_FAILURE;
     }
 
-    // Process all packets in the file
-    ts::TSPacket pkt;
+    // Process all packets in the file, by windows of packets.
+    // Packets are analyzed in bulk and the complete window is rewritten
+    // when at least one packet was modified in it.
+    ts::TSPacketVector buffer(WINDOW_PACKETS);
+    bool eof = false;
 
-    for (;;) {
+    while (!eof) {
 
-        // Save position of current packet
+        // Save position of current window
         const std::ios::pos_type pos = opt.file.tellg();
         if (opt.fileError(u"error getting file position")) {
             break;
         }
 
-        // Read a TS packet
-        if (!pkt.read(opt.file, true, opt)) {
+        // Read a window of TS packets
+        size_t count = 0;
+        while (count < buffer.size() && buffer[count].read(opt.file, true, opt)) {
+            count++;
+        }
+        eof = count < buffer.size();
+        if (count == 0) {
             break; // end of file
         }
 
-        // Process packet
-        if (!fixer.feedPacket(pkt) && !opt.test) {
-            // Packet was modified, need to rewrite it.
-            // Rewind to beginning of current packet
+        // Process the window
+        if (fixer.feedPackets(buffer.data(), count) > 0 && !opt.test) {
+            // At least one packet was modified, rewrite the window.
+            // First, clear a possible eof condition from the read loop.
+            opt.file.clear();
+            // Rewind to beginning of current window
             opt.file.seekp(pos);
             if (opt.fileError(u"error setting file position")) {
                 break;
             }
-            // Rewrite the packet
-            pkt.write(opt.file, opt);
-            if (opt.fileError(u"error rewriting packet")) {
+            // Rewrite the packets
+            size_t written = 0;
+            while (written < count && buffer[written].write(opt.file, opt)) {
+                written++;
+            }
+            if (opt.fileError(u"error rewriting packets")) {
                 break;
             }
             // Make sure the get position is ok
@@ -160,7 +176,7 @@ int MainCode(int argc, char *argv[])
     if (opt.circular && opt.valid()) {
 
         // Create an empty packet (no payload, 184-byte adaptation field)
-        pkt = ts::NullPacket;
+        ts::TSPacket pkt(ts::NullPacket);
         pkt.b[3] = 0x20;    // adaptation field, no payload
         pkt.b[4] = 183;     // adaptation field length
         pkt.b[5] = 0x00;    // nothing in adaptation field
@@ -0,0 +1,123 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  Pretty-print binary history event files (tsp plugin "history" --binary).
+//
+//----------------------------------------------------------------------------
+
+#include "tsMain.h"
+#include "tsDuckContext.h"
+#include "tsHistoryEvent.h"
+TS_MAIN(MainCode);
+
+
+//----------------------------------------------------------------------------
+// Command line options
+//----------------------------------------------------------------------------
+
+namespace {
+    class Options: public ts::Args
+    {
+        TS_NOBUILD_NOCOPY(Options);
+    public:
+        Options(int argc, char *argv[]);
+
+        ts::DuckContext   duck {this};  // TSDuck execution context.
+        ts::UStringVector in_files {};  // Input file names.
+    };
+}
+
+Options::Options(int argc, char *argv[]) :
+    Args(u"Pretty-print binary history event files", u"[options] filename ...")
+{
+    duck.defineArgsForStandards(*this);
+    duck.defineArgsForCharset(*this);
+
+    option(u"", 0, FILENAME, 1, UNLIMITED_COUNT);
+    help(u"",
+         u"Binary history files to print. Such files are produced by the tsp "
+         u"plugin \"history\" with options --binary --output-file. The same "
+         u"text lines as the plugin text output are written on the standard "
+         u"output, prefixed with the packet index or the playback time in "
+         u"milliseconds, depending on how the file was produced.");
+
+    analyze(argc, argv);
+
+    duck.loadArgs(*this);
+    getValues(in_files, u"");
+    exitOnError();
+}
+
+
+//----------------------------------------------------------------------------
+// Print one binary history file.
+//----------------------------------------------------------------------------
+
+namespace {
+    bool PrintFile(Options& opt, const ts::UString& file_name)
+    {
+        // Open the binary file.
+        std::ifstream in(file_name.toUTF8().c_str(), std::ios::in | std::ios::binary);
+        if (!in) {
+            opt.error(u"cannot open %s", {file_name});
+            return false;
+        }
+
+        // Read and check the file header.
+        uint8_t header[ts::HistoryEvent::HEADER_SIZE];
+        in.read(reinterpret_cast<char*>(header), sizeof(header));
+        if (size_t(in.gcount()) < sizeof(header) ||
+            std::memcmp(header, ts::HistoryEvent::FileMagic(), ts::HistoryEvent::MAGIC_SIZE) != 0)
+        {
+            opt.error(u"%s is not a binary history file", {file_name});
+            return false;
+        }
+        if (header[ts::HistoryEvent::MAGIC_SIZE] != ts::HistoryEvent::FILE_VERSION) {
+            opt.error(u"%s: unsupported history file version %d", {file_name, header[ts::HistoryEvent::MAGIC_SIZE]});
+            return false;
+        }
+
+        // Read all event records.
+        uint8_t buffer[ts::HistoryEvent::RECORD_SIZE];
+        ts::HistoryEvent event;
+        for (;;) {
+            in.read(reinterpret_cast<char*>(buffer), sizeof(buffer));
+            const size_t count = size_t(in.gcount());
+            if (count == 0) {
+                break; // end of file
+            }
+            if (count < sizeof(buffer)) {
+                opt.error(u"%s: truncated event record at end of file", {file_name});
+                return false;
+            }
+            if (!event.deserialize(buffer)) {
+                opt.error(u"%s: invalid event record", {file_name});
+                return false;
+            }
+            std::cout << ts::UString::Format(u"%d: %s", {event.timestamp, event.toString(opt.duck)}) << std::endl;
+        }
+        return true;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Program entry point
+//----------------------------------------------------------------------------
+
+int MainCode(int argc, char *argv[])
+{
+    Options opt(argc, argv);
+    bool success = true;
+
+    for (const auto& name : opt.in_files) {
+        success = PrintFile(opt, name) && success;
+    }
+
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
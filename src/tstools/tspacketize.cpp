@@ -153,6 +153,7 @@ int MainCode(int argc, char *argv[])
     ts::CyclingPacketizer pzer(opt.duck, opt.pid, opt.stuffing_policy, opt.bitrate);
     ts::SectionFile file(opt.duck);
     file.setCRCValidation(opt.crc_op);
+    file.setCompiledSectionCache(opt.sections_opt.compiled_cache);
 
     // Load sections
     if (opt.infiles.size() == 0) {
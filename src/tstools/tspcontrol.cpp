@@ -31,6 +31,7 @@ namespace {
         ts::TSPControlCommand cmdline {*this};
         ts::UString           command {};
         ts::IPv4SocketAddress tsp_address {};
+        bool                  session = false;
 
         // Inherited methods.
         virtual ts::UString getHelpText(HelpFormat format, size_t line_width = DEFAULT_LINE_WIDTH) const override;
@@ -42,9 +43,18 @@ Options::Options(int argc, char *argv[]) :
 {
     cmdline.setShell(ts::Args::GetAppName(argc, argv));
 
-    option(u"", 0, STRING, 1, UNLIMITED_COUNT);
+    option(u"", 0, STRING, 0, UNLIMITED_COUNT);
     help(u"", u"The control command to send to tsp.");
 
+    option(u"session", 's');
+    help(u"session",
+         u"Open a persistent control session with the tsp process. "
+         u"The control commands are read, one per line, from the standard input and "
+         u"sent on the same connection. The responses are displayed on the standard "
+         u"output, each followed by a '--end' line. This avoids reconnecting to tsp "
+         u"for each command when many commands are sent, typically status polls. "
+         u"No control command shall be specified on the command line.");
+
     option(u"tsp", 't', IPSOCKADDR_OA, 1, 1);
     help(u"tsp",
          u"Specify the IP address (or host name) and port where the tsp process "
@@ -58,12 +68,21 @@ Options::Options(int argc, char *argv[]) :
     ts::UStringVector args;
     getValues(args, u"");
     getSocketValue(tsp_address, u"tsp", ts::IPv4SocketAddress(ts::IPv4Address::LocalHost));
+    session = present(u"session");
     command.quotedLine(args);
 
+    // With --session, commands are read from the standard input.
+    if (session && !command.empty()) {
+        error(u"do not specify a control command with --session");
+    }
+    else if (!session && command.empty()) {
+        error(u"no control command specified");
+    }
+
     // Validate the control command. It will be validated inside tsp anyway
     // but let's not send an invalid command. Not all commands can be fully
     // validated outside the context of the tsp, but let's filter most errors.
-    if (!cmdline.analyzeCommand(command)) {
+    if (!session && !cmdline.analyzeCommand(command)) {
         error(u"invalid tsp control command: %s", {command});
     }
 
@@ -99,11 +118,42 @@ int MainCode(int argc, char *argv[])
     ts::IPv4SocketAddress addr;
     ts::UString resp;
 
-    if (conn.open(opt) &&
-        conn.bind(addr, opt) &&
-        conn.connect(opt.tsp_address, opt) &&
-        conn.sendLine(opt.command, opt) &&
-        conn.closeWriter(opt))
+    if (opt.session) {
+        // Persistent session: send commands from the standard input on a single
+        // connection. Each response from tsp ends with a "--end" line.
+        if (conn.open(opt) &&
+            conn.bind(addr, opt) &&
+            conn.connect(opt.tsp_address, opt) &&
+            conn.sendLine(u"--session", opt) &&
+            conn.receiveLine(resp, nullptr, opt) &&
+            resp == u"--ready")
+        {
+            std::string line;
+            bool ok = true;
+            while (ok && std::getline(std::cin, line)) {
+                ts::UString command(ts::UString::FromUTF8(line));
+                command.trim();
+                if (command.empty()) {
+                    continue;
+                }
+                // Validate the command locally before sending it, like in one-shot mode.
+                if (!opt.cmdline.analyzeCommand(command)) {
+                    opt.error(u"invalid tsp control command: %s", {command});
+                    continue;
+                }
+                ok = conn.sendLine(command, opt);
+                while (ok && (ok = conn.receiveLine(resp, nullptr, opt)) && resp != u"--end") {
+                    std::cout << resp << std::endl;
+                }
+            }
+            conn.close(opt);
+        }
+    }
+    else if (conn.open(opt) &&
+             conn.bind(addr, opt) &&
+             conn.connect(opt.tsp_address, opt) &&
+             conn.sendLine(opt.command, opt) &&
+             conn.closeWriter(opt))
     {
         // Request successfully sent, read the responses.
         while (conn.receiveLine(resp, nullptr, opt)) {
@@ -227,14 +227,10 @@ bool Resynchronizer::writePacket(const uint8_t* input_packet)
 bool Resynchronizer::checkSync(const uint8_t* buf, size_t buf_size, size_t pkt_size, size_t header_size)
 {
     assert(pkt_size >= header_size + ts::PKT_SIZE);
-    const uint8_t* end = buf + buf_size - pkt_size + 1;
 
     // Check if the buffer contains packets with the appropriate size
-    while (buf < end) {
-        if (buf[header_size] != ts::SYNC_BYTE) {
-            return false; // not found
-        }
-        buf += pkt_size;
+    if (!ts::CheckSyncPeriodicity(buf, buf_size, pkt_size, header_size)) {
+        return false; // not found
     }
 
     // Packets found all along the buffer
@@ -285,9 +281,20 @@ int MainCode(int argc, char *argv[])
         size_t const search_size = std::min(opt.contig_size, sync_size);
         uint8_t* const end_search = sync_end - search_size + 1;
 
+        // Header sizes of the candidate packet formats. A position can start a
+        // valid stream only if a sync byte follows one of these header sizes.
+        std::vector<size_t> header_sizes;
+        if (opt.packet_size > 0) {
+            header_sizes.push_back(opt.header_size);
+        }
+        else {
+            header_sizes.push_back(0);
+            header_sizes.push_back(ts::M2TS_HEADER_SIZE);
+        }
+
         // Search a range of valid packets. Try all expected packet sizes.
         const uint8_t* start;
-        for (start = sync_buf; start < end_search; start++) {
+        for (start = sync_buf; start < end_search; ) {
             if (opt.packet_size > 0) {
                 if (resync.checkSync(start, search_size, opt.packet_size, opt.header_size)) {
                     // Found user-specified encapsulation of TS packets
@@ -308,6 +315,19 @@ int MainCode(int argc, char *argv[])
                     break;
                 }
             }
+            // Jump to the next position with a sync byte after one of the candidate
+            // headers, using the vectorized scanner instead of one byte at a time.
+            const uint8_t* next = end_search;
+            for (const size_t hsize : header_sizes) {
+                const uint8_t* const from = start + 1 + hsize;
+                if (from < sync_end) {
+                    const size_t offset = ts::FindSyncByte(from, sync_end - from);
+                    if (offset != ts::NPOS && from + offset - hsize < next) {
+                        next = from + offset - hsize;
+                    }
+                }
+            }
+            start = next;
         }
         if (resync.inputPacketSize() == 0) {
             std::cerr << "* Cannot find MPEG TS packets after " << ts::UString::Decimal(search_size) << " bytes" << std::endl;
@@ -12,6 +12,7 @@
 
 #include "tsMain.h"
 #include "tsDuckContext.h"
+#include "tsThread.h"
 #include "tsTuner.h"
 #include "tsTunerArgs.h"
 #include "tsSignalState.h"
@@ -58,6 +59,7 @@ namespace {
         bool              global_services = false;
         ts::MilliSecond   psi_timeout = 0;
         const ts::HFBand* hfband = nullptr;
+        ts::UStringVector extra_tuners {};
         ts::UString       channel_file {};
         bool              update_channel_file = false;
         bool              default_channel_file = false;
@@ -148,6 +150,16 @@ ScanOptions::ScanOptions(int argc, char *argv[]) :
          u"With this option, tsscan checks all offsets and reports that the signal is at offset +1. "
          u"By default, tsscan reports that the signal is found at the central frequency of the channel (offset zero).");
 
+    option(u"parallel-tuners", 0, STRING, 0, UNLIMITED_COUNT);
+    help(u"parallel-tuners", u"name",
+         u"Specify the name of an additional tuner device to use for pipelined scanning. "
+         u"Several --parallel-tuners options may be specified. The frequency plan is "
+         u"distributed over all tuners: while the PSI/SI of a frequency are analyzed on "
+         u"one tuner, the next frequencies of the plan are already tuned and locked on "
+         u"the other ones, hiding their lock and settle time. The results are reported "
+         u"in the order of the frequency plan, regardless of the tuner which scanned "
+         u"each frequency. All tuners shall use the same reception parameters.");
+
     option(u"psi-timeout", 0, UNSIGNED);
     help(u"psi-timeout", u"milliseconds",
          u"Specifies the timeout, in milli-seconds, for PSI/SI table collection. "
@@ -212,6 +224,7 @@ ScanOptions::ScanOptions(int argc, char *argv[]) :
     list_services     = present(u"service-list");
     global_services   = present(u"global-service-list");
     psi_timeout       = intValue<ts::MilliSecond>(u"psi-timeout", DEFAULT_PSI_TIMEOUT);
+    getValues(extra_tuners, u"parallel-tuners");
 
     const bool save_channel_file = present(u"save-channels");
     update_channel_file = present(u"update-channels");
@@ -417,6 +430,146 @@ bool OffsetScanner::tryOffset(int32_t offset)
 }
 
 
+//----------------------------------------------------------------------------
+// Scan pipeline: owns one tuner and performs the tuning and signal detection
+// part of the scan in a separate thread. With several tuners, this overlaps
+// the lock and settle time of the next frequencies of the plan with the
+// PSI/SI analysis of the current one. The PSI/SI analysis itself remains
+// sequential, on the thread which calls wait().
+//----------------------------------------------------------------------------
+
+class ScanPipeline: private ts::Thread
+{
+    TS_NOBUILD_NOCOPY(ScanPipeline);
+public:
+    // Constructor / destructor. The tuner shall be already configured.
+    ScanPipeline(ScanOptions& opt, ts::Tuner& tuner);
+    virtual ~ScanPipeline() override;
+
+    // Asynchronously scan the offsets of one UHF/VHF channel.
+    // The tuner is left tuned on the best offset.
+    void submitChannel(uint32_t channel);
+
+    // Asynchronously tune to explicitly specified parameters.
+    void submitTune(const ts::ModulationArgs& params);
+
+    // Wait for the completion of the submitted operation.
+    // Return true when a signal was found and the tuner is tuned on it.
+    bool wait(ts::ModulationArgs& params, int32_t& best_offset);
+
+    // Associated tuner, to be used between wait() and the next submission only.
+    ts::Tuner& tuner() { return _tuner; }
+
+private:
+    ScanOptions& _opt;
+    ts::Tuner&   _tuner;
+    std::mutex   _mutex {};                  // Protect the following fields.
+    std::condition_variable _todo {};        // Signal a submitted operation.
+    std::condition_variable _done {};        // Signal a completed operation.
+    bool         _pending = false;           // An operation is waiting for the thread.
+    bool         _completed = false;         // The result of the operation is available.
+    bool         _terminate = false;         // Ask the thread to terminate.
+    bool         _is_channel = false;        // The operation is a channel scan, not an explicit tune.
+    bool         _signal_found = false;      // Result: a signal was found.
+    uint32_t     _channel = 0;               // Channel to scan.
+    int32_t      _best_offset = 0;           // Result: best offset in the channel.
+    ts::ModulationArgs _params {};           // Tuning parameters, in and out.
+
+    // Thread main code: execute submitted operations.
+    virtual void main() override;
+};
+
+ScanPipeline::ScanPipeline(ScanOptions& opt, ts::Tuner& tuner) :
+    _opt(opt),
+    _tuner(tuner)
+{
+    start();
+}
+
+ScanPipeline::~ScanPipeline()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _terminate = true;
+        _todo.notify_all();
+    }
+    waitForTermination();
+}
+
+void ScanPipeline::submitChannel(uint32_t channel)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _pending = true;
+    _completed = false;
+    _is_channel = true;
+    _channel = channel;
+    _todo.notify_all();
+}
+
+void ScanPipeline::submitTune(const ts::ModulationArgs& params)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _pending = true;
+    _completed = false;
+    _is_channel = false;
+    _params = params;
+    _todo.notify_all();
+}
+
+bool ScanPipeline::wait(ts::ModulationArgs& params, int32_t& best_offset)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    _done.wait(lock, [this]() { return _completed; });
+    _completed = false;
+    params = _params;
+    best_offset = _best_offset;
+    return _signal_found;
+}
+
+void ScanPipeline::main()
+{
+    for (;;) {
+        // Wait for an operation to execute.
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _todo.wait(lock, [this]() { return _pending || _terminate; });
+            if (_terminate) {
+                return;
+            }
+            _pending = false;
+        }
+
+        // Execute the operation. This is the long part, the mutex is released.
+        // The caller does not submit anything else before fetching the result.
+        bool found = false;
+        int32_t offset = 0;
+        ts::ModulationArgs params;
+        if (_is_channel) {
+            // Scan all offsets surrounding the channel, stay tuned on the best one.
+            OffsetScanner offscan(_opt, _tuner, _channel);
+            found = offscan.signalFound();
+            offset = offscan.bestOffset();
+            offscan.getTunerParameters(params);
+        }
+        else {
+            // Explicit tuning parameters. The signal lock is acquired during analysis.
+            params = _params;
+            found = _tuner.tune(params);
+        }
+
+        // Post the result.
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _params = params;
+            _best_offset = offset;
+            _signal_found = found;
+            _completed = true;
+            _done.notify_all();
+        }
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Scanning context.
 //----------------------------------------------------------------------------
@@ -432,13 +585,19 @@ public:
     void main();
 
 private:
+    // Safe pointers to tuners and scan pipelines.
+    typedef ts::SafePtr<ts::Tuner> TunerPtr;
+    typedef ts::SafePtr<ScanPipeline> PipelinePtr;
+
     ScanOptions&    _opt;
-    ts::Tuner       _tuner;
+    ts::Tuner       _tuner;       // Main tuner.
     ts::ServiceList _services;
     ts::ChannelFile _channels;
+    std::vector<TunerPtr>    _extra_tuners {};  // Additional tuners with --parallel-tuners.
+    std::vector<PipelinePtr> _pipelines {};     // One scan pipeline per tuner.
 
     // Analyze a TS and generate relevant info.
-    void scanTS(std::ostream& strm, const ts::UString& margin, ts::ModulationArgs& tparams);
+    void scanTS(std::ostream& strm, const ts::UString& margin, ts::Tuner& tuner, ts::ModulationArgs& tparams);
 
     // UHF/VHF-band scanning
     void hfBandScan();
@@ -461,13 +620,13 @@ ScanContext::ScanContext(ScanOptions& opt) :
 // Analyze a TS and generate relevant info.
 //----------------------------------------------------------------------------
 
-void ScanContext::scanTS(std::ostream& strm, const ts::UString& margin, ts::ModulationArgs& tparams)
+void ScanContext::scanTS(std::ostream& strm, const ts::UString& margin, ts::Tuner& tuner, ts::ModulationArgs& tparams)
 {
     const bool get_services = _opt.list_services || _opt.global_services;
 
     // Collect info from the TS.
     // Use "PAT only" when we do not need the services or channels file.
-    ts::TSScanner info(_opt.duck, _tuner, _opt.psi_timeout, !get_services && _opt.channel_file.empty());
+    ts::TSScanner info(_opt.duck, tuner, _opt.psi_timeout, !get_services && _opt.channel_file.empty());
 
     // Get tuning parameters again, as TSScanner waits for a lock.
     // Also keep the original frequency and polarity since satellite tuners can only report the intermediate frequency.
@@ -545,22 +704,36 @@ void ScanContext::scanTS(std::ostream& strm, const ts::UString& margin, ts::Modu
 
 void ScanContext::hfBandScan()
 {
-    // Loop on all selected UHF channels
+    const size_t ntuners = _pipelines.size();
+    uint32_t next_submit = _opt.first_channel;
+
+    // Prime the pipelines: hand the first channels of the plan to the tuners.
+    for (size_t i = 0; i < ntuners && next_submit <= _opt.last_channel; ++i) {
+        _pipelines[i]->submitChannel(next_submit++);
+    }
+
+    // Loop on all selected UHF channels, in the order of the plan.
+    // Each channel was submitted, in the same order, round-robin on the tuners.
     for (uint32_t chan = _opt.first_channel; chan <= _opt.last_channel; ++chan) {
 
-        // Scan all offsets surrounding the channel.
-        OffsetScanner offscan(_opt, _tuner, chan);
-        if (offscan.signalFound()) {
+        // Wait for the completion of the offset scan of this channel.
+        ScanPipeline& pipe(*_pipelines[(chan - _opt.first_channel) % ntuners]);
+        ts::ModulationArgs tparams;
+        int32_t best_offset = 0;
+        if (pipe.wait(tparams, best_offset)) {
 
             // A channel was found, report its characteristics.
             ts::SignalState state;
-            _tuner.getSignalState(state);
-            std::cout << "* " << _opt.hfband->description(chan, offscan.bestOffset()) << ", " << state.toString() << std::endl;
+            pipe.tuner().getSignalState(state);
+            std::cout << "* " << _opt.hfband->description(chan, best_offset) << ", " << state.toString() << std::endl;
 
             // Analyze PSI/SI if required.
-            ts::ModulationArgs tparams;
-            offscan.getTunerParameters(tparams);
-            scanTS(std::cout, u"  ", tparams);
+            scanTS(std::cout, u"  ", pipe.tuner(), tparams);
+        }
+
+        // Hand the next unassigned channel of the plan to this tuner.
+        if (next_submit <= _opt.last_channel) {
+            pipe.submitChannel(next_submit++);
         }
     }
 }
@@ -588,7 +761,8 @@ void ScanContext::nitScan()
         return;
     }
 
-    // Process each TS descriptor list in the NIT.
+    // Build the list of transponders from the TS descriptor lists in the NIT.
+    std::vector<ts::ModulationArgs> transponders;
     for (const auto& it : nit->transports) {
 
         const ts::TransportStreamId& tsid(it.first);
@@ -602,19 +776,42 @@ void ScanContext::nitScan()
                 // Copy the local reception parameters (LNB, etc.) from the command line options
                 // (we use the same reception equipment).
                 params.copyLocalReceptionParameters(_opt.tuner_args);
-                // Tune to this transponder.
-                _opt.debug(u"* tuning to " + params.toPluginOptions(true));
-                if (_tuner.tune(params)) {
-                    // Report channel characteristics
-                    ts::SignalState state;
-                    _tuner.getSignalState(state);
-                    std::cout << "* Frequency: " << params.shortDescription(_opt.duck) << ", " << state.toString() << std::endl;
-                    // Analyze PSI/SI if required
-                    scanTS(std::cout, u"  ", params);
-                }
+                transponders.push_back(params);
             }
         }
     }
+
+    // Scan all transponders, in the order of the NIT, round-robin on the tuners.
+    const size_t ntuners = _pipelines.size();
+    size_t next_submit = 0;
+
+    // Prime the pipelines: hand the first transponders to the tuners.
+    for (size_t i = 0; i < ntuners && next_submit < transponders.size(); ++i) {
+        _opt.debug(u"* tuning to " + transponders[next_submit].toPluginOptions(true));
+        _pipelines[i]->submitTune(transponders[next_submit++]);
+    }
+
+    for (size_t current = 0; current < transponders.size(); ++current) {
+
+        // Wait for the tuning of this transponder.
+        ScanPipeline& pipe(*_pipelines[current % ntuners]);
+        ts::ModulationArgs params;
+        int32_t best_offset = 0;
+        if (pipe.wait(params, best_offset)) {
+            // Report channel characteristics
+            ts::SignalState state;
+            pipe.tuner().getSignalState(state);
+            std::cout << "* Frequency: " << params.shortDescription(_opt.duck) << ", " << state.toString() << std::endl;
+            // Analyze PSI/SI if required
+            scanTS(std::cout, u"  ", pipe.tuner(), params);
+        }
+
+        // Hand the next unassigned transponder to this tuner.
+        if (next_submit < transponders.size()) {
+            _opt.debug(u"* tuning to " + transponders[next_submit].toPluginOptions(true));
+            pipe.submitTune(transponders[next_submit++]);
+        }
+    }
 }
 
 
@@ -630,7 +827,27 @@ void ScanContext::main()
         return;
     }
 
+    // Initialize the additional tuners with --parallel-tuners.
+    // They use the same reception parameters as the main one, except the device name.
+    for (const auto& name : _opt.extra_tuners) {
+        ts::TunerArgs targs(_opt.tuner_args);
+        targs.device_name = name;
+        TunerPtr tuner(new ts::Tuner(_opt.duck));
+        tuner->setSignalTimeoutSilent(true);
+        if (!targs.configureTuner(*tuner)) {
+            return;
+        }
+        _extra_tuners.push_back(tuner);
+    }
+
+    // Create the scan pipelines, one per tuner.
+    _pipelines.push_back(new ScanPipeline(_opt, _tuner));
+    for (const auto& tuner : _extra_tuners) {
+        _pipelines.push_back(new ScanPipeline(_opt, *tuner));
+    }
+
     // Pre-load the existing channel file.
+    _channels.setCompiledCache(true);
     if (_opt.update_channel_file && !_opt.channel_file.empty() && fs::exists(_opt.channel_file) && !_channels.load(_opt.channel_file, _opt)) {
         return;
     }
@@ -23,6 +23,7 @@ static constexpr size_t   MIN_TS_BUFFER_SIZE     = 1024;             // 1 kB
 static constexpr size_t   DEFAULT_TS_BUFFER_SIZE = 4 * 1024 * 1024;  // 4 MB
 static constexpr size_t   MAX_TS_BUFFER_SIZE     = 16 * 1024 * 1024; // 16 MB
 static constexpr uint64_t DEFAULT_MIN_INTERVAL   = 100;              // milliseconds
+static constexpr size_t   STUFFING_WRITE_PAGE    = 64;               // null packets per write operation
 
 namespace {
     class Options: public ts::Args
@@ -247,11 +248,16 @@ bool Stuffer::getTimeStamp(const ts::TSPacket& pkt, uint64_t& tstamp) const
 
 void Stuffer::writeStuffing(uint64_t count)
 {
+    // Pre-built page of null packets, written in bulk instead of one by one.
+    // All null packets are identical, the continuity counter is meaningless on the null PID.
+    static const std::vector<ts::TSPacket> page(STUFFING_WRITE_PAGE, ts::NullPacket);
+
     while (count > 0) {
-        if (!_output.writePackets(&ts::NullPacket, nullptr, 1, _opt)) {
+        const size_t chunk = size_t(std::min<uint64_t>(count, page.size()));
+        if (!_output.writePackets(page.data(), nullptr, chunk, _opt)) {
             fatalError();
         }
-        count--;
+        count -= chunk;
     }
 }
 
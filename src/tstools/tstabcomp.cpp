@@ -17,6 +17,7 @@
 #include "tsReportWithPrefix.h"
 #include "tsFileUtils.h"
 #include "tsSysUtils.h"
+#include "tsThread.h"
 TS_MAIN(MainCode);
 
 
@@ -39,6 +40,8 @@ namespace {
         bool                useStdOut = false;       // Use standard output.
         bool                compile = false;         // Explicit compilation.
         bool                decompile = false;       // Explicit decompilation.
+        bool                incremental = false;     // Skip files whose output is up to date.
+        size_t              parallel = 0;            // Number of worker threads, 0 for sequential processing.
         bool                fromJSON = false;        // All input files are JSON.
         bool                toJSON = false;          // Decompile to JSON.
         bool                xmlModel = false;        // Display XML model instead of compilation.
@@ -90,6 +93,12 @@ Options::Options(int argc, char *argv[]) :
          u"This is automatically detected for file names ending in .json. "
          u"This option is only required when the input file name has a non-standard extension or is the standard input.");
 
+    option(u"incremental", 'i');
+    help(u"incremental",
+         u"Process only the files whose output is missing or older than the input file. "
+         u"Up-to-date output files are left untouched. "
+         u"This option is ignored for the standard input or output.");
+
     option(u"json", 'j');
     help(u"json",
          u"When decompiling, perform an automated XML-to-JSON conversion. "
@@ -105,6 +114,14 @@ Options::Options(int argc, char *argv[]) :
          u"The default output file for the standard input (\"-\") is the standard output (\"-\"). "
          u"If more than one input file is specified, the output path, if present, must be either a directory name or \"-\".");
 
+    option(u"parallel", 'p', INTEGER, 0, 1, 1, 256, true);
+    help(u"parallel", u"threads",
+         u"Process the input files in parallel, using several threads. "
+         u"Each thread parses the XML model once and reuses it for all its files. "
+         u"The optional value is the number of threads to use; the default is the "
+         u"number of processor cores. "
+         u"This option cannot be used with the standard input or output.");
+
     option(u"xml-model", 'x');
     help(u"xml-model",
          u"Display the XML model of the table files. This model is not a full "
@@ -122,6 +139,10 @@ Options::Options(int argc, char *argv[]) :
     getValue(outFile, u"output");
     compile = present(u"compile");
     decompile = present(u"decompile");
+    incremental = present(u"incremental");
+    if (present(u"parallel")) {
+        parallel = intValue<size_t>(u"parallel", std::max<size_t>(1, std::thread::hardware_concurrency()));
+    }
     fromJSON = present(u"from-json");
     toJSON = present(u"json") || outFile.endWith(ts::SectionFile::DEFAULT_JSON_SECTION_FILE_SUFFIX);
     xmlModel = present(u"xml-model");
@@ -145,6 +166,9 @@ Options::Options(int argc, char *argv[]) :
     if (compile && decompile) {
         error(u"specify either --compile or --decompile but not both");
     }
+    if (parallel > 0 && (useStdIn || useStdOut)) {
+        error(u"--parallel cannot be used with the standard input or output");
+    }
 
     exitOnError();
 }
@@ -180,7 +204,7 @@ namespace {
 //----------------------------------------------------------------------------
 
 namespace {
-    bool ProcessFile(Options& opt, const ts::UString& infile)
+    bool ProcessFile(Options& opt, ts::SectionFile& file, const ts::UString& infile)
     {
         typedef ts::SectionFile::FileType FType;
 
@@ -210,9 +234,18 @@ namespace {
             }
         }
 
-        ts::SectionFile file(opt.duck);
-        file.setTweaks(opt.xmlTweaks);
-        file.setCRCValidation(ts::CRC32::CHECK);
+        // With --incremental, skip the file when its output is up to date.
+        if (opt.incremental && !useStdIn && !useStdOut) {
+            const ts::Time intime(ts::GetFileModificationTimeUTC(infile));
+            if (intime != ts::Time::Epoch && ts::GetFileModificationTimeUTC(outname) > intime) {
+                opt.verbose(u"%s is up to date", {outname});
+                return true;
+            }
+        }
+
+        // The section file object is reused from one file to the next,
+        // so that the XML model is parsed only once.
+        file.clear();
 
         ts::ReportWithPrefix report(opt, (useStdIn ? u"stdin" : ts::BaseName(infile)) + u": ");
 
@@ -247,6 +280,52 @@ namespace {
 }
 
 
+//----------------------------------------------------------------------------
+//  Worker thread for --parallel.
+//----------------------------------------------------------------------------
+
+namespace {
+    class CompilerThread: public ts::Thread
+    {
+        TS_NOBUILD_NOCOPY(CompilerThread);
+    public:
+        // The constructor is invoked in the main thread, before starting any worker.
+        CompilerThread(Options& opt, std::atomic<size_t>& next, std::atomic<bool>& success) :
+            _opt(opt), _next(next), _success(success), _duck(&opt)
+        {
+            _duck.loadArgs(opt);
+        }
+        virtual ~CompilerThread() override
+        {
+            waitForTermination();
+        }
+        virtual void main() override
+        {
+            // One section file per worker: each thread parses the XML model once
+            // and reuses it, read-only, for all the files it processes.
+            ts::SectionFile file(_duck);
+            file.setTweaks(_opt.xmlTweaks);
+            file.setCRCValidation(ts::CRC32::CHECK);
+            file.setCompiledSectionCache(_opt.sectionOptions.compiled_cache);
+            for (;;) {
+                const size_t i = _next.fetch_add(1);
+                if (i >= _opt.inFiles.size()) {
+                    break;
+                }
+                if (!_opt.inFiles[i].empty() && !ProcessFile(_opt, file, _opt.inFiles[i])) {
+                    _success = false;
+                }
+            }
+        }
+    private:
+        Options&              _opt;
+        std::atomic<size_t>&  _next;     // Index of next input file to process.
+        std::atomic<bool>&    _success;  // Cleared by any worker on error.
+        ts::DuckContext       _duck;     // Each worker has its own context, loadArgs() is not thread-safe.
+    };
+}
+
+
 //----------------------------------------------------------------------------
 //  Program entry point
 //----------------------------------------------------------------------------
@@ -258,10 +337,34 @@ int MainCode(int argc, char *argv[])
     if (opt.xmlModel) {
         ok = DisplayModel(opt);
     }
+    else if (opt.parallel > 0) {
+        // Parallel processing: the input files are distributed over a pool of worker threads.
+        // Do not create more threads than input files.
+        std::atomic<size_t> next(0);
+        std::atomic<bool> success(true);
+        std::list<ts::SafePtr<CompilerThread>> workers;
+        const size_t count = std::min(opt.parallel, opt.inFiles.size());
+        for (size_t n = 0; n < count; ++n) {
+            workers.push_back(new CompilerThread(opt, next, success));
+        }
+        for (const auto& th : workers) {
+            th->start();
+        }
+        for (const auto& th : workers) {
+            th->waitForTermination();
+        }
+        ok = success;
+    }
     else {
+        // Sequential processing. The section file object is reused from one
+        // file to the next, so that the XML model is parsed only once.
+        ts::SectionFile file(opt.duck);
+        file.setTweaks(opt.xmlTweaks);
+        file.setCRCValidation(ts::CRC32::CHECK);
+        file.setCompiledSectionCache(opt.sectionOptions.compiled_cache);
         for (size_t i = 0; i < opt.inFiles.size(); ++i) {
             if (!opt.inFiles[i].empty()) {
-                ok = ProcessFile(opt, opt.inFiles[i]) && ok;
+                ok = ProcessFile(opt, file, opt.inFiles[i]) && ok;
             }
         }
     }
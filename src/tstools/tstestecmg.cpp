@@ -20,6 +20,8 @@
 #include "tsAsyncReport.h"
 #include "tsNullReport.h"
 #include "tsSingleDataStatistics.h"
+#include "tsTime.h"
+#include <random>
 TS_MAIN(MainCode);
 
 
@@ -41,6 +43,9 @@ namespace {
         uint32_t              super_cas_id = 0;
         ts::ByteBlock         access_criteria {};
         ts::Second            cp_duration = 0;
+        ts::Second            cp_duration_min = 0;
+        ts::Second            cp_duration_max = 0;
+        bool                  max_rate = false;
         ts::Second            stat_interval = 0;
         ts::tlv::VERSION      dvbsim_version = 0;
         uint16_t              channel_count = 0;
@@ -82,6 +87,18 @@ CmdOptions::CmdOptions(int argc, char *argv[]) :
          u"Specify the crypto-period duration in seconds. "
          u"The default is 10 seconds.");
 
+    option(u"cp-duration-max", 0, Args::POSITIVE);
+    help(u"cp-duration-max", u"seconds",
+         u"With --cp-duration-min, specify the maximum crypto-period duration in seconds. "
+         u"The duration of each crypto-period is uniformly drawn between the minimum and maximum values. "
+         u"By default, all crypto-periods last --cp-duration.");
+
+    option(u"cp-duration-min", 0, Args::POSITIVE);
+    help(u"cp-duration-min", u"seconds",
+         u"With --cp-duration-max, specify the minimum crypto-period duration in seconds. "
+         u"The duration of each crypto-period is uniformly drawn between the minimum and maximum values. "
+         u"By default, all crypto-periods last --cp-duration.");
+
     option(u"cw-size", 0, Args::POSITIVE);
     help(u"cw-size", u"bytes",
          u"Specify the size in bytes of control words. "
@@ -127,6 +144,12 @@ CmdOptions::CmdOptions(int argc, char *argv[]) :
          u"Stop the test after generating the specified number of ECM's. "
          u"By default, the test endlessly runs.");
 
+    option(u"max-rate", 0);
+    help(u"max-rate",
+         u"Ignore the crypto-period pacing and request the next ECM on each stream as soon as "
+         u"the previous response is received. The ECMG is permanently saturated and the "
+         u"reported rate is the maximum number of crypto-periods per second it sustains.");
+
     option(u"max-seconds", 0, Args::UNSIGNED);
     help(u"max-seconds", u"seconds",
          u"Stop the test after the specified number of seconds. "
@@ -163,6 +186,9 @@ CmdOptions::CmdOptions(int argc, char *argv[]) :
     getIntValue(super_cas_id, u"super-cas-id");
     getHexaValue(access_criteria, u"access-criteria");
     getIntValue(cp_duration, u"cp-duration", 10);
+    getIntValue(cp_duration_min, u"cp-duration-min", cp_duration);
+    getIntValue(cp_duration_max, u"cp-duration-max", cp_duration);
+    max_rate = present(u"max-rate");
     getIntValue(stat_interval, u"statistics-interval", 10);
     getIntValue(max_ecm, u"max-ecm");
     getIntValue(max_seconds, u"max-seconds");
@@ -179,6 +205,9 @@ CmdOptions::CmdOptions(int argc, char *argv[]) :
     if (size_t(first_ecm_id) + size_t(channel_count) * size_t(streams_per_channel) > 0x10000) {
         error(u"combination of --channels and --streams-per-channel too large for --first-ecm-id");
     }
+    if (cp_duration_min > cp_duration_max) {
+        error(u"--cp-duration-min is greater than --cp-duration-max");
+    }
 
     // Specify which ECMG <=> SCS version to use.
     ecmgscs.setVersion(dvbsim_version);
@@ -304,6 +333,59 @@ bool EventQueue::waitEvent(uint16_t& channel_id, uint16_t& stream_id)
 }
 
 
+//----------------------------------------------------------------------------
+// A histogram of latencies, millisecond resolution, used for percentiles.
+//----------------------------------------------------------------------------
+
+namespace {
+    class LatencyStat
+    {
+    public:
+        LatencyStat() = default;
+
+        // Feed one latency value.
+        void feed(ts::MilliSecond time)
+        {
+            _histo[size_t(std::max<ts::MilliSecond>(0, std::min<ts::MilliSecond>(time, MAX_LATENCY)))]++;
+            _count++;
+        }
+
+        // Number of accumulated values.
+        size_t count() const { return _count; }
+
+        // Latency under which the specified proportion (in 1/1000) of values fall.
+        ts::MilliSecond percentile(size_t permille) const;
+
+        // Reset the histogram.
+        void reset() { _histo.assign(_histo.size(), 0); _count = 0; }
+
+    private:
+        // Latencies above this value are clamped in the last bucket.
+        static constexpr ts::MilliSecond MAX_LATENCY = 10000;
+
+        std::vector<uint32_t> _histo = std::vector<uint32_t>(size_t(MAX_LATENCY) + 1, 0);
+        size_t                _count = 0;
+    };
+}
+
+// Latency under which the specified proportion (in 1/1000) of values fall.
+ts::MilliSecond LatencyStat::percentile(size_t permille) const
+{
+    if (_count == 0) {
+        return 0;
+    }
+    const size_t rank = std::max<size_t>(1, (_count * permille + 999) / 1000);
+    size_t cumul = 0;
+    for (size_t ms = 0; ms < _histo.size(); ++ms) {
+        cumul += _histo[ms];
+        if (cumul >= rank) {
+            return ts::MilliSecond(ms);
+        }
+    }
+    return MAX_LATENCY; // not reached
+}
+
+
 //----------------------------------------------------------------------------
 // A class reporting statistics.
 //----------------------------------------------------------------------------
@@ -320,6 +402,7 @@ namespace {
         // Provide statistics.
         void oneRequest() { _request_count.fetch_add(1); }
         void oneResponse(ts::MilliSecond time);
+        void oneSetupResponse(ts::MilliSecond time);
 
         // Thread main code.
         virtual void main() override;
@@ -338,9 +421,14 @@ namespace {
         std::condition_variable    _condition {};
         ResponseStat               _instant_response {};
         ResponseStat               _global_response {};
+        LatencyStat                _instant_latency {};
+        LatencyStat                _global_latency {};
+        LatencyStat                _setup_latency {};
+        ts::Time                   _start_time {ts::Time::CurrentUTC()};
+        ts::Time                   _last_report {_start_time};
 
         // Report statistics. Must be called with mutex held.
-        void reportStatistics(const ResponseStat& stat);
+        void reportStatistics(const ResponseStat& stat, const LatencyStat& lat, const ts::Time& since);
     };
 }
 
@@ -364,15 +452,26 @@ void CmdStatistics::oneResponse(ts::MilliSecond time)
     std::lock_guard<std::mutex> lock(_mutex);
     _instant_response.feed(time);
     _global_response.feed(time);
+    _instant_latency.feed(time);
+    _global_latency.feed(time);
+}
+
+void CmdStatistics::oneSetupResponse(ts::MilliSecond time)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _setup_latency.feed(time);
 }
 
 // Report statistics. Must be called with mutex held.
-void CmdStatistics::reportStatistics(const ResponseStat& stat)
+void CmdStatistics::reportStatistics(const ResponseStat& stat, const LatencyStat& lat, const ts::Time& since)
 {
-    _report.info(u"req: %'d, ecm: %'d, response mean: %s ms, min: %d, max: %d, dev: %s",
-                 {_request_count.load(), _global_response.count(),
+    const ts::MilliSecond elapsed = ts::Time::CurrentUTC() - since;
+    const double rate = elapsed <= 0 ? 0.0 : double(lat.count()) * 1000.0 / double(elapsed);
+    _report.info(u"req: %'d, ecm: %'d, rate: %.1f cp/s, response mean: %s ms, min: %d, max: %d, dev: %s, p50: %d, p99: %d, p999: %d",
+                 {_request_count.load(), _global_response.count(), rate,
                   stat.meanString(0, 3), stat.minimum(), stat.maximum(),
-                  stat.standardDeviationString(0, 3)});
+                  stat.standardDeviationString(0, 3),
+                  lat.percentile(500), lat.percentile(990), lat.percentile(999)});
 }
 
 // Thread code.
@@ -387,13 +486,19 @@ void CmdStatistics::main()
             _condition.wait_for(lock, std::chrono::seconds(std::chrono::seconds::rep(_opt.stat_interval)));
         }
         if (!_terminate) {
-            reportStatistics(_instant_response);
+            reportStatistics(_instant_response, _instant_latency, _last_report);
             _instant_response.reset();
+            _instant_latency.reset();
+            _last_report = ts::Time::CurrentUTC();
         }
     }
     {
         std::lock_guard<std::mutex> lock(_mutex);
-        reportStatistics(_global_response);
+        reportStatistics(_global_response, _global_latency, _start_time);
+        if (_setup_latency.count() > 0) {
+            _report.info(u"stream_setup: %'d responses, p50: %d ms, p99: %d, p999: %d",
+                         {_setup_latency.count(), _setup_latency.percentile(500), _setup_latency.percentile(990), _setup_latency.percentile(999)});
+        }
     }
 }
 
@@ -440,6 +545,10 @@ namespace {
         void abort();
 
     private:
+        // Stack size of the reception thread. The default stack size would limit the
+        // number of channels when simulating thousands of concurrent connections.
+        static constexpr size_t RECEIVER_STACK_SIZE = 128 * 1024;
+
         // Description of one stream.
         class Stream
         {
@@ -448,6 +557,7 @@ namespace {
             bool     closing = false;
             uint16_t cp_number = 0;
             ts::Time start_request {};
+            ts::Time start_setup {};
 
             Stream() = default;
         };
@@ -466,6 +576,8 @@ namespace {
         std::recursive_mutex        _mutex {};        // protect subsequent fields
         std::condition_variable_any _completed {};    // signalled by reception thread when all streams are closed.
         std::vector<Stream>         _streams {};
+        std::mt19937                _cp_prng;         // crypto-period duration distribution, used by reception thread only
+        std::uniform_int_distribution<ts::MilliSecond> _cp_dist;
 
         // Check the validity of a received message.
         bool checkChannelMessage(const ts::tlv::ChannelMessage* mp, const ts::UChar* message_name);
@@ -478,6 +590,7 @@ namespace {
 
 // Constructor.
 ECMGConnection::ECMGConnection(const CmdOptions& opt, CmdStatistics& stat, EventQueue& events, ts::Report& report, uint16_t index) :
+    ts::Thread(ts::ThreadAttributes().setStackSize(RECEIVER_STACK_SIZE)),
     _opt(opt),
     _stat(stat),
     _events(events),
@@ -487,7 +600,9 @@ ECMGConnection::ECMGConnection(const CmdOptions& opt, CmdStatistics& stat, Event
     _first_ecm_id(_opt.first_ecm_id + index * _opt.streams_per_channel),
     _first_stream_id(_opt.first_ecm_stream_id),
     _end_stream_id(_opt.first_ecm_stream_id + _opt.streams_per_channel),
-    _streams(_opt.streams_per_channel)
+    _streams(_opt.streams_per_channel),
+    _cp_prng(std::random_device{}()),
+    _cp_dist(_opt.cp_duration_min * ts::MilliSecPerSec, _opt.cp_duration_max * ts::MilliSecPerSec)
 {
     // Set logging levels for ECM messages.
     _logger.setSeverity(ts::ecmgscs::Tags::CW_provision, _opt.log_data);
@@ -624,6 +739,7 @@ bool ECMGConnection::sendStreamSetup(uint16_t stream_id)
         msg.stream_id = stream_id;
         msg.ECM_id = uint16_t(_first_ecm_id + index);
         msg.nominal_CP_duration = uint16_t(_opt.cp_duration * 10); // unit is 100 ms
+        _streams[index].start_setup = ts::Time::CurrentUTC();
         return _conn.send(msg, _logger);
     }
 }
@@ -709,6 +825,10 @@ void ECMGConnection::main()
                     if (!stream.ready) {
                         // This is a response to stream_setup.
                         stream.ready = true;
+                        if (stream.start_setup != ts::Time::Epoch) {
+                            _stat.oneSetupResponse(ts::Time::CurrentUTC() - stream.start_setup);
+                            stream.start_setup = ts::Time::Epoch;
+                        }
                         // Start sending requests to this stream.
                         ok = sendRequest(mp->stream_id);
                         // Setup the next stream.
@@ -749,9 +869,16 @@ void ECMGConnection::main()
                     }
                     else {
                         // Log current request response time.
-                        _stat.oneResponse(ts::Time::CurrentUTC() - stream.start_request);
-                        // Schedule next request.
-                        _events.postRequest(stream.start_request + _opt.cp_duration * ts::MilliSecPerSec, mp->channel_id, mp->stream_id);
+                        const ts::Time now(ts::Time::CurrentUTC());
+                        _stat.oneResponse(now - stream.start_request);
+                        // Schedule next request: immediately in --max-rate mode, otherwise
+                        // after a crypto-period duration drawn in the configured range.
+                        if (_opt.max_rate) {
+                            _events.postRequest(now, mp->channel_id, mp->stream_id);
+                        }
+                        else {
+                            _events.postRequest(stream.start_request + _cp_dist(_cp_prng), mp->channel_id, mp->stream_id);
+                        }
                         stream.start_request = ts::Time::Epoch;
                     }
                 }
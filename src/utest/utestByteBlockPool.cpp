@@ -0,0 +1,105 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for class ts::ByteBlockPool
+//
+//----------------------------------------------------------------------------
+
+#include "tsByteBlockPool.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class ByteBlockPoolTest: public tsunit::Test
+{
+public:
+    virtual void beforeTest() override;
+    virtual void afterTest() override;
+
+    void testReuse();
+    void testMaxBlocks();
+
+    TSUNIT_TEST_BEGIN(ByteBlockPoolTest);
+    TSUNIT_TEST(testReuse);
+    TSUNIT_TEST(testMaxBlocks);
+    TSUNIT_TEST_END();
+};
+
+TSUNIT_REGISTER(ByteBlockPoolTest);
+
+
+//----------------------------------------------------------------------------
+// Initialization.
+//----------------------------------------------------------------------------
+
+// Test suite initialization method.
+void ByteBlockPoolTest::beforeTest()
+{
+}
+
+// Test suite cleanup method.
+void ByteBlockPoolTest::afterTest()
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+void ByteBlockPoolTest::testReuse()
+{
+    ts::ByteBlockPool pool;
+    TSUNIT_EQUAL(0, pool.size());
+
+    // Acquire one block and keep a reference on it.
+    ts::ByteBlockPtr block1(pool.acquire());
+    TSUNIT_ASSERT(!block1.isNull());
+    TSUNIT_EQUAL(1, pool.size());
+    block1->appendUInt32(0x12345678);
+
+    // The block is in use, a second acquire must return another one.
+    ts::ByteBlockPtr block2(pool.acquire());
+    TSUNIT_ASSERT(!block2.isNull());
+    TSUNIT_ASSERT(block1.pointer() != block2.pointer());
+    TSUNIT_EQUAL(2, pool.size());
+
+    // Release the first block, it must be reused.
+    const ts::ByteBlock* const addr1 = block1.pointer();
+    block1.clear();
+    ts::ByteBlockPtr block3(pool.acquire());
+    TSUNIT_ASSERT(block3.pointer() == addr1);
+    TSUNIT_EQUAL(2, pool.size());
+}
+
+void ByteBlockPoolTest::testMaxBlocks()
+{
+    ts::ByteBlockPool pool(2);
+
+    // Keep references on more blocks than the pool can hold.
+    std::vector<ts::ByteBlockPtr> blocks;
+    for (size_t i = 0; i < 5; ++i) {
+        blocks.push_back(pool.acquire());
+        TSUNIT_ASSERT(!blocks.back().isNull());
+    }
+    TSUNIT_EQUAL(2, pool.size());
+
+    // Released supernumerary blocks simply disappear.
+    blocks.clear();
+    TSUNIT_EQUAL(2, pool.size());
+
+    // Shrinking the pool drops blocks.
+    pool.setMaxBlocks(1);
+    TSUNIT_EQUAL(1, pool.size());
+    pool.clear();
+    TSUNIT_EQUAL(0, pool.size());
+    TSUNIT_ASSERT(!pool.acquire().isNull());
+}
@@ -0,0 +1,159 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for ts::ByteBlockSlice
+//
+//----------------------------------------------------------------------------
+
+#include "tsByteBlockSlice.h"
+#include "tsSection.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class ByteBlockSliceTest: public tsunit::Test
+{
+public:
+    virtual void beforeTest() override;
+    virtual void afterTest() override;
+
+    void testSharing();
+    void testCopyOnWrite();
+    void testSubSlice();
+    void testSectionPayload();
+
+    TSUNIT_TEST_BEGIN(ByteBlockSliceTest);
+    TSUNIT_TEST(testSharing);
+    TSUNIT_TEST(testCopyOnWrite);
+    TSUNIT_TEST(testSubSlice);
+    TSUNIT_TEST(testSectionPayload);
+    TSUNIT_TEST_END();
+};
+
+TSUNIT_REGISTER(ByteBlockSliceTest);
+
+
+//----------------------------------------------------------------------------
+// Initialization.
+//----------------------------------------------------------------------------
+
+// Test suite initialization method.
+void ByteBlockSliceTest::beforeTest()
+{
+}
+
+// Test suite cleanup method.
+void ByteBlockSliceTest::afterTest()
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+void ByteBlockSliceTest::testSharing()
+{
+    ts::ByteBlockPtr bb(new ts::ByteBlock({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+
+    ts::ByteBlockSlice s1(bb, 2, 5);
+    TSUNIT_ASSERT(!s1.empty());
+    TSUNIT_EQUAL(5, s1.size());
+    TSUNIT_EQUAL(bb->data() + 2, s1.data());
+    TSUNIT_EQUAL(2, s1.data()[0]);
+    TSUNIT_ASSERT(s1.isShared()); // shared with bb
+
+    // Copying a slice shares the data.
+    ts::ByteBlockSlice s2(s1);
+    TSUNIT_EQUAL(s1.data(), s2.data());
+    TSUNIT_ASSERT(s1 == s2);
+
+    // Bounds are clipped to the actual data.
+    ts::ByteBlockSlice s3(bb, 8, 100);
+    TSUNIT_EQUAL(2, s3.size());
+    ts::ByteBlockSlice s4(bb, 100, 100);
+    TSUNIT_ASSERT(s4.empty());
+    TSUNIT_ASSERT(s4.data() == nullptr);
+
+    // The slice keeps the data alive after the last ByteBlockPtr is gone.
+    bb.clear();
+    TSUNIT_EQUAL(2, s1.data()[0]);
+    TSUNIT_EQUAL(6, s1.data()[4]);
+}
+
+void ByteBlockSliceTest::testCopyOnWrite()
+{
+    ts::ByteBlockPtr bb(new ts::ByteBlock({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+    ts::ByteBlockSlice s1(bb, 2, 5);
+
+    // Write access while shared must detach a private copy of the slice only.
+    uint8_t* p = s1.udata();
+    TSUNIT_ASSERT(p != nullptr);
+    TSUNIT_ASSERT(p != bb->data() + 2);
+    TSUNIT_ASSERT(!s1.isShared());
+    p[0] = 0xAB;
+    TSUNIT_EQUAL(0xAB, s1.data()[0]);
+    TSUNIT_EQUAL(2, (*bb)[2]); // original untouched
+
+    // Write access while not shared must not copy again.
+    TSUNIT_EQUAL(p, s1.udata());
+
+    // Conversion to byte block copies the slice content.
+    const ts::ByteBlock copy(s1.toByteBlock());
+    TSUNIT_EQUAL(5, copy.size());
+    TSUNIT_EQUAL(0xAB, copy[0]);
+    TSUNIT_EQUAL(6, copy[4]);
+}
+
+void ByteBlockSliceTest::testSubSlice()
+{
+    ts::ByteBlockPtr bb(new ts::ByteBlock({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+    ts::ByteBlockSlice s1(bb); // whole block
+    TSUNIT_EQUAL(10, s1.size());
+
+    const ts::ByteBlockSlice s2(s1.subSlice(4, 3));
+    TSUNIT_EQUAL(3, s2.size());
+    TSUNIT_EQUAL(bb->data() + 4, s2.data());
+    TSUNIT_EQUAL(4, s2.data()[0]);
+
+    // Sub-slice of a sub-slice, clipped to its parent.
+    const ts::ByteBlockSlice s3(s2.subSlice(2, 100));
+    TSUNIT_EQUAL(1, s3.size());
+    TSUNIT_EQUAL(6, s3.data()[0]);
+
+    // In-place trimming.
+    s1.trim(9);
+    TSUNIT_EQUAL(1, s1.size());
+    TSUNIT_EQUAL(9, s1.data()[0]);
+    s1.trim(5);
+    TSUNIT_ASSERT(s1.empty());
+}
+
+void ByteBlockSliceTest::testSectionPayload()
+{
+    // A minimal short section: table id 0xAB, 4-byte payload.
+    static const uint8_t data[] = {0xAB, 0x30, 0x04, 0x10, 0x20, 0x30, 0x40};
+    const ts::Section sec(data, sizeof(data));
+    TSUNIT_ASSERT(sec.isValid());
+    TSUNIT_EQUAL(4, sec.payloadSize());
+
+    // The payload slice shares the section data, without copy.
+    const ts::ByteBlockSlice payload(sec.payloadSlice());
+    TSUNIT_EQUAL(4, payload.size());
+    TSUNIT_EQUAL(sec.payload(), payload.data());
+    TSUNIT_EQUAL(0x10, payload.data()[0]);
+    TSUNIT_EQUAL(0x40, payload.data()[3]);
+
+    // The content slice covers the full section.
+    const ts::ByteBlockSlice content(sec.contentSlice());
+    TSUNIT_EQUAL(sec.size(), content.size());
+    TSUNIT_EQUAL(sec.content(), content.data());
+}
@@ -26,9 +26,11 @@ public:
     virtual void afterTest() override;
 
     void testCRC();
+    void testCombine();
 
     TSUNIT_TEST_BEGIN(CRC32Test);
     TSUNIT_TEST(testCRC);
+    TSUNIT_TEST(testCombine);
     TSUNIT_TEST_END();
 };
 
@@ -179,7 +181,50 @@ void CRC32Test::testCRC()
         c.add(data->data + chunk_size, chunk_size);
         c.add(data->data + 2 * chunk_size, data->data_size - 2 * chunk_size);
         TSUNIT_EQUAL(data->crc, c.value());
+
+        // Test in scatter-gather form, over the same 3 fragments.
+        const ts::CRC32 sg({
+            {data->data, chunk_size},
+            {data->data + chunk_size, chunk_size},
+            {data->data + 2 * chunk_size, data->data_size - 2 * chunk_size},
+        });
+        TSUNIT_EQUAL(data->crc, sg.value());
+
+        // Same test with a dynamic list of fragments.
+        std::vector<ts::CRC32::Fragment> frags;
+        for (size_t start = 0; start < data->data_size; start += 7) {
+            frags.push_back({data->data + start, std::min<size_t>(7, data->data_size - start)});
+        }
+        c.reset();
+        c.add(frags);
+        TSUNIT_EQUAL(data->crc, c.value());
     }
 
     bench.report(u"CRC32Test::testCRC");
 }
+
+void CRC32Test::testCombine()
+{
+    for (const auto* data = all_data; data->data_size != 0; ++data) {
+
+        // Compute the CRC of 3 chunks independently, then combine them.
+        const size_t chunk_size = data->data_size / 3;
+        const ts::CRC32 c1(data->data, chunk_size);
+        const ts::CRC32 c2(data->data + chunk_size, chunk_size);
+        const ts::CRC32 c3(data->data + 2 * chunk_size, data->data_size - 2 * chunk_size);
+
+        ts::CRC32 c;
+        c.combine(c1, chunk_size);
+        c.combine(c2, chunk_size);
+        c.combine(c3, data->data_size - 2 * chunk_size);
+        TSUNIT_EQUAL(data->crc, c.value());
+
+        // Combining the CRC of an empty area is a no-op.
+        c.reset();
+        c.combine(c1, chunk_size);
+        c.combine(ts::CRC32(), 0);
+        c.combine(c2, chunk_size);
+        c.combine(c3, data->data_size - 2 * chunk_size);
+        TSUNIT_EQUAL(data->crc, c.value());
+    }
+}
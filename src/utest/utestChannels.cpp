@@ -12,6 +12,8 @@
 
 #include "tsChannelFile.h"
 #include "tsNullReport.h"
+#include "tsFileUtils.h"
+#include "tsErrCodeReport.h"
 #include "tsunit.h"
 
 
@@ -26,9 +28,11 @@ public:
     virtual void afterTest() override;
 
     void testText();
+    void testCompiledCache();
 
     TSUNIT_TEST_BEGIN(ChannelsTest);
     TSUNIT_TEST(testText);
+    TSUNIT_TEST(testCompiledCache);
     TSUNIT_TEST_END();
 };
 
@@ -210,3 +214,69 @@ void ChannelsTest::testText()
 
     TSUNIT_EQUAL(document, channels.toXML());
 }
+
+void ChannelsTest::testCompiledCache()
+{
+    static const ts::UChar* const document =
+        u"<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        u"<tsduck>\n"
+        u"  <network id=\"0x7883\" type=\"DVB-C\">\n"
+        u"    <ts id=\"0x7890\" onid=\"0x7412\">\n"
+        u"      <dvbc frequency=\"789,654,123\" symbolrate=\"6,900,000\" modulation=\"64-QAM\"/>\n"
+        u"      <service id=\"0x0102\" name=\"Azerty\" provider=\"Qwerty\" LCN=\"48\" PMTPID=\"0x1368\" type=\"0x78\" cas=\"false\"/>\n"
+        u"      <service id=\"0x0879\"/>\n"
+        u"    </ts>\n"
+        u"  </network>\n"
+        u"  <network id=\"0x8753\" type=\"DVB-S\">\n"
+        u"    <ts id=\"0x8793\" onid=\"0x5896\">\n"
+        u"      <dvbs frequency=\"8,523,698\" symbolrate=\"1,237,418\" modulation=\"8-PSK\" system=\"DVB-S2\" polarity=\"horizontal\" FEC=\"7/8\" pilots=\"on\" rolloff=\"0.35\"/>\n"
+        u"      <service id=\"0x4591\" name=\"Foo Channel\"/>\n"
+        u"    </ts>\n"
+        u"  </network>\n"
+        u"</tsduck>\n"
+        u"";
+
+    const ts::UString xmlName(ts::TempFile(u".tmp.xml"));
+    const ts::UString cacheName(xmlName + ts::ChannelFile::DEFAULT_CACHE_FILE_SUFFIX);
+    fs::remove(cacheName, &ts::ErrCodeReport());
+
+    // Build the XML channel file.
+    ts::ChannelFile out;
+    TSUNIT_ASSERT(out.parse(document));
+    TSUNIT_ASSERT(out.save(xmlName));
+
+    // Move the XML file into the past so that the cache is unambiguously newer.
+    fs::last_write_time(xmlName.toUTF8(),
+                        fs::file_time_type::clock::now() - std::chrono::seconds(10),
+                        &ts::ErrCodeReport());
+
+    // First load: the XML file is parsed and the cache is created.
+    ts::ChannelFile file1;
+    file1.setCompiledCache(true);
+    TSUNIT_ASSERT(!fs::exists(cacheName));
+    TSUNIT_ASSERT(file1.load(xmlName));
+    TSUNIT_ASSERT(fs::exists(cacheName));
+    TSUNIT_EQUAL(document, file1.toXML());
+
+    // Second load after deleting the XML source: can only come from the cache.
+    fs::remove(xmlName, &ts::ErrCodeReport());
+    ts::ChannelFile file2;
+    file2.setCompiledCache(true);
+    TSUNIT_ASSERT(file2.load(xmlName));
+    TSUNIT_EQUAL(document, file2.toXML());
+
+    // A corrupted cache is ignored and the XML source is parsed again.
+    TSUNIT_ASSERT(out.save(xmlName));
+    fs::last_write_time(xmlName.toUTF8(),
+                        fs::file_time_type::clock::now() - std::chrono::seconds(10),
+                        &ts::ErrCodeReport());
+    TSUNIT_ASSERT(ts::UString(u"garbage").save(cacheName));
+
+    ts::ChannelFile file3;
+    file3.setCompiledCache(true);
+    TSUNIT_ASSERT(file3.load(xmlName));
+    TSUNIT_EQUAL(document, file3.toXML());
+
+    fs::remove(xmlName, &ts::ErrCodeReport());
+    fs::remove(cacheName, &ts::ErrCodeReport());
+}
@@ -27,10 +27,12 @@ public:
 
     void testAnalyze();
     void testFix();
+    void testFixWindow();
 
     TSUNIT_TEST_BEGIN(ContinuityTest);
     TSUNIT_TEST(testAnalyze);
     TSUNIT_TEST(testFix);
+    TSUNIT_TEST(testFixWindow);
     TSUNIT_TEST_END();
 };
 
@@ -214,3 +216,37 @@ void ContinuityTest::testFix()
     TSUNIT_EQUAL(2, fixer.errorCount());
     TSUNIT_EQUAL(5, fixer.fixCount());
 }
+
+void ContinuityTest::testFixWindow()
+{
+    ts::ReportBuffer<> log;
+    ts::ContinuityAnalyzer fixer(ts::AllPIDs, &log);
+
+    fixer.setDisplay(true);
+    fixer.setFix(true);
+    fixer.setMessagePrefix(u"baz: ");
+
+    // Same scenario as testFix, processed as one single window of packets.
+    static const ts::PID pids[] = {100, 101, 100, 101, 101, 101, 101, 101, 101, 101, 101, 101};
+    static const uint8_t cc_in[] = {5, 13, 6, 14, 14, 15, 0, 3, 4, 4, 4, 5};
+    static const uint8_t cc_out[] = {5, 13, 6, 14, 14, 15, 0, 1, 2, 2, 2, 3};
+
+    ts::TSPacketVector pkts(12, ts::NullPacket);
+    for (size_t i = 0; i < pkts.size(); ++i) {
+        pkts[i].setPID(pids[i]);
+        pkts[i].setCC(cc_in[i]);
+    }
+
+    TSUNIT_EQUAL(5, fixer.feedPackets(pkts.data(), pkts.size()));
+    TSUNIT_EQUAL(u"baz: packet index: 7, PID: 0x0065, missing 2 packets\n"
+                 u"baz: packet index: 10, PID: 0x0065, 3 duplicate packets", log.messages());
+
+    for (size_t i = 0; i < pkts.size(); ++i) {
+        TSUNIT_EQUAL(cc_out[i], pkts[i].getCC());
+    }
+
+    TSUNIT_EQUAL(12, fixer.totalPackets());
+    TSUNIT_EQUAL(12, fixer.processedPackets());
+    TSUNIT_EQUAL(2, fixer.errorCount());
+    TSUNIT_EQUAL(5, fixer.fixCount());
+}
@@ -58,6 +58,7 @@ public:
 
     void testAES();
     void testAES_ECB();
+    void testAES_MultiBlock();
     void testAES_CBC();
     void testAES_CTR();
     void testAES_CTS1();
@@ -80,6 +81,7 @@ public:
     TSUNIT_TEST_BEGIN(CryptoTest);
     TSUNIT_TEST(testAES);
     TSUNIT_TEST(testAES_ECB);
+    TSUNIT_TEST(testAES_MultiBlock);
     TSUNIT_TEST(testAES_CBC);
     TSUNIT_TEST(testAES_CTR);
     TSUNIT_TEST(testAES_CTS1);
@@ -375,6 +377,39 @@ void CryptoTest::testAES_ECB()
     bench.report(u"CryptoTest::testAES_ECB");
 }
 
+void CryptoTest::testAES_MultiBlock()
+{
+    // Check that multi-block ECB operations, possibly pipelined by the
+    // implementation, are identical to block by block operations.
+    ts::SystemRandomGenerator prng;
+    ts::ByteBlock key(ts::AES::MAX_KEY_SIZE);
+    ts::ByteBlock plain(13 * ts::AES::BLOCK_SIZE);
+    TSUNIT_ASSERT(prng.read(key.data(), key.size()));
+    TSUNIT_ASSERT(prng.read(plain.data(), plain.size()));
+
+    ts::AES aes1;
+    ts::AES aes2;
+    TSUNIT_ASSERT(aes1.setKey(key.data(), key.size()));
+    TSUNIT_ASSERT(aes2.setKey(key.data(), key.size()));
+
+    // Encrypt block by block and all blocks at once.
+    ts::ByteBlock cipher1(plain.size());
+    ts::ByteBlock cipher2(plain.size());
+    for (size_t i = 0; i < plain.size(); i += ts::AES::BLOCK_SIZE) {
+        TSUNIT_ASSERT(aes1.encrypt(plain.data() + i, ts::AES::BLOCK_SIZE, cipher1.data() + i, ts::AES::BLOCK_SIZE));
+    }
+    TSUNIT_ASSERT(aes2.encryptBlocks(plain.data(), cipher2.data(), plain.size() / ts::AES::BLOCK_SIZE));
+    TSUNIT_ASSERT(cipher1 == cipher2);
+
+    // A multi-block operation counts as one key usage per block.
+    TSUNIT_EQUAL(aes1.encryptionCount(), aes2.encryptionCount());
+
+    // Decrypt all blocks at once.
+    ts::ByteBlock plain2(cipher1.size());
+    TSUNIT_ASSERT(aes2.decryptBlocks(cipher1.data(), plain2.data(), cipher1.size() / ts::AES::BLOCK_SIZE));
+    TSUNIT_ASSERT(plain == plain2);
+}
+
 void CryptoTest::testAES_CBC()
 {
     utest::TSUnitBenchmark bench(u"TSUNIT_AES_CBC_ITERATIONS");
@@ -74,6 +74,7 @@ public:
     void testGetIntVarLE();
     void testPutIntVarBE();
     void testPutIntVarLE();
+    void testLocateZeroZero();
 
     TSUNIT_TEST_BEGIN(MemoryTest);
     TSUNIT_TEST(testGetUInt8);
@@ -126,6 +127,7 @@ public:
     TSUNIT_TEST(testGetIntVarLE);
     TSUNIT_TEST(testPutIntVarBE);
     TSUNIT_TEST(testPutIntVarLE);
+    TSUNIT_TEST(testLocateZeroZero);
     TSUNIT_TEST_END();
 };
 
@@ -510,3 +512,35 @@ void MemoryTest::testPutIntVarLE()
     ts::PutIntVarLE(out, 8, 0x908F8E8D8C8B8A89);
     TSUNIT_EQUAL(0, std::memcmp(out, _bytes + 0x89, 8));
 }
+
+void MemoryTest::testLocateZeroZero()
+{
+    static const uint8_t data[] = {
+        0x01, 0x00, 0x02, 0x00, 0x00, 0x02, 0x55, 0x00,
+        0x00, 0x01, 0xAA, 0xBB, 0x00, 0x00, 0x00, 0x17,
+        0x42, 0x9F, 0x00, 0x00, 0x33, 0x44, 0x00, 0x00,
+        0x00, 0x00, 0x01, 0x99, 0x00, 0x00,
+    };
+    TSUNIT_ASSERT(ts::LocateZeroZero(data, sizeof(data), 0x01) == data + 7);
+    TSUNIT_ASSERT(ts::LocateZeroZero(data, sizeof(data), 0x00) == data + 12);
+    TSUNIT_ASSERT(ts::LocateZeroZero(data, sizeof(data), 0x02) == data + 3);
+    TSUNIT_ASSERT(ts::LocateZeroZero(data, sizeof(data), 0x77) == nullptr);
+    TSUNIT_ASSERT(ts::LocateZeroZero(data + 20, 10, 0x01) == data + 24);
+    TSUNIT_ASSERT(ts::LocateZeroZero(data + 27, 3, 0x01) == nullptr);
+    TSUNIT_ASSERT(ts::LocateZeroZero(data, 2, 0x00) == nullptr);
+    TSUNIT_ASSERT(ts::LocateZeroZero(data, 0, 0x00) == nullptr);
+
+    // Larger buffer, making sure the vectorized paths are exercised.
+    std::vector<uint8_t> buf(300, 0xFF);
+    TSUNIT_ASSERT(ts::LocateZeroZero(buf.data(), buf.size(), 0x01) == nullptr);
+    buf[200] = buf[201] = 0x00;
+    buf[202] = 0x01;
+    TSUNIT_ASSERT(ts::LocateZeroZero(buf.data(), buf.size(), 0x01) == buf.data() + 200);
+    TSUNIT_ASSERT(ts::LocateZeroZero(buf.data(), buf.size(), 0x00) == nullptr);
+    // An incomplete pattern at the very end of the buffer must not match.
+    buf[298] = buf[299] = 0x00;
+    TSUNIT_ASSERT(ts::LocateZeroZero(buf.data(), buf.size(), 0x55) == nullptr);
+    // Consistency with the generic pattern search.
+    static const uint8_t prefix[] = {0x00, 0x00, 0x01};
+    TSUNIT_ASSERT(ts::LocateZeroZero(data, sizeof(data), 0x01) == ts::LocatePattern(data, sizeof(data), prefix, sizeof(prefix)));
+}
@@ -11,6 +11,7 @@
 //----------------------------------------------------------------------------
 
 #include "tsMessageQueue.h"
+#include "tsMessageConflatingQueue.h"
 #include "tsMessagePriorityQueue.h"
 #include "tsMonotonic.h"
 #include "tsSysUtils.h"
@@ -32,12 +33,16 @@ public:
 
     void testConstructor();
     void testQueue();
+    void testTryEnqueue();
     void testPriorityQueue();
+    void testConflatingQueue();
 
     TSUNIT_TEST_BEGIN(MessageQueueTest);
     TSUNIT_TEST(testConstructor);
     TSUNIT_TEST(testQueue);
+    TSUNIT_TEST(testTryEnqueue);
     TSUNIT_TEST(testPriorityQueue);
+    TSUNIT_TEST(testConflatingQueue);
     TSUNIT_TEST_END();
 private:
     ts::NanoSecond  _nsPrecision;
@@ -181,6 +186,30 @@ void MessageQueueTest::testQueue()
     debug() << "MessageQueueTest: main thread: end of test" << std::endl;
 }
 
+void MessageQueueTest::testTryEnqueue()
+{
+    TestQueue queue(4);
+    int message = 0;
+
+    // Fill the queue, never waits.
+    while (message < 4) {
+        TSUNIT_ASSERT(queue.tryEnqueue(new int(message++)));
+    }
+    TSUNIT_EQUAL(0, queue.droppedCount());
+
+    // Queue full: messages are dropped and counted, still without waiting.
+    TSUNIT_ASSERT(!queue.tryEnqueue(new int(message)));
+    TSUNIT_ASSERT(!queue.tryEnqueue(new int(message)));
+    TSUNIT_EQUAL(2, queue.droppedCount());
+
+    // After dequeueing one message, one slot is available again.
+    TestQueue::MessagePtr msg;
+    TSUNIT_ASSERT(queue.dequeue(msg, 0));
+    TSUNIT_EQUAL(0, *msg);
+    TSUNIT_ASSERT(queue.tryEnqueue(new int(message)));
+    TSUNIT_EQUAL(2, queue.droppedCount());
+}
+
 void MessageQueueTest::testPriorityQueue()
 {
     struct Message
@@ -250,3 +279,52 @@ void MessageQueueTest::testPriorityQueue()
 
     TSUNIT_ASSERT(!queue.dequeue(msg, 0));
 }
+
+void MessageQueueTest::testConflatingQueue()
+{
+    struct Message
+    {
+        int key;
+        int value;
+        Message(int k = 0, int v = 0) : key(k), value(v) {}
+        bool operator==(const Message& other) const { return key == other.key; }
+    };
+
+    ts::MessageConflatingQueue<Message> queue(4);
+    ts::MessageConflatingQueue<Message>::MessagePtr msg;
+
+    TSUNIT_ASSERT(queue.enqueue(new Message(1, 1), 0));
+    TSUNIT_ASSERT(queue.enqueue(new Message(2, 2), 0));
+    TSUNIT_ASSERT(queue.enqueue(new Message(3, 3), 0));
+
+    // Same keys again: the new messages replace the queued ones in place.
+    TSUNIT_ASSERT(queue.enqueue(new Message(2, 12), 0));
+    TSUNIT_ASSERT(queue.enqueue(new Message(1, 11), 0));
+    TSUNIT_EQUAL(2, queue.conflatedCount());
+
+    // Conflation also works through tryEnqueue() when the queue is full.
+    TSUNIT_ASSERT(queue.enqueue(new Message(4, 4), 0));
+    TSUNIT_ASSERT(queue.tryEnqueue(new Message(3, 13)));
+    TSUNIT_ASSERT(!queue.tryEnqueue(new Message(5, 5)));
+    TSUNIT_EQUAL(3, queue.conflatedCount());
+    TSUNIT_EQUAL(1, queue.droppedCount());
+
+    // Dequeue order is preserved, with the updated values.
+    TSUNIT_ASSERT(queue.dequeue(msg, 0));
+    TSUNIT_EQUAL(1, msg->key);
+    TSUNIT_EQUAL(11, msg->value);
+
+    TSUNIT_ASSERT(queue.dequeue(msg, 0));
+    TSUNIT_EQUAL(2, msg->key);
+    TSUNIT_EQUAL(12, msg->value);
+
+    TSUNIT_ASSERT(queue.dequeue(msg, 0));
+    TSUNIT_EQUAL(3, msg->key);
+    TSUNIT_EQUAL(13, msg->value);
+
+    TSUNIT_ASSERT(queue.dequeue(msg, 0));
+    TSUNIT_EQUAL(4, msg->key);
+    TSUNIT_EQUAL(4, msg->value);
+
+    TSUNIT_ASSERT(!queue.dequeue(msg, 0));
+}
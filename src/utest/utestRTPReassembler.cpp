@@ -0,0 +1,231 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for class ts::RTPReassembler
+//
+//----------------------------------------------------------------------------
+
+#include "tsRTPReassembler.h"
+#include "tsMemory.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class RTPReassemblerTest: public tsunit::Test
+{
+public:
+    void testInOrder();
+    void testReordering();
+    void testFECRecovery();
+    void testLoss();
+
+    TSUNIT_TEST_BEGIN(RTPReassemblerTest);
+    TSUNIT_TEST(testInOrder);
+    TSUNIT_TEST(testReordering);
+    TSUNIT_TEST(testFECRecovery);
+    TSUNIT_TEST(testLoss);
+    TSUNIT_TEST_END();
+
+private:
+    static constexpr size_t PAYLOAD_SIZE = 16;
+    static constexpr size_t PACKET_SIZE = ts::RTP_HEADER_SIZE + PAYLOAD_SIZE;
+
+    // Build one RTP media datagram with a seq-dependent payload.
+    static void BuildMedia(uint8_t* data, uint16_t seq);
+
+    // Build one SMPTE 2022-1 FEC datagram protecting count datagrams,
+    // starting at snbase, with the given sequence offset.
+    static void BuildFEC(uint8_t* data, uint16_t snbase, uint16_t offset, uint16_t count, bool row);
+};
+
+TSUNIT_REGISTER(RTPReassemblerTest);
+
+
+//----------------------------------------------------------------------------
+// Build test datagrams.
+//----------------------------------------------------------------------------
+
+void RTPReassemblerTest::BuildMedia(uint8_t* data, uint16_t seq)
+{
+    data[0] = 0x80;  // RTP version 2.
+    data[1] = 33;    // payload type: MPEG-2 TS.
+    ts::PutUInt16(data + 2, seq);
+    ts::PutUInt32(data + 4, uint32_t(seq) * 100);
+    ts::PutUInt32(data + 8, 0x12345678);
+    for (size_t i = 0; i < PAYLOAD_SIZE; ++i) {
+        data[ts::RTP_HEADER_SIZE + i] = uint8_t(seq + i);
+    }
+}
+
+void RTPReassemblerTest::BuildFEC(uint8_t* data, uint16_t snbase, uint16_t offset, uint16_t count, bool row)
+{
+    // The FEC datagram is an RTP datagram itself.
+    data[0] = 0x80;
+    data[1] = 96;
+    ts::PutUInt16(data + 2, 0);
+    ts::PutUInt32(data + 4, 0);
+    ts::PutUInt32(data + 8, 0);
+
+    // FEC header and payload: XOR of the protected datagrams.
+    uint8_t* const fec = data + ts::RTP_HEADER_SIZE;
+    uint16_t size_xor = 0;
+    uint8_t pt_xor = 0;
+    uint32_t ts_xor = 0;
+    ::memset(fec + 16, 0, PAYLOAD_SIZE);
+    for (uint16_t i = 0; i < count; ++i) {
+        const uint16_t seq = uint16_t(snbase + i * offset);
+        uint8_t media[PACKET_SIZE];
+        BuildMedia(media, seq);
+        size_xor ^= uint16_t(PAYLOAD_SIZE);
+        pt_xor ^= media[1] & 0x7F;
+        ts_xor ^= ts::GetUInt32(media + 4);
+        for (size_t b = 0; b < PAYLOAD_SIZE; ++b) {
+            fec[16 + b] ^= media[ts::RTP_HEADER_SIZE + b];
+        }
+    }
+    ts::PutUInt16(fec, snbase);
+    ts::PutUInt16(fec + 2, size_xor);
+    fec[4] = pt_xor;
+    fec[5] = fec[6] = fec[7] = 0;   // mask
+    ts::PutUInt32(fec + 8, ts_xor);
+    fec[12] = row ? 0x40 : 0x00;    // D bit
+    fec[13] = uint8_t(offset);
+    fec[14] = uint8_t(count);
+    fec[15] = 0;
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+void RTPReassemblerTest::testInOrder()
+{
+    ts::RTPReassembler buf;
+    buf.init(4, PACKET_SIZE);
+
+    uint8_t data[PACKET_SIZE];
+    uint8_t out[PACKET_SIZE];
+    size_t size = 0;
+    ts::MicroSecond timestamp = -1;
+
+    for (uint16_t seq = 100; seq < 110; ++seq) {
+        BuildMedia(data, seq);
+        TSUNIT_ASSERT(buf.putMedia(data, PACKET_SIZE, ts::MicroSecond(seq)));
+        TSUNIT_ASSERT(buf.getNext(out, sizeof(out), size, timestamp));
+        TSUNIT_EQUAL(PACKET_SIZE, size);
+        TSUNIT_EQUAL(seq, ts::GetUInt16(out + 2));
+        TSUNIT_EQUAL(ts::MicroSecond(seq), timestamp);
+        TSUNIT_ASSERT(!buf.getNext(out, sizeof(out), size, timestamp));
+    }
+    TSUNIT_EQUAL(0, buf.reorderedCount());
+    TSUNIT_EQUAL(0, buf.lostCount());
+
+    // A non-RTP datagram is rejected (to be processed directly by the caller).
+    data[0] = 0x47;
+    TSUNIT_ASSERT(!buf.putMedia(data, PACKET_SIZE, -1));
+}
+
+void RTPReassemblerTest::testReordering()
+{
+    ts::RTPReassembler buf;
+    buf.init(4, PACKET_SIZE);
+
+    uint8_t data[PACKET_SIZE];
+    uint8_t out[PACKET_SIZE];
+    size_t size = 0;
+    ts::MicroSecond timestamp = -1;
+
+    // Feed 0, 2, 1, 3. Datagram 2 must be held back until 1 arrives.
+    for (uint16_t seq : {0, 2}) {
+        BuildMedia(data, seq);
+        TSUNIT_ASSERT(buf.putMedia(data, PACKET_SIZE, -1));
+    }
+    TSUNIT_ASSERT(buf.getNext(out, sizeof(out), size, timestamp));
+    TSUNIT_EQUAL(0, ts::GetUInt16(out + 2));
+    TSUNIT_ASSERT(!buf.getNext(out, sizeof(out), size, timestamp));
+
+    for (uint16_t seq : {1, 3}) {
+        BuildMedia(data, seq);
+        TSUNIT_ASSERT(buf.putMedia(data, PACKET_SIZE, -1));
+    }
+    for (uint16_t seq = 1; seq <= 3; ++seq) {
+        TSUNIT_ASSERT(buf.getNext(out, sizeof(out), size, timestamp));
+        TSUNIT_EQUAL(seq, ts::GetUInt16(out + 2));
+    }
+    TSUNIT_EQUAL(1, buf.reorderedCount());
+    TSUNIT_EQUAL(0, buf.lostCount());
+}
+
+void RTPReassemblerTest::testFECRecovery()
+{
+    ts::RTPReassembler buf;
+    buf.init(4, PACKET_SIZE);
+
+    uint8_t data[PACKET_SIZE];
+    uint8_t fec[PACKET_SIZE + 16];
+    uint8_t out[PACKET_SIZE];
+    size_t size = 0;
+    ts::MicroSecond timestamp = -1;
+
+    // Column FEC over a 4x3 matrix: protect datagrams 1, 5, 9.
+    BuildFEC(fec, 1, 4, 3, false);
+    buf.putFEC(fec, sizeof(fec));
+
+    // Feed datagrams 0 to 11, except 5.
+    for (uint16_t seq = 0; seq < 12; ++seq) {
+        if (seq != 5) {
+            BuildMedia(data, seq);
+            TSUNIT_ASSERT(buf.putMedia(data, PACKET_SIZE, -1));
+        }
+    }
+
+    // All datagrams must come out in sequence, 5 being rebuilt from the FEC.
+    uint8_t reference[PACKET_SIZE];
+    for (uint16_t seq = 0; seq < 12; ++seq) {
+        TSUNIT_ASSERT(buf.getNext(out, sizeof(out), size, timestamp));
+        TSUNIT_EQUAL(PACKET_SIZE, size);
+        BuildMedia(reference, seq);
+        TSUNIT_EQUAL(0, ::memcmp(reference, out, PACKET_SIZE));
+    }
+    TSUNIT_EQUAL(1, buf.recoveredCount());
+    TSUNIT_EQUAL(0, buf.lostCount());
+}
+
+void RTPReassemblerTest::testLoss()
+{
+    ts::RTPReassembler buf;
+    buf.init(4, PACKET_SIZE);
+
+    uint8_t data[PACKET_SIZE];
+    uint8_t out[PACKET_SIZE];
+    size_t size = 0;
+    ts::MicroSecond timestamp = -1;
+
+    // Feed datagrams 0 to 9, except 3, without any FEC stream.
+    for (uint16_t seq = 0; seq < 10; ++seq) {
+        if (seq != 3) {
+            BuildMedia(data, seq);
+            TSUNIT_ASSERT(buf.putMedia(data, PACKET_SIZE, -1));
+        }
+    }
+
+    // Datagram 3 is abandoned once datagram 3 + window was seen.
+    for (uint16_t seq = 0; seq < 10; ++seq) {
+        if (seq != 3) {
+            TSUNIT_ASSERT(buf.getNext(out, sizeof(out), size, timestamp));
+            TSUNIT_EQUAL(seq, ts::GetUInt16(out + 2));
+        }
+    }
+    TSUNIT_ASSERT(!buf.getNext(out, sizeof(out), size, timestamp));
+    TSUNIT_EQUAL(1, buf.lostCount());
+    TSUNIT_EQUAL(0, buf.recoveredCount());
+}
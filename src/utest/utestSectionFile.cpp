@@ -49,6 +49,7 @@ public:
     void testSCTE35();
     void testMemory();
     void testBuildSections();
+    void testCompiledCache();
     void testMultiSectionsCAT();
     void testMultiSectionsAtProgramLevelPMT();
     void testMultiSectionsAtStreamLevelPMT();
@@ -62,6 +63,7 @@ public:
     TSUNIT_TEST(testSCTE35);
     TSUNIT_TEST(testMemory);
     TSUNIT_TEST(testBuildSections);
+    TSUNIT_TEST(testCompiledCache);
     TSUNIT_TEST(testMultiSectionsCAT);
     TSUNIT_TEST(testMultiSectionsAtProgramLevelPMT);
     TSUNIT_TEST(testMultiSectionsAtStreamLevelPMT);
@@ -489,6 +491,64 @@ void SectionFileTest::testBuildSections()
     TSUNIT_ASSERT(tdtTime == xmlTDT.utc_time);
 }
 
+void SectionFileTest::testCompiledCache()
+{
+    ts::DuckContext duck(&report());
+    const ts::UString cacheName(_tempFileNameXML + ts::SectionFile::DEFAULT_COMPILED_SECTION_FILE_SUFFIX);
+    fs::remove(cacheName, &ts::ErrCodeReport());
+
+    // Build an XML file with one PAT.
+    ts::PAT pat(7, true, 0x1234);
+    pat.pmts[0x0001] = 0x1000;
+    pat.pmts[0x0002] = 0x2000;
+
+    ts::BinaryTablePtr patBin(new(ts::BinaryTable));
+    TSUNIT_ASSERT(!patBin.isNull());
+    pat.serialize(duck, *patBin);
+    TSUNIT_ASSERT(patBin->isValid());
+
+    ts::SectionFile out(duck);
+    out.add(patBin);
+    TSUNIT_ASSERT(out.saveXML(_tempFileNameXML));
+
+    // Move the XML file into the past so that the cache is unambiguously newer.
+    fs::last_write_time(_tempFileNameXML.toUTF8(),
+                        fs::file_time_type::clock::now() - std::chrono::seconds(10),
+                        &ts::ErrCodeReport(report(), u"error setting time", _tempFileNameXML));
+
+    // First load: the XML file is parsed and the cache is created.
+    ts::SectionFile file1(duck);
+    file1.setCompiledSectionCache(true);
+    TSUNIT_ASSERT(!fs::exists(cacheName));
+    TSUNIT_ASSERT(file1.loadXML(_tempFileNameXML));
+    TSUNIT_ASSERT(fs::exists(cacheName));
+    TSUNIT_EQUAL(1, file1.tables().size());
+
+    // Second load after deleting the XML source: can only come from the cache.
+    fs::remove(_tempFileNameXML, &ts::ErrCodeReport());
+    ts::SectionFile file2(duck);
+    file2.setCompiledSectionCache(true);
+    TSUNIT_ASSERT(file2.loadXML(_tempFileNameXML));
+    TSUNIT_EQUAL(file1.sections().size(), file2.sections().size());
+    for (size_t i = 0; i < file1.sections().size(); ++i) {
+        TSUNIT_ASSERT(*file1.sections()[i] == *file2.sections()[i]);
+    }
+
+    // A corrupted cache is ignored and the XML source is parsed again.
+    TSUNIT_ASSERT(out.saveXML(_tempFileNameXML));
+    fs::last_write_time(_tempFileNameXML.toUTF8(),
+                        fs::file_time_type::clock::now() - std::chrono::seconds(10),
+                        &ts::ErrCodeReport(report(), u"error setting time", _tempFileNameXML));
+    TSUNIT_ASSERT(ts::UString(u"garbage").save(cacheName));
+
+    ts::SectionFile file3(duck);
+    file3.setCompiledSectionCache(true);
+    TSUNIT_ASSERT(file3.loadXML(_tempFileNameXML));
+    TSUNIT_EQUAL(1, file3.tables().size());
+
+    fs::remove(cacheName, &ts::ErrCodeReport());
+}
+
 void SectionFileTest::testMultiSectionsCAT()
 {
     ts::DuckContext duck;
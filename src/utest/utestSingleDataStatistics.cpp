@@ -25,9 +25,11 @@ public:
     virtual void afterTest() override;
 
     void testSingleDataStatistics();
+    void testQuantiles();
 
     TSUNIT_TEST_BEGIN(SingleDataStatTest);
     TSUNIT_TEST(testSingleDataStatistics);
+    TSUNIT_TEST(testQuantiles);
     TSUNIT_TEST_END();
 };
 
@@ -76,3 +78,37 @@ void SingleDataStatTest::testSingleDataStatistics()
     TSUNIT_EQUAL(u"1.67", stat.varianceString());
     TSUNIT_EQUAL(u"1.29", stat.standardDeviationString());
 }
+
+void SingleDataStatTest::testQuantiles()
+{
+    ts::SingleDataStatistics<uint32_t> stat;
+
+    // Without enabling quantiles, the estimation is always zero.
+    stat.feed(5);
+    TSUNIT_EQUAL(0, stat.quantile(0.5));
+
+    // Exhaustive reservoir: fewer samples than the reservoir size.
+    stat.reset();
+    stat.enableQuantiles(100);
+    for (uint32_t i = 1; i <= 10; ++i) {
+        stat.feed(11 - i);
+    }
+    TSUNIT_EQUAL(10, stat.count());
+    TSUNIT_EQUAL(1, stat.quantile(0.0));
+    TSUNIT_EQUAL(6, stat.quantile(0.5));
+    TSUNIT_EQUAL(10, stat.quantile(1.0));
+
+    // Sampling reservoir: more samples than the reservoir size.
+    // Feed a uniform distribution of 1 to 1000 in mixed order and check that
+    // the estimations are in a loose tolerance interval around the exact values.
+    stat.reset();
+    for (uint32_t i = 0; i < 1000; ++i) {
+        stat.feed(((i * 617) % 1000) + 1);
+    }
+    const uint32_t p50 = stat.quantile(0.50);
+    const uint32_t p99 = stat.quantile(0.99);
+    debug() << "SingleDataStatTest::testQuantiles(): p50: " << p50 << ", p99: " << p99 << std::endl;
+    TSUNIT_EQUAL(1000, stat.count());
+    TSUNIT_ASSERT(p50 > 250 && p50 < 750);
+    TSUNIT_ASSERT(p99 >= p50 && p99 <= 1000);
+}
@@ -0,0 +1,178 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for tsTS.h
+//
+//----------------------------------------------------------------------------
+
+#include "tsTS.h"
+#include "tsByteBlock.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class TSTest: public tsunit::Test
+{
+public:
+    virtual void beforeTest() override;
+    virtual void afterTest() override;
+
+    void testFindSyncByte();
+    void testCheckSyncPeriodicity();
+    void testClassifyPacketHeaders();
+    void testMatchPIDs();
+
+    TSUNIT_TEST_BEGIN(TSTest);
+    TSUNIT_TEST(testFindSyncByte);
+    TSUNIT_TEST(testCheckSyncPeriodicity);
+    TSUNIT_TEST(testClassifyPacketHeaders);
+    TSUNIT_TEST(testMatchPIDs);
+    TSUNIT_TEST_END();
+};
+
+TSUNIT_REGISTER(TSTest);
+
+
+//----------------------------------------------------------------------------
+// Initialization.
+//----------------------------------------------------------------------------
+
+// Test suite initialization method.
+void TSTest::beforeTest()
+{
+}
+
+// Test suite cleanup method.
+void TSTest::afterTest()
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+void TSTest::testFindSyncByte()
+{
+    ts::ByteBlock buf(1000, 0x00);
+
+    // No sync byte at all.
+    TSUNIT_EQUAL(ts::NPOS, ts::FindSyncByte(buf.data(), buf.size()));
+    TSUNIT_EQUAL(ts::NPOS, ts::FindSyncByte(buf.data(), 0));
+
+    // One sync byte at every possible position inside and around the vector chunks.
+    for (size_t pos = 0; pos < 70; ++pos) {
+        buf[pos] = ts::SYNC_BYTE;
+        TSUNIT_EQUAL(pos, ts::FindSyncByte(buf.data(), buf.size()));
+        buf[pos] = 0x00;
+    }
+
+    // Sync byte in the scalar tail, after the last complete chunk.
+    buf[buf.size() - 1] = ts::SYNC_BYTE;
+    TSUNIT_EQUAL(buf.size() - 1, ts::FindSyncByte(buf.data(), buf.size()));
+    TSUNIT_EQUAL(ts::NPOS, ts::FindSyncByte(buf.data(), buf.size() - 1));
+
+    // The first of several sync bytes is returned.
+    buf[500] = ts::SYNC_BYTE;
+    buf[600] = ts::SYNC_BYTE;
+    TSUNIT_EQUAL(500, ts::FindSyncByte(buf.data(), buf.size()));
+}
+
+void TSTest::testCheckSyncPeriodicity()
+{
+    ts::ByteBlock buf(10 * ts::PKT_RS_SIZE, 0xFF);
+
+    // Valid 188-byte packets.
+    for (size_t pos = 0; pos < buf.size(); pos += ts::PKT_SIZE) {
+        buf[pos] = ts::SYNC_BYTE;
+    }
+    TSUNIT_ASSERT(ts::CheckSyncPeriodicity(buf.data(), 10 * ts::PKT_SIZE, ts::PKT_SIZE));
+    TSUNIT_ASSERT(!ts::CheckSyncPeriodicity(buf.data(), 10 * ts::PKT_SIZE, ts::PKT_RS_SIZE));
+
+    // A buffer which is too short for one packet is trivially valid.
+    TSUNIT_ASSERT(ts::CheckSyncPeriodicity(buf.data(), ts::PKT_SIZE - 1, ts::PKT_SIZE));
+
+    // Corrupt one sync byte in the middle, then at the very last packet.
+    buf[5 * ts::PKT_SIZE] = 0x00;
+    TSUNIT_ASSERT(!ts::CheckSyncPeriodicity(buf.data(), 10 * ts::PKT_SIZE, ts::PKT_SIZE));
+    buf[5 * ts::PKT_SIZE] = ts::SYNC_BYTE;
+    buf[9 * ts::PKT_SIZE] = 0x00;
+    TSUNIT_ASSERT(!ts::CheckSyncPeriodicity(buf.data(), 10 * ts::PKT_SIZE, ts::PKT_SIZE));
+    buf[9 * ts::PKT_SIZE] = ts::SYNC_BYTE;
+
+    // M2TS-like layout: 4-byte header before each sync byte.
+    ts::ByteBlock m2ts(10 * ts::PKT_M2TS_SIZE, 0xFF);
+    for (size_t pos = 0; pos < m2ts.size(); pos += ts::PKT_M2TS_SIZE) {
+        m2ts[pos + ts::M2TS_HEADER_SIZE] = ts::SYNC_BYTE;
+    }
+    TSUNIT_ASSERT(ts::CheckSyncPeriodicity(m2ts.data(), m2ts.size(), ts::PKT_M2TS_SIZE, ts::M2TS_HEADER_SIZE));
+    TSUNIT_ASSERT(!ts::CheckSyncPeriodicity(m2ts.data(), m2ts.size(), ts::PKT_M2TS_SIZE));
+}
+
+void TSTest::testClassifyPacketHeaders()
+{
+    // Build 7 packets (odd count: the last ones go through the scalar tail).
+    constexpr size_t count = 7;
+    ts::ByteBlock buf(count * ts::PKT_SIZE, 0xFF);
+    for (size_t i = 0; i < count; ++i) {
+        uint8_t* const pkt = buf.data() + i * ts::PKT_SIZE;
+        const ts::PID pid = ts::PID(0x0100 + i);
+        pkt[0] = ts::SYNC_BYTE;
+        pkt[1] = uint8_t(pid >> 8);
+        pkt[2] = uint8_t(pid);
+        pkt[3] = 0x10;  // payload only, not scrambled
+    }
+    // Packet 2: TEI + PUSI + priority, packet 4: odd scrambling + AF.
+    buf[2 * ts::PKT_SIZE + 1] |= 0xE0;
+    buf[4 * ts::PKT_SIZE + 3] = 0xF0;
+
+    ts::PID pids[count];
+    uint8_t flags[count];
+    ts::ClassifyPacketHeaders(buf.data(), ts::PKT_SIZE, count, pids, flags);
+
+    for (size_t i = 0; i < count; ++i) {
+        TSUNIT_EQUAL(ts::PID(0x0100 + i), pids[i]);
+    }
+    TSUNIT_EQUAL(ts::TS_HFLAG_PAYLOAD, flags[0]);
+    TSUNIT_EQUAL(ts::TS_HFLAG_TEI | ts::TS_HFLAG_PUSI | ts::TS_HFLAG_PRIORITY | ts::TS_HFLAG_PAYLOAD, flags[2]);
+    TSUNIT_EQUAL(ts::TS_HFLAG_SCRAMBLING | ts::TS_HFLAG_AF | ts::TS_HFLAG_PAYLOAD, flags[4]);
+    TSUNIT_EQUAL(ts::SC_ODD_KEY, uint8_t((flags[4] & ts::TS_HFLAG_SCRAMBLING) >> ts::TS_HFLAG_SC_SHIFT));
+    TSUNIT_EQUAL(ts::TS_HFLAG_PAYLOAD, flags[6]);
+
+    // The flags array is optional.
+    pids[3] = ts::PID_NULL;
+    ts::ClassifyPacketHeaders(buf.data(), ts::PKT_SIZE, count, pids);
+    TSUNIT_EQUAL(ts::PID(0x0103), pids[3]);
+}
+
+void TSTest::testMatchPIDs()
+{
+    // 70 PID values: one more than a full 64-bit mask word.
+    constexpr size_t count = 70;
+    ts::PID pids[count];
+    for (size_t i = 0; i < count; ++i) {
+        pids[i] = ts::PID(i % 5 == 0 ? 0x0200 : 0x0300);
+    }
+
+    ts::PIDSet set;
+    set.set(0x0200);
+
+    uint64_t mask[2] = {0, 0};
+    ts::MatchPIDs(set, pids, count, mask);
+    for (size_t i = 0; i < count; ++i) {
+        TSUNIT_EQUAL(i % 5 == 0, ((mask[i / 64] >> (i % 64)) & 1) != 0);
+    }
+
+    // No PID matches an empty set.
+    ts::MatchPIDs(ts::NoPID, pids, count, mask);
+    TSUNIT_EQUAL(0, mask[0]);
+    TSUNIT_EQUAL(0, mask[1]);
+}
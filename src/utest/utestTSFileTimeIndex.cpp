@@ -0,0 +1,112 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for TSFileTimeIndex.
+//
+//----------------------------------------------------------------------------
+
+#include "tsTSFileTimeIndex.h"
+#include "tsCerrReport.h"
+#include "tsNullReport.h"
+#include "tsFileUtils.h"
+#include "tsErrCodeReport.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class TSFileTimeIndexTest: public tsunit::Test
+{
+public:
+    virtual void beforeTest() override;
+    virtual void afterTest() override;
+
+    void testWriteRead();
+    void testMissingIndex();
+
+    TSUNIT_TEST_BEGIN(TSFileTimeIndexTest);
+    TSUNIT_TEST(testWriteRead);
+    TSUNIT_TEST(testMissingIndex);
+    TSUNIT_TEST_END();
+
+private:
+    ts::UString _tempFileName {};
+};
+
+TSUNIT_REGISTER(TSFileTimeIndexTest);
+
+
+//----------------------------------------------------------------------------
+// Initialization.
+//----------------------------------------------------------------------------
+
+// Test suite initialization method.
+void TSFileTimeIndexTest::beforeTest()
+{
+    if (_tempFileName.empty()) {
+        _tempFileName = ts::TempFile(u".ts");
+    }
+    fs::remove(ts::TSFileTimeIndex::IndexFileName(_tempFileName), &ts::ErrCodeReport());
+}
+
+// Test suite cleanup method.
+void TSFileTimeIndexTest::afterTest()
+{
+    fs::remove(ts::TSFileTimeIndex::IndexFileName(_tempFileName), &ts::ErrCodeReport());
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+void TSFileTimeIndexTest::testWriteRead()
+{
+    ts::TSFileTimeIndex index;
+    TSUNIT_ASSERT(!index.isOpen());
+    TSUNIT_ASSERT(index.createWrite(_tempFileName, CERR));
+    TSUNIT_ASSERT(index.isOpen());
+
+    // Feed 100 packets, one PCR every packet, PCR step of 100 ms.
+    // With the default index interval of one second, one packet in ten is indexed.
+    for (uint64_t i = 0; i < 100; ++i) {
+        ts::TSPacket pkt(ts::NullPacket);
+        TSUNIT_ASSERT(pkt.setPCR(i * (ts::SYSTEM_CLOCK_FREQ / 10), true));
+        index.feedPacket(pkt, i);
+    }
+    TSUNIT_ASSERT(index.close(CERR));
+    TSUNIT_ASSERT(!index.isOpen());
+
+    // Reload the index and check a few seek points.
+    ts::TSFileTimeIndex index2;
+    TSUNIT_ASSERT(index2.openRead(_tempFileName, CERR));
+    TSUNIT_ASSERT(index2.isOpen());
+    TSUNIT_EQUAL(10, index2.entryCount());
+    TSUNIT_EQUAL(9000, index2.duration());
+
+    uint64_t packet_index = 0;
+    TSUNIT_ASSERT(index2.lookup(0, packet_index));
+    TSUNIT_EQUAL(0, packet_index);
+    TSUNIT_ASSERT(index2.lookup(5000, packet_index));
+    TSUNIT_EQUAL(50, packet_index);
+    TSUNIT_ASSERT(index2.lookup(5500, packet_index));
+    TSUNIT_EQUAL(50, packet_index);
+    // Beyond the end of the index, return the last indexed packet.
+    TSUNIT_ASSERT(index2.lookup(60000, packet_index));
+    TSUNIT_EQUAL(90, packet_index);
+    TSUNIT_ASSERT(index2.close(CERR));
+}
+
+void TSFileTimeIndexTest::testMissingIndex()
+{
+    ts::TSFileTimeIndex index;
+    TSUNIT_ASSERT(!index.openRead(_tempFileName + u".none", NULLREP));
+    TSUNIT_ASSERT(!index.isOpen());
+}
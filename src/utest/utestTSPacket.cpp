@@ -34,6 +34,7 @@ public:
     void testSetPayloadSize();
     void testFlags();
     void testPrivateData();
+    void testBatchExtract();
 
     TSUNIT_TEST_BEGIN(TSPacketTest);
     TSUNIT_TEST(testPacket);
@@ -44,6 +45,7 @@ public:
     TSUNIT_TEST(testSetPayloadSize);
     TSUNIT_TEST(testFlags);
     TSUNIT_TEST(testPrivateData);
+    TSUNIT_TEST(testBatchExtract);
     TSUNIT_TEST_END();
 };
 
@@ -521,3 +523,54 @@ void TSPacketTest::testPrivateData()
     pkt.getPrivateData(data);
     TSUNIT_ASSERT(data.empty());
 }
+
+void TSPacketTest::testBatchExtract()
+{
+    ts::TSPacket packets[6];
+    for (auto& pkt : packets) {
+        pkt = ts::NullPacket;
+    }
+
+    // One packet with a PCR.
+    packets[1].init(0x0100);
+    TSUNIT_ASSERT(packets[1].setPCR(0x000000126789ABCD, true));
+
+    // One packet with an adaptation field but no PCR.
+    packets[3].init(0x0150);
+    TSUNIT_ASSERT(packets[3].setDiscontinuityIndicator(true));
+
+    // One packet with the start of a PES header containing a PTS.
+    packets[4].init(0x0200);
+    packets[4].setPUSI();
+    uint8_t* pl = packets[4].getPayload();
+    pl[0] = 0x00; pl[1] = 0x00; pl[2] = 0x01;  // PES start code prefix
+    pl[3] = 0xE0;                              // video stream id (long header)
+    pl[4] = 0x00; pl[5] = 0x00;                // PES packet length (unbounded)
+    pl[6] = 0x80;                              // markers '10', no flag
+    pl[7] = 0x80;                              // PTS_DTS_flags = '10'
+    pl[8] = 0x05;                              // PES header data length
+    pl[9] = 0x21;                              // PTS field with markers, value 0 for now
+    pl[10] = 0x00; pl[11] = 0x01;
+    pl[12] = 0x00; pl[13] = 0x01;
+    packets[4].setPTS(0x123456789);
+    TSUNIT_EQUAL(0x123456789, packets[4].getPTS());
+
+    ts::TSPacket::PacketTimestampVector pcrs;
+    ts::TSPacket::ExtractPCRs(packets, 6, pcrs);
+    TSUNIT_EQUAL(1, pcrs.size());
+    TSUNIT_EQUAL(1, pcrs[0].index);
+    TSUNIT_EQUAL(0x0100, pcrs[0].pid);
+    TSUNIT_EQUAL(0x000000126789ABCD, pcrs[0].value);
+
+    ts::TSPacket::PacketTimestampVector ptss;
+    ts::TSPacket::ExtractPTSs(packets, 6, ptss);
+    TSUNIT_EQUAL(1, ptss.size());
+    TSUNIT_EQUAL(4, ptss[0].index);
+    TSUNIT_EQUAL(0x0200, ptss[0].pid);
+    TSUNIT_EQUAL(0x123456789, ptss[0].value);
+
+    // A scrambled packet shall be ignored by the PTS scan.
+    packets[4].setScrambling(ts::SC_EVEN_KEY);
+    ts::TSPacket::ExtractPTSs(packets, 6, ptss);
+    TSUNIT_ASSERT(ptss.empty());
+}
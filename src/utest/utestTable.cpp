@@ -28,6 +28,8 @@
 #include "tsEutelsatChannelNumberDescriptor.h"
 #include "tsDuckContext.h"
 #include "tsTSPacket.h"
+#include "tsBinaryTable.h"
+#include "tsPSIBuffer.h"
 #include "tsunit.h"
 
 
@@ -52,6 +54,8 @@ public:
     void testTOT();
     void testTSDT();
     void testCleanupPrivateDescriptors();
+    void testReusableSerializationBuffer();
+    void testDescriptorSearch();
 
     TSUNIT_TEST_BEGIN(TableTest);
     TSUNIT_TEST(testAssignPMT);
@@ -65,6 +69,8 @@ public:
     TSUNIT_TEST(testTOT);
     TSUNIT_TEST(testTSDT);
     TSUNIT_TEST(testCleanupPrivateDescriptors);
+    TSUNIT_TEST(testReusableSerializationBuffer);
+    TSUNIT_TEST(testDescriptorSearch);
     TSUNIT_TEST_END();
 };
 
@@ -347,3 +353,90 @@ void TableTest::testCleanupPrivateDescriptors()
     TSUNIT_EQUAL(1, dlist.count());
     TSUNIT_EQUAL(ts::DID_SERVICE, dlist[0]->tag());
 }
+
+void TableTest::testReusableSerializationBuffer()
+{
+    ts::DuckContext duck;
+
+    // A PMT with a few streams and a larger SDT, serialized through the same reusable buffer.
+    ts::PMT pmt(1, true, 27, 1001);
+    pmt.descs.add(duck, ts::CADescriptor(0x1234, 2002));
+    pmt.streams[3003].stream_type = 45;
+    pmt.streams[3003].descs.add(duck, ts::AVCVideoDescriptor());
+
+    ts::SDT sdt(true, 2, true, 0x5678, 0x9ABC);
+    for (uint16_t srv = 100; srv < 120; ++srv) {
+        sdt.services[srv].setName(duck, ts::UString::Format(u"SERVICE %d", {srv}));
+    }
+
+    // Reference serializations with one-shot buffers.
+    ts::BinaryTable refPMT;
+    ts::BinaryTable refSDT;
+    TSUNIT_ASSERT(pmt.serialize(duck, refPMT));
+    TSUNIT_ASSERT(sdt.serialize(duck, refSDT));
+
+    // Same serializations through one shared reusable buffer, in both orders.
+    ts::PSIBuffer buf(duck);
+    ts::BinaryTable bin;
+    TSUNIT_ASSERT(pmt.serialize(bin, buf));
+    TSUNIT_ASSERT(bin.isValid());
+    TSUNIT_ASSERT(bin == refPMT);
+    TSUNIT_ASSERT(sdt.serialize(bin, buf));
+    TSUNIT_ASSERT(bin.isValid());
+    TSUNIT_ASSERT(bin == refSDT);
+    TSUNIT_ASSERT(pmt.serialize(bin, buf));
+    TSUNIT_ASSERT(bin == refPMT);
+
+    // An invalid table shall leave the binary table empty, without corrupting the buffer.
+    ts::PMT bad;
+    bad.invalidate();
+    TSUNIT_ASSERT(!bad.serialize(bin, buf));
+    TSUNIT_ASSERT(!bin.isValid());
+    TSUNIT_ASSERT(sdt.serialize(bin, buf));
+    TSUNIT_ASSERT(bin == refSDT);
+}
+
+void TableTest::testDescriptorSearch()
+{
+    ts::DuckContext duck;
+    ts::DescriptorList dlist(nullptr);
+
+    // Build a list which is large enough to trigger the internal tag index.
+    for (uint16_t i = 0; i < 6; ++i) {
+        dlist.add(duck, ts::CADescriptor(0x1234, 2000 + i));
+        dlist.add(duck, ts::AVCVideoDescriptor());
+    }
+    TSUNIT_EQUAL(12, dlist.count());
+
+    // Iterate all CA descriptors, at even indexes.
+    size_t found = 0;
+    for (size_t i = dlist.search(ts::DID_CA); i < dlist.count(); i = dlist.search(ts::DID_CA, i + 1)) {
+        TSUNIT_EQUAL(ts::DID_CA, dlist[i]->tag());
+        TSUNIT_EQUAL(0, i % 2);
+        found++;
+    }
+    TSUNIT_EQUAL(6, found);
+    TSUNIT_EQUAL(dlist.count(), dlist.search(ts::DID_AC3));
+
+    // The index shall be invalidated when the list is modified.
+    TSUNIT_ASSERT(dlist.removeByIndex(0));
+    TSUNIT_EQUAL(11, dlist.count());
+    TSUNIT_EQUAL(1, dlist.search(ts::DID_CA));
+    TSUNIT_EQUAL(0, dlist.search(ts::DID_AVC_VIDEO));
+
+    TSUNIT_EQUAL(5, dlist.removeByTag(ts::DID_CA));
+    TSUNIT_EQUAL(6, dlist.count());
+    TSUNIT_EQUAL(dlist.count(), dlist.search(ts::DID_CA));
+    TSUNIT_EQUAL(3, dlist.search(ts::DID_AVC_VIDEO, 3));
+
+    // Collect several tags in one pass.
+    dlist.add(duck, ts::CADescriptor(0x4321, 3000));
+    std::vector<size_t> indexes;
+    dlist.searchAll({ts::DID_CA, ts::DID_AVC_VIDEO}, indexes);
+    TSUNIT_EQUAL(7, indexes.size());
+    dlist.searchAll({ts::DID_CA}, indexes);
+    TSUNIT_EQUAL(1, indexes.size());
+    TSUNIT_EQUAL(6, indexes[0]);
+    dlist.searchAll({ts::DID_AC3}, indexes);
+    TSUNIT_ASSERT(indexes.empty());
+}
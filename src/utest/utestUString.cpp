@@ -305,6 +305,10 @@ void UStringTest::testUTF()
     TSUNIT_EQUAL(s1, s2);
     TSUNIT_EQUAL(s1, s3);
     TSUNIT_EQUAL(s1, s4);
+
+    // Reverse conversion, exercising the bulk ASCII narrowing path.
+    const std::string u8(s1.toUTF8());
+    TSUNIT_EQUAL(std::string(reinterpret_cast<const char*>(utf8_bytes), utf8_count), u8);
 }
 
 void UStringTest::testDiacritical()
@@ -1379,6 +1383,11 @@ void UStringTest::testHexaDump()
         u"0010.0000 0010.0001 0010.0010 0010.0011 0010.0100 0010.0101   !\"#$%\n"
         u"0010.0110 0010.0111 0010.1000 0010.1001                      &'()\n";
     TSUNIT_EQUAL(ref8, hex8);
+
+    // The stream version produces the same output as the string version.
+    std::ostringstream strm;
+    ts::UString::Dump(strm, refBytes + 32, 40, ts::UString::HEXA | ts::UString::ASCII | ts::UString::OFFSET, 4, 50, 32);
+    TSUNIT_EQUAL(hex3.toUTF8(), strm.str());
 }
 
 void UStringTest::testArgMixIn()
@@ -0,0 +1,295 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+// Micro-benchmark suite for hot-path primitives of the TSDuck library.
+//
+// Each benchmark runs a fixed workload on one primitive. The runner first
+// executes one warmup pass, then measures a number of repetitions and
+// reports the median, making the results reasonably stable on a loaded
+// system. Results can be saved in JSON format to track regressions from
+// one release to another. Use "make bench" from the top-level directory.
+//
+//----------------------------------------------------------------------------
+
+#include "tsMain.h"
+#include "tsAlgorithm.h"
+#include "tsDuckContext.h"
+#include "tsTSPacket.h"
+#include "tsCRC32.h"
+#include "tsBuffer.h"
+#include "tsPAT.h"
+#include "tsOneShotPacketizer.h"
+#include "tsSectionDemux.h"
+#include "tsTSProcessor.h"
+#include "tsTSProcessorArgs.h"
+#include "tsjsonObject.h"
+#include "tsjsonArray.h"
+#include <chrono>
+TS_MAIN(MainCode);
+
+// Global sink, making sure that benchmark loops are not optimized away.
+namespace {
+    volatile uint64_t g_sink = 0;
+}
+
+
+//----------------------------------------------------------------------------
+// Command line options
+//----------------------------------------------------------------------------
+
+namespace {
+    class Options: public ts::Args
+    {
+        TS_NOBUILD_NOCOPY(Options);
+    public:
+        Options(int argc, char *argv[]);
+
+        ts::UStringVector names {};
+        size_t            repeat = 0;
+        ts::UString       json_file {};
+        bool              list = false;
+    };
+}
+
+Options::Options(int argc, char *argv[]) :
+    ts::Args(u"Micro-benchmark suite for hot-path primitives of the TSDuck library", u"[options] [name ...]")
+{
+    option(u"", 0, STRING, 0, UNLIMITED_COUNT);
+    help(u"", u"Names of the benchmarks to run. By default, run all benchmarks.");
+
+    option(u"json-file", 'j', FILENAME);
+    help(u"json-file", u"filename", u"Save the benchmark results in JSON format in the specified file.");
+
+    option(u"list", 'l');
+    help(u"list", u"List the available benchmarks and exit.");
+
+    option(u"repeat", 'r', POSITIVE);
+    help(u"repeat", u"Number of measured repetitions of each benchmark, the median value is reported. The default is 5.");
+
+    // Analyze the command.
+    analyze(argc, argv);
+
+    // Load option values.
+    getValues(names, u"");
+    getIntValue(repeat, u"repeat", 5);
+    getValue(json_file, u"json-file");
+    list = present(u"list");
+
+    // Final checking
+    exitOnError();
+}
+
+
+//----------------------------------------------------------------------------
+// Individual benchmarks. Each function runs one complete workload and
+// returns the number of elementary operations which were performed.
+//----------------------------------------------------------------------------
+
+namespace {
+
+    // TSPacket accessors: header and adaptation field parsing.
+    size_t BenchTSPacket(Options& opt)
+    {
+        constexpr size_t iterations = 2000000;
+        ts::TSPacket pkt(ts::NullPacket);
+        pkt.setPID(0x0100);
+        pkt.setPCR(0x0000000123456789, true);
+        uint64_t acc = 0;
+        for (size_t i = 0; i < iterations; ++i) {
+            acc += pkt.getPID();
+            acc += pkt.hasPCR();
+            acc += pkt.getPCR();
+            acc += pkt.getPayloadSize();
+            pkt.setPID(ts::PID((pkt.getPID() + 1) & 0x1FFF));
+        }
+        g_sink += acc;
+        return 5 * iterations;
+    }
+
+    // CRC32 computation over 4 kB buffers (DVB section checksum size range).
+    size_t BenchCRC32(Options& opt)
+    {
+        constexpr size_t iterations = 20000;
+        ts::ByteBlock data(4096);
+        for (size_t i = 0; i < data.size(); ++i) {
+            data[i] = uint8_t(i * 7 + 13);
+        }
+        uint64_t acc = 0;
+        for (size_t i = 0; i < iterations; ++i) {
+            data[0] = uint8_t(i);
+            const ts::CRC32 crc(data.data(), data.size());
+            acc += crc.value();
+        }
+        g_sink += acc;
+        return iterations;
+    }
+
+    // Buffer::getBits with a mix of small bit field sizes over a 1 kB buffer.
+    size_t BenchGetBits(Options& opt)
+    {
+        constexpr size_t iterations = 2000;
+        ts::ByteBlock data(1024);
+        for (size_t i = 0; i < data.size(); ++i) {
+            data[i] = uint8_t(i * 31 + 7);
+        }
+        ts::Buffer buf(data.data(), data.size());
+        uint64_t acc = 0;
+        size_t ops = 0;
+        for (size_t i = 0; i < iterations; ++i) {
+            buf.readSeek(0);
+            while (buf.canReadBits(24)) {
+                acc += buf.getBits<uint32_t>(3);
+                acc += buf.getBits<uint32_t>(5);
+                acc += buf.getBits<uint32_t>(13);
+                ops += 3;
+            }
+        }
+        g_sink += acc;
+        return ops;
+    }
+
+    // UString::Format with typical mixes of integer, string and float arguments.
+    size_t BenchFormat(Options& opt)
+    {
+        constexpr size_t iterations = 200000;
+        uint64_t acc = 0;
+        for (size_t i = 0; i < iterations; ++i) {
+            const ts::UString str(ts::UString::Format(u"PID 0x%X (%<d), %s, %.3f", {i & 0x1FFF, u"scrambled", double(i) / 3.0}));
+            acc += str.size();
+        }
+        g_sink += acc;
+        return iterations;
+    }
+
+    // SectionDemux::feedPacket on a cycling PAT with 100 services.
+    size_t BenchSectionDemux(Options& opt)
+    {
+        constexpr size_t iterations = 20000;
+        ts::DuckContext duck;
+
+        // Build and packetize one PAT with a realistic number of services.
+        ts::PAT pat(1, true, 0x1234);
+        for (uint16_t srv = 1; srv <= 100; ++srv) {
+            pat.pmts[srv] = ts::PID(0x0100 + srv);
+        }
+        ts::OneShotPacketizer pzer(duck, ts::PID_PAT);
+        pzer.addTable(duck, pat);
+        ts::TSPacketVector pkts;
+        pzer.getPackets(pkts);
+
+        // Feed the table cycle over and over in the demux.
+        ts::SectionDemux demux(duck);
+        demux.addPID(ts::PID_PAT);
+        for (size_t i = 0; i < iterations; ++i) {
+            for (auto& pkt : pkts) {
+                demux.feedPacket(pkt);
+            }
+        }
+        return iterations * pkts.size();
+    }
+
+    // Synthetic tsp chain: 10k null packets through a complete TS processor.
+    // This one measures the full pipeline overhead, including startup.
+    size_t BenchTspChain(Options& opt)
+    {
+        constexpr size_t packets = 10000;
+        ts::TSProcessorArgs args;
+        args.app_name = u"tsbench";
+        args.input.set(u"null", {ts::UString::Decimal(packets, 0, true, ts::UString())});
+        args.output.set(u"drop");
+        ts::TSProcessor proc(opt);
+        if (!proc.start(args)) {
+            return 0;
+        }
+        proc.waitForTermination();
+        return packets;
+    }
+
+    // Registry of all benchmarks.
+    struct Benchmark {
+        const ts::UChar* name;
+        const ts::UChar* description;
+        size_t (*proc)(Options&);
+    };
+    const Benchmark AllBenchmarks[] = {
+        {u"tspacket",      u"TSPacket header and PCR accessors", BenchTSPacket},
+        {u"crc32",         u"CRC32 computation over 4 kB buffers", BenchCRC32},
+        {u"getbits",       u"Buffer::getBits on small bit fields", BenchGetBits},
+        {u"format",        u"UString::Format with mixed arguments", BenchFormat},
+        {u"section-demux", u"SectionDemux::feedPacket on a cycling PAT", BenchSectionDemux},
+        {u"tsp-chain",     u"10k-packet synthetic tsp chain (null -> drop)", BenchTspChain},
+    };
+}
+
+
+//----------------------------------------------------------------------------
+// Program entry point
+//----------------------------------------------------------------------------
+
+int MainCode(int argc, char *argv[])
+{
+    Options opt(argc, argv);
+
+    // List benchmarks only.
+    if (opt.list) {
+        for (const auto& bench : AllBenchmarks) {
+            std::cout << ts::UString::Format(u"%-14s %s", {bench.name, bench.description}) << std::endl;
+        }
+        return EXIT_SUCCESS;
+    }
+
+    // Collected results, for the optional JSON report.
+    ts::json::Object root;
+    root.add(u"application", u"tsbench");
+    root.add(u"repeat", opt.repeat);
+    const ts::json::ValuePtr results(new ts::json::Array);
+    root.add(u"benchmarks", results);
+
+    for (const auto& bench : AllBenchmarks) {
+
+        // Apply the optional selection of benchmarks.
+        if (!opt.names.empty() && !ts::Contains(opt.names, ts::UString(bench.name))) {
+            continue;
+        }
+
+        // One warmup pass, then measured repetitions.
+        bench.proc(opt);
+        std::vector<uint64_t> samples;
+        size_t ops = 0;
+        for (size_t rep = 0; rep < opt.repeat; ++rep) {
+            const auto start = std::chrono::steady_clock::now();
+            ops = bench.proc(opt);
+            const auto end = std::chrono::steady_clock::now();
+            samples.push_back(uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()));
+        }
+        if (ops == 0) {
+            opt.error(u"benchmark %s failed", {bench.name});
+            continue;
+        }
+
+        // Median of the measured repetitions.
+        std::sort(samples.begin(), samples.end());
+        const uint64_t median = samples[samples.size() / 2];
+        const double ns_per_op = double(median) / double(ops);
+        const uint64_t ops_per_sec = uint64_t((double(ops) * 1000000000.0) / double(median));
+        std::cout << ts::UString::Format(u"%-14s %'d ops, median %'d ns, %.1f ns/op, %'d ops/s", {bench.name, ops, median, ns_per_op, ops_per_sec}) << std::endl;
+
+        // Accumulate the JSON report.
+        const ts::json::ValuePtr obj(new ts::json::Object);
+        obj->add(u"name", bench.name);
+        obj->add(u"operations", ops);
+        obj->add(u"median-nanoseconds", median);
+        obj->add(u"nanoseconds-per-operation", ns_per_op);
+        obj->add(u"operations-per-second", ops_per_sec);
+        results->set(obj);
+    }
+
+    // Save the JSON report when requested.
+    if (!opt.json_file.empty() && !root.save(opt.json_file, 2, false, opt)) {
+        return EXIT_FAILURE;
+    }
+    return opt.valid() ? EXIT_SUCCESS : EXIT_FAILURE;
+}